@@ -0,0 +1,97 @@
+/*
+ * Benchmarks for hand indexing and card abstraction
+ * Measures suit-isomorphic flop indices and turn equity histograms per
+ * second
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/poker_abstraction.h"
+#include "benchmark.h"
+
+/* Distinct flop hands cycled through by the index benchmark */
+#define NUM_HANDS 4096
+
+/*
+ * Benchmark hand_index() on flop hands (hole cards plus three board cards)
+ */
+BenchmarkResult benchmark_hand_index(void) {
+    struct timespec start, end;
+    static uint8_t hands[NUM_HANDS][5];
+    int iterations = 0;
+    uint64_t checksum = 0;
+    uint64_t state = 12345;
+    BenchmarkResult result;
+
+    for (size_t h = 0; h < NUM_HANDS; h++) {
+        uint64_t used = 0;
+        for (size_t i = 0; i < 5; i++) {
+            uint8_t card;
+            do {
+                state = state * UINT64_C(6364136223846793005) + 1442695040888963407ULL;
+                card = (uint8_t)((state >> 33) % DECK_SIZE);
+            } while (used & (UINT64_C(1) << card));
+            used |= UINT64_C(1) << card;
+            hands[h][i] = card;
+        }
+    }
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        for (size_t h = 0; h < NUM_HANDS; h++) {
+            uint64_t index;
+            hand_index(hands[h], 5, &index);
+            checksum += index;
+        }
+        iterations += NUM_HANDS;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+
+    /* Prevent optimization */
+    if (checksum == 0) {
+        printf("Unexpected checksum\n");
+    }
+
+    result.name = "hand_index (flop)";
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
+
+/*
+ * Benchmark ehs_histograms() on a turn board (46 river cards, 50 bins)
+ */
+BenchmarkResult benchmark_ehs_histograms(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    uint64_t board = 0;
+    uint32_t* const hist = malloc(HOLE_COMBOS * 50 * sizeof(uint32_t));
+    BenchmarkResult result;
+
+    parse_hand_mask("QsJs4d3c", 8, &board, NULL);
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        ehs_histograms(board, 50, 0, 0, hist);
+        iterations++;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+    free(hist);
+
+    result.name = "ehs_histograms (turn board)";
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
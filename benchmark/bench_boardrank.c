@@ -0,0 +1,96 @@
+/*
+ * Benchmarks for board rankings
+ * Measures river rankings built and range-vs-range showdown sweeps per
+ * second
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/poker_boardrank.h"
+#include "benchmark.h"
+
+#define BENCH_BOARDS 256
+
+/*
+ * Benchmark board_ranking_build() on random 5-card boards
+ */
+BenchmarkResult benchmark_board_ranking(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    static uint64_t boards[BENCH_BOARDS];
+    BoardRanking* const ranking = malloc(sizeof(BoardRanking));
+    uint32_t state = 0x9E3779B9u;
+    BenchmarkResult result;
+
+    for (size_t i = 0; i < BENCH_BOARDS; i++) {
+        uint64_t board = 0;
+        while (__builtin_popcountll(board) < BOARD_SIZE) {
+            state = state * 1103515245u + 12345u;
+            board |= UINT64_C(1) << ((state >> 16) % DECK_SIZE);
+        }
+        boards[i] = board;
+    }
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        for (size_t i = 0; i < BENCH_BOARDS; i++) {
+            board_ranking_build(boards[i], ranking);
+        }
+        iterations += BENCH_BOARDS;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+    free(ranking);
+
+    result.name = "board_ranking_build (river)";
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
+
+/*
+ * Benchmark board_ranking_showdown() with a random weighted range on one river
+ */
+BenchmarkResult benchmark_board_showdown(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    static double weights[HOLE_COMBOS];
+    static double values[HOLE_COMBOS];
+    BoardRanking* const ranking = malloc(sizeof(BoardRanking));
+    uint32_t state = 0x2545F491u;
+    BenchmarkResult result;
+
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        state = state * 1103515245u + 12345u;
+        weights[c] = (double)((state >> 16) % 1000) / 1000.0;
+    }
+    uint64_t board = 0;
+    parse_hand_mask("Ah7c7d2s9h", 10, &board, NULL);
+    board_ranking_build(board, ranking);
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        for (int i = 0; i < 64; i++) {
+            board_ranking_showdown(ranking, weights, values, NULL);
+        }
+        iterations += 64;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+    free(ranking);
+
+    result.name = "board_ranking_showdown (river)";
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
@@ -0,0 +1,85 @@
+/*
+ * Benchmarks for formatting functions (card_to_string, format_cards)
+ * Measures 5-card hands formatted per second using high-resolution timer
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+#include "../include/poker.h"
+#include "benchmark.h"
+
+/* Test data shared by the format benchmarks */
+static const Card BENCH_HAND[HAND_SIZE] = {
+    {RANK_ACE, SUIT_HEARTS},
+    {RANK_KING, SUIT_SPADES},
+    {RANK_QUEEN, SUIT_DIAMONDS},
+    {RANK_SEVEN, SUIT_CLUBS},
+    {RANK_TWO, SUIT_SPADES}
+};
+
+/*
+ * Benchmark formatting a 5-card hand one card at a time with card_to_string
+ */
+BenchmarkResult benchmark_card_to_string_hand(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    int i;
+    size_t j;
+    char buffer[3];
+    BenchmarkResult result;
+
+    result.name = "card_to_string (x5)";
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        for (i = 0; i < 100000; i++) {
+            for (j = 0; j < HAND_SIZE; j++) {
+                card_to_string(BENCH_HAND[j], buffer, sizeof(buffer));
+            }
+            iterations++;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
+
+/*
+ * Benchmark formatting a whole 5-card hand with format_cards
+ */
+BenchmarkResult benchmark_format_cards(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    int i;
+    char buffer[16];
+    BenchmarkResult result;
+
+    result.name = "format_cards";
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        for (i = 0; i < 100000; i++) {
+            format_cards(BENCH_HAND, HAND_SIZE, '\0', buffer, sizeof(buffer));
+            iterations++;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
@@ -0,0 +1,64 @@
+/*
+ * Benchmarks for the game engine
+ * Measures actions applied per second over random self-play on many tables
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include "../include/poker_game.h"
+#include "benchmark.h"
+
+#define BENCH_TABLES 4096
+#define BENCH_SEATS 6
+
+/*
+ * Benchmark game_apply_batch() with a cheap random policy (6-max tables)
+ */
+BenchmarkResult benchmark_game_step(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    static uint8_t actions[BENCH_TABLES];
+    static uint32_t raises[BENCH_TABLES];
+    const GameConfig config = {BENCH_SEATS, 1, 2, 200};
+    GameTables* const g = game_tables_create(&config, BENCH_TABLES);
+    uint32_t state = 0x12345678u;
+    uint64_t hands = 0;
+    BenchmarkResult result;
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        for (size_t t = 0; t < BENCH_TABLES; t++) {
+            GameLegal legal;
+            if (g->street[t] == GAME_STREET_DONE) {
+                game_start_hand(g, t, hands % BENCH_SEATS, hands, NULL);
+                hands++;
+            }
+            game_legal_actions(g, t, &legal);
+            state = state * 1103515245u + 12345u;
+            const unsigned r = (state >> 16) % 8;
+            if (r == 0 && (legal.actions & (1u << GAME_ACTION_FOLD))) {
+                actions[t] = GAME_ACTION_FOLD;
+            } else if (r == 1 && (legal.actions & (1u << GAME_ACTION_RAISE))) {
+                actions[t] = GAME_ACTION_RAISE;
+                raises[t] = legal.min_raise_to;
+            } else {
+                actions[t] = GAME_ACTION_CHECK_CALL;
+            }
+        }
+        game_apply_batch(g, actions, raises, BENCH_TABLES, NULL);
+        iterations += BENCH_TABLES;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+    game_tables_destroy(g);
+
+    result.name = "game_apply_batch (6-max)";
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
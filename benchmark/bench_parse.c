@@ -0,0 +1,82 @@
+/*
+ * Benchmarks for card parsing (parse_card, parse_hand)
+ * Measures 5-card hands parsed per second using high-resolution timer
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+#include "../include/poker.h"
+#include "benchmark.h"
+
+/*
+ * Benchmark parsing a 5-card hand one card at a time with parse_card
+ */
+BenchmarkResult benchmark_parse_card_hand(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    int i;
+    size_t j;
+    Card cards[HAND_SIZE];
+    BenchmarkResult result;
+
+    /* Test data: one hand, pre-split into card strings */
+    const char* strs[HAND_SIZE] = {"Ah", "Ks", "Qd", "7c", "2s"};
+
+    result.name = "parse_card (x5)";
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        for (i = 0; i < 100000; i++) {
+            for (j = 0; j < HAND_SIZE; j++) {
+                parse_card(strs[j], &cards[j]);
+            }
+            iterations++;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
+
+/*
+ * Benchmark parsing a whole 5-card hand string with parse_hand
+ */
+BenchmarkResult benchmark_parse_hand(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    int i;
+    Card cards[HAND_SIZE];
+    BenchmarkResult result;
+
+    /* Test data: one hand as a single line */
+    const char str[] = "AhKsQd7c2s";
+
+    result.name = "parse_hand";
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        for (i = 0; i < 100000; i++) {
+            parse_hand(str, sizeof(str) - 1, cards, HAND_SIZE, NULL);
+            iterations++;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
@@ -0,0 +1,94 @@
+/*
+ * Benchmarks for binary hand-record files
+ * Measures records decoded per second when scanning a compressed file
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "../include/poker_records.h"
+#include "benchmark.h"
+
+#define BENCH_RECORDS 100000
+#define BENCH_CHUNK 1024
+
+static const char* const BENCH_PATH = "/tmp/poker_bench_records.phr";
+
+/* Static helper: write a file of showdown-style records */
+static int write_bench_file(void) {
+    static HandRecord chunk[BENCH_CHUNK];
+    RecordWriter* const writer = record_writer_open(BENCH_PATH, NULL);
+    if (writer == NULL) {
+        return -1;
+    }
+
+    for (size_t done = 0; done < BENCH_RECORDS; done += BENCH_CHUNK) {
+        for (size_t i = 0; i < BENCH_CHUNK; i++) {
+            HandRecord* const rec = &chunk[i];
+            const size_t n = done + i;
+            memset(rec, 0, sizeof(*rec));
+            memset(rec->hole, CARD_INDEX_NONE, sizeof(rec->hole));
+            rec->hand_id = 230000000000ULL + n;
+            rec->num_players = (uint8_t)(2 + n % 5);
+            rec->hero = 0;
+            rec->hole[0][0] = (uint8_t)(n % 26);
+            rec->hole[0][1] = (uint8_t)(26 + n % 21);
+            rec->board_len = BOARD_SIZE;
+            for (size_t b = 0; b < BOARD_SIZE; b++) {
+                rec->board[b] = (uint8_t)(47 + b);
+            }
+            rec->showdown_mask = 0x1;
+            rec->winner_mask = 0x1;
+        }
+        if (record_writer_append(writer, chunk, BENCH_CHUNK) != 0) {
+            record_writer_close(writer);
+            return -1;
+        }
+    }
+    return record_writer_close(writer);
+}
+
+/*
+ * Benchmark scanning a compressed record file front to back
+ */
+BenchmarkResult benchmark_record_scan(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    static HandRecord chunk[BENCH_CHUNK];
+    BenchmarkResult result;
+
+    result.name = "record_reader_read";
+    result.ops_per_sec = 0;
+    result.iterations = 0;
+    result.elapsed_sec = 0;
+
+    RecordReader* const reader = (write_bench_file() == 0) ? record_reader_open(BENCH_PATH) : NULL;
+    if (reader == NULL) {
+        return result;
+    }
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        size_t got;
+        record_reader_seek(reader, 0);
+        do {
+            record_reader_read(reader, chunk, BENCH_CHUNK, &got);
+            iterations += (int)got;
+        } while (got > 0);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+
+    record_reader_close(reader);
+    remove(BENCH_PATH);
+
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
@@ -0,0 +1,95 @@
+/*
+ * Benchmarks for the river solver
+ * Measures DCFR iterations and exploitability evaluations per second on a
+ * uniform-vs-uniform river spot
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include "../include/poker_solver.h"
+#include "benchmark.h"
+
+/* Static helper: half-pot, pot and all-in bets, one raise size and two raises */
+static RiverSolver* bench_solver(void) {
+    static double range[HOLE_COMBOS];
+    RiverConfig config;
+
+    memset(&config, 0, sizeof(config));
+    parse_hand_mask("Ah7c7d2s9h", 10, &config.board, NULL);
+    config.pot = 10.0;
+    config.stack = 50.0;
+    for (int p = 0; p < 2; p++) {
+        config.bet_sizes[p][0] = 0.5;
+        config.bet_sizes[p][1] = 1.0;
+        config.num_bet_sizes[p] = 2;
+        config.raise_sizes[p][0] = 1.0;
+        config.num_raise_sizes[p] = 1;
+    }
+    config.max_raises = 2;
+    config.all_in = 1;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        range[c] = 1.0;
+    }
+    return river_solver_create(&config, range, range);
+}
+
+/*
+ * Benchmark river_solver_run() (single thread)
+ */
+BenchmarkResult benchmark_river_solver(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    RiverSolver* const solver = bench_solver();
+    BenchmarkResult result;
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        river_solver_run(solver, 16, 1);
+        iterations += 16;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+    river_solver_destroy(solver);
+
+    result.name = "river_solver_run (iteration)";
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
+
+/*
+ * Benchmark river_solver_exploitability() after 100 iterations (single thread)
+ */
+BenchmarkResult benchmark_river_exploitability(void) {
+    struct timespec start, end;
+    int iterations = 0;
+    double exploitability = 0.0;
+    RiverSolver* const solver = bench_solver();
+    BenchmarkResult result;
+
+    river_solver_run(solver, 100, 1);
+
+    /* Benchmark: run for at least 1 second */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        river_solver_exploitability(solver, 1, &exploitability);
+        iterations++;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+    } while ((end.tv_sec - start.tv_sec) +
+             (end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+    river_solver_destroy(solver);
+
+    result.name = "river_solver_exploitability";
+    result.elapsed_sec = (end.tv_sec - start.tv_sec) +
+                         (end.tv_nsec - start.tv_nsec) / 1e9;
+    result.ops_per_sec = iterations / result.elapsed_sec;
+    result.iterations = iterations;
+
+    return result;
+}
@@ -23,9 +23,22 @@ BenchmarkResult benchmark_detect_three_of_a_kind(void);
 BenchmarkResult benchmark_detect_two_pair(void);
 BenchmarkResult benchmark_detect_one_pair(void);
 BenchmarkResult benchmark_detect_high_card(void);
+BenchmarkResult benchmark_parse_card_hand(void);
+BenchmarkResult benchmark_parse_hand(void);
+BenchmarkResult benchmark_card_to_string_hand(void);
+BenchmarkResult benchmark_format_cards(void);
+BenchmarkResult benchmark_record_scan(void);
+BenchmarkResult benchmark_evaluate_mask(void);
+BenchmarkResult benchmark_game_step(void);
+BenchmarkResult benchmark_board_ranking(void);
+BenchmarkResult benchmark_board_showdown(void);
+BenchmarkResult benchmark_river_solver(void);
+BenchmarkResult benchmark_river_exploitability(void);
+BenchmarkResult benchmark_hand_index(void);
+BenchmarkResult benchmark_ehs_histograms(void);
 
 int main(void) {
-    BenchmarkResult results[13];
+    BenchmarkResult results[26];
     size_t i = 0;
 
     printf("Running Poker Hand Evaluator Benchmarks...\n");
@@ -35,47 +48,97 @@ int main(void) {
     printf("Please wait...\n\n");
 
     /* Run deck operations */
-    printf("[1/13] Benchmarking deck_shuffle...\n");
+    printf("[1/26] Benchmarking deck_shuffle...\n");
     results[i++] = benchmark_deck_shuffle();
 
     /* Run helper functions */
-    printf("[2/13] Benchmarking is_flush...\n");
+    printf("[2/26] Benchmarking is_flush...\n");
     results[i++] = benchmark_is_flush();
 
-    printf("[3/13] Benchmarking is_straight...\n");
+    printf("[3/26] Benchmarking is_straight...\n");
     results[i++] = benchmark_is_straight();
 
     /* Run detector functions (strongest to weakest) */
-    printf("[4/13] Benchmarking detect_royal_flush...\n");
+    printf("[4/26] Benchmarking detect_royal_flush...\n");
     results[i++] = benchmark_detect_royal_flush();
 
-    printf("[5/13] Benchmarking detect_straight_flush...\n");
+    printf("[5/26] Benchmarking detect_straight_flush...\n");
     results[i++] = benchmark_detect_straight_flush();
 
-    printf("[6/13] Benchmarking detect_four_of_a_kind...\n");
+    printf("[6/26] Benchmarking detect_four_of_a_kind...\n");
     results[i++] = benchmark_detect_four_of_a_kind();
 
-    printf("[7/13] Benchmarking detect_full_house...\n");
+    printf("[7/26] Benchmarking detect_full_house...\n");
     results[i++] = benchmark_detect_full_house();
 
-    printf("[8/13] Benchmarking detect_flush...\n");
+    printf("[8/26] Benchmarking detect_flush...\n");
     results[i++] = benchmark_detect_flush();
 
-    printf("[9/13] Benchmarking detect_straight...\n");
+    printf("[9/26] Benchmarking detect_straight...\n");
     results[i++] = benchmark_detect_straight();
 
-    printf("[10/13] Benchmarking detect_three_of_a_kind...\n");
+    printf("[10/26] Benchmarking detect_three_of_a_kind...\n");
     results[i++] = benchmark_detect_three_of_a_kind();
 
-    printf("[11/13] Benchmarking detect_two_pair...\n");
+    printf("[11/26] Benchmarking detect_two_pair...\n");
     results[i++] = benchmark_detect_two_pair();
 
-    printf("[12/13] Benchmarking detect_one_pair...\n");
+    printf("[12/26] Benchmarking detect_one_pair...\n");
     results[i++] = benchmark_detect_one_pair();
 
-    printf("[13/13] Benchmarking detect_high_card...\n");
+    printf("[13/26] Benchmarking detect_high_card...\n");
     results[i++] = benchmark_detect_high_card();
 
+    /* Run parsers */
+    printf("[14/26] Benchmarking parse_card (x5)...\n");
+    results[i++] = benchmark_parse_card_hand();
+
+    printf("[15/26] Benchmarking parse_hand...\n");
+    results[i++] = benchmark_parse_hand();
+
+    /* Run formatters */
+    printf("[16/26] Benchmarking card_to_string (x5)...\n");
+    results[i++] = benchmark_card_to_string_hand();
+
+    printf("[17/26] Benchmarking format_cards...\n");
+    results[i++] = benchmark_format_cards();
+
+    /* Run record file scan */
+    printf("[18/26] Benchmarking record_reader_read...\n");
+    results[i++] = benchmark_record_scan();
+
+    /* Run mask evaluator */
+    printf("[19/26] Benchmarking evaluate_mask...\n");
+    results[i++] = benchmark_evaluate_mask();
+
+    /* Run game engine */
+    printf("[20/26] Benchmarking game_apply_batch...\n");
+    results[i++] = benchmark_game_step();
+
+    /* Run board rankings */
+    printf("[21/26] Benchmarking board_ranking_build...\n");
+    results[i++] = benchmark_board_ranking();
+
+    /* Run range-vs-range showdown sweep */
+    printf("[22/26] Benchmarking board_ranking_showdown...\n");
+    results[i++] = benchmark_board_showdown();
+
+    /* Run river solver iterations */
+    printf("[23/26] Benchmarking river_solver_run...\n");
+    results[i++] = benchmark_river_solver();
+
+    /* Run best-response evaluation */
+    printf("[24/26] Benchmarking river_solver_exploitability...\n");
+    results[i++] = benchmark_river_exploitability();
+
+    /* Run suit-isomorphic indexing */
+    printf("[25/26] Benchmarking hand_index...\n");
+    results[i++] = benchmark_hand_index();
+
+    /* Run equity histograms */
+    printf("[26/26] Benchmarking ehs_histograms...\n");
+    results[i++] = benchmark_ehs_histograms();
+
     /* Display results */
     print_benchmark_table(results, i);
 
@@ -19,23 +19,6 @@
 #include <stdlib.h>
 #include <time.h>
 
-/* Helper function to get hand category name */
-static const char* hand_category_name(const HandCategory category) {
-    switch (category) {
-        case HAND_HIGH_CARD:       return "High Card";
-        case HAND_ONE_PAIR:        return "One Pair";
-        case HAND_TWO_PAIR:        return "Two Pair";
-        case HAND_THREE_OF_A_KIND: return "Three of a Kind";
-        case HAND_STRAIGHT:        return "Straight";
-        case HAND_FLUSH:           return "Flush";
-        case HAND_FULL_HOUSE:      return "Full House";
-        case HAND_FOUR_OF_A_KIND:  return "Four of a Kind";
-        case HAND_STRAIGHT_FLUSH:  return "Straight Flush";
-        case HAND_ROYAL_FLUSH:     return "Royal Flush";
-        default:                   return "Unknown";
-    }
-}
-
 /* Detect hand category using available detector functions */
 static HandCategory detect_hand_category(const Card* const cards) {
     Rank tiebreakers[MAX_TIEBREAKERS];
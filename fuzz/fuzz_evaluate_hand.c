@@ -206,6 +206,16 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     (void)detect_high_card(cards, 5, NULL, NULL);
     /* (void)detect_high_card(NULL, 5, tiebreakers, &num_tiebreakers); -- DISABLED */
 
+    /* Full evaluation (duplicates are rejected with POKER_EDUPLICATE) */
+    Hand hand;
+    (void)evaluate_hand(cards, 5, &hand);
+    (void)evaluate_hand(cards, 4, &hand);  /* Edge case: too few cards */
+    (void)evaluate_hand(NULL, 5, &hand);
+    (void)evaluate_mask(((uint64_t)data[0] << 56) | ((uint64_t)data[1] << 48) |
+                        ((uint64_t)data[2] << 40) | ((uint64_t)data[3] << 32) |
+                        ((uint64_t)data[4] << 24) | ((uint64_t)data[5] << 16) |
+                        ((uint64_t)data[6] << 8) | data[7]);
+
     /* Test helper functions */
     (void)is_flush(cards, 5);
     (void)is_flush(cards, 0);
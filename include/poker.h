@@ -45,6 +45,10 @@
 #define RANK_ARRAY_SIZE 15  /* Array size for rank indexing (0-14, RANK_ACE=14) */
 #define HAND_SIZE 5         /* Standard 5-card poker hand */
 #define DECK_SIZE 52        /* Standard deck (4 suits × 13 ranks) */
+#define HOLE_SIZE 2         /* Hold'em hole cards per player */
+#define BOARD_SIZE 5        /* Community cards on a complete board */
+#define MAX_PLAYERS 10      /* Maximum players at one table */
+#define POKER_MAX_THREADS 256 /* Most worker threads one call uses (larger requests are capped) */
 
 /*
  * Error codes - Following errno conventions
@@ -54,13 +58,29 @@
  * an error indicator (e.g., -1, NULL) and set poker_errno to indicate
  * the specific error type.
  */
-extern int poker_errno;
+#if defined(__GNUC__) || defined(__clang__)
+#define POKER_THREAD_LOCAL __thread
+#else
+#define POKER_THREAD_LOCAL
+#endif
+
+/*
+ * poker_errno is thread-local where the compiler supports it, so worker
+ * threads inside the library (and callers' own threads) each see their own
+ * error state.
+ */
+extern POKER_THREAD_LOCAL int poker_errno;
 
 #define POKER_EOK       0  /* No error */
 #define POKER_EINVAL    1  /* Invalid argument */
 #define POKER_ENOMEM    2  /* Out of memory */
 #define POKER_ENOTFOUND 3  /* Pattern not found */
 #define POKER_ERANGE    4  /* Out of range */
+#define POKER_EDUPLICATE 5 /* Duplicate card */
+#define POKER_EFORMAT   6  /* Corrupt or unrecognized data */
+#define POKER_EIO       7  /* I/O failure */
+#define POKER_ETIMEDOUT 8  /* Deadline passed before completion */
+#define POKER_EBUSY     9  /* Service overloaded, retry later */
 
 /*
  * Rank enumeration
@@ -153,6 +173,48 @@ int card_to_string(const Card card, char* const buffer, const size_t size);
  */
 int parse_card(const char* const str, Card* const out_card);
 
+/*
+ * Card index encoding
+ *
+ * Maps each of the DECK_SIZE cards to a dense 6-bit index in deck_new()
+ * order: index = (rank - RANK_TWO) * 4 + suit. Bit i of a 64-bit card mask
+ * represents the card with index i.
+ */
+#define CARD_INDEX(card) ((unsigned)(((card).rank - RANK_TWO) * 4 + (card).suit))
+#define CARD_FROM_INDEX(index) \
+    ((Card){ (uint8_t)((index) / 4 + RANK_TWO), (uint8_t)((index) % 4) })
+#define CARD_MASK_BIT(card) (UINT64_C(1) << CARD_INDEX(card))
+
+/**
+ * @brief Parse a hand string (e.g., "AhKsQd7c2s") into cards
+ *
+ * Cards may be concatenated or separated by spaces, tabs, commas or line
+ * endings. Duplicate cards are rejected in the same pass.
+ *
+ * @param str Input text (need not be NUL-terminated)
+ * @param len Number of bytes of str to parse
+ * @param out Output array for parsed cards
+ * @param max Capacity of out
+ * @param out_error_pos Optional pointer to receive byte offset of the error
+ * @return Number of cards parsed, or -1 on error (poker_errno set to
+ *         POKER_EINVAL, POKER_EDUPLICATE or POKER_ERANGE)
+ */
+int parse_hand(const char* const str, const size_t len,
+               Card* const out, const size_t max,
+               size_t* const out_error_pos);
+
+/**
+ * @brief Parse a hand string into a 64-bit card mask
+ * @param str Input text (need not be NUL-terminated)
+ * @param len Number of bytes of str to parse
+ * @param out_mask Pointer to receive mask (bit CARD_INDEX(card) per card)
+ * @param out_error_pos Optional pointer to receive byte offset of the error
+ * @return Number of cards parsed, or -1 on error (poker_errno set)
+ */
+int parse_hand_mask(const char* const str, const size_t len,
+                    uint64_t* const out_mask,
+                    size_t* const out_error_pos);
+
 /*
  * Deck structure
  *
@@ -453,4 +515,151 @@ typedef struct {
     size_t num_tiebreakers;             /* Number of valid tiebreakers */
 } Hand;
 
+/*
+ * Packed hand value
+ *
+ * A HandValue orders hands by strength with a single integer comparison:
+ * bits 20-23 hold the HandCategory and bits 0-19 hold up to five tiebreaker
+ * ranks as 4-bit nibbles, most significant first. 0 means "not evaluated".
+ */
+typedef uint32_t HandValue;
+
+#define HAND_VALUE_CATEGORY_SHIFT 20
+#define HAND_VALUE_CATEGORY(value) ((HandCategory)((value) >> HAND_VALUE_CATEGORY_SHIFT))
+
+/**
+ * @brief Evaluate the best five-card hand in a 5-7 card mask
+ *
+ * Branch-light bit-parallel evaluation intended for inner loops: cards are
+ * grouped into four 13-bit suit masks and pairs, trips, quads, flushes and
+ * straights are found with mask operations.
+ *
+ * @param mask Card mask (bit CARD_INDEX(card) per card)
+ * @return Packed hand value, or 0 if mask holds fewer than 5 or more than
+ *         7 cards or bits at or above DECK_SIZE
+ */
+HandValue evaluate_mask(const uint64_t mask);
+
+/**
+ * @brief Evaluate 5-7 cards given as four 13-bit suit masks
+ *
+ * suits[s] has bit (rank - RANK_TWO) set for each card of suit s. Callers
+ * that add and remove single cards (outs, runouts) keep the suit masks and
+ * flip one bit per card instead of rebuilding them from a card mask.
+ *
+ * @param suits Rank masks of the hearts, diamonds, clubs and spades
+ * @return Packed hand value (same as evaluate_mask()), or 0 if the masks
+ *         hold fewer than 5 or more than 7 cards or bits above the ace
+ */
+HandValue evaluate_suits(const uint32_t suits[4]);
+
+/**
+ * @brief Evaluate many card masks in one call
+ * @param masks Card masks (5-7 cards each)
+ * @param count Number of masks
+ * @param out_values Receives evaluate_mask() of each mask
+ */
+void evaluate_masks(const uint64_t* const masks, const size_t count,
+                    HandValue* const out_values);
+
+/**
+ * @brief Evaluate rows of card indices, split across threads
+ *
+ * cards holds num_hands rows of cards_per_hand card indices (CARD_INDEX(),
+ * 0..DECK_SIZE-1) stored row after row, e.g. a C-contiguous (n, 7) uint8
+ * array. A row with an index out of range or a repeated card evaluates
+ * to 0. Small batches run on fewer threads than requested.
+ *
+ * @param cards Card index rows
+ * @param num_hands Number of rows
+ * @param cards_per_hand Cards per row (HAND_SIZE to HAND_SIZE + 2)
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out_values Receives one HandValue per row
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int evaluate_card_rows(const uint8_t* const cards, const size_t num_hands,
+                       const size_t cards_per_hand, const size_t num_threads,
+                       HandValue* const out_values);
+
+/**
+ * @brief Evaluate the best five-card poker hand from 5 to 7 cards
+ *
+ * Fills out_hand with the five cards that make the best hand, its category
+ * and its tiebreakers (same layout as the detect_* functions).
+ *
+ * @param cards Array of cards
+ * @param len Number of cards (HAND_SIZE to HAND_SIZE + 2)
+ * @param out_hand Pointer to receive the evaluated hand
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL or
+ *         POKER_EDUPLICATE)
+ */
+int evaluate_hand(const Card* const cards, const size_t len, Hand* const out_hand);
+
+/**
+ * @brief Pack an evaluated hand's category and tiebreakers into a HandValue
+ * @param hand Evaluated hand
+ * @return Packed hand value, or 0 if hand is NULL
+ */
+HandValue hand_value(const Hand* const hand);
+
+/**
+ * @brief Compare two evaluated hands
+ * @param a First hand
+ * @param b Second hand
+ * @return Positive if a wins, negative if b wins, 0 for a tie
+ */
+int compare_hands(const Hand* const a, const Hand* const b);
+
+/**
+ * @brief Get the display name of a hand category (e.g., "Full House")
+ * @param category Hand category
+ * @return Static string, or "Unknown" if category is out of range
+ */
+const char* hand_category_name(const HandCategory category);
+
+/**
+ * @brief Format cards into a caller buffer (e.g., "AhKsQd" or "Ah Ks Qd")
+ * @param cards Array of cards (can be NULL if len is 0)
+ * @param len Number of cards
+ * @param separator Character written between cards, or '\0' for none
+ * @param buffer Output buffer (NUL-terminated on success)
+ * @param size Size of output buffer
+ * @return Characters written excluding NUL, or -1 on error (poker_errno set
+ *         to POKER_EINVAL for invalid input, POKER_ERANGE if buffer too small)
+ */
+int format_cards(const Card* const cards, const size_t len, const char separator,
+                 char* const buffer, const size_t size);
+
+/**
+ * @brief Format a 64-bit card mask in ascending CARD_INDEX order
+ * @param mask Card mask (bits at or above DECK_SIZE must be clear)
+ * @param separator Character written between cards, or '\0' for none
+ * @param buffer Output buffer (NUL-terminated on success)
+ * @param size Size of output buffer
+ * @return Characters written excluding NUL, or -1 on error (poker_errno set)
+ */
+int format_card_mask(const uint64_t mask, const char separator,
+                     char* const buffer, const size_t size);
+
+/**
+ * @brief Format a descriptive hand name (e.g., "Two Pair, Aces and Nines")
+ * @param hand Evaluated hand (category and leading tiebreakers are used)
+ * @param buffer Output buffer (NUL-terminated on success)
+ * @param size Size of output buffer
+ * @return Characters written excluding NUL, or -1 on error (poker_errno set)
+ */
+int format_hand_description(const Hand* const hand, char* const buffer,
+                            const size_t size);
+
+/**
+ * @brief Format a batch of hands as "<cards>\t<category>\t<description>\n" lines
+ * @param hands Array of evaluated hands
+ * @param count Number of hands
+ * @param buffer Output buffer (empty string on error)
+ * @param size Size of output buffer
+ * @return Characters written excluding NUL, or -1 on error (poker_errno set)
+ */
+int format_hands(const Hand* const hands, const size_t count,
+                 char* const buffer, const size_t size);
+
 #endif /* POKER_H */
@@ -0,0 +1,196 @@
+/*
+ * Poker Hand Evaluation Library
+ * Card abstraction: EHS-histogram bucketing
+ */
+
+#ifndef POKER_ABSTRACTION_H
+#define POKER_ABSTRACTION_H
+
+#include "poker_handindex.h"
+#include "poker_strength.h"
+
+/*
+ * Equity histograms
+ *
+ * A hand's equity distribution on a street is the histogram, over the
+ * river runouts still to come, of its river hand strength (the share of
+ * live opponent combos it beats, ties counting half, as
+ * board_ranking_percentile()). Hands with the same expected strength can
+ * have very different histograms (a flush draw against a weak made hand),
+ * which is what an abstraction must tell apart.
+ *
+ * Histograms are compared with the earth mover's distance; in one
+ * dimension that is the L1 distance between the cumulative histograms.
+ */
+
+/* Largest histogram bin count */
+#define ABSTRACTION_MAX_BINS 256
+
+/* Largest bucket count (bucket ids fit in 16 bits) */
+#define ABSTRACTION_MAX_BUCKETS 65536
+
+/* Bucket table file format version */
+#define BUCKET_TABLE_FORMAT_VERSION 1
+
+/**
+ * @brief Equity histograms of every hole-card combo on a board
+ *
+ * Each runout completes the board to five cards, ranks every live combo
+ * once (board_ranking_build()) and adds one count to the bin of each
+ * combo's strength. Combos sharing a card with the runout skip it, so
+ * counts differ slightly between combos.
+ *
+ * @param board Board mask (0, 3, 4 or 5 cards)
+ * @param bins Bins per histogram (2..ABSTRACTION_MAX_BINS)
+ * @param samples Runouts to sample (with replacement); 0, or at least the
+ *        number of runouts, visits every runout once
+ * @param seed Sampling seed
+ * @param out HOLE_COMBOS * bins counts, out[combo * bins + bin]; zero for
+ *        combos that share a card with the board
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL or
+ *         POKER_ENOMEM)
+ */
+int ehs_histograms(const uint64_t board, const unsigned bins, const size_t samples,
+                   const uint64_t seed, uint32_t* const out);
+
+/**
+ * @brief Earth mover's distance between two histograms
+ *
+ * Histograms are normalized first; the result is the mean absolute
+ * difference of the cumulative distributions, in [0, 1) as a share of
+ * the strength axis.
+ *
+ * @param a First histogram (bins counts)
+ * @param b Second histogram (bins counts)
+ * @param bins Bin count
+ * @return Distance, or -1.0 for an empty histogram or bins == 0
+ */
+double histogram_emd(const uint32_t* const a, const uint32_t* const b, const unsigned bins);
+
+/*
+ * Abstraction builder
+ *
+ * abstraction_build() clusters the histograms of every hand class of a
+ * street (hand_index()) into buckets with k-means under the earth mover's
+ * distance and writes a bucket table:
+ *
+ * 1. Features: board classes are split across threads; each one gets its
+ *    histograms from ehs_histograms() (summed over the combos of a hand
+ *    class) and writes one record per hand class into a memory-mapped
+ *    scratch file, so features of the turn (13,960,050 classes) never sit
+ *    in the heap. Records are the cumulative histogram quantized to bytes;
+ *    on the river every histogram is a single bin, so the record is the
+ *    bin index.
+ * 2. Initialization: k-means++ seeding on an evenly spaced sample of up to
+ *    65,536 records.
+ * 3. Lloyd iterations: threads stream over the records and assign each to
+ *    its nearest centroid, skipping the search when a record is within
+ *    half the distance from its centroid to the nearest other centroid,
+ *    and abandoning partial distances that exceed the best so far.
+ *    Centroid sums are integers, so the result does not depend on the
+ *    thread count. Iteration stops early when no assignment changes.
+ *
+ * River records take one of bins values, so the river clusters those
+ * values weighted by their frequency and then maps every hand through
+ * the result.
+ *
+ * The preflop street has a single (empty) board; its runouts are sampled
+ * in fixed chunks that the threads share, and samples must be nonzero.
+ */
+
+typedef struct {
+    int street;                 /* HAND_INDEX_PREFLOP..HAND_INDEX_RIVER */
+    size_t num_buckets;         /* 1..ABSTRACTION_MAX_BUCKETS */
+    unsigned bins;              /* Histogram bins (2..ABSTRACTION_MAX_BINS) */
+    size_t samples;             /* Runouts per board (0 = every runout, not preflop) */
+    size_t iterations;          /* Most Lloyd iterations */
+    size_t num_threads;         /* Worker threads (0 = one per online CPU) */
+    uint64_t seed;              /* Sampling and seeding */
+} AbstractionConfig;
+
+typedef struct {
+    uint64_t num_hands;         /* Hand classes bucketed */
+    size_t iterations;          /* Lloyd iterations run */
+    uint64_t changed;           /* Assignments changed by the last iteration */
+    size_t empty_buckets;       /* Buckets no hand ended up in */
+    double mean_distance;       /* Mean EMD between a hand and its centroid */
+} AbstractionStats;
+
+/**
+ * @brief Build a bucket table for one street
+ *
+ * The scratch file (path with ".features" appended) is unlinked as soon
+ * as it is mapped.
+ *
+ * @param config Build settings
+ * @param path Output file
+ * @param out_stats Receives build statistics (can be NULL)
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL,
+ *         POKER_ENOMEM or POKER_EIO)
+ */
+int abstraction_build(const AbstractionConfig* const config, const char* const path,
+                      AbstractionStats* const out_stats);
+
+/*
+ * Bucket tables
+ *
+ * File layout (little-endian):
+ *
+ *   0   "PBKT"
+ *   4   u8  format version
+ *   5   u8  street
+ *   6   u8  bytes per bucket (1 when num_buckets <= 256, else 2)
+ *   7   u8  reserved
+ *   8   u32 num_buckets
+ *   12  u32 bins
+ *   16  u64 num_hands (hand_index_count(street))
+ *   24  num_hands bucket ids, by hand index
+ *
+ * A table is memory-mapped read-only, so lookups cost one hand_index()
+ * and one load, and processes share its pages.
+ */
+
+/* Opaque memory-mapped table */
+typedef struct BucketTable BucketTable;
+
+/**
+ * @brief Open a bucket table
+ * @param path File written by abstraction_build()
+ * @return Pointer to the table, or NULL on error (poker_errno set to
+ *         POKER_EINVAL, POKER_ENOTFOUND, POKER_EFORMAT or POKER_ENOMEM)
+ */
+BucketTable* bucket_table_open(const char* const path);
+
+/**
+ * @brief Close a bucket table
+ * @param table Table to close (can be NULL)
+ */
+void bucket_table_close(BucketTable* const table);
+
+/**
+ * @brief Street of a bucket table
+ * @param table Table
+ * @return HAND_INDEX_PREFLOP..HAND_INDEX_RIVER
+ */
+int bucket_table_street(const BucketTable* const table);
+
+/**
+ * @brief Number of buckets in a table
+ * @param table Table
+ * @return Bucket count
+ */
+size_t bucket_table_buckets(const BucketTable* const table);
+
+/**
+ * @brief Bucket of a hand
+ * @param table Table
+ * @param cards Hole cards then board cards (as hand_index())
+ * @param num_cards Card count of the table's street
+ * @return Bucket in [0, bucket_table_buckets()), or -1 on error
+ *         (poker_errno set to POKER_EINVAL or POKER_EDUPLICATE, or
+ *         POKER_EFORMAT for an out-of-range entry)
+ */
+int bucket_table_lookup(const BucketTable* const table, const uint8_t* const cards,
+                        const size_t num_cards);
+
+#endif /* POKER_ABSTRACTION_H */
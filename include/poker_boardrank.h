@@ -0,0 +1,162 @@
+/*
+ * Poker Hand Evaluation Library
+ * Board rankings: every live hole-card combo on a board, sorted
+ */
+
+#ifndef POKER_BOARDRANK_H
+#define POKER_BOARDRANK_H
+
+#include "poker_strength.h"
+
+/*
+ * Board ranking
+ *
+ * On a 5-card board, 1081 of the HOLE_COMBOS two-card hands are live. A
+ * BoardRanking evaluates each of them once, sorts them weakest first and
+ * stores, per combo, how many live opponent combos it beats, ties and
+ * loses to after card removal (an opponent cannot hold either of its
+ * cards). Queries are then table lookups instead of 1081 evaluations.
+ * Flops and turns are ranked on the board as it stands.
+ *
+ * Arrays indexed by combo use hole_combo_index(); blocked combos (sharing
+ * a card with the board) have value 0, position BOARD_RANK_BLOCKED and
+ * zero counts.
+ */
+
+/* Live combos on a 5-card board: (DECK_SIZE - 5) choose 2 */
+#define BOARD_COMBOS 1081
+
+/* Position of a combo that shares a card with the board */
+#define BOARD_RANK_BLOCKED 0xFFFF
+
+typedef struct {
+    uint64_t board;                    /* Board mask (3-5 cards) */
+    size_t num_combos;                 /* Live combos (BOARD_COMBOS on the river) */
+    uint16_t order[HOLE_COMBOS];       /* Combo indices, weakest first */
+    uint16_t group_end[HOLE_COMBOS];   /* Position one past the last combo tied with order[i] */
+    HandValue value[HOLE_COMBOS];      /* evaluate_mask(combo | board) */
+    uint16_t position[HOLE_COMBOS];    /* Index into order */
+    uint16_t wins[HOLE_COMBOS];        /* Live opponent combos beaten */
+    uint16_t ties[HOLE_COMBOS];        /* ... tied */
+    uint16_t losses[HOLE_COMBOS];      /* ... losing to */
+} BoardRanking;
+
+/**
+ * @brief Rank every live combo on a board
+ * @param board Board mask (3-5 cards)
+ * @param out Pointer to receive the ranking
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int board_ranking_build(const uint64_t board, BoardRanking* const out);
+
+/**
+ * @brief Number of live opponent combos that beat a hand
+ * @param ranking Board ranking
+ * @param hole Two-card mask
+ * @return Combo count, or -1 on error (poker_errno set to POKER_EINVAL for
+ *         a bad hole, POKER_EDUPLICATE if it shares a card with the board)
+ */
+int board_ranking_beaten_by(const BoardRanking* const ranking, const uint64_t hole);
+
+/**
+ * @brief Whether no live opponent combo beats a hand
+ * @param ranking Board ranking
+ * @param hole Two-card mask
+ * @return 1 for the nuts (ties allowed), 0 otherwise, -1 on error (as
+ *         board_ranking_beaten_by())
+ */
+int board_ranking_is_nuts(const BoardRanking* const ranking, const uint64_t hole);
+
+/**
+ * @brief Share of live opponent combos a hand beats, ties counting half
+ *
+ * The HS of hand_strength() against a uniform range.
+ *
+ * @param ranking Board ranking
+ * @param hole Two-card mask
+ * @return Percentile in [0, 1], or -1.0 on error (as board_ranking_beaten_by())
+ */
+double board_ranking_percentile(const BoardRanking* const ranking, const uint64_t hole);
+
+/**
+ * @brief Number of live combos with a value strictly above a given value
+ *
+ * Counts every live combo (no card removal); binary search over the sorted
+ * values, so value need not belong to a live combo.
+ *
+ * @param ranking Board ranking
+ * @param value Packed hand value
+ * @return Combo count in [0, num_combos], or 0 on error (poker_errno set
+ *         to POKER_EINVAL for a NULL ranking)
+ */
+size_t board_ranking_count_above(const BoardRanking* const ranking, const HandValue value);
+
+/**
+ * @brief Showdown value of every combo against a weighted opposing range
+ *
+ * For each live combo c:
+ *
+ *   out_values[c] = sum of opp_weights[o] * (+1 if c beats o, 0 if tied,
+ *                   -1 if o beats c) over live combos o sharing no card
+ *                   with c
+ *   out_totals[c] = sum of those opp_weights[o]
+ *
+ * so out_values[c] / out_totals[c] is the expected showdown result in
+ * [-1, 1] and (out_totals[c] + out_values[c]) / 2 the weight beaten plus
+ * half the weight tied. One sweep up the sorted order keeps running
+ * weights per card and removes the ones sharing a card with c, so the
+ * cost is linear in the combos instead of quadratic in pairs. Call once
+ * per side for a range-vs-range showdown. Blocked combos get 0.
+ *
+ * @param ranking Board ranking
+ * @param opp_weights HOLE_COMBOS opposing weights (NULL = uniform)
+ * @param out_values HOLE_COMBOS values
+ * @param out_totals HOLE_COMBOS opposing weights after card removal (can be NULL)
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int board_ranking_showdown(const BoardRanking* const ranking, const double* const opp_weights,
+                           double* const out_values, double* const out_totals);
+
+/*
+ * Board ranking cache
+ *
+ * Direct-mapped: each board maps to one slot and a miss rebuilds that
+ * slot. A cache is not thread-safe; give each thread its own. Pointers
+ * returned by board_rank_cache_get() stay valid until the next get on the
+ * same cache.
+ */
+typedef struct BoardRankCache BoardRankCache;
+
+/**
+ * @brief Create a cache holding up to capacity rankings
+ * @param capacity Number of slots (>= 1)
+ * @return Pointer to the cache, or NULL on error (poker_errno set to
+ *         POKER_EINVAL or POKER_ENOMEM)
+ */
+BoardRankCache* board_rank_cache_create(const size_t capacity);
+
+/**
+ * @brief Free a cache and every ranking it holds
+ * @param cache Cache to free (can be NULL)
+ */
+void board_rank_cache_destroy(BoardRankCache* const cache);
+
+/**
+ * @brief Ranking of a board, built on a miss
+ * @param cache Cache
+ * @param board Board mask (3-5 cards)
+ * @return Pointer to the ranking, or NULL on error (poker_errno set to
+ *         POKER_EINVAL)
+ */
+const BoardRanking* board_rank_cache_get(BoardRankCache* const cache, const uint64_t board);
+
+/**
+ * @brief Hit and miss counts since the cache was created
+ * @param cache Cache
+ * @param out_hits Receives the hit count (can be NULL)
+ * @param out_misses Receives the miss count (can be NULL)
+ */
+void board_rank_cache_stats(const BoardRankCache* const cache, uint64_t* const out_hits,
+                            uint64_t* const out_misses);
+
+#endif /* POKER_BOARDRANK_H */
@@ -0,0 +1,50 @@
+/*
+ * Poker Hand Evaluation Library
+ * All-in equity of known hole cards against each other
+ */
+
+#ifndef POKER_EQUITY_H
+#define POKER_EQUITY_H
+
+#include "poker.h"
+
+/*
+ * Equity is each player's expected share of the pot when the remaining
+ * board cards are dealt from the cards not held, on the board or dead.
+ * Ties split the pot evenly between the tied players.
+ */
+
+/*
+ * Result of calculate_equity()
+ */
+typedef struct {
+    uint64_t trials;               /* Boards evaluated */
+    double equity[MAX_PLAYERS];    /* Expected pot share (sums to 1) */
+    double win[MAX_PLAYERS];       /* Fraction of boards won outright */
+    double tie[MAX_PLAYERS];       /* Fraction of boards split */
+} EquityResult;
+
+/**
+ * @brief Calculate all-in equity for 2 or more players
+ *
+ * With samples == 0 every possible completion of the board is enumerated
+ * (exact). Otherwise samples random completions are drawn (Monte Carlo)
+ * from a generator seeded with seed, so results are reproducible.
+ *
+ * @param hole_masks One two-card mask per player
+ * @param num_players Number of players (2..MAX_PLAYERS)
+ * @param board Known board cards (0-5 cards)
+ * @param dead Cards removed from the deck (can be 0)
+ * @param samples Random boards to draw (0 = enumerate all)
+ * @param seed Generator seed for sampling
+ * @param out Pointer to receive the result
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL for a
+ *         bad player count, hole or board size, POKER_EDUPLICATE if any
+ *         card appears twice)
+ */
+int calculate_equity(const uint64_t* const hole_masks, const size_t num_players,
+                     const uint64_t board, const uint64_t dead,
+                     const size_t samples, const uint64_t seed,
+                     EquityResult* const out);
+
+#endif /* POKER_EQUITY_H */
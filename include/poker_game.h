@@ -0,0 +1,188 @@
+/*
+ * Poker Hand Evaluation Library
+ * No-Limit Hold'em game engine for self-play simulation
+ */
+
+#ifndef POKER_GAME_H
+#define POKER_GAME_H
+
+#include "poker.h"
+
+/*
+ * Game engine
+ *
+ * GameTables holds many independent tables in structure-of-arrays form:
+ * one array per field, indexed by table (per-table fields) or by
+ * table * num_seats + seat (per-seat fields). Everything is allocated once
+ * by game_tables_create(); starting hands, generating legal actions and
+ * applying actions never allocate. Each table deals from its own seeded
+ * generator, so a (seed, action sequence) pair always replays the same hand
+ * and tables can be stepped from different threads.
+ *
+ * Betting follows no-limit rules: blinds (heads-up, the button posts the
+ * small blind and acts first before the flop), a minimum raise of the last
+ * full raise or the big blind, all-ins for less that do not reopen the
+ * betting, and the board run out once at most one player can still act.
+ * Hands end in showdown_settle(), so side pots, split pots and uncalled
+ * chips are paid exactly.
+ */
+
+/* Streets (GameTables.street) */
+#define GAME_STREET_PREFLOP 0
+#define GAME_STREET_FLOP    1
+#define GAME_STREET_TURN    2
+#define GAME_STREET_RIVER   3
+#define GAME_STREET_DONE    4   /* Hand over: won[] and stack[] are final */
+
+/* Actions */
+#define GAME_ACTION_FOLD       0
+#define GAME_ACTION_CHECK_CALL 1
+#define GAME_ACTION_RAISE      2   /* Bet or raise to an amount (all-in included) */
+
+/* GameTables.to_act when no one is to act */
+#define GAME_NO_SEAT 0xFF
+
+/*
+ * Table configuration (shared by every table of a GameTables)
+ */
+typedef struct {
+    size_t num_seats;          /* Seats per table (2..MAX_PLAYERS) */
+    uint32_t small_blind;
+    uint32_t big_blind;        /* Also the minimum bet */
+    uint32_t starting_stack;   /* Stack for game_start_hand() without stacks */
+} GameConfig;
+
+/*
+ * Structure-of-arrays table state
+ *
+ * Read freely; change only through the game_* functions.
+ */
+typedef struct {
+    GameConfig config;
+    size_t capacity;           /* Number of tables */
+
+    /* Per table */
+    uint8_t* street;           /* GAME_STREET_* */
+    uint8_t* to_act;           /* Seat to act, or GAME_NO_SEAT */
+    uint8_t* button;
+    uint16_t* seated;          /* Bit per seat dealt into the hand */
+    uint16_t* folded;          /* Bit per folded seat (and per empty seat) */
+    uint16_t* all_in;          /* Bit per seat with no chips behind */
+    uint16_t* acted;           /* Bit per seat that acted since the last full raise */
+    uint32_t* current_bet;     /* Highest commitment this street */
+    uint32_t* min_raise;       /* Smallest legal raise increment */
+    uint32_t* pot;             /* Chips put in this hand, all streets */
+    uint64_t* board;           /* Board card mask */
+    uint64_t* dealt;           /* Every card dealt this hand */
+    uint64_t* rng;             /* Dealing generator state */
+
+    /* Per seat (capacity * num_seats, index table * num_seats + seat) */
+    uint32_t* stack;           /* Chips behind */
+    uint32_t* committed;       /* Chips put in this street */
+    uint32_t* contributed;     /* Chips put in this hand */
+    uint32_t* won;             /* Chips won at the end of the hand */
+    uint64_t* hole;            /* Hole card mask */
+} GameTables;
+
+/*
+ * Legal actions for the seat to act
+ */
+typedef struct {
+    unsigned actions;          /* Bit (1 << GAME_ACTION_*) per legal action */
+    uint8_t seat;
+    uint32_t to_call;          /* Chips a CHECK_CALL puts in (0 = check) */
+    uint32_t min_raise_to;     /* Smallest RAISE amount (total this street) */
+    uint32_t max_raise_to;     /* Largest RAISE amount (all-in) */
+} GameLegal;
+
+/**
+ * @brief Allocate state for a number of tables
+ * @param config Table configuration
+ * @param capacity Number of tables (at least 1)
+ * @return New tables (every hand over until started), or NULL on error
+ *         (poker_errno set to POKER_EINVAL or POKER_ENOMEM)
+ */
+GameTables* game_tables_create(const GameConfig* const config, const size_t capacity);
+
+/**
+ * @brief Free tables
+ * @param tables Tables to free (can be NULL)
+ */
+void game_tables_destroy(GameTables* const tables);
+
+/**
+ * @brief Change the blinds of hands started from now on, on every table
+ * @param tables Tables
+ * @param small_blind Small blind (at least 1)
+ * @param big_blind Big blind (at least small_blind)
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int game_set_blinds(GameTables* const tables, const uint32_t small_blind,
+                    const uint32_t big_blind);
+
+/**
+ * @brief Start a hand: reset the table, post blinds and deal hole cards
+ *
+ * Seats with an empty stack sit the hand out. The small blind is the first
+ * seated seat after the button (the button itself when two are seated),
+ * the big blind the next one.
+ *
+ * @param tables Tables
+ * @param table Table index
+ * @param button Button seat (must be seated)
+ * @param seed Dealing seed
+ * @param stacks num_seats starting stacks (NULL = config.starting_stack each)
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL, or
+ *         as game_apply() if the blinds end the hand)
+ */
+int game_start_hand(GameTables* const tables, const size_t table, const size_t button,
+                    const uint64_t seed, const uint32_t* const stacks);
+
+/**
+ * @brief Get the legal actions of the seat to act
+ * @param tables Tables
+ * @param table Table index
+ * @param out Receives the legal actions
+ * @return 0 on success, -1 if the hand is over or table is out of range
+ *         (poker_errno set to POKER_EINVAL)
+ */
+int game_legal_actions(const GameTables* const tables, const size_t table,
+                       GameLegal* const out);
+
+/**
+ * @brief Apply an action for the seat to act and advance the hand
+ *
+ * Streets are dealt when betting rounds close; the hand is settled when
+ * one player is left or after the river.
+ *
+ * @param tables Tables
+ * @param table Table index
+ * @param action GAME_ACTION_*
+ * @param raise_to RAISE: total commitment this street (ignored otherwise)
+ * @return 0 on success, -1 if the action is illegal (table unchanged,
+ *         poker_errno set to POKER_EINVAL) or the hand ended and could not
+ *         be settled (every seat gets its contribution back, poker_errno
+ *         set by showdown_settle())
+ */
+int game_apply(GameTables* const tables, const size_t table, const int action,
+               const uint32_t raise_to);
+
+/**
+ * @brief Apply one action per table to tables [0, count)
+ *
+ * Tables whose hand is over are skipped. An illegal action leaves its
+ * table unchanged; the others are still applied.
+ *
+ * @param tables Tables
+ * @param actions count actions (GAME_ACTION_*)
+ * @param raise_to count raise amounts (can be NULL if no action is RAISE)
+ * @param count Number of tables to step (at most capacity)
+ * @param out_live Receives the number of tables still in play (can be NULL)
+ * @return 0 on success, -1 if any action failed as in game_apply() or
+ *         arguments are bad (poker_errno set to POKER_EINVAL)
+ */
+int game_apply_batch(GameTables* const tables, const uint8_t* const actions,
+                     const uint32_t* const raise_to, const size_t count,
+                     size_t* const out_live);
+
+#endif /* POKER_GAME_H */
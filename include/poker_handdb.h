@@ -0,0 +1,166 @@
+/*
+ * Poker Hand Evaluation Library
+ * Columnar on-disk database of evaluated hands with block skip indices
+ */
+
+#ifndef POKER_HANDDB_H
+#define POKER_HANDDB_H
+
+#include "poker_history.h"
+
+/*
+ * A hand database stores one row per player whose hole cards are known in
+ * a hand (hero or shown down), with the hand already evaluated against the
+ * board. Rows are grouped into blocks; within a block every column is a
+ * contiguous array, so a query touches only the columns it filters on.
+ *
+ * Each block carries a skip index: min/max hand strength, min/max hand id,
+ * a bitmap of hand categories present, a bitmap of results present and
+ * whether any hero rows exist. Queries consult the index first and skip
+ * blocks that cannot match without reading their columns. Appending rows
+ * roughly sorted by what is queried (e.g., by strength or category) makes
+ * the indices most selective.
+ *
+ * Columns are stored in host byte order; files carry an endianness marker
+ * and are rejected (POKER_EFORMAT) on a host of the other byte order.
+ */
+
+#define HANDDB_FORMAT_VERSION 1
+
+/* Default rows per block */
+#define HANDDB_DEFAULT_BLOCK_ROWS 65536
+
+/*
+ * Row results (one bit each so queries can OR them together)
+ */
+#define HANDDB_RESULT_WON     0x01  /* Sole winner of a pot */
+#define HANDDB_RESULT_SPLIT   0x02  /* One of several winners */
+#define HANDDB_RESULT_LOST    0x04  /* Did not collect */
+#define HANDDB_RESULT_UNKNOWN 0x08  /* Hand recorded no winners */
+
+/* Category bitmap bit for a HandCategory (bit 0 = not evaluated) */
+#define HANDDB_CATEGORY_BIT(category) ((uint16_t)(1u << (category)))
+
+/*
+ * One materialized row
+ */
+typedef struct {
+    uint64_t row;              /* Row number in the database */
+    uint64_t hand_id;          /* Site hand number */
+    uint8_t hole[HOLE_SIZE];   /* CARD_INDEX values */
+    uint8_t board[BOARD_SIZE]; /* CARD_INDEX values (board_len valid) */
+    uint8_t board_len;         /* 0-5 */
+    uint8_t is_hero;           /* Row is the hand's hero */
+    uint8_t showdown;          /* Player showed down */
+    uint8_t result;            /* One HANDDB_RESULT_* value */
+    HandCategory category;     /* 0 if the board had fewer than 3 cards */
+    HandValue strength;        /* Packed best-hand value, 0 if not evaluated */
+} HandDbRow;
+
+/*
+ * Query predicate; every set field must match (zeroed = match all)
+ */
+typedef struct {
+    uint16_t categories;       /* HANDDB_CATEGORY_BIT() set, 0 = any */
+    uint8_t results;           /* HANDDB_RESULT_* set, 0 = any */
+    int hero_only;             /* Non-zero: hero rows only */
+    HandValue min_strength;    /* Inclusive lower bound */
+    HandValue max_strength;    /* Inclusive upper bound, 0 = none */
+    uint64_t min_hand_id;      /* Inclusive lower bound */
+    uint64_t max_hand_id;      /* Inclusive upper bound, 0 = none */
+} HandDbQuery;
+
+/*
+ * Work done by a query
+ */
+typedef struct {
+    size_t blocks_total;       /* Blocks in the database */
+    size_t blocks_scanned;     /* Blocks whose columns were read */
+    uint64_t rows_scanned;     /* Rows tested in scanned blocks */
+    uint64_t rows_matched;     /* Rows that satisfied the query */
+} HandDbQueryStats;
+
+/**
+ * @brief Receives one matching row
+ * @param row Matching row (valid only during the call)
+ * @param user_data Caller context passed to handdb_query()
+ * @return 0 to continue, non-zero to stop the query
+ */
+typedef int (*HandDbRowCallback)(const HandDbRow* row, void* user_data);
+
+/* Streaming database builder (opaque) */
+typedef struct HandDbWriter HandDbWriter;
+
+/* Read-only memory-mapped database (opaque) */
+typedef struct HandDb HandDb;
+
+/**
+ * @brief Create a hand database file
+ * @param path Output file path (truncated if it exists)
+ * @param block_rows Rows per block (0 = HANDDB_DEFAULT_BLOCK_ROWS)
+ * @return Writer, or NULL on error (poker_errno set; POKER_ENOTFOUND if the
+ *         file cannot be created)
+ */
+HandDbWriter* handdb_writer_open(const char* const path, const size_t block_rows);
+
+/**
+ * @brief Evaluate hand records and append their rows
+ *
+ * Adds a row for each player with both hole cards known; hands with fewer
+ * than three board cards are stored with strength 0 and category 0. The
+ * whole batch is validated first, so an invalid record appends nothing.
+ *
+ * @param writer Writer
+ * @param records Records to add
+ * @param count Number of records
+ * @return 0 on success, -1 on error (poker_errno set; POKER_EINVAL for an
+ *         invalid record, POKER_EIO on write failure)
+ */
+int handdb_writer_append(HandDbWriter* const writer, const HandRecord* const records,
+                         const size_t count);
+
+/**
+ * @brief Flush the last block, write the index and close the file
+ *
+ * Always releases the writer, even on error.
+ *
+ * @param writer Writer (can be NULL)
+ * @return 0 on success, -1 on error (poker_errno set)
+ */
+int handdb_writer_close(HandDbWriter* const writer);
+
+/**
+ * @brief Open a hand database for querying
+ * @param path Database file path
+ * @return Database handle, or NULL on error (poker_errno set; POKER_EFORMAT
+ *         for an invalid file)
+ */
+HandDb* handdb_open(const char* const path);
+
+/**
+ * @brief Total rows in the database
+ * @param db Database
+ * @return Row count
+ */
+uint64_t handdb_row_count(const HandDb* const db);
+
+/**
+ * @brief Run a query, skipping blocks whose indices rule out any match
+ * @param db Database
+ * @param query Predicate (NULL = match all)
+ * @param callback Receives each match in row order (NULL = count only)
+ * @param user_data Passed through to callback
+ * @param out_stats Optional pointer to receive work statistics
+ * @return 0 on success (including early stop), -1 on error (poker_errno set)
+ */
+int handdb_query(const HandDb* const db, const HandDbQuery* const query,
+                 HandDbRowCallback callback, void* const user_data,
+                 HandDbQueryStats* const out_stats);
+
+/**
+ * @brief Unmap and release a database
+ * @param db Database (can be NULL)
+ */
+void handdb_close(HandDb* const db);
+
+#endif /* POKER_HANDDB_H */
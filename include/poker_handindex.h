@@ -0,0 +1,98 @@
+/*
+ * Poker Hand Evaluation Library
+ * Suit-isomorphic hand indexing
+ */
+
+#ifndef POKER_HANDINDEX_H
+#define POKER_HANDINDEX_H
+
+#include "poker.h"
+
+/*
+ * Hand indexing
+ *
+ * Hands that differ only by a renaming of suits play identically, so
+ * abstraction and solver tables store one entry per isomorphism class.
+ * hand_index() maps hole cards plus the board dealt so far to a dense
+ * index in [0, hand_index_count(street)), the same for every hand in a
+ * class; hand_unindex() returns a canonical member of a class.
+ *
+ *   Street    Cards               Classes
+ *   preflop   2                   169
+ *   flop      2 + 3               1,286,792
+ *   turn      2 + 4               13,960,050
+ *   river     2 + 5               123,156,254
+ *
+ * Cards are card indices (CARD_INDEX()): hole cards first, then the board.
+ * Order within the hole cards or within the board does not matter, so a
+ * turn card is interchangeable with a flop card (the indices forget deal
+ * order, which equity-based abstractions never look at).
+ *
+ * Boards alone are indexed the same way (3, 4 and 5 cards) so table
+ * builders can visit one representative per board class.
+ *
+ * Indices are computed per suit: the ranks a suit received in each round
+ * are ranked combinatorially, suits are sorted, and suits with the same
+ * per-round card counts are combined as a multiset. No lookup tables
+ * beyond small binomial tables are needed.
+ */
+
+/* Streets */
+#define HAND_INDEX_PREFLOP 0
+#define HAND_INDEX_FLOP    1
+#define HAND_INDEX_TURN    2
+#define HAND_INDEX_RIVER   3
+#define HAND_INDEX_STREETS 4
+
+/**
+ * @brief Number of hand classes on a street
+ * @param street HAND_INDEX_PREFLOP..HAND_INDEX_RIVER
+ * @return Class count, or 0 for a bad street
+ */
+uint64_t hand_index_count(const int street);
+
+/**
+ * @brief Index of a hand's isomorphism class
+ * @param cards Hole cards then board cards
+ * @param num_cards 2, 5, 6 or 7 (selects the street)
+ * @param out Receives the index
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL for
+ *         a bad count or card, POKER_EDUPLICATE for a repeated card)
+ */
+int hand_index(const uint8_t* const cards, const size_t num_cards, uint64_t* const out);
+
+/**
+ * @brief Canonical hand of a class
+ * @param street Street
+ * @param index Class index (< hand_index_count(street))
+ * @param out_cards Receives 2, 5, 6 or 7 cards in hand_index() order, each part ascending
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int hand_unindex(const int street, const uint64_t index, uint8_t* const out_cards);
+
+/**
+ * @brief Number of board classes on a street (flop 1,755, turn 16,432, river 134,459)
+ * @param street HAND_INDEX_FLOP..HAND_INDEX_RIVER (preflop has one empty board)
+ * @return Class count, or 0 for a bad street
+ */
+uint64_t board_index_count(const int street);
+
+/**
+ * @brief Index of a board's isomorphism class
+ * @param cards Board cards
+ * @param num_cards 3, 4 or 5
+ * @param out Receives the index
+ * @return 0 on success, -1 on error (as hand_index())
+ */
+int board_index(const uint8_t* const cards, const size_t num_cards, uint64_t* const out);
+
+/**
+ * @brief Canonical board of a class
+ * @param street HAND_INDEX_FLOP..HAND_INDEX_RIVER
+ * @param index Class index (< board_index_count(street))
+ * @param out_cards Receives 3, 4 or 5 cards, ascending
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int board_unindex(const int street, const uint64_t index, uint8_t* const out_cards);
+
+#endif /* POKER_HANDINDEX_H */
@@ -0,0 +1,178 @@
+/*
+ * Poker Hand Evaluation Library
+ * Hand-history ingestion: compact hand records and text history parsing
+ */
+
+#ifndef POKER_HISTORY_H
+#define POKER_HISTORY_H
+
+#include "poker.h"
+
+/*
+ * Sentinel values for HandRecord fields
+ */
+#define CARD_INDEX_NONE 0xFF  /* Unknown card (hole cards not shown) */
+#define PLAYER_NONE     0xFF  /* No player (e.g., hero not dealt in) */
+
+/*
+ * HandRecord structure
+ *
+ * Compact, fixed-size summary of one played hand as needed by evaluation
+ * and analysis: known hole cards, the board, and who showed down and won.
+ * Cards are stored as CARD_INDEX values (0-51) so a record is 40 bytes
+ * instead of holding 2-byte Card structs and player names.
+ *
+ * Players are numbered 0..num_players-1 in seat order as listed in the
+ * hand header. Bit i of showdown_mask / winner_mask refers to player i.
+ */
+typedef struct {
+    uint64_t hand_id;                       /* Site hand number (0 if none) */
+    uint8_t hole[MAX_PLAYERS][HOLE_SIZE];   /* CARD_INDEX or CARD_INDEX_NONE */
+    uint8_t board[BOARD_SIZE];              /* CARD_INDEX values */
+    uint8_t board_len;                      /* Valid board cards (0-5) */
+    uint8_t num_players;                    /* Players seated (1-MAX_PLAYERS) */
+    uint8_t hero;                           /* Player dealt visible cards, or PLAYER_NONE */
+    uint16_t showdown_mask;                 /* Players that showed cards */
+    uint16_t winner_mask;                   /* Players that collected a pot */
+} HandRecord;
+
+/*
+ * HistoryResult structure
+ *
+ * Output of bulk ingestion. Records are in file order. Hands that could not
+ * be parsed (truncated text, invalid or duplicate cards, too many seats) are
+ * counted in skipped rather than aborting the whole file.
+ */
+typedef struct {
+    HandRecord* records;  /* Heap array of parsed records */
+    size_t count;         /* Number of valid records */
+    size_t skipped;       /* Hands rejected as malformed */
+} HistoryResult;
+
+/**
+ * @brief Find the start of the next hand in a text history
+ *
+ * A hand starts at a line beginning with "PokerStars " (PokerStars) or
+ * "Poker Hand #" (GGPoker).
+ *
+ * @param data History text
+ * @param len Length of data in bytes
+ * @param pos Offset to start searching from
+ * @return Offset of the next hand header at or after pos, or len if none
+ */
+size_t history_next_hand(const char* const data, const size_t len, const size_t pos);
+
+/**
+ * @brief Parse the text of a single hand into a HandRecord
+ * @param text Hand text starting at its header line
+ * @param len Length of text in bytes
+ * @param out_record Pointer to receive the parsed record
+ * @return 0 on success, -1 on error (poker_errno set)
+ */
+int history_parse_hand(const char* const text, const size_t len,
+                       HandRecord* const out_record);
+
+/**
+ * @brief Parse every hand in an in-memory history buffer
+ *
+ * The buffer is split into num_threads byte ranges, each snapped forward to
+ * a hand boundary, and parsed in parallel. Results are concatenated in
+ * buffer order, so output is identical for any thread count.
+ *
+ * @param data History text
+ * @param len Length of data in bytes
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out_result Result to fill; release with history_result_free()
+ * @return 0 on success, -1 on error (poker_errno set)
+ */
+int history_parse_buffer(const char* const data, const size_t len,
+                         const size_t num_threads,
+                         HistoryResult* const out_result);
+
+/**
+ * @brief Memory-map a history file and parse it with history_parse_buffer()
+ * @param path Path to the text history file
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out_result Result to fill; release with history_result_free()
+ * @return 0 on success, -1 on error (poker_errno set; POKER_ENOTFOUND if
+ *         the file cannot be opened or mapped)
+ */
+int history_load_file(const char* const path, const size_t num_threads,
+                      HistoryResult* const out_result);
+
+/**
+ * @brief Free records owned by a HistoryResult
+ *
+ * Safe to call on a zeroed or already-freed result (NULL poisoning).
+ *
+ * @param result Result to release (can be NULL)
+ */
+void history_result_free(HistoryResult* const result);
+
+/*
+ * Directory ingestion
+ *
+ * history_load_directory() reads every regular file in a directory (one
+ * session per file, as many sites export) and hands the decoded records of
+ * each file to a callback. Each worker thread batches open/read/close
+ * through its own io_uring when available, so hundreds of small files are
+ * in flight per syscall; otherwise workers fall back to open + pread.
+ */
+
+/**
+ * @brief Receives the records of one file
+ *
+ * Calls are serialized (never concurrent) but may come from any worker
+ * thread, and files arrive in no particular order. The records array is
+ * only valid for the duration of the call.
+ *
+ * @param name File name within the directory
+ * @param records Records parsed from the file, in file order
+ * @param count Number of records
+ * @param user_data Caller context passed to history_load_directory()
+ * @return 0 to continue, non-zero to stop ingestion early
+ */
+typedef int (*HistoryFileCallback)(const char* name, const HandRecord* records,
+                                   size_t count, void* user_data);
+
+/*
+ * Options for history_load_directory()
+ */
+typedef struct {
+    size_t num_threads;   /* Worker threads (0 = one per online CPU) */
+    size_t queue_depth;   /* Files in flight per io_uring worker (0 = 64) */
+    int use_io_uring;     /* Non-zero: try io_uring first; 0: pread only */
+} HistoryDirOptions;
+
+/*
+ * Statistics reported by history_load_directory()
+ */
+typedef struct {
+    size_t files;         /* Files read successfully */
+    size_t failed_files;  /* Files that could not be opened or read */
+    size_t bytes;         /* Total bytes read */
+    size_t records;       /* Records delivered to the callback */
+    size_t skipped;       /* Malformed hands skipped */
+    int used_io_uring;    /* 1 if any worker ran on io_uring */
+} HistoryDirStats;
+
+/**
+ * @brief Ingest every regular file in a directory
+ *
+ * Hidden files (leading '.') and subdirectories are ignored.
+ *
+ * @param dir_path Directory to read
+ * @param options Options (NULL = defaults: auto threads, io_uring enabled)
+ * @param callback Receives each file's records (required)
+ * @param user_data Passed through to callback
+ * @param out_stats Optional pointer to receive statistics
+ * @return 0 on success (including early stop by callback), -1 on error
+ *         (poker_errno set; POKER_ENOTFOUND if the directory cannot be read)
+ */
+int history_load_directory(const char* const dir_path,
+                           const HistoryDirOptions* const options,
+                           const HistoryFileCallback callback,
+                           void* const user_data,
+                           HistoryDirStats* const out_stats);
+
+#endif /* POKER_HISTORY_H */
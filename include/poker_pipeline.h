@@ -0,0 +1,166 @@
+/*
+ * Poker Hand Evaluation Library
+ * Staged batch pipeline: producers -> evaluators -> aggregators
+ */
+
+#ifndef POKER_PIPELINE_H
+#define POKER_PIPELINE_H
+
+#include "poker_history.h"
+
+/*
+ * A pipeline is a chain of stages connected by bounded lock-free queues of
+ * record batches. The first stage produces batches (reads files, generates
+ * deals), the middle stages transform them (evaluate hands) and the last
+ * stage aggregates them. Each stage runs on its own worker threads.
+ *
+ * All batches come from a fixed pool allocated up front, sized so every
+ * queue can be full and every worker can hold one batch. A fast stage
+ * therefore blocks when its output queue is full instead of growing memory,
+ * and a drained queue puts its consumers to sleep instead of spinning.
+ *
+ * Stage functions of a stage with several threads run concurrently and
+ * must be thread-safe with respect to their context; the worker argument
+ * (0..num_threads-1) can index per-thread state to avoid locking.
+ */
+
+/* Maximum stages in one pipeline */
+#define PIPELINE_MAX_STAGES 8
+
+/* Default records per batch */
+#define PIPELINE_DEFAULT_BATCH_SIZE 1024
+
+/* Stage function result: no more input (source) / stop early (other stages) */
+#define PIPELINE_DONE 1
+
+/*
+ * One batch of records flowing through the pipeline
+ */
+typedef struct {
+    HandRecord* records;   /* capacity records; count valid */
+    HandValue* values;     /* capacity * MAX_PLAYERS slots for evaluated hands */
+    void* scratch;         /* PipelineOptions.scratch_size bytes, NULL if 0 */
+    size_t count;          /* Valid records */
+    size_t capacity;       /* Records the batch can hold (batch_size) */
+    uint64_t sequence;     /* 0, 1, 2... in the order the source forwarded batches */
+} PipelineBatch;
+
+/**
+ * @brief Stage function
+ *
+ * Source (first) stage: receives an empty batch (count 0) to fill. Return 0
+ * when the batch is filled, PIPELINE_DONE when input is exhausted (a
+ * non-empty batch is still forwarded), or a negative value on error.
+ *
+ * Other stages: receive a batch from the previous stage and may modify it
+ * in place. Return 0 to continue, PIPELINE_DONE to stop the whole pipeline
+ * early, or a negative value on error.
+ *
+ * On error the stage should set poker_errno; pipeline_run() reports it.
+ *
+ * @param batch Batch being processed
+ * @param context Stage context (PipelineStage.context)
+ * @param worker Index of the calling worker within its stage
+ * @return 0, PIPELINE_DONE or a negative value (see above)
+ */
+typedef int (*PipelineStageFn)(PipelineBatch* batch, void* context, size_t worker);
+
+/*
+ * Stage description
+ */
+typedef struct {
+    const char* name;      /* Label for statistics (can be NULL) */
+    PipelineStageFn fn;    /* Stage function (required) */
+    void* context;         /* Passed to fn */
+    size_t num_threads;    /* Worker threads for this stage (0 = 1; POKER_MAX_THREADS in total) */
+} PipelineStage;
+
+/*
+ * Options for pipeline_run()
+ */
+typedef struct {
+    size_t batch_size;     /* Records per batch (0 = PIPELINE_DEFAULT_BATCH_SIZE) */
+    size_t queue_capacity; /* Batches per inter-stage queue (0 = 2 per adjacent worker) */
+    size_t scratch_size;   /* Bytes of per-batch scratch for stage output (0 = none) */
+} PipelineOptions;
+
+/*
+ * Per-stage statistics
+ */
+typedef struct {
+    const char* name;      /* PipelineStage.name */
+    size_t num_threads;    /* Workers that ran the stage */
+    uint64_t batches;      /* Batches processed */
+    uint64_t records;      /* Records processed (sum of batch counts) */
+    double busy_sec;       /* Time inside the stage function, summed over workers */
+    double wait_sec;       /* Time blocked on queues, summed over workers */
+    double records_per_sec;/* records / pipeline wall time */
+} PipelineStageStats;
+
+/*
+ * Statistics reported by pipeline_run()
+ */
+typedef struct {
+    double elapsed_sec;    /* Wall time of the whole run */
+    size_t num_stages;     /* Valid entries in stages */
+    size_t pool_batches;   /* Batches allocated (memory bound) */
+    PipelineStageStats stages[PIPELINE_MAX_STAGES];
+} PipelineStats;
+
+/**
+ * @brief Run a pipeline until the source is exhausted
+ *
+ * Returns after every batch produced has passed through every stage, or
+ * after a stage stops the pipeline early or fails. Batches are not
+ * guaranteed to reach later stages in sequence order when a stage has
+ * more than one thread.
+ *
+ * @param stages Stages in order: source first, aggregator last
+ * @param num_stages Number of stages (2..PIPELINE_MAX_STAGES)
+ * @param options Options (NULL = defaults)
+ * @param out_stats Optional pointer to receive statistics
+ * @return 0 on success (including early stop), -1 on error (poker_errno
+ *         set; POKER_EINVAL for bad arguments, POKER_ENOMEM, or the value a
+ *         failing stage left in poker_errno)
+ */
+int pipeline_run(const PipelineStage* const stages, const size_t num_stages,
+                 const PipelineOptions* const options, PipelineStats* const out_stats);
+
+/*
+ * Built-in stages
+ */
+
+/*
+ * Context for pipeline_array_source(): hands out consecutive slices of an
+ * in-memory record array. Zero-initialize next before the run.
+ */
+typedef struct {
+    const HandRecord* records;
+    size_t count;
+    size_t next;           /* Claimed atomically by source workers */
+} PipelineArraySource;
+
+/**
+ * @brief Source stage that copies records from a PipelineArraySource
+ * @param batch Batch to fill
+ * @param context PipelineArraySource
+ * @param worker Unused
+ * @return 0 or PIPELINE_DONE
+ */
+int pipeline_array_source(PipelineBatch* batch, void* context, size_t worker);
+
+/**
+ * @brief Stage that evaluates every known hand in a batch
+ *
+ * Sets values[i * MAX_PLAYERS + p] to evaluate_mask() of player p's hole
+ * cards plus the board of record i, or 0 if the hole cards are unknown, the
+ * player is not seated or the board has fewer than three cards.
+ *
+ * @param batch Batch to evaluate
+ * @param context Unused (can be NULL)
+ * @param worker Unused
+ * @return 0
+ */
+int pipeline_evaluate_stage(PipelineBatch* batch, void* context, size_t worker);
+
+#endif /* POKER_PIPELINE_H */
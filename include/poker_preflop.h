@@ -0,0 +1,121 @@
+/*
+ * Poker Hand Evaluation Library
+ * Exact preflop all-in equities of every combo against every combo
+ */
+
+#ifndef POKER_PREFLOP_H
+#define POKER_PREFLOP_H
+
+#include "poker_strength.h"
+
+/*
+ * Preflop equity matrix
+ *
+ * The all-in equity of hole combo a against combo b (sharing no card) over
+ * all PREFLOP_BOARDS boards, exactly, for all 1326 x 1225 ordered
+ * matchups. Card removal is exact: AhKh against QhJh differs from AhKh
+ * against QsJs.
+ *
+ * Matchups that differ only by renaming suits have equal equity, so the
+ * matrix is stored per matchup class: PREFLOP_MATCHUP_CLASSES ordered
+ * classes instead of 1,624,350 ordered matchups. Values are exact
+ * half-point scores (2 per board won, 1 per board tied) out of
+ * 2 * PREFLOP_BOARDS.
+ *
+ * The builder never enumerates matchups. Each of the 134,459 river board
+ * classes (board_index()) is ranked once with board_ranking_build(), every
+ * ordered pair of live combos adds its result on that board to its
+ * matchup class, weighted by the number of boards in the board class, and
+ * each class total is finally divided by its number of matchups. Board
+ * classes are split across threads with per-thread class totals, so
+ * results do not depend on the thread count.
+ */
+
+/* Boards per matchup: 48 choose 5 */
+#define PREFLOP_BOARDS 1712304
+
+/* Ordered matchup classes under suit renaming */
+#define PREFLOP_MATCHUP_CLASSES 93769
+
+/* Equity file format version */
+#define PREFLOP_EQUITY_FORMAT_VERSION 1
+
+/*
+ * Equity file layout (little-endian):
+ *
+ *   0   "PEQM"
+ *   4   u8  format version
+ *   5   3 reserved bytes
+ *   8   u32 number of classes
+ *   12  u32 boards per matchup (PREFLOP_BOARDS)
+ *   16  per class, ascending key: u32 key, u32 score
+ *
+ * A class key is a * HOLE_COMBOS + b for the suit renaming of the matchup
+ * that minimizes it (combo indices from hole_combo_index()).
+ */
+
+/* Opaque loaded matrix */
+typedef struct PreflopEquity PreflopEquity;
+
+typedef struct {
+    size_t num_classes;           /* Matchup classes written */
+    size_t board_classes;         /* Boards ranked */
+} PreflopEquityStats;
+
+/**
+ * @brief Compute the matrix and write it to a file
+ * @param path Output file
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out_stats Receives build statistics (can be NULL)
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL,
+ *         POKER_ENOMEM or POKER_EIO)
+ */
+int preflop_equity_build(const char* const path, const size_t num_threads,
+                         PreflopEquityStats* const out_stats);
+
+/**
+ * @brief Load an equity file
+ * @param path File written by preflop_equity_build()
+ * @return Pointer to the matrix, or NULL on error (poker_errno set to
+ *         POKER_EINVAL, POKER_ENOTFOUND, POKER_EFORMAT or POKER_ENOMEM)
+ */
+PreflopEquity* preflop_equity_open(const char* const path);
+
+/**
+ * @brief Free a loaded matrix
+ * @param table Matrix to free (can be NULL)
+ */
+void preflop_equity_close(PreflopEquity* const table);
+
+/**
+ * @brief Exact score of one combo against another
+ * @param table Loaded matrix
+ * @param hole Two-card mask of the player
+ * @param villain Two-card mask of the opponent
+ * @return Half-point score out of 2 * PREFLOP_BOARDS, or -1 on error
+ *         (poker_errno set to POKER_EINVAL for a bad mask,
+ *         POKER_EDUPLICATE if the combos share a card)
+ */
+int64_t preflop_equity_score(const PreflopEquity* const table, const uint64_t hole,
+                             const uint64_t villain);
+
+/**
+ * @brief All-in equity of one combo against another
+ * @param table Loaded matrix
+ * @param hole Two-card mask of the player
+ * @param villain Two-card mask of the opponent
+ * @return Equity in [0, 1], or -1.0 on error (as preflop_equity_score())
+ */
+double preflop_equity(const PreflopEquity* const table, const uint64_t hole,
+                      const uint64_t villain);
+
+/**
+ * @brief Expand the full matrix
+ * @param table Loaded matrix
+ * @param out HOLE_COMBOS * HOLE_COMBOS equities, out[a * HOLE_COMBOS + b]
+ *        for combo indices a and b; 0 where the combos share a card
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int preflop_equity_matrix(const PreflopEquity* const table, double* const out);
+
+#endif /* POKER_PREFLOP_H */
@@ -0,0 +1,134 @@
+/*
+ * Poker Hand Evaluation Library
+ * Heads-up push/fold equilibrium solver
+ */
+
+#ifndef POKER_PUSHFOLD_H
+#define POKER_PUSHFOLD_H
+
+#include "poker_preflop.h"
+
+/*
+ * Push/fold game
+ *
+ * Heads-up, the small blind either folds or moves all-in and the big
+ * blind either folds or calls. Each player has the effective stack (the
+ * most either can lose, blinds and antes included), posts an ante, and
+ * the big blind may also post a big-blind ante. Payoffs are the small
+ * blind's chips won per deal:
+ *
+ *   small blind folds           -(small_blind + ante)
+ *   big blind folds to the jam  +(big_blind + ante + big_blind_ante)
+ *   jam called                  2 * stack * equity - stack
+ *
+ * Hands are dealt without replacement and equities are exact combo
+ * against combo (preflop_equity()), so card removal is exact: AK jams
+ * into fewer big-blind aces than 72 does.
+ *
+ * Both players have an equilibrium that gives every combo of a preflop
+ * class (hand_index(), 169 classes) the same strategy. The solver keeps
+ * one strategy per class and, for a representative combo of each class,
+ * the number of opposing combos of every class it does not block and
+ * their summed equity, which makes each iteration a 169 x 169 sweep with
+ * the exact per-combo payoffs. It runs CFR+ (regret matching+,
+ * alternating updates, linearly weighted averages).
+ */
+
+/* Preflop hand classes */
+#define PUSHFOLD_CLASSES 169
+
+/* Opaque class-level equities */
+typedef struct PushFoldEquities PushFoldEquities;
+
+/*
+ * One spot (stack depth and ante structure), in chips
+ */
+typedef struct {
+    double stack;                 /* Effective stack (> big_blind + ante + big_blind_ante) */
+    double small_blind;           /* (0, big_blind] */
+    double big_blind;             /* > 0 */
+    double ante;                  /* Posted by each player (>= 0) */
+    double big_blind_ante;        /* Posted by the big blind only (>= 0) */
+} PushFoldSpot;
+
+/*
+ * Equilibrium of one spot
+ */
+typedef struct {
+    double jam[PUSHFOLD_CLASSES];     /* Small blind's jam frequency per class */
+    double call[PUSHFOLD_CLASSES];    /* Big blind's call frequency per class */
+    double jam_share;                 /* Fraction of combos jammed */
+    double call_share;                /* Fraction of combos calling */
+    double value;                     /* Small blind's chips per deal */
+    double exploitability;            /* Mean best-response gain, chips per deal */
+} PushFoldResult;
+
+/**
+ * @brief Class-level equities from a loaded preflop matrix
+ * @param table Matrix from preflop_equity_open()
+ * @return Pointer to the equities, or NULL on error (poker_errno set to
+ *         POKER_EINVAL for a NULL or incomplete matrix, POKER_ENOMEM)
+ */
+PushFoldEquities* pushfold_equities_create(const PreflopEquity* const table);
+
+/**
+ * @brief Class-level equities from a matrix file, building it if missing
+ *
+ * If path does not exist the matrix is computed with
+ * preflop_equity_build() (minutes) and saved there first.
+ *
+ * @param path Preflop matrix file
+ * @param num_threads Worker threads for a build (0 = one per online CPU)
+ * @return Pointer to the equities, or NULL on error (as
+ *         preflop_equity_build(), preflop_equity_open() and
+ *         pushfold_equities_create())
+ */
+PushFoldEquities* pushfold_equities_load(const char* const path, const size_t num_threads);
+
+/**
+ * @brief Free class-level equities
+ * @param equities Equities to free (can be NULL)
+ */
+void pushfold_equities_destroy(PushFoldEquities* const equities);
+
+/**
+ * @brief Exact equity of a class against another, after card removal
+ * @param equities Class-level equities
+ * @param hero Hero's class (hand_index() of the hole cards)
+ * @param villain Villain's class
+ * @param out_combos Receives the villain combos one hero combo does not
+ *        block (can be NULL)
+ * @return Mean equity of a hero combo against those combos, 0 if there
+ *         are none, or -1.0 on error (poker_errno set to POKER_EINVAL)
+ */
+double pushfold_class_equity(const PushFoldEquities* const equities, const size_t hero,
+                             const size_t villain, size_t* const out_combos);
+
+/**
+ * @brief Solve spots, in parallel
+ *
+ * Spots are split across threads; each result depends only on its spot
+ * and the iteration count.
+ *
+ * @param equities Class-level equities
+ * @param spots Spots to solve
+ * @param count Number of spots
+ * @param iterations CFR+ iterations per spot (each updates both players)
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out count results
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL for
+ *         a bad spot or zero iterations)
+ */
+int pushfold_solve(const PushFoldEquities* const equities, const PushFoldSpot* const spots,
+                   const size_t count, const size_t iterations, const size_t num_threads,
+                   PushFoldResult* const out);
+
+/**
+ * @brief Expand per-class values to per-combo values
+ * @param class_values PUSHFOLD_CLASSES values (jam or call of a result)
+ * @param out HOLE_COMBOS values by hole_combo_index()
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int pushfold_expand(const double* const class_values, double* const out);
+
+#endif /* POKER_PUSHFOLD_H */
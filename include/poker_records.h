@@ -0,0 +1,171 @@
+/*
+ * Poker Hand Evaluation Library
+ * Compact binary hand-record files: 6-bit cards, compressed blocks, index
+ */
+
+#ifndef POKER_RECORDS_H
+#define POKER_RECORDS_H
+
+#include "poker_history.h"
+
+/*
+ * Binary record file format (all integers little-endian)
+ *
+ *   File header   16 bytes: "PHRB", u16 version, u16 flags, u32 block size, u32 reserved
+ *   Block         20-byte header (u32 records, u32 raw size, u32 stored size,
+ *                 u32 FNV-1a checksum of raw bytes, u32 codec) + stored bytes
+ *   ...
+ *   Index         one 40-byte RecordBlockInfo entry per block
+ *   Trailer       24 bytes: u64 index offset, u64 total records, u32 blocks, "PHRI"
+ *
+ * Inside a block, records are bit-packed LSB-first:
+ *
+ *   4 bits  num_players          4 bits  hero (15 = PLAYER_NONE)
+ *   3 bits  board_len            n bits  showdown_mask, n bits winner_mask
+ *   per player: 1 bit "hole cards known", then 2 x 6-bit card (63 = CARD_INDEX_NONE)
+ *   board_len x 6-bit card
+ *   7-bit length L + L bits: zigzag delta of hand_id from the previous record
+ *
+ * A typical showdown record is about 9 bytes instead of 40. Blocks are
+ * self-contained (the first delta is from 0), so any block can be decoded
+ * on its own from the index. Fields beyond num_players / board_len are not
+ * stored and decode as CARD_INDEX_NONE (hole) and 0 (board), matching
+ * history_parse_hand().
+ */
+
+#define RECORD_FORMAT_VERSION 1
+
+/* Default records per block */
+#define RECORD_DEFAULT_BLOCK_RECORDS 4096
+
+/*
+ * Block codecs
+ */
+#define RECORD_CODEC_NONE 0  /* Stored bit-packed */
+#define RECORD_CODEC_LZ   1  /* Bit-packed, then LZ77 byte compressed */
+
+/*
+ * Index entry describing one block
+ */
+typedef struct {
+    uint64_t offset;         /* File offset of the block header */
+    uint64_t first_record;   /* Record number of the block's first record */
+    uint64_t min_hand_id;    /* Smallest hand_id in the block */
+    uint64_t max_hand_id;    /* Largest hand_id in the block */
+    uint32_t count;          /* Records in the block */
+    uint32_t stored_size;    /* Bytes stored on disk after the block header */
+} RecordBlockInfo;
+
+/*
+ * Options for record_writer_open()
+ */
+typedef struct {
+    size_t block_records;  /* Records per block (0 = RECORD_DEFAULT_BLOCK_RECORDS) */
+    int compress;          /* Non-zero: LZ-compress blocks when it saves space */
+} RecordWriterOptions;
+
+/* Streaming writer (opaque) */
+typedef struct RecordWriter RecordWriter;
+
+/* Streaming reader over a memory-mapped file (opaque) */
+typedef struct RecordReader RecordReader;
+
+/**
+ * @brief Create a record file for writing
+ * @param path Output file path (truncated if it exists)
+ * @param options Options (NULL = defaults: default block size, compression on)
+ * @return Writer, or NULL on error (poker_errno set; POKER_ENOTFOUND if the
+ *         file cannot be created)
+ */
+RecordWriter* record_writer_open(const char* const path,
+                                 const RecordWriterOptions* const options);
+
+/**
+ * @brief Append records to the file
+ *
+ * Records are buffered and written a block at a time.
+ *
+ * @param writer Writer
+ * @param records Records to append
+ * @param count Number of records
+ * @return 0 on success, -1 on error (poker_errno set; POKER_EINVAL for a
+ *         record with out-of-range fields, POKER_EIO on write failure)
+ */
+int record_writer_append(RecordWriter* const writer, const HandRecord* const records,
+                         const size_t count);
+
+/**
+ * @brief Flush the last block, write the index and close the file
+ *
+ * Always releases the writer, even on error.
+ *
+ * @param writer Writer (can be NULL)
+ * @return 0 on success, -1 on error (poker_errno set)
+ */
+int record_writer_close(RecordWriter* const writer);
+
+/**
+ * @brief Open a record file for reading
+ *
+ * Validates the header, trailer and index. Block checksums are verified as
+ * each block is decoded.
+ *
+ * @param path Record file path
+ * @return Reader positioned at record 0, or NULL on error (poker_errno set;
+ *         POKER_ENOTFOUND if the file cannot be opened, POKER_EFORMAT if it
+ *         is not a valid record file)
+ */
+RecordReader* record_reader_open(const char* const path);
+
+/**
+ * @brief Total number of records in the file
+ * @param reader Reader
+ * @return Record count
+ */
+uint64_t record_reader_count(const RecordReader* const reader);
+
+/**
+ * @brief Number of blocks in the file
+ * @param reader Reader
+ * @return Block count
+ */
+size_t record_reader_block_count(const RecordReader* const reader);
+
+/**
+ * @brief Index entry for one block
+ * @param reader Reader
+ * @param block Block number
+ * @param out_info Pointer to receive the entry
+ * @return 0 on success, -1 on error (poker_errno set to POKER_ERANGE if
+ *         block is past the end)
+ */
+int record_reader_block_info(const RecordReader* const reader, const size_t block,
+                             RecordBlockInfo* const out_info);
+
+/**
+ * @brief Read the next records in file order
+ * @param reader Reader
+ * @param out Array to receive records
+ * @param max Capacity of out
+ * @param out_count Receives the number of records read (0 at end of file)
+ * @return 0 on success, -1 on error (poker_errno set; POKER_EFORMAT for a
+ *         corrupt block)
+ */
+int record_reader_read(RecordReader* const reader, HandRecord* const out,
+                       const size_t max, size_t* const out_count);
+
+/**
+ * @brief Position the reader at a record number using the block index
+ * @param reader Reader
+ * @param record Record number (equal to the count seeks to end of file)
+ * @return 0 on success, -1 on error (poker_errno set)
+ */
+int record_reader_seek(RecordReader* const reader, const uint64_t record);
+
+/**
+ * @brief Unmap the file and release the reader
+ * @param reader Reader (can be NULL)
+ */
+void record_reader_close(RecordReader* const reader);
+
+#endif /* POKER_RECORDS_H */
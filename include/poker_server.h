@@ -0,0 +1,220 @@
+/*
+ * Poker Hand Evaluation Library
+ * Local evaluation service over Unix domain sockets: protocol, server and client
+ */
+
+#ifndef POKER_SERVER_H
+#define POKER_SERVER_H
+
+#include "poker_equity.h"
+
+/*
+ * Protocol
+ *
+ * Clients send fixed 16-byte request headers followed by a payload whose
+ * size follows from the request type and count; the server answers each
+ * request with a 16-byte response header and payload. Fields are in host
+ * byte order (the socket is local). A connection may pipeline requests;
+ * responses carry the request id and can arrive in any order.
+ *
+ *   SERVER_REQ_EVALUATE  payload: count uint64_t card masks (5-7 cards)
+ *                        reply:   count uint32_t HandValues
+ *   SERVER_REQ_EQUITY    payload: ServerEquityRequest + count uint64_t
+ *                                 hole masks (count = players)
+ *                        reply:   ServerEquityReply + 3 * count doubles
+ *                                 (equity[], win[], tie[])
+ *   SERVER_REQ_PING      payload: none, reply: none
+ *
+ * deadline_us is the request's time budget from arrival at the server
+ * (0 = none). Requests still queued when it passes are answered with
+ * SERVER_STATUS_DEADLINE instead of being computed; sampled equity is
+ * also abandoned between chunks once it passes.
+ */
+
+#define SERVER_REQ_EVALUATE 1
+#define SERVER_REQ_EQUITY   2
+#define SERVER_REQ_PING     3
+
+#define SERVER_STATUS_OK       0
+#define SERVER_STATUS_INVALID  1  /* Malformed request or invalid cards */
+#define SERVER_STATUS_DEADLINE 2  /* Deadline passed before completion */
+#define SERVER_STATUS_BUSY     3  /* Request queue full, retry later */
+
+/* Largest count in one request */
+#define SERVER_MAX_HANDS 65536
+
+typedef struct {
+    uint32_t id;           /* Echoed in the response */
+    uint16_t type;         /* SERVER_REQ_* */
+    uint16_t reserved;     /* Must be 0 */
+    uint32_t count;        /* Masks (evaluate) or players (equity) */
+    uint32_t deadline_us;  /* Time budget in microseconds (0 = none) */
+} ServerRequestHeader;
+
+typedef struct {
+    uint32_t id;           /* Request id */
+    uint16_t status;       /* SERVER_STATUS_* */
+    uint16_t reserved;
+    uint32_t count;        /* Request count echoed back */
+    uint32_t payload_size; /* Bytes following this header */
+} ServerResponseHeader;
+
+typedef struct {
+    uint64_t board;        /* Known board cards */
+    uint64_t dead;         /* Dead cards */
+    uint32_t samples;      /* 0 = enumerate all boards */
+    uint32_t seed;         /* Sampling seed */
+} ServerEquityRequest;
+
+typedef struct {
+    uint64_t trials;       /* Boards evaluated */
+} ServerEquityReply;
+
+/*
+ * Server
+ *
+ * One I/O thread (the caller of server_run()) accepts connections and
+ * reads requests; worker threads take every request queued at that moment
+ * (up to max_batch hands) and evaluate all masks from all of them in a
+ * single evaluate_masks() call. Under light load a request is served on its
+ * own as soon as it arrives; under heavy load batches grow on their own.
+ * Sockets are nonblocking and responses a client has not read yet are
+ * buffered per connection, so one slow reader never stalls the others.
+ */
+
+/*
+ * Options for server_open()
+ */
+typedef struct {
+    const char* socket_path;   /* Filesystem path of the socket (required) */
+    size_t num_threads;        /* Worker threads (0 = one per online CPU) */
+    size_t max_batch;          /* Hands per coalesced batch (0 = 4096) */
+    size_t max_pending;        /* Queued requests before BUSY replies (0 = 1024) */
+    size_t max_connections;    /* Concurrent clients (0 = 256) */
+} ServerOptions;
+
+/*
+ * Counters reported by server_get_stats()
+ */
+typedef struct {
+    uint64_t connections;      /* Connections accepted */
+    uint64_t requests;         /* Requests received */
+    uint64_t batches;          /* Worker wake-ups that served requests */
+    uint64_t hands;            /* Masks evaluated */
+    uint64_t equity_requests;  /* Equity requests computed */
+    uint64_t deadline_misses;  /* Requests answered with SERVER_STATUS_DEADLINE */
+    uint64_t rejected;         /* Requests answered with BUSY or INVALID */
+    uint64_t max_batch_requests; /* Most requests coalesced into one batch */
+} ServerStats;
+
+/* Running server (opaque) */
+typedef struct PokerServer PokerServer;
+
+/**
+ * @brief Create the socket and start listening
+ *
+ * Removes a stale socket file at the same path first. Clients can connect
+ * as soon as this returns; requests are served once server_run() starts.
+ *
+ * @param options Server options
+ * @return Server, or NULL on error (poker_errno set; POKER_EIO if the
+ *         socket cannot be created)
+ */
+PokerServer* server_open(const ServerOptions* const options);
+
+/**
+ * @brief Serve requests until server_stop() is called
+ *
+ * Starts the worker threads and runs the I/O loop on the calling thread.
+ * Requests already queued when stopping are still answered.
+ *
+ * @param server Server
+ * @return 0 on clean stop, -1 on error (poker_errno set)
+ */
+int server_run(PokerServer* const server);
+
+/**
+ * @brief Ask server_run() to return
+ *
+ * Async-signal-safe: may be called from a signal handler or another thread.
+ *
+ * @param server Server
+ */
+void server_stop(PokerServer* const server);
+
+/**
+ * @brief Snapshot the server counters
+ * @param server Server
+ * @param out_stats Pointer to receive counters
+ */
+void server_get_stats(PokerServer* const server, ServerStats* const out_stats);
+
+/**
+ * @brief Close the socket, remove the socket file and free the server
+ * @param server Server (can be NULL; must not be running)
+ */
+void server_close(PokerServer* const server);
+
+/*
+ * Client
+ *
+ * Blocking client for one request at a time per connection. Errors map to
+ * poker_errno: POKER_EINVAL (invalid request), POKER_ETIMEDOUT (deadline),
+ * POKER_EBUSY (server overloaded), POKER_EIO (connection failure).
+ */
+
+/* Client connection (opaque) */
+typedef struct PokerClient PokerClient;
+
+/**
+ * @brief Connect to a server
+ * @param socket_path Server socket path
+ * @return Client, or NULL on error (poker_errno set to POKER_EIO)
+ */
+PokerClient* client_connect(const char* const socket_path);
+
+/**
+ * @brief Evaluate card masks on the server
+ * @param client Client
+ * @param masks Card masks (5-7 cards each)
+ * @param count Number of masks (1..SERVER_MAX_HANDS)
+ * @param deadline_us Time budget in microseconds (0 = none)
+ * @param out_values Receives one HandValue per mask (0 for invalid masks)
+ * @return 0 on success, -1 on error (poker_errno set)
+ */
+int client_evaluate(PokerClient* const client, const uint64_t* const masks,
+                    const size_t count, const uint32_t deadline_us,
+                    HandValue* const out_values);
+
+/**
+ * @brief Calculate equity on the server (see calculate_equity())
+ * @param client Client
+ * @param hole_masks One two-card mask per player
+ * @param num_players Number of players (2..MAX_PLAYERS)
+ * @param board Known board cards
+ * @param dead Dead cards
+ * @param samples Random boards (0 = enumerate all)
+ * @param seed Sampling seed
+ * @param deadline_us Time budget in microseconds (0 = none)
+ * @param out Pointer to receive the result
+ * @return 0 on success, -1 on error (poker_errno set)
+ */
+int client_equity(PokerClient* const client, const uint64_t* const hole_masks,
+                  const size_t num_players, const uint64_t board, const uint64_t dead,
+                  const uint32_t samples, const uint32_t seed, const uint32_t deadline_us,
+                  EquityResult* const out);
+
+/**
+ * @brief Round-trip an empty request (health check)
+ * @param client Client
+ * @return 0 on success, -1 on error (poker_errno set)
+ */
+int client_ping(PokerClient* const client);
+
+/**
+ * @brief Close a client connection
+ * @param client Client (can be NULL)
+ */
+void client_close(PokerClient* const client);
+
+#endif /* POKER_SERVER_H */
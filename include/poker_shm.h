@@ -0,0 +1,156 @@
+/*
+ * Poker Hand Evaluation Library
+ * Shared-memory ring IPC between client processes and one evaluator process
+ */
+
+#ifndef POKER_SHM_H
+#define POKER_SHM_H
+
+#include "poker.h"
+
+/*
+ * The evaluator process creates a file-backed shared mapping (put it under
+ * /dev/shm for a RAM-only segment) holding one or more rings of slots.
+ * Each slot carries a request of up to slot_hands card masks and, once
+ * served, their HandValues in place.
+ *
+ * Clients claim a slot, write masks and publish it; the evaluator polls
+ * every ring, evaluates each published slot with evaluate_masks() and marks
+ * it done; the client copies the values out and frees the slot. A ring can
+ * be shared by several clients (multi-producer, single consumer) or given
+ * to one client (single producer, uncontended). No system call is made
+ * while both sides are busy: each side spins briefly, then sleeps on a
+ * futex in the mapping and is woken only when the other side sees it
+ * sleeping (Linux; elsewhere idle sides poll with short sleeps).
+ */
+
+/* Defaults for ShmRingOptions fields left at 0 */
+#define SHM_DEFAULT_RINGS      4
+#define SHM_DEFAULT_RING_SLOTS 64
+#define SHM_DEFAULT_SLOT_HANDS 256
+
+/*
+ * Options for shm_evaluator_create()
+ */
+typedef struct {
+    size_t num_rings;      /* Rings in the segment (0 = 4) */
+    size_t ring_slots;     /* Slots per ring, a power of two (0 = 64) */
+    size_t slot_hands;     /* Masks per slot (0 = 256) */
+} ShmRingOptions;
+
+/*
+ * Counters reported by shm_evaluator_get_stats()
+ */
+typedef struct {
+    uint64_t requests;     /* Slots served */
+    uint64_t hands;        /* Masks evaluated */
+    uint64_t polls;        /* Passes over the rings that found work */
+    uint64_t sleeps;       /* Times the evaluator went idle on its futex */
+} ShmStats;
+
+/* Evaluator side of a segment (opaque) */
+typedef struct ShmEvaluator ShmEvaluator;
+
+/* Client attached to one ring (opaque) */
+typedef struct ShmClient ShmClient;
+
+/**
+ * @brief Create the shared segment
+ *
+ * Replaces a segment file left at path by an earlier evaluator; any other
+ * file there is refused and left untouched. Clients can attach as soon as
+ * this returns.
+ *
+ * @param path File to map (e.g. "/dev/shm/poker-eval")
+ * @param options Ring geometry (NULL = defaults)
+ * @return Evaluator, or NULL on error (poker_errno set to POKER_EINVAL for
+ *         bad options, POKER_EIO if path holds another file or the segment
+ *         cannot be created or mapped)
+ */
+ShmEvaluator* shm_evaluator_create(const char* const path, const ShmRingOptions* const options);
+
+/**
+ * @brief Serve every published slot once
+ *
+ * For callers that embed the evaluator in their own loop.
+ *
+ * @param evaluator Evaluator
+ * @return Number of slots served
+ */
+size_t shm_evaluator_poll(ShmEvaluator* const evaluator);
+
+/**
+ * @brief Serve requests until shm_evaluator_stop() is called
+ *
+ * Polls the rings, sleeping on the segment futex when idle.
+ *
+ * @param evaluator Evaluator
+ * @return 0 on success, -1 on invalid argument (poker_errno set)
+ */
+int shm_evaluator_run(ShmEvaluator* const evaluator);
+
+/**
+ * @brief Ask shm_evaluator_run() to return
+ *
+ * Async-signal-safe: may be called from a signal handler or another thread.
+ *
+ * @param evaluator Evaluator
+ */
+void shm_evaluator_stop(ShmEvaluator* const evaluator);
+
+/**
+ * @brief Snapshot the evaluator counters
+ * @param evaluator Evaluator
+ * @param out_stats Pointer to receive counters
+ */
+void shm_evaluator_get_stats(ShmEvaluator* const evaluator, ShmStats* const out_stats);
+
+/**
+ * @brief Mark the segment closed, unmap it and remove the file
+ *
+ * Clients waiting on a request fail with POKER_EIO.
+ *
+ * @param evaluator Evaluator (can be NULL; must not be running)
+ */
+void shm_evaluator_destroy(ShmEvaluator* const evaluator);
+
+/**
+ * @brief Attach to a ring of an evaluator's segment
+ * @param path Segment file passed to shm_evaluator_create()
+ * @param ring Ring index (clients may share a ring)
+ * @return Client, or NULL on error (poker_errno set to POKER_EIO if the
+ *         segment cannot be mapped, POKER_EFORMAT if it is not a segment,
+ *         POKER_ERANGE if ring is out of range)
+ */
+ShmClient* shm_client_attach(const char* const path, const size_t ring);
+
+/**
+ * @brief Evaluate card masks through the ring
+ *
+ * Masks are split into slot-sized requests; several are kept in flight at
+ * once.
+ *
+ * @param client Client
+ * @param masks Card masks (5-7 cards each)
+ * @param count Number of masks
+ * @param out_values Receives one HandValue per mask (0 for invalid masks)
+ * @return 0 on success, -1 on error (poker_errno set; POKER_EIO if the
+ *         evaluator shut down)
+ */
+int shm_client_evaluate(ShmClient* const client, const uint64_t* const masks,
+                        const size_t count, HandValue* const out_values);
+
+/**
+ * @brief Masks per slot (largest single request)
+ * @param client Client
+ * @return Slot capacity in masks
+ */
+size_t shm_client_slot_hands(const ShmClient* const client);
+
+/**
+ * @brief Unmap the segment
+ * @param client Client (can be NULL)
+ */
+void shm_client_detach(ShmClient* const client);
+
+#endif /* POKER_SHM_H */
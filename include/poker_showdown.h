@@ -0,0 +1,154 @@
+/*
+ * Poker Hand Evaluation Library
+ * Showdown resolution: winners and exact pot splits
+ */
+
+#ifndef POKER_SHOWDOWN_H
+#define POKER_SHOWDOWN_H
+
+#include "poker.h"
+
+/*
+ * Odd-chip rules
+ *
+ * When a pot does not divide evenly between tied winners, each leftover
+ * chip (at most winners - 1 of them) goes to a different winner:
+ *
+ *   SHOWDOWN_ODD_CHIP_POSITION   Winners in seat order starting at
+ *                                ShowdownPot.first_seat (the first seat
+ *                                left of the button in flop games)
+ *   SHOWDOWN_ODD_CHIP_HIGH_CARD  Winners by their highest hole card, rank
+ *                                first, then suit (spades, hearts,
+ *                                diamonds, clubs)
+ */
+#define SHOWDOWN_ODD_CHIP_POSITION  0
+#define SHOWDOWN_ODD_CHIP_HIGH_CARD 1
+
+/*
+ * One seat at showdown. Folded seats are skipped: they neither win nor
+ * have their cards checked.
+ */
+typedef struct {
+    uint64_t hole;         /* Hole-card mask (HOLE_SIZE cards) */
+    int folded;            /* Nonzero if the player folded */
+} ShowdownPlayer;
+
+/*
+ * Pot to award
+ */
+typedef struct {
+    uint64_t amount;       /* Chips, in the smallest unit that can be split */
+    size_t first_seat;     /* SHOWDOWN_ODD_CHIP_POSITION: first seat to get an odd chip */
+    int odd_chip_rule;     /* SHOWDOWN_ODD_CHIP_* */
+} ShowdownPot;
+
+/**
+ * @brief Find the winners of a showdown and split the pot between them
+ *
+ * Every live hand is evaluated with evaluate_mask(); the highest HandValue
+ * wins and equal values split. A single live player wins without a
+ * showdown (the board may then be incomplete).
+ *
+ * @param players Seats (index = seat number)
+ * @param num_players Number of seats (1..MAX_PLAYERS)
+ * @param board Board cards (3-5 cards when two or more players are live)
+ * @param pot Pot to split (NULL = winners only)
+ * @param out_winners_mask Receives a bit per winning seat (can be NULL)
+ * @param out_shares Receives chips per seat, 0 for non-winners
+ *                   (num_players entries; can be NULL if pot is NULL)
+ * @return Number of winners, or -1 on error (poker_errno set to
+ *         POKER_EINVAL for bad arguments, a wrong hole or board size or
+ *         no live player, POKER_EDUPLICATE if any card appears twice)
+ */
+int showdown_resolve(const ShowdownPlayer* const players, const size_t num_players,
+                     const uint64_t board, const ShowdownPot* const pot,
+                     uint16_t* const out_winners_mask, uint64_t* const out_shares);
+
+/*
+ * Settlement
+ *
+ * A table's hand ends with what each seat put in (contributions) and who
+ * folded. Pots are built from the live seats' contribution levels: the
+ * main pot holds every seat's chips up to the smallest live all-in, each
+ * side pot the chips between two levels, and every pot is eligible to the
+ * live seats that reached its level. Folded chips stay in the pots they
+ * were put into; chips above the highest live level go to the top pot.
+ * Each live hand is evaluated once for all pots.
+ */
+
+/* Most pots one table can produce (one per distinct live level) */
+#define SHOWDOWN_MAX_POTS MAX_PLAYERS
+
+/*
+ * One pot built by showdown_build_pots()
+ */
+typedef struct {
+    uint64_t amount;       /* Chips in the pot */
+    uint16_t eligible;     /* Bit per seat that can win it */
+    uint16_t winners;      /* Bit per seat that won it (settlement only) */
+} ShowdownSidePot;
+
+/*
+ * One table to settle
+ */
+typedef struct {
+    ShowdownPlayer players[MAX_PLAYERS];
+    uint64_t contributions[MAX_PLAYERS];  /* Chips each seat put in this hand */
+    size_t num_players;                   /* Seats used (1..MAX_PLAYERS) */
+    uint64_t board;                       /* Board cards */
+    size_t first_seat;                    /* SHOWDOWN_ODD_CHIP_POSITION start seat */
+    int odd_chip_rule;                    /* SHOWDOWN_ODD_CHIP_* */
+} ShowdownTable;
+
+/*
+ * Result of showdown_settle()
+ */
+typedef struct {
+    int status;                           /* 0, or the poker_errno code for this table */
+    size_t num_pots;
+    ShowdownSidePot pots[SHOWDOWN_MAX_POTS]; /* Main pot first */
+    uint64_t payouts[MAX_PLAYERS];        /* Chips won per seat over all pots */
+    HandValue values[MAX_PLAYERS];        /* Evaluated hands (0 if not needed) */
+} ShowdownSettlement;
+
+/**
+ * @brief Build the main and side pots of a table
+ * @param table Table (cards are not looked at)
+ * @param out_pots Receives up to SHOWDOWN_MAX_POTS pots, main pot first
+ * @param out_num_pots Receives the number of pots
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int showdown_build_pots(const ShowdownTable* const table, ShowdownSidePot* const out_pots,
+                        size_t* const out_num_pots);
+
+/**
+ * @brief Build a table's pots and award each to its best eligible hand
+ *
+ * Pots with one eligible seat are returned to it without a showdown;
+ * otherwise split pots and odd chips follow the table's odd-chip rule.
+ *
+ * @param table Table
+ * @param out Pointer to receive the settlement (status set on error too)
+ * @return 0 on success, -1 on error (poker_errno set as for
+ *         showdown_resolve())
+ */
+int showdown_settle(const ShowdownTable* const table, ShowdownSettlement* const out);
+
+/**
+ * @brief Settle many tables, split across threads
+ *
+ * Tables are independent: an invalid table gets a nonzero status and the
+ * rest are still settled.
+ *
+ * @param tables Tables
+ * @param count Number of tables
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out Receives one settlement per table
+ * @return 0 if every table was settled, -1 otherwise (poker_errno set to
+ *         the status of the first failed table, or POKER_EINVAL for bad
+ *         arguments)
+ */
+int showdown_settle_batch(const ShowdownTable* const tables, const size_t count,
+                          const size_t num_threads, ShowdownSettlement* const out);
+
+#endif /* POKER_SHOWDOWN_H */
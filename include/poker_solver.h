@@ -0,0 +1,200 @@
+/*
+ * Poker Hand Evaluation Library
+ * River subgame solver (Discounted CFR)
+ */
+
+#ifndef POKER_SOLVER_H
+#define POKER_SOLVER_H
+
+#include "poker_boardrank.h"
+
+/*
+ * River subgame
+ *
+ * Two players, OOP (acts first) and IP, reach the river with a pot and an
+ * effective stack behind. The betting tree is built from per-player bet
+ * sizes (fractions of the pot) and raise sizes (fractions of the pot after
+ * calling); sizes at or above the stack become all-in and duplicates are
+ * merged. Payoffs are chips relative to an even split of the starting
+ * pot: a player who folds loses half the pot plus their river bets, a
+ * showdown winner gains half the pot plus the loser's bets.
+ *
+ * Strategies are stored per decision node as num_actions x HOLE_COMBOS
+ * probabilities (action-major, combos by hole_combo_index()). Solving
+ * runs Discounted CFR (alpha 1.5, beta 0, gamma 2) with alternating
+ * updates; every regret and strategy update is a loop over all combos,
+ * and each traversal splits the root's subtrees across threads.
+ */
+
+/* Players */
+#define RIVER_OOP 0
+#define RIVER_IP  1
+
+/* Action kinds */
+#define RIVER_ACTION_FOLD  0
+#define RIVER_ACTION_CHECK 1
+#define RIVER_ACTION_CALL  2
+#define RIVER_ACTION_BET   3    /* Bet or raise (all-in when the amount is the stack) */
+
+/* Bet or raise sizes per player */
+#define RIVER_MAX_SIZES 5
+
+/* Fold, check/call, RIVER_MAX_SIZES sizes and all-in */
+#define RIVER_MAX_ACTIONS (RIVER_MAX_SIZES + 3)
+
+/*
+ * Subgame definition
+ */
+typedef struct {
+    uint64_t board;                                  /* 5-card board */
+    double pot;                                      /* Pot at the start of the river (> 0) */
+    double stack;                                    /* Effective stack behind (>= 0) */
+    double bet_sizes[2][RIVER_MAX_SIZES];            /* Per player, fractions of the pot */
+    size_t num_bet_sizes[2];
+    double raise_sizes[2][RIVER_MAX_SIZES];          /* Per player, fractions of the pot after calling */
+    size_t num_raise_sizes[2];
+    unsigned max_raises;                             /* Raises allowed after the first bet */
+    int all_in;                                      /* Nonzero: offer all-in wherever a bet or raise is */
+} RiverConfig;
+
+/*
+ * One node of the betting tree (node 0 is the root)
+ */
+typedef struct {
+    int player;                            /* RIVER_OOP or RIVER_IP to act, -1 at terminals */
+    int folded;                            /* Terminal: player who folded, -1 at a showdown */
+    double bets[2];                        /* River bets of OOP and IP on reaching the node */
+    size_t num_actions;
+    uint8_t actions[RIVER_MAX_ACTIONS];    /* RIVER_ACTION_* */
+    double amounts[RIVER_MAX_ACTIONS];     /* Acting player's total bet after the action */
+    size_t children[RIVER_MAX_ACTIONS];
+} RiverNode;
+
+/* Opaque solver state: tree, regrets and average strategies */
+typedef struct RiverSolver RiverSolver;
+
+/**
+ * @brief Build the betting tree and solver state for a river subgame
+ *
+ * Range weights on combos that share a card with the board are ignored.
+ *
+ * @param config Subgame definition
+ * @param oop_range HOLE_COMBOS weights of the OOP range
+ * @param ip_range HOLE_COMBOS weights of the IP range
+ * @return Pointer to the solver, or NULL on error (poker_errno set to
+ *         POKER_EINVAL for a bad board, sizes, negative weights or an
+ *         empty range, POKER_ENOMEM)
+ */
+RiverSolver* river_solver_create(const RiverConfig* const config, const double* const oop_range,
+                                 const double* const ip_range);
+
+/**
+ * @brief Free a solver
+ * @param solver Solver to free (can be NULL)
+ */
+void river_solver_destroy(RiverSolver* const solver);
+
+/**
+ * @brief Run DCFR iterations (continuing from earlier runs)
+ *
+ * Results do not depend on num_threads.
+ *
+ * @param solver Solver
+ * @param iterations Iterations to run (each updates both players)
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int river_solver_run(RiverSolver* const solver, const size_t iterations,
+                     const size_t num_threads);
+
+/**
+ * @brief Number of nodes in the betting tree (decision and terminal)
+ * @param solver Solver
+ * @return Node count
+ */
+size_t river_solver_num_nodes(const RiverSolver* const solver);
+
+/**
+ * @brief Describe one node of the betting tree
+ * @param solver Solver
+ * @param node Node index (< river_solver_num_nodes())
+ * @param out Pointer to receive the node
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL)
+ */
+int river_solver_node(const RiverSolver* const solver, const size_t node, RiverNode* const out);
+
+/**
+ * @brief Average (equilibrium) strategy at a decision node
+ *
+ * Combos the acting player never reaches the node with get the uniform
+ * strategy.
+ *
+ * @param solver Solver
+ * @param node Decision node index
+ * @param out num_actions * HOLE_COMBOS probabilities, out[a * HOLE_COMBOS + combo]
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL for a
+ *         bad or terminal node)
+ */
+int river_solver_strategy(const RiverSolver* const solver, const size_t node,
+                          double* const out);
+
+/**
+ * @brief Replace the average strategy at a decision node
+ *
+ * Loads an external strategy (a bot's, say) so best responses and
+ * exploitability measure it instead of the solved one. Entries are
+ * normalized per combo; combos whose entries are all zero play uniformly.
+ *
+ * @param solver Solver
+ * @param node Decision node index
+ * @param strategy num_actions * HOLE_COMBOS non-negative weights, strategy[a * HOLE_COMBOS + combo]
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL for a
+ *         bad or terminal node or a negative weight)
+ */
+int river_solver_set_strategy(RiverSolver* const solver, const size_t node,
+                              const double* const strategy);
+
+/*
+ * Best response and exploitability
+ *
+ * A best response keeps one player's average strategy fixed and lets the
+ * other pick the most profitable action for every combo at every node.
+ * Values are chips per deal relative to an even split of the starting pot
+ * (the payoffs above), averaged over the pairs of hands the two ranges can
+ * hold after card removal. Showdowns use board_ranking_showdown(), one
+ * linear sweep per leaf over the ranking sorted once at creation, and the
+ * subtrees under large nodes are evaluated on separate threads.
+ */
+
+/**
+ * @brief Best-response value of a player against the other's average strategy
+ * @param solver Solver
+ * @param player RIVER_OOP or RIVER_IP (the responder)
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out_value Receives the responder's value per deal
+ * @param out_values HOLE_COMBOS responder values per combo (can be NULL);
+ *        0 for combos that cannot face the opposing range
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL or
+ *         POKER_ENOMEM)
+ */
+int river_solver_best_response(const RiverSolver* const solver, const int player,
+                               const size_t num_threads, double* const out_value,
+                               double* const out_values);
+
+/**
+ * @brief Exploitability of the average strategy profile
+ *
+ * The mean of both best-response values: 0 at a Nash equilibrium and
+ * positive otherwise, in chips per deal (divide by the pot for a pot
+ * share). The two best responses run concurrently when num_threads > 1.
+ *
+ * @param solver Solver
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out Receives the exploitability
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL or
+ *         POKER_ENOMEM)
+ */
+int river_solver_exploitability(const RiverSolver* const solver, const size_t num_threads,
+                                double* const out);
+
+#endif /* POKER_SOLVER_H */
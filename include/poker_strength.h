@@ -0,0 +1,194 @@
+/*
+ * Poker Hand Evaluation Library
+ * Hand strength (HS), effective hand strength (EHS, EHS²), hand
+ * potential (PPot, NPot) and outs
+ */
+
+#ifndef POKER_STRENGTH_H
+#define POKER_STRENGTH_H
+
+#include "poker.h"
+
+/*
+ * Hand strength
+ *
+ * HS is the probability that a hand beats one opponent hand drawn from a
+ * range on the current board, ties counting half:
+ *
+ *   HS = (wins + ties / 2) / total   (opponent combos weighted by the range)
+ *
+ * Opponent combos sharing a card with the hand or the board are removed.
+ * EHS and EHS² are the mean of HS and of HS² on the river over every way
+ * to complete the board (each completion equally likely); against a
+ * uniform range EHS equals all-in equity against one random hand. EHS²
+ * rewards draws by weighting the strong runouts more.
+ *
+ * Ranges are HOLE_COMBOS weights indexed by hole_combo_index() (NULL =
+ * every combo weight 1). Boards have 3 to 5 cards.
+ */
+
+/* Number of distinct two-card hands */
+#define HOLE_COMBOS 1326
+
+/*
+ * Result of hand_strength()
+ */
+typedef struct {
+    double hs;          /* Strength on the current board */
+    double ehs;         /* Mean river HS over all runouts */
+    double ehs2;        /* Mean squared river HS over all runouts */
+} HandStrength;
+
+/**
+ * @brief Index of a two-card hand in [0, HOLE_COMBOS)
+ *
+ * For card indices a < b the index is b * (b - 1) / 2 + a.
+ *
+ * @param hole Two-card mask
+ * @return Combo index, or -1 if hole does not hold exactly two cards
+ */
+int hole_combo_index(const uint64_t hole);
+
+/**
+ * @brief Two-card mask of a combo index
+ * @param index Combo index (< HOLE_COMBOS)
+ * @return Two-card mask, or 0 if index is out of range
+ */
+uint64_t hole_combo_mask(const size_t index);
+
+/**
+ * @brief HS, EHS and EHS² of one hand against a range
+ *
+ * Values are 0 when the range has no combo left after card removal.
+ *
+ * @param hole Two-card mask
+ * @param board Board (3-5 cards)
+ * @param weights HOLE_COMBOS opponent weights (NULL = uniform)
+ * @param out Pointer to receive the result
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL for
+ *         bad sizes, POKER_EDUPLICATE if hole and board share a card)
+ */
+int hand_strength(const uint64_t hole, const uint64_t board,
+                  const double* const weights, HandStrength* const out);
+
+/**
+ * @brief HS, EHS and EHS² of every two-card hand on a board
+ *
+ * Each board (the current one and every runout) evaluates each combo once
+ * and ranks the values; a hand's wins, ties and range total then follow
+ * from prefix sums with per-card corrections for card removal, instead of
+ * evaluating every hand against every opponent. Combos that overlap the
+ * board are set to 0.
+ *
+ * @param board Board (3-5 cards)
+ * @param weights HOLE_COMBOS opponent weights (NULL = uniform)
+ * @param out HOLE_COMBOS results, indexed by hole_combo_index()
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL or
+ *         POKER_ENOMEM)
+ */
+int hand_strength_all(const uint64_t board, const double* const weights,
+                      HandStrength* const out);
+
+/*
+ * Hand potential
+ *
+ * Every (opponent combo, runout to the river) pair is classified by where
+ * the hand stands now and on the river: ahead, tied or behind. PPot is the
+ * chance of improving from behind, NPot of falling back from ahead (ties
+ * counting half either way):
+ *
+ *   PPot = (HP[B][A] + HP[B][T]/2 + HP[T][A]/2) / (HP[B][*] + HP[T][*]/2)
+ *   NPot = (HP[A][B] + HP[T][B]/2 + HP[A][T]/2) / (HP[A][*] + HP[T][*]/2)
+ */
+
+/* Rows and columns of HandPotential.states */
+#define POTENTIAL_AHEAD  0
+#define POTENTIAL_TIED   1
+#define POTENTIAL_BEHIND 2
+
+/*
+ * Result of hand_potential()
+ */
+typedef struct {
+    double hs;              /* Strength on the current board */
+    double ppot;            /* Positive potential */
+    double npot;            /* Negative potential */
+    double states[3][3];    /* Pair weight by [state now][state on the river] */
+} HandPotential;
+
+/**
+ * @brief Positive and negative potential of one hand against a range
+ *
+ * Enumerates every opponent combo against every runout to the river; the
+ * hand and each opponent are evaluated once on the current board and the
+ * hand once per runout, and the runouts are split across threads. PPot or
+ * NPot is 0 when no pair starts behind or ahead respectively.
+ *
+ * @param hole Two-card mask
+ * @param board Flop or turn (3-4 cards)
+ * @param weights HOLE_COMBOS opponent weights (NULL = uniform)
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out Pointer to receive the result
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL for
+ *         bad sizes, POKER_EDUPLICATE if hole and board share a card,
+ *         POKER_ENOMEM)
+ */
+int hand_potential(const uint64_t hole, const uint64_t board,
+                   const double* const weights, const size_t num_threads,
+                   HandPotential* const out);
+
+/*
+ * Result of compute_outs() and compute_outs_range()
+ *
+ * Per-card arrays are indexed by card index; cards that are not unseen
+ * (hole, board, known opponent cards) have value 0 and share 0 and are in
+ * no mask.
+ */
+typedef struct {
+    HandValue values[DECK_SIZE];    /* Hand value with the card added */
+    double share[DECK_SIZE];        /* Pot share (opponents) or HS (range) with the card */
+    uint64_t ahead;                 /* Unseen cards that leave the hand ahead */
+    uint64_t tied;                  /* ... tied */
+    uint64_t behind;                /* ... behind */
+    uint64_t improves;              /* Unseen cards that raise the hand category */
+} HandOuts;
+
+/**
+ * @brief Outcome of every possible next card against known opponents
+ *
+ * A card leaves the hand ahead if it beats every opponent, tied if it
+ * splits with the best of them and behind otherwise; share is the pot
+ * fraction won (1, 1/k for a k-way split, or 0). Each hand's suit masks
+ * are built once and each card is added and removed with one bit flip
+ * (evaluate_suits()).
+ *
+ * @param hole Two-card mask
+ * @param board Flop or turn (3-4 cards)
+ * @param opponents Two-card mask per opponent
+ * @param num_opponents Number of opponents (1..MAX_PLAYERS - 1)
+ * @param out Pointer to receive the result
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL for
+ *         bad sizes or counts, POKER_EDUPLICATE if any card appears twice)
+ */
+int compute_outs(const uint64_t hole, const uint64_t board,
+                 const uint64_t* const opponents, const size_t num_opponents,
+                 HandOuts* const out);
+
+/**
+ * @brief Outcome of every possible next card against a range
+ *
+ * share is the HS against the range with the card added (see
+ * hand_strength()); the card leaves the hand ahead if HS > 1/2, tied if
+ * HS == 1/2 and behind if HS < 1/2 (also when the range is empty).
+ *
+ * @param hole Two-card mask
+ * @param board Flop or turn (3-4 cards)
+ * @param weights HOLE_COMBOS opponent weights (NULL = uniform)
+ * @param out Pointer to receive the result
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL for
+ *         bad sizes, POKER_EDUPLICATE if hole and board share a card)
+ */
+int compute_outs_range(const uint64_t hole, const uint64_t board,
+                       const double* const weights, HandOuts* const out);
+
+#endif /* POKER_STRENGTH_H */
@@ -0,0 +1,157 @@
+/*
+ * Poker Hand Evaluation Library
+ * Multi-table tournament simulator
+ */
+
+#ifndef POKER_TOURNAMENT_H
+#define POKER_TOURNAMENT_H
+
+#include "poker_game.h"
+
+/*
+ * Tournament simulation
+ *
+ * A tournament seats its entrants at random over as few tables as fit,
+ * then plays rounds: one hand on every table with two or more players
+ * (GameTables engine, all-ins settled with evaluate_mask()). After each
+ * round busted players get their finishing places, tables are broken as
+ * the field shrinks and players are moved from the biggest table to the
+ * smallest until no two tables differ by more than one player. Blinds go
+ * up every hands_per_level rounds.
+ *
+ * Entrant i plays policies[i % num_policies]. Every decision draws from a
+ * generator seeded from the tournament seed, so results depend only on the
+ * configuration and seed, never on thread count.
+ */
+
+/* Most policies a tournament can mix */
+#define TOURNAMENT_MAX_POLICIES 16
+
+/*
+ * One blind level
+ */
+typedef struct {
+    uint32_t small_blind;
+    uint32_t big_blind;
+} TournamentLevel;
+
+/**
+ * Policy decision function
+ *
+ * @param tables Table state (the seat to act is legal->seat of table)
+ * @param table Table index
+ * @param legal Legal actions
+ * @param params Policy parameters (TournamentPolicy.params)
+ * @param rng Generator state for random decisions (pass to tournament_random())
+ * @param out_raise_to Receives the amount for GAME_ACTION_RAISE
+ * @return GAME_ACTION_*; an illegal choice is played as GAME_ACTION_CHECK_CALL
+ */
+typedef int (*TournamentDecide)(const GameTables* tables, size_t table,
+                                const GameLegal* legal, const void* params,
+                                uint64_t* rng, uint32_t* out_raise_to);
+
+/*
+ * A strategy: decision function plus its parameters
+ */
+typedef struct {
+    TournamentDecide decide;
+    const void* params;
+} TournamentPolicy;
+
+/*
+ * Tournament structure
+ */
+typedef struct {
+    size_t num_players;                /* Entrants (at least 2) */
+    size_t table_size;                 /* Seats per table (2..MAX_PLAYERS) */
+    uint32_t starting_stack;           /* num_players * starting_stack must fit in 32 bits */
+    const TournamentLevel* levels;     /* Blind levels; the last one repeats */
+    size_t num_levels;
+    size_t hands_per_level;            /* Rounds per level (at least 1) */
+    const uint64_t* payouts;           /* payouts[p] = prize for place p + 1 */
+    size_t num_payouts;                /* Paid places (at most num_players) */
+    const TournamentPolicy* policies;  /* Entrant i plays policies[i % num_policies] */
+    size_t num_policies;               /* 1..TOURNAMENT_MAX_POLICIES */
+    size_t max_rounds;                 /* 0 = play to one player; else rank survivors by chips */
+} TournamentConfig;
+
+/*
+ * Results of the entrants playing one policy
+ */
+typedef struct {
+    uint64_t entries;
+    uint64_t wins;                     /* First places */
+    uint64_t cashes;                   /* Finishes within the paid places */
+    uint64_t prize;                    /* Total prize won */
+    double prize_sq;                   /* Sum of squared prizes (for variance) */
+} TournamentPolicyStats;
+
+/*
+ * Aggregate results of tournament_simulate()
+ */
+typedef struct {
+    uint64_t tournaments;
+    uint64_t hands;                    /* Hands played over all tables */
+    uint64_t rounds;
+    TournamentPolicyStats policies[TOURNAMENT_MAX_POLICIES];
+} TournamentStats;
+
+/**
+ * @brief Play one tournament
+ * @param config Tournament structure
+ * @param seed Tournament seed
+ * @param out_places Receives each entrant's finishing place (1 = winner;
+ *                   num_players entries)
+ * @param out_hands Receives the number of hands played (can be NULL)
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL or
+ *         POKER_ENOMEM)
+ */
+int tournament_run(const TournamentConfig* const config, const uint64_t seed,
+                   uint32_t* const out_places, uint64_t* const out_hands);
+
+/**
+ * @brief Play many tournaments in parallel and aggregate results by policy
+ *
+ * Tournament i uses seed + i, so it matches tournament_run(config, seed + i).
+ *
+ * @param config Tournament structure
+ * @param count Number of tournaments
+ * @param seed Seed of the first tournament
+ * @param num_threads Worker threads (0 = one per online CPU)
+ * @param out Receives the aggregate results
+ * @return 0 on success, -1 on error (poker_errno set to POKER_EINVAL or
+ *         POKER_ENOMEM)
+ */
+int tournament_simulate(const TournamentConfig* const config, const uint64_t count,
+                        const uint64_t seed, const size_t num_threads,
+                        TournamentStats* const out);
+
+/**
+ * @brief Draw a random number from a policy generator
+ * @param rng Generator state
+ * @return 64 random bits
+ */
+uint64_t tournament_random(uint64_t* const rng);
+
+/*
+ * Built-in policies
+ *
+ *   tournament_decide_check_call  Never folds or raises
+ *   tournament_decide_random      Folds, calls, min-raises or shoves at random
+ *                                 (params: NULL)
+ *   tournament_decide_shove       Preflop push/fold: all-in with any pair or
+ *                                 two cards of at least *(const int*)params
+ *                                 (a Rank; NULL = RANK_TEN), otherwise check
+ *                                 or fold; checks or folds after the flop
+ */
+int tournament_decide_check_call(const GameTables* tables, size_t table,
+                                 const GameLegal* legal, const void* params,
+                                 uint64_t* rng, uint32_t* out_raise_to);
+int tournament_decide_random(const GameTables* tables, size_t table,
+                             const GameLegal* legal, const void* params,
+                             uint64_t* rng, uint32_t* out_raise_to);
+int tournament_decide_shove(const GameTables* tables, size_t table,
+                            const GameLegal* legal, const void* params,
+                            uint64_t* rng, uint32_t* out_raise_to);
+
+#endif /* POKER_TOURNAMENT_H */
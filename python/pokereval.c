@@ -0,0 +1,293 @@
+/*
+ * pokereval - Python bindings for batch hand evaluation
+ *
+ * Takes card-index arrays through the buffer protocol (NumPy uint8 arrays
+ * of shape (n, 5..7), bytes viewed as 2-D memoryviews, ...) without copying
+ * and evaluates them with the GIL released, across threads:
+ *
+ *   import numpy as np, pokereval
+ *   cards = np.array([[48, 44, 40, 36, 32]], dtype=np.uint8)   # Ah Kh Qh Jh Th
+ *   values = pokereval.evaluate(cards)          # uint32 HandValues
+ *   pokereval.category_name(values[0])          # 'Royal Flush'
+ *
+ * Card indices are CARD_INDEX(): (rank - 2) * 4 + suit, suits h d c s.
+ * NumPy is optional: without it evaluate() returns an array.array('I').
+ *
+ * Build:
+ *   make python     (then PYTHONPATH=build python3 ...)
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <string.h>
+#include "../include/poker.h"
+
+/* Static helper: check a buffer format string names a 1-byte or 4-byte unsigned integer */
+static int is_unsigned_format(const char* format, const Py_ssize_t itemsize) {
+    if (format == NULL) {
+        return itemsize == 1;
+    }
+    if (*format == '@' || *format == '=') {
+        format++;
+    }
+    if (itemsize == 1) {
+        return strcmp(format, "B") == 0;
+    }
+    return itemsize == 4 && (strcmp(format, "I") == 0 || strcmp(format, "L") == 0);
+}
+
+/*
+ * Static helper: get a C-contiguous (n, 5..7) uint8 view of cards
+ * @return 0 on success, -1 with a Python exception set
+ */
+static int get_cards(PyObject* const obj, Py_buffer* const view) {
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+        return -1;
+    }
+    if (!is_unsigned_format(view->format, view->itemsize) || view->itemsize != 1) {
+        PyErr_SetString(PyExc_TypeError, "cards must be a uint8 array");
+    } else if (view->ndim != 2 || view->shape[1] < HAND_SIZE || view->shape[1] > HAND_SIZE + 2) {
+        PyErr_SetString(PyExc_ValueError, "cards must have shape (n, 5), (n, 6) or (n, 7)");
+    } else {
+        return 0;
+    }
+    PyBuffer_Release(view);
+    return -1;
+}
+
+/* Static helper: evaluate with the GIL released */
+static void evaluate_view(const Py_buffer* const cards, const size_t threads, HandValue* const out) {
+    const size_t rows = (size_t)cards->shape[0];
+    const size_t width = (size_t)cards->shape[1];
+    Py_BEGIN_ALLOW_THREADS
+    evaluate_card_rows((const uint8_t*)cards->buf, rows, width, threads, out);
+    Py_END_ALLOW_THREADS
+}
+
+/*
+ * Static helper: new zeroed uint32 array of n values
+ * numpy.zeros when NumPy is installed, array.array('I') otherwise
+ */
+static PyObject* new_value_array(const Py_ssize_t n) {
+    PyObject* numpy = PyImport_ImportModule("numpy");
+    if (numpy != NULL) {
+        PyObject* const result = PyObject_CallMethod(numpy, "zeros", "(ns)", n, "uint32");
+        Py_DECREF(numpy);
+        return result;
+    }
+    if (!PyErr_ExceptionMatches(PyExc_ImportError)) {
+        return NULL;
+    }
+    PyErr_Clear();
+
+    PyObject* const array = PyImport_ImportModule("array");
+    if (array == NULL) {
+        return NULL;
+    }
+    PyObject* const zeros = PyBytes_FromStringAndSize(NULL, n * (Py_ssize_t)sizeof(HandValue));
+    PyObject* result = NULL;
+    if (zeros != NULL) {
+        memset(PyBytes_AS_STRING(zeros), 0, (size_t)n * sizeof(HandValue));
+        result = PyObject_CallMethod(array, "array", "(sO)", "I", zeros);
+        Py_DECREF(zeros);
+    }
+    Py_DECREF(array);
+    return result;
+}
+
+/*
+ * Static helper: get a writable C-contiguous uint32 view holding n values
+ * @return 0 on success, -1 with a Python exception set
+ */
+static int get_values(PyObject* const obj, const Py_ssize_t n, Py_buffer* const view) {
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE) != 0) {
+        return -1;
+    }
+    if (view->itemsize != (Py_ssize_t)sizeof(HandValue) ||
+        !is_unsigned_format(view->format, view->itemsize)) {
+        PyErr_SetString(PyExc_TypeError, "out must be a uint32 array");
+    } else if (view->len != n * (Py_ssize_t)sizeof(HandValue)) {
+        PyErr_SetString(PyExc_ValueError, "out must hold one value per hand");
+    } else {
+        return 0;
+    }
+    PyBuffer_Release(view);
+    return -1;
+}
+
+/* Static helper: validate the threads argument */
+static int check_threads(const Py_ssize_t threads) {
+    if (threads < 0) {
+        PyErr_SetString(PyExc_ValueError, "threads must be >= 0");
+        return -1;
+    }
+    return 0;
+}
+
+PyDoc_STRVAR(evaluate_doc,
+"evaluate(cards, threads=0)\n"
+"--\n\n"
+"Evaluate hands given as a uint8 array of card indices, shape (n, 5..7).\n"
+"Returns a uint32 array of HandValues (higher wins; 0 for a row with a\n"
+"bad index or repeated card). threads=0 uses every CPU.");
+
+static PyObject* py_evaluate(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"cards", "threads", NULL};
+    PyObject* cards_obj;
+    Py_ssize_t threads = 0;
+    (void)self;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", keywords, &cards_obj, &threads) ||
+        check_threads(threads) != 0) {
+        return NULL;
+    }
+
+    Py_buffer cards;
+    if (get_cards(cards_obj, &cards) != 0) {
+        return NULL;
+    }
+    PyObject* const result = new_value_array(cards.shape[0]);
+    Py_buffer values;
+    if (result == NULL || get_values(result, cards.shape[0], &values) != 0) {
+        Py_XDECREF(result);
+        PyBuffer_Release(&cards);
+        return NULL;
+    }
+
+    evaluate_view(&cards, (size_t)threads, (HandValue*)values.buf);
+    PyBuffer_Release(&values);
+    PyBuffer_Release(&cards);
+    return result;
+}
+
+PyDoc_STRVAR(evaluate_into_doc,
+"evaluate_into(cards, out, threads=0)\n"
+"--\n\n"
+"Like evaluate(), writing into an existing uint32 array of n values.");
+
+static PyObject* py_evaluate_into(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* keywords[] = {"cards", "out", "threads", NULL};
+    PyObject* cards_obj;
+    PyObject* out_obj;
+    Py_ssize_t threads = 0;
+    (void)self;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|n", keywords, &cards_obj, &out_obj, &threads) ||
+        check_threads(threads) != 0) {
+        return NULL;
+    }
+
+    Py_buffer cards;
+    Py_buffer values;
+    if (get_cards(cards_obj, &cards) != 0) {
+        return NULL;
+    }
+    if (get_values(out_obj, cards.shape[0], &values) != 0) {
+        PyBuffer_Release(&cards);
+        return NULL;
+    }
+
+    evaluate_view(&cards, (size_t)threads, (HandValue*)values.buf);
+    PyBuffer_Release(&values);
+    PyBuffer_Release(&cards);
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(parse_doc,
+"parse(text)\n"
+"--\n\n"
+"Parse a hand string such as 'AhKh QhJhTh' into bytes of card indices.");
+
+static PyObject* py_parse(PyObject* self, PyObject* args) {
+    const char* text;
+    Py_ssize_t len;
+    (void)self;
+    if (!PyArg_ParseTuple(args, "s#", &text, &len)) {
+        return NULL;
+    }
+
+    Card cards[DECK_SIZE];
+    size_t error_offset = 0;
+    const int n = parse_hand(text, (size_t)len, cards, DECK_SIZE, &error_offset);
+    if (n < 0) {
+        PyErr_Format(PyExc_ValueError, "invalid hand at offset %zu", error_offset);
+        return NULL;
+    }
+
+    uint8_t indices[DECK_SIZE];
+    for (int i = 0; i < n; i++) {
+        indices[i] = (uint8_t)CARD_INDEX(cards[i]);
+    }
+    return PyBytes_FromStringAndSize((const char*)indices, n);
+}
+
+/*
+ * Static helper: convert an int-like object (int, numpy.uint32, ...) to a HandValue
+ * @return 0 on success, -1 with a Python exception set
+ */
+static int get_hand_value(PyObject* const obj, HandValue* const out) {
+    PyObject* const index = PyNumber_Index(obj);
+    if (index == NULL) {
+        return -1;
+    }
+    const unsigned long value = PyLong_AsUnsignedLong(index);
+    Py_DECREF(index);
+    if (value == (unsigned long)-1 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (value > UINT32_MAX) {
+        PyErr_SetString(PyExc_OverflowError, "hand value out of range");
+        return -1;
+    }
+    *out = (HandValue)value;
+    return 0;
+}
+
+PyDoc_STRVAR(category_doc,
+"category(value)\n"
+"--\n\n"
+"Hand category (0 = invalid, 1 = high card ... 10 = royal flush) of a HandValue.");
+
+static PyObject* py_category(PyObject* self, PyObject* arg) {
+    HandValue value;
+    (void)self;
+    if (get_hand_value(arg, &value) != 0) {
+        return NULL;
+    }
+    return PyLong_FromLong((long)HAND_VALUE_CATEGORY(value));
+}
+
+PyDoc_STRVAR(category_name_doc,
+"category_name(value)\n"
+"--\n\n"
+"Name of a HandValue's category, e.g. 'Full House'.");
+
+static PyObject* py_category_name(PyObject* self, PyObject* arg) {
+    HandValue value;
+    (void)self;
+    if (get_hand_value(arg, &value) != 0) {
+        return NULL;
+    }
+    return PyUnicode_FromString(hand_category_name(HAND_VALUE_CATEGORY(value)));
+}
+
+static PyMethodDef pokereval_methods[] = {
+    {"evaluate", (PyCFunction)(void (*)(void))py_evaluate, METH_VARARGS | METH_KEYWORDS, evaluate_doc},
+    {"evaluate_into", (PyCFunction)(void (*)(void))py_evaluate_into, METH_VARARGS | METH_KEYWORDS,
+     evaluate_into_doc},
+    {"parse", py_parse, METH_VARARGS, parse_doc},
+    {"category", py_category, METH_O, category_doc},
+    {"category_name", py_category_name, METH_O, category_name_doc},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef pokereval_module = {
+    PyModuleDef_HEAD_INIT,
+    "pokereval",
+    "Batch poker hand evaluation on card-index arrays.",
+    -1,
+    pokereval_methods,
+    NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit_pokereval(void) {
+    return PyModule_Create(&pokereval_module);
+}
@@ -0,0 +1,1043 @@
+/*
+ * abstraction.c - EHS-histogram card abstraction
+ * Equity histograms, k-means under the earth mover's distance and
+ * memory-mapped bucket tables
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_abstraction.h"
+#include "../include/poker_boardrank.h"
+#include "threads.h"
+#include <fcntl.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Bucket table header size */
+#define TABLE_HEADER_SIZE 24
+
+/* Quantized cumulative histogram entries are 0..CDF_SCALE */
+#define CDF_SCALE 255
+
+/* Records sampled for k-means++ seeding */
+#define SEED_SAMPLE_LIMIT 65536
+
+/* Preflop runout chunks, fixed so results do not depend on the thread count */
+#define PREFLOP_CHUNKS 64
+
+/* Hands written per output chunk */
+#define WRITE_CHUNK 65536
+
+static const uint8_t TABLE_MAGIC[4] = {'P', 'B', 'K', 'T'};
+
+/* Board cards per street */
+static const size_t STREET_BOARD_CARDS[HAND_INDEX_STREETS] = {0, 3, 4, 5};
+
+/* Static helper: splitmix64 step */
+static uint64_t next_random(uint64_t* const state) {
+    uint64_t z = (*state += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+/* Static helper: uniform double in [0, 1) */
+static double random_unit(uint64_t* const state) {
+    return (double)(next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Little-endian helpers for the table header */
+static void put_u32(uint8_t* const p, const uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static void put_u64(uint8_t* const p, const uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const uint8_t* const p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_u64(const uint8_t* const p) {
+    return (uint64_t)get_u32(p) | ((uint64_t)get_u32(p + 4) << 32);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Equity histograms                                                        */
+/* ------------------------------------------------------------------------ */
+
+/* Static helper: add one runout's strengths to the histograms */
+static int add_runout(const uint64_t board, const unsigned bins, BoardRanking* const ranking,
+                      uint32_t* const out) {
+    if (board_ranking_build(board, ranking) != 0) {
+        return -1;
+    }
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        if (ranking->position[c] == BOARD_RANK_BLOCKED) {
+            continue;
+        }
+        const uint64_t twice_total =
+            2 * ((uint64_t)ranking->wins[c] + ranking->ties[c] + ranking->losses[c]);
+        const uint64_t twice_score = 2 * (uint64_t)ranking->wins[c] + ranking->ties[c];
+        uint64_t bin = (twice_total > 0) ? twice_score * bins / twice_total : bins / 2;
+        if (bin >= bins) {
+            bin = bins - 1;
+        }
+        out[c * bins + bin]++;
+    }
+    return 0;
+}
+
+int ehs_histograms(const uint64_t board, const unsigned bins, const size_t samples,
+                   const uint64_t seed, uint32_t* const out) {
+    const int board_len = __builtin_popcountll(board);
+    if (out == NULL || bins < 2 || bins > ABSTRACTION_MAX_BINS ||
+        (board >> DECK_SIZE) != 0 || board_len == 1 || board_len == 2 || board_len > BOARD_SIZE) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    BoardRanking* const ranking = malloc(sizeof(BoardRanking));
+    if (ranking == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    memset(out, 0, HOLE_COMBOS * bins * sizeof(uint32_t));
+
+    uint8_t free_cards[DECK_SIZE];
+    size_t num_free = 0;
+    for (uint8_t card = 0; card < DECK_SIZE; card++) {
+        if (!(board & (UINT64_C(1) << card))) {
+            free_cards[num_free++] = card;
+        }
+    }
+    const size_t need = BOARD_SIZE - (size_t)board_len;
+    uint64_t runouts = 1;
+    for (size_t i = 0; i < need; i++) {
+        runouts = runouts * (num_free - i) / (i + 1);
+    }
+
+    int rc = 0;
+    if (samples == 0 || samples >= runouts) {
+        /* Every runout: combinations of need free cards, in colex order */
+        size_t pick[BOARD_SIZE];
+        for (size_t i = 0; i < need; i++) {
+            pick[i] = i;
+        }
+        for (uint64_t r = 0; r < runouts && rc == 0; r++) {
+            uint64_t full = board;
+            for (size_t i = 0; i < need; i++) {
+                full |= UINT64_C(1) << free_cards[pick[i]];
+            }
+            rc = add_runout(full, bins, ranking, out);
+
+            size_t i = 0;
+            while (i < need && pick[i] + 1 == ((i + 1 < need) ? pick[i + 1] : num_free)) {
+                pick[i] = i;
+                i++;
+            }
+            if (i < need) {
+                pick[i]++;
+            }
+        }
+    } else {
+        uint64_t state = seed;
+        for (size_t s = 0; s < samples && rc == 0; s++) {
+            uint64_t full = board;
+            for (size_t i = 0; i < need; i++) {
+                const size_t j = i + (size_t)(next_random(&state) % (num_free - i));
+                const uint8_t card = free_cards[j];
+                free_cards[j] = free_cards[i];
+                free_cards[i] = card;
+                full |= UINT64_C(1) << card;
+            }
+            rc = add_runout(full, bins, ranking, out);
+        }
+    }
+    free(ranking);
+    return rc;
+}
+
+double histogram_emd(const uint32_t* const a, const uint32_t* const b, const unsigned bins) {
+    if (a == NULL || b == NULL || bins == 0) {
+        return -1.0;
+    }
+    uint64_t total_a = 0;
+    uint64_t total_b = 0;
+    for (unsigned i = 0; i < bins; i++) {
+        total_a += a[i];
+        total_b += b[i];
+    }
+    if (total_a == 0 || total_b == 0) {
+        return -1.0;
+    }
+    double distance = 0.0;
+    uint64_t cum_a = 0;
+    uint64_t cum_b = 0;
+    for (unsigned i = 0; i + 1 < bins; i++) {
+        cum_a += a[i];
+        cum_b += b[i];
+        const double diff = (double)cum_a / (double)total_a - (double)cum_b / (double)total_b;
+        distance += (diff < 0.0) ? -diff : diff;
+    }
+    return distance / bins;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Features                                                                 */
+/* ------------------------------------------------------------------------ */
+
+/*
+ * Shared feature-phase settings
+ */
+typedef struct {
+    int street;
+    unsigned bins;
+    size_t samples;
+    uint64_t seed;
+    size_t record_bytes;       /* bins - 1, or 1 on the river */
+    uint8_t* features;         /* num_hands records */
+} FeatureSpec;
+
+typedef struct {
+    const FeatureSpec* spec;
+    size_t begin;              /* Board classes, or preflop chunks */
+    size_t end;
+    uint64_t* sums;            /* Preflop: HOLE_COMBOS * bins counts over the chunks */
+    int error;                 /* poker_errno of a failure, 0 if none */
+} FeatureJob;
+
+/* A live combo and its hand class on one board */
+typedef struct {
+    uint64_t hand;
+    uint16_t combo;
+} ClassEntry;
+
+static int compare_entries(const void* a, const void* b) {
+    const ClassEntry* const x = a;
+    const ClassEntry* const y = b;
+    if (x->hand != y->hand) {
+        return (x->hand > y->hand) - (x->hand < y->hand);
+    }
+    return (x->combo > y->combo) - (x->combo < y->combo);
+}
+
+/* Static helper: per-board seed that does not depend on which thread runs it */
+static uint64_t unit_seed(const uint64_t seed, const uint64_t unit) {
+    uint64_t state = seed ^ (unit * UINT64_C(0xD1B54A32D192ED03));
+    return next_random(&state);
+}
+
+/* Static helper: quantize a histogram into a feature record */
+static void write_record(const FeatureSpec* const spec, const uint64_t* const hist,
+                         uint8_t* const record) {
+    const unsigned bins = spec->bins;
+    uint64_t total = 0;
+    unsigned top = 0;
+    for (unsigned i = 0; i < bins; i++) {
+        total += hist[i];
+        if (hist[i] > hist[top]) {
+            top = i;
+        }
+    }
+    if (spec->street == HAND_INDEX_RIVER) {
+        record[0] = (uint8_t)((total > 0) ? top : bins / 2);
+        return;
+    }
+    uint64_t cum = 0;
+    for (unsigned i = 0; i + 1 < bins; i++) {
+        if (total == 0) {
+            /* No runout observed: a point mass in the middle */
+            record[i] = (i >= bins / 2) ? CDF_SCALE : 0;
+            continue;
+        }
+        cum += hist[i];
+        record[i] = (uint8_t)((cum * CDF_SCALE + total / 2) / total);
+    }
+}
+
+/*
+ * Static helper: sum the histograms of each hand class on a board and
+ * write its record. hist holds HOLE_COMBOS * bins counts.
+ */
+static int write_board_records(const FeatureSpec* const spec, const uint8_t* const board_cards,
+                               const uint64_t board, const uint64_t* const hist,
+                               ClassEntry* const entries, uint64_t* const acc) {
+    const size_t board_len = STREET_BOARD_CARDS[spec->street];
+    uint8_t cards[HOLE_SIZE + BOARD_SIZE];
+    if (board_len > 0) {
+        memcpy(cards + HOLE_SIZE, board_cards, board_len);
+    }
+
+    size_t count = 0;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        const uint64_t hole = hole_combo_mask(c);
+        if (hole & board) {
+            continue;
+        }
+        cards[0] = (uint8_t)__builtin_ctzll(hole);
+        cards[1] = (uint8_t)(63 - __builtin_clzll(hole));
+        if (hand_index(cards, HOLE_SIZE + board_len, &entries[count].hand) != 0) {
+            return -1;
+        }
+        entries[count].combo = (uint16_t)c;
+        count++;
+    }
+    qsort(entries, count, sizeof(ClassEntry), compare_entries);
+
+    for (size_t i = 0; i < count;) {
+        memset(acc, 0, spec->bins * sizeof(uint64_t));
+        size_t j = i;
+        for (; j < count && entries[j].hand == entries[i].hand; j++) {
+            const uint64_t* const row = hist + (size_t)entries[j].combo * spec->bins;
+            for (unsigned b = 0; b < spec->bins; b++) {
+                acc[b] += row[b];
+            }
+        }
+        write_record(spec, acc, spec->features + entries[i].hand * spec->record_bytes);
+        i = j;
+    }
+    return 0;
+}
+
+static void* feature_worker(void* arg) {
+    FeatureJob* const job = arg;
+    const FeatureSpec* const spec = job->spec;
+    const size_t cells = HOLE_COMBOS * spec->bins;
+    uint32_t* const counts = malloc(cells * sizeof(uint32_t));
+    uint64_t* const hist = malloc(cells * sizeof(uint64_t));
+    uint64_t* const acc = malloc(spec->bins * sizeof(uint64_t));
+    ClassEntry* const entries = malloc(HOLE_COMBOS * sizeof(ClassEntry));
+    if (counts == NULL || hist == NULL || acc == NULL || entries == NULL) {
+        job->error = POKER_ENOMEM;
+    }
+
+    for (size_t unit = job->begin; unit < job->end && job->error == 0; unit++) {
+        if (spec->street == HAND_INDEX_PREFLOP) {
+            /* Chunk unit of the sampled runouts */
+            const size_t share = spec->samples / PREFLOP_CHUNKS +
+                                 (unit < spec->samples % PREFLOP_CHUNKS);
+            if (share == 0) {
+                continue;
+            }
+            if (ehs_histograms(0, spec->bins, share, unit_seed(spec->seed, unit), counts) != 0) {
+                job->error = poker_errno;
+                break;
+            }
+            for (size_t i = 0; i < cells; i++) {
+                job->sums[i] += counts[i];
+            }
+            continue;
+        }
+
+        uint8_t board_cards[BOARD_SIZE];
+        if (board_unindex(spec->street, unit, board_cards) != 0) {
+            job->error = poker_errno;
+            break;
+        }
+        uint64_t board = 0;
+        for (size_t i = 0; i < STREET_BOARD_CARDS[spec->street]; i++) {
+            board |= UINT64_C(1) << board_cards[i];
+        }
+        if (ehs_histograms(board, spec->bins, spec->samples, unit_seed(spec->seed, unit),
+                           counts) != 0) {
+            job->error = poker_errno;
+            break;
+        }
+        for (size_t i = 0; i < cells; i++) {
+            hist[i] = counts[i];
+        }
+        if (write_board_records(spec, board_cards, board, hist, entries, acc) != 0) {
+            job->error = poker_errno;
+        }
+    }
+
+    free(counts);
+    free(hist);
+    free(acc);
+    free(entries);
+    return NULL;
+}
+
+/* Static helper: fill every record of the street; 0 on success */
+static int compute_features(const FeatureSpec* const spec, const size_t threads) {
+    const size_t units = (spec->street == HAND_INDEX_PREFLOP)
+                             ? PREFLOP_CHUNKS
+                             : (size_t)board_index_count(spec->street);
+    const size_t jobs = (threads < units) ? threads : units;
+    const size_t cells = HOLE_COMBOS * spec->bins;
+    FeatureJob* const work = calloc(jobs, sizeof(FeatureJob));
+    if (work == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    int error = 0;
+    for (size_t j = 0; j < jobs; j++) {
+        work[j].spec = spec;
+        work[j].begin = units * j / jobs;
+        work[j].end = units * (j + 1) / jobs;
+        if (spec->street == HAND_INDEX_PREFLOP) {
+            work[j].sums = calloc(cells, sizeof(uint64_t));
+            if (work[j].sums == NULL) {
+                error = POKER_ENOMEM;
+            }
+        }
+    }
+    if (error == 0) {
+        run_threads(jobs, feature_worker, work, sizeof(FeatureJob));
+        for (size_t j = 0; j < jobs && error == 0; j++) {
+            error = work[j].error;
+        }
+    }
+
+    if (error == 0 && spec->street == HAND_INDEX_PREFLOP) {
+        /* Integer sums, so the thread split does not matter */
+        for (size_t j = 1; j < jobs; j++) {
+            for (size_t i = 0; i < cells; i++) {
+                work[0].sums[i] += work[j].sums[i];
+            }
+        }
+        uint64_t* const acc = malloc(spec->bins * sizeof(uint64_t));
+        ClassEntry* const entries = malloc(HOLE_COMBOS * sizeof(ClassEntry));
+        if (acc == NULL || entries == NULL) {
+            error = POKER_ENOMEM;
+        } else if (write_board_records(spec, NULL, 0, work[0].sums, entries, acc) != 0) {
+            error = poker_errno;
+        }
+        free(acc);
+        free(entries);
+    }
+
+    for (size_t j = 0; j < jobs; j++) {
+        free(work[j].sums);
+    }
+    free(work);
+    if (error != 0) {
+        poker_errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* k-means                                                                  */
+/* ------------------------------------------------------------------------ */
+
+/*
+ * Records to cluster: quantized cumulative histograms, optionally weighted.
+ * Per-record bounds follow Hamerly: upper bounds the distance to the
+ * assigned centroid and lower the distance to every other one, both
+ * loosened by how far centroids moved, so most records skip the search.
+ */
+typedef struct {
+    const uint8_t* records;
+    size_t count;
+    size_t dims;
+    const uint64_t* weights;   /* NULL = 1 each */
+    size_t k;
+    double* centroids;         /* k * dims */
+    double* half_gap;          /* Half the distance to the nearest other centroid */
+    double* shift;             /* Distance each centroid moved in the last update */
+    double max_shift;
+    uint16_t* assignment;      /* count buckets */
+    float* upper;              /* count bounds (invalid on the first pass) */
+    float* lower;
+    int first;                 /* First pass: search every record */
+    int measure;               /* Only measure distances to the assigned centroids */
+} KMeans;
+
+typedef struct {
+    const KMeans* km;
+    size_t begin;
+    size_t end;
+    uint64_t* sums;            /* k * dims weighted record sums */
+    uint64_t* counts;          /* k weights */
+    uint64_t changed;
+    double distance;           /* Measure pass: weighted distance to the assigned centroids */
+} LloydJob;
+
+typedef struct {
+    KMeans* km;
+    size_t begin;
+    size_t end;
+} GapJob;
+
+/* Float bounds are widened by this factor to absorb rounding */
+#define BOUND_SLACK 1e-5
+
+/* Static helper: L1 distance from a record to a centroid, stopping once it reaches limit */
+static double record_distance(const uint8_t* const record, const double* const centroid,
+                              const size_t dims, const double limit) {
+    double sum = 0.0;
+    for (size_t i = 0; i < dims; i++) {
+        const double diff = record[i] - centroid[i];
+        sum += (diff < 0.0) ? -diff : diff;
+        if (sum >= limit) {
+            break;
+        }
+    }
+    return sum;
+}
+
+static double centroid_distance(const double* const a, const double* const b, const size_t dims) {
+    double sum = 0.0;
+    for (size_t i = 0; i < dims; i++) {
+        sum += (a[i] < b[i]) ? b[i] - a[i] : a[i] - b[i];
+    }
+    return sum;
+}
+
+static void* gap_worker(void* arg) {
+    GapJob* const job = arg;
+    KMeans* const km = job->km;
+    for (size_t c = job->begin; c < job->end; c++) {
+        double nearest = DBL_MAX;
+        for (size_t o = 0; o < km->k; o++) {
+            if (o != c) {
+                const double d = centroid_distance(km->centroids + c * km->dims,
+                                                   km->centroids + o * km->dims, km->dims);
+                if (d < nearest) {
+                    nearest = d;
+                }
+            }
+        }
+        km->half_gap[c] = nearest / 2.0;
+    }
+    return NULL;
+}
+
+static void* lloyd_worker(void* arg) {
+    LloydJob* const job = arg;
+    const KMeans* const km = job->km;
+    const size_t dims = km->dims;
+
+    for (size_t i = job->begin; i < job->end; i++) {
+        const uint8_t* const record = km->records + i * dims;
+        const uint64_t weight = (km->weights != NULL) ? km->weights[i] : 1;
+        const size_t previous = km->assignment[i];
+        if (km->measure) {
+            job->distance += record_distance(record, km->centroids + previous * dims, dims,
+                                             DBL_MAX) * (double)weight;
+            continue;
+        }
+
+        size_t best = previous;
+        int search = km->first;
+        if (!search) {
+            double upper = km->upper[i] + km->shift[previous];
+            const double lower = km->lower[i] - km->max_shift;
+            const double bound = (km->half_gap[previous] > lower) ? km->half_gap[previous] : lower;
+            if (upper > bound) {
+                upper = record_distance(record, km->centroids + previous * dims, dims, DBL_MAX);
+                search = (upper > bound);
+            }
+            km->upper[i] = (float)(upper * (1.0 + BOUND_SLACK));
+            km->lower[i] = (float)(lower * (1.0 - BOUND_SLACK));
+        }
+        if (search) {
+            /* Nearest and second-nearest centroids, abandoning distances past the second */
+            double best_distance = DBL_MAX;
+            double second = DBL_MAX;
+            for (size_t c = 0; c < km->k; c++) {
+                const double d = record_distance(record, km->centroids + c * dims, dims, second);
+                if (d < best_distance) {
+                    second = best_distance;
+                    best = c;
+                    best_distance = d;
+                } else if (d < second) {
+                    second = d;
+                }
+            }
+            km->upper[i] = (float)(best_distance * (1.0 + BOUND_SLACK));
+            km->lower[i] = (float)(second * (1.0 - BOUND_SLACK));
+        }
+
+        km->assignment[i] = (uint16_t)best;
+        job->changed += (best != previous) ? weight : 0;
+        job->counts[best] += weight;
+        uint64_t* const sum = job->sums + best * dims;
+        for (size_t d = 0; d < dims; d++) {
+            sum[d] += (uint64_t)record[d] * weight;
+        }
+    }
+    return NULL;
+}
+
+/* Static helper: k-means++ seeding on an evenly spaced sample of the records */
+static int seed_centroids(KMeans* const km, uint64_t seed) {
+    const size_t sample = (km->count < SEED_SAMPLE_LIMIT) ? km->count : SEED_SAMPLE_LIMIT;
+    size_t* const picks = malloc(sample * sizeof(size_t));
+    double* const nearest = malloc(sample * sizeof(double));
+    if (picks == NULL || nearest == NULL) {
+        free(picks);
+        free(nearest);
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    for (size_t s = 0; s < sample; s++) {
+        picks[s] = (size_t)((uint64_t)s * km->count / sample);
+        nearest[s] = DBL_MAX;
+    }
+
+    uint64_t state = seed;
+    for (size_t c = 0; c < km->k; c++) {
+        /* Draw proportionally to weight * distance^2 (weight alone for the first) */
+        double total = 0.0;
+        for (size_t s = 0; s < sample; s++) {
+            const double w = (km->weights != NULL) ? (double)km->weights[picks[s]] : 1.0;
+            total += (c == 0) ? w : w * nearest[s] * nearest[s];
+        }
+        size_t chosen = c % sample;  /* Every record already a centroid: repeat */
+        if (total > 0.0) {
+            double target = random_unit(&state) * total;
+            for (size_t s = 0; s < sample; s++) {
+                const double w = (km->weights != NULL) ? (double)km->weights[picks[s]] : 1.0;
+                const double mass = (c == 0) ? w : w * nearest[s] * nearest[s];
+                if (mass > 0.0) {
+                    chosen = s;
+                    if (target < mass) {
+                        break;
+                    }
+                    target -= mass;
+                }
+            }
+        }
+
+        double* const centroid = km->centroids + c * km->dims;
+        const uint8_t* const record = km->records + picks[chosen] * km->dims;
+        for (size_t d = 0; d < km->dims; d++) {
+            centroid[d] = record[d];
+        }
+        for (size_t s = 0; s < sample; s++) {
+            const double dist = record_distance(km->records + picks[s] * km->dims, centroid,
+                                                km->dims, nearest[s]);
+            if (dist < nearest[s]) {
+                nearest[s] = dist;
+            }
+        }
+    }
+    free(picks);
+    free(nearest);
+    return 0;
+}
+
+/* Static helper: seed and run Lloyd iterations; assignments end in km->assignment */
+static int run_kmeans(KMeans* const km, const AbstractionConfig* const config,
+                      const size_t threads, AbstractionStats* const stats) {
+    const size_t jobs = (threads < km->count) ? threads : km->count;
+    const size_t gap_jobs = (threads < km->k) ? threads : km->k;
+    LloydJob* const work = calloc(jobs, sizeof(LloydJob));
+    GapJob* const gaps = calloc(gap_jobs, sizeof(GapJob));
+    int rc = (work != NULL && gaps != NULL) ? 0 : -1;
+    for (size_t j = 0; j < jobs && rc == 0; j++) {
+        work[j].km = km;
+        work[j].begin = km->count * j / jobs;
+        work[j].end = km->count * (j + 1) / jobs;
+        work[j].sums = malloc(km->k * km->dims * sizeof(uint64_t));
+        work[j].counts = malloc(km->k * sizeof(uint64_t));
+        if (work[j].sums == NULL || work[j].counts == NULL) {
+            rc = -1;
+        }
+    }
+    if (rc != 0) {
+        poker_errno = POKER_ENOMEM;
+    } else {
+        rc = seed_centroids(km, config->seed);
+    }
+    for (size_t j = 0; j < gap_jobs && rc == 0; j++) {
+        gaps[j].km = km;
+        gaps[j].begin = km->k * j / gap_jobs;
+        gaps[j].end = km->k * (j + 1) / gap_jobs;
+    }
+    memset(km->assignment, 0, km->count * sizeof(uint16_t));
+
+    uint64_t total_weight = 0;
+    for (size_t i = 0; i < km->count && rc == 0; i++) {
+        total_weight += (km->weights != NULL) ? km->weights[i] : 1;
+    }
+
+    km->first = 1;
+    km->measure = 0;
+    for (size_t it = 0; it < config->iterations && rc == 0; it++) {
+        run_threads(gap_jobs, gap_worker, gaps, sizeof(GapJob));
+        for (size_t j = 0; j < jobs; j++) {
+            memset(work[j].sums, 0, km->k * km->dims * sizeof(uint64_t));
+            memset(work[j].counts, 0, km->k * sizeof(uint64_t));
+            work[j].changed = 0;
+        }
+        run_threads(jobs, lloyd_worker, work, sizeof(LloydJob));
+        km->first = 0;
+
+        uint64_t changed = 0;
+        for (size_t j = 0; j < jobs; j++) {
+            changed += work[j].changed;
+        }
+        for (size_t j = 1; j < jobs; j++) {
+            for (size_t i = 0; i < km->k * km->dims; i++) {
+                work[0].sums[i] += work[j].sums[i];
+            }
+            for (size_t c = 0; c < km->k; c++) {
+                work[0].counts[c] += work[j].counts[c];
+            }
+        }
+
+        /* Empty buckets keep their centroid */
+        stats->empty_buckets = 0;
+        km->max_shift = 0.0;
+        for (size_t c = 0; c < km->k; c++) {
+            double* const centroid = km->centroids + c * km->dims;
+            km->shift[c] = 0.0;
+            if (work[0].counts[c] == 0) {
+                stats->empty_buckets++;
+                continue;
+            }
+            double moved = 0.0;
+            for (size_t d = 0; d < km->dims; d++) {
+                const double updated =
+                    (double)work[0].sums[c * km->dims + d] / (double)work[0].counts[c];
+                moved += (updated < centroid[d]) ? centroid[d] - updated : updated - centroid[d];
+                centroid[d] = updated;
+            }
+            km->shift[c] = moved;
+            km->max_shift = (moved > km->max_shift) ? moved : km->max_shift;
+        }
+        stats->iterations = it + 1;
+        stats->changed = changed;
+        if (changed == 0 && it > 0) {
+            break;
+        }
+    }
+
+    if (rc == 0) {
+        km->measure = 1;
+        for (size_t j = 0; j < jobs; j++) {
+            work[j].distance = 0.0;
+        }
+        run_threads(jobs, lloyd_worker, work, sizeof(LloydJob));
+        double distance = 0.0;
+        for (size_t j = 0; j < jobs; j++) {
+            distance += work[j].distance;
+        }
+        stats->mean_distance = distance / ((double)total_weight * CDF_SCALE * (km->dims + 1));
+    }
+
+    for (size_t j = 0; j < jobs && work != NULL; j++) {
+        free(work[j].sums);
+        free(work[j].counts);
+    }
+    free(work);
+    free(gaps);
+    return rc;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Builder                                                                  */
+/* ------------------------------------------------------------------------ */
+
+/* Static helper: write the table header and bucket ids */
+static int write_table(const char* const path, const AbstractionConfig* const config,
+                       const uint64_t num_hands, const uint8_t* const features,
+                       const uint16_t* const assignment) {
+    FILE* const file = fopen(path, "wb");
+    if (file == NULL) {
+        return -1;
+    }
+    const size_t bucket_bytes = (config->num_buckets <= 256) ? 1 : 2;
+    uint8_t header[TABLE_HEADER_SIZE] = {0};
+    memcpy(header, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+    header[4] = BUCKET_TABLE_FORMAT_VERSION;
+    header[5] = (uint8_t)config->street;
+    header[6] = (uint8_t)bucket_bytes;
+    put_u32(header + 8, (uint32_t)config->num_buckets);
+    put_u32(header + 12, config->bins);
+    put_u64(header + 16, num_hands);
+
+    uint8_t* const chunk = malloc(WRITE_CHUNK * bucket_bytes);
+    int ok = (chunk != NULL) && fwrite(header, sizeof(header), 1, file) == 1;
+    for (uint64_t h = 0; h < num_hands && ok; h += WRITE_CHUNK) {
+        const size_t n = (num_hands - h < WRITE_CHUNK) ? (size_t)(num_hands - h) : WRITE_CHUNK;
+        for (size_t i = 0; i < n; i++) {
+            /* River assignments are per strength bin */
+            const uint16_t bucket = (config->street == HAND_INDEX_RIVER)
+                                        ? assignment[features[h + i]]
+                                        : assignment[h + i];
+            chunk[i * bucket_bytes] = (uint8_t)bucket;
+            if (bucket_bytes == 2) {
+                chunk[i * bucket_bytes + 1] = (uint8_t)(bucket >> 8);
+            }
+        }
+        ok = fwrite(chunk, bucket_bytes, n, file) == n;
+    }
+    free(chunk);
+    if (fclose(file) != 0 || !ok) {
+        remove(path);
+        return -1;
+    }
+    return 0;
+}
+
+/* Static helper: map an unlinked scratch file for the features */
+static uint8_t* map_features(const char* const path, const size_t size) {
+    const size_t len = strlen(path);
+    char* const scratch = malloc(len + sizeof(".features"));
+    if (scratch == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    memcpy(scratch, path, len);
+    memcpy(scratch + len, ".features", sizeof(".features"));
+
+    const int fd = open(scratch, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    void* map = MAP_FAILED;
+    if (fd >= 0) {
+        if (ftruncate(fd, (off_t)size) == 0) {
+            map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);  /* The mapping keeps the file referenced */
+        unlink(scratch);
+    }
+    free(scratch);
+    if (map == MAP_FAILED) {
+        poker_errno = POKER_EIO;
+        return NULL;
+    }
+    return (uint8_t*)map;
+}
+
+int abstraction_build(const AbstractionConfig* const config, const char* const path,
+                      AbstractionStats* const out_stats) {
+    if (config == NULL || path == NULL || config->street < HAND_INDEX_PREFLOP ||
+        config->street >= HAND_INDEX_STREETS || config->num_buckets == 0 ||
+        config->num_buckets > ABSTRACTION_MAX_BUCKETS || config->bins < 2 ||
+        config->bins > ABSTRACTION_MAX_BINS || config->iterations == 0 ||
+        (config->street == HAND_INDEX_PREFLOP && config->samples == 0)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    const uint64_t num_hands = hand_index_count(config->street);
+    if (num_hands == 0) {
+        return -1;
+    }
+    const size_t threads = resolve_thread_count(config->num_threads);
+
+    FeatureSpec spec;
+    spec.street = config->street;
+    spec.bins = config->bins;
+    spec.samples = config->samples;
+    spec.seed = config->seed;
+    spec.record_bytes = (config->street == HAND_INDEX_RIVER) ? 1 : config->bins - 1;
+    const size_t features_size = (size_t)num_hands * spec.record_bytes;
+    spec.features = map_features(path, features_size);
+    if (spec.features == NULL) {
+        return -1;
+    }
+
+    AbstractionStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.num_hands = num_hands;
+
+    KMeans km;
+    memset(&km, 0, sizeof(km));
+    km.dims = config->bins - 1;
+    km.k = config->num_buckets;
+    uint8_t* steps = NULL;
+    uint64_t* weights = NULL;
+    int rc = compute_features(&spec, threads);
+
+    if (rc == 0 && config->street == HAND_INDEX_RIVER) {
+        /* Cluster the strength bins, weighted by how many hands fall in each */
+        km.count = config->bins;
+        steps = malloc(km.count * km.dims);
+        weights = calloc(km.count, sizeof(uint64_t));
+        if (steps == NULL || weights == NULL) {
+            poker_errno = POKER_ENOMEM;
+            rc = -1;
+        } else {
+            for (uint64_t h = 0; h < num_hands; h++) {
+                weights[spec.features[h]]++;
+            }
+            for (size_t b = 0; b < km.count; b++) {
+                for (size_t d = 0; d < km.dims; d++) {
+                    steps[b * km.dims + d] = (d >= b) ? CDF_SCALE : 0;
+                }
+            }
+            km.records = steps;
+            km.weights = weights;
+        }
+    } else if (rc == 0) {
+        km.count = (size_t)num_hands;
+        km.records = spec.features;
+    }
+
+    if (rc == 0) {
+        km.centroids = malloc(km.k * km.dims * sizeof(double));
+        km.half_gap = malloc(km.k * sizeof(double));
+        km.shift = malloc(km.k * sizeof(double));
+        km.assignment = malloc(km.count * sizeof(uint16_t));
+        km.upper = malloc(km.count * sizeof(float));
+        km.lower = malloc(km.count * sizeof(float));
+        if (km.centroids == NULL || km.half_gap == NULL || km.shift == NULL ||
+            km.assignment == NULL || km.upper == NULL || km.lower == NULL) {
+            poker_errno = POKER_ENOMEM;
+            rc = -1;
+        }
+    }
+    if (rc == 0) {
+        rc = run_kmeans(&km, config, threads, &stats);
+    }
+    if (rc == 0 && config->street == HAND_INDEX_RIVER) {
+        /* Buckets no bin maps to are empty among the hands too */
+        stats.empty_buckets = 0;
+        for (size_t c = 0; c < km.k; c++) {
+            size_t b = 0;
+            while (b < km.count && (km.assignment[b] != c || weights[b] == 0)) {
+                b++;
+            }
+            stats.empty_buckets += (b == km.count);
+        }
+    }
+    if (rc == 0 && write_table(path, config, num_hands, spec.features, km.assignment) != 0) {
+        poker_errno = POKER_EIO;
+        rc = -1;
+    }
+
+    munmap(spec.features, features_size);
+    free(steps);
+    free(weights);
+    free(km.centroids);
+    free(km.half_gap);
+    free(km.shift);
+    free(km.assignment);
+    free(km.upper);
+    free(km.lower);
+    if (rc == 0 && out_stats != NULL) {
+        *out_stats = stats;
+    }
+    return rc;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Bucket tables                                                            */
+/* ------------------------------------------------------------------------ */
+
+struct BucketTable {
+    uint8_t* map;
+    size_t size;
+    int street;
+    size_t num_buckets;
+    size_t bucket_bytes;
+    uint64_t num_hands;
+};
+
+/* Static helper: open failure path that releases everything */
+static BucketTable* table_fail(BucketTable* const table, const int error) {
+    bucket_table_close(table);
+    poker_errno = error;
+    return NULL;
+}
+
+BucketTable* bucket_table_open(const char* const path) {
+    if (path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+    const size_t size = (size_t)st.st_size;
+    if (size < TABLE_HEADER_SIZE) {
+        close(fd);
+        poker_errno = POKER_EFORMAT;
+        return NULL;
+    }
+    void* const map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* The mapping keeps the file referenced */
+    if (map == MAP_FAILED) {
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+
+    BucketTable* const table = calloc(1, sizeof(BucketTable));
+    if (table == NULL) {
+        munmap(map, size);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    table->map = (uint8_t*)map;
+    table->size = size;
+
+    const uint8_t* const header = table->map;
+    table->street = header[5];
+    table->bucket_bytes = header[6];
+    table->num_buckets = get_u32(header + 8);
+    table->num_hands = get_u64(header + 16);
+    if (memcmp(header, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0 ||
+        header[4] != BUCKET_TABLE_FORMAT_VERSION || table->street >= HAND_INDEX_STREETS ||
+        (table->bucket_bytes != 1 && table->bucket_bytes != 2) || table->num_buckets == 0 ||
+        table->num_buckets > ((table->bucket_bytes == 1) ? 256 : ABSTRACTION_MAX_BUCKETS) ||
+        table->num_hands != hand_index_count(table->street) ||
+        (size - TABLE_HEADER_SIZE) / table->bucket_bytes != table->num_hands ||
+        (size - TABLE_HEADER_SIZE) % table->bucket_bytes != 0) {
+        return table_fail(table, POKER_EFORMAT);
+    }
+    return table;
+}
+
+void bucket_table_close(BucketTable* const table) {
+    if (table == NULL) {
+        return;
+    }
+    if (table->map != NULL) {
+        munmap(table->map, table->size);
+    }
+    free(table);
+}
+
+int bucket_table_street(const BucketTable* const table) {
+    return (table != NULL) ? table->street : -1;
+}
+
+size_t bucket_table_buckets(const BucketTable* const table) {
+    return (table != NULL) ? table->num_buckets : 0;
+}
+
+int bucket_table_lookup(const BucketTable* const table, const uint8_t* const cards,
+                        const size_t num_cards) {
+    if (table == NULL || num_cards != HOLE_SIZE + STREET_BOARD_CARDS[table->street]) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    uint64_t index;
+    if (hand_index(cards, num_cards, &index) != 0) {
+        return -1;
+    }
+    const uint8_t* const entry = table->map + TABLE_HEADER_SIZE + index * table->bucket_bytes;
+    unsigned bucket = entry[0];
+    if (table->bucket_bytes == 2) {
+        bucket |= (unsigned)entry[1] << 8;
+    }
+    if (bucket >= table->num_buckets) {
+        poker_errno = POKER_EFORMAT;
+        return -1;
+    }
+    return (int)bucket;
+}
@@ -0,0 +1,302 @@
+/*
+ * boardrank.c - Sorted rankings of every live combo on a board
+ */
+
+#include "../include/poker_boardrank.h"
+#include <stdlib.h>
+
+/* Combo index bits in a ranking key (value << COMBO_BITS | combo) */
+#define COMBO_BITS 11
+#define COMBO_MASK ((1u << COMBO_BITS) - 1)
+
+/*
+ * Direct-mapped cache of rankings (slot board 0 = empty)
+ */
+struct BoardRankCache {
+    BoardRanking* slots;
+    size_t capacity;
+    uint64_t hits;
+    uint64_t misses;
+};
+
+/* Static helper: LSD radix sort of ranking keys by value (three byte passes) */
+static const uint64_t* sort_by_value(uint64_t* keys, uint64_t* tmp, const size_t n) {
+    for (unsigned shift = COMBO_BITS; shift < COMBO_BITS + 24; shift += 8) {
+        size_t offsets[257] = {0};
+        for (size_t i = 0; i < n; i++) {
+            offsets[((keys[i] >> shift) & 0xFF) + 1]++;
+        }
+        for (size_t d = 1; d < 257; d++) {
+            offsets[d] += offsets[d - 1];
+        }
+        for (size_t i = 0; i < n; i++) {
+            tmp[offsets[(keys[i] >> shift) & 0xFF]++] = keys[i];
+        }
+        uint64_t* const swap = keys;
+        keys = tmp;
+        tmp = swap;
+    }
+    return keys;
+}
+
+int board_ranking_build(const uint64_t board, BoardRanking* const out) {
+    const int cards = __builtin_popcountll(board);
+    if (out == NULL || cards < 3 || cards > BOARD_SIZE || (board >> DECK_SIZE) != 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    uint8_t card_a[HOLE_COMBOS];
+    uint8_t card_b[HOLE_COMBOS];
+    uint64_t keys[HOLE_COMBOS];
+    uint64_t tmp[HOLE_COMBOS];
+    size_t n = 0;
+    size_t c = 0;
+    for (uint8_t b = 1; b < DECK_SIZE; b++) {
+        for (uint8_t a = 0; a < b; a++, c++) {
+            const uint64_t hole = (UINT64_C(1) << a) | (UINT64_C(1) << b);
+            card_a[c] = a;
+            card_b[c] = b;
+            out->wins[c] = out->ties[c] = out->losses[c] = 0;
+            if (hole & board) {
+                out->value[c] = 0;
+                out->position[c] = BOARD_RANK_BLOCKED;
+                continue;
+            }
+            out->value[c] = evaluate_mask(hole | board);
+            keys[n++] = ((uint64_t)out->value[c] << COMBO_BITS) | c;
+        }
+    }
+    const uint64_t* const sorted = sort_by_value(keys, tmp, n);
+    out->board = board;
+    out->num_combos = n;
+
+    /*
+     * Ascending sweep over tie groups: a combo beats everything below its
+     * group except combos sharing one of its cards, counted per card
+     */
+    uint16_t below = 0;
+    uint16_t card_below[DECK_SIZE] = {0};
+    uint16_t card_group[DECK_SIZE] = {0};
+    size_t i = 0;
+    while (i < n) {
+        const uint64_t value = sorted[i] >> COMBO_BITS;
+        size_t j = i;
+        for (; j < n && (sorted[j] >> COMBO_BITS) == value; j++) {
+            const size_t combo = sorted[j] & COMBO_MASK;
+            out->order[j] = (uint16_t)combo;
+            out->position[combo] = (uint16_t)j;
+            card_group[card_a[combo]]++;
+            card_group[card_b[combo]]++;
+        }
+        for (size_t k = i; k < j; k++) {
+            const size_t combo = out->order[k];
+            const uint8_t a = card_a[combo];
+            const uint8_t b = card_b[combo];
+            out->group_end[k] = (uint16_t)j;
+            out->wins[combo] = (uint16_t)(below - card_below[a] - card_below[b]);
+            /* The combo itself shares both cards: counted twice, added back once */
+            out->ties[combo] = (uint16_t)((j - i) - card_group[a] - card_group[b] + 1);
+        }
+        for (size_t k = i; k < j; k++) {
+            const size_t combo = out->order[k];
+            card_below[card_a[combo]]++;
+            card_below[card_b[combo]]++;
+            card_group[card_a[combo]] = 0;
+            card_group[card_b[combo]] = 0;
+        }
+        below = (uint16_t)(below + (j - i));
+        i = j;
+    }
+
+    /* Opponents left after removing the combo's cards (and the combo itself) */
+    for (size_t k = 0; k < n; k++) {
+        const size_t combo = out->order[k];
+        const unsigned live = below - card_below[card_a[combo]] - card_below[card_b[combo]] + 1;
+        out->losses[combo] = (uint16_t)(live - out->wins[combo] - out->ties[combo]);
+    }
+    return 0;
+}
+
+/* Static helper: combo index of a live hole on the ranked board, or -1 */
+static int live_combo(const BoardRanking* const ranking, const uint64_t hole) {
+    const int combo = (ranking != NULL) ? hole_combo_index(hole) : -1;
+    if (combo < 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    if (hole & ranking->board) {
+        poker_errno = POKER_EDUPLICATE;
+        return -1;
+    }
+    return combo;
+}
+
+int board_ranking_beaten_by(const BoardRanking* const ranking, const uint64_t hole) {
+    const int combo = live_combo(ranking, hole);
+    return (combo < 0) ? -1 : ranking->losses[combo];
+}
+
+int board_ranking_is_nuts(const BoardRanking* const ranking, const uint64_t hole) {
+    const int combo = live_combo(ranking, hole);
+    return (combo < 0) ? -1 : (ranking->losses[combo] == 0);
+}
+
+double board_ranking_percentile(const BoardRanking* const ranking, const uint64_t hole) {
+    const int combo = live_combo(ranking, hole);
+    if (combo < 0) {
+        return -1.0;
+    }
+    const unsigned live = ranking->wins[combo] + ranking->ties[combo] + ranking->losses[combo];
+    return (ranking->wins[combo] + 0.5 * ranking->ties[combo]) / live;
+}
+
+size_t board_ranking_count_above(const BoardRanking* const ranking, const HandValue value) {
+    if (ranking == NULL) {
+        poker_errno = POKER_EINVAL;
+        return 0;
+    }
+
+    /* First position whose value exceeds value */
+    size_t low = 0;
+    size_t high = ranking->num_combos;
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (ranking->value[ranking->order[mid]] > value) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return ranking->num_combos - low;
+}
+
+int board_ranking_showdown(const BoardRanking* const ranking, const double* const opp_weights,
+                           double* const out_values, double* const out_totals) {
+    if (ranking == NULL || out_values == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    uint8_t card_a[HOLE_COMBOS];
+    uint8_t card_b[HOLE_COMBOS];
+    size_t c = 0;
+    for (uint8_t b = 1; b < DECK_SIZE; b++) {
+        for (uint8_t a = 0; a < b; a++, c++) {
+            card_a[c] = a;
+            card_b[c] = b;
+            out_values[c] = 0.0;
+            if (out_totals != NULL) {
+                out_totals[c] = 0.0;
+            }
+        }
+    }
+
+    /* out_values holds 2 * beaten + tied until the totals are known */
+    const size_t n = ranking->num_combos;
+    double below = 0.0;
+    double card_below[DECK_SIZE] = {0};
+    double card_group[DECK_SIZE] = {0};
+    for (size_t i = 0; i < n; i = ranking->group_end[i]) {
+        const size_t end = ranking->group_end[i];
+        double group = 0.0;
+        for (size_t k = i; k < end; k++) {
+            const size_t combo = ranking->order[k];
+            const double w = opp_weights ? opp_weights[combo] : 1.0;
+            group += w;
+            card_group[card_a[combo]] += w;
+            card_group[card_b[combo]] += w;
+        }
+        for (size_t k = i; k < end; k++) {
+            const size_t combo = ranking->order[k];
+            const uint8_t a = card_a[combo];
+            const uint8_t b = card_b[combo];
+            const double w = opp_weights ? opp_weights[combo] : 1.0;
+            const double beaten = below - card_below[a] - card_below[b];
+            /* The combo itself is in both card sums: removed twice, added back once */
+            const double tied = group - card_group[a] - card_group[b] + w;
+            out_values[combo] = 2.0 * beaten + tied;
+        }
+        for (size_t k = i; k < end; k++) {
+            const size_t combo = ranking->order[k];
+            const double w = opp_weights ? opp_weights[combo] : 1.0;
+            card_below[card_a[combo]] += w;
+            card_below[card_b[combo]] += w;
+            card_group[card_a[combo]] = 0.0;
+            card_group[card_b[combo]] = 0.0;
+        }
+        below += group;
+    }
+
+    /* After the sweep below is the whole range: beaten - lost = 2 * beaten + tied - total */
+    for (size_t k = 0; k < n; k++) {
+        const size_t combo = ranking->order[k];
+        const double w = opp_weights ? opp_weights[combo] : 1.0;
+        const double total = below - card_below[card_a[combo]] - card_below[card_b[combo]] + w;
+        out_values[combo] -= total;
+        if (out_totals != NULL) {
+            out_totals[combo] = total;
+        }
+    }
+    return 0;
+}
+
+BoardRankCache* board_rank_cache_create(const size_t capacity) {
+    if (capacity == 0) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+    BoardRankCache* const cache = malloc(sizeof(BoardRankCache));
+    BoardRanking* const slots = (capacity <= SIZE_MAX / sizeof(BoardRanking))
+                                    ? malloc(capacity * sizeof(BoardRanking)) : NULL;
+    if (cache == NULL || slots == NULL) {
+        free(cache);
+        free(slots);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    for (size_t s = 0; s < capacity; s++) {
+        slots[s].board = 0;
+    }
+    cache->slots = slots;
+    cache->capacity = capacity;
+    cache->hits = 0;
+    cache->misses = 0;
+    return cache;
+}
+
+void board_rank_cache_destroy(BoardRankCache* const cache) {
+    if (cache != NULL) {
+        free(cache->slots);
+        free(cache);
+    }
+}
+
+const BoardRanking* board_rank_cache_get(BoardRankCache* const cache, const uint64_t board) {
+    if (cache == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+    /* Fibonacci hash: the high bits mix every card of the board */
+    const uint64_t hash = (board * UINT64_C(0x9E3779B97F4A7C15)) >> 32;
+    BoardRanking* const slot = &cache->slots[hash % cache->capacity];
+    if (slot->board == board && board != 0) {
+        cache->hits++;
+        return slot;
+    }
+    if (board_ranking_build(board, slot) != 0) {
+        return NULL;
+    }
+    cache->misses++;
+    return slot;
+}
+
+void board_rank_cache_stats(const BoardRankCache* const cache, uint64_t* const out_hits,
+                            uint64_t* const out_misses) {
+    if (out_hits != NULL) {
+        *out_hits = (cache != NULL) ? cache->hits : 0;
+    }
+    if (out_misses != NULL) {
+        *out_misses = (cache != NULL) ? cache->misses : 0;
+    }
+}
@@ -1,9 +1,44 @@
 /* card.c - Card representation and utilities */
 
-#include <stdio.h>
-#include <string.h>
-#include <ctype.h>
 #include "../include/poker.h"
+#include "card_chars.h"
+
+/*
+ * Character lookup tables for card parsing
+ *
+ * Each table maps a raw input byte straight to its decoded value so the
+ * parsers never branch on character ranges or call toupper(). A value of 0
+ * marks an invalid byte: ranks are stored as their Rank value (2-14) and
+ * suits as Suit + 1 (1-4). Both cases are accepted, matching parse_card().
+ */
+static const uint8_t RANK_FROM_CHAR[256] = {
+    ['2'] = RANK_TWO,   ['3'] = RANK_THREE, ['4'] = RANK_FOUR,
+    ['5'] = RANK_FIVE,  ['6'] = RANK_SIX,   ['7'] = RANK_SEVEN,
+    ['8'] = RANK_EIGHT, ['9'] = RANK_NINE,
+    ['T'] = RANK_TEN,   ['t'] = RANK_TEN,
+    ['J'] = RANK_JACK,  ['j'] = RANK_JACK,
+    ['Q'] = RANK_QUEEN, ['q'] = RANK_QUEEN,
+    ['K'] = RANK_KING,  ['k'] = RANK_KING,
+    ['A'] = RANK_ACE,   ['a'] = RANK_ACE
+};
+
+static const uint8_t SUIT_FROM_CHAR[256] = {
+    ['H'] = SUIT_HEARTS + 1,   ['h'] = SUIT_HEARTS + 1,
+    ['D'] = SUIT_DIAMONDS + 1, ['d'] = SUIT_DIAMONDS + 1,
+    ['C'] = SUIT_CLUBS + 1,    ['c'] = SUIT_CLUBS + 1,
+    ['S'] = SUIT_SPADES + 1,   ['s'] = SUIT_SPADES + 1
+};
+
+/* Characters for formatting, shared with format.c (card_chars.h) */
+const char RANK_TO_CHAR[RANK_ARRAY_SIZE] = {
+    '?', '?', '2', '3', '4', '5', '6', '7', '8', '9', 'T', 'J', 'Q', 'K', 'A'
+};
+const char SUIT_TO_CHAR[4] = { 'h', 'd', 'c', 's' };
+
+/* Bytes that may appear between cards in a hand string */
+static const uint8_t IS_HAND_SEPARATOR[256] = {
+    [' '] = 1, ['\t'] = 1, ['\r'] = 1, ['\n'] = 1, [','] = 1
+};
 
 int card_to_string(const Card card, char* const buffer, const size_t size) {
     // Check buffer size - need at least 3 bytes (2 chars + null terminator)
@@ -11,37 +46,15 @@ int card_to_string(const Card card, char* const buffer, const size_t size) {
         return -1;
     }
 
-    // Map rank to character
-    char rank_char;
-    switch (card.rank) {
-        case RANK_TWO:   rank_char = '2'; break;
-        case RANK_THREE: rank_char = '3'; break;
-        case RANK_FOUR:  rank_char = '4'; break;
-        case RANK_FIVE:  rank_char = '5'; break;
-        case RANK_SIX:   rank_char = '6'; break;
-        case RANK_SEVEN: rank_char = '7'; break;
-        case RANK_EIGHT: rank_char = '8'; break;
-        case RANK_NINE:  rank_char = '9'; break;
-        case RANK_TEN:   rank_char = 'T'; break;
-        case RANK_JACK:  rank_char = 'J'; break;
-        case RANK_QUEEN: rank_char = 'Q'; break;
-        case RANK_KING:  rank_char = 'K'; break;
-        case RANK_ACE:   rank_char = 'A'; break;
-        default:         return -1;
-    }
-
-    // Map suit to character
-    char suit_char;
-    switch (card.suit) {
-        case SUIT_HEARTS:   suit_char = 'h'; break;
-        case SUIT_DIAMONDS: suit_char = 'd'; break;
-        case SUIT_CLUBS:    suit_char = 'c'; break;
-        case SUIT_SPADES:   suit_char = 's'; break;
-        default:            return -1;
+    // Validate rank and suit before indexing the character tables
+    if (card.rank < RANK_TWO || card.rank > RANK_ACE || card.suit > SUIT_SPADES) {
+        return -1;
     }
 
-    // Use snprintf for buffer overflow protection
-    snprintf(buffer, size, "%c%c", rank_char, suit_char);
+    // Map rank and suit to characters via lookup tables
+    buffer[0] = RANK_TO_CHAR[card.rank];
+    buffer[1] = SUIT_TO_CHAR[card.suit];
+    buffer[2] = '\0';
     return 0;
 }
 
@@ -51,48 +64,149 @@ int parse_card(const char* const str, Card* const out_card) {
         return -1;
     }
 
-    // Validate string length (must be exactly 2 characters)
-    size_t len = strlen(str);
-    if (len != 2) {
+    // Validate string length (must be exactly 2 characters). Checking the
+    // bytes directly avoids a full strlen() scan on long inputs.
+    if (str[0] == '\0' || str[1] == '\0' || str[2] != '\0') {
         return -1;
     }
 
-    // Parse rank character (case-insensitive)
-    char rank_char = toupper(str[0]);
-    uint8_t rank;
-
-    switch (rank_char) {
-        case '2': rank = RANK_TWO;   break;
-        case '3': rank = RANK_THREE; break;
-        case '4': rank = RANK_FOUR;  break;
-        case '5': rank = RANK_FIVE;  break;
-        case '6': rank = RANK_SIX;   break;
-        case '7': rank = RANK_SEVEN; break;
-        case '8': rank = RANK_EIGHT; break;
-        case '9': rank = RANK_NINE;  break;
-        case 'T': rank = RANK_TEN;   break;
-        case 'J': rank = RANK_JACK;  break;
-        case 'Q': rank = RANK_QUEEN; break;
-        case 'K': rank = RANK_KING;  break;
-        case 'A': rank = RANK_ACE;   break;
-        default:  return -1;
-    }
-
-    // Parse suit character (case-insensitive)
-    char suit_char = toupper(str[1]);
-    uint8_t suit;
-
-    switch (suit_char) {
-        case 'H': suit = SUIT_HEARTS;   break;
-        case 'D': suit = SUIT_DIAMONDS; break;
-        case 'C': suit = SUIT_CLUBS;    break;
-        case 'S': suit = SUIT_SPADES;   break;
-        default:  return -1;
+    // Decode rank and suit via lookup tables (case-insensitive)
+    const uint8_t rank = RANK_FROM_CHAR[(unsigned char)str[0]];
+    const uint8_t suit = SUIT_FROM_CHAR[(unsigned char)str[1]];
+    if (rank == 0 || suit == 0) {
+        return -1;
     }
 
     // Set output card
     out_card->rank = rank;
-    out_card->suit = suit;
+    out_card->suit = (uint8_t)(suit - 1);
 
     return 0;
 }
+
+/**
+ * @brief Shared scanner behind parse_hand() and parse_hand_mask()
+ *
+ * Walks the input once, skipping separators and decoding each two-byte card
+ * through the lookup tables. Duplicate detection uses a 64-bit seen-mask
+ * indexed by CARD_INDEX, so validation costs one AND per card.
+ *
+ * @param out Card output array (can be NULL when only the mask is wanted)
+ * @param max Capacity of out (ignored when out is NULL)
+ * @return Number of cards parsed, or -1 on error with poker_errno set
+ */
+static int parse_cards(const char* const str, const size_t len,
+                       Card* const out, const size_t max,
+                       uint64_t* const out_mask,
+                       size_t* const out_error_pos) {
+    const unsigned char* const bytes = (const unsigned char*)str;
+    uint64_t seen = 0;
+    size_t count = 0;
+    size_t i = 0;
+    size_t error_pos = 0;
+    int error = POKER_EOK;
+
+    while (i < len) {
+        const unsigned char c = bytes[i];
+        const uint8_t rank = RANK_FROM_CHAR[c];
+        if (rank == 0) {
+            if (IS_HAND_SEPARATOR[c]) {
+                i++;
+                continue;
+            }
+            error = POKER_EINVAL;
+            error_pos = i;
+            break;
+        }
+
+        const uint8_t suit_code = (i + 1 < len) ? SUIT_FROM_CHAR[bytes[i + 1]] : 0;
+        if (suit_code == 0) {
+            error = POKER_EINVAL;
+            error_pos = i + 1;
+            break;
+        }
+
+        const uint8_t suit = (uint8_t)(suit_code - 1);
+        const uint64_t bit = UINT64_C(1) << ((rank - RANK_TWO) * 4 + suit);
+        if (seen & bit) {
+            error = POKER_EDUPLICATE;
+            error_pos = i;
+            break;
+        }
+        if (out != NULL) {
+            if (count >= max) {
+                error = POKER_ERANGE;
+                error_pos = i;
+                break;
+            }
+            out[count].rank = rank;
+            out[count].suit = suit;
+        }
+
+        seen |= bit;
+        count++;
+        i += 2;
+    }
+
+    if (error != POKER_EOK) {
+        poker_errno = error;
+        if (out_error_pos != NULL) {
+            *out_error_pos = error_pos;
+        }
+        return -1;
+    }
+
+    if (out_mask != NULL) {
+        *out_mask = seen;
+    }
+    return (int)count;
+}
+
+/**
+ * @brief Parse a whole hand string into an array of cards
+ *
+ * Accepts concatenated cards ("AhKsQd7c2s") optionally separated by spaces,
+ * tabs, commas or line endings. Parsing and validation happen in a single
+ * pass; the first error stops the scan and its byte offset is reported.
+ *
+ * @param str Input text (need not be NUL-terminated)
+ * @param len Number of bytes of str to parse
+ * @param out Output array for parsed cards
+ * @param max Capacity of out
+ * @param out_error_pos Optional pointer to receive the offset of the error
+ * @return Number of cards parsed, or -1 on error with poker_errno set to
+ *         POKER_EINVAL, POKER_EDUPLICATE or POKER_ERANGE
+ */
+int parse_hand(const char* const str, const size_t len,
+               Card* const out, const size_t max,
+               size_t* const out_error_pos) {
+    if (str == NULL || out == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    return parse_cards(str, len, out, max, NULL, out_error_pos);
+}
+
+/**
+ * @brief Parse a whole hand string into a 64-bit card mask
+ *
+ * Same grammar and error reporting as parse_hand(), but produces a card
+ * mask (bit CARD_INDEX(card) set for every card) instead of a Card array.
+ *
+ * @param str Input text (need not be NUL-terminated)
+ * @param len Number of bytes of str to parse
+ * @param out_mask Pointer to receive the card mask
+ * @param out_error_pos Optional pointer to receive the offset of the error
+ * @return Number of cards parsed, or -1 on error with poker_errno set
+ */
+int parse_hand_mask(const char* const str, const size_t len,
+                    uint64_t* const out_mask,
+                    size_t* const out_error_pos) {
+    if (str == NULL || out_mask == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    return parse_cards(str, len, NULL, 0, out_mask, out_error_pos);
+}
@@ -0,0 +1,15 @@
+/*
+ * card_chars.h - Internal rank and suit character tables (card.c)
+ * Private to the library; not installed with the public headers
+ */
+
+#ifndef POKER_CARD_CHARS_H
+#define POKER_CARD_CHARS_H
+
+#include "../include/poker.h"
+
+/* Characters for formatting, indexed by Rank value ('?' below RANK_TWO) and Suit value */
+extern const char RANK_TO_CHAR[RANK_ARRAY_SIZE];
+extern const char SUIT_TO_CHAR[4];
+
+#endif /* POKER_CARD_CHARS_H */
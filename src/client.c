@@ -0,0 +1,225 @@
+/*
+ * client.c - Blocking client for the local evaluation service
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_server.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+struct PokerClient {
+    int fd;
+    uint32_t next_id;
+};
+
+/* Static helper: write every byte of the iovecs */
+static int send_all(const int fd, struct iovec* iov, size_t num_iov) {
+    while (num_iov > 0) {
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = num_iov;
+        const ssize_t sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        size_t done = (size_t)sent;
+        while (num_iov > 0 && done >= iov->iov_len) {
+            done -= iov->iov_len;
+            iov++;
+            num_iov--;
+        }
+        if (num_iov > 0) {
+            iov->iov_base = (char*)iov->iov_base + done;
+            iov->iov_len -= done;
+        }
+    }
+    return 0;
+}
+
+/* Static helper: read exactly size bytes */
+static int recv_all(const int fd, void* const buffer, const size_t size) {
+    size_t got = 0;
+    while (got < size) {
+        const ssize_t n = recv(fd, (char*)buffer + got, size - got, 0);
+        if (n == 0) {
+            return -1;
+        }
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        got += (size_t)n;
+    }
+    return 0;
+}
+
+/*
+ * Static helper: send one request and read its response
+ *
+ * On SERVER_STATUS_OK the response payload must be exactly reply_size bytes
+ * and is read into reply. Other statuses map to poker_errno.
+ */
+static int round_trip(PokerClient* const client, const uint16_t type, const uint32_t count,
+                      const uint32_t deadline_us, const void* const part1, const size_t size1,
+                      const void* const part2, const size_t size2,
+                      void* const reply, const size_t reply_size) {
+    ServerRequestHeader header;
+    memset(&header, 0, sizeof(header));
+    header.id = client->next_id++;
+    header.type = type;
+    header.count = count;
+    header.deadline_us = deadline_us;
+
+    struct iovec iov[3];
+    size_t num_iov = 0;
+    iov[num_iov].iov_base = &header;
+    iov[num_iov++].iov_len = sizeof(header);
+    if (size1 > 0) {
+        iov[num_iov].iov_base = (void*)part1;
+        iov[num_iov++].iov_len = size1;
+    }
+    if (size2 > 0) {
+        iov[num_iov].iov_base = (void*)part2;
+        iov[num_iov++].iov_len = size2;
+    }
+
+    ServerResponseHeader response;
+    if (send_all(client->fd, iov, num_iov) != 0 ||
+        recv_all(client->fd, &response, sizeof(response)) != 0 ||
+        response.id != header.id) {
+        poker_errno = POKER_EIO;
+        return -1;
+    }
+
+    switch (response.status) {
+        case SERVER_STATUS_OK:
+            break;
+        case SERVER_STATUS_INVALID:
+            poker_errno = POKER_EINVAL;
+            return -1;
+        case SERVER_STATUS_DEADLINE:
+            poker_errno = POKER_ETIMEDOUT;
+            return -1;
+        case SERVER_STATUS_BUSY:
+            poker_errno = POKER_EBUSY;
+            return -1;
+        default:
+            poker_errno = POKER_EFORMAT;
+            return -1;
+    }
+
+    if (response.payload_size != reply_size) {
+        poker_errno = POKER_EFORMAT;
+        return -1;
+    }
+    if (reply_size > 0 && recv_all(client->fd, reply, reply_size) != 0) {
+        poker_errno = POKER_EIO;
+        return -1;
+    }
+    return 0;
+}
+
+PokerClient* client_connect(const char* const socket_path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path == NULL || strlen(socket_path) >= sizeof(addr.sun_path)) {
+        poker_errno = POKER_EIO;
+        return NULL;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    PokerClient* const client = malloc(sizeof(PokerClient));
+    if (client == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    client->next_id = 1;
+    client->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client->fd < 0 ||
+        connect(client->fd, (const struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        if (client->fd >= 0) {
+            close(client->fd);
+        }
+        free(client);
+        poker_errno = POKER_EIO;
+        return NULL;
+    }
+    return client;
+}
+
+int client_evaluate(PokerClient* const client, const uint64_t* const masks,
+                    const size_t count, const uint32_t deadline_us,
+                    HandValue* const out_values) {
+    if (client == NULL || masks == NULL || out_values == NULL ||
+        count == 0 || count > SERVER_MAX_HANDS) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    return round_trip(client, SERVER_REQ_EVALUATE, (uint32_t)count, deadline_us,
+                      masks, count * sizeof(uint64_t), NULL, 0,
+                      out_values, count * sizeof(HandValue));
+}
+
+int client_equity(PokerClient* const client, const uint64_t* const hole_masks,
+                  const size_t num_players, const uint64_t board, const uint64_t dead,
+                  const uint32_t samples, const uint32_t seed, const uint32_t deadline_us,
+                  EquityResult* const out) {
+    if (client == NULL || hole_masks == NULL || out == NULL ||
+        num_players < 2 || num_players > MAX_PLAYERS) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    ServerEquityRequest request;
+    memset(&request, 0, sizeof(request));
+    request.board = board;
+    request.dead = dead;
+    request.samples = samples;
+    request.seed = seed;
+
+    struct {
+        ServerEquityReply head;
+        double values[3 * MAX_PLAYERS];
+    } reply;
+    const size_t reply_size = sizeof(ServerEquityReply) + 3 * num_players * sizeof(double);
+    if (round_trip(client, SERVER_REQ_EQUITY, (uint32_t)num_players, deadline_us,
+                   &request, sizeof(request), hole_masks, num_players * sizeof(uint64_t),
+                   &reply, reply_size) != 0) {
+        return -1;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->trials = reply.head.trials;
+    memcpy(out->equity, reply.values, num_players * sizeof(double));
+    memcpy(out->win, reply.values + num_players, num_players * sizeof(double));
+    memcpy(out->tie, reply.values + 2 * num_players, num_players * sizeof(double));
+    return 0;
+}
+
+int client_ping(PokerClient* const client) {
+    if (client == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    return round_trip(client, SERVER_REQ_PING, 0, 0, NULL, 0, NULL, 0, NULL, 0);
+}
+
+void client_close(PokerClient* const client) {
+    if (client != NULL) {
+        close(client->fd);
+        free(client);
+    }
+}
@@ -0,0 +1,171 @@
+/*
+ * equity.c - All-in equity by board enumeration or Monte Carlo sampling
+ */
+
+#include "../include/poker_equity.h"
+#include <string.h>
+
+/* Mask of the valid card bits */
+#define DECK_MASK ((UINT64_C(1) << DECK_SIZE) - 1)
+
+/* Pot share unit divisible by every possible number of tied players (1-10) */
+#define SHARE_UNIT 2520
+
+/* Static helper: number of set bits */
+static unsigned count_cards(uint64_t mask) {
+    unsigned n = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        n++;
+    }
+    return n;
+}
+
+/* Static helper: splitmix64 step (sampling generator) */
+static uint64_t next_random(uint64_t* const state) {
+    uint64_t z = (*state += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+/*
+ * Showdown accumulator: integer counts so exact enumeration stays exact
+ */
+typedef struct {
+    const uint64_t* holes;
+    size_t num_players;
+    uint64_t trials;
+    uint64_t wins[MAX_PLAYERS];
+    uint64_t ties[MAX_PLAYERS];
+    uint64_t shares[MAX_PLAYERS];
+} Showdown;
+
+/* Static helper: score one complete board */
+static void score_board(Showdown* const sd, const uint64_t board) {
+    HandValue values[MAX_PLAYERS];
+    HandValue best = 0;
+    unsigned winners = 0;
+
+    for (size_t p = 0; p < sd->num_players; p++) {
+        values[p] = evaluate_mask(board | sd->holes[p]);
+        if (values[p] > best) {
+            best = values[p];
+            winners = 1;
+        } else if (values[p] == best) {
+            winners++;
+        }
+    }
+
+    for (size_t p = 0; p < sd->num_players; p++) {
+        if (values[p] == best) {
+            sd->shares[p] += SHARE_UNIT / winners;
+            if (winners == 1) {
+                sd->wins[p]++;
+            } else {
+                sd->ties[p]++;
+            }
+        }
+    }
+    sd->trials++;
+}
+
+int calculate_equity(const uint64_t* const hole_masks, const size_t num_players,
+                     const uint64_t board, const uint64_t dead,
+                     const size_t samples, const uint64_t seed,
+                     EquityResult* const out) {
+    if (hole_masks == NULL || out == NULL || num_players < 2 || num_players > MAX_PLAYERS ||
+        ((board | dead) & ~DECK_MASK) != 0 || count_cards(board) > BOARD_SIZE) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    uint64_t used = board;
+    if (dead & board) {
+        poker_errno = POKER_EDUPLICATE;
+        return -1;
+    }
+    used |= dead;
+    for (size_t p = 0; p < num_players; p++) {
+        if ((hole_masks[p] & ~DECK_MASK) != 0 || count_cards(hole_masks[p]) != HOLE_SIZE) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+        if (hole_masks[p] & used) {
+            poker_errno = POKER_EDUPLICATE;
+            return -1;
+        }
+        used |= hole_masks[p];
+    }
+
+    /* Cards that can still come */
+    uint8_t remaining[DECK_SIZE];
+    size_t num_remaining = 0;
+    for (unsigned i = 0; i < DECK_SIZE; i++) {
+        if (!(used & (UINT64_C(1) << i))) {
+            remaining[num_remaining++] = (uint8_t)i;
+        }
+    }
+    const size_t missing = BOARD_SIZE - count_cards(board);
+    if (missing > num_remaining) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    Showdown sd;
+    memset(&sd, 0, sizeof(sd));
+    sd.holes = hole_masks;
+    sd.num_players = num_players;
+
+    if (missing == 0) {
+        score_board(&sd, board);
+    } else if (samples == 0) {
+        /* Every combination of missing cards, in lexicographic order */
+        size_t idx[BOARD_SIZE];
+        for (size_t i = 0; i < missing; i++) {
+            idx[i] = i;
+        }
+        for (;;) {
+            uint64_t full = board;
+            for (size_t i = 0; i < missing; i++) {
+                full |= UINT64_C(1) << remaining[idx[i]];
+            }
+            score_board(&sd, full);
+
+            size_t i = missing;
+            while (i > 0 && idx[i - 1] == num_remaining - missing + i - 1) {
+                i--;
+            }
+            if (i == 0) {
+                break;
+            }
+            idx[i - 1]++;
+            for (size_t j = i; j < missing; j++) {
+                idx[j] = idx[j - 1] + 1;
+            }
+        }
+    } else {
+        /* Partial Fisher-Yates: the first `missing` slots become the draw */
+        uint64_t state = seed;
+        for (size_t s = 0; s < samples; s++) {
+            uint64_t full = board;
+            for (size_t i = 0; i < missing; i++) {
+                const uint64_t r = next_random(&state) >> 32;
+                const size_t j = i + (size_t)((r * (num_remaining - i)) >> 32);
+                const uint8_t card = remaining[j];
+                remaining[j] = remaining[i];
+                remaining[i] = card;
+                full |= UINT64_C(1) << card;
+            }
+            score_board(&sd, full);
+        }
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->trials = sd.trials;
+    for (size_t p = 0; p < num_players; p++) {
+        out->equity[p] = (double)sd.shares[p] / ((double)SHARE_UNIT * (double)sd.trials);
+        out->win[p] = (double)sd.wins[p] / (double)sd.trials;
+        out->tie[p] = (double)sd.ties[p] / (double)sd.trials;
+    }
+    return 0;
+}
@@ -1,11 +1,362 @@
 /* evaluator.c - Main hand evaluation orchestration */
 
 #include "../include/poker.h"
+#include "threads.h"
+#include <string.h>
+
+/* Fewest rows worth a thread of their own in evaluate_card_rows() */
+#define MIN_ROWS_PER_THREAD 16384
 
 /* Global error indicator - initialized to POKER_EOK (0) */
-int poker_errno = 0;
+POKER_THREAD_LOCAL int poker_errno = 0;
+
+/* Mask of the valid card bits */
+#define DECK_MASK ((UINT64_C(1) << DECK_SIZE) - 1)
+
+/* Rank bit r - RANK_TWO in a 13-bit rank mask */
+#define RANK_BIT(rank) (1u << ((rank) - RANK_TWO))
+
+/* Tiebreakers used by each category, indexed by HandCategory */
+static const uint8_t CATEGORY_TIEBREAKERS[HAND_ROYAL_FLUSH + 1] = {
+    0, 5, 4, 3, 3, 1, 5, 2, 2, 1, 1
+};
+
+/* Static helper: number of set bits */
+static unsigned popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_popcountll(x);
+#else
+    unsigned n = 0;
+    for (; x != 0; x &= x - 1) {
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* Static helper: index of the highest set bit (x != 0) */
+static unsigned highest_bit(const uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31u - (unsigned)__builtin_clz(x);
+#else
+    unsigned i = 0;
+    while ((x >> i) > 1) {
+        i++;
+    }
+    return i;
+#endif
+}
+
+/* Static helper: rank of the highest card in a 13-bit rank mask */
+static unsigned top_rank(const uint32_t ranks) {
+    return highest_bit(ranks) + RANK_TWO;
+}
+
+/*
+ * Static helper: high card of the best straight in a 13-bit rank mask
+ *
+ * The ace is duplicated below the deuce so A-2-3-4-5 (wheel) is found by
+ * the same run test; returns 0 if there is no straight.
+ */
+static unsigned straight_high(const uint32_t ranks) {
+    const uint32_t x = (ranks << 1) | ((ranks >> 12) & 1u);
+    const uint32_t runs = x & (x >> 1) & (x >> 2) & (x >> 3) & (x >> 4);
+    return (runs != 0) ? highest_bit(runs) + 5 : 0;
+}
+
+/* Static helper: pack category and up to five ranks taken from a rank mask */
+static HandValue pack_top(const unsigned category, const unsigned lead, uint32_t ranks,
+                          const unsigned count) {
+    HandValue value = (HandValue)category << HAND_VALUE_CATEGORY_SHIFT;
+    unsigned shift = 16;
+
+    if (lead != 0) {
+        value |= (HandValue)lead << shift;
+        shift -= 4;
+    }
+    for (unsigned i = 0; i < count && ranks != 0; i++) {
+        const unsigned bit = highest_bit(ranks);
+        value |= (HandValue)(bit + RANK_TWO) << shift;
+        ranks &= ~(1u << bit);
+        shift -= 4;
+    }
+    return value;
+}
+
+/* Static helper: evaluate four valid 13-bit suit masks holding 5-7 cards */
+static HandValue evaluate_suit_ranks(const uint32_t suits[4]) {
+    const uint32_t s0 = suits[0], s1 = suits[1], s2 = suits[2], s3 = suits[3];
+    const uint32_t any = s0 | s1 | s2 | s3;
+
+    /* Flush (at most one suit can hold five of seven cards) */
+    uint32_t flush = 0;
+    for (unsigned s = 0; s < 4; s++) {
+        if (popcount64(suits[s]) >= HAND_SIZE) {
+            flush = suits[s];
+        }
+    }
+    if (flush != 0) {
+        const unsigned high = straight_high(flush);
+        if (high == RANK_ACE) {
+            return pack_top(HAND_ROYAL_FLUSH, RANK_ACE, 0, 0);
+        }
+        if (high != 0) {
+            return pack_top(HAND_STRAIGHT_FLUSH, high, 0, 0);
+        }
+    }
+
+    const uint32_t quads = s0 & s1 & s2 & s3;
+    if (quads != 0) {
+        const unsigned quad = top_rank(quads);
+        return pack_top(HAND_FOUR_OF_A_KIND, quad, any & ~RANK_BIT(quad), 1);
+    }
+
+    const uint32_t two_plus = (s0 & s1) | (s0 & s2) | (s0 & s3) | (s1 & s2) | (s1 & s3) | (s2 & s3);
+    const uint32_t trips = (s0 & s1 & s2) | (s0 & s1 & s3) | (s0 & s2 & s3) | (s1 & s2 & s3);
+    const uint32_t pairs = two_plus & ~trips;
+
+    if (trips != 0) {
+        const unsigned trip = top_rank(trips);
+        const uint32_t rest = (trips & ~RANK_BIT(trip)) | pairs;
+        if (rest != 0) {
+            return pack_top(HAND_FULL_HOUSE, trip, rest, 1);
+        }
+    }
+
+    if (flush != 0) {
+        return pack_top(HAND_FLUSH, 0, flush, HAND_SIZE);
+    }
 
-int evaluate_hand(void) {
-    /* Placeholder for hand evaluation */
+    const unsigned high = straight_high(any);
+    if (high != 0) {
+        return pack_top(HAND_STRAIGHT, high, 0, 0);
+    }
+
+    if (trips != 0) {
+        const unsigned trip = top_rank(trips);
+        return pack_top(HAND_THREE_OF_A_KIND, trip, any & ~RANK_BIT(trip), 2);
+    }
+
+    if (pairs != 0) {
+        const unsigned high_pair = top_rank(pairs);
+        const uint32_t lower = pairs & ~RANK_BIT(high_pair);
+        if (lower != 0) {
+            const unsigned low_pair = top_rank(lower);
+            const HandValue value = pack_top(HAND_TWO_PAIR, high_pair, 0, 0) |
+                                    ((HandValue)low_pair << 12);
+            const uint32_t kickers = any & ~RANK_BIT(high_pair) & ~RANK_BIT(low_pair);
+            return value | ((HandValue)top_rank(kickers) << 8);
+        }
+        return pack_top(HAND_ONE_PAIR, high_pair, any & ~RANK_BIT(high_pair), 3);
+    }
+
+    return pack_top(HAND_HIGH_CARD, 0, any, HAND_SIZE);
+}
+
+HandValue evaluate_mask(const uint64_t mask) {
+    const unsigned n = popcount64(mask);
+    if (n < HAND_SIZE || n > HAND_SIZE + 2 || (mask & ~DECK_MASK) != 0) {
+        return 0;
+    }
+
+    /* Four 13-bit suit masks */
+    uint32_t suits[4] = {0, 0, 0, 0};
+    for (uint64_t m = mask; m != 0; m &= m - 1) {
+#if defined(__GNUC__) || defined(__clang__)
+        const unsigned index = (unsigned)__builtin_ctzll(m);
+#else
+        unsigned index = 0;
+        while (((m >> index) & 1) == 0) {
+            index++;
+        }
+#endif
+        suits[index & 3] |= 1u << (index >> 2);
+    }
+    return evaluate_suit_ranks(suits);
+}
+
+HandValue evaluate_suits(const uint32_t suits[4]) {
+    const uint32_t all = suits[0] | suits[1] | suits[2] | suits[3];
+    const unsigned n = popcount64(suits[0]) + popcount64(suits[1]) +
+                       popcount64(suits[2]) + popcount64(suits[3]);
+    if (n < HAND_SIZE || n > HAND_SIZE + 2 || (all >> 13) != 0) {
+        return 0;
+    }
+    return evaluate_suit_ranks(suits);
+}
+
+void evaluate_masks(const uint64_t* const masks, const size_t count,
+                    HandValue* const out_values) {
+    for (size_t i = 0; i < count; i++) {
+        out_values[i] = evaluate_mask(masks[i]);
+    }
+}
+
+/* One thread's share of evaluate_card_rows() */
+typedef struct {
+    const uint8_t* cards;
+    size_t cards_per_hand;
+    size_t begin;
+    size_t end;
+    HandValue* out_values;
+} CardRowsJob;
+
+static void* card_rows_worker(void* arg) {
+    const CardRowsJob* const job = (const CardRowsJob*)arg;
+
+    for (size_t i = job->begin; i < job->end; i++) {
+        const uint8_t* const row = job->cards + i * job->cards_per_hand;
+        uint64_t mask = 0;
+        unsigned out_of_range = 0;
+        for (size_t c = 0; c < job->cards_per_hand; c++) {
+            out_of_range |= (row[c] >= DECK_SIZE);
+            mask |= UINT64_C(1) << (row[c] & 63);
+        }
+        /* A repeated card leaves fewer bits than cards */
+        job->out_values[i] = (out_of_range || popcount64(mask) != job->cards_per_hand)
+                                 ? 0 : evaluate_mask(mask);
+    }
+    return NULL;
+}
+
+int evaluate_card_rows(const uint8_t* const cards, const size_t num_hands,
+                       const size_t cards_per_hand, const size_t num_threads,
+                       HandValue* const out_values) {
+    if ((num_hands > 0 && (cards == NULL || out_values == NULL)) ||
+        cards_per_hand < HAND_SIZE || cards_per_hand > HAND_SIZE + 2) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    size_t threads = resolve_thread_count(num_threads);
+    const size_t useful = num_hands / MIN_ROWS_PER_THREAD;
+    if (threads > useful) {
+        threads = (useful > 0) ? useful : 1;
+    }
+
+    CardRowsJob jobs[256];
+    if (threads > sizeof(jobs) / sizeof(jobs[0])) {
+        threads = sizeof(jobs) / sizeof(jobs[0]);
+    }
+    for (size_t t = 0; t < threads; t++) {
+        jobs[t].cards = cards;
+        jobs[t].cards_per_hand = cards_per_hand;
+        jobs[t].begin = num_hands * t / threads;
+        jobs[t].end = num_hands * (t + 1) / threads;
+        jobs[t].out_values = out_values;
+    }
+    run_threads(threads, card_rows_worker, jobs, sizeof(CardRowsJob));
     return 0;
 }
+
+/* Static helper: move the first unused card matching rank (and suit) into the hand */
+static void take_card(const Card* const cards, const size_t len, int* const used,
+                      const unsigned rank, const int suit, Hand* const hand,
+                      size_t* const taken) {
+    for (size_t i = 0; i < len; i++) {
+        if (!used[i] && cards[i].rank == rank && (suit < 0 || cards[i].suit == suit)) {
+            used[i] = 1;
+            hand->cards[(*taken)++] = cards[i];
+            return;
+        }
+    }
+}
+
+int evaluate_hand(const Card* const cards, const size_t len, Hand* const out_hand) {
+    if (cards == NULL || out_hand == NULL || len < HAND_SIZE || len > HAND_SIZE + 2) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    uint64_t mask = 0;
+    int suit_counts[4] = {0, 0, 0, 0};
+    for (size_t i = 0; i < len; i++) {
+        if (cards[i].rank < RANK_TWO || cards[i].rank > RANK_ACE || cards[i].suit > SUIT_SPADES) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+        const uint64_t bit = CARD_MASK_BIT(cards[i]);
+        if (mask & bit) {
+            poker_errno = POKER_EDUPLICATE;
+            return -1;
+        }
+        mask |= bit;
+        suit_counts[cards[i].suit]++;
+    }
+
+    const HandValue value = evaluate_mask(mask);
+    const HandCategory category = HAND_VALUE_CATEGORY(value);
+
+    memset(out_hand, 0, sizeof(*out_hand));
+    out_hand->category = category;
+    out_hand->num_tiebreakers = CATEGORY_TIEBREAKERS[category];
+    for (size_t i = 0; i < out_hand->num_tiebreakers; i++) {
+        out_hand->tiebreakers[i] = (Rank)((value >> (16 - 4 * i)) & 0xF);
+    }
+
+    /* Pick the five cards that realize the value */
+    int used[HAND_SIZE + 2] = {0};
+    size_t taken = 0;
+    int flush_suit = -1;
+    for (int s = 0; s < 4; s++) {
+        if (suit_counts[s] >= HAND_SIZE) {
+            flush_suit = s;
+        }
+    }
+    const Rank* const t = out_hand->tiebreakers;
+
+    switch (category) {
+        case HAND_ROYAL_FLUSH:
+        case HAND_STRAIGHT_FLUSH:
+        case HAND_STRAIGHT: {
+            const int suit = (category == HAND_STRAIGHT) ? -1 : flush_suit;
+            for (unsigned i = 0; i < HAND_SIZE; i++) {
+                const unsigned rank = (t[0] == RANK_FIVE && i == 4) ? RANK_ACE : t[0] - i;
+                take_card(cards, len, used, rank, suit, out_hand, &taken);
+            }
+            break;
+        }
+        case HAND_FLUSH:
+            for (unsigned i = 0; i < HAND_SIZE; i++) {
+                take_card(cards, len, used, t[i], flush_suit, out_hand, &taken);
+            }
+            break;
+        default: {
+            /* Grouped categories: copies needed of each tiebreaker rank */
+            static const uint8_t GROUPS[HAND_FOUR_OF_A_KIND + 1][3] = {
+                [HAND_ONE_PAIR] = {2, 1, 1},
+                [HAND_TWO_PAIR] = {2, 2, 1},
+                [HAND_THREE_OF_A_KIND] = {3, 1, 1},
+                [HAND_FULL_HOUSE] = {3, 2, 0},
+                [HAND_FOUR_OF_A_KIND] = {4, 1, 0},
+            };
+            for (size_t i = 0; i < out_hand->num_tiebreakers; i++) {
+                const unsigned copies = (category == HAND_HIGH_CARD || i >= 3) ? 1 : GROUPS[category][i];
+                for (unsigned c = 0; c < copies; c++) {
+                    take_card(cards, len, used, t[i], -1, out_hand, &taken);
+                }
+            }
+            break;
+        }
+    }
+
+    return 0;
+}
+
+HandValue hand_value(const Hand* const hand) {
+    if (hand == NULL) {
+        return 0;
+    }
+
+    HandValue value = (HandValue)hand->category << HAND_VALUE_CATEGORY_SHIFT;
+    for (size_t i = 0; i < hand->num_tiebreakers && i < MAX_TIEBREAKERS; i++) {
+        value |= (HandValue)(hand->tiebreakers[i] & 0xF) << (16 - 4 * i);
+    }
+    return value;
+}
+
+int compare_hands(const Hand* const a, const Hand* const b) {
+    const HandValue va = hand_value(a);
+    const HandValue vb = hand_value(b);
+    return (va > vb) - (va < vb);
+}
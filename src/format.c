@@ -0,0 +1,336 @@
+/* format.c - Table-driven formatting of cards, hands and hand descriptions */
+
+#include "../include/poker.h"
+#include "card_chars.h"
+#include <string.h>
+
+/* Rank names indexed by Rank value, singular and plural */
+static const char* const RANK_NAMES[RANK_ARRAY_SIZE] = {
+    NULL, NULL, "Two", "Three", "Four", "Five", "Six", "Seven", "Eight",
+    "Nine", "Ten", "Jack", "Queen", "King", "Ace"
+};
+static const char* const RANK_NAMES_PLURAL[RANK_ARRAY_SIZE] = {
+    NULL, NULL, "Twos", "Threes", "Fours", "Fives", "Sixes", "Sevens",
+    "Eights", "Nines", "Tens", "Jacks", "Queens", "Kings", "Aces"
+};
+
+/* Category names indexed by HandCategory value */
+static const char* const CATEGORY_NAMES[HAND_ROYAL_FLUSH + 1] = {
+    NULL,
+    "High Card", "One Pair", "Two Pair", "Three of a Kind", "Straight",
+    "Flush", "Full House", "Four of a Kind", "Straight Flush", "Royal Flush"
+};
+
+/* Static helper: check card fields are within the valid ranges */
+static int card_is_valid(const Card card) {
+    return card.rank >= RANK_TWO && card.rank <= RANK_ACE &&
+           card.suit <= SUIT_SPADES;
+}
+
+/* Static helper: check rank is within RANK_TWO..RANK_ACE */
+static int rank_is_valid(const Rank rank) {
+    return rank >= RANK_TWO && rank <= RANK_ACE;
+}
+
+/*
+ * Output cursor used by the formatters
+ *
+ * Appends are bounds-checked against the buffer size with one byte reserved
+ * for the NUL terminator. Once an append fails the cursor stays failed, so
+ * callers can chain appends and check the result once.
+ */
+typedef struct {
+    char* buffer;
+    size_t size;
+    size_t pos;
+    int failed;
+} FormatCursor;
+
+static void cursor_append(FormatCursor* const cursor, const char* const str,
+                          const size_t len) {
+    if (cursor->failed || cursor->pos + len >= cursor->size) {
+        cursor->failed = 1;
+        return;
+    }
+    memcpy(cursor->buffer + cursor->pos, str, len);
+    cursor->pos += len;
+}
+
+static void cursor_append_str(FormatCursor* const cursor, const char* const str) {
+    cursor_append(cursor, str, strlen(str));
+}
+
+static void cursor_append_char(FormatCursor* const cursor, const char c) {
+    cursor_append(cursor, &c, 1);
+}
+
+/* Static helper: terminate buffer and translate cursor state to a result */
+static int cursor_finish(FormatCursor* const cursor) {
+    if (cursor->failed) {
+        if (cursor->size > 0) {
+            cursor->buffer[0] = '\0';
+        }
+        poker_errno = POKER_ERANGE;
+        return -1;
+    }
+    cursor->buffer[cursor->pos] = '\0';
+    return (int)cursor->pos;
+}
+
+/* Static helper: check every card in an array is valid */
+static int cards_are_valid(const Card* const cards, const size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (!card_is_valid(cards[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Static helper: check a hand carries everything its description needs
+ *
+ * Royal flush needs no ranks, two pair and full house need two, every other
+ * category needs its primary rank.
+ */
+static int hand_is_describable(const Hand* const hand) {
+    const HandCategory category = hand->category;
+    if (category < HAND_HIGH_CARD || category > HAND_ROYAL_FLUSH) {
+        return 0;
+    }
+    if (category == HAND_ROYAL_FLUSH) {
+        return 1;
+    }
+
+    const size_t needed = (category == HAND_TWO_PAIR ||
+                           category == HAND_FULL_HOUSE) ? 2 : 1;
+    if (hand->num_tiebreakers < needed || hand->num_tiebreakers > MAX_TIEBREAKERS) {
+        return 0;
+    }
+    for (size_t i = 0; i < needed; i++) {
+        if (!rank_is_valid(hand->tiebreakers[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Static helper: append cards (caller validates them first) */
+static void cursor_append_cards(FormatCursor* const cursor,
+                                const Card* const cards, const size_t len,
+                                const char separator) {
+    for (size_t i = 0; i < len; i++) {
+        if (i > 0 && separator != '\0') {
+            cursor_append_char(cursor, separator);
+        }
+        const char pair[2] = { RANK_TO_CHAR[cards[i].rank], SUIT_TO_CHAR[cards[i].suit] };
+        cursor_append(cursor, pair, 2);
+    }
+}
+
+/* Static helper: append the description of a hand_is_describable() hand */
+static void cursor_append_description(FormatCursor* const cursor,
+                                      const Hand* const hand) {
+    const HandCategory category = hand->category;
+
+    cursor_append_str(cursor, CATEGORY_NAMES[category]);
+    if (category == HAND_ROYAL_FLUSH) {
+        return;
+    }
+
+    const Rank primary = hand->tiebreakers[0];
+    cursor_append(cursor, ", ", 2);
+
+    switch (category) {
+        case HAND_HIGH_CARD:
+            cursor_append_str(cursor, RANK_NAMES[primary]);
+            break;
+        case HAND_ONE_PAIR:
+        case HAND_THREE_OF_A_KIND:
+        case HAND_FOUR_OF_A_KIND:
+            cursor_append_str(cursor, RANK_NAMES_PLURAL[primary]);
+            break;
+        case HAND_TWO_PAIR:
+            cursor_append_str(cursor, RANK_NAMES_PLURAL[primary]);
+            cursor_append(cursor, " and ", 5);
+            cursor_append_str(cursor, RANK_NAMES_PLURAL[hand->tiebreakers[1]]);
+            break;
+        case HAND_FULL_HOUSE:
+            cursor_append_str(cursor, RANK_NAMES_PLURAL[primary]);
+            cursor_append(cursor, " full of ", 9);
+            cursor_append_str(cursor, RANK_NAMES_PLURAL[hand->tiebreakers[1]]);
+            break;
+        default:
+            /* Straight, flush and straight flush are named by high card */
+            cursor_append_str(cursor, RANK_NAMES[primary]);
+            cursor_append(cursor, " high", 5);
+            break;
+    }
+}
+
+/**
+ * @brief Get the display name of a hand category
+ *
+ * @param category Hand category
+ * @return Static string (e.g., "Full House"), or "Unknown" if out of range
+ */
+const char* hand_category_name(const HandCategory category) {
+    if (category < HAND_HIGH_CARD || category > HAND_ROYAL_FLUSH) {
+        return "Unknown";
+    }
+    return CATEGORY_NAMES[category];
+}
+
+/**
+ * @brief Format an array of cards into a caller buffer
+ *
+ * Writes two characters per card via table lookup (e.g., "AhKsQd"),
+ * optionally separated by a single character. No stdio is involved.
+ *
+ * @param cards Array of cards (can be NULL if len is 0)
+ * @param len Number of cards
+ * @param separator Character between cards, or '\0' for none
+ * @param buffer Output buffer (always NUL-terminated when size > 0)
+ * @param size Size of output buffer
+ * @return Number of characters written (excluding NUL), or -1 on error
+ *         (POKER_EINVAL for bad arguments/cards, POKER_ERANGE if too small)
+ */
+int format_cards(const Card* const cards, const size_t len, const char separator,
+                 char* const buffer, const size_t size) {
+    if (buffer == NULL || size == 0 || (cards == NULL && len > 0)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    /* Size the output up front so the loop only decodes and stores */
+    const size_t needed = (len == 0) ? 0 :
+                          len * 2 + ((separator != '\0') ? len - 1 : 0);
+    if (needed >= size) {
+        buffer[0] = '\0';
+        poker_errno = POKER_ERANGE;
+        return -1;
+    }
+
+    char* out = buffer;
+    for (size_t i = 0; i < len; i++) {
+        if (!card_is_valid(cards[i])) {
+            buffer[0] = '\0';
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+        if (i > 0 && separator != '\0') {
+            *out++ = separator;
+        }
+        out[0] = RANK_TO_CHAR[cards[i].rank];
+        out[1] = SUIT_TO_CHAR[cards[i].suit];
+        out += 2;
+    }
+    *out = '\0';
+    return (int)needed;
+}
+
+/**
+ * @brief Format a 64-bit card mask into a caller buffer
+ *
+ * Cards are written in ascending CARD_INDEX order.
+ *
+ * @param mask Card mask (bits above DECK_SIZE must be clear)
+ * @param separator Character between cards, or '\0' for none
+ * @param buffer Output buffer
+ * @param size Size of output buffer
+ * @return Number of characters written (excluding NUL), or -1 on error
+ */
+int format_card_mask(const uint64_t mask, const char separator,
+                     char* const buffer, const size_t size) {
+    if (buffer == NULL || size == 0 || (mask >> DECK_SIZE) != 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    FormatCursor cursor = { buffer, size, 0, 0 };
+    int first = 1;
+    for (unsigned index = 0; index < DECK_SIZE; index++) {
+        if (mask & (UINT64_C(1) << index)) {
+            if (!first && separator != '\0') {
+                cursor_append_char(&cursor, separator);
+            }
+            const char pair[2] = { RANK_TO_CHAR[index / 4 + RANK_TWO], SUIT_TO_CHAR[index % 4] };
+            cursor_append(&cursor, pair, 2);
+            first = 0;
+        }
+    }
+    return cursor_finish(&cursor);
+}
+
+/**
+ * @brief Format a descriptive hand name (e.g., "Two Pair, Aces and Nines")
+ *
+ * Uses hand->category and the leading tiebreakers. Examples:
+ * "High Card, Ace", "Full House, Kings full of Fives", "Flush, Jack high",
+ * "Royal Flush".
+ *
+ * @param hand Evaluated hand
+ * @param buffer Output buffer
+ * @param size Size of output buffer
+ * @return Number of characters written (excluding NUL), or -1 on error
+ */
+int format_hand_description(const Hand* const hand, char* const buffer,
+                            const size_t size) {
+    if (hand == NULL || buffer == NULL || size == 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    if (!hand_is_describable(hand)) {
+        buffer[0] = '\0';
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    FormatCursor cursor = { buffer, size, 0, 0 };
+    cursor_append_description(&cursor, hand);
+    return cursor_finish(&cursor);
+}
+
+/**
+ * @brief Format a batch of evaluated hands, one line per hand
+ *
+ * Each line has the form "<cards>\t<category>\t<description>\n", for
+ * example "AsAdKh9c9s\tTwo Pair\tTwo Pair, Aces and Nines\n". The output is
+ * all-or-nothing: on error the buffer is left as an empty string.
+ *
+ * @param hands Array of evaluated hands
+ * @param count Number of hands
+ * @param buffer Output buffer
+ * @param size Size of output buffer
+ * @return Number of characters written (excluding NUL), or -1 on error
+ */
+int format_hands(const Hand* const hands, const size_t count,
+                 char* const buffer, const size_t size) {
+    if (buffer == NULL || size == 0 || (hands == NULL && count > 0)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!cards_are_valid(hands[i].cards, HAND_SIZE) ||
+            !hand_is_describable(&hands[i])) {
+            buffer[0] = '\0';
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+    }
+
+    FormatCursor cursor = { buffer, size, 0, 0 };
+    for (size_t i = 0; i < count && !cursor.failed; i++) {
+        const Hand* const hand = &hands[i];
+
+        cursor_append_cards(&cursor, hand->cards, HAND_SIZE, '\0');
+        cursor_append_char(&cursor, '\t');
+        cursor_append_str(&cursor, CATEGORY_NAMES[hand->category]);
+        cursor_append_char(&cursor, '\t');
+        cursor_append_description(&cursor, hand);
+        cursor_append_char(&cursor, '\n');
+    }
+    return cursor_finish(&cursor);
+}
@@ -0,0 +1,375 @@
+/*
+ * game.c - No-Limit Hold'em game engine over structure-of-arrays tables
+ */
+
+#include "../include/poker_game.h"
+#include "../include/poker_showdown.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Seats the betting masks can hold */
+#define SEAT_MASK(n) ((uint16_t)((1u << (n)) - 1u))
+
+/* Static helper: splitmix64 step (dealing generator) */
+static uint64_t next_random(uint64_t* const state) {
+    uint64_t z = (*state += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+/* Static helper: deal one card not yet dealt on a table */
+static uint64_t deal_card(GameTables* const g, const size_t t) {
+    uint64_t bit;
+    do {
+        const uint64_t r = next_random(&g->rng[t]) >> 32;
+        bit = UINT64_C(1) << ((r * DECK_SIZE) >> 32);
+    } while (g->dealt[t] & bit);
+    g->dealt[t] |= bit;
+    return bit;
+}
+
+/* Static helper: first seat after from (exclusive, wrapping) in mask, or GAME_NO_SEAT */
+static uint8_t next_seat(const uint16_t mask, const size_t from) {
+    const unsigned after = mask & ~((2u << from) - 1u);
+    if (after != 0) {
+        return (uint8_t)__builtin_ctz(after);
+    }
+    return mask ? (uint8_t)__builtin_ctz(mask) : GAME_NO_SEAT;
+}
+
+/* Static helper: move up to amount chips from a seat's stack into the pot */
+static void put_chips(GameTables* const g, const size_t t, const size_t seat, uint32_t amount) {
+    const size_t i = t * g->config.num_seats + seat;
+    if (amount >= g->stack[i]) {
+        amount = g->stack[i];
+        g->all_in[t] |= (uint16_t)(1u << seat);
+    }
+    g->stack[i] -= amount;
+    g->committed[i] += amount;
+    g->contributed[i] += amount;
+    g->pot[t] += amount;
+}
+
+GameTables* game_tables_create(const GameConfig* const config, const size_t capacity) {
+    if (config == NULL || capacity == 0 || config->num_seats < 2 ||
+        config->num_seats > MAX_PLAYERS || config->small_blind == 0 ||
+        config->big_blind < config->small_blind || config->starting_stack == 0) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+
+    const size_t seats = capacity * config->num_seats;
+    /* Widest fields first so every array stays aligned */
+    const size_t bytes = capacity * (3 * sizeof(uint64_t) + 3 * sizeof(uint32_t) +
+                                     4 * sizeof(uint16_t) + 3 * sizeof(uint8_t)) +
+                         seats * (sizeof(uint64_t) + 4 * sizeof(uint32_t));
+
+    GameTables* const g = malloc(sizeof(GameTables));
+    uint8_t* const block = calloc(1, bytes);
+    if (g == NULL || block == NULL) {
+        free(g);
+        free(block);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+
+    g->config = *config;
+    g->capacity = capacity;
+    uint8_t* p = block;
+#define CARVE(field, count) \
+    (g->field = (void*)p, p += (count) * sizeof(*g->field))
+    CARVE(board, capacity);
+    CARVE(dealt, capacity);
+    CARVE(rng, capacity);
+    CARVE(hole, seats);
+    CARVE(current_bet, capacity);
+    CARVE(min_raise, capacity);
+    CARVE(pot, capacity);
+    CARVE(stack, seats);
+    CARVE(committed, seats);
+    CARVE(contributed, seats);
+    CARVE(won, seats);
+    CARVE(seated, capacity);
+    CARVE(folded, capacity);
+    CARVE(all_in, capacity);
+    CARVE(acted, capacity);
+    CARVE(street, capacity);
+    CARVE(to_act, capacity);
+    CARVE(button, capacity);
+#undef CARVE
+
+    memset(g->street, GAME_STREET_DONE, capacity);
+    memset(g->to_act, GAME_NO_SEAT, capacity);
+    return g;
+}
+
+void game_tables_destroy(GameTables* const tables) {
+    if (tables == NULL) {
+        return;
+    }
+    free(tables->board);   /* First array: start of the block */
+    free(tables);
+}
+
+int game_set_blinds(GameTables* const tables, const uint32_t small_blind,
+                    const uint32_t big_blind) {
+    if (tables == NULL || small_blind == 0 || big_blind < small_blind) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    tables->config.small_blind = small_blind;
+    tables->config.big_blind = big_blind;
+    return 0;
+}
+
+/*
+ * Static helper: pay the hand out and mark the table done
+ * @return 0 on success, -1 if the showdown could not be settled (every
+ *         seat gets its contribution back; poker_errno set by
+ *         showdown_settle())
+ */
+static int finish_hand(GameTables* const g, const size_t t) {
+    const size_t n = g->config.num_seats;
+    const uint16_t live = (uint16_t)(g->seated[t] & ~g->folded[t]);
+
+    /* Run the board out when it comes to a showdown */
+    if ((live & (live - 1)) != 0) {
+        while (__builtin_popcountll(g->board[t]) < BOARD_SIZE) {
+            g->board[t] |= deal_card(g, t);
+        }
+    }
+
+    ShowdownTable table;
+    table.num_players = n;
+    table.board = g->board[t];
+    table.first_seat = (g->button[t] + 1u) % n;
+    table.odd_chip_rule = SHOWDOWN_ODD_CHIP_POSITION;
+    for (size_t seat = 0; seat < n; seat++) {
+        table.players[seat].hole = g->hole[t * n + seat];
+        table.players[seat].folded = !(live & (1u << seat));
+        table.contributions[seat] = g->contributed[t * n + seat];
+    }
+
+    ShowdownSettlement result;
+    const int status = showdown_settle(&table, &result);
+    for (size_t seat = 0; seat < n; seat++) {
+        const uint32_t payout = (status == 0) ? (uint32_t)result.payouts[seat]
+                                              : g->contributed[t * n + seat];
+        g->won[t * n + seat] = payout;
+        g->stack[t * n + seat] += payout;
+    }
+    g->street[t] = GAME_STREET_DONE;
+    g->to_act[t] = GAME_NO_SEAT;
+    return status;
+}
+
+/*
+ * Static helper: move the hand on after an action (or the blinds) by seat
+ * from: next seat to act, next street, or settlement
+ * @return 0 on success, -1 if settlement failed (see finish_hand())
+ */
+static int advance(GameTables* const g, const size_t t, size_t from) {
+    const size_t n = g->config.num_seats;
+
+    for (;;) {
+        const uint16_t live = (uint16_t)(g->seated[t] & ~g->folded[t]);
+        if ((live & (live - 1)) == 0) {
+            return finish_hand(g, t);
+        }
+
+        /* Seats that still owe an action this street */
+        const uint16_t active = (uint16_t)(live & ~g->all_in[t]);
+        const uint32_t* const committed = &g->committed[t * n];
+        uint16_t pending = (uint16_t)(active & ~g->acted[t]);
+        for (unsigned rest = active & g->acted[t]; rest != 0; rest &= rest - 1) {
+            const unsigned seat = (unsigned)__builtin_ctz(rest);
+            if (committed[seat] < g->current_bet[t]) {
+                pending |= (uint16_t)(1u << seat);
+            }
+        }
+        /* A lone player who has matched the bet has no one left to act against */
+        if ((active & (active - 1)) == 0 && pending != 0 &&
+            committed[__builtin_ctz(pending)] >= g->current_bet[t]) {
+            pending = 0;
+        }
+        if (pending != 0) {
+            g->to_act[t] = next_seat(pending, from);
+            return 0;
+        }
+
+        /* Betting round closed */
+        if (g->street[t] == GAME_STREET_RIVER) {
+            return finish_hand(g, t);
+        }
+        if ((active & (active - 1)) == 0) {
+            return finish_hand(g, t);   /* Everyone else all-in: run it out */
+        }
+
+        const unsigned cards = (g->street[t] == GAME_STREET_PREFLOP) ? 3 : 1;
+        for (unsigned c = 0; c < cards; c++) {
+            g->board[t] |= deal_card(g, t);
+        }
+        g->street[t]++;
+        memset(&g->committed[t * n], 0, n * sizeof(uint32_t));
+        g->current_bet[t] = 0;
+        g->min_raise[t] = g->config.big_blind;
+        g->acted[t] = 0;
+        from = g->button[t];
+    }
+}
+
+int game_start_hand(GameTables* const tables, const size_t table, const size_t button,
+                    const uint64_t seed, const uint32_t* const stacks) {
+    if (tables == NULL || table >= tables->capacity || button >= tables->config.num_seats) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    GameTables* const g = tables;
+    const size_t n = g->config.num_seats;
+    const size_t t = table;
+
+    uint16_t seated = 0;
+    for (size_t seat = 0; seat < n; seat++) {
+        const uint32_t chips = stacks ? stacks[seat] : g->config.starting_stack;
+        if (chips > 0) {
+            seated |= (uint16_t)(1u << seat);
+        }
+    }
+    if (!(seated & (1u << button)) || (seated & (seated - 1)) == 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    for (size_t seat = 0; seat < n; seat++) {
+        const size_t i = t * n + seat;
+        g->stack[i] = stacks ? stacks[seat] : g->config.starting_stack;
+        g->committed[i] = 0;
+        g->contributed[i] = 0;
+        g->won[i] = 0;
+        g->hole[i] = 0;
+    }
+    g->street[t] = GAME_STREET_PREFLOP;
+    g->button[t] = (uint8_t)button;
+    g->seated[t] = seated;
+    g->folded[t] = (uint16_t)(SEAT_MASK(n) & ~seated);
+    g->all_in[t] = 0;
+    g->acted[t] = 0;
+    g->pot[t] = 0;
+    g->board[t] = 0;
+    g->dealt[t] = 0;
+    g->rng[t] = seed;
+
+    for (size_t seat = 0; seat < n; seat++) {
+        if (seated & (1u << seat)) {
+            g->hole[t * n + seat] = deal_card(g, t) | deal_card(g, t);
+        }
+    }
+
+    /* Heads-up the button is the small blind */
+    const size_t sb = (__builtin_popcount(seated) == 2) ? button : next_seat(seated, button);
+    const size_t bb = next_seat(seated, sb);
+    put_chips(g, t, sb, g->config.small_blind);
+    put_chips(g, t, bb, g->config.big_blind);
+    g->current_bet[t] = (g->committed[t * n + sb] > g->committed[t * n + bb])
+                            ? g->committed[t * n + sb] : g->committed[t * n + bb];
+    g->min_raise[t] = g->config.big_blind;
+
+    return advance(g, t, bb);
+}
+
+int game_legal_actions(const GameTables* const tables, const size_t table,
+                       GameLegal* const out) {
+    if (tables == NULL || out == NULL || table >= tables->capacity ||
+        tables->street[table] == GAME_STREET_DONE) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    const GameTables* const g = tables;
+    const size_t t = table;
+    const size_t seat = g->to_act[t];
+    const size_t i = t * g->config.num_seats + seat;
+    const uint32_t owed = g->current_bet[t] - g->committed[i];
+    const uint32_t all_in_to = g->committed[i] + g->stack[i];
+
+    out->seat = (uint8_t)seat;
+    out->to_call = (owed < g->stack[i]) ? owed : g->stack[i];
+    out->actions = 1u << GAME_ACTION_CHECK_CALL;
+    if (owed > 0) {
+        out->actions |= 1u << GAME_ACTION_FOLD;
+    }
+
+    /* Raising needs chips beyond a call and a betting round still open to this seat */
+    out->min_raise_to = 0;
+    out->max_raise_to = 0;
+    if (all_in_to > g->current_bet[t] && !(g->acted[t] & (1u << seat))) {
+        const uint32_t full = g->current_bet[t] + g->min_raise[t];
+        out->actions |= 1u << GAME_ACTION_RAISE;
+        out->min_raise_to = (full < all_in_to) ? full : all_in_to;
+        out->max_raise_to = all_in_to;
+    }
+    return 0;
+}
+
+int game_apply(GameTables* const tables, const size_t table, const int action,
+               const uint32_t raise_to) {
+    GameLegal legal;
+    if (game_legal_actions(tables, table, &legal) != 0 ||
+        action < 0 || action > GAME_ACTION_RAISE || !(legal.actions & (1u << action)) ||
+        (action == GAME_ACTION_RAISE &&
+         (raise_to < legal.min_raise_to || raise_to > legal.max_raise_to))) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    GameTables* const g = tables;
+    const size_t t = table;
+    const size_t seat = legal.seat;
+
+    if (action == GAME_ACTION_FOLD) {
+        g->folded[t] |= (uint16_t)(1u << seat);
+    } else if (action == GAME_ACTION_CHECK_CALL) {
+        put_chips(g, t, seat, legal.to_call);
+    } else {
+        const size_t i = t * g->config.num_seats + seat;
+        const uint32_t increment = raise_to - g->current_bet[t];
+        put_chips(g, t, seat, raise_to - g->committed[i]);
+        if (increment >= g->min_raise[t]) {
+            /* Full raise: reopens the betting for everyone else */
+            g->min_raise[t] = increment;
+            g->acted[t] = 0;
+        }
+        g->current_bet[t] = raise_to;
+    }
+    g->acted[t] |= (uint16_t)(1u << seat);
+
+    return advance(g, t, seat);
+}
+
+int game_apply_batch(GameTables* const tables, const uint8_t* const actions,
+                     const uint32_t* const raise_to, const size_t count,
+                     size_t* const out_live) {
+    if (tables == NULL || (count > 0 && actions == NULL) || count > tables->capacity) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    int status = 0;
+    size_t live = 0;
+    for (size_t t = 0; t < count; t++) {
+        if (tables->street[t] == GAME_STREET_DONE) {
+            continue;
+        }
+        if (actions[t] == GAME_ACTION_RAISE && raise_to == NULL) {
+            poker_errno = POKER_EINVAL;
+            status = -1;
+        } else if (game_apply(tables, t, actions[t], raise_to ? raise_to[t] : 0) != 0) {
+            status = -1;
+        }
+        live += (tables->street[t] != GAME_STREET_DONE);
+    }
+
+    if (out_live != NULL) {
+        *out_live = live;
+    }
+    return status;
+}
@@ -0,0 +1,677 @@
+/*
+ * handdb.c - Columnar on-disk hand database
+ * Stores evaluated hand rows as per-block column arrays with min/max and
+ * bitmap skip indices, and answers predicate queries over a memory map
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_handdb.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* On-disk structure sizes */
+#define FILE_HEADER_SIZE 16
+#define INDEX_ENTRY_SIZE 48
+#define TRAILER_SIZE     24
+
+/* Bytes per row across all columns: u64 id, u32 strength, u32 board, u16 hole, 3 x u8 */
+#define ROW_BYTES 21
+
+/* Upper bound on rows per block */
+#define MAX_BLOCK_ROWS (1u << 22)
+
+/* flags column layout */
+#define FLAG_BOARD_LEN_MASK 0x07
+#define FLAG_HERO           0x08
+#define FLAG_SHOWDOWN       0x10
+
+/* Written in host order; reads back differently on the other byte order */
+#define ENDIAN_MARKER 0x01020304u
+
+static const uint8_t FILE_MAGIC[4] = {'P', 'H', 'D', 'B'};
+static const uint8_t TRAILER_MAGIC[4] = {'P', 'H', 'D', 'I'};
+
+/* Static helper: round up to a multiple of 8 */
+static uint64_t align8(const uint64_t x) {
+    return (x + 7) & ~UINT64_C(7);
+}
+
+/* Little-endian helpers for the header, index and trailer */
+static void put_u32(uint8_t* const p, const uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static void put_u64(uint8_t* const p, const uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const uint8_t* const p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_u64(const uint8_t* const p) {
+    return (uint64_t)get_u32(p) | ((uint64_t)get_u32(p + 4) << 32);
+}
+
+/*
+ * Skip index for one block
+ */
+typedef struct {
+    uint64_t offset;
+    uint64_t first_row;
+    uint64_t min_hand_id;
+    uint64_t max_hand_id;
+    uint32_t rows;
+    HandValue min_strength;
+    HandValue max_strength;
+    uint16_t categories;
+    uint8_t results;
+    uint8_t has_hero;
+} BlockIndex;
+
+/*
+ * Column pointers for one block (into the writer's buffers or the mapping)
+ */
+typedef struct {
+    uint64_t* hand_id;
+    HandValue* strength;
+    uint32_t* board;
+    uint16_t* hole;
+    uint8_t* category;
+    uint8_t* result;
+    uint8_t* flags;
+} Columns;
+
+/* Static helper: point columns into a block of rows rows */
+static void columns_at(Columns* const cols, uint8_t* const base, const size_t rows) {
+    cols->hand_id = (uint64_t*)base;
+    cols->strength = (HandValue*)(base + 8 * rows);
+    cols->board = (uint32_t*)(base + 12 * rows);
+    cols->hole = (uint16_t*)(base + 16 * rows);
+    cols->category = base + 18 * rows;
+    cols->result = base + 19 * rows;
+    cols->flags = base + 20 * rows;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Writer                                                                   */
+/* ------------------------------------------------------------------------ */
+
+struct HandDbWriter {
+    FILE* file;
+    uint64_t offset;
+    size_t block_rows;
+    /* Current block, one array per column */
+    uint64_t* hand_id;
+    HandValue* strength;
+    uint32_t* board;
+    uint16_t* hole;
+    uint8_t* category;
+    uint8_t* result;
+    uint8_t* flags;
+    size_t pending;
+    BlockIndex current;
+    BlockIndex* index;
+    size_t num_blocks;
+    size_t index_capacity;
+    uint64_t total;
+    int error;
+};
+
+/* Static helper: fwrite that tracks the offset and latches I/O errors */
+static int writer_put(HandDbWriter* const writer, const void* const data, const size_t len) {
+    if (len > 0 && fwrite(data, 1, len, writer->file) != len) {
+        writer->error = POKER_EIO;
+        return -1;
+    }
+    writer->offset += len;
+    return 0;
+}
+
+/* Static helper: write the current block's columns and index entry */
+static int writer_flush_block(HandDbWriter* const writer) {
+    const size_t n = writer->pending;
+    if (n == 0) {
+        return 0;
+    }
+
+    if (writer->num_blocks == writer->index_capacity) {
+        const size_t capacity = (writer->index_capacity == 0) ? 64 : writer->index_capacity * 2;
+        BlockIndex* const grown = realloc(writer->index, capacity * sizeof(BlockIndex));
+        if (grown == NULL) {
+            writer->error = POKER_ENOMEM;
+            return -1;
+        }
+        writer->index = grown;
+        writer->index_capacity = capacity;
+    }
+
+    BlockIndex* const entry = &writer->index[writer->num_blocks];
+    *entry = writer->current;
+    entry->offset = writer->offset;
+    entry->first_row = writer->total;
+    entry->rows = (uint32_t)n;
+
+    static const uint8_t PADDING[8] = {0};
+    const uint64_t padded = align8(ROW_BYTES * (uint64_t)n);
+    if (writer_put(writer, writer->hand_id, n * sizeof(uint64_t)) != 0 ||
+        writer_put(writer, writer->strength, n * sizeof(HandValue)) != 0 ||
+        writer_put(writer, writer->board, n * sizeof(uint32_t)) != 0 ||
+        writer_put(writer, writer->hole, n * sizeof(uint16_t)) != 0 ||
+        writer_put(writer, writer->category, n) != 0 ||
+        writer_put(writer, writer->result, n) != 0 ||
+        writer_put(writer, writer->flags, n) != 0 ||
+        writer_put(writer, PADDING, (size_t)(padded - ROW_BYTES * (uint64_t)n)) != 0) {
+        return -1;
+    }
+
+    writer->num_blocks++;
+    writer->total += n;
+    writer->pending = 0;
+    return 0;
+}
+
+/* Static helper: release a writer's memory */
+static void writer_free(HandDbWriter* const writer) {
+    free(writer->hand_id);
+    free(writer->strength);
+    free(writer->board);
+    free(writer->hole);
+    free(writer->category);
+    free(writer->result);
+    free(writer->flags);
+    free(writer->index);
+    free(writer);
+}
+
+HandDbWriter* handdb_writer_open(const char* const path, const size_t block_rows) {
+    if (path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+
+    HandDbWriter* const writer = calloc(1, sizeof(HandDbWriter));
+    if (writer == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    size_t rows = (block_rows > 0) ? block_rows : HANDDB_DEFAULT_BLOCK_ROWS;
+    if (rows > MAX_BLOCK_ROWS) {
+        rows = MAX_BLOCK_ROWS;
+    }
+    writer->block_rows = rows;
+    writer->hand_id = malloc(rows * sizeof(uint64_t));
+    writer->strength = malloc(rows * sizeof(HandValue));
+    writer->board = malloc(rows * sizeof(uint32_t));
+    writer->hole = malloc(rows * sizeof(uint16_t));
+    writer->category = malloc(rows);
+    writer->result = malloc(rows);
+    writer->flags = malloc(rows);
+    if (writer->hand_id == NULL || writer->strength == NULL || writer->board == NULL ||
+        writer->hole == NULL || writer->category == NULL || writer->result == NULL ||
+        writer->flags == NULL) {
+        writer_free(writer);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        writer_free(writer);
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+
+    uint8_t header[FILE_HEADER_SIZE];
+    const uint32_t marker = ENDIAN_MARKER;
+    memset(header, 0, sizeof(header));
+    memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header[4] = HANDDB_FORMAT_VERSION;
+    memcpy(header + 8, &marker, sizeof(marker));  /* Host order on purpose */
+    put_u32(header + 12, (uint32_t)rows);
+    if (writer_put(writer, header, sizeof(header)) != 0) {
+        handdb_writer_close(writer);
+        poker_errno = POKER_EIO;
+        return NULL;
+    }
+    return writer;
+}
+
+/*
+ * Static helper: check a record and pack its board
+ * Cards are range-checked before they are used as shift counts.
+ * @return 0 if every count and card is valid, -1 otherwise
+ */
+static int check_record(const HandRecord* const rec, uint64_t* const out_board_mask,
+                        uint32_t* const out_packed_board) {
+    if (rec->num_players > MAX_PLAYERS || rec->board_len > BOARD_SIZE) {
+        return -1;
+    }
+
+    uint64_t board_mask = 0;
+    uint32_t packed_board = 0;
+    for (unsigned b = 0; b < rec->board_len; b++) {
+        if (rec->board[b] >= DECK_SIZE) {
+            return -1;
+        }
+        const uint64_t bit = UINT64_C(1) << rec->board[b];
+        if ((board_mask & bit) != 0) {
+            return -1;
+        }
+        board_mask |= bit;
+        packed_board |= (uint32_t)rec->board[b] << (6 * b);
+    }
+
+    for (unsigned p = 0; p < rec->num_players; p++) {
+        const uint8_t c0 = rec->hole[p][0];
+        const uint8_t c1 = rec->hole[p][1];
+        if (c0 >= DECK_SIZE || c1 >= DECK_SIZE) {
+            continue;  /* Hole cards not (fully) known */
+        }
+        const uint64_t hole_mask = (UINT64_C(1) << c0) | (UINT64_C(1) << c1);
+        if (c0 == c1 || (hole_mask & board_mask) != 0) {
+            return -1;
+        }
+    }
+
+    *out_board_mask = board_mask;
+    *out_packed_board = packed_board;
+    return 0;
+}
+
+/*
+ * Static helper: add one row to the current block, flushing when full
+ * The record has passed check_record().
+ * @return 0 on success, -1 on write failure
+ */
+static int writer_add_row(HandDbWriter* const writer, const HandRecord* const rec,
+                          const unsigned player, const uint64_t board_mask,
+                          const uint32_t packed_board) {
+    const uint8_t c0 = rec->hole[player][0];
+    const uint8_t c1 = rec->hole[player][1];
+    const uint64_t hole_mask = (UINT64_C(1) << c0) | (UINT64_C(1) << c1);
+
+    const HandValue strength = (rec->board_len >= 3) ? evaluate_mask(hole_mask | board_mask) : 0;
+    const uint8_t category = (uint8_t)HAND_VALUE_CATEGORY(strength);
+    const uint16_t bit = (uint16_t)(1u << player);
+    uint8_t result;
+    if (rec->winner_mask == 0) {
+        result = HANDDB_RESULT_UNKNOWN;
+    } else if ((rec->winner_mask & bit) == 0) {
+        result = HANDDB_RESULT_LOST;
+    } else {
+        result = ((rec->winner_mask & (rec->winner_mask - 1)) != 0) ? HANDDB_RESULT_SPLIT
+                                                                     : HANDDB_RESULT_WON;
+    }
+    const int is_hero = (rec->hero == player);
+
+    const size_t i = writer->pending;
+    BlockIndex* const cur = &writer->current;
+    if (i == 0) {
+        memset(cur, 0, sizeof(*cur));
+        cur->min_hand_id = rec->hand_id;
+        cur->max_hand_id = rec->hand_id;
+        cur->min_strength = strength;
+        cur->max_strength = strength;
+    } else {
+        cur->min_hand_id = (rec->hand_id < cur->min_hand_id) ? rec->hand_id : cur->min_hand_id;
+        cur->max_hand_id = (rec->hand_id > cur->max_hand_id) ? rec->hand_id : cur->max_hand_id;
+        cur->min_strength = (strength < cur->min_strength) ? strength : cur->min_strength;
+        cur->max_strength = (strength > cur->max_strength) ? strength : cur->max_strength;
+    }
+    cur->categories |= HANDDB_CATEGORY_BIT(category);
+    cur->results |= result;
+    cur->has_hero |= (uint8_t)is_hero;
+
+    writer->hand_id[i] = rec->hand_id;
+    writer->strength[i] = strength;
+    writer->board[i] = packed_board;
+    writer->hole[i] = (uint16_t)(c0 | (c1 << 6));
+    writer->category[i] = category;
+    writer->result[i] = result;
+    writer->flags[i] = (uint8_t)(rec->board_len | (is_hero ? FLAG_HERO : 0) |
+                                 ((rec->showdown_mask & bit) ? FLAG_SHOWDOWN : 0));
+
+    if (++writer->pending == writer->block_rows) {
+        return writer_flush_block(writer);
+    }
+    return 0;
+}
+
+int handdb_writer_append(HandDbWriter* const writer, const HandRecord* const records,
+                         const size_t count) {
+    if (writer == NULL || (records == NULL && count > 0)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    if (writer->error != POKER_EOK) {
+        poker_errno = writer->error;
+        return -1;
+    }
+
+    /* Validate the whole batch first, so a bad record appends nothing */
+    uint64_t board_mask = 0;
+    uint32_t packed_board = 0;
+    for (size_t r = 0; r < count; r++) {
+        if (check_record(&records[r], &board_mask, &packed_board) != 0) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+    }
+
+    for (size_t r = 0; r < count; r++) {
+        const HandRecord* const rec = &records[r];
+        check_record(rec, &board_mask, &packed_board);
+        for (unsigned p = 0; p < rec->num_players; p++) {
+            if (rec->hole[p][0] >= DECK_SIZE || rec->hole[p][1] >= DECK_SIZE) {
+                continue;  /* Hole cards not (fully) known */
+            }
+            if (writer_add_row(writer, rec, p, board_mask, packed_board) != 0) {
+                poker_errno = writer->error;
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int handdb_writer_close(HandDbWriter* const writer) {
+    if (writer == NULL) {
+        return 0;
+    }
+
+    if (writer->error == POKER_EOK && writer_flush_block(writer) == 0) {
+        const uint64_t index_offset = writer->offset;
+        uint8_t entry[INDEX_ENTRY_SIZE];
+        for (size_t b = 0; b < writer->num_blocks && writer->error == POKER_EOK; b++) {
+            const BlockIndex* const info = &writer->index[b];
+            put_u64(entry, info->offset);
+            put_u64(entry + 8, info->first_row);
+            put_u64(entry + 16, info->min_hand_id);
+            put_u64(entry + 24, info->max_hand_id);
+            put_u32(entry + 32, info->rows);
+            put_u32(entry + 36, info->min_strength);
+            put_u32(entry + 40, info->max_strength);
+            entry[44] = (uint8_t)info->categories;
+            entry[45] = (uint8_t)(info->categories >> 8);
+            entry[46] = info->results;
+            entry[47] = info->has_hero;
+            writer_put(writer, entry, sizeof(entry));
+        }
+
+        uint8_t trailer[TRAILER_SIZE];
+        put_u64(trailer, index_offset);
+        put_u64(trailer + 8, writer->total);
+        put_u32(trailer + 16, (uint32_t)writer->num_blocks);
+        memcpy(trailer + 20, TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+        if (writer->error == POKER_EOK) {
+            writer_put(writer, trailer, sizeof(trailer));
+        }
+    }
+
+    if (fclose(writer->file) != 0 && writer->error == POKER_EOK) {
+        writer->error = POKER_EIO;
+    }
+    const int error = writer->error;
+    writer_free(writer);
+    if (error != POKER_EOK) {
+        poker_errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Reader and queries                                                       */
+/* ------------------------------------------------------------------------ */
+
+struct HandDb {
+    uint8_t* map;
+    size_t size;
+    BlockIndex* index;
+    size_t num_blocks;
+    uint64_t total;
+};
+
+/* Static helper: open failure path that releases everything */
+static HandDb* db_fail(HandDb* const db, const int error) {
+    handdb_close(db);
+    poker_errno = error;
+    return NULL;
+}
+
+HandDb* handdb_open(const char* const path) {
+    if (path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+    const size_t size = (size_t)st.st_size;
+    if (size < FILE_HEADER_SIZE + TRAILER_SIZE) {
+        close(fd);
+        poker_errno = POKER_EFORMAT;
+        return NULL;
+    }
+    void* const map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* The mapping keeps the file referenced */
+    if (map == MAP_FAILED) {
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+
+    HandDb* const db = calloc(1, sizeof(HandDb));
+    if (db == NULL) {
+        munmap(map, size);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    db->map = (uint8_t*)map;
+    db->size = size;
+
+    const uint8_t* const header = db->map;
+    const uint8_t* const trailer = db->map + size - TRAILER_SIZE;
+    uint32_t marker;
+    memcpy(&marker, header + 8, sizeof(marker));
+    if (memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        header[4] != HANDDB_FORMAT_VERSION || marker != ENDIAN_MARKER ||
+        memcmp(trailer + 20, TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0) {
+        return db_fail(db, POKER_EFORMAT);
+    }
+
+    const uint64_t index_offset = get_u64(trailer);
+    const uint64_t num_blocks = get_u32(trailer + 16);
+    db->total = get_u64(trailer + 8);
+    if (index_offset < FILE_HEADER_SIZE || index_offset > size - TRAILER_SIZE ||
+        size - TRAILER_SIZE - index_offset != num_blocks * INDEX_ENTRY_SIZE) {
+        return db_fail(db, POKER_EFORMAT);
+    }
+
+    db->num_blocks = (size_t)num_blocks;
+    if (num_blocks > 0) {
+        db->index = malloc((size_t)num_blocks * sizeof(BlockIndex));
+        if (db->index == NULL) {
+            return db_fail(db, POKER_ENOMEM);
+        }
+    }
+
+    /* Blocks must tile [header, index) in order */
+    uint64_t expected_offset = FILE_HEADER_SIZE;
+    uint64_t expected_row = 0;
+    for (size_t b = 0; b < db->num_blocks; b++) {
+        const uint8_t* const entry = db->map + index_offset + b * INDEX_ENTRY_SIZE;
+        BlockIndex* const info = &db->index[b];
+        info->offset = get_u64(entry);
+        info->first_row = get_u64(entry + 8);
+        info->min_hand_id = get_u64(entry + 16);
+        info->max_hand_id = get_u64(entry + 24);
+        info->rows = get_u32(entry + 32);
+        info->min_strength = get_u32(entry + 36);
+        info->max_strength = get_u32(entry + 40);
+        info->categories = (uint16_t)(entry[44] | (entry[45] << 8));
+        info->results = entry[46];
+        info->has_hero = entry[47];
+        if (info->offset != expected_offset || info->first_row != expected_row ||
+            info->rows == 0 || info->rows > MAX_BLOCK_ROWS) {
+            return db_fail(db, POKER_EFORMAT);
+        }
+        expected_offset += align8(ROW_BYTES * (uint64_t)info->rows);
+        expected_row += info->rows;
+    }
+    if (expected_offset != index_offset || expected_row != db->total) {
+        return db_fail(db, POKER_EFORMAT);
+    }
+
+    return db;
+}
+
+uint64_t handdb_row_count(const HandDb* const db) {
+    return (db != NULL) ? db->total : 0;
+}
+
+/* Static helper: can any row of this block match? (index only) */
+static int block_may_match(const BlockIndex* const info, const HandDbQuery* const q) {
+    if (q->categories != 0 && (info->categories & q->categories) == 0) {
+        return 0;
+    }
+    if (q->results != 0 && (info->results & q->results) == 0) {
+        return 0;
+    }
+    if (q->hero_only && !info->has_hero) {
+        return 0;
+    }
+    if (info->max_strength < q->min_strength ||
+        (q->max_strength != 0 && info->min_strength > q->max_strength)) {
+        return 0;
+    }
+    if (info->max_hand_id < q->min_hand_id ||
+        (q->max_hand_id != 0 && info->min_hand_id > q->max_hand_id)) {
+        return 0;
+    }
+    return 1;
+}
+
+/* Static helper: materialize row i of a block */
+static void load_row(const Columns* const cols, const size_t i, const uint64_t row,
+                     HandDbRow* const out) {
+    const uint32_t board = cols->board[i];
+    const uint8_t flags = cols->flags[i];
+
+    out->row = row;
+    out->hand_id = cols->hand_id[i];
+    out->hole[0] = (uint8_t)(cols->hole[i] & 63u);
+    out->hole[1] = (uint8_t)(cols->hole[i] >> 6);
+    out->board_len = flags & FLAG_BOARD_LEN_MASK;
+    for (unsigned b = 0; b < BOARD_SIZE; b++) {
+        out->board[b] = (b < out->board_len) ? (uint8_t)((board >> (6 * b)) & 63u) : 0;
+    }
+    out->is_hero = (flags & FLAG_HERO) ? 1 : 0;
+    out->showdown = (flags & FLAG_SHOWDOWN) ? 1 : 0;
+    out->result = cols->result[i];
+    out->category = (HandCategory)cols->category[i];
+    out->strength = cols->strength[i];
+}
+
+int handdb_query(const HandDb* const db, const HandDbQuery* const query,
+                 HandDbRowCallback callback, void* const user_data,
+                 HandDbQueryStats* const out_stats) {
+    if (db == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    HandDbQuery q;
+    if (query != NULL) {
+        q = *query;
+    } else {
+        memset(&q, 0, sizeof(q));
+    }
+    const int test_strength = (q.min_strength != 0 || q.max_strength != 0);
+    const int test_id = (q.min_hand_id != 0 || q.max_hand_id != 0);
+    const HandValue max_strength = (q.max_strength != 0) ? q.max_strength : UINT32_MAX;
+    const uint64_t max_id = (q.max_hand_id != 0) ? q.max_hand_id : UINT64_MAX;
+
+    HandDbQueryStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.blocks_total = db->num_blocks;
+
+    int stop = 0;
+    for (size_t b = 0; b < db->num_blocks && !stop; b++) {
+        const BlockIndex* const info = &db->index[b];
+        if (!block_may_match(info, &q)) {
+            continue;
+        }
+        stats.blocks_scanned++;
+        stats.rows_scanned += info->rows;
+
+        Columns cols;
+        columns_at(&cols, db->map + info->offset, info->rows);
+
+        /* Each test reads its column only when the predicate uses it */
+        for (size_t i = 0; i < info->rows; i++) {
+            if (q.categories != 0 && (HANDDB_CATEGORY_BIT(cols.category[i]) & q.categories) == 0) {
+                continue;
+            }
+            if (q.results != 0 && (cols.result[i] & q.results) == 0) {
+                continue;
+            }
+            if (q.hero_only && (cols.flags[i] & FLAG_HERO) == 0) {
+                continue;
+            }
+            if (test_strength &&
+                (cols.strength[i] < q.min_strength || cols.strength[i] > max_strength)) {
+                continue;
+            }
+            if (test_id && (cols.hand_id[i] < q.min_hand_id || cols.hand_id[i] > max_id)) {
+                continue;
+            }
+
+            stats.rows_matched++;
+            if (callback != NULL) {
+                HandDbRow row;
+                load_row(&cols, i, info->first_row + i, &row);
+                if (callback(&row, user_data) != 0) {
+                    stop = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (out_stats != NULL) {
+        *out_stats = stats;
+    }
+    return 0;
+}
+
+void handdb_close(HandDb* const db) {
+    if (db == NULL) {
+        return;
+    }
+    if (db->map != NULL) {
+        munmap(db->map, db->size);
+    }
+    free(db->index);
+    free(db);
+}
@@ -0,0 +1,444 @@
+/*
+ * handindex.c - Suit-isomorphic indices of hands and boards
+ */
+
+#include "../include/poker_handindex.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+#define RANKS 13
+#define SUITS 4
+#define MAX_ROUNDS 2
+
+/* Bits per round in a suit's count code (at most 5 cards of a suit per round) */
+#define CODE_BITS 3
+
+/*
+ * Suits holding the same number of cards in every round form a group;
+ * a configuration is the sorted list of per-suit count codes
+ */
+typedef struct {
+    uint32_t key;                     /* Sorted suit codes, 8 bits each */
+    uint64_t offset;                  /* First index of the configuration */
+    size_t num_groups;
+    uint8_t group_code[SUITS];
+    uint8_t group_len[SUITS];
+    uint64_t suit_size[SUITS];        /* Rank-set sequences per suit of the group */
+    uint64_t group_size[SUITS];       /* Multisets of group_len suit indices */
+} Configuration;
+
+typedef struct {
+    size_t num_rounds;
+    uint8_t round_cards[MAX_ROUNDS];
+    size_t num_cards;
+    Configuration* configs;           /* Ascending key, so ascending offset */
+    size_t num_configs;
+    uint64_t size;
+} Indexer;
+
+/* Board cards per street */
+static const uint8_t BOARD_CARDS[HAND_INDEX_STREETS] = {0, 3, 4, 5};
+
+/* Hand indexers per street, board indexers per street (board_indexers[0] unused) */
+static Indexer hand_indexers[HAND_INDEX_STREETS];
+static Indexer board_indexers[HAND_INDEX_STREETS];
+static pthread_once_t indexers_once = PTHREAD_ONCE_INIT;
+static int indexers_ready = 0;
+
+/* Binomials over ranks: rank_choose[n][k] = C(n, k) */
+static uint64_t rank_choose[RANKS + 1][RANKS + 1];
+
+/* Static helper: C(n, k) for the small k of suit groups */
+static uint64_t choose(const uint64_t n, const uint64_t k) {
+    if (k > n) {
+        return 0;
+    }
+    uint64_t result = 1;
+    for (uint64_t i = 0; i < k; i++) {
+        result = result * (n - i) / (i + 1);
+    }
+    return result;
+}
+
+static unsigned code_count(const uint8_t code, const size_t round) {
+    return (code >> (CODE_BITS * (MAX_ROUNDS - 1 - round))) & ((1u << CODE_BITS) - 1);
+}
+
+/* Static helper: rank-set sequences of one suit with the given per-round counts */
+static uint64_t suit_size(const uint8_t code, const size_t num_rounds) {
+    uint64_t size = 1;
+    unsigned used = 0;
+    for (size_t r = 0; r < num_rounds; r++) {
+        const unsigned m = code_count(code, r);
+        if (used + m > RANKS) {
+            return 0;
+        }
+        size *= rank_choose[RANKS - used][m];
+        used += m;
+    }
+    return size;
+}
+
+static int compare_configs(const void* a, const void* b) {
+    const uint32_t x = ((const Configuration*)a)->key;
+    const uint32_t y = ((const Configuration*)b)->key;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Static helper: enumerate the configurations of an indexer, recursing
+ * over suits with non-increasing codes. Returns -1 when out of memory.
+ */
+static int add_configs(Indexer* const ix, uint8_t* const codes, const size_t suit,
+                       const uint8_t max_code, size_t* const capacity) {
+    if (suit == SUITS) {
+        for (size_t r = 0; r < ix->num_rounds; r++) {
+            unsigned total = 0;
+            for (size_t s = 0; s < SUITS; s++) {
+                total += code_count(codes[s], r);
+            }
+            if (total != ix->round_cards[r]) {
+                return 0;
+            }
+        }
+        if (ix->num_configs == *capacity) {
+            const size_t grown = (*capacity > 0) ? 2 * *capacity : 64;
+            Configuration* const configs = realloc(ix->configs, grown * sizeof(Configuration));
+            if (configs == NULL) {
+                return -1;
+            }
+            ix->configs = configs;
+            *capacity = grown;
+        }
+        Configuration* const config = &ix->configs[ix->num_configs++];
+        config->key = 0;
+        config->num_groups = 0;
+        for (size_t s = 0; s < SUITS; s++) {
+            config->key = (config->key << 8) | codes[s];
+            if (s > 0 && codes[s] == codes[s - 1]) {
+                config->group_len[config->num_groups - 1]++;
+                continue;
+            }
+            config->group_code[config->num_groups] = codes[s];
+            config->group_len[config->num_groups] = 1;
+            config->num_groups++;
+        }
+        return 0;
+    }
+
+    for (int code = max_code; code >= 0; code--) {
+        int fits = suit_size((uint8_t)code, ix->num_rounds) > 0;
+        for (size_t r = ix->num_rounds; r < MAX_ROUNDS && fits; r++) {
+            fits = (code_count((uint8_t)code, r) == 0);
+        }
+        for (size_t r = 0; r < ix->num_rounds && fits; r++) {
+            fits = (code_count((uint8_t)code, r) <= ix->round_cards[r]);
+        }
+        if (!fits) {
+            continue;
+        }
+        codes[suit] = (uint8_t)code;
+        if (add_configs(ix, codes, suit + 1, (uint8_t)code, capacity) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int build_indexer(Indexer* const ix, const uint8_t* const rounds, const size_t num_rounds) {
+    ix->num_rounds = num_rounds;
+    ix->num_cards = 0;
+    for (size_t r = 0; r < num_rounds; r++) {
+        ix->round_cards[r] = rounds[r];
+        ix->num_cards += rounds[r];
+    }
+    ix->configs = NULL;
+    ix->num_configs = 0;
+    size_t capacity = 0;
+    uint8_t codes[SUITS];
+    if (add_configs(ix, codes, 0, (1u << (CODE_BITS * MAX_ROUNDS)) - 1, &capacity) != 0) {
+        return -1;
+    }
+    qsort(ix->configs, ix->num_configs, sizeof(Configuration), compare_configs);
+
+    ix->size = 0;
+    for (size_t i = 0; i < ix->num_configs; i++) {
+        Configuration* const config = &ix->configs[i];
+        uint64_t size = 1;
+        for (size_t g = 0; g < config->num_groups; g++) {
+            config->suit_size[g] = suit_size(config->group_code[g], num_rounds);
+            config->group_size[g] = choose(config->suit_size[g] + config->group_len[g] - 1,
+                                           config->group_len[g]);
+            size *= config->group_size[g];
+        }
+        config->offset = ix->size;
+        ix->size += size;
+    }
+    return 0;
+}
+
+static void init_indexers(void) {
+    for (size_t n = 0; n <= RANKS; n++) {
+        for (size_t k = 0; k <= RANKS; k++) {
+            rank_choose[n][k] = choose(n, k);
+        }
+    }
+    for (int street = 0; street < HAND_INDEX_STREETS; street++) {
+        /* Hole cards are one round, the board another */
+        const uint8_t rounds[MAX_ROUNDS] = {HOLE_SIZE, BOARD_CARDS[street]};
+        if (build_indexer(&hand_indexers[street], rounds, (street > 0) ? 2 : 1) != 0) {
+            return;
+        }
+        if (street > 0 && build_indexer(&board_indexers[street], rounds + 1, 1) != 0) {
+            return;
+        }
+    }
+    indexers_ready = 1;
+}
+
+/* Static helper: indexer tables, built once; NULL when out of memory */
+static const Indexer* get_indexer(const int street, const int board) {
+    pthread_once(&indexers_once, init_indexers);
+    if (!indexers_ready) {
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    if (street < (board ? HAND_INDEX_FLOP : HAND_INDEX_PREFLOP) || street >= HAND_INDEX_STREETS) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+    return board ? &board_indexers[street] : &hand_indexers[street];
+}
+
+/* Static helper: colex rank of each round's ranks among the ranks earlier rounds left */
+static uint64_t suit_index(const uint16_t* const sets, const size_t num_rounds) {
+    uint64_t index = 0;
+    uint64_t multiplier = 1;
+    uint16_t used = 0;
+    for (size_t r = 0; r < num_rounds; r++) {
+        uint64_t colex = 0;
+        unsigned k = 1;
+        for (uint16_t rest = sets[r]; rest != 0; rest &= (uint16_t)(rest - 1), k++) {
+            const unsigned rank = (unsigned)__builtin_ctz(rest);
+            const unsigned position = rank - (unsigned)__builtin_popcount(used & ((1u << rank) - 1));
+            colex += rank_choose[position][k];
+        }
+        index += colex * multiplier;
+        multiplier *= rank_choose[RANKS - __builtin_popcount(used)][__builtin_popcount(sets[r])];
+        used |= sets[r];
+    }
+    return index;
+}
+
+static void suit_unindex(uint64_t index, const uint8_t code, const size_t num_rounds,
+                         uint16_t* const sets) {
+    uint16_t used = 0;
+    for (size_t r = 0; r < num_rounds; r++) {
+        const unsigned m = code_count(code, r);
+        const unsigned free_ranks = RANKS - (unsigned)__builtin_popcount(used);
+        const uint64_t size = rank_choose[free_ranks][m];
+        uint64_t colex = index % size;
+        index /= size;
+
+        uint16_t set = 0;
+        unsigned top = free_ranks;
+        for (unsigned k = m; k > 0; k--) {
+            unsigned position = top - 1;
+            while (rank_choose[position][k] > colex) {
+                position--;
+            }
+            colex -= rank_choose[position][k];
+            top = position;
+            /* The position-th rank not used by earlier rounds */
+            unsigned rank = 0;
+            for (unsigned seen = 0;; rank++) {
+                if (!(used & (1u << rank)) && seen++ == position) {
+                    break;
+                }
+            }
+            set |= (uint16_t)(1u << rank);
+        }
+        sets[r] = set;
+        used |= set;
+    }
+}
+
+/* Static helper: rank of a non-increasing multiset a[0..k) of values below n */
+static uint64_t multiset_index(const uint64_t* const a, const size_t k) {
+    uint64_t index = 0;
+    for (size_t j = 0; j < k; j++) {
+        index += choose(a[j] + (k - 1 - j), k - j);
+    }
+    return index;
+}
+
+static void multiset_unindex(uint64_t index, const uint64_t n, const size_t k,
+                             uint64_t* const out) {
+    for (size_t j = 0; j < k; j++) {
+        const uint64_t t = k - j;
+        /* Largest b with C(b, t) <= index, b in [t - 1, n + t - 1) */
+        uint64_t low = t - 1;
+        uint64_t high = n + t - 2;
+        while (low < high) {
+            const uint64_t mid = low + (high - low + 1) / 2;
+            if (choose(mid, t) <= index) {
+                low = mid;
+            } else {
+                high = mid - 1;
+            }
+        }
+        index -= choose(low, t);
+        out[j] = low - (t - 1);
+    }
+}
+
+static int index_cards(const Indexer* const ix, const uint8_t* const cards,
+                       const size_t num_cards, uint64_t* const out) {
+    if (cards == NULL || out == NULL || num_cards != ix->num_cards) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    uint16_t sets[SUITS][MAX_ROUNDS] = {{0}};
+    uint64_t seen = 0;
+    size_t next = 0;
+    for (size_t r = 0; r < ix->num_rounds; r++) {
+        for (unsigned i = 0; i < ix->round_cards[r]; i++) {
+            const uint8_t card = cards[next++];
+            if (card >= DECK_SIZE) {
+                poker_errno = POKER_EINVAL;
+                return -1;
+            }
+            if (seen & (UINT64_C(1) << card)) {
+                poker_errno = POKER_EDUPLICATE;
+                return -1;
+            }
+            seen |= UINT64_C(1) << card;
+            sets[card & 3][r] |= (uint16_t)(1u << (card >> 2));
+        }
+    }
+
+    /* Suits sorted by count code, then by suit index, both descending */
+    uint8_t codes[SUITS];
+    uint64_t indices[SUITS];
+    for (size_t s = 0; s < SUITS; s++) {
+        uint8_t code = 0;
+        for (size_t r = 0; r < ix->num_rounds; r++) {
+            code |= (uint8_t)(__builtin_popcount(sets[s][r]) << (CODE_BITS * (MAX_ROUNDS - 1 - r)));
+        }
+        const uint64_t index = suit_index(sets[s], ix->num_rounds);
+        size_t at = s;
+        while (at > 0 && (codes[at - 1] < code || (codes[at - 1] == code && indices[at - 1] < index))) {
+            codes[at] = codes[at - 1];
+            indices[at] = indices[at - 1];
+            at--;
+        }
+        codes[at] = code;
+        indices[at] = index;
+    }
+    const uint32_t key = ((uint32_t)codes[0] << 24) | ((uint32_t)codes[1] << 16) |
+                         ((uint32_t)codes[2] << 8) | codes[3];
+
+    size_t low = 0;
+    size_t high = ix->num_configs;
+    while (high - low > 1) {
+        const size_t mid = (low + high) / 2;
+        if (ix->configs[mid].key <= key) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    const Configuration* const config = &ix->configs[low];
+
+    uint64_t index = 0;
+    uint64_t multiplier = 1;
+    size_t suit = 0;
+    for (size_t g = 0; g < config->num_groups; g++) {
+        index += multiset_index(indices + suit, config->group_len[g]) * multiplier;
+        multiplier *= config->group_size[g];
+        suit += config->group_len[g];
+    }
+    *out = config->offset + index;
+    return 0;
+}
+
+static int unindex_cards(const Indexer* const ix, const uint64_t index, uint8_t* const out) {
+    if (out == NULL || index >= ix->size) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    size_t low = 0;
+    size_t high = ix->num_configs;
+    while (high - low > 1) {
+        const size_t mid = (low + high) / 2;
+        if (ix->configs[mid].offset <= index) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    const Configuration* const config = &ix->configs[low];
+
+    /* Suits take the canonical order of the configuration */
+    uint16_t sets[SUITS][MAX_ROUNDS] = {{0}};
+    uint64_t rest = index - config->offset;
+    size_t suit = 0;
+    for (size_t g = 0; g < config->num_groups; g++) {
+        uint64_t indices[SUITS];
+        const size_t k = config->group_len[g];
+        multiset_unindex(rest % config->group_size[g], config->suit_size[g], k, indices);
+        rest /= config->group_size[g];
+        for (size_t j = 0; j < k; j++, suit++) {
+            suit_unindex(indices[j], config->group_code[g], ix->num_rounds, sets[suit]);
+        }
+    }
+
+    size_t next = 0;
+    for (size_t r = 0; r < ix->num_rounds; r++) {
+        for (unsigned rank = 0; rank < RANKS; rank++) {
+            for (unsigned s = 0; s < SUITS; s++) {
+                if (sets[s][r] & (1u << rank)) {
+                    out[next++] = (uint8_t)(rank * SUITS + s);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+uint64_t hand_index_count(const int street) {
+    const Indexer* const ix = get_indexer(street, 0);
+    return (ix != NULL) ? ix->size : 0;
+}
+
+int hand_index(const uint8_t* const cards, const size_t num_cards, uint64_t* const out) {
+    int street = -1;
+    for (int s = 0; s < HAND_INDEX_STREETS; s++) {
+        if (num_cards == (size_t)HOLE_SIZE + BOARD_CARDS[s]) {
+            street = s;
+        }
+    }
+    const Indexer* const ix = get_indexer(street, 0);
+    return (ix != NULL) ? index_cards(ix, cards, num_cards, out) : -1;
+}
+
+int hand_unindex(const int street, const uint64_t index, uint8_t* const out_cards) {
+    const Indexer* const ix = get_indexer(street, 0);
+    return (ix != NULL) ? unindex_cards(ix, index, out_cards) : -1;
+}
+
+uint64_t board_index_count(const int street) {
+    const Indexer* const ix = get_indexer(street, 1);
+    return (ix != NULL) ? ix->size : 0;
+}
+
+int board_index(const uint8_t* const cards, const size_t num_cards, uint64_t* const out) {
+    const int street = (num_cards >= 3 && num_cards <= BOARD_SIZE) ? (int)num_cards - 2 : -1;
+    const Indexer* const ix = get_indexer(street, 1);
+    return (ix != NULL) ? index_cards(ix, cards, num_cards, out) : -1;
+}
+
+int board_unindex(const int street, const uint64_t index, uint8_t* const out_cards) {
+    const Indexer* const ix = get_indexer(street, 1);
+    return (ix != NULL) ? unindex_cards(ix, index, out_cards) : -1;
+}
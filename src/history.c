@@ -0,0 +1,499 @@
+/*
+ * history.c - Text hand-history ingestion
+ * Splits PokerStars/GGPoker-style histories into hands and parses them in
+ * parallel into compact HandRecord structs
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_history.h"
+#include "threads.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Initial per-worker record capacity; grows geometrically */
+#define INITIAL_RECORD_CAPACITY 1024
+
+/* Maximum player-name length kept for matching action lines */
+#define MAX_NAME_LEN 64
+
+/* Static helper: does [str, str+len) start with prefix? */
+static int starts_with(const char* const str, const size_t len,
+                       const char* const prefix, const size_t prefix_len) {
+    return len >= prefix_len && memcmp(str, prefix, prefix_len) == 0;
+}
+
+#define STARTS_WITH(str, len, lit) starts_with((str), (len), (lit), sizeof(lit) - 1)
+
+/* Static helper: offset of needle in [str, str+len), or len if absent */
+static size_t find_in(const char* const str, const size_t len,
+                      const char* const needle, const size_t needle_len) {
+    if (needle_len > len) {
+        return len;
+    }
+    const size_t last = len - needle_len;
+    for (size_t i = 0; i <= last; i++) {
+        if (str[i] == needle[0] && memcmp(str + i, needle, needle_len) == 0) {
+            return i;
+        }
+    }
+    return len;
+}
+
+#define FIND_IN(str, len, lit) find_in((str), (len), (lit), sizeof(lit) - 1)
+
+/* Static helper: is the line at [line, line+len) a hand header? */
+static int is_hand_header(const char* const line, const size_t len) {
+    return STARTS_WITH(line, len, "PokerStars ") ||
+           STARTS_WITH(line, len, "Poker Hand #");
+}
+
+size_t history_next_hand(const char* const data, const size_t len, const size_t pos) {
+    if (data == NULL) {
+        return len;
+    }
+
+    size_t i = pos;
+
+    /* Snap to the start of the next line unless already at one */
+    if (i > 0 && i < len && data[i - 1] != '\n') {
+        const char* nl = memchr(data + i, '\n', len - i);
+        i = (nl == NULL) ? len : (size_t)(nl - data) + 1;
+    }
+
+    while (i < len) {
+        if (is_hand_header(data + i, len - i)) {
+            return i;
+        }
+        const char* nl = memchr(data + i, '\n', len - i);
+        if (nl == NULL) {
+            break;
+        }
+        i = (size_t)(nl - data) + 1;
+    }
+    return len;
+}
+
+/*
+ * Per-hand parser state: seat names seen in the header, referenced as
+ * slices of the hand text (no copies).
+ */
+typedef struct {
+    const char* names[MAX_PLAYERS];
+    size_t name_lens[MAX_PLAYERS];
+    size_t num_players;
+} SeatTable;
+
+/* Static helper: player index of a name, or PLAYER_NONE */
+static uint8_t seat_lookup(const SeatTable* const seats, const char* const name,
+                           const size_t name_len) {
+    for (size_t i = 0; i < seats->num_players; i++) {
+        if (seats->name_lens[i] == name_len &&
+            memcmp(seats->names[i], name, name_len) == 0) {
+            return (uint8_t)i;
+        }
+    }
+    return PLAYER_NONE;
+}
+
+/*
+ * Static helper: decode the "[Xx Yy ...]" group that starts at or after
+ * offset 0 of [str, str+len) into CARD_INDEX values.
+ *
+ * @return Number of cards decoded, or -1 if missing/invalid
+ */
+static int parse_bracket_cards(const char* const str, const size_t len,
+                               uint8_t* const out, const size_t max) {
+    const size_t open = FIND_IN(str, len, "[");
+    if (open == len) {
+        return -1;
+    }
+    const char* const start = str + open + 1;
+    const size_t rest = len - open - 1;
+    const char* const close = memchr(start, ']', rest);
+    if (close == NULL) {
+        return -1;
+    }
+
+    Card cards[BOARD_SIZE];
+    const int n = parse_hand(start, (size_t)(close - start), cards,
+                             (max < BOARD_SIZE) ? max : BOARD_SIZE, NULL);
+    for (int i = 0; i < n; i++) {
+        out[i] = (uint8_t)CARD_INDEX(cards[i]);
+    }
+    return n;
+}
+
+/* Static helper: parse the digits of the hand number after '#' */
+static uint64_t parse_hand_id(const char* const line, const size_t len) {
+    size_t i = FIND_IN(line, len, "#");
+    uint64_t id = 0;
+
+    /* GGPoker prefixes hand numbers with letters (e.g., "#HD1234") */
+    for (i++; i < len && !(line[i] >= '0' && line[i] <= '9'); i++) {
+        if (line[i] == ':' || line[i] == ' ') {
+            return 0;
+        }
+    }
+    for (; i < len && line[i] >= '0' && line[i] <= '9'; i++) {
+        id = id * 10 + (uint64_t)(line[i] - '0');
+    }
+    return id;
+}
+
+/* Static helper: handle a "Seat N: name (..." header line */
+static int parse_seat_line(const char* const line, const size_t len,
+                           SeatTable* const seats) {
+    const size_t colon = FIND_IN(line, len, ": ");
+    if (colon == len) {
+        return 0;
+    }
+
+    /* Name runs to the last " (" so names containing parentheses survive */
+    const char* const name = line + colon + 2;
+    size_t name_len = 0;
+    for (size_t i = colon + 2; i + 1 < len; i++) {
+        if (line[i] == ' ' && line[i + 1] == '(') {
+            name_len = i - (colon + 2);
+        }
+    }
+    if (name_len == 0 || name_len > MAX_NAME_LEN) {
+        return 0;
+    }
+    if (seats->num_players >= MAX_PLAYERS) {
+        return -1;
+    }
+
+    seats->names[seats->num_players] = name;
+    seats->name_lens[seats->num_players] = name_len;
+    seats->num_players++;
+    return 0;
+}
+
+/* Static helper: store a player's hole cards from a bracket group */
+static int store_hole_cards(HandRecord* const record, const uint8_t player,
+                            const char* const group, const size_t len) {
+    uint8_t cards[HOLE_SIZE];
+    if (player == PLAYER_NONE) {
+        return 0;
+    }
+    if (parse_bracket_cards(group, len, cards, HOLE_SIZE) != HOLE_SIZE) {
+        return -1;
+    }
+    record->hole[player][0] = cards[0];
+    record->hole[player][1] = cards[1];
+    return 0;
+}
+
+/* Static helper: reject hands where the same card appears twice */
+static int record_cards_unique(const HandRecord* const record) {
+    uint64_t seen = 0;
+    for (size_t i = 0; i < record->board_len; i++) {
+        const uint64_t bit = UINT64_C(1) << record->board[i];
+        if (seen & bit) {
+            return 0;
+        }
+        seen |= bit;
+    }
+    for (size_t p = 0; p < record->num_players; p++) {
+        for (size_t c = 0; c < HOLE_SIZE; c++) {
+            if (record->hole[p][c] == CARD_INDEX_NONE) {
+                continue;
+            }
+            const uint64_t bit = UINT64_C(1) << record->hole[p][c];
+            if (seen & bit) {
+                return 0;
+            }
+            seen |= bit;
+        }
+    }
+    return 1;
+}
+
+int history_parse_hand(const char* const text, const size_t len,
+                       HandRecord* const out_record) {
+    if (text == NULL || out_record == NULL || !is_hand_header(text, len)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    HandRecord record;
+    SeatTable seats;
+    memset(&record, 0, sizeof(record));
+    memset(record.hole, CARD_INDEX_NONE, sizeof(record.hole));
+    record.hero = PLAYER_NONE;
+    seats.num_players = 0;
+
+    int in_header = 1;  /* Seat lines before the first "***" section */
+    int first_line = 1;
+    size_t pos = 0;
+
+    while (pos < len) {
+        const char* const line = text + pos;
+        const char* nl = memchr(line, '\n', len - pos);
+        size_t line_len = (nl == NULL) ? len - pos : (size_t)(nl - line);
+        pos += line_len + 1;
+        if (line_len > 0 && line[line_len - 1] == '\r') {
+            line_len--;
+        }
+
+        if (first_line) {
+            record.hand_id = parse_hand_id(line, line_len);
+            first_line = 0;
+            continue;
+        }
+        if (STARTS_WITH(line, line_len, "***")) {
+            in_header = 0;
+            continue;
+        }
+        if (in_header) {
+            if (STARTS_WITH(line, line_len, "Seat ") &&
+                parse_seat_line(line, line_len, &seats) != 0) {
+                poker_errno = POKER_ERANGE;
+                return -1;
+            }
+            continue;
+        }
+
+        if (STARTS_WITH(line, line_len, "Dealt to ")) {
+            /* Only the hero's line carries cards; others are skipped */
+            const size_t bracket = FIND_IN(line, line_len, " [");
+            if (bracket == line_len) {
+                continue;
+            }
+            const uint8_t player = seat_lookup(&seats, line + 9, bracket - 9);
+            if (store_hole_cards(&record, player, line + bracket, line_len - bracket) != 0) {
+                poker_errno = POKER_EINVAL;
+                return -1;
+            }
+            if (player != PLAYER_NONE) {
+                record.hero = player;
+            }
+        } else if (STARTS_WITH(line, line_len, "Board [")) {
+            const int n = parse_bracket_cards(line, line_len, record.board, BOARD_SIZE);
+            if (n < 0) {
+                poker_errno = POKER_EINVAL;
+                return -1;
+            }
+            record.board_len = (uint8_t)n;
+        } else if (!STARTS_WITH(line, line_len, "Seat ")) {
+            const size_t shows = FIND_IN(line, line_len, ": shows [");
+            if (shows < line_len) {
+                const uint8_t player = seat_lookup(&seats, line, shows);
+                if (store_hole_cards(&record, player, line + shows, line_len - shows) != 0) {
+                    poker_errno = POKER_EINVAL;
+                    return -1;
+                }
+                if (player != PLAYER_NONE) {
+                    record.showdown_mask |= (uint16_t)(1u << player);
+                }
+                continue;
+            }
+
+            const size_t collected = FIND_IN(line, line_len, " collected ");
+            if (collected < line_len) {
+                const uint8_t player = seat_lookup(&seats, line, collected);
+                if (player != PLAYER_NONE) {
+                    record.winner_mask |= (uint16_t)(1u << player);
+                }
+            }
+        }
+    }
+
+    if (seats.num_players == 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    record.num_players = (uint8_t)seats.num_players;
+
+    if (!record_cards_unique(&record)) {
+        poker_errno = POKER_EDUPLICATE;
+        return -1;
+    }
+
+    *out_record = record;
+    return 0;
+}
+
+/* Per-worker state for history_parse_buffer() */
+typedef struct {
+    const char* data;
+    size_t len;         /* Length of the whole buffer */
+    size_t start;       /* First hand header owned by this worker */
+    size_t end;         /* Start of the next worker's range */
+    HandRecord* records;
+    size_t count;
+    size_t capacity;
+    size_t skipped;
+    int error;          /* POKER_EOK or POKER_ENOMEM */
+} IngestWorker;
+
+static void* ingest_worker(void* const arg) {
+    IngestWorker* const w = (IngestWorker*)arg;
+    size_t pos = w->start;
+
+    while (pos < w->end) {
+        const size_t next = history_next_hand(w->data, w->len, pos + 1);
+
+        if (w->count == w->capacity) {
+            const size_t capacity = (w->capacity == 0) ? INITIAL_RECORD_CAPACITY : w->capacity * 2;
+            HandRecord* const grown = realloc(w->records, capacity * sizeof(HandRecord));
+            if (grown == NULL) {
+                w->error = POKER_ENOMEM;
+                return NULL;
+            }
+            w->records = grown;
+            w->capacity = capacity;
+        }
+
+        if (history_parse_hand(w->data + pos, next - pos, &w->records[w->count]) == 0) {
+            w->count++;
+        } else {
+            w->skipped++;
+        }
+        pos = next;
+    }
+    return NULL;
+}
+
+int history_parse_buffer(const char* const data, const size_t len,
+                         const size_t num_threads,
+                         HistoryResult* const out_result) {
+    if (out_result == NULL || (data == NULL && len > 0)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    out_result->records = NULL;
+    out_result->count = 0;
+    out_result->skipped = 0;
+    if (len == 0) {
+        return 0;
+    }
+
+    /* Don't spawn more workers than there are ~64 KB chunks of input */
+    size_t threads = resolve_thread_count(num_threads);
+    const size_t max_useful = len / 65536 + 1;
+    if (threads > max_useful) {
+        threads = max_useful;
+    }
+
+    IngestWorker* const workers = calloc(threads, sizeof(IngestWorker));
+    if (workers == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+
+    /* Split into equal byte ranges, each snapped forward to a hand boundary */
+    for (size_t i = 0; i < threads; i++) {
+        workers[i].data = data;
+        workers[i].len = len;
+        workers[i].start = history_next_hand(data, len, len / threads * i);
+    }
+    for (size_t i = 0; i < threads; i++) {
+        workers[i].end = (i + 1 < threads) ? workers[i + 1].start : len;
+        if (workers[i].end < workers[i].start) {
+            workers[i].end = workers[i].start;
+        }
+    }
+
+    run_threads(threads, ingest_worker, workers, sizeof(IngestWorker));
+
+    /* Concatenate per-worker results in buffer order */
+    size_t total = 0;
+    int error = POKER_EOK;
+    for (size_t i = 0; i < threads; i++) {
+        total += workers[i].count;
+        out_result->skipped += workers[i].skipped;
+        if (workers[i].error != POKER_EOK) {
+            error = workers[i].error;
+        }
+    }
+
+    HandRecord* records = NULL;
+    if (error == POKER_EOK && total > 0) {
+        records = malloc(total * sizeof(HandRecord));
+        if (records == NULL) {
+            error = POKER_ENOMEM;
+        } else {
+            size_t offset = 0;
+            for (size_t i = 0; i < threads; i++) {
+                if (workers[i].count > 0) {
+                    memcpy(records + offset, workers[i].records,
+                           workers[i].count * sizeof(HandRecord));
+                }
+                offset += workers[i].count;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < threads; i++) {
+        free(workers[i].records);
+    }
+    free(workers);
+
+    if (error != POKER_EOK) {
+        out_result->skipped = 0;
+        poker_errno = error;
+        return -1;
+    }
+
+    out_result->records = records;
+    out_result->count = total;
+    return 0;
+}
+
+int history_load_file(const char* const path, const size_t num_threads,
+                      HistoryResult* const out_result) {
+    if (path == NULL || out_result == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        poker_errno = POKER_ENOTFOUND;
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        poker_errno = POKER_ENOTFOUND;
+        return -1;
+    }
+
+    const size_t len = (size_t)st.st_size;
+    if (len == 0) {
+        close(fd);
+        return history_parse_buffer(NULL, 0, num_threads, out_result);
+    }
+
+    void* const map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* The mapping keeps the file referenced */
+    if (map == MAP_FAILED) {
+        poker_errno = POKER_ENOTFOUND;
+        return -1;
+    }
+
+    /* Workers read their ranges front to back */
+    posix_madvise(map, len, POSIX_MADV_SEQUENTIAL);
+
+    const int rc = history_parse_buffer((const char*)map, len, num_threads, out_result);
+    munmap(map, len);
+    return rc;
+}
+
+void history_result_free(HistoryResult* const result) {
+    if (result == NULL) {
+        return;
+    }
+
+    free(result->records);
+    result->records = NULL;  /* Prevent double-free */
+    result->count = 0;
+    result->skipped = 0;
+}
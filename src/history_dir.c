@@ -0,0 +1,682 @@
+/*
+ * history_dir.c - Directory ingestion for many small hand-history files
+ * Batches open/read/close through io_uring where available, with an
+ * open + pread thread-pool fallback
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE  /* d_type, syscall() */
+
+#include "../include/poker_history.h"
+#include "threads.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * io_uring is used through raw syscalls (no liburing dependency). Define
+ * POKER_NO_IO_URING to build the pread path only.
+ */
+#if defined(__linux__) && !defined(POKER_NO_IO_URING) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+/* Default files in flight per io_uring worker */
+#define DEFAULT_QUEUE_DEPTH 64
+
+/* Upper bound on queue depth (ring entries are twice this) */
+#define MAX_QUEUE_DEPTH 1024
+
+/* Initial per-file read buffer; grows for larger files */
+#define INITIAL_READ_BUFFER 65536
+
+/* Sentinel returned by take_next_file() when no work remains */
+#define NO_FILE SIZE_MAX
+
+/*
+ * Shared ingestion job. The lock guards next, stats, stop and error, and
+ * serializes callback invocations.
+ */
+typedef struct {
+    int dir_fd;
+    char** names;
+    size_t num_names;
+    size_t next;
+    pthread_mutex_t lock;
+    HistoryFileCallback callback;
+    void* user_data;
+    HistoryDirStats stats;
+    int stop;
+    int error;
+} DirJob;
+
+/* Per-worker arguments for run_threads() */
+typedef struct {
+    DirJob* job;
+    size_t queue_depth;
+    int use_io_uring;
+} DirWorker;
+
+/* Static helper: claim the next unread file, or NO_FILE */
+static size_t take_next_file(DirJob* const job) {
+    size_t index = NO_FILE;
+
+    pthread_mutex_lock(&job->lock);
+    if (!job->stop && job->error == POKER_EOK && job->next < job->num_names) {
+        index = job->next++;
+    }
+    pthread_mutex_unlock(&job->lock);
+    return index;
+}
+
+/* Static helper: count a file that could not be read */
+static void record_failure(DirJob* const job) {
+    pthread_mutex_lock(&job->lock);
+    job->stats.failed_files++;
+    pthread_mutex_unlock(&job->lock);
+}
+
+/* Static helper: parse a file's bytes and deliver its records */
+static void deliver_file(DirJob* const job, const size_t index,
+                         const char* const data, const size_t len) {
+    HistoryResult result;
+
+    if (history_parse_buffer(data, len, 1, &result) != 0) {
+        pthread_mutex_lock(&job->lock);
+        job->error = poker_errno;
+        pthread_mutex_unlock(&job->lock);
+        return;
+    }
+
+    pthread_mutex_lock(&job->lock);
+    if (!job->stop) {
+        job->stats.files++;
+        job->stats.bytes += len;
+        job->stats.records += result.count;
+        job->stats.skipped += result.skipped;
+        if (job->callback(job->names[index], result.records, result.count,
+                          job->user_data) != 0) {
+            job->stop = 1;
+        }
+    }
+    pthread_mutex_unlock(&job->lock);
+
+    history_result_free(&result);
+}
+
+/* Static helper: grow a read buffer to at least need bytes */
+static int ensure_capacity(char** const buf, size_t* const cap, const size_t need) {
+    if (need <= *cap) {
+        return 0;
+    }
+    size_t capacity = (*cap == 0) ? INITIAL_READ_BUFFER : *cap;
+    while (capacity < need) {
+        capacity *= 2;
+    }
+    char* const grown = realloc(*buf, capacity);
+    if (grown == NULL) {
+        return -1;
+    }
+    *buf = grown;
+    *cap = capacity;
+    return 0;
+}
+
+/*
+ * Static helper: read a whole file with openat + pread
+ *
+ * @return Bytes read, or -1 on I/O error, -2 on allocation failure
+ */
+static long read_file_pread(const int dir_fd, const char* const name,
+                            char** const buf, size_t* const cap) {
+    const int fd = openat(dir_fd, name, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat st;
+    size_t len = 0;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (ensure_capacity(buf, cap, (size_t)st.st_size + 1) != 0) {
+        close(fd);
+        return -2;
+    }
+
+    /* Read to EOF; the file may have grown since fstat() */
+    for (;;) {
+        if (len == *cap && ensure_capacity(buf, cap, len + 1) != 0) {
+            close(fd);
+            return -2;
+        }
+        const ssize_t n = pread(fd, *buf + len, *cap - len, (off_t)len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            close(fd);
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        len += (size_t)n;
+    }
+
+    close(fd);
+    return (long)len;
+}
+
+/* Static helper: pread-based worker loop */
+static void pread_worker_loop(DirJob* const job) {
+    char* buf = NULL;
+    size_t cap = 0;
+
+    for (size_t index = take_next_file(job); index != NO_FILE; index = take_next_file(job)) {
+        const long len = read_file_pread(job->dir_fd, job->names[index], &buf, &cap);
+        if (len == -2) {
+            pthread_mutex_lock(&job->lock);
+            job->error = POKER_ENOMEM;
+            pthread_mutex_unlock(&job->lock);
+            break;
+        }
+        if (len < 0) {
+            record_failure(job);
+            continue;
+        }
+        deliver_file(job, index, buf, (size_t)len);
+    }
+
+    free(buf);
+}
+
+#ifdef HAVE_IO_URING
+
+/* Operation tags stored in the low bits of user_data */
+#define OP_OPEN  0
+#define OP_READ  1
+#define OP_CLOSE 2
+#define OP_BITS  2
+
+/*
+ * Minimal io_uring ring: one submitter, one consumer (the owning worker)
+ */
+typedef struct {
+    int fd;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_array;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned sqe_tail;       /* Local tail, published on submit */
+    unsigned to_submit;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned cq_mask;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    void* sq_map;
+    size_t sq_map_len;
+    void* cq_map;
+    size_t cq_map_len;
+    size_t sqes_len;
+} Ring;
+
+/* Per-file state for files in flight on a ring */
+typedef struct {
+    size_t file;
+    int fd;
+    char* buf;
+    size_t cap;
+    size_t len;
+    int busy;
+} Slot;
+
+static int ring_init(Ring* const ring, const unsigned entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    memset(ring, 0, sizeof(*ring));
+
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0) {
+        return -1;
+    }
+
+    ring->sq_map_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_map_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_map_len > ring->sq_map_len) {
+            ring->sq_map_len = ring->cq_map_len;
+        }
+        ring->cq_map_len = ring->sq_map_len;
+    }
+
+    ring->sq_map = mmap(NULL, ring->sq_map_len, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (ring->sq_map == MAP_FAILED) {
+        close(ring->fd);
+        return -1;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_map = ring->sq_map;
+    } else {
+        ring->cq_map = mmap(NULL, ring->cq_map_len, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+        if (ring->cq_map == MAP_FAILED) {
+            munmap(ring->sq_map, ring->sq_map_len);
+            close(ring->fd);
+            return -1;
+        }
+    }
+
+    ring->sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        if (ring->cq_map != ring->sq_map) {
+            munmap(ring->cq_map, ring->cq_map_len);
+        }
+        munmap(ring->sq_map, ring->sq_map_len);
+        close(ring->fd);
+        return -1;
+    }
+
+    char* const sq = (char*)ring->sq_map;
+    char* const cq = (char*)ring->cq_map;
+    ring->sq_head = (unsigned*)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring->sq_mask = *(unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sq_entries = params.sq_entries;
+    ring->sqe_tail = *ring->sq_tail;
+    ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cq_mask = *(unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    return 0;
+}
+
+static void ring_free(Ring* const ring) {
+    munmap(ring->sqes, ring->sqes_len);
+    if (ring->cq_map != ring->sq_map) {
+        munmap(ring->cq_map, ring->cq_map_len);
+    }
+    munmap(ring->sq_map, ring->sq_map_len);
+    close(ring->fd);
+}
+
+/* Static helper: next free SQE (zeroed), or NULL if the queue is full */
+static struct io_uring_sqe* ring_get_sqe(Ring* const ring) {
+    const unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    if (ring->sqe_tail - head >= ring->sq_entries) {
+        return NULL;
+    }
+    const unsigned index = ring->sqe_tail & ring->sq_mask;
+    struct io_uring_sqe* const sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_array[index] = index;
+    ring->sqe_tail++;
+    ring->to_submit++;
+    return sqe;
+}
+
+/* Static helper: publish queued SQEs and wait for at least wait_nr CQEs */
+static int ring_submit(Ring* const ring, const unsigned wait_nr) {
+    __atomic_store_n(ring->sq_tail, ring->sqe_tail, __ATOMIC_RELEASE);
+    for (;;) {
+        const long rc = syscall(__NR_io_uring_enter, ring->fd, ring->to_submit, wait_nr,
+                                IORING_ENTER_GETEVENTS, NULL, 0);
+        if (rc >= 0) {
+            ring->to_submit -= (unsigned)rc;
+            return 0;
+        }
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+}
+
+static void prep_open(Ring* const ring, const int dir_fd, const char* const name,
+                      const size_t slot) {
+    struct io_uring_sqe* const sqe = ring_get_sqe(ring);
+    sqe->opcode = IORING_OP_OPENAT;
+    sqe->fd = dir_fd;
+    sqe->addr = (uint64_t)(uintptr_t)name;
+    sqe->open_flags = O_RDONLY;
+    sqe->user_data = ((uint64_t)slot << OP_BITS) | OP_OPEN;
+}
+
+static void prep_read(Ring* const ring, const Slot* const s, const size_t slot) {
+    struct io_uring_sqe* const sqe = ring_get_sqe(ring);
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = s->fd;
+    sqe->addr = (uint64_t)(uintptr_t)(s->buf + s->len);
+    sqe->len = (uint32_t)(s->cap - s->len);
+    sqe->off = s->len;
+    sqe->user_data = ((uint64_t)slot << OP_BITS) | OP_READ;
+}
+
+static void prep_close(Ring* const ring, const int fd) {
+    struct io_uring_sqe* const sqe = ring_get_sqe(ring);
+    sqe->opcode = IORING_OP_CLOSE;
+    sqe->fd = fd;
+    sqe->user_data = OP_CLOSE;
+}
+
+/*
+ * Static helper: io_uring worker loop
+ *
+ * Keeps up to queue_depth files in flight. Each file goes OPENAT -> READ
+ * (repeated while the buffer fills) -> CLOSE; records are delivered as soon
+ * as the read finishes, and the slot is refilled without waiting for CLOSE.
+ * Ring entries are twice the queue depth so every slot plus one
+ * fire-and-forget CLOSE per slot always fits.
+ *
+ * @return 0 if the ring ran, -1 if io_uring is unavailable
+ */
+static int uring_worker_loop(DirJob* const job, const size_t queue_depth) {
+    Ring ring;
+    if (ring_init(&ring, (unsigned)(queue_depth * 2)) != 0) {
+        return -1;
+    }
+
+    Slot* const slots = calloc(queue_depth, sizeof(Slot));
+    if (slots == NULL) {
+        ring_free(&ring);
+        return -1;
+    }
+
+    pthread_mutex_lock(&job->lock);
+    job->stats.used_io_uring = 1;
+    pthread_mutex_unlock(&job->lock);
+
+    size_t in_flight = 0;   /* Ops awaiting completion (slots + closes) */
+    int more_files = 1;
+    int broken = 0;         /* Kernel rejected an opcode: finish via pread */
+
+    for (;;) {
+        /* Refill free slots */
+        for (size_t i = 0; i < queue_depth && more_files && !broken; i++) {
+            if (slots[i].busy) {
+                continue;
+            }
+            const size_t index = take_next_file(job);
+            if (index == NO_FILE) {
+                more_files = 0;
+                break;
+            }
+            slots[i].file = index;
+            slots[i].fd = -1;
+            slots[i].len = 0;
+            slots[i].busy = 1;
+            prep_open(&ring, job->dir_fd, job->names[index], i);
+            in_flight++;
+        }
+
+        if (in_flight == 0) {
+            break;
+        }
+        if (ring_submit(&ring, 1) != 0) {
+            broken = 1;
+            break;
+        }
+
+        /* Reap completions */
+        unsigned head = *ring.cq_head;
+        const unsigned tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++) {
+            const struct io_uring_cqe* const cqe = &ring.cqes[head & ring.cq_mask];
+            const unsigned op = (unsigned)(cqe->user_data & ((1u << OP_BITS) - 1));
+            const size_t i = (size_t)(cqe->user_data >> OP_BITS);
+            const int res = cqe->res;
+            in_flight--;
+
+            if (op == OP_CLOSE) {
+                continue;
+            }
+
+            Slot* const s = &slots[i];
+            if (res == -EINVAL || res == -EOPNOTSUPP) {
+                /* Opcode unsupported by this kernel: redo the file via pread */
+                broken = 1;
+                if (s->fd >= 0) {
+                    close(s->fd);
+                }
+                const long len = read_file_pread(job->dir_fd, job->names[s->file], &s->buf, &s->cap);
+                if (len >= 0) {
+                    deliver_file(job, s->file, s->buf, (size_t)len);
+                } else {
+                    record_failure(job);
+                }
+                s->busy = 0;
+                continue;
+            }
+
+            if (res < 0) {
+                record_failure(job);
+                if (op == OP_READ) {
+                    prep_close(&ring, s->fd);
+                    in_flight++;
+                }
+                s->busy = 0;
+                continue;
+            }
+
+            if (op == OP_OPEN) {
+                s->fd = res;
+            } else {
+                s->len += (size_t)res;
+                if (res == 0 || s->len < s->cap) {
+                    /* EOF: deliver, close asynchronously, free the slot */
+                    deliver_file(job, s->file, s->buf, s->len);
+                    prep_close(&ring, s->fd);
+                    in_flight++;
+                    s->busy = 0;
+                    continue;
+                }
+            }
+
+            /* Need (more) buffer space before the next read */
+            if (ensure_capacity(&s->buf, &s->cap, s->len + 1) != 0) {
+                pthread_mutex_lock(&job->lock);
+                job->error = POKER_ENOMEM;
+                pthread_mutex_unlock(&job->lock);
+                prep_close(&ring, s->fd);
+                in_flight++;
+                s->busy = 0;
+                continue;
+            }
+            prep_read(&ring, s, i);
+            in_flight++;
+        }
+        __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+    }
+
+    /* Publish any trailing CLOSE ops without waiting */
+    if (ring.to_submit > 0) {
+        ring_submit(&ring, 0);
+    }
+
+    /* Tearing down the ring cancels anything still pending before buffers go */
+    ring_free(&ring);
+
+    for (size_t i = 0; i < queue_depth; i++) {
+        Slot* const s = &slots[i];
+        if (s->busy) {
+            /* Stranded by a failed submit: finish the file via pread */
+            if (s->fd >= 0) {
+                close(s->fd);
+            }
+            const long len = read_file_pread(job->dir_fd, job->names[s->file], &s->buf, &s->cap);
+            if (len >= 0) {
+                deliver_file(job, s->file, s->buf, (size_t)len);
+            } else {
+                record_failure(job);
+            }
+        }
+        free(s->buf);
+    }
+    free(slots);
+
+    if (broken) {
+        pread_worker_loop(job);
+    }
+    return 0;
+}
+
+#endif /* HAVE_IO_URING */
+
+static void* dir_worker(void* const arg) {
+    DirWorker* const w = (DirWorker*)arg;
+
+#ifdef HAVE_IO_URING
+    if (w->use_io_uring && uring_worker_loop(w->job, w->queue_depth) == 0) {
+        return NULL;
+    }
+#endif
+
+    pread_worker_loop(w->job);
+    return NULL;
+}
+
+/* Static helper: qsort comparator for file names */
+static int name_compare(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/* Static helper: list regular, non-hidden files of an open directory */
+static int list_files(DIR* const dir, const int dir_fd, char*** const out_names,
+                      size_t* const out_count) {
+    char** names = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    const struct dirent* entry;
+
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        if (entry->d_type != DT_REG) {
+            /* Resolve unknown types and symlinks */
+            struct stat st;
+            if (entry->d_type == DT_DIR ||
+                fstatat(dir_fd, entry->d_name, &st, 0) != 0 || !S_ISREG(st.st_mode)) {
+                continue;
+            }
+        }
+
+        if (count == capacity) {
+            capacity = (capacity == 0) ? 256 : capacity * 2;
+            char** const grown = realloc(names, capacity * sizeof(char*));
+            if (grown == NULL) {
+                goto fail;
+            }
+            names = grown;
+        }
+        names[count] = strdup(entry->d_name);
+        if (names[count] == NULL) {
+            goto fail;
+        }
+        count++;
+    }
+
+    /* Sorted order keeps work assignment deterministic */
+    if (count > 1) {
+        qsort(names, count, sizeof(char*), name_compare);
+    }
+    *out_names = names;
+    *out_count = count;
+    return 0;
+
+fail:
+    for (size_t i = 0; i < count; i++) {
+        free(names[i]);
+    }
+    free(names);
+    return -1;
+}
+
+int history_load_directory(const char* const dir_path,
+                           const HistoryDirOptions* const options,
+                           const HistoryFileCallback callback,
+                           void* const user_data,
+                           HistoryDirStats* const out_stats) {
+    if (dir_path == NULL || callback == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    DIR* const dir = opendir(dir_path);
+    if (dir == NULL) {
+        poker_errno = POKER_ENOTFOUND;
+        return -1;
+    }
+
+    DirJob job;
+    memset(&job, 0, sizeof(job));
+    job.dir_fd = dirfd(dir);
+    job.callback = callback;
+    job.user_data = user_data;
+
+    if (list_files(dir, job.dir_fd, &job.names, &job.num_names) != 0) {
+        closedir(dir);
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+
+    size_t threads = resolve_thread_count(options != NULL ? options->num_threads : 0);
+    if (threads > job.num_names) {
+        threads = (job.num_names == 0) ? 1 : job.num_names;
+    }
+    size_t depth = (options != NULL && options->queue_depth > 0) ? options->queue_depth : DEFAULT_QUEUE_DEPTH;
+    if (depth > MAX_QUEUE_DEPTH) {
+        depth = MAX_QUEUE_DEPTH;
+    }
+
+    DirWorker* const workers = calloc(threads, sizeof(DirWorker));
+    int rc = 0;
+    if (workers == NULL || pthread_mutex_init(&job.lock, NULL) != 0) {
+        free(workers);
+        job.error = POKER_ENOMEM;
+    } else {
+        for (size_t i = 0; i < threads; i++) {
+            workers[i].job = &job;
+            workers[i].queue_depth = depth;
+            workers[i].use_io_uring = (options != NULL) ? options->use_io_uring : 1;
+        }
+        if (job.num_names > 0) {
+            run_threads(threads, dir_worker, workers, sizeof(DirWorker));
+        }
+        pthread_mutex_destroy(&job.lock);
+        free(workers);
+    }
+
+    if (job.error != POKER_EOK) {
+        poker_errno = job.error;
+        rc = -1;
+    }
+    if (out_stats != NULL) {
+        *out_stats = job.stats;
+    }
+
+    for (size_t i = 0; i < job.num_names; i++) {
+        free(job.names[i]);
+    }
+    free(job.names);
+    closedir(dir);
+    return rc;
+}
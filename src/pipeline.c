@@ -0,0 +1,559 @@
+/*
+ * pipeline.c - Staged batch pipeline runtime
+ * Bounded lock-free MPMC queues between stages, a fixed batch pool for
+ * backpressure and per-stage worker threads
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_pipeline.h"
+#include "threads.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Yields before a blocked worker parks on the queue's condition variable */
+#define SPIN_YIELDS 32
+
+/* Keeps producer and consumer counters on separate cache lines */
+#define CACHE_LINE 64
+
+/*
+ * One queue slot. seq tells producers and consumers whose turn the slot is
+ * (Vyukov bounded MPMC scheme): seq == pos means free for the producer at
+ * pos, seq == pos + 1 means filled for the consumer at pos.
+ */
+typedef struct {
+    size_t seq;
+    PipelineBatch* batch;
+} QueueCell;
+
+/*
+ * Bounded queue of batch pointers. Push and pop are lock-free; the mutex
+ * and condition variable are only touched by workers that have run out of
+ * work (or space) and by the threads that wake them.
+ */
+typedef struct {
+    QueueCell* cells;
+    size_t mask;
+    char pad0[CACHE_LINE];
+    size_t head;              /* Next push position */
+    char pad1[CACHE_LINE];
+    size_t tail;              /* Next pop position */
+    char pad2[CACHE_LINE];
+    int closed;               /* No more pushes will happen */
+    int waiters;              /* Workers parked or about to park */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} BatchQueue;
+
+/* Shared run state */
+typedef struct {
+    const PipelineStage* stages;
+    size_t num_stages;
+    BatchQueue queues[PIPELINE_MAX_STAGES];  /* queues[i]: stage i -> i + 1 */
+    BatchQueue free_list;                    /* Empty batches for the source */
+    size_t live[PIPELINE_MAX_STAGES];        /* Workers still running per stage */
+    uint64_t next_sequence;
+    int stop;
+    int error;
+} Pipeline;
+
+/* Per-worker arguments and statistics */
+typedef struct {
+    Pipeline* pipeline;
+    size_t stage;
+    size_t worker;
+    uint64_t batches;
+    uint64_t records;
+    double busy_sec;
+    double wait_sec;
+} PipelineWorker;
+
+/* Static helper: monotonic time in seconds */
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* Static helper: smallest power of two >= n (n >= 1) */
+static size_t round_pow2(const size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+static int queue_init(BatchQueue* const q, const size_t capacity) {
+    memset(q, 0, sizeof(*q));
+    const size_t size = round_pow2(capacity);
+    q->cells = malloc(size * sizeof(QueueCell));
+    if (q->cells == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i < size; i++) {
+        q->cells[i].seq = i;
+        q->cells[i].batch = NULL;
+    }
+    q->mask = size - 1;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->cond, NULL);
+    return 0;
+}
+
+static void queue_destroy(BatchQueue* const q) {
+    if (q->cells != NULL) {
+        free(q->cells);
+        q->cells = NULL;
+        pthread_mutex_destroy(&q->lock);
+        pthread_cond_destroy(&q->cond);
+    }
+}
+
+/* Static helper: lock-free push; 0 if the queue is full */
+static int queue_try_push(BatchQueue* const q, PipelineBatch* const batch) {
+    size_t pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    QueueCell* cell;
+
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        const size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&q->head, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+        }
+    }
+
+    cell->batch = batch;
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/* Static helper: lock-free pop; NULL if the queue is empty */
+static PipelineBatch* queue_try_pop(BatchQueue* const q) {
+    size_t pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    QueueCell* cell;
+
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        const size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&q->tail, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return NULL;
+        } else {
+            pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    PipelineBatch* const batch = cell->batch;
+    __atomic_store_n(&cell->seq, pos + q->mask + 1, __ATOMIC_RELEASE);
+    return batch;
+}
+
+/*
+ * Static helper: wake parked workers after a push, pop, close or stop
+ *
+ * The full fence orders the queue update before the waiters check; a
+ * parking worker increments waiters and re-checks the queue under the
+ * lock, so either it sees the update or this sees it waiting.
+ */
+static void queue_wake(BatchQueue* const q) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&q->waiters, __ATOMIC_RELAXED) > 0) {
+        pthread_mutex_lock(&q->lock);
+        pthread_cond_broadcast(&q->cond);
+        pthread_mutex_unlock(&q->lock);
+    }
+}
+
+static int is_stopped(Pipeline* const p) {
+    return __atomic_load_n(&p->stop, __ATOMIC_ACQUIRE);
+}
+
+/* Static helper: stop every worker; error is POKER_EOK for an early stop */
+static void stop_pipeline(Pipeline* const p, const int error) {
+    if (error != POKER_EOK) {
+        int expected = POKER_EOK;
+        __atomic_compare_exchange_n(&p->error, &expected, error, 0,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&p->stop, 1, __ATOMIC_RELEASE);
+    for (size_t i = 0; i + 1 < p->num_stages; i++) {
+        queue_wake(&p->queues[i]);
+    }
+    queue_wake(&p->free_list);
+}
+
+/*
+ * Static helper: push, blocking while the queue is full
+ * @return 0 on success, -1 if the pipeline stopped first
+ */
+static int queue_push(Pipeline* const p, BatchQueue* const q, PipelineBatch* const batch,
+                      double* const wait_sec) {
+    if (queue_try_push(q, batch)) {
+        queue_wake(q);
+        return 0;
+    }
+
+    const double start = now_sec();
+    int pushed = 0;
+    for (unsigned spins = 0; !pushed && !is_stopped(p); spins++) {
+        if (spins < SPIN_YIELDS) {
+            sched_yield();
+            pushed = queue_try_push(q, batch);
+            continue;
+        }
+        pthread_mutex_lock(&q->lock);
+        __atomic_fetch_add(&q->waiters, 1, __ATOMIC_SEQ_CST);
+        pushed = queue_try_push(q, batch);
+        if (!pushed && !is_stopped(p)) {
+            pthread_cond_wait(&q->cond, &q->lock);
+        }
+        __atomic_fetch_sub(&q->waiters, 1, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&q->lock);
+    }
+    *wait_sec += now_sec() - start;
+
+    if (!pushed) {
+        return -1;
+    }
+    queue_wake(q);
+    return 0;
+}
+
+/*
+ * Static helper: pop, blocking while the queue is empty
+ * @return Batch, or NULL once the queue is closed and drained or the
+ *         pipeline stopped
+ */
+static PipelineBatch* queue_pop(Pipeline* const p, BatchQueue* const q, double* const wait_sec) {
+    PipelineBatch* batch = queue_try_pop(q);
+    if (batch != NULL) {
+        queue_wake(q);
+        return batch;
+    }
+
+    const double start = now_sec();
+    for (unsigned spins = 0; batch == NULL && !is_stopped(p); spins++) {
+        const int closed = __atomic_load_n(&q->closed, __ATOMIC_ACQUIRE);
+        batch = queue_try_pop(q);
+        if (batch != NULL || closed) {
+            break;
+        }
+        if (spins < SPIN_YIELDS) {
+            sched_yield();
+            continue;
+        }
+        pthread_mutex_lock(&q->lock);
+        __atomic_fetch_add(&q->waiters, 1, __ATOMIC_SEQ_CST);
+        batch = queue_try_pop(q);
+        if (batch == NULL && !is_stopped(p) && !__atomic_load_n(&q->closed, __ATOMIC_ACQUIRE)) {
+            pthread_cond_wait(&q->cond, &q->lock);
+        }
+        __atomic_fetch_sub(&q->waiters, 1, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&q->lock);
+    }
+    *wait_sec += now_sec() - start;
+
+    if (batch != NULL) {
+        queue_wake(q);
+    }
+    return batch;
+}
+
+/* Static helper: run a stage function, recording busy time */
+static int call_stage(PipelineWorker* const w, PipelineBatch* const batch) {
+    const PipelineStage* const stage = &w->pipeline->stages[w->stage];
+    const double start = now_sec();
+    poker_errno = POKER_EOK;
+    const int rc = stage->fn(batch, stage->context, w->worker);
+    w->busy_sec += now_sec() - start;
+    if (rc < 0) {
+        stop_pipeline(w->pipeline, (poker_errno != POKER_EOK) ? poker_errno : POKER_EINVAL);
+    }
+    return rc;
+}
+
+/* Static helper: source loop; fills free batches until input runs out */
+static void run_source(PipelineWorker* const w) {
+    Pipeline* const p = w->pipeline;
+
+    for (;;) {
+        PipelineBatch* const batch = queue_pop(p, &p->free_list, &w->wait_sec);
+        if (batch == NULL) {
+            break;
+        }
+
+        batch->count = 0;
+        const int rc = call_stage(w, batch);
+        if (rc < 0) {
+            break;
+        }
+        if (batch->count > batch->capacity) {
+            stop_pipeline(p, POKER_ERANGE);
+            break;
+        }
+
+        if (batch->count > 0) {
+            batch->sequence = __atomic_fetch_add(&p->next_sequence, 1, __ATOMIC_RELAXED);
+            w->batches++;
+            w->records += batch->count;
+            if (queue_push(p, &p->queues[0], batch, &w->wait_sec) != 0) {
+                break;
+            }
+        } else if (queue_push(p, &p->free_list, batch, &w->wait_sec) != 0) {
+            break;
+        }
+
+        if (rc == PIPELINE_DONE) {
+            break;
+        }
+    }
+}
+
+/* Static helper: transform/aggregate loop; last stage recycles batches */
+static void run_stage(PipelineWorker* const w) {
+    Pipeline* const p = w->pipeline;
+    BatchQueue* const in = &p->queues[w->stage - 1];
+    BatchQueue* const out = (w->stage + 1 < p->num_stages) ? &p->queues[w->stage] : &p->free_list;
+
+    for (;;) {
+        PipelineBatch* const batch = queue_pop(p, in, &w->wait_sec);
+        if (batch == NULL) {
+            break;
+        }
+
+        const int rc = call_stage(w, batch);
+        if (rc < 0) {
+            break;
+        }
+        w->batches++;
+        w->records += batch->count;
+        if (rc == PIPELINE_DONE) {
+            stop_pipeline(p, POKER_EOK);
+            break;
+        }
+        if (queue_push(p, out, batch, &w->wait_sec) != 0) {
+            break;
+        }
+    }
+}
+
+static void* pipeline_worker(void* const arg) {
+    PipelineWorker* const w = (PipelineWorker*)arg;
+    Pipeline* const p = w->pipeline;
+
+    if (w->stage == 0) {
+        run_source(w);
+    } else {
+        run_stage(w);
+    }
+
+    /* The last worker out of a stage closes its output queue */
+    if (__atomic_sub_fetch(&p->live[w->stage], 1, __ATOMIC_ACQ_REL) == 0 &&
+        w->stage + 1 < p->num_stages) {
+        __atomic_store_n(&p->queues[w->stage].closed, 1, __ATOMIC_RELEASE);
+        queue_wake(&p->queues[w->stage]);
+    }
+    return NULL;
+}
+
+int pipeline_run(const PipelineStage* const stages, const size_t num_stages,
+                 const PipelineOptions* const options, PipelineStats* const out_stats) {
+    if (stages == NULL || num_stages < 2 || num_stages > PIPELINE_MAX_STAGES) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    size_t threads[PIPELINE_MAX_STAGES];
+    size_t total_threads = 0;
+    for (size_t s = 0; s < num_stages; s++) {
+        if (stages[s].fn == NULL) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+        threads[s] = (stages[s].num_threads == 0) ? 1 : stages[s].num_threads;
+        total_threads += threads[s];
+        if (threads[s] > MAX_WORKER_THREADS || total_threads > MAX_WORKER_THREADS) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+    }
+
+    const size_t batch_size = (options != NULL && options->batch_size != 0)
+                                  ? options->batch_size : PIPELINE_DEFAULT_BATCH_SIZE;
+    const size_t scratch_size = (options != NULL) ? (options->scratch_size + 15) & ~(size_t)15 : 0;
+    if (batch_size > SIZE_MAX / (sizeof(HandRecord) + MAX_PLAYERS * sizeof(HandValue)) ||
+        scratch_size < ((options != NULL) ? options->scratch_size : 0)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    Pipeline p;
+    memset(&p, 0, sizeof(p));
+    p.stages = stages;
+    p.num_stages = num_stages;
+
+    /* Queues, then a pool big enough to fill all of them plus one batch per worker */
+    size_t pool_size = total_threads;
+    int ok = 1;
+    for (size_t i = 0; i + 1 < num_stages && ok; i++) {
+        const size_t capacity = (options != NULL && options->queue_capacity != 0)
+                                    ? options->queue_capacity
+                                    : 2 * (threads[i] + threads[i + 1]);
+        ok = (queue_init(&p.queues[i], capacity) == 0);
+        pool_size += ok ? p.queues[i].mask + 1 : 0;
+    }
+    ok = ok && (queue_init(&p.free_list, pool_size) == 0);
+
+    PipelineBatch* const pool = ok ? calloc(pool_size, sizeof(PipelineBatch)) : NULL;
+    HandRecord* const records = (pool != NULL) ? malloc(pool_size * batch_size * sizeof(HandRecord)) : NULL;
+    HandValue* const values = (records != NULL)
+                                  ? malloc(pool_size * batch_size * MAX_PLAYERS * sizeof(HandValue))
+                                  : NULL;
+    char* const scratch = (values != NULL && scratch_size != 0) ? malloc(pool_size * scratch_size) : NULL;
+    const int scratch_ok = (values != NULL) && (scratch_size == 0 || scratch != NULL);
+    PipelineWorker* const workers = scratch_ok ? calloc(total_threads, sizeof(PipelineWorker)) : NULL;
+    pthread_t* const handles = (workers != NULL) ? malloc(total_threads * sizeof(pthread_t)) : NULL;
+
+    int result = 0;
+    if (handles == NULL) {
+        poker_errno = POKER_ENOMEM;
+        result = -1;
+        goto cleanup;
+    }
+
+    for (size_t b = 0; b < pool_size; b++) {
+        pool[b].records = records + b * batch_size;
+        pool[b].values = values + b * batch_size * MAX_PLAYERS;
+        pool[b].scratch = (scratch != NULL) ? scratch + b * scratch_size : NULL;
+        pool[b].capacity = batch_size;
+        queue_try_push(&p.free_list, &pool[b]);
+    }
+
+    size_t w = 0;
+    for (size_t s = 0; s < num_stages; s++) {
+        p.live[s] = threads[s];
+        for (size_t t = 0; t < threads[s]; t++, w++) {
+            workers[w].pipeline = &p;
+            workers[w].stage = s;
+            workers[w].worker = t;
+        }
+    }
+
+    /* Every worker needs its own thread: stages block on one another */
+    const double start = now_sec();
+    size_t started = 0;
+    while (started < total_threads &&
+           pthread_create(&handles[started], NULL, pipeline_worker, &workers[started]) == 0) {
+        started++;
+    }
+    if (started < total_threads) {
+        stop_pipeline(&p, POKER_ENOMEM);
+    }
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(handles[i], NULL);
+    }
+    const double elapsed = now_sec() - start;
+
+    if (p.error != POKER_EOK) {
+        poker_errno = p.error;
+        result = -1;
+    }
+
+    if (out_stats != NULL) {
+        memset(out_stats, 0, sizeof(*out_stats));
+        out_stats->elapsed_sec = elapsed;
+        out_stats->num_stages = num_stages;
+        out_stats->pool_batches = pool_size;
+        for (size_t s = 0; s < num_stages; s++) {
+            out_stats->stages[s].name = stages[s].name;
+            out_stats->stages[s].num_threads = threads[s];
+        }
+        for (size_t i = 0; i < started; i++) {
+            PipelineStageStats* const st = &out_stats->stages[workers[i].stage];
+            st->batches += workers[i].batches;
+            st->records += workers[i].records;
+            st->busy_sec += workers[i].busy_sec;
+            st->wait_sec += workers[i].wait_sec;
+        }
+        for (size_t s = 0; s < num_stages; s++) {
+            PipelineStageStats* const st = &out_stats->stages[s];
+            st->records_per_sec = (elapsed > 0) ? (double)st->records / elapsed : 0;
+        }
+    }
+
+cleanup:
+    free(handles);
+    free(workers);
+    free(scratch);
+    free(values);
+    free(records);
+    free(pool);
+    for (size_t i = 0; i + 1 < num_stages; i++) {
+        queue_destroy(&p.queues[i]);
+    }
+    queue_destroy(&p.free_list);
+    return result;
+}
+
+int pipeline_array_source(PipelineBatch* batch, void* context, size_t worker) {
+    PipelineArraySource* const source = (PipelineArraySource*)context;
+    (void)worker;
+
+    const size_t start = __atomic_fetch_add(&source->next, batch->capacity, __ATOMIC_RELAXED);
+    if (start >= source->count) {
+        return PIPELINE_DONE;
+    }
+
+    const size_t n = (source->count - start < batch->capacity) ? source->count - start
+                                                               : batch->capacity;
+    memcpy(batch->records, source->records + start, n * sizeof(HandRecord));
+    batch->count = n;
+    return (start + n >= source->count) ? PIPELINE_DONE : 0;
+}
+
+int pipeline_evaluate_stage(PipelineBatch* batch, void* context, size_t worker) {
+    (void)context;
+    (void)worker;
+
+    for (size_t i = 0; i < batch->count; i++) {
+        const HandRecord* const rec = &batch->records[i];
+        HandValue* const out = &batch->values[i * MAX_PLAYERS];
+
+        uint64_t board = 0;
+        for (size_t b = 0; b < rec->board_len && b < BOARD_SIZE; b++) {
+            if (rec->board[b] < DECK_SIZE) {
+                board |= UINT64_C(1) << rec->board[b];
+            }
+        }
+
+        for (size_t pl = 0; pl < MAX_PLAYERS; pl++) {
+            const uint8_t c0 = rec->hole[pl][0];
+            const uint8_t c1 = rec->hole[pl][1];
+            if (pl >= rec->num_players || rec->board_len < 3 || c0 >= DECK_SIZE || c1 >= DECK_SIZE) {
+                out[pl] = 0;
+                continue;
+            }
+            out[pl] = evaluate_mask(board | (UINT64_C(1) << c0) | (UINT64_C(1) << c1));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,426 @@
+/*
+ * preflop.c - Exact preflop equity matrix
+ * Board-class enumeration with per-matchup-class totals, and lookups
+ */
+
+#include "../include/poker_preflop.h"
+#include "../include/poker_boardrank.h"
+#include "../include/poker_handindex.h"
+#include "threads.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* File structure sizes */
+#define FILE_HEADER_SIZE 16
+#define CLASS_ENTRY_SIZE 8
+
+/* Suit renamings */
+#define NUM_PERMUTATIONS 24
+
+/* Cells of the full matrix */
+#define MATRIX_CELLS ((size_t)HOLE_COMBOS * HOLE_COMBOS)
+
+/* Key of cells whose combos share a card */
+#define NO_CLASS UINT32_MAX
+
+static const uint8_t FILE_MAGIC[4] = {'P', 'E', 'Q', 'M'};
+
+struct PreflopEquity {
+    size_t num_classes;
+    uint32_t* keys;               /* Ascending */
+    uint32_t* scores;
+};
+
+/* Little-endian helpers for the file */
+static void put_u32(uint8_t* const p, const uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const uint8_t* const p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* The 24 permutations of the four suits */
+static void suit_permutations(uint8_t perms[NUM_PERMUTATIONS][4]) {
+    size_t n = 0;
+    for (uint8_t a = 0; a < 4; a++) {
+        for (uint8_t b = 0; b < 4; b++) {
+            for (uint8_t c = 0; c < 4; c++) {
+                const uint8_t d = (uint8_t)(6 - a - b - c);
+                if (a != b && a != c && b != c && d != a && d != b && d != c) {
+                    perms[n][0] = a;
+                    perms[n][1] = b;
+                    perms[n][2] = c;
+                    perms[n][3] = d;
+                    n++;
+                }
+            }
+        }
+    }
+}
+
+static uint64_t permute_mask(const uint64_t mask, const uint8_t* const perm) {
+    uint64_t out = 0;
+    for (uint64_t rest = mask; rest != 0; rest &= rest - 1) {
+        const unsigned card = (unsigned)__builtin_ctzll(rest);
+        out |= UINT64_C(1) << ((card & ~3u) | perm[card & 3]);
+    }
+    return out;
+}
+
+/* Static helper: class key of an ordered matchup (smallest over suit renamings) */
+static uint32_t matchup_key(const uint64_t hole, const uint64_t villain,
+                            uint8_t perms[NUM_PERMUTATIONS][4]) {
+    uint32_t key = NO_CLASS;
+    for (size_t p = 0; p < NUM_PERMUTATIONS; p++) {
+        const uint32_t a = (uint32_t)hole_combo_index(permute_mask(hole, perms[p]));
+        const uint32_t b = (uint32_t)hole_combo_index(permute_mask(villain, perms[p]));
+        const uint32_t candidate = a * HOLE_COMBOS + b;
+        key = (candidate < key) ? candidate : key;
+    }
+    return key;
+}
+
+/* Static helper: position of a key in an ascending array, or -1 */
+static long find_key(const uint32_t* const keys, const size_t count, const uint32_t key) {
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (keys[mid] < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return (low < count && keys[low] == key) ? (long)low : -1;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Builder                                                                  */
+/* ------------------------------------------------------------------------ */
+
+typedef struct {
+    const uint32_t* class_of;     /* MATRIX_CELLS class ids, num_classes where combos overlap */
+    size_t num_classes;
+    size_t begin;                 /* River board classes */
+    size_t end;
+    uint64_t* totals;             /* num_classes + 1 weighted half-point scores (last unused) */
+    int error;                    /* poker_errno of a failure, 0 if none */
+} BoardJob;
+
+/* Static helper: boards in the class of a board (24 over its symmetries) */
+static uint64_t board_weight(const uint64_t board, uint8_t perms[NUM_PERMUTATIONS][4]) {
+    uint64_t symmetries = 0;
+    for (size_t p = 0; p < NUM_PERMUTATIONS; p++) {
+        symmetries += (permute_mask(board, perms[p]) == board);
+    }
+    return NUM_PERMUTATIONS / symmetries;
+}
+
+static void* board_worker(void* arg) {
+    BoardJob* const job = arg;
+    uint8_t perms[NUM_PERMUTATIONS][4];
+    suit_permutations(perms);
+    BoardRanking* const ranking = malloc(sizeof(BoardRanking));
+    if (ranking == NULL) {
+        job->error = POKER_ENOMEM;
+    }
+
+    for (size_t b = job->begin; b < job->end && job->error == 0; b++) {
+        uint8_t cards[BOARD_SIZE];
+        if (board_unindex(HAND_INDEX_RIVER, b, cards) != 0) {
+            job->error = poker_errno;
+            break;
+        }
+        uint64_t board = 0;
+        for (size_t i = 0; i < BOARD_SIZE; i++) {
+            board |= UINT64_C(1) << cards[i];
+        }
+        if (board_ranking_build(board, ranking) != 0) {
+            job->error = poker_errno;
+            break;
+        }
+        const uint64_t weight = board_weight(board, perms);
+        const size_t n = ranking->num_combos;
+        const uint16_t* const order = ranking->order;
+
+        /*
+         * Each combo scores 2 against every weaker live combo and 1 per tie.
+         * Overlapping combos land in the spare last total, which keeps the
+         * inner loops free of branches.
+         */
+        size_t group_start = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (i > 0 && ranking->group_end[i - 1] == i) {
+                group_start = i;
+            }
+            const uint32_t* const row = job->class_of + (size_t)order[i] * HOLE_COMBOS;
+            for (size_t j = 0; j < group_start; j++) {
+                job->totals[row[order[j]]] += 2 * weight;
+            }
+            for (size_t j = group_start; j < ranking->group_end[i]; j++) {
+                job->totals[row[order[j]]] += weight;
+            }
+        }
+    }
+    free(ranking);
+    return NULL;
+}
+
+/* Static helper: write the class keys and scores */
+static int write_matrix(FILE* const file, const uint32_t* const keys,
+                        const uint32_t* const scores, const size_t num_classes) {
+    uint8_t header[FILE_HEADER_SIZE] = {0};
+    memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header[4] = PREFLOP_EQUITY_FORMAT_VERSION;
+    put_u32(header + 8, (uint32_t)num_classes);
+    put_u32(header + 12, PREFLOP_BOARDS);
+    int ok = fwrite(header, sizeof(header), 1, file) == 1;
+    for (size_t c = 0; c < num_classes && ok; c++) {
+        uint8_t entry[CLASS_ENTRY_SIZE];
+        put_u32(entry, keys[c]);
+        put_u32(entry + 4, scores[c]);
+        ok = fwrite(entry, sizeof(entry), 1, file) == 1;
+    }
+    return ok ? 0 : -1;
+}
+
+int preflop_equity_build(const char* const path, const size_t num_threads,
+                         PreflopEquityStats* const out_stats) {
+    if (path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    const size_t board_classes = (size_t)board_index_count(HAND_INDEX_RIVER);
+    if (board_classes == 0) {
+        return -1;
+    }
+    /* Opened first so an unwritable path fails before the enumeration */
+    FILE* const file = fopen(path, "wb");
+    if (file == NULL) {
+        poker_errno = POKER_EIO;
+        return -1;
+    }
+
+    /* Class of every ordered matchup, and matchups per class */
+    uint8_t perms[NUM_PERMUTATIONS][4];
+    suit_permutations(perms);
+    uint32_t* const class_of = malloc(MATRIX_CELLS * sizeof(uint32_t));
+    uint32_t* const keys = malloc(MATRIX_CELLS * sizeof(uint32_t));
+    if (class_of == NULL || keys == NULL) {
+        free(class_of);
+        free(keys);
+        fclose(file);
+        remove(path);
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    size_t num_keys = 0;
+    for (size_t a = 0; a < HOLE_COMBOS; a++) {
+        const uint64_t hole = hole_combo_mask(a);
+        for (size_t b = 0; b < HOLE_COMBOS; b++) {
+            const uint64_t villain = hole_combo_mask(b);
+            class_of[a * HOLE_COMBOS + b] =
+                (hole & villain) ? NO_CLASS : matchup_key(hole, villain, perms);
+            if (!(hole & villain) && class_of[a * HOLE_COMBOS + b] == a * HOLE_COMBOS + b) {
+                keys[num_keys++] = (uint32_t)(a * HOLE_COMBOS + b);
+            }
+        }
+    }
+    /* Keys were found in ascending order; map keys to class ids */
+    uint32_t* const sizes = calloc(num_keys, sizeof(uint32_t));
+    if (sizes == NULL) {
+        free(class_of);
+        free(keys);
+        fclose(file);
+        remove(path);
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    for (size_t cell = 0; cell < MATRIX_CELLS; cell++) {
+        if (class_of[cell] != NO_CLASS) {
+            class_of[cell] = (uint32_t)find_key(keys, num_keys, class_of[cell]);
+            sizes[class_of[cell]]++;
+        } else {
+            class_of[cell] = (uint32_t)num_keys;
+        }
+    }
+
+    const size_t threads = resolve_thread_count(num_threads);
+    const size_t jobs = (threads < board_classes) ? threads : board_classes;
+    BoardJob* const work = calloc(jobs, sizeof(BoardJob));
+    int error = (work == NULL) ? POKER_ENOMEM : 0;
+    for (size_t j = 0; j < jobs && error == 0; j++) {
+        work[j].class_of = class_of;
+        work[j].num_classes = num_keys;
+        work[j].begin = board_classes * j / jobs;
+        work[j].end = board_classes * (j + 1) / jobs;
+        work[j].totals = calloc(num_keys + 1, sizeof(uint64_t));
+        if (work[j].totals == NULL) {
+            error = POKER_ENOMEM;
+        }
+    }
+    if (error == 0) {
+        run_threads(jobs, board_worker, work, sizeof(BoardJob));
+        for (size_t j = 0; j < jobs && error == 0; j++) {
+            error = work[j].error;
+        }
+    }
+
+    /* Every matchup of a class has the same total */
+    uint32_t* const scores = (error == 0) ? malloc(num_keys * sizeof(uint32_t)) : NULL;
+    if (error == 0 && scores == NULL) {
+        error = POKER_ENOMEM;
+    }
+    for (size_t c = 0; c < num_keys && error == 0; c++) {
+        uint64_t total = 0;
+        for (size_t j = 0; j < jobs; j++) {
+            total += work[j].totals[c];
+        }
+        scores[c] = (uint32_t)(total / sizes[c]);
+    }
+    if (error == 0 && write_matrix(file, keys, scores, num_keys) != 0) {
+        error = POKER_EIO;
+    }
+    if (fclose(file) != 0 && error == 0) {
+        error = POKER_EIO;
+    }
+
+    for (size_t j = 0; work != NULL && j < jobs; j++) {
+        free(work[j].totals);
+    }
+    free(work);
+    free(scores);
+    free(sizes);
+    free(keys);
+    free(class_of);
+    if (error != 0) {
+        remove(path);
+        poker_errno = error;
+        return -1;
+    }
+    if (out_stats != NULL) {
+        out_stats->num_classes = num_keys;
+        out_stats->board_classes = board_classes;
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Lookups                                                                  */
+/* ------------------------------------------------------------------------ */
+
+PreflopEquity* preflop_equity_open(const char* const path) {
+    if (path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+    FILE* const file = fopen(path, "rb");
+    if (file == NULL) {
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+    uint8_t header[FILE_HEADER_SIZE];
+    if (fread(header, sizeof(header), 1, file) != 1 ||
+        memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        header[4] != PREFLOP_EQUITY_FORMAT_VERSION || get_u32(header + 12) != PREFLOP_BOARDS ||
+        get_u32(header + 8) == 0 || get_u32(header + 8) > MATRIX_CELLS) {
+        fclose(file);
+        poker_errno = POKER_EFORMAT;
+        return NULL;
+    }
+
+    PreflopEquity* const table = calloc(1, sizeof(PreflopEquity));
+    if (table == NULL) {
+        fclose(file);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    table->num_classes = get_u32(header + 8);
+    table->keys = malloc(table->num_classes * sizeof(uint32_t));
+    table->scores = malloc(table->num_classes * sizeof(uint32_t));
+    uint8_t* const data = malloc(table->num_classes * CLASS_ENTRY_SIZE);
+    int error = (table->keys == NULL || table->scores == NULL || data == NULL) ? POKER_ENOMEM : 0;
+    if (error == 0 && (fread(data, CLASS_ENTRY_SIZE, table->num_classes, file) != table->num_classes ||
+                       fgetc(file) != EOF)) {
+        error = POKER_EFORMAT;
+    }
+    for (size_t c = 0; c < table->num_classes && error == 0; c++) {
+        table->keys[c] = get_u32(data + c * CLASS_ENTRY_SIZE);
+        table->scores[c] = get_u32(data + c * CLASS_ENTRY_SIZE + 4);
+        if ((c > 0 && table->keys[c] <= table->keys[c - 1]) || table->keys[c] >= MATRIX_CELLS ||
+            table->scores[c] > 2 * PREFLOP_BOARDS) {
+            error = POKER_EFORMAT;
+        }
+    }
+    free(data);
+    fclose(file);
+    if (error != 0) {
+        preflop_equity_close(table);
+        poker_errno = error;
+        return NULL;
+    }
+    return table;
+}
+
+void preflop_equity_close(PreflopEquity* const table) {
+    if (table == NULL) {
+        return;
+    }
+    free(table->keys);
+    free(table->scores);
+    free(table);
+}
+
+int64_t preflop_equity_score(const PreflopEquity* const table, const uint64_t hole,
+                             const uint64_t villain) {
+    if (table == NULL || hole_combo_index(hole) < 0 || hole_combo_index(villain) < 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    if (hole & villain) {
+        poker_errno = POKER_EDUPLICATE;
+        return -1;
+    }
+    uint8_t perms[NUM_PERMUTATIONS][4];
+    suit_permutations(perms);
+    const long c = find_key(table->keys, table->num_classes, matchup_key(hole, villain, perms));
+    if (c < 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    return table->scores[c];
+}
+
+double preflop_equity(const PreflopEquity* const table, const uint64_t hole,
+                      const uint64_t villain) {
+    const int64_t score = preflop_equity_score(table, hole, villain);
+    return (score >= 0) ? (double)score / (2.0 * PREFLOP_BOARDS) : -1.0;
+}
+
+int preflop_equity_matrix(const PreflopEquity* const table, double* const out) {
+    if (table == NULL || out == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    uint8_t perms[NUM_PERMUTATIONS][4];
+    suit_permutations(perms);
+    for (size_t a = 0; a < HOLE_COMBOS; a++) {
+        const uint64_t hole = hole_combo_mask(a);
+        for (size_t b = 0; b < HOLE_COMBOS; b++) {
+            const uint64_t villain = hole_combo_mask(b);
+            const long c = (hole & villain)
+                               ? -1
+                               : find_key(table->keys, table->num_classes,
+                                          matchup_key(hole, villain, perms));
+            out[a * HOLE_COMBOS + b] =
+                (c >= 0) ? (double)table->scores[c] / (2.0 * PREFLOP_BOARDS) : 0.0;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,329 @@
+/*
+ * pushfold.c - Heads-up push/fold equilibrium solver
+ * Class-level exact equities and CFR+ over jam/call strategies
+ */
+
+#include "../include/poker_pushfold.h"
+#include "../include/poker_handindex.h"
+#include "threads.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Opposing combos a hole combo does not block */
+#define LIVE_COMBOS ((DECK_SIZE - 2) * (DECK_SIZE - 3) / 2)
+
+/* Ordered deals of two hands */
+#define DEALS ((double)HOLE_COMBOS * LIVE_COMBOS)
+
+struct PushFoldEquities {
+    uint32_t sizes[PUSHFOLD_CLASSES];                       /* Combos per class */
+    uint16_t combos[PUSHFOLD_CLASSES][PUSHFOLD_CLASSES];    /* Live villain combos per class */
+    int64_t scores[PUSHFOLD_CLASSES][PUSHFOLD_CLASSES];     /* Their summed half-point scores */
+};
+
+/* Static helper: preflop class of a hole combo */
+static size_t class_of_combo(const size_t combo) {
+    const uint64_t mask = hole_combo_mask(combo);
+    const uint8_t cards[HOLE_SIZE] = {(uint8_t)__builtin_ctzll(mask),
+                                      (uint8_t)(63 - __builtin_clzll(mask))};
+    uint64_t index = 0;
+    hand_index(cards, HOLE_SIZE, &index);
+    return (size_t)index;
+}
+
+PushFoldEquities* pushfold_equities_create(const PreflopEquity* const table) {
+    if (table == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+    PushFoldEquities* const equities = calloc(1, sizeof(PushFoldEquities));
+    if (equities == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    size_t classes[HOLE_COMBOS];
+    for (size_t combo = 0; combo < HOLE_COMBOS; combo++) {
+        classes[combo] = class_of_combo(combo);
+        equities->sizes[classes[combo]]++;
+    }
+
+    /* Every combo of a class sees the same counts, so one representative suffices */
+    for (size_t hero = 0; hero < PUSHFOLD_CLASSES; hero++) {
+        uint8_t cards[HOLE_SIZE];
+        hand_unindex(HAND_INDEX_PREFLOP, hero, cards);
+        const uint64_t hole = (UINT64_C(1) << cards[0]) | (UINT64_C(1) << cards[1]);
+        for (size_t combo = 0; combo < HOLE_COMBOS; combo++) {
+            const uint64_t villain = hole_combo_mask(combo);
+            if (villain & hole) {
+                continue;
+            }
+            const int64_t score = preflop_equity_score(table, hole, villain);
+            if (score < 0) {
+                pushfold_equities_destroy(equities);
+                poker_errno = POKER_EINVAL;
+                return NULL;
+            }
+            equities->combos[hero][classes[combo]]++;
+            equities->scores[hero][classes[combo]] += score;
+        }
+    }
+    return equities;
+}
+
+PushFoldEquities* pushfold_equities_load(const char* const path, const size_t num_threads) {
+    if (path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+    PreflopEquity* table = preflop_equity_open(path);
+    if (table == NULL && poker_errno == POKER_ENOTFOUND) {
+        if (preflop_equity_build(path, num_threads, NULL) != 0) {
+            return NULL;
+        }
+        table = preflop_equity_open(path);
+    }
+    if (table == NULL) {
+        return NULL;
+    }
+    PushFoldEquities* const equities = pushfold_equities_create(table);
+    preflop_equity_close(table);
+    return equities;
+}
+
+void pushfold_equities_destroy(PushFoldEquities* const equities) {
+    free(equities);
+}
+
+double pushfold_class_equity(const PushFoldEquities* const equities, const size_t hero,
+                             const size_t villain, size_t* const out_combos) {
+    if (equities == NULL || hero >= PUSHFOLD_CLASSES || villain >= PUSHFOLD_CLASSES) {
+        poker_errno = POKER_EINVAL;
+        return -1.0;
+    }
+    const size_t combos = equities->combos[hero][villain];
+    if (out_combos != NULL) {
+        *out_combos = combos;
+    }
+    return (combos > 0)
+               ? (double)equities->scores[hero][villain] / (2.0 * PREFLOP_BOARDS * combos)
+               : 0.0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Solver                                                                   */
+/* ------------------------------------------------------------------------ */
+
+/*
+ * Per-combo payoffs of one spot, summed over the live opposing combos of
+ * each class: called[x][y] is a combo of class x all-in against class y
+ * (2 * stack * equity - stack each), steal[x][y] what the small blind
+ * collects when those combos fold.
+ */
+typedef struct {
+    double called[PUSHFOLD_CLASSES][PUSHFOLD_CLASSES];
+    double steal[PUSHFOLD_CLASSES][PUSHFOLD_CLASSES];
+    double fold;                  /* Small blind's fold payoff summed over live combos */
+} SpotPayoffs;
+
+/* Static helper: validate a spot */
+static int valid_spot(const PushFoldSpot* const spot) {
+    return isfinite(spot->stack) && isfinite(spot->small_blind) && isfinite(spot->big_blind) &&
+           isfinite(spot->ante) && isfinite(spot->big_blind_ante) && spot->big_blind > 0.0 &&
+           spot->small_blind > 0.0 && spot->small_blind <= spot->big_blind &&
+           spot->ante >= 0.0 && spot->big_blind_ante >= 0.0 &&
+           spot->stack > spot->big_blind + spot->ante + spot->big_blind_ante;
+}
+
+static void spot_payoffs(const PushFoldEquities* const equities, const PushFoldSpot* const spot,
+                         SpotPayoffs* const payoffs) {
+    const double gain = spot->big_blind + spot->ante + spot->big_blind_ante;
+    for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+        for (size_t y = 0; y < PUSHFOLD_CLASSES; y++) {
+            const double combos = equities->combos[x][y];
+            payoffs->called[x][y] =
+                spot->stack * ((double)equities->scores[x][y] / PREFLOP_BOARDS - combos);
+            payoffs->steal[x][y] = gain * combos;
+        }
+    }
+    payoffs->fold = -(spot->small_blind + spot->ante) * LIVE_COMBOS;
+}
+
+/* Static helper: small blind's jam payoff per combo of each class */
+static void jam_values(const SpotPayoffs* const payoffs, const double* const call,
+                       double* const out) {
+    for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+        double value = 0.0;
+        for (size_t y = 0; y < PUSHFOLD_CLASSES; y++) {
+            value += payoffs->steal[x][y] + call[y] * (payoffs->called[x][y] - payoffs->steal[x][y]);
+        }
+        out[x] = value;
+    }
+}
+
+/* Static helper: big blind's call and fold payoffs per combo of each class */
+static void call_values(const SpotPayoffs* const payoffs, const double* const jam,
+                        double* const out_call, double* const out_fold) {
+    for (size_t y = 0; y < PUSHFOLD_CLASSES; y++) {
+        double call = 0.0;
+        double fold = 0.0;
+        for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+            call += jam[x] * payoffs->called[y][x];
+            fold -= jam[x] * payoffs->steal[y][x];
+        }
+        out_call[y] = call;
+        out_fold[y] = fold;
+    }
+}
+
+/* Static helper: regret matching+ update of one two-action decision per class */
+static void update_regrets(const double* const act, const double fold, const double* const fold_values,
+                           double* const regret_act, double* const regret_fold,
+                           double* const strategy) {
+    for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+        const double other = (fold_values != NULL) ? fold_values[x] : fold;
+        const double value = strategy[x] * act[x] + (1.0 - strategy[x]) * other;
+        regret_act[x] = fmax(regret_act[x] + act[x] - value, 0.0);
+        regret_fold[x] = fmax(regret_fold[x] + other - value, 0.0);
+        const double total = regret_act[x] + regret_fold[x];
+        strategy[x] = (total > 0.0) ? regret_act[x] / total : 0.5;
+    }
+}
+
+static void solve_spot(const PushFoldEquities* const equities, const PushFoldSpot* const spot,
+                       const size_t iterations, SpotPayoffs* const payoffs,
+                       PushFoldResult* const out) {
+    double jam[PUSHFOLD_CLASSES];
+    double call[PUSHFOLD_CLASSES];
+    double regrets[4][PUSHFOLD_CLASSES] = {{0.0}};
+    double jam_sum[PUSHFOLD_CLASSES] = {0.0};
+    double call_sum[PUSHFOLD_CLASSES] = {0.0};
+    double act[PUSHFOLD_CLASSES];
+    double fold[PUSHFOLD_CLASSES];
+
+    spot_payoffs(equities, spot, payoffs);
+    for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+        jam[x] = 0.5;
+        call[x] = 0.5;
+    }
+
+    /* Alternating updates; iteration t weighs t in the averages */
+    for (size_t t = 1; t <= iterations; t++) {
+        jam_values(payoffs, call, act);
+        update_regrets(act, payoffs->fold, NULL, regrets[0], regrets[1], jam);
+        call_values(payoffs, jam, act, fold);
+        update_regrets(act, 0.0, fold, regrets[2], regrets[3], call);
+        for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+            jam_sum[x] += (double)t * jam[x];
+            call_sum[x] += (double)t * call[x];
+        }
+    }
+    const double weight = (double)iterations * (double)(iterations + 1) / 2.0;
+    out->jam_share = 0.0;
+    out->call_share = 0.0;
+    for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+        out->jam[x] = jam_sum[x] / weight;
+        out->call[x] = call_sum[x] / weight;
+        out->jam_share += equities->sizes[x] * out->jam[x] / HOLE_COMBOS;
+        out->call_share += equities->sizes[x] * out->call[x] / HOLE_COMBOS;
+    }
+
+    /* Value and best responses of the averages, per deal */
+    jam_values(payoffs, out->call, act);
+    double value = 0.0;
+    double sb_best = 0.0;
+    double sb_folds = 0.0;
+    for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+        value += equities->sizes[x] *
+                 (out->jam[x] * act[x] + (1.0 - out->jam[x]) * payoffs->fold);
+        sb_best += equities->sizes[x] * fmax(act[x], payoffs->fold);
+        sb_folds += equities->sizes[x] * (1.0 - out->jam[x]) * payoffs->fold;
+    }
+    call_values(payoffs, out->jam, act, fold);
+    double bb_best = -sb_folds;
+    for (size_t y = 0; y < PUSHFOLD_CLASSES; y++) {
+        bb_best += equities->sizes[y] * fmax(act[y], fold[y]);
+    }
+    out->value = value / DEALS;
+    out->exploitability = (sb_best + bb_best) / (2.0 * DEALS);
+}
+
+typedef struct {
+    const PushFoldEquities* equities;
+    const PushFoldSpot* spots;
+    size_t iterations;
+    size_t begin;
+    size_t end;
+    PushFoldResult* out;
+    int error;                    /* poker_errno of a failure, 0 if none */
+} SpotJob;
+
+static void* spot_worker(void* arg) {
+    SpotJob* const job = arg;
+    SpotPayoffs* const payoffs = malloc(sizeof(SpotPayoffs));
+    if (payoffs == NULL) {
+        job->error = POKER_ENOMEM;
+        return NULL;
+    }
+    for (size_t s = job->begin; s < job->end; s++) {
+        solve_spot(job->equities, &job->spots[s], job->iterations, payoffs, &job->out[s]);
+    }
+    free(payoffs);
+    return NULL;
+}
+
+int pushfold_solve(const PushFoldEquities* const equities, const PushFoldSpot* const spots,
+                   const size_t count, const size_t iterations, const size_t num_threads,
+                   PushFoldResult* const out) {
+    if (equities == NULL || (count > 0 && (spots == NULL || out == NULL)) || iterations == 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    for (size_t s = 0; s < count; s++) {
+        if (!valid_spot(&spots[s])) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    const size_t threads = resolve_thread_count(num_threads);
+    const size_t jobs = (threads < count) ? threads : count;
+    SpotJob* const work = calloc(jobs, sizeof(SpotJob));
+    if (work == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    for (size_t j = 0; j < jobs; j++) {
+        work[j].equities = equities;
+        work[j].spots = spots;
+        work[j].iterations = iterations;
+        work[j].begin = count * j / jobs;
+        work[j].end = count * (j + 1) / jobs;
+        work[j].out = out;
+    }
+    run_threads(jobs, spot_worker, work, sizeof(SpotJob));
+    int error = 0;
+    for (size_t j = 0; j < jobs && error == 0; j++) {
+        error = work[j].error;
+    }
+    free(work);
+    if (error != 0) {
+        poker_errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+int pushfold_expand(const double* const class_values, double* const out) {
+    if (class_values == NULL || out == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    for (size_t combo = 0; combo < HOLE_COMBOS; combo++) {
+        out[combo] = class_values[class_of_combo(combo)];
+    }
+    return 0;
+}
@@ -0,0 +1,964 @@
+/*
+ * records.c - Compact binary hand-record files
+ * Bit-packs HandRecords with 6-bit cards into checksummed, optionally
+ * LZ-compressed blocks, with a trailing block index for random access
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_records.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* On-disk structure sizes */
+#define FILE_HEADER_SIZE  16
+#define BLOCK_HEADER_SIZE 20
+#define INDEX_ENTRY_SIZE  40
+#define TRAILER_SIZE      24
+
+/* Worst-case encoded record: 4+4+3 + 2x10 masks + 10x13 hole + 5x6 board + 7+64 id */
+#define MAX_RECORD_BITS  262
+#define MAX_RECORD_BYTES ((MAX_RECORD_BITS + 7) / 8)
+
+/* Upper bound on records per block, keeps block sizes within u32 */
+#define MAX_BLOCK_RECORDS (1u << 20)
+
+/* 6-bit and 4-bit codes for absent cards / players */
+#define CARD_CODE_NONE 63u
+#define HERO_CODE_NONE 15u
+
+/* LZ codec parameters */
+#define LZ_MIN_MATCH  4
+#define LZ_HASH_BITS  12
+#define LZ_MAX_OFFSET 65535u
+
+static const uint8_t FILE_MAGIC[4] = {'P', 'H', 'R', 'B'};
+static const uint8_t TRAILER_MAGIC[4] = {'P', 'H', 'R', 'I'};
+
+/* ------------------------------------------------------------------------ */
+/* Little-endian helpers                                                    */
+/* ------------------------------------------------------------------------ */
+
+static void put_u16(uint8_t* const p, const uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t* const p, const uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static void put_u64(uint8_t* const p, const uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint16_t get_u16(const uint8_t* const p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* const p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_u64(const uint8_t* const p) {
+    return (uint64_t)get_u32(p) | ((uint64_t)get_u32(p + 4) << 32);
+}
+
+/* Static helper: 32-bit FNV-1a checksum */
+static uint32_t fnv1a(const uint8_t* const data, const size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Bit packing                                                              */
+/* ------------------------------------------------------------------------ */
+
+/* LSB-first bit writer over a caller-sized buffer */
+typedef struct {
+    uint8_t* data;
+    size_t pos;
+    uint64_t acc;
+    unsigned bits;
+} BitWriter;
+
+/* LSB-first bit reader; reading past the end yields zeros and sets overrun */
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    uint64_t acc;
+    unsigned bits;
+    int overrun;
+} BitReader;
+
+/* Static helper: append the low n bits of value (n <= 32) */
+static void bits_put(BitWriter* const w, const uint64_t value, const unsigned n) {
+    w->acc |= (value & ((UINT64_C(1) << n) - 1)) << w->bits;
+    w->bits += n;
+    while (w->bits >= 8) {
+        w->data[w->pos++] = (uint8_t)w->acc;
+        w->acc >>= 8;
+        w->bits -= 8;
+    }
+}
+
+/* Static helper: append the low n bits of value (n <= 64) */
+static void bits_put64(BitWriter* const w, const uint64_t value, const unsigned n) {
+    if (n > 32) {
+        bits_put(w, value, 32);
+        bits_put(w, value >> 32, n - 32);
+    } else {
+        bits_put(w, value, n);
+    }
+}
+
+/* Static helper: pad to a byte boundary and return the byte length */
+static size_t bits_finish(BitWriter* const w) {
+    if (w->bits > 0) {
+        w->data[w->pos++] = (uint8_t)w->acc;
+    }
+    w->acc = 0;
+    w->bits = 0;
+    return w->pos;
+}
+
+/* Static helper: read n bits (n <= 32) */
+static uint32_t bits_get(BitReader* const r, const unsigned n) {
+    if (r->bits < n) {
+        /* Refill a word at a time when possible */
+        if (r->size - r->pos >= 4) {
+            r->acc |= (uint64_t)get_u32(r->data + r->pos) << r->bits;
+            r->pos += 4;
+            r->bits += 32;
+        } else {
+            while (r->bits < n) {
+                if (r->pos < r->size) {
+                    r->acc |= (uint64_t)r->data[r->pos++] << r->bits;
+                } else {
+                    r->overrun = 1;
+                }
+                r->bits += 8;
+            }
+        }
+    }
+    const uint32_t value = (uint32_t)(r->acc & ((UINT64_C(1) << n) - 1));
+    r->acc >>= n;
+    r->bits -= n;
+    return value;
+}
+
+/* Static helper: read n bits (n <= 64) */
+static uint64_t bits_get64(BitReader* const r, const unsigned n) {
+    if (n > 32) {
+        const uint64_t low = bits_get(r, 32);
+        return low | ((uint64_t)bits_get(r, n - 32) << 32);
+    }
+    return bits_get(r, n);
+}
+
+/* Static helper: check a record fits the encoding before writing any bits */
+static int record_is_encodable(const HandRecord* const rec) {
+    const unsigned np = rec->num_players;
+
+    if (np > MAX_PLAYERS || rec->board_len > BOARD_SIZE) {
+        return 0;
+    }
+    if (rec->hero != PLAYER_NONE && rec->hero >= np) {
+        return 0;
+    }
+    if ((rec->showdown_mask >> np) != 0 || (rec->winner_mask >> np) != 0) {
+        return 0;
+    }
+    for (unsigned p = 0; p < np; p++) {
+        for (unsigned c = 0; c < HOLE_SIZE; c++) {
+            if (rec->hole[p][c] >= DECK_SIZE && rec->hole[p][c] != CARD_INDEX_NONE) {
+                return 0;
+            }
+        }
+    }
+    for (unsigned b = 0; b < rec->board_len; b++) {
+        if (rec->board[b] >= DECK_SIZE) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Static helper: bit-pack one validated record */
+static void encode_record(BitWriter* const w, const HandRecord* const rec,
+                          uint64_t* const prev_id) {
+    const unsigned np = rec->num_players;
+
+    bits_put(w, np, 4);
+    bits_put(w, (rec->hero == PLAYER_NONE) ? HERO_CODE_NONE : rec->hero, 4);
+    bits_put(w, rec->board_len, 3);
+    bits_put(w, rec->showdown_mask, np);
+    bits_put(w, rec->winner_mask, np);
+
+    for (unsigned p = 0; p < np; p++) {
+        const uint8_t c0 = rec->hole[p][0];
+        const uint8_t c1 = rec->hole[p][1];
+        if (c0 == CARD_INDEX_NONE && c1 == CARD_INDEX_NONE) {
+            bits_put(w, 0, 1);
+        } else {
+            bits_put(w, 1, 1);
+            bits_put(w, (c0 == CARD_INDEX_NONE) ? CARD_CODE_NONE : c0, 6);
+            bits_put(w, (c1 == CARD_INDEX_NONE) ? CARD_CODE_NONE : c1, 6);
+        }
+    }
+    for (unsigned b = 0; b < rec->board_len; b++) {
+        bits_put(w, rec->board[b], 6);
+    }
+
+    /* Zigzag delta: sequential ids cost 9 bits */
+    const uint64_t delta = rec->hand_id - *prev_id;
+    const uint64_t zigzag = (delta << 1) ^ (UINT64_C(0) - (delta >> 63));
+    unsigned length = 0;
+    while (length < 64 && (zigzag >> length) != 0) {
+        length++;
+    }
+    bits_put(w, length, 7);
+    bits_put64(w, zigzag, length);
+    *prev_id = rec->hand_id;
+}
+
+/* Static helper: decode one record, 0 on success or -1 if malformed */
+static int decode_record(BitReader* const r, HandRecord* const rec,
+                         uint64_t* const prev_id) {
+    memset(rec, 0, sizeof(*rec));
+    memset(rec->hole, CARD_INDEX_NONE, sizeof(rec->hole));
+
+    const unsigned np = bits_get(r, 4);
+    const unsigned hero = bits_get(r, 4);
+    const unsigned board_len = bits_get(r, 3);
+    if (np > MAX_PLAYERS || board_len > BOARD_SIZE ||
+        (hero != HERO_CODE_NONE && hero >= np)) {
+        return -1;
+    }
+    rec->num_players = (uint8_t)np;
+    rec->hero = (hero == HERO_CODE_NONE) ? PLAYER_NONE : (uint8_t)hero;
+    rec->board_len = (uint8_t)board_len;
+    rec->showdown_mask = (uint16_t)bits_get(r, np);
+    rec->winner_mask = (uint16_t)bits_get(r, np);
+
+    for (unsigned p = 0; p < np; p++) {
+        if (bits_get(r, 1)) {
+            const uint32_t pair = bits_get(r, 12);  /* Both cards in one read */
+            for (unsigned c = 0; c < HOLE_SIZE; c++) {
+                const unsigned code = (pair >> (6 * c)) & 63u;
+                if (code >= DECK_SIZE && code != CARD_CODE_NONE) {
+                    return -1;
+                }
+                rec->hole[p][c] = (code == CARD_CODE_NONE) ? CARD_INDEX_NONE : (uint8_t)code;
+            }
+        }
+    }
+    const uint32_t board = bits_get(r, 6 * board_len);  /* At most 30 bits */
+    for (unsigned b = 0; b < board_len; b++) {
+        const unsigned code = (board >> (6 * b)) & 63u;
+        if (code >= DECK_SIZE) {
+            return -1;
+        }
+        rec->board[b] = (uint8_t)code;
+    }
+
+    const unsigned length = bits_get(r, 7);
+    if (length > 64) {
+        return -1;
+    }
+    const uint64_t zigzag = bits_get64(r, length);
+    const uint64_t delta = (zigzag >> 1) ^ (UINT64_C(0) - (zigzag & 1));
+    rec->hand_id = *prev_id + delta;
+    *prev_id = rec->hand_id;
+    return r->overrun ? -1 : 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* LZ block codec (LZ4-style sequences: token, literals, offset, match)     */
+/* ------------------------------------------------------------------------ */
+
+/* Static helper: write an LZ length extension (runs of 255) */
+static int lz_put_length(uint8_t* const dst, const size_t cap, size_t* const op, size_t len) {
+    while (len >= 255) {
+        if (*op >= cap) {
+            return -1;
+        }
+        dst[(*op)++] = 255;
+        len -= 255;
+    }
+    if (*op >= cap) {
+        return -1;
+    }
+    dst[(*op)++] = (uint8_t)len;
+    return 0;
+}
+
+/* Static helper: emit one sequence; match_len 0 marks the final literals */
+static int lz_emit(uint8_t* const dst, const size_t cap, size_t* const op,
+                   const uint8_t* const literals, const size_t lit_len,
+                   const size_t offset, const size_t match_len) {
+    const size_t match_code = (match_len > 0) ? match_len - LZ_MIN_MATCH : 0;
+
+    if (*op >= cap) {
+        return -1;
+    }
+    dst[(*op)++] = (uint8_t)(((lit_len < 15 ? lit_len : 15) << 4) |
+                             (match_code < 15 ? match_code : 15));
+    if (lit_len >= 15 && lz_put_length(dst, cap, op, lit_len - 15) != 0) {
+        return -1;
+    }
+    if (cap - *op < lit_len) {
+        return -1;
+    }
+    memcpy(dst + *op, literals, lit_len);
+    *op += lit_len;
+
+    if (match_len > 0) {
+        if (cap - *op < 2) {
+            return -1;
+        }
+        put_u16(dst + *op, (uint16_t)offset);
+        *op += 2;
+        if (match_code >= 15 && lz_put_length(dst, cap, op, match_code - 15) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Static helper: compress src into at most cap bytes
+ *
+ * @return Compressed size, or 0 if the output would not fit in cap
+ */
+static size_t lz_compress(const uint8_t* const src, const size_t len,
+                          uint8_t* const dst, const size_t cap) {
+    uint32_t table[1u << LZ_HASH_BITS];  /* Position + 1, 0 = empty */
+    size_t ip = 0;
+    size_t anchor = 0;
+    size_t op = 0;
+
+    memset(table, 0, sizeof(table));
+    while (ip + LZ_MIN_MATCH <= len) {
+        const uint32_t seq = get_u32(src + ip);
+        const uint32_t h = (seq * 2654435761u) >> (32 - LZ_HASH_BITS);
+        const size_t candidate = table[h];
+        table[h] = (uint32_t)(ip + 1);
+
+        if (candidate == 0 || ip - (candidate - 1) > LZ_MAX_OFFSET ||
+            get_u32(src + candidate - 1) != seq) {
+            ip++;
+            continue;
+        }
+
+        const size_t ref = candidate - 1;
+        size_t match_len = LZ_MIN_MATCH;
+        while (ip + match_len < len && src[ref + match_len] == src[ip + match_len]) {
+            match_len++;
+        }
+        if (lz_emit(dst, cap, &op, src + anchor, ip - anchor, ip - ref, match_len) != 0) {
+            return 0;
+        }
+        ip += match_len;
+        anchor = ip;
+    }
+
+    if (lz_emit(dst, cap, &op, src + anchor, len - anchor, 0, 0) != 0) {
+        return 0;
+    }
+    return op;
+}
+
+/* Static helper: read an LZ length extension */
+static int lz_get_length(const uint8_t* const src, const size_t len, size_t* const ip,
+                         size_t* const value) {
+    uint8_t byte;
+    do {
+        if (*ip >= len) {
+            return -1;
+        }
+        byte = src[(*ip)++];
+        *value += byte;
+    } while (byte == 255);
+    return 0;
+}
+
+/* Static helper: decompress exactly out_len bytes, 0 on success */
+static int lz_decompress(const uint8_t* const src, const size_t len,
+                         uint8_t* const dst, const size_t out_len) {
+    size_t ip = 0;
+    size_t op = 0;
+
+    while (ip < len) {
+        const uint8_t token = src[ip++];
+
+        size_t lit_len = token >> 4;
+        if (lit_len == 15 && lz_get_length(src, len, &ip, &lit_len) != 0) {
+            return -1;
+        }
+        if (lit_len > len - ip || lit_len > out_len - op) {
+            return -1;
+        }
+        memcpy(dst + op, src + ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+
+        if (ip == len) {
+            break;  /* Final literals-only sequence */
+        }
+
+        if (len - ip < 2) {
+            return -1;
+        }
+        const size_t offset = get_u16(src + ip);
+        ip += 2;
+        if (offset == 0 || offset > op) {
+            return -1;
+        }
+        size_t match_len = token & 15;
+        if (match_len == 15 && lz_get_length(src, len, &ip, &match_len) != 0) {
+            return -1;
+        }
+        match_len += LZ_MIN_MATCH;
+        if (match_len > out_len - op) {
+            return -1;
+        }
+        /* Byte copy: matches may overlap their own output */
+        for (size_t i = 0; i < match_len; i++, op++) {
+            dst[op] = dst[op - offset];
+        }
+    }
+    return (op == out_len) ? 0 : -1;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Writer                                                                   */
+/* ------------------------------------------------------------------------ */
+
+struct RecordWriter {
+    FILE* file;
+    uint64_t offset;           /* Bytes written so far */
+    size_t block_records;
+    int compress;
+    uint8_t* raw;              /* Bit-packed current block */
+    uint8_t* packed;           /* Compression scratch */
+    size_t raw_capacity;
+    BitWriter bits;
+    size_t pending;            /* Records in the current block */
+    uint64_t prev_id;
+    uint64_t min_id;
+    uint64_t max_id;
+    RecordBlockInfo* index;
+    size_t num_blocks;
+    size_t index_capacity;
+    uint64_t total;
+    int error;                 /* Sticky poker_errno after a failed write */
+};
+
+/* Static helper: fwrite that tracks the offset and latches I/O errors */
+static int writer_put(RecordWriter* const writer, const void* const data, const size_t len) {
+    if (len > 0 && fwrite(data, 1, len, writer->file) != len) {
+        writer->error = POKER_EIO;
+        return -1;
+    }
+    writer->offset += len;
+    return 0;
+}
+
+/* Static helper: write the current block and add it to the index */
+static int writer_flush_block(RecordWriter* const writer) {
+    if (writer->pending == 0) {
+        return 0;
+    }
+
+    if (writer->num_blocks == writer->index_capacity) {
+        const size_t capacity = (writer->index_capacity == 0) ? 64 : writer->index_capacity * 2;
+        RecordBlockInfo* const grown = realloc(writer->index, capacity * sizeof(RecordBlockInfo));
+        if (grown == NULL) {
+            writer->error = POKER_ENOMEM;
+            return -1;
+        }
+        writer->index = grown;
+        writer->index_capacity = capacity;
+    }
+
+    const size_t raw_size = bits_finish(&writer->bits);
+    const uint8_t* stored = writer->raw;
+    size_t stored_size = raw_size;
+    uint32_t codec = RECORD_CODEC_NONE;
+
+    if (writer->compress && raw_size > 1) {
+        const size_t packed = lz_compress(writer->raw, raw_size, writer->packed, raw_size - 1);
+        if (packed > 0) {
+            stored = writer->packed;
+            stored_size = packed;
+            codec = RECORD_CODEC_LZ;
+        }
+    }
+
+    RecordBlockInfo* const info = &writer->index[writer->num_blocks];
+    info->offset = writer->offset;
+    info->first_record = writer->total;
+    info->min_hand_id = writer->min_id;
+    info->max_hand_id = writer->max_id;
+    info->count = (uint32_t)writer->pending;
+    info->stored_size = (uint32_t)stored_size;
+
+    uint8_t header[BLOCK_HEADER_SIZE];
+    put_u32(header, (uint32_t)writer->pending);
+    put_u32(header + 4, (uint32_t)raw_size);
+    put_u32(header + 8, (uint32_t)stored_size);
+    put_u32(header + 12, fnv1a(writer->raw, raw_size));
+    put_u32(header + 16, codec);
+    if (writer_put(writer, header, sizeof(header)) != 0 ||
+        writer_put(writer, stored, stored_size) != 0) {
+        return -1;
+    }
+
+    writer->num_blocks++;
+    writer->total += writer->pending;
+    writer->pending = 0;
+    writer->prev_id = 0;
+    writer->bits.pos = 0;
+    return 0;
+}
+
+RecordWriter* record_writer_open(const char* const path,
+                                 const RecordWriterOptions* const options) {
+    if (path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+
+    size_t block_records = (options != NULL && options->block_records > 0)
+                               ? options->block_records : RECORD_DEFAULT_BLOCK_RECORDS;
+    if (block_records > MAX_BLOCK_RECORDS) {
+        block_records = MAX_BLOCK_RECORDS;
+    }
+
+    RecordWriter* const writer = calloc(1, sizeof(RecordWriter));
+    if (writer == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    writer->block_records = block_records;
+    writer->compress = (options != NULL) ? options->compress : 1;
+    writer->raw_capacity = block_records * MAX_RECORD_BYTES + 1;
+    writer->raw = malloc(writer->raw_capacity);
+    writer->packed = malloc(writer->raw_capacity);
+    if (writer->raw == NULL || writer->packed == NULL) {
+        free(writer->raw);
+        free(writer->packed);
+        free(writer);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    writer->bits.data = writer->raw;
+
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        free(writer->raw);
+        free(writer->packed);
+        free(writer);
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+
+    uint8_t header[FILE_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+    put_u16(header + 4, RECORD_FORMAT_VERSION);
+    put_u32(header + 8, (uint32_t)block_records);
+    if (writer_put(writer, header, sizeof(header)) != 0) {
+        record_writer_close(writer);
+        poker_errno = POKER_EIO;
+        return NULL;
+    }
+    return writer;
+}
+
+int record_writer_append(RecordWriter* const writer, const HandRecord* const records,
+                         const size_t count) {
+    if (writer == NULL || (records == NULL && count > 0)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    if (writer->error != POKER_EOK) {
+        poker_errno = writer->error;
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const HandRecord* const rec = &records[i];
+        if (!record_is_encodable(rec)) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+
+        if (writer->pending == 0) {
+            writer->min_id = rec->hand_id;
+            writer->max_id = rec->hand_id;
+        } else if (rec->hand_id < writer->min_id) {
+            writer->min_id = rec->hand_id;
+        } else if (rec->hand_id > writer->max_id) {
+            writer->max_id = rec->hand_id;
+        }
+
+        encode_record(&writer->bits, rec, &writer->prev_id);
+        if (++writer->pending == writer->block_records &&
+            writer_flush_block(writer) != 0) {
+            poker_errno = writer->error;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int record_writer_close(RecordWriter* const writer) {
+    if (writer == NULL) {
+        return 0;
+    }
+
+    int rc = 0;
+    if (writer->error == POKER_EOK && writer_flush_block(writer) == 0) {
+        const uint64_t index_offset = writer->offset;
+        uint8_t entry[INDEX_ENTRY_SIZE];
+        for (size_t b = 0; b < writer->num_blocks && writer->error == POKER_EOK; b++) {
+            const RecordBlockInfo* const info = &writer->index[b];
+            put_u64(entry, info->offset);
+            put_u64(entry + 8, info->first_record);
+            put_u64(entry + 16, info->min_hand_id);
+            put_u64(entry + 24, info->max_hand_id);
+            put_u32(entry + 32, info->count);
+            put_u32(entry + 36, info->stored_size);
+            writer_put(writer, entry, sizeof(entry));
+        }
+
+        uint8_t trailer[TRAILER_SIZE];
+        put_u64(trailer, index_offset);
+        put_u64(trailer + 8, writer->total);
+        put_u32(trailer + 16, (uint32_t)writer->num_blocks);
+        memcpy(trailer + 20, TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+        if (writer->error == POKER_EOK) {
+            writer_put(writer, trailer, sizeof(trailer));
+        }
+    }
+
+    if (fclose(writer->file) != 0 && writer->error == POKER_EOK) {
+        writer->error = POKER_EIO;
+    }
+    if (writer->error != POKER_EOK) {
+        poker_errno = writer->error;
+        rc = -1;
+    }
+
+    free(writer->index);
+    free(writer->raw);
+    free(writer->packed);
+    free(writer);
+    return rc;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Reader                                                                   */
+/* ------------------------------------------------------------------------ */
+
+struct RecordReader {
+    const uint8_t* map;
+    size_t size;
+    RecordBlockInfo* index;
+    size_t num_blocks;
+    uint64_t total;
+    uint8_t* raw;              /* Decompressed block (LZ blocks only) */
+    size_t raw_capacity;
+    size_t next_block;         /* Next block to load */
+    BitReader bits;
+    uint32_t remaining;        /* Undecoded records in the loaded block */
+    uint64_t prev_id;
+};
+
+/* Static helper: open failure path that releases everything */
+static RecordReader* reader_fail(RecordReader* const reader, const int error) {
+    record_reader_close(reader);
+    poker_errno = error;
+    return NULL;
+}
+
+RecordReader* record_reader_open(const char* const path) {
+    if (path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+    const size_t size = (size_t)st.st_size;
+    if (size < FILE_HEADER_SIZE + TRAILER_SIZE) {
+        close(fd);
+        poker_errno = POKER_EFORMAT;
+        return NULL;
+    }
+    void* const map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* The mapping keeps the file referenced */
+    if (map == MAP_FAILED) {
+        poker_errno = POKER_ENOTFOUND;
+        return NULL;
+    }
+
+    RecordReader* const reader = calloc(1, sizeof(RecordReader));
+    if (reader == NULL) {
+        munmap(map, size);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    reader->map = (const uint8_t*)map;
+    reader->size = size;
+
+    /* Header and trailer */
+    const uint8_t* const data = reader->map;
+    const uint8_t* const trailer = data + size - TRAILER_SIZE;
+    if (memcmp(data, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        get_u16(data + 4) != RECORD_FORMAT_VERSION ||
+        memcmp(trailer + 20, TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0) {
+        return reader_fail(reader, POKER_EFORMAT);
+    }
+    const uint64_t index_offset = get_u64(trailer);
+    const uint64_t num_blocks = get_u32(trailer + 16);
+    reader->total = get_u64(trailer + 8);
+    if (index_offset < FILE_HEADER_SIZE || index_offset > size - TRAILER_SIZE ||
+        size - TRAILER_SIZE - index_offset != num_blocks * INDEX_ENTRY_SIZE) {
+        return reader_fail(reader, POKER_EFORMAT);
+    }
+
+    /* Index: blocks must tile [header, index) and records must add up */
+    reader->num_blocks = (size_t)num_blocks;
+    if (num_blocks > 0) {
+        reader->index = malloc((size_t)num_blocks * sizeof(RecordBlockInfo));
+        if (reader->index == NULL) {
+            return reader_fail(reader, POKER_ENOMEM);
+        }
+    }
+    uint64_t expected_offset = FILE_HEADER_SIZE;
+    uint64_t expected_record = 0;
+    for (size_t b = 0; b < reader->num_blocks; b++) {
+        const uint8_t* const entry = data + index_offset + b * INDEX_ENTRY_SIZE;
+        RecordBlockInfo* const info = &reader->index[b];
+        info->offset = get_u64(entry);
+        info->first_record = get_u64(entry + 8);
+        info->min_hand_id = get_u64(entry + 16);
+        info->max_hand_id = get_u64(entry + 24);
+        info->count = get_u32(entry + 32);
+        info->stored_size = get_u32(entry + 36);
+        if (info->offset != expected_offset || info->first_record != expected_record ||
+            info->count == 0) {
+            return reader_fail(reader, POKER_EFORMAT);
+        }
+        expected_offset += BLOCK_HEADER_SIZE + (uint64_t)info->stored_size;
+        expected_record += info->count;
+    }
+    if (expected_offset != index_offset || expected_record != reader->total) {
+        return reader_fail(reader, POKER_EFORMAT);
+    }
+
+    posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);
+    return reader;
+}
+
+/* Static helper: decode block b's header and prepare its bit stream */
+static int reader_load_block(RecordReader* const reader, const size_t b) {
+    const RecordBlockInfo* const info = &reader->index[b];
+    const uint8_t* const header = reader->map + info->offset;
+    const uint8_t* const stored = header + BLOCK_HEADER_SIZE;
+    const uint32_t count = get_u32(header);
+    const uint32_t raw_size = get_u32(header + 4);
+    const uint32_t stored_size = get_u32(header + 8);
+    const uint32_t checksum = get_u32(header + 12);
+    const uint32_t codec = get_u32(header + 16);
+
+    if (count != info->count || stored_size != info->stored_size ||
+        raw_size > (uint64_t)count * MAX_RECORD_BYTES) {
+        poker_errno = POKER_EFORMAT;
+        return -1;
+    }
+
+    const uint8_t* raw;
+    if (codec == RECORD_CODEC_NONE) {
+        if (stored_size != raw_size) {
+            poker_errno = POKER_EFORMAT;
+            return -1;
+        }
+        raw = stored;  /* Decode straight from the mapping */
+    } else if (codec == RECORD_CODEC_LZ) {
+        if (raw_size > reader->raw_capacity) {
+            uint8_t* const grown = realloc(reader->raw, raw_size);
+            if (grown == NULL) {
+                poker_errno = POKER_ENOMEM;
+                return -1;
+            }
+            reader->raw = grown;
+            reader->raw_capacity = raw_size;
+        }
+        if (lz_decompress(stored, stored_size, reader->raw, raw_size) != 0) {
+            poker_errno = POKER_EFORMAT;
+            return -1;
+        }
+        raw = reader->raw;
+    } else {
+        poker_errno = POKER_EFORMAT;
+        return -1;
+    }
+
+    if (fnv1a(raw, raw_size) != checksum) {
+        poker_errno = POKER_EFORMAT;
+        return -1;
+    }
+
+    memset(&reader->bits, 0, sizeof(reader->bits));
+    reader->bits.data = raw;
+    reader->bits.size = raw_size;
+    reader->remaining = count;
+    reader->prev_id = 0;
+    reader->next_block = b + 1;
+    return 0;
+}
+
+uint64_t record_reader_count(const RecordReader* const reader) {
+    return (reader != NULL) ? reader->total : 0;
+}
+
+size_t record_reader_block_count(const RecordReader* const reader) {
+    return (reader != NULL) ? reader->num_blocks : 0;
+}
+
+int record_reader_block_info(const RecordReader* const reader, const size_t block,
+                             RecordBlockInfo* const out_info) {
+    if (reader == NULL || out_info == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    if (block >= reader->num_blocks) {
+        poker_errno = POKER_ERANGE;
+        return -1;
+    }
+    *out_info = reader->index[block];
+    return 0;
+}
+
+int record_reader_read(RecordReader* const reader, HandRecord* const out,
+                       const size_t max, size_t* const out_count) {
+    if (reader == NULL || out_count == NULL || (out == NULL && max > 0)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    size_t n = 0;
+    while (n < max) {
+        if (reader->remaining == 0) {
+            if (reader->next_block >= reader->num_blocks) {
+                break;
+            }
+            if (reader_load_block(reader, reader->next_block) != 0) {
+                *out_count = n;
+                return -1;
+            }
+        }
+
+        /* Decode as much of this block as fits */
+        size_t batch = reader->remaining;
+        if (batch > max - n) {
+            batch = max - n;
+        }
+        for (size_t i = 0; i < batch; i++) {
+            if (decode_record(&reader->bits, &out[n + i], &reader->prev_id) != 0) {
+                reader->remaining = 0;
+                reader->next_block = reader->num_blocks;
+                *out_count = n + i;
+                poker_errno = POKER_EFORMAT;
+                return -1;
+            }
+        }
+        reader->remaining -= (uint32_t)batch;
+        n += batch;
+    }
+
+    *out_count = n;
+    return 0;
+}
+
+int record_reader_seek(RecordReader* const reader, const uint64_t record) {
+    if (reader == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    if (record > reader->total) {
+        poker_errno = POKER_ERANGE;
+        return -1;
+    }
+    if (record == reader->total) {
+        reader->next_block = reader->num_blocks;
+        reader->remaining = 0;
+        return 0;
+    }
+
+    /* Last block whose first_record <= record */
+    size_t lo = 0;
+    size_t hi = reader->num_blocks - 1;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo + 1) / 2;
+        if (reader->index[mid].first_record <= record) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    if (reader_load_block(reader, lo) != 0) {
+        return -1;
+    }
+    HandRecord skip;
+    for (uint64_t i = reader->index[lo].first_record; i < record; i++) {
+        if (decode_record(&reader->bits, &skip, &reader->prev_id) != 0) {
+            reader->remaining = 0;
+            poker_errno = POKER_EFORMAT;
+            return -1;
+        }
+        reader->remaining--;
+    }
+    return 0;
+}
+
+void record_reader_close(RecordReader* const reader) {
+    if (reader == NULL) {
+        return;
+    }
+    if (reader->map != NULL) {
+        munmap((void*)reader->map, reader->size);
+    }
+    free(reader->index);
+    free(reader->raw);
+    free(reader);
+}
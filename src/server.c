@@ -0,0 +1,887 @@
+/*
+ * server.c - Local evaluation service over a Unix domain socket
+ * One poll() I/O thread, a shared request queue and worker threads that
+ * coalesce queued requests into single batch-evaluation calls
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_server.h"
+#include "threads.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_MAX_BATCH 4096
+#define DEFAULT_MAX_PENDING 1024
+#define DEFAULT_MAX_CONNECTIONS 256
+
+/* Sampled equity runs in chunks of this many boards between deadline checks */
+#define EQUITY_CHUNK 8192
+
+/* A client that stops reading responses is dropped after this long */
+#define SEND_TIMEOUT_SEC 5
+
+/* A client with more response bytes than this waiting is dropped */
+#define MAX_OUTPUT_BYTES ((size_t)64 << 20)
+
+/* Initial output buffer size */
+#define OUTPUT_CHUNK 4096
+
+/* Bytes requested from recv() per read */
+#define READ_CHUNK 65536
+
+/*
+ * Client connection. The I/O thread holds one reference while the socket
+ * is open and every queued request holds another, so a client hanging up
+ * never frees state a worker is about to answer on.
+ *
+ * Sockets are nonblocking. Responses the socket does not take at once wait
+ * in the output buffer until the I/O thread sees it writable, so a client
+ * that reads slowly never stalls the I/O thread or a worker.
+ */
+typedef struct {
+    PokerServer* server;
+    int fd;
+    int refs;
+    int closing;                /* No more requests are read; closed once answered */
+    pthread_mutex_t write_lock; /* Guards the output buffer, broken and flush_deadline */
+    int broken;                 /* A send failed or stalled; later responses are dropped */
+    uint8_t* out;               /* Response bytes not yet sent, from out_pos to out_len */
+    size_t out_pos;
+    size_t out_len;
+    size_t out_capacity;
+    double flush_deadline;      /* Monotonic time by which waiting output must move */
+    uint8_t* buffer;            /* Bytes received but not yet framed */
+    size_t len;
+    size_t capacity;
+} ServerConn;
+
+/* Queued request */
+typedef struct ServerJob {
+    struct ServerJob* next;
+    ServerConn* conn;
+    ServerRequestHeader header;
+    double deadline;            /* Absolute monotonic seconds, 0 = none */
+    size_t payload_size;
+    uint8_t payload[];
+} ServerJob;
+
+struct PokerServer {
+    int listen_fd;
+    int wake_pipe[2];
+    char path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+    size_t num_threads;
+    size_t max_batch;
+    size_t max_pending;
+    size_t max_connections;
+
+    /* The lock guards the queue, stopping and stats */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    ServerJob* head;
+    ServerJob* tail;
+    size_t pending;
+    int stopping;
+    ServerStats stats;
+
+    int stop_requested;         /* Set by server_stop() before it wakes the I/O thread */
+};
+
+/* Per-worker scratch for coalesced batches */
+typedef struct {
+    PokerServer* server;
+    uint64_t* masks;
+    HandValue* values;
+    size_t capacity;
+} ServerWorker;
+
+/* Static helper: monotonic time in seconds */
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void set_cloexec(const int fd) {
+    const int flags = fcntl(fd, F_GETFD);
+    if (flags >= 0) {
+        fcntl(fd, F_SETFD, flags | FD_CLOEXEC);
+    }
+}
+
+/*
+ * Static helper: payload size implied by a request header
+ * @return Size in bytes, or -1 if the header is malformed
+ */
+static long request_payload_size(const ServerRequestHeader* const header) {
+    if (header->reserved != 0) {
+        return -1;
+    }
+    switch (header->type) {
+        case SERVER_REQ_EVALUATE:
+            if (header->count == 0 || header->count > SERVER_MAX_HANDS) {
+                return -1;
+            }
+            return (long)(header->count * sizeof(uint64_t));
+        case SERVER_REQ_EQUITY:
+            if (header->count < 2 || header->count > MAX_PLAYERS) {
+                return -1;
+            }
+            return (long)(sizeof(ServerEquityRequest) + header->count * sizeof(uint64_t));
+        case SERVER_REQ_PING:
+            return (header->count == 0) ? 0 : -1;
+        default:
+            return -1;
+    }
+}
+
+/* Static helper: wake the I/O thread (a full pipe already holds a wakeup) */
+static void wake_io(PokerServer* const server) {
+    const char byte = 1;
+    ssize_t rc = write(server->wake_pipe[1], &byte, 1);
+    (void)rc;
+}
+
+/*
+ * Static helper: drop one reference
+ * Sequentially consistent, so a worker dropping a request of a closing
+ * connection and the I/O thread marking it closing cannot both miss the
+ * other (see server_worker()).
+ */
+static void conn_release(ServerConn* const conn) {
+    if (__atomic_sub_fetch(&conn->refs, 1, __ATOMIC_SEQ_CST) == 0) {
+        close(conn->fd);
+        pthread_mutex_destroy(&conn->write_lock);
+        free(conn->out);
+        free(conn->buffer);
+        free(conn);
+    }
+}
+
+/* Static helper: mark a connection broken and discard its output (write_lock held) */
+static void conn_break(ServerConn* const conn) {
+    conn->broken = 1;
+    conn->out_pos = conn->out_len = 0;
+}
+
+/*
+ * Static helper: append response parts to the output buffer (write_lock held)
+ * @return 0 on success, -1 if the buffer cannot grow or would pass
+ *         MAX_OUTPUT_BYTES
+ */
+static int buffer_output(ServerConn* const conn, const struct iovec* const vec,
+                         const size_t num_iov) {
+    size_t size = 0;
+    for (size_t i = 0; i < num_iov; i++) {
+        size += vec[i].iov_len;
+    }
+    if (conn->out_len - conn->out_pos + size > MAX_OUTPUT_BYTES) {
+        return -1;
+    }
+    if (conn->out_capacity - conn->out_len < size && conn->out_pos > 0) {
+        /* Reclaim what the socket already took */
+        memmove(conn->out, conn->out + conn->out_pos, conn->out_len - conn->out_pos);
+        conn->out_len -= conn->out_pos;
+        conn->out_pos = 0;
+    }
+    if (conn->out_capacity - conn->out_len < size) {
+        size_t capacity = (conn->out_capacity > 0) ? conn->out_capacity : OUTPUT_CHUNK;
+        while (capacity - conn->out_len < size) {
+            capacity *= 2;
+        }
+        uint8_t* const grown = realloc(conn->out, capacity);
+        if (grown == NULL) {
+            return -1;
+        }
+        conn->out = grown;
+        conn->out_capacity = capacity;
+    }
+    for (size_t i = 0; i < num_iov; i++) {
+        memcpy(conn->out + conn->out_len, vec[i].iov_base, vec[i].iov_len);
+        conn->out_len += vec[i].iov_len;
+    }
+    return 0;
+}
+
+/*
+ * Static helper: send one response (header plus up to two payload parts)
+ *
+ * Responses from different workers are serialized per connection. Nothing
+ * here blocks: when output is already waiting, or the socket takes only
+ * part of the response, the rest is buffered and the I/O thread is woken
+ * to flush it. A failed send or an output buffer past MAX_OUTPUT_BYTES
+ * marks the connection broken so its remaining responses are dropped.
+ */
+static void send_response(ServerConn* const conn, const uint32_t id, const uint16_t status,
+                          const uint32_t count, const void* const part1, const size_t size1,
+                          const void* const part2, const size_t size2) {
+    ServerResponseHeader header;
+    memset(&header, 0, sizeof(header));
+    header.id = id;
+    header.status = status;
+    header.count = count;
+    header.payload_size = (uint32_t)(size1 + size2);
+
+    struct iovec iov[3];
+    size_t num_iov = 0;
+    iov[num_iov].iov_base = &header;
+    iov[num_iov++].iov_len = sizeof(header);
+    if (size1 > 0) {
+        iov[num_iov].iov_base = (void*)part1;
+        iov[num_iov++].iov_len = size1;
+    }
+    if (size2 > 0) {
+        iov[num_iov].iov_base = (void*)part2;
+        iov[num_iov++].iov_len = size2;
+    }
+
+    pthread_mutex_lock(&conn->write_lock);
+    const int idle = (conn->out_pos == conn->out_len);
+    struct iovec* vec = iov;
+    /* Send directly only when nothing is waiting, so responses keep their order */
+    while (idle && !conn->broken && num_iov > 0) {
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = vec;
+        msg.msg_iovlen = num_iov;
+        const ssize_t sent = sendmsg(conn->fd, &msg, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            if (errno != EINTR) {
+                conn_break(conn);
+            }
+            continue;
+        }
+        /* Skip what was written, trimming a partially sent part */
+        size_t done = (size_t)sent;
+        while (num_iov > 0 && done >= vec->iov_len) {
+            done -= vec->iov_len;
+            vec++;
+            num_iov--;
+        }
+        if (num_iov > 0) {
+            vec->iov_base = (char*)vec->iov_base + done;
+            vec->iov_len -= done;
+        }
+    }
+    int wake = 0;
+    if (!conn->broken && num_iov > 0) {
+        if (buffer_output(conn, vec, num_iov) != 0) {
+            conn_break(conn);
+        } else if (idle) {
+            conn->flush_deadline = now_sec() + SEND_TIMEOUT_SEC;
+            wake = 1;
+        }
+    }
+    pthread_mutex_unlock(&conn->write_lock);
+    if (wake) {
+        wake_io(conn->server);
+    }
+}
+
+/*
+ * Workers
+ */
+
+/* Static helper: sampled or enumerated equity, checking the deadline between chunks */
+static uint16_t run_equity(const ServerJob* const job, EquityResult* const result) {
+    ServerEquityRequest request;
+    uint64_t holes[MAX_PLAYERS];
+    const size_t players = job->header.count;
+    memcpy(&request, job->payload, sizeof(request));
+    memcpy(holes, job->payload + sizeof(request), players * sizeof(uint64_t));
+
+    if (request.samples == 0) {
+        return (calculate_equity(holes, players, request.board, request.dead, 0, 0, result) == 0)
+                   ? SERVER_STATUS_OK : SERVER_STATUS_INVALID;
+    }
+
+    /* Chunks are combined weighted by their trial counts */
+    double equity[MAX_PLAYERS] = {0}, win[MAX_PLAYERS] = {0}, tie[MAX_PLAYERS] = {0};
+    uint64_t trials = 0;
+    for (uint64_t chunk = 0; trials < request.samples; chunk++) {
+        if (chunk > 0 && job->deadline != 0 && now_sec() > job->deadline) {
+            return SERVER_STATUS_DEADLINE;
+        }
+        const size_t n = (request.samples - trials < EQUITY_CHUNK) ? request.samples - trials
+                                                                   : EQUITY_CHUNK;
+        const uint64_t seed = ((uint64_t)request.seed << 32) ^ (chunk * UINT64_C(0x9E3779B97F4A7C15));
+        EquityResult part;
+        if (calculate_equity(holes, players, request.board, request.dead, n, seed, &part) != 0) {
+            return SERVER_STATUS_INVALID;
+        }
+        for (size_t p = 0; p < players; p++) {
+            equity[p] += part.equity[p] * (double)part.trials;
+            win[p] += part.win[p] * (double)part.trials;
+            tie[p] += part.tie[p] * (double)part.trials;
+        }
+        trials += part.trials;
+        if (part.trials < n) {
+            break;  /* Board already complete: one trial per chunk */
+        }
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->trials = trials;
+    for (size_t p = 0; p < players; p++) {
+        result->equity[p] = equity[p] / (double)trials;
+        result->win[p] = win[p] / (double)trials;
+        result->tie[p] = tie[p] / (double)trials;
+    }
+    return SERVER_STATUS_OK;
+}
+
+/* Static helper: answer one batch of jobs taken from the queue */
+static void serve_batch(ServerWorker* const worker, ServerJob* const batch, ServerStats* const counts) {
+    const double now = now_sec();
+    size_t num_masks = 0;
+
+    /* Expired requests are answered without work; evaluate masks are gathered */
+    for (ServerJob* job = batch; job != NULL; job = job->next) {
+        if (job->deadline != 0 && now > job->deadline) {
+            send_response(job->conn, job->header.id, SERVER_STATUS_DEADLINE, job->header.count,
+                          NULL, 0, NULL, 0);
+            counts->deadline_misses++;
+            job->header.type = 0;
+            continue;
+        }
+        if (job->header.type == SERVER_REQ_EVALUATE) {
+            memcpy(worker->masks + num_masks, job->payload, job->payload_size);
+            num_masks += job->header.count;
+        }
+    }
+
+    /* One kernel call for every evaluate request in the batch */
+    evaluate_masks(worker->masks, num_masks, worker->values);
+    counts->hands += num_masks;
+
+    size_t offset = 0;
+    for (ServerJob* job = batch; job != NULL; job = job->next) {
+        if (job->header.type == SERVER_REQ_EVALUATE) {
+            send_response(job->conn, job->header.id, SERVER_STATUS_OK, job->header.count,
+                          worker->values + offset, job->header.count * sizeof(HandValue), NULL, 0);
+            offset += job->header.count;
+        } else if (job->header.type == SERVER_REQ_EQUITY) {
+            EquityResult result;
+            const uint16_t status = run_equity(job, &result);
+            const size_t players = job->header.count;
+            if (status == SERVER_STATUS_OK) {
+                double values[3 * MAX_PLAYERS];
+                memcpy(values, result.equity, players * sizeof(double));
+                memcpy(values + players, result.win, players * sizeof(double));
+                memcpy(values + 2 * players, result.tie, players * sizeof(double));
+                const ServerEquityReply reply = {result.trials};
+                send_response(job->conn, job->header.id, status, job->header.count,
+                              &reply, sizeof(reply), values, 3 * players * sizeof(double));
+                counts->equity_requests++;
+            } else {
+                send_response(job->conn, job->header.id, status, job->header.count,
+                              NULL, 0, NULL, 0);
+                counts->deadline_misses += (status == SERVER_STATUS_DEADLINE);
+                counts->rejected += (status == SERVER_STATUS_INVALID);
+            }
+        }
+    }
+}
+
+static void* server_worker(void* const arg) {
+    ServerWorker* const worker = (ServerWorker*)arg;
+    PokerServer* const server = worker->server;
+
+    for (;;) {
+        pthread_mutex_lock(&server->lock);
+        while (server->head == NULL && !server->stopping) {
+            pthread_cond_wait(&server->cond, &server->lock);
+        }
+        if (server->head == NULL) {
+            pthread_mutex_unlock(&server->lock);
+            break;
+        }
+
+        /* Take everything queued, up to max_batch hands (always at least one job) */
+        ServerJob* const batch = server->head;
+        ServerJob* last = NULL;
+        size_t jobs = 0;
+        size_t hands = 0;
+        while (server->head != NULL) {
+            const ServerJob* const job = server->head;
+            const size_t job_hands = (job->header.type == SERVER_REQ_EVALUATE) ? job->header.count : 0;
+            if (jobs > 0 && hands + job_hands > server->max_batch) {
+                break;
+            }
+            hands += job_hands;
+            jobs++;
+            last = server->head;
+            server->head = server->head->next;
+        }
+        last->next = NULL;
+        if (server->head == NULL) {
+            server->tail = NULL;
+        }
+        server->pending -= jobs;
+        server->stats.batches++;
+        if (jobs > server->stats.max_batch_requests) {
+            server->stats.max_batch_requests = jobs;
+        }
+        pthread_mutex_unlock(&server->lock);
+
+        ServerStats counts;
+        memset(&counts, 0, sizeof(counts));
+        serve_batch(worker, batch, &counts);
+
+        /* The I/O thread closes a closing connection once its last request is answered */
+        int wake = 0;
+        for (ServerJob* job = batch; job != NULL;) {
+            ServerJob* const next = job->next;
+            wake |= __atomic_load_n(&job->conn->closing, __ATOMIC_SEQ_CST);
+            conn_release(job->conn);
+            free(job);
+            job = next;
+        }
+        if (wake) {
+            wake_io(server);
+        }
+
+        pthread_mutex_lock(&server->lock);
+        server->stats.hands += counts.hands;
+        server->stats.equity_requests += counts.equity_requests;
+        server->stats.deadline_misses += counts.deadline_misses;
+        server->stats.rejected += counts.rejected;
+        pthread_mutex_unlock(&server->lock);
+    }
+    return NULL;
+}
+
+/*
+ * I/O thread
+ */
+
+/* Static helper: queue one framed request (or answer it directly) */
+static void dispatch_request(PokerServer* const server, ServerConn* const conn,
+                             const ServerRequestHeader* const header,
+                             const uint8_t* const payload, const size_t payload_size) {
+    pthread_mutex_lock(&server->lock);
+    server->stats.requests++;
+    const int full = (header->type != SERVER_REQ_PING && server->pending >= server->max_pending);
+    server->stats.rejected += full;
+    pthread_mutex_unlock(&server->lock);
+
+    if (header->type == SERVER_REQ_PING) {
+        send_response(conn, header->id, SERVER_STATUS_OK, 0, NULL, 0, NULL, 0);
+        return;
+    }
+
+    ServerJob* const job = full ? NULL : malloc(sizeof(ServerJob) + payload_size);
+    if (job == NULL) {
+        send_response(conn, header->id, SERVER_STATUS_BUSY, header->count, NULL, 0, NULL, 0);
+        return;
+    }
+    job->next = NULL;
+    job->conn = conn;
+    job->header = *header;
+    job->deadline = (header->deadline_us != 0) ? now_sec() + header->deadline_us / 1e6 : 0;
+    job->payload_size = payload_size;
+    memcpy(job->payload, payload, payload_size);
+    __atomic_add_fetch(&conn->refs, 1, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&server->lock);
+    if (server->tail != NULL) {
+        server->tail->next = job;
+    } else {
+        server->head = job;
+    }
+    server->tail = job;
+    server->pending++;
+    pthread_cond_signal(&server->cond);
+    pthread_mutex_unlock(&server->lock);
+}
+
+/*
+ * Static helper: read what is available and dispatch complete requests
+ * @return 0 to keep the connection, -1 to close it
+ */
+static int read_connection(PokerServer* const server, ServerConn* const conn) {
+    if (conn->capacity - conn->len < READ_CHUNK) {
+        const size_t capacity = conn->len + READ_CHUNK;
+        uint8_t* const grown = realloc(conn->buffer, capacity);
+        if (grown == NULL) {
+            return -1;
+        }
+        conn->buffer = grown;
+        conn->capacity = capacity;
+    }
+
+    const ssize_t got = recv(conn->fd, conn->buffer + conn->len, conn->capacity - conn->len, 0);
+    if (got == 0) {
+        return -1;
+    }
+    if (got < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+    conn->len += (size_t)got;
+
+    size_t pos = 0;
+    while (conn->len - pos >= sizeof(ServerRequestHeader)) {
+        ServerRequestHeader header;
+        memcpy(&header, conn->buffer + pos, sizeof(header));
+        const long payload_size = request_payload_size(&header);
+        if (payload_size < 0) {
+            /* Framing is lost: answer, then hang up once that is sent */
+            pthread_mutex_lock(&server->lock);
+            server->stats.requests++;
+            server->stats.rejected++;
+            pthread_mutex_unlock(&server->lock);
+            send_response(conn, header.id, SERVER_STATUS_INVALID, header.count, NULL, 0, NULL, 0);
+            return -1;
+        }
+        if (conn->len - pos - sizeof(header) < (size_t)payload_size) {
+            break;
+        }
+        dispatch_request(server, conn, &header, conn->buffer + pos + sizeof(header),
+                         (size_t)payload_size);
+        pos += sizeof(header) + (size_t)payload_size;
+    }
+
+    memmove(conn->buffer, conn->buffer + pos, conn->len - pos);
+    conn->len -= pos;
+    return 0;
+}
+
+/* Static helper: send buffered responses the socket now takes */
+static void flush_output(ServerConn* const conn) {
+    pthread_mutex_lock(&conn->write_lock);
+    while (!conn->broken && conn->out_pos < conn->out_len) {
+        const ssize_t sent = send(conn->fd, conn->out + conn->out_pos,
+                                  conn->out_len - conn->out_pos, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            if (errno != EINTR) {
+                conn_break(conn);
+            }
+            continue;
+        }
+        conn->out_pos += (size_t)sent;
+        conn->flush_deadline = now_sec() + SEND_TIMEOUT_SEC;
+    }
+    if (conn->out_pos == conn->out_len) {
+        conn->out_pos = conn->out_len = 0;
+    }
+    pthread_mutex_unlock(&conn->write_lock);
+}
+
+/*
+ * Static helper: fill poll entries for the connections, closing the ones
+ * that are finished (broken, stalled past their flush deadline, or closing
+ * with every request answered and sent)
+ * @return Poll timeout in milliseconds until the nearest flush deadline,
+ *         or -1 if no output is waiting
+ */
+static int prepare_connections(ServerConn** const conns, size_t* const num_conns,
+                               struct pollfd* const fds) {
+    const double now = now_sec();
+    double deadline = 0;
+    size_t i = 0;
+    while (i < *num_conns) {
+        ServerConn* const conn = conns[i];
+        pthread_mutex_lock(&conn->write_lock);
+        if (conn->out_pos < conn->out_len && now > conn->flush_deadline) {
+            conn_break(conn);
+        }
+        const int broken = conn->broken;
+        const int waiting = (conn->out_pos < conn->out_len);
+        const double flush_deadline = conn->flush_deadline;
+        pthread_mutex_unlock(&conn->write_lock);
+
+        const int closing = __atomic_load_n(&conn->closing, __ATOMIC_SEQ_CST);
+        if (broken || (closing && !waiting && __atomic_load_n(&conn->refs, __ATOMIC_SEQ_CST) == 1)) {
+            conn_release(conn);
+            conns[i] = conns[--*num_conns];
+            continue;
+        }
+        if (waiting && (deadline == 0 || flush_deadline < deadline)) {
+            deadline = flush_deadline;
+        }
+        fds[i].fd = conn->fd;
+        fds[i].events = (short)((closing ? 0 : POLLIN) | (waiting ? POLLOUT : 0));
+        fds[i].revents = 0;
+        i++;
+    }
+    return (deadline == 0) ? -1 : (int)((deadline - now) * 1000.0) + 1;
+}
+
+/* Static helper: handle poll results for the connections */
+static void service_connections(PokerServer* const server, ServerConn** const conns,
+                                const size_t num_conns, const struct pollfd* const fds) {
+    for (size_t i = 0; i < num_conns; i++) {
+        ServerConn* const conn = conns[i];
+        const short revents = fds[i].revents;
+        if (revents & (POLLERR | POLLHUP)) {
+            /* The client can no longer read responses */
+            pthread_mutex_lock(&conn->write_lock);
+            conn_break(conn);
+            pthread_mutex_unlock(&conn->write_lock);
+            continue;
+        }
+        if (revents & POLLOUT) {
+            flush_output(conn);
+        }
+        if ((revents & POLLIN) && read_connection(server, conn) != 0) {
+            __atomic_store_n(&conn->closing, 1, __ATOMIC_SEQ_CST);
+        }
+    }
+}
+
+/* Static helper: accept one client */
+static ServerConn* accept_connection(PokerServer* const server) {
+    const int fd = accept(server->listen_fd, NULL, NULL);
+    if (fd < 0) {
+        return NULL;
+    }
+    set_cloexec(fd);
+    const int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    ServerConn* const conn = calloc(1, sizeof(ServerConn));
+    if (conn == NULL) {
+        close(fd);
+        return NULL;
+    }
+    conn->server = server;
+    conn->fd = fd;
+    conn->refs = 1;
+    pthread_mutex_init(&conn->write_lock, NULL);
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.connections++;
+    pthread_mutex_unlock(&server->lock);
+    return conn;
+}
+
+PokerServer* server_open(const ServerOptions* const options) {
+    if (options == NULL || options->socket_path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    const size_t path_len = strlen(options->socket_path);
+    if (path_len == 0 || path_len >= sizeof(addr.sun_path)) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+    memcpy(addr.sun_path, options->socket_path, path_len + 1);
+
+    PokerServer* const server = calloc(1, sizeof(PokerServer));
+    if (server == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    memcpy(server->path, addr.sun_path, sizeof(server->path));
+    server->num_threads = resolve_thread_count(options->num_threads);
+    server->max_batch = options->max_batch ? options->max_batch : DEFAULT_MAX_BATCH;
+    server->max_pending = options->max_pending ? options->max_pending : DEFAULT_MAX_PENDING;
+    server->max_connections = options->max_connections ? options->max_connections
+                                                       : DEFAULT_MAX_CONNECTIONS;
+    server->wake_pipe[0] = server->wake_pipe[1] = -1;
+
+    /* Replace a stale socket left by a previous run, never a regular file */
+    struct stat st;
+    if (lstat(addr.sun_path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        unlink(addr.sun_path);
+    }
+
+    server->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server->listen_fd < 0 || pipe(server->wake_pipe) != 0 ||
+        bind(server->listen_fd, (const struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(server->listen_fd, 128) != 0) {
+        if (server->listen_fd >= 0) {
+            close(server->listen_fd);
+        }
+        if (server->wake_pipe[0] >= 0) {
+            close(server->wake_pipe[0]);
+            close(server->wake_pipe[1]);
+        }
+        free(server);
+        poker_errno = POKER_EIO;
+        return NULL;
+    }
+    set_cloexec(server->listen_fd);
+    set_cloexec(server->wake_pipe[0]);
+    set_cloexec(server->wake_pipe[1]);
+    fcntl(server->wake_pipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(server->wake_pipe[1], F_SETFL, O_NONBLOCK);
+
+    pthread_mutex_init(&server->lock, NULL);
+    pthread_cond_init(&server->cond, NULL);
+    return server;
+}
+
+int server_run(PokerServer* const server) {
+    if (server == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    const size_t batch_capacity = (server->max_batch > SERVER_MAX_HANDS) ? server->max_batch
+                                                                         : SERVER_MAX_HANDS;
+    const size_t slots = server->max_connections + 2;
+    ServerWorker* const workers = calloc(server->num_threads, sizeof(ServerWorker));
+    pthread_t* const threads = calloc(server->num_threads, sizeof(pthread_t));
+    ServerConn** const conns = calloc(server->max_connections, sizeof(ServerConn*));
+    struct pollfd* const fds = calloc(slots, sizeof(struct pollfd));
+    if (workers == NULL || threads == NULL || conns == NULL || fds == NULL) {
+        free(workers);
+        free(threads);
+        free(conns);
+        free(fds);
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+
+    pthread_mutex_lock(&server->lock);
+    server->stopping = 0;
+    pthread_mutex_unlock(&server->lock);
+
+    size_t started = 0;
+    for (size_t i = 0; i < server->num_threads && i < MAX_WORKER_THREADS; i++) {
+        workers[i].server = server;
+        workers[i].capacity = batch_capacity;
+        workers[i].masks = malloc(batch_capacity * sizeof(uint64_t));
+        workers[i].values = malloc(batch_capacity * sizeof(HandValue));
+        if (workers[i].masks == NULL || workers[i].values == NULL ||
+            pthread_create(&threads[started], NULL, server_worker, &workers[i]) != 0) {
+            free(workers[i].masks);
+            free(workers[i].values);
+            workers[i].masks = NULL;
+            workers[i].values = NULL;
+            break;
+        }
+        started++;
+    }
+
+    int result = 0;
+    size_t num_conns = 0;
+    if (started == 0) {
+        poker_errno = POKER_ENOMEM;
+        result = -1;
+    }
+
+    char drain[64];
+    while (result == 0) {
+        const int timeout = prepare_connections(conns, &num_conns, fds + 2);
+        fds[0].fd = server->wake_pipe[0];
+        fds[0].events = POLLIN;
+        fds[1].fd = (num_conns < server->max_connections) ? server->listen_fd : -1;
+        fds[1].events = POLLIN;
+
+        if (poll(fds, 2 + num_conns, timeout) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            poker_errno = POKER_EIO;
+            result = -1;
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            /* Workers wake the loop to flush output; only server_stop() ends it */
+            while (read(server->wake_pipe[0], drain, sizeof(drain)) > 0) {
+            }
+            if (__atomic_load_n(&server->stop_requested, __ATOMIC_ACQUIRE)) {
+                break;
+            }
+        }
+
+        service_connections(server, conns, num_conns, fds + 2);
+
+        if (fds[1].fd >= 0 && (fds[1].revents & POLLIN)) {
+            ServerConn* const conn = accept_connection(server);
+            if (conn != NULL) {
+                conns[num_conns++] = conn;
+            }
+        }
+    }
+
+    /* Workers answer everything still queued, then exit */
+    pthread_mutex_lock(&server->lock);
+    server->stopping = 1;
+    pthread_cond_broadcast(&server->cond);
+    pthread_mutex_unlock(&server->lock);
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+        free(workers[i].masks);
+        free(workers[i].values);
+    }
+
+    /* Deliver their answers, still dropping clients that stop reading */
+    for (size_t i = 0; i < num_conns; i++) {
+        __atomic_store_n(&conns[i]->closing, 1, __ATOMIC_SEQ_CST);
+    }
+    while (result == 0 && num_conns > 0) {
+        const int timeout = prepare_connections(conns, &num_conns, fds);
+        if (num_conns == 0 || (poll(fds, num_conns, timeout) < 0 && errno != EINTR)) {
+            break;
+        }
+        service_connections(server, conns, num_conns, fds);
+    }
+    for (size_t i = 0; i < num_conns; i++) {
+        conn_release(conns[i]);
+    }
+
+    /* Drain the stop request so the server can run again (the pipe is nonblocking) */
+    while (read(server->wake_pipe[0], drain, sizeof(drain)) > 0) {
+    }
+    __atomic_store_n(&server->stop_requested, 0, __ATOMIC_RELEASE);
+    free(workers);
+    free(threads);
+    free(conns);
+    free(fds);
+    return result;
+}
+
+void server_stop(PokerServer* const server) {
+    if (server != NULL) {
+        __atomic_store_n(&server->stop_requested, 1, __ATOMIC_RELEASE);
+        wake_io(server);
+    }
+}
+
+void server_get_stats(PokerServer* const server, ServerStats* const out_stats) {
+    if (server == NULL || out_stats == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&server->lock);
+    *out_stats = server->stats;
+    pthread_mutex_unlock(&server->lock);
+}
+
+void server_close(PokerServer* const server) {
+    if (server == NULL) {
+        return;
+    }
+    close(server->listen_fd);
+    unlink(server->path);
+    close(server->wake_pipe[0]);
+    close(server->wake_pipe[1]);
+    pthread_mutex_destroy(&server->lock);
+    pthread_cond_destroy(&server->cond);
+    free(server);
+}
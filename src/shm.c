@@ -0,0 +1,599 @@
+/*
+ * shm.c - Shared-memory ring IPC for co-located evaluator clients
+ * Sequence-numbered slot rings in a shared file mapping, with futex
+ * wakeups for whichever side is idle
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE  /* syscall() */
+
+#include "../include/poker_shm.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Futexes are used through raw syscalls. Define POKER_NO_FUTEX to build the
+ * portable path, where an idle side polls with short sleeps instead.
+ */
+#if defined(__linux__) && !defined(POKER_NO_FUTEX) && defined(__has_include)
+#if __has_include(<linux/futex.h>)
+#define HAVE_FUTEX 1
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+#define SHM_MAGIC   0x48534b50u  /* "PKSH" */
+#define SHM_VERSION 1
+
+/* Cache line; headers and slots are padded to it */
+#define LINE 64
+
+/*
+ * Idle waiting: busy checks first, then checks that yield the CPU (so a
+ * peer sharing the core can run), then a futex sleep
+ */
+#define BUSY_SPINS 64
+#define EVALUATOR_SPINS 2048
+#define CLIENT_SPINS 4096
+
+/* Longest client sleep between checks for a closed segment */
+#define CLIENT_SLEEP_NS 100000000L
+
+/* Sleep between polls when futexes are unavailable */
+#define POLL_SLEEP_NS 50000L
+
+/*
+ * Segment header. Everything is 32-bit so it can serve as a futex word.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_rings;
+    uint32_t ring_slots;
+    uint32_t slot_hands;
+    uint32_t slot_size;     /* Bytes per slot */
+    uint32_t closed;        /* Set when the evaluator is destroyed */
+    uint32_t wake_seq;      /* Evaluator futex word, bumped to wake it */
+    uint32_t sleeping;      /* Evaluator is (about to be) asleep on wake_seq */
+} ShmHeader;
+
+/* Producer claim counter, one cache line per ring */
+typedef struct {
+    uint32_t tail;
+} ShmRingHeader;
+
+/*
+ * Slot. For the claim at ring position pos, seq moves
+ *   pos (free) -> pos + 1 (published) -> pos + 2 (done) -> pos + ring_slots
+ * where the last value frees it for the claim one lap later. Masks and
+ * values follow the header.
+ */
+typedef struct {
+    uint32_t seq;           /* Client futex word */
+    uint32_t waiting;       /* Client is (about to be) asleep on seq */
+    uint32_t count;         /* Masks in this request */
+    uint32_t reserved;
+} ShmSlot;
+
+/*
+ * Segment layout. Each side keeps its own copy: clients can write the
+ * shared header, so the evaluator never reads geometry back from it.
+ */
+typedef struct {
+    size_t num_rings;
+    uint32_t ring_slots;
+    size_t slot_hands;
+    size_t slot_size;       /* Bytes per slot */
+} ShmGeometry;
+
+struct ShmEvaluator {
+    uint8_t* base;
+    size_t size;
+    char* path;
+    ShmGeometry geometry;
+    uint32_t* heads;        /* Next position to serve, per ring (geometry.num_rings) */
+    int stopping;
+    ShmStats stats;
+};
+
+/* Request in flight from one client */
+typedef struct {
+    uint32_t pos;
+    size_t offset;          /* First mask of this request */
+    size_t count;
+} ShmPending;
+
+struct ShmClient {
+    uint8_t* base;
+    size_t size;
+    ShmGeometry geometry;   /* Validated against the file at attach */
+    ShmRingHeader* ring;
+    ShmPending* pending;    /* FIFO of requests in flight */
+    size_t max_pending;
+};
+
+#define SHM_HEADER(base) ((ShmHeader*)(base))
+
+static size_t round_line(const size_t n) {
+    return (n + LINE - 1) / LINE * LINE;
+}
+
+static size_t ring_stride(const ShmGeometry* const geometry) {
+    return LINE + (size_t)geometry->ring_slots * geometry->slot_size;
+}
+
+static ShmRingHeader* ring_at(uint8_t* const base, const ShmGeometry* const geometry,
+                              const size_t ring) {
+    return (ShmRingHeader*)(base + LINE + ring * ring_stride(geometry));
+}
+
+static ShmSlot* slot_at(ShmRingHeader* const ring, const ShmGeometry* const geometry,
+                        const uint32_t pos) {
+    const size_t index = pos & (geometry->ring_slots - 1);
+    return (ShmSlot*)((uint8_t*)ring + LINE + index * geometry->slot_size);
+}
+
+static uint64_t* slot_masks(ShmSlot* const slot) {
+    return (uint64_t*)(slot + 1);
+}
+
+static HandValue* slot_values(ShmSlot* const slot, const size_t slot_hands) {
+    return (HandValue*)(slot_masks(slot) + slot_hands);
+}
+
+/*
+ * Futex helpers (shared, not process-private: waiters live in other processes)
+ */
+
+static void futex_wait(uint32_t* const word, const uint32_t expected, const long timeout_ns) {
+#ifdef HAVE_FUTEX
+    struct timespec timeout = {0, timeout_ns};
+    syscall(SYS_futex, word, FUTEX_WAIT, expected, timeout_ns > 0 ? &timeout : NULL, NULL, 0);
+#else
+    (void)word;
+    (void)expected;
+    (void)timeout_ns;
+    const struct timespec pause = {0, POLL_SLEEP_NS};
+    nanosleep(&pause, NULL);
+#endif
+}
+
+static void futex_wake(uint32_t* const word) {
+#ifdef HAVE_FUTEX
+    syscall(SYS_futex, word, FUTEX_WAKE, 0x7fffffff, NULL, NULL, 0);
+#else
+    (void)word;
+#endif
+}
+
+/*
+ * Evaluator
+ */
+
+/*
+ * Static helper: check that path can be replaced
+ * Only a missing path or a regular file that starts with a segment header
+ * of this library may go; anything else is left alone.
+ * @return 0 if path is free to create, -1 otherwise
+ */
+static int replaceable_segment(const char* const path) {
+    struct stat st;
+    if (lstat(path, &st) != 0) {
+        return (errno == ENOENT) ? 0 : -1;
+    }
+    if (!S_ISREG(st.st_mode) || st.st_size < (off_t)sizeof(ShmHeader)) {
+        return -1;
+    }
+    const int fd = open(path, O_RDONLY | O_NOFOLLOW);
+    if (fd < 0) {
+        return -1;
+    }
+    ShmHeader header;
+    const ssize_t got = pread(fd, &header, sizeof(header), 0);
+    close(fd);
+    if (got != (ssize_t)sizeof(header) || header.magic != SHM_MAGIC) {
+        return -1;
+    }
+    return unlink(path);
+}
+
+ShmEvaluator* shm_evaluator_create(const char* const path, const ShmRingOptions* const options) {
+    const size_t num_rings = (options && options->num_rings) ? options->num_rings : SHM_DEFAULT_RINGS;
+    const size_t ring_slots = (options && options->ring_slots) ? options->ring_slots
+                                                               : SHM_DEFAULT_RING_SLOTS;
+    const size_t slot_hands = (options && options->slot_hands) ? options->slot_hands
+                                                               : SHM_DEFAULT_SLOT_HANDS;
+    /* Four slots minimum keep the free/published/done sequence values distinct */
+    if (path == NULL || num_rings > 1024 || ring_slots < 4 || ring_slots > 65536 ||
+        (ring_slots & (ring_slots - 1)) != 0 || slot_hands > (1u << 20)) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+
+    const ShmGeometry geometry = {
+        num_rings, (uint32_t)ring_slots, slot_hands,
+        round_line(sizeof(ShmSlot) + slot_hands * (sizeof(uint64_t) + sizeof(HandValue)))};
+    const size_t size = LINE + num_rings * ring_stride(&geometry);
+
+    ShmEvaluator* const evaluator = calloc(1, sizeof(ShmEvaluator));
+    char* const path_copy = malloc(strlen(path) + 1);
+    uint32_t* const heads = calloc(num_rings, sizeof(uint32_t));
+    if (evaluator == NULL || path_copy == NULL || heads == NULL) {
+        free(evaluator);
+        free(path_copy);
+        free(heads);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    strcpy(path_copy, path);
+
+    /* A fresh file: clients still mapping an old segment keep the old one */
+    const int fd = (replaceable_segment(path) == 0) ? open(path, O_RDWR | O_CREAT | O_EXCL, 0600)
+                                                    : -1;
+    void* base = MAP_FAILED;
+    if (fd >= 0 && ftruncate(fd, (off_t)size) == 0) {
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (base == MAP_FAILED) {
+        if (fd >= 0) {
+            unlink(path);
+        }
+        free(evaluator);
+        free(path_copy);
+        free(heads);
+        poker_errno = POKER_EIO;
+        return NULL;
+    }
+
+    /* The file starts zeroed; slots start free for their first-lap position */
+    ShmHeader* const header = SHM_HEADER(base);
+    header->version = SHM_VERSION;
+    header->num_rings = (uint32_t)num_rings;
+    header->ring_slots = (uint32_t)ring_slots;
+    header->slot_hands = (uint32_t)slot_hands;
+    header->slot_size = (uint32_t)geometry.slot_size;
+    for (size_t r = 0; r < num_rings; r++) {
+        ShmRingHeader* const ring = ring_at(base, &geometry, r);
+        for (uint32_t i = 0; i < ring_slots; i++) {
+            slot_at(ring, &geometry, i)->seq = i;
+        }
+    }
+    __atomic_store_n(&header->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+
+    evaluator->base = base;
+    evaluator->size = size;
+    evaluator->path = path_copy;
+    evaluator->geometry = geometry;
+    evaluator->heads = heads;
+    return evaluator;
+}
+
+size_t shm_evaluator_poll(ShmEvaluator* const evaluator) {
+    if (evaluator == NULL) {
+        return 0;
+    }
+    const ShmGeometry* const geometry = &evaluator->geometry;
+    size_t served = 0;
+
+    for (size_t r = 0; r < geometry->num_rings; r++) {
+        ShmRingHeader* const ring = ring_at(evaluator->base, geometry, r);
+        uint32_t head = evaluator->heads[r];
+
+        /* Serve published slots in ring order until one is not ready */
+        for (;;) {
+            ShmSlot* const slot = slot_at(ring, geometry, head);
+            if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != head + 1) {
+                break;
+            }
+            const uint32_t count = (slot->count <= geometry->slot_hands) ? slot->count : 0;
+            evaluate_masks(slot_masks(slot), count, slot_values(slot, geometry->slot_hands));
+            served++;
+
+            /* Counted before release so a client that sees its result sees it counted */
+            __atomic_fetch_add(&evaluator->stats.requests, 1, __ATOMIC_RELAXED);
+            __atomic_fetch_add(&evaluator->stats.hands, count, __ATOMIC_RELAXED);
+            __atomic_store_n(&slot->seq, head + 2, __ATOMIC_RELEASE);
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&slot->waiting, __ATOMIC_RELAXED)) {
+                futex_wake(&slot->seq);
+            }
+            head++;
+        }
+        evaluator->heads[r] = head;
+    }
+
+    if (served > 0) {
+        __atomic_fetch_add(&evaluator->stats.polls, 1, __ATOMIC_RELAXED);
+    }
+    return served;
+}
+
+int shm_evaluator_run(ShmEvaluator* const evaluator) {
+    if (evaluator == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    ShmHeader* const header = SHM_HEADER(evaluator->base);
+    size_t idle = 0;
+
+    while (!__atomic_load_n(&evaluator->stopping, __ATOMIC_ACQUIRE)) {
+        if (shm_evaluator_poll(evaluator) > 0) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < EVALUATOR_SPINS) {
+            if (idle >= BUSY_SPINS) {
+                sched_yield();
+            }
+            continue;
+        }
+
+        /*
+         * Announce sleep, then look once more: a client publishing after
+         * this check sees sleeping and bumps wake_seq, so the wait below
+         * returns at once instead of missing the request.
+         */
+        const uint32_t seq = __atomic_load_n(&header->wake_seq, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&header->sleeping, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (shm_evaluator_poll(evaluator) == 0 &&
+            !__atomic_load_n(&evaluator->stopping, __ATOMIC_ACQUIRE)) {
+            __atomic_fetch_add(&evaluator->stats.sleeps, 1, __ATOMIC_RELAXED);
+            futex_wait(&header->wake_seq, seq, 0);
+        }
+        __atomic_store_n(&header->sleeping, 0, __ATOMIC_RELAXED);
+        idle = 0;
+    }
+
+    __atomic_store_n(&evaluator->stopping, 0, __ATOMIC_RELAXED);
+    return 0;
+}
+
+void shm_evaluator_stop(ShmEvaluator* const evaluator) {
+    if (evaluator == NULL) {
+        return;
+    }
+    ShmHeader* const header = SHM_HEADER(evaluator->base);
+    __atomic_store_n(&evaluator->stopping, 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&header->wake_seq, 1, __ATOMIC_SEQ_CST);
+    futex_wake(&header->wake_seq);
+}
+
+void shm_evaluator_get_stats(ShmEvaluator* const evaluator, ShmStats* const out_stats) {
+    if (evaluator == NULL || out_stats == NULL) {
+        return;
+    }
+    out_stats->requests = __atomic_load_n(&evaluator->stats.requests, __ATOMIC_RELAXED);
+    out_stats->hands = __atomic_load_n(&evaluator->stats.hands, __ATOMIC_RELAXED);
+    out_stats->polls = __atomic_load_n(&evaluator->stats.polls, __ATOMIC_RELAXED);
+    out_stats->sleeps = __atomic_load_n(&evaluator->stats.sleeps, __ATOMIC_RELAXED);
+}
+
+void shm_evaluator_destroy(ShmEvaluator* const evaluator) {
+    if (evaluator == NULL) {
+        return;
+    }
+    ShmHeader* const header = SHM_HEADER(evaluator->base);
+    const ShmGeometry* const geometry = &evaluator->geometry;
+
+    /* Wake every sleeping client so it sees the segment closed */
+    __atomic_store_n(&header->closed, 1, __ATOMIC_SEQ_CST);
+    for (size_t r = 0; r < geometry->num_rings; r++) {
+        ShmRingHeader* const ring = ring_at(evaluator->base, geometry, r);
+        for (uint32_t i = 0; i < geometry->ring_slots; i++) {
+            futex_wake(&slot_at(ring, geometry, i)->seq);
+        }
+    }
+
+    munmap(evaluator->base, evaluator->size);
+    unlink(evaluator->path);
+    free(evaluator->path);
+    free(evaluator->heads);
+    free(evaluator);
+}
+
+/*
+ * Client
+ */
+
+ShmClient* shm_client_attach(const char* const path, const size_t ring) {
+    if (path == NULL) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+    const int fd = open(path, O_RDWR);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        poker_errno = POKER_EIO;
+        return NULL;
+    }
+    const size_t size = (size_t)st.st_size;
+    void* const base = (size >= LINE) ? mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                                      : MAP_FAILED;
+    close(fd);
+    if (base == MAP_FAILED) {
+        poker_errno = (size >= LINE) ? POKER_EIO : POKER_EFORMAT;
+        return NULL;
+    }
+
+    /* Reject anything whose geometry does not fit the file */
+    const ShmHeader* const header = SHM_HEADER(base);
+    const int magic = __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == SHM_MAGIC;
+    const ShmGeometry geometry = {header->num_rings, header->ring_slots, header->slot_hands,
+                                  header->slot_size};
+    const int valid =
+        magic && header->version == SHM_VERSION && geometry.ring_slots >= 4 &&
+        (geometry.ring_slots & (geometry.ring_slots - 1)) == 0 &&
+        geometry.slot_size >= round_line(sizeof(ShmSlot) + geometry.slot_hands *
+                                                               (sizeof(uint64_t) + sizeof(HandValue))) &&
+        LINE + geometry.num_rings * ring_stride(&geometry) <= size;
+    if (!valid || ring >= geometry.num_rings) {
+        munmap(base, size);
+        poker_errno = valid ? POKER_ERANGE : POKER_EFORMAT;
+        return NULL;
+    }
+
+    ShmClient* const client = calloc(1, sizeof(ShmClient));
+    /* Keep half a ring in flight so clients sharing it still get slots */
+    const size_t max_pending = geometry.ring_slots / 2;
+    ShmPending* const pending = calloc(max_pending, sizeof(ShmPending));
+    if (client == NULL || pending == NULL) {
+        free(client);
+        free(pending);
+        munmap(base, size);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    client->base = base;
+    client->size = size;
+    client->geometry = geometry;
+    client->ring = ring_at(base, &geometry, ring);
+    client->pending = pending;
+    client->max_pending = max_pending;
+    return client;
+}
+
+size_t shm_client_slot_hands(const ShmClient* const client) {
+    return (client != NULL) ? client->geometry.slot_hands : 0;
+}
+
+/*
+ * Static helper: claim the slot at the ring tail
+ * @return 0 with *out_pos set, or -1 if the ring is full
+ */
+static int claim_slot(ShmClient* const client, uint32_t* const out_pos) {
+    uint32_t pos = __atomic_load_n(&client->ring->tail, __ATOMIC_RELAXED);
+    for (;;) {
+        const ShmSlot* const slot = slot_at(client->ring, &client->geometry, pos);
+        const int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&client->ring->tail, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *out_pos = pos;
+                return 0;
+            }
+        } else if (diff < 0) {
+            return -1;  /* Slot from the previous lap still in use */
+        } else {
+            pos = __atomic_load_n(&client->ring->tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* Static helper: write masks into a claimed slot and publish it */
+static void publish_slot(ShmClient* const client, const uint32_t pos,
+                         const uint64_t* const masks, const size_t count) {
+    ShmHeader* const header = SHM_HEADER(client->base);
+    ShmSlot* const slot = slot_at(client->ring, &client->geometry, pos);
+    memcpy(slot_masks(slot), masks, count * sizeof(uint64_t));
+    slot->count = (uint32_t)count;
+
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&header->sleeping, __ATOMIC_RELAXED)) {
+        __atomic_fetch_add(&header->wake_seq, 1, __ATOMIC_SEQ_CST);
+        futex_wake(&header->wake_seq);
+    }
+}
+
+/*
+ * Static helper: wait for a published slot, copy its values and free it
+ * @return 0 on success, -1 if the evaluator shut down
+ */
+static int complete_slot(ShmClient* const client, const ShmPending* const request,
+                         HandValue* const out_values) {
+    ShmHeader* const header = SHM_HEADER(client->base);
+    ShmSlot* const slot = slot_at(client->ring, &client->geometry, request->pos);
+    const uint32_t done = request->pos + 2;
+
+    for (size_t spin = 0; __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != done; spin++) {
+        if (__atomic_load_n(&header->closed, __ATOMIC_ACQUIRE)) {
+            poker_errno = POKER_EIO;
+            return -1;
+        }
+        if (spin < CLIENT_SPINS) {
+            if (spin >= BUSY_SPINS) {
+                sched_yield();
+            }
+            continue;
+        }
+        /* Same announce-then-recheck handshake as the evaluator */
+        __atomic_store_n(&slot->waiting, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == request->pos + 1) {
+            futex_wait(&slot->seq, request->pos + 1, CLIENT_SLEEP_NS);
+        }
+    }
+    __atomic_store_n(&slot->waiting, 0, __ATOMIC_RELAXED);
+
+    memcpy(out_values + request->offset, slot_values(slot, client->geometry.slot_hands),
+           request->count * sizeof(HandValue));
+    __atomic_store_n(&slot->seq, request->pos + client->geometry.ring_slots, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int shm_client_evaluate(ShmClient* const client, const uint64_t* const masks,
+                        const size_t count, HandValue* const out_values) {
+    if (client == NULL || (count > 0 && (masks == NULL || out_values == NULL))) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    const ShmHeader* const header = SHM_HEADER(client->base);
+    const size_t slot_hands = client->geometry.slot_hands;
+
+    /* FIFO of in-flight requests: the evaluator serves a ring in order */
+    size_t first = 0, num_pending = 0, next = 0;
+    while (next < count || num_pending > 0) {
+        if (next < count && num_pending < client->max_pending) {
+            uint32_t pos;
+            if (claim_slot(client, &pos) == 0) {
+                ShmPending* const request = &client->pending[(first + num_pending) % client->max_pending];
+                request->pos = pos;
+                request->offset = next;
+                request->count = (count - next < slot_hands) ? count - next : slot_hands;
+                publish_slot(client, pos, masks + next, request->count);
+                next += request->count;
+                num_pending++;
+                continue;
+            }
+            if (num_pending == 0) {
+                /* Ring full of other clients' requests */
+                if (__atomic_load_n(&header->closed, __ATOMIC_ACQUIRE)) {
+                    poker_errno = POKER_EIO;
+                    return -1;
+                }
+                sched_yield();
+                continue;
+            }
+        }
+
+        if (complete_slot(client, &client->pending[first], out_values) != 0) {
+            return -1;
+        }
+        first = (first + 1) % client->max_pending;
+        num_pending--;
+    }
+    return 0;
+}
+
+void shm_client_detach(ShmClient* const client) {
+    if (client != NULL) {
+        munmap(client->base, client->size);
+        free(client->pending);
+        free(client);
+    }
+}
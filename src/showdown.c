@@ -0,0 +1,336 @@
+/*
+ * showdown.c - Showdown resolution, side pots and settlement
+ */
+
+#include "../include/poker_showdown.h"
+#include "threads.h"
+#include <string.h>
+
+/* Fewest tables worth a thread of their own in showdown_settle_batch() */
+#define MIN_TABLES_PER_THREAD 4096
+
+/* Highest hole-card key for the high-card odd-chip rule: rank, then suit s > h > d > c */
+static unsigned high_card_key(const uint64_t hole) {
+    static const unsigned SUIT_ORDER[4] = {2, 1, 0, 3};  /* h, d, c, s */
+    const unsigned index = 63u - (unsigned)__builtin_clzll(hole);
+    const unsigned rank_base = index & ~3u;
+    unsigned best = 0;
+
+    /* Highest rank present; among its cards, the best suit */
+    for (unsigned suit = 0; suit < 4; suit++) {
+        if (hole & (UINT64_C(1) << (rank_base + suit))) {
+            const unsigned key = rank_base + SUIT_ORDER[suit];
+            best = (key > best) ? key : best;
+        }
+    }
+    return best;
+}
+
+/*
+ * Static helper: add amount split evenly between winners to shares, with
+ * the leftover chips one per winner in odd-chip order
+ */
+static void split_chips(const ShowdownPlayer* const players, const size_t num_players,
+                        const uint16_t winners, const uint64_t amount,
+                        const size_t first_seat, const int odd_chip_rule,
+                        uint64_t* const shares) {
+    size_t order[MAX_PLAYERS];
+    size_t count = 0;
+
+    if (odd_chip_rule == SHOWDOWN_ODD_CHIP_HIGH_CARD) {
+        /* Insertion sort by descending high-card key */
+        for (size_t seat = 0; seat < num_players; seat++) {
+            if (!(winners & (1u << seat))) {
+                continue;
+            }
+            const unsigned key = high_card_key(players[seat].hole);
+            size_t pos = count++;
+            while (pos > 0 && high_card_key(players[order[pos - 1]].hole) < key) {
+                order[pos] = order[pos - 1];
+                pos--;
+            }
+            order[pos] = seat;
+        }
+    } else {
+        for (size_t i = 0; i < num_players; i++) {
+            const size_t seat = (first_seat + i) % num_players;
+            if (winners & (1u << seat)) {
+                order[count++] = seat;
+            }
+        }
+    }
+
+    const uint64_t each = amount / count;
+    const uint64_t odd = amount % count;
+    for (size_t i = 0; i < count; i++) {
+        shares[order[i]] += each + (i < odd);
+    }
+}
+
+/*
+ * Static helper: check live hands (two cards each, no card seen twice)
+ * @return 0 with *out_live set to a bit per live seat, or -1 (poker_errno set)
+ */
+static int check_live_hands(const ShowdownPlayer* const players, const size_t num_players,
+                            const uint64_t board, uint16_t* const out_live) {
+    uint64_t used = board;
+    uint16_t live = 0;
+
+    if (__builtin_popcountll(board) > BOARD_SIZE || (board >> DECK_SIZE) != 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    for (size_t seat = 0; seat < num_players; seat++) {
+        if (players[seat].folded) {
+            continue;
+        }
+        const uint64_t hole = players[seat].hole;
+        if (__builtin_popcountll(hole) != HOLE_SIZE || (hole >> DECK_SIZE) != 0) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+        if (hole & used) {
+            poker_errno = POKER_EDUPLICATE;
+            return -1;
+        }
+        used |= hole;
+        live |= (uint16_t)(1u << seat);
+    }
+    if (live == 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    *out_live = live;
+    return 0;
+}
+
+/* Static helper: seats among eligible holding the highest value */
+static uint16_t best_seats(const HandValue* const values, const size_t num_players,
+                           const uint16_t eligible) {
+    HandValue best = 0;
+    uint16_t winners = 0;
+    for (size_t seat = 0; seat < num_players; seat++) {
+        if (!(eligible & (1u << seat))) {
+            continue;
+        }
+        if (values[seat] > best) {
+            best = values[seat];
+            winners = (uint16_t)(1u << seat);
+        } else if (values[seat] == best) {
+            winners |= (uint16_t)(1u << seat);
+        }
+    }
+    return winners;
+}
+
+static int valid_rules(const size_t num_players, const size_t first_seat, const int odd_chip_rule) {
+    return first_seat < num_players &&
+           (odd_chip_rule == SHOWDOWN_ODD_CHIP_POSITION || odd_chip_rule == SHOWDOWN_ODD_CHIP_HIGH_CARD);
+}
+
+int showdown_resolve(const ShowdownPlayer* const players, const size_t num_players,
+                     const uint64_t board, const ShowdownPot* const pot,
+                     uint16_t* const out_winners_mask, uint64_t* const out_shares) {
+    if (players == NULL || num_players == 0 || num_players > MAX_PLAYERS ||
+        (pot != NULL && (out_shares == NULL ||
+                         !valid_rules(num_players, pot->first_seat, pot->odd_chip_rule)))) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    uint16_t live;
+    if (check_live_hands(players, num_players, board, &live) != 0) {
+        return -1;
+    }
+
+    /* Highest HandValue wins; equal values tie */
+    uint16_t winners = live;
+    if ((live & (live - 1)) != 0) {
+        if (__builtin_popcountll(board) < 3) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+        HandValue values[MAX_PLAYERS];
+        for (size_t seat = 0; seat < num_players; seat++) {
+            values[seat] = (live & (1u << seat)) ? evaluate_mask(players[seat].hole | board) : 0;
+        }
+        winners = best_seats(values, num_players, live);
+    }
+
+    if (out_winners_mask != NULL) {
+        *out_winners_mask = winners;
+    }
+    if (pot != NULL) {
+        memset(out_shares, 0, num_players * sizeof(uint64_t));
+        split_chips(players, num_players, winners, pot->amount, pot->first_seat,
+                    pot->odd_chip_rule, out_shares);
+    }
+    return __builtin_popcount(winners);
+}
+
+int showdown_build_pots(const ShowdownTable* const table, ShowdownSidePot* const out_pots,
+                        size_t* const out_num_pots) {
+    if (table == NULL || out_pots == NULL || out_num_pots == NULL ||
+        table->num_players == 0 || table->num_players > MAX_PLAYERS) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    const size_t n = table->num_players;
+
+    /* Distinct live contribution levels, ascending */
+    uint64_t levels[MAX_PLAYERS];
+    size_t num_levels = 0;
+    for (size_t seat = 0; seat < n; seat++) {
+        if (table->players[seat].folded) {
+            continue;
+        }
+        const uint64_t level = table->contributions[seat];
+        size_t pos = num_levels;
+        while (pos > 0 && levels[pos - 1] > level) {
+            pos--;
+        }
+        if (pos > 0 && levels[pos - 1] == level) {
+            continue;
+        }
+        memmove(&levels[pos + 1], &levels[pos], (num_levels - pos) * sizeof(uint64_t));
+        levels[pos] = level;
+        num_levels++;
+    }
+    if (num_levels == 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    /* Each pot collects every seat's chips between the previous level and its own */
+    size_t num_pots = 0;
+    uint64_t previous = 0;
+    for (size_t l = 0; l < num_levels; l++) {
+        const uint64_t level = levels[l];
+        const int top = (l == num_levels - 1);
+        uint64_t amount = 0;
+        uint16_t eligible = 0;
+        for (size_t seat = 0; seat < n; seat++) {
+            const uint64_t put = table->contributions[seat];
+            const uint64_t capped = (top || put < level) ? put : level;
+            amount += (capped > previous) ? capped - previous : 0;
+            if (!table->players[seat].folded && put >= level) {
+                eligible |= (uint16_t)(1u << seat);
+            }
+        }
+        if (amount > 0) {
+            out_pots[num_pots].amount = amount;
+            out_pots[num_pots].eligible = eligible;
+            out_pots[num_pots].winners = 0;
+            num_pots++;
+        }
+        previous = level;
+    }
+
+    *out_num_pots = num_pots;
+    return 0;
+}
+
+int showdown_settle(const ShowdownTable* const table, ShowdownSettlement* const out) {
+    if (out == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    memset(out, 0, sizeof(*out));
+    out->status = POKER_EINVAL;
+    if (table == NULL || table->num_players == 0 || table->num_players > MAX_PLAYERS ||
+        !valid_rules(table->num_players, table->first_seat, table->odd_chip_rule)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    const size_t n = table->num_players;
+    uint16_t live;
+    if (check_live_hands(table->players, n, table->board, &live) != 0 ||
+        showdown_build_pots(table, out->pots, &out->num_pots) != 0) {
+        out->status = poker_errno;
+        return -1;
+    }
+
+    /* Evaluate each seat still contesting a pot once */
+    uint16_t contested = 0;
+    for (size_t p = 0; p < out->num_pots; p++) {
+        const uint16_t eligible = out->pots[p].eligible;
+        if ((eligible & (eligible - 1)) != 0) {
+            contested |= eligible;
+        }
+    }
+    if (contested != 0) {
+        if (__builtin_popcountll(table->board) < 3) {
+            poker_errno = POKER_EINVAL;
+            out->status = POKER_EINVAL;
+            return -1;
+        }
+        for (size_t seat = 0; seat < n; seat++) {
+            if (contested & (1u << seat)) {
+                out->values[seat] = evaluate_mask(table->players[seat].hole | table->board);
+            }
+        }
+    }
+
+    for (size_t p = 0; p < out->num_pots; p++) {
+        ShowdownSidePot* const pot = &out->pots[p];
+        pot->winners = best_seats(out->values, n, pot->eligible);
+        split_chips(table->players, n, pot->winners, pot->amount, table->first_seat,
+                    table->odd_chip_rule, out->payouts);
+    }
+
+    out->status = POKER_EOK;
+    return 0;
+}
+
+/* One thread's share of showdown_settle_batch() */
+typedef struct {
+    const ShowdownTable* tables;
+    ShowdownSettlement* out;
+    size_t begin;
+    size_t end;
+    size_t first_failed;    /* Index of the first failed table, or end */
+} SettleJob;
+
+static void* settle_worker(void* arg) {
+    SettleJob* const job = (SettleJob*)arg;
+    job->first_failed = job->end;
+    for (size_t i = job->begin; i < job->end; i++) {
+        if (showdown_settle(&job->tables[i], &job->out[i]) != 0 && job->first_failed == job->end) {
+            job->first_failed = i;
+        }
+    }
+    return NULL;
+}
+
+int showdown_settle_batch(const ShowdownTable* const tables, const size_t count,
+                          const size_t num_threads, ShowdownSettlement* const out) {
+    if (count > 0 && (tables == NULL || out == NULL)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    size_t threads = resolve_thread_count(num_threads);
+    const size_t useful = count / MIN_TABLES_PER_THREAD;
+    if (threads > useful) {
+        threads = (useful > 0) ? useful : 1;
+    }
+
+    SettleJob jobs[MAX_WORKER_THREADS];
+    for (size_t t = 0; t < threads; t++) {
+        jobs[t].tables = tables;
+        jobs[t].out = out;
+        jobs[t].begin = count * t / threads;
+        jobs[t].end = count * (t + 1) / threads;
+    }
+    run_threads(threads, settle_worker, jobs, sizeof(SettleJob));
+
+    /* poker_errno is per thread: report the first failure from here */
+    for (size_t t = 0; t < threads; t++) {
+        if (jobs[t].first_failed != jobs[t].end) {
+            poker_errno = out[jobs[t].first_failed].status;
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,754 @@
+/*
+ * solver.c - Discounted CFR for river subgames
+ */
+
+#include "../include/poker_solver.h"
+#include "threads.h"
+#include <math.h>
+#include <stdlib.h>
+
+/* DCFR discounting: positive regrets t^a/(t^a+1), negative t^b/(t^b+1), strategies (t/(t+1))^g */
+#define DCFR_ALPHA 1.5
+#define DCFR_BETA  0.0
+#define DCFR_GAMMA 2.0
+
+/* Fewest subtree nodes worth splitting across threads */
+#define MIN_NODES_PER_THREAD 16
+
+/* Bet amounts closer than this are the same action */
+#define AMOUNT_EPSILON 1e-9
+
+/*
+ * Tree node with its per-combo arrays
+ */
+typedef struct {
+    RiverNode info;
+    size_t subtree;            /* Nodes in the subtree, this one included */
+    double* regrets;           /* num_actions * HOLE_COMBOS cumulative regrets */
+    double* strategy_sum;      /* num_actions * HOLE_COMBOS weighted strategy sums */
+    double* current;           /* num_actions * HOLE_COMBOS regret-matched strategy */
+    double* reach;             /* Reach vector handed to this node by its parent */
+    double* values;            /* Traverser's counterfactual values on return */
+} SolverNode;
+
+struct RiverSolver {
+    RiverConfig config;
+    BoardRanking ranking;
+    double ranges[2][HOLE_COMBOS];     /* Board-blocked combos zeroed */
+    uint8_t card_a[HOLE_COMBOS];
+    uint8_t card_b[HOLE_COMBOS];
+    uint8_t live[HOLE_COMBOS];         /* Combo shares no card with the board */
+    SolverNode* nodes;
+    size_t num_nodes;
+    size_t capacity;
+    double* storage;                   /* Every per-combo array, one allocation */
+    size_t iterations;
+};
+
+/* Discount factors of one iteration */
+typedef struct {
+    double positive;
+    double negative;
+    double strategy;
+} DcfrWeights;
+
+/* One thread's share of a node's children */
+typedef struct {
+    RiverSolver* solver;
+    const SolverNode* parent;
+    int traverser;
+    const double* self;
+    const double* opp;
+    const DcfrWeights* weights;
+    size_t begin;
+    size_t end;
+    size_t threads;
+} ChildrenJob;
+
+static void traverse(RiverSolver* const s, const size_t index, const int traverser,
+                     const double* const self, const double* const opp,
+                     const DcfrWeights* const weights, const size_t threads);
+
+/* Static helper: append a node, SIZE_MAX when out of memory */
+static size_t push_node(RiverSolver* const s, const int player, const int folded,
+                        const double bets[2]) {
+    if (s->num_nodes == s->capacity) {
+        const size_t capacity = (s->capacity > 0) ? 2 * s->capacity : 64;
+        SolverNode* const nodes = realloc(s->nodes, capacity * sizeof(SolverNode));
+        if (nodes == NULL) {
+            return SIZE_MAX;
+        }
+        s->nodes = nodes;
+        s->capacity = capacity;
+    }
+    SolverNode* const node = &s->nodes[s->num_nodes];
+    node->info.player = player;
+    node->info.folded = folded;
+    node->info.bets[0] = bets[0];
+    node->info.bets[1] = bets[1];
+    node->info.num_actions = 0;
+    node->subtree = 1;
+    return s->num_nodes++;
+}
+
+/* Static helper: add a bet or raise to a node, clamped to the stack, sorted and unique */
+static void add_bet(RiverNode* const info, double amount, const double stack) {
+    if (amount > stack) {
+        amount = stack;
+    }
+    size_t at = 0;
+    while (at < info->num_actions && info->actions[at] != RIVER_ACTION_BET) {
+        at++;
+    }
+    for (; at < info->num_actions && info->amounts[at] <= amount + AMOUNT_EPSILON; at++) {
+        if (fabs(info->amounts[at] - amount) <= AMOUNT_EPSILON) {
+            return;
+        }
+    }
+    for (size_t a = info->num_actions; a > at; a--) {
+        info->actions[a] = info->actions[a - 1];
+        info->amounts[a] = info->amounts[a - 1];
+    }
+    info->actions[at] = RIVER_ACTION_BET;
+    info->amounts[at] = amount;
+    info->num_actions++;
+}
+
+/* Static helper: build the subtree where player acts facing bets, SIZE_MAX when out of memory */
+static size_t build_tree(RiverSolver* const s, const int player, const double bets[2],
+                         const unsigned raises) {
+    const RiverConfig* const config = &s->config;
+    const int opp = 1 - player;
+    const size_t index = push_node(s, player, -1, bets);
+    if (index == SIZE_MAX) {
+        return SIZE_MAX;
+    }
+
+    RiverNode info = s->nodes[index].info;
+    const int facing = bets[opp] > bets[player] + AMOUNT_EPSILON;
+    if (facing) {
+        info.actions[0] = RIVER_ACTION_FOLD;
+        info.amounts[0] = bets[player];
+        info.actions[1] = RIVER_ACTION_CALL;
+        info.amounts[1] = bets[opp];
+        info.num_actions = 2;
+        if (raises < config->max_raises && bets[opp] < config->stack) {
+            const double pot_after_call = config->pot + 2.0 * bets[opp];
+            for (size_t i = 0; i < config->num_raise_sizes[player]; i++) {
+                add_bet(&info, bets[opp] + config->raise_sizes[player][i] * pot_after_call,
+                        config->stack);
+            }
+            if (config->all_in) {
+                add_bet(&info, config->stack, config->stack);
+            }
+        }
+    } else {
+        info.actions[0] = RIVER_ACTION_CHECK;
+        info.amounts[0] = bets[player];
+        info.num_actions = 1;
+        if (bets[player] < config->stack) {
+            const double pot = config->pot + bets[0] + bets[1];
+            for (size_t i = 0; i < config->num_bet_sizes[player]; i++) {
+                add_bet(&info, bets[player] + config->bet_sizes[player][i] * pot, config->stack);
+            }
+            if (config->all_in) {
+                add_bet(&info, config->stack, config->stack);
+            }
+        }
+    }
+
+    size_t subtree = 1;
+    for (size_t a = 0; a < info.num_actions; a++) {
+        double next[2] = {bets[0], bets[1]};
+        next[player] = info.amounts[a];
+        size_t child;
+        switch (info.actions[a]) {
+        case RIVER_ACTION_FOLD:
+            child = push_node(s, -1, player, next);
+            break;
+        case RIVER_ACTION_CHECK:
+            /* OOP acts first, so an IP check closes the action */
+            child = (player == RIVER_IP) ? push_node(s, -1, -1, next)
+                                         : build_tree(s, opp, next, raises);
+            break;
+        case RIVER_ACTION_CALL:
+            child = push_node(s, -1, -1, next);
+            break;
+        default:
+            child = build_tree(s, opp, next, facing ? raises + 1 : raises);
+            break;
+        }
+        if (child == SIZE_MAX) {
+            return SIZE_MAX;
+        }
+        info.children[a] = child;
+        subtree += s->nodes[child].subtree;
+    }
+    s->nodes[index].info = info;
+    s->nodes[index].subtree = subtree;
+    return index;
+}
+
+/* Static helper: carve every node's arrays out of one allocation */
+static int allocate_storage(RiverSolver* const s) {
+    size_t total = 0;
+    for (size_t n = 0; n < s->num_nodes; n++) {
+        total += (3 * s->nodes[n].info.num_actions + 2) * (size_t)HOLE_COMBOS;
+    }
+    s->storage = (total <= SIZE_MAX / sizeof(double)) ? calloc(total, sizeof(double)) : NULL;
+    if (s->storage == NULL) {
+        return -1;
+    }
+    double* next = s->storage;
+    for (size_t n = 0; n < s->num_nodes; n++) {
+        SolverNode* const node = &s->nodes[n];
+        const size_t block = node->info.num_actions * (size_t)HOLE_COMBOS;
+        node->regrets = next;
+        node->strategy_sum = next + block;
+        node->current = next + 2 * block;
+        node->reach = next + 3 * block;
+        node->values = next + 3 * block + HOLE_COMBOS;
+        next += 3 * block + 2 * HOLE_COMBOS;
+    }
+    return 0;
+}
+
+/* Static helper: sizes must be positive and finite */
+static int valid_sizes(const double* const sizes, const size_t count) {
+    if (count > RIVER_MAX_SIZES) {
+        return 0;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!(sizes[i] > 0.0) || !isfinite(sizes[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int valid_config(const RiverConfig* const config) {
+    if (__builtin_popcountll(config->board) != BOARD_SIZE || (config->board >> DECK_SIZE) != 0 ||
+        !(config->pot > 0.0) || !isfinite(config->pot) ||
+        !(config->stack >= 0.0) || !isfinite(config->stack)) {
+        return 0;
+    }
+    for (int p = 0; p < 2; p++) {
+        if (!valid_sizes(config->bet_sizes[p], config->num_bet_sizes[p]) ||
+            !valid_sizes(config->raise_sizes[p], config->num_raise_sizes[p])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+RiverSolver* river_solver_create(const RiverConfig* const config, const double* const oop_range,
+                                 const double* const ip_range) {
+    if (config == NULL || oop_range == NULL || ip_range == NULL || !valid_config(config)) {
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+    RiverSolver* const s = malloc(sizeof(RiverSolver));
+    if (s == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    s->config = *config;
+    s->nodes = NULL;
+    s->num_nodes = 0;
+    s->capacity = 0;
+    s->storage = NULL;
+    s->iterations = 0;
+    board_ranking_build(config->board, &s->ranking);
+
+    const double* const ranges[2] = {oop_range, ip_range};
+    double sums[2] = {0.0, 0.0};
+    size_t c = 0;
+    for (uint8_t b = 1; b < DECK_SIZE; b++) {
+        for (uint8_t a = 0; a < b; a++, c++) {
+            s->card_a[c] = a;
+            s->card_b[c] = b;
+            s->live[c] = (s->ranking.position[c] != BOARD_RANK_BLOCKED);
+            for (int p = 0; p < 2; p++) {
+                const double w = ranges[p][c];
+                if (!(w >= 0.0) || !isfinite(w)) {
+                    free(s);
+                    poker_errno = POKER_EINVAL;
+                    return NULL;
+                }
+                s->ranges[p][c] = s->live[c] ? w : 0.0;
+                sums[p] += s->ranges[p][c];
+            }
+        }
+    }
+    if (!(sums[0] > 0.0) || !(sums[1] > 0.0)) {
+        free(s);
+        poker_errno = POKER_EINVAL;
+        return NULL;
+    }
+
+    const double bets[2] = {0.0, 0.0};
+    if (build_tree(s, RIVER_OOP, bets, 0) == SIZE_MAX || allocate_storage(s) != 0) {
+        river_solver_destroy(s);
+        poker_errno = POKER_ENOMEM;
+        return NULL;
+    }
+    return s;
+}
+
+void river_solver_destroy(RiverSolver* const solver) {
+    if (solver != NULL) {
+        free(solver->storage);
+        free(solver->nodes);
+        free(solver);
+    }
+}
+
+/* Static helper: traverser's values at a terminal node */
+static void terminal_values(const RiverSolver* const s, const RiverNode* const info,
+                            const int traverser, const double* const opp, double* const values) {
+    const double half_pot = 0.5 * s->config.pot;
+
+    if (info->folded < 0) {
+        board_ranking_showdown(&s->ranking, opp, values, NULL);
+        const double stake = half_pot + info->bets[0];
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            values[c] *= stake;
+        }
+        return;
+    }
+
+    /* Opposing weight left after removing the traverser's cards */
+    const double stake = (info->folded == traverser) ? -(half_pot + info->bets[traverser])
+                                                     : half_pot + info->bets[1 - traverser];
+    double total = 0.0;
+    double card[DECK_SIZE] = {0};
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        total += opp[c];
+        card[s->card_a[c]] += opp[c];
+        card[s->card_b[c]] += opp[c];
+    }
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        const double live = total - card[s->card_a[c]] - card[s->card_b[c]] + opp[c];
+        values[c] = s->live[c] ? stake * live : 0.0;
+    }
+}
+
+/* Static helper: regret matching into node->current (node->values as scratch) */
+static void current_strategy(SolverNode* const node) {
+    const size_t actions = node->info.num_actions;
+    double* const norm = node->values;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        norm[c] = 0.0;
+    }
+    for (size_t a = 0; a < actions; a++) {
+        const double* const regrets = node->regrets + a * HOLE_COMBOS;
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            norm[c] += (regrets[c] > 0.0) ? regrets[c] : 0.0;
+        }
+    }
+    const double uniform = 1.0 / (double)actions;
+    for (size_t a = 0; a < actions; a++) {
+        const double* const regrets = node->regrets + a * HOLE_COMBOS;
+        double* const current = node->current + a * HOLE_COMBOS;
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            const double positive = (regrets[c] > 0.0) ? regrets[c] : 0.0;
+            current[c] = (norm[c] > 0.0) ? positive / norm[c] : uniform;
+        }
+    }
+}
+
+/* Static helper: traverse one child with its reach vector filled in by the parent */
+static void traverse_child(RiverSolver* const s, const SolverNode* const parent, const size_t a,
+                           const int traverser, const double* const self,
+                           const double* const opp, const DcfrWeights* const weights,
+                           const size_t threads) {
+    const SolverNode* const child = &s->nodes[parent->info.children[a]];
+    const int own = (parent->info.player == traverser);
+    traverse(s, parent->info.children[a], traverser, own ? child->reach : self,
+             own ? opp : child->reach, weights, threads);
+}
+
+static void* children_worker(void* arg) {
+    ChildrenJob* const job = (ChildrenJob*)arg;
+    for (size_t a = job->begin; a < job->end; a++) {
+        traverse_child(job->solver, job->parent, a, job->traverser, job->self, job->opp,
+                       job->weights, job->threads);
+    }
+    return NULL;
+}
+
+/*
+ * Static helper: one CFR pass over a subtree for the traverser, leaving
+ * its counterfactual values in node->values. Children write disjoint
+ * subtrees, so big nodes hand them to separate threads.
+ */
+static void traverse(RiverSolver* const s, const size_t index, const int traverser,
+                     const double* const self, const double* const opp,
+                     const DcfrWeights* const weights, const size_t threads) {
+    SolverNode* const node = &s->nodes[index];
+    const size_t actions = node->info.num_actions;
+    if (node->info.player < 0) {
+        terminal_values(s, &node->info, traverser, opp, node->values);
+        return;
+    }
+
+    current_strategy(node);
+    const int own = (node->info.player == traverser);
+    const double* const acting = own ? self : opp;
+    for (size_t a = 0; a < actions; a++) {
+        const double* const current = node->current + a * HOLE_COMBOS;
+        double* const reach = s->nodes[node->info.children[a]].reach;
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            reach[c] = acting[c] * current[c];
+        }
+    }
+
+    size_t jobs = (threads < actions) ? threads : actions;
+    if (node->subtree < jobs * MIN_NODES_PER_THREAD) {
+        jobs = 1;
+    }
+    if (jobs > 1) {
+        ChildrenJob work[RIVER_MAX_ACTIONS];
+        for (size_t t = 0; t < jobs; t++) {
+            work[t].solver = s;
+            work[t].parent = node;
+            work[t].traverser = traverser;
+            work[t].self = self;
+            work[t].opp = opp;
+            work[t].weights = weights;
+            work[t].begin = actions * t / jobs;
+            work[t].end = actions * (t + 1) / jobs;
+            work[t].threads = threads * (t + 1) / jobs - threads * t / jobs;
+        }
+        run_threads(jobs, children_worker, work, sizeof(ChildrenJob));
+    } else {
+        for (size_t a = 0; a < actions; a++) {
+            traverse_child(s, node, a, traverser, self, opp, weights, 1);
+        }
+    }
+
+    double* const values = node->values;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        values[c] = 0.0;
+    }
+    if (!own) {
+        for (size_t a = 0; a < actions; a++) {
+            const double* const child = s->nodes[node->info.children[a]].values;
+            for (size_t c = 0; c < HOLE_COMBOS; c++) {
+                values[c] += child[c];
+            }
+        }
+        return;
+    }
+
+    for (size_t a = 0; a < actions; a++) {
+        const double* const current = node->current + a * HOLE_COMBOS;
+        const double* const child = s->nodes[node->info.children[a]].values;
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            values[c] += current[c] * child[c];
+        }
+    }
+    for (size_t a = 0; a < actions; a++) {
+        const double* const current = node->current + a * HOLE_COMBOS;
+        const double* const child = s->nodes[node->info.children[a]].values;
+        double* const regrets = node->regrets + a * HOLE_COMBOS;
+        double* const sums = node->strategy_sum + a * HOLE_COMBOS;
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            const double discount = (regrets[c] > 0.0) ? weights->positive : weights->negative;
+            regrets[c] = regrets[c] * discount + child[c] - values[c];
+            sums[c] = sums[c] * weights->strategy + self[c] * current[c];
+        }
+    }
+}
+
+int river_solver_run(RiverSolver* const solver, const size_t iterations,
+                     const size_t num_threads) {
+    if (solver == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    const size_t threads = resolve_thread_count(num_threads);
+    for (size_t i = 0; i < iterations; i++) {
+        /* Factors for what was accumulated over the previous t iterations */
+        const double t = (double)solver->iterations++;
+        const double pos = pow(t, DCFR_ALPHA);
+        const double neg = pow(t, DCFR_BETA);
+        const DcfrWeights weights = {pos / (pos + 1.0), neg / (neg + 1.0),
+                                     pow(t / (t + 1.0), DCFR_GAMMA)};
+        for (int p = 0; p < 2; p++) {
+            traverse(solver, 0, p, solver->ranges[p], solver->ranges[1 - p], &weights, threads);
+        }
+    }
+    return 0;
+}
+
+size_t river_solver_num_nodes(const RiverSolver* const solver) {
+    return (solver != NULL) ? solver->num_nodes : 0;
+}
+
+int river_solver_node(const RiverSolver* const solver, const size_t node, RiverNode* const out) {
+    if (solver == NULL || out == NULL || node >= solver->num_nodes) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    *out = solver->nodes[node].info;
+    return 0;
+}
+
+int river_solver_strategy(const RiverSolver* const solver, const size_t node,
+                          double* const out) {
+    if (solver == NULL || out == NULL || node >= solver->num_nodes ||
+        solver->nodes[node].info.player < 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    const SolverNode* const n = &solver->nodes[node];
+    const size_t actions = n->info.num_actions;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        double total = 0.0;
+        for (size_t a = 0; a < actions; a++) {
+            total += n->strategy_sum[a * HOLE_COMBOS + c];
+        }
+        for (size_t a = 0; a < actions; a++) {
+            out[a * HOLE_COMBOS + c] = (total > 0.0) ? n->strategy_sum[a * HOLE_COMBOS + c] / total
+                                                     : 1.0 / (double)actions;
+        }
+    }
+    return 0;
+}
+
+int river_solver_set_strategy(RiverSolver* const solver, const size_t node,
+                              const double* const strategy) {
+    if (solver == NULL || strategy == NULL || node >= solver->num_nodes ||
+        solver->nodes[node].info.player < 0) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    SolverNode* const n = &solver->nodes[node];
+    const size_t entries = n->info.num_actions * (size_t)HOLE_COMBOS;
+    for (size_t i = 0; i < entries; i++) {
+        if (!(strategy[i] >= 0.0) || !isfinite(strategy[i])) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+    }
+    for (size_t i = 0; i < entries; i++) {
+        n->strategy_sum[i] = strategy[i];
+    }
+    return 0;
+}
+
+/*
+ * Best response: the responder picks its best action per combo at its
+ * own nodes while the other player follows the average strategy. Each
+ * pass has its own buffers, so it leaves the solver untouched.
+ */
+typedef struct {
+    const RiverSolver* solver;
+    int player;
+    double* reach;       /* num_nodes * HOLE_COMBOS opposing reach handed to each node */
+    double* values;      /* num_nodes * HOLE_COMBOS responder values per node */
+} BestResponse;
+
+/* One thread's share of a node's children in a best-response pass */
+typedef struct {
+    const BestResponse* br;
+    size_t parent;
+    const double* opp;
+    size_t begin;
+    size_t end;
+    size_t threads;
+} ResponseJob;
+
+/* One player's best response inside river_solver_exploitability() */
+typedef struct {
+    const RiverSolver* solver;
+    int player;
+    size_t threads;
+    double value;
+    int status;
+} ResponseTask;
+
+static void respond(const BestResponse* const br, const size_t index, const double* const opp,
+                    const size_t threads);
+
+/* Static helper: respond in one child, passing the parent's reach or the child's own */
+static void respond_child(const BestResponse* const br, const size_t parent, const size_t a,
+                          const double* const opp, const size_t threads) {
+    const RiverNode* const info = &br->solver->nodes[parent].info;
+    const size_t child = info->children[a];
+    respond(br, child, (info->player == br->player) ? opp : br->reach + child * HOLE_COMBOS,
+            threads);
+}
+
+static void* response_worker(void* arg) {
+    ResponseJob* const job = (ResponseJob*)arg;
+    for (size_t a = job->begin; a < job->end; a++) {
+        respond_child(job->br, job->parent, a, job->opp, job->threads);
+    }
+    return NULL;
+}
+
+/* Static helper: responder values of a subtree against the opposing reach */
+static void respond(const BestResponse* const br, const size_t index, const double* const opp,
+                    const size_t threads) {
+    const RiverSolver* const s = br->solver;
+    const SolverNode* const node = &s->nodes[index];
+    const size_t actions = node->info.num_actions;
+    double* const values = br->values + index * HOLE_COMBOS;
+    if (node->info.player < 0) {
+        terminal_values(s, &node->info, br->player, opp, values);
+        return;
+    }
+
+    const int own = (node->info.player == br->player);
+    if (!own) {
+        /* Opposing reach through each action of the average strategy (values as scratch) */
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            values[c] = 0.0;
+        }
+        for (size_t a = 0; a < actions; a++) {
+            const double* const sums = node->strategy_sum + a * HOLE_COMBOS;
+            for (size_t c = 0; c < HOLE_COMBOS; c++) {
+                values[c] += sums[c];
+            }
+        }
+        const double uniform = 1.0 / (double)actions;
+        for (size_t a = 0; a < actions; a++) {
+            const double* const sums = node->strategy_sum + a * HOLE_COMBOS;
+            double* const reach = br->reach + node->info.children[a] * HOLE_COMBOS;
+            for (size_t c = 0; c < HOLE_COMBOS; c++) {
+                reach[c] = opp[c] * ((values[c] > 0.0) ? sums[c] / values[c] : uniform);
+            }
+        }
+    }
+
+    size_t jobs = (threads < actions) ? threads : actions;
+    if (node->subtree < jobs * MIN_NODES_PER_THREAD) {
+        jobs = 1;
+    }
+    if (jobs > 1) {
+        ResponseJob work[RIVER_MAX_ACTIONS];
+        for (size_t t = 0; t < jobs; t++) {
+            work[t].br = br;
+            work[t].parent = index;
+            work[t].opp = opp;
+            work[t].begin = actions * t / jobs;
+            work[t].end = actions * (t + 1) / jobs;
+            work[t].threads = threads * (t + 1) / jobs - threads * t / jobs;
+        }
+        run_threads(jobs, response_worker, work, sizeof(ResponseJob));
+    } else {
+        for (size_t a = 0; a < actions; a++) {
+            respond_child(br, index, a, opp, 1);
+        }
+    }
+
+    const double* const first = br->values + node->info.children[0] * HOLE_COMBOS;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        values[c] = first[c];
+    }
+    for (size_t a = 1; a < actions; a++) {
+        const double* const child = br->values + node->info.children[a] * HOLE_COMBOS;
+        if (own) {
+            for (size_t c = 0; c < HOLE_COMBOS; c++) {
+                values[c] = (child[c] > values[c]) ? child[c] : values[c];
+            }
+        } else {
+            for (size_t c = 0; c < HOLE_COMBOS; c++) {
+                values[c] += child[c];
+            }
+        }
+    }
+}
+
+/*
+ * Static helper: best-response value of one player per pair of hands
+ * dealt, and per combo when out_values is given; -1 when out of memory
+ */
+static int best_response(const RiverSolver* const s, const int player, const size_t threads,
+                         double* const out_value, double* const out_values) {
+    const size_t size = s->num_nodes * (size_t)HOLE_COMBOS;
+    BestResponse br = {s, player, NULL, NULL};
+    br.reach = malloc(2 * size * sizeof(double));
+    if (br.reach == NULL) {
+        return -1;
+    }
+    br.values = br.reach + size;
+
+    const double* const opp = s->ranges[1 - player];
+    respond(&br, 0, opp, threads);
+
+    /* Normalize by the opposing weight each combo can face */
+    double total = 0.0;
+    double card[DECK_SIZE] = {0};
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        total += opp[c];
+        card[s->card_a[c]] += opp[c];
+        card[s->card_b[c]] += opp[c];
+    }
+    double value = 0.0;
+    double pairs = 0.0;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        const double live = s->live[c] ? total - card[s->card_a[c]] - card[s->card_b[c]] + opp[c]
+                                       : 0.0;
+        value += s->ranges[player][c] * br.values[c];
+        pairs += s->ranges[player][c] * live;
+        if (out_values != NULL) {
+            out_values[c] = (live > 0.0) ? br.values[c] / live : 0.0;
+        }
+    }
+    *out_value = (pairs > 0.0) ? value / pairs : 0.0;
+    free(br.reach);
+    return 0;
+}
+
+int river_solver_best_response(const RiverSolver* const solver, const int player,
+                               const size_t num_threads, double* const out_value,
+                               double* const out_values) {
+    if (solver == NULL || out_value == NULL || (player != RIVER_OOP && player != RIVER_IP)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    if (best_response(solver, player, resolve_thread_count(num_threads), out_value,
+                      out_values) != 0) {
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    return 0;
+}
+
+static void* response_task_worker(void* arg) {
+    ResponseTask* const task = (ResponseTask*)arg;
+    task->status = best_response(task->solver, task->player, task->threads, &task->value, NULL);
+    return NULL;
+}
+
+int river_solver_exploitability(const RiverSolver* const solver, const size_t num_threads,
+                                double* const out) {
+    if (solver == NULL || out == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    /* The two best responses are independent: one per thread when there are two */
+    const size_t threads = resolve_thread_count(num_threads);
+    const size_t tasks = (threads > 1) ? 2 : 1;
+    ResponseTask work[2];
+    for (int p = 0; p < 2; p++) {
+        work[p].solver = solver;
+        work[p].player = p;
+        work[p].threads = (tasks > 1) ? (threads + (size_t)(1 - p)) / 2 : 1;
+    }
+    if (tasks > 1) {
+        run_threads(2, response_task_worker, work, sizeof(ResponseTask));
+    } else {
+        response_task_worker(&work[0]);
+        response_task_worker(&work[1]);
+    }
+    if (work[0].status != 0 || work[1].status != 0) {
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    *out = 0.5 * (work[0].value + work[1].value);
+    return 0;
+}
@@ -0,0 +1,573 @@
+/*
+ * strength.c - Hand strength (HS), effective hand strength (EHS, EHS²),
+ * hand potential (PPot, NPot) and outs
+ */
+
+#include "../include/poker_strength.h"
+#include "../include/poker_boardrank.h"
+#include "threads.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Fewest runouts worth a thread of their own in hand_potential() */
+#define MIN_RUNOUTS_PER_THREAD 64
+
+/* Marks a combo without an HS on a board (blocked, or empty range) */
+#define NO_STRENGTH (-1.0)
+
+/*
+ * Scratch for ranking every combo on a board
+ */
+typedef struct {
+    BoardRanking ranking;            /* Board being ranked */
+    double values[HOLE_COMBOS];      /* Showdown values against the range */
+    double totals[HOLE_COMBOS];      /* Range weight left after card removal */
+    double hs[HOLE_COMBOS];          /* HS on the board being ranked */
+    double sum[HOLE_COMBOS];
+    double sum_sq[HOLE_COMBOS];
+    uint32_t runouts[HOLE_COMBOS];
+} RankWork;
+
+int hole_combo_index(const uint64_t hole) {
+    if (__builtin_popcountll(hole) != HOLE_SIZE || (hole >> DECK_SIZE) != 0) {
+        return -1;
+    }
+    const int a = __builtin_ctzll(hole);
+    const int b = 63 - __builtin_clzll(hole);
+    return b * (b - 1) / 2 + a;
+}
+
+uint64_t hole_combo_mask(const size_t index) {
+    if (index >= HOLE_COMBOS) {
+        return 0;
+    }
+    size_t b = 1;
+    while ((b + 1) * b / 2 <= index) {
+        b++;
+    }
+    const size_t a = index - b * (b - 1) / 2;
+    return (UINT64_C(1) << a) | (UINT64_C(1) << b);
+}
+
+static int valid_weights(const double* const weights) {
+    if (weights == NULL) {
+        return 1;
+    }
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        if (!(weights[c] >= 0.0)) {   /* Also rejects NaN */
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int valid_board(const uint64_t board) {
+    const int cards = __builtin_popcountll(board);
+    return cards >= 3 && cards <= BOARD_SIZE && (board >> DECK_SIZE) == 0;
+}
+
+/*
+ * Static helper: HS of every combo on a board (w->hs; NO_STRENGTH where
+ * undefined). Uniform ranges read the ranking's counts; weighted ones take
+ * one showdown sweep, HS being (total + value) / (2 * total).
+ */
+static void rank_board(RankWork* const w, const uint64_t board, const double* const weights) {
+    const BoardRanking* const r = &w->ranking;
+    board_ranking_build(board, &w->ranking);
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        w->hs[c] = NO_STRENGTH;
+    }
+    if (weights == NULL) {
+        for (size_t k = 0; k < r->num_combos; k++) {
+            const size_t c = r->order[k];
+            const unsigned live = r->wins[c] + r->ties[c] + r->losses[c];
+            if (live > 0) {
+                w->hs[c] = (r->wins[c] + 0.5 * r->ties[c]) / live;
+            }
+        }
+        return;
+    }
+
+    /* Running sums leave rounding residue where card removal empties the range */
+    double range = 0.0;
+    for (size_t k = 0; k < r->num_combos; k++) {
+        range += weights[r->order[k]];
+    }
+    board_ranking_showdown(r, weights, w->values, w->totals);
+    for (size_t k = 0; k < r->num_combos; k++) {
+        const size_t c = r->order[k];
+        if (w->totals[c] > 1e-12 * range) {
+            w->hs[c] = (w->totals[c] + w->values[c]) / (2.0 * w->totals[c]);
+        }
+    }
+}
+
+int hand_strength_all(const uint64_t board, const double* const weights,
+                      HandStrength* const out) {
+    if (out == NULL || !valid_board(board) || !valid_weights(weights)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    RankWork* const w = malloc(sizeof(RankWork));
+    if (w == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+
+    rank_board(w, board, weights);
+    size_t c;
+    for (c = 0; c < HOLE_COMBOS; c++) {
+        out[c].hs = (w->hs[c] > 0.0) ? w->hs[c] : 0.0;
+        w->sum[c] = 0.0;
+        w->sum_sq[c] = 0.0;
+        w->runouts[c] = 0;
+    }
+
+    /* Every runout: one or two cards not on the board */
+    uint8_t deck[DECK_SIZE];
+    size_t num_deck = 0;
+    for (uint8_t card = 0; card < DECK_SIZE; card++) {
+        if (!(board & (UINT64_C(1) << card))) {
+            deck[num_deck++] = card;
+        }
+    }
+    const int missing = BOARD_SIZE - __builtin_popcountll(board);
+    for (size_t x = 0; missing > 0 && x < num_deck; x++) {
+        for (size_t y = (missing == 2) ? x + 1 : num_deck - 1; y < num_deck; y++) {
+            uint64_t full = board | (UINT64_C(1) << deck[x]);
+            if (missing == 2) {
+                full |= UINT64_C(1) << deck[y];
+            }
+            rank_board(w, full, weights);
+            for (c = 0; c < HOLE_COMBOS; c++) {
+                if (w->hs[c] >= 0.0) {
+                    w->sum[c] += w->hs[c];
+                    w->sum_sq[c] += w->hs[c] * w->hs[c];
+                    w->runouts[c]++;
+                }
+            }
+        }
+    }
+
+    for (c = 0; c < HOLE_COMBOS; c++) {
+        if (missing == 0) {
+            out[c].ehs = out[c].hs;
+            out[c].ehs2 = out[c].hs * out[c].hs;
+        } else if (w->runouts[c] > 0) {
+            out[c].ehs = w->sum[c] / w->runouts[c];
+            out[c].ehs2 = w->sum_sq[c] / w->runouts[c];
+        } else {
+            out[c].ehs = 0.0;
+            out[c].ehs2 = 0.0;
+        }
+    }
+    free(w);
+    return 0;
+}
+
+/* Static helper: HS of one hand on a board, or NO_STRENGTH if the range is empty */
+static double single_strength(const uint64_t hole, const uint64_t board,
+                              const double* const weights) {
+    const HandValue hero = evaluate_mask(hole | board);
+    const uint64_t blocked = hole | board;
+    double win_tie = 0.0;
+    double total = 0.0;
+    size_t c = 0;
+
+    for (unsigned b = 1; b < DECK_SIZE; b++) {
+        for (unsigned a = 0; a < b; a++, c++) {
+            const uint64_t opp = (UINT64_C(1) << a) | (UINT64_C(1) << b);
+            const double wt = weights ? weights[c] : 1.0;
+            if ((opp & blocked) != 0 || wt == 0.0) {
+                continue;
+            }
+            const HandValue value = evaluate_mask(opp | board);
+            total += wt;
+            win_tie += (hero > value) ? wt : (hero == value) ? 0.5 * wt : 0.0;
+        }
+    }
+    return (total > 0.0) ? win_tie / total : NO_STRENGTH;
+}
+
+int hand_strength(const uint64_t hole, const uint64_t board,
+                  const double* const weights, HandStrength* const out) {
+    if (out == NULL || hole_combo_index(hole) < 0 || !valid_board(board) ||
+        !valid_weights(weights)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    if (hole & board) {
+        poker_errno = POKER_EDUPLICATE;
+        return -1;
+    }
+
+    const double hs = single_strength(hole, board, weights);
+    out->hs = (hs > 0.0) ? hs : 0.0;
+
+    const int missing = BOARD_SIZE - __builtin_popcountll(board);
+    if (missing == 0) {
+        out->ehs = out->hs;
+        out->ehs2 = out->hs * out->hs;
+        return 0;
+    }
+
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    size_t runouts = 0;
+    const uint64_t used = hole | board;
+    for (unsigned x = 0; x < DECK_SIZE; x++) {
+        if (used & (UINT64_C(1) << x)) {
+            continue;
+        }
+        for (unsigned y = (missing == 2) ? x + 1 : DECK_SIZE - 1; y < DECK_SIZE; y++) {
+            uint64_t full = board | (UINT64_C(1) << x);
+            if (missing == 2) {
+                if (used & (UINT64_C(1) << y)) {
+                    continue;
+                }
+                full |= UINT64_C(1) << y;
+            }
+            const double river = single_strength(hole, full, weights);
+            if (river >= 0.0) {
+                sum += river;
+                sum_sq += river * river;
+                runouts++;
+            }
+        }
+    }
+    out->ehs = runouts ? sum / runouts : 0.0;
+    out->ehs2 = runouts ? sum_sq / runouts : 0.0;
+    return 0;
+}
+
+/*
+ * Opponents and runouts shared by every hand_potential() worker
+ */
+typedef struct {
+    uint64_t hole;
+    uint64_t board;
+    const uint64_t* opp_masks;     /* Live opponent combos */
+    const double* opp_weights;
+    const uint8_t* opp_states;     /* POTENTIAL_* on the current board */
+    size_t num_opps;
+    const uint64_t* runouts;       /* Cards completing the board */
+} PotentialShared;
+
+/* One thread's share of hand_potential() */
+typedef struct {
+    const PotentialShared* shared;
+    size_t begin;
+    size_t end;
+    double states[3][3];
+} PotentialJob;
+
+static uint8_t potential_state(const HandValue hero, const HandValue opp) {
+    return (hero > opp) ? POTENTIAL_AHEAD : (hero == opp) ? POTENTIAL_TIED : POTENTIAL_BEHIND;
+}
+
+static void* potential_worker(void* arg) {
+    PotentialJob* const job = (PotentialJob*)arg;
+    const PotentialShared* const s = job->shared;
+    double states[3][3] = {{0}};
+
+    for (size_t r = job->begin; r < job->end; r++) {
+        const uint64_t runout = s->runouts[r];
+        const uint64_t river = s->board | runout;
+        const HandValue hero = evaluate_mask(s->hole | river);
+        for (size_t o = 0; o < s->num_opps; o++) {
+            if (s->opp_masks[o] & runout) {
+                continue;
+            }
+            const HandValue opp = evaluate_mask(s->opp_masks[o] | river);
+            states[s->opp_states[o]][potential_state(hero, opp)] += s->opp_weights[o];
+        }
+    }
+    for (size_t now = 0; now < 3; now++) {
+        for (size_t later = 0; later < 3; later++) {
+            job->states[now][later] = states[now][later];
+        }
+    }
+    return NULL;
+}
+
+int hand_potential(const uint64_t hole, const uint64_t board,
+                   const double* const weights, const size_t num_threads,
+                   HandPotential* const out) {
+    const int board_cards = __builtin_popcountll(board);
+    if (out == NULL || hole_combo_index(hole) < 0 || (board >> DECK_SIZE) != 0 ||
+        board_cards < 3 || board_cards >= BOARD_SIZE || !valid_weights(weights)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    if (hole & board) {
+        poker_errno = POKER_EDUPLICATE;
+        return -1;
+    }
+
+    /* Live opponents and runouts: at most one combo per pair of unseen cards */
+    uint64_t* const opp_masks = malloc(2 * HOLE_COMBOS * sizeof(uint64_t));
+    double* const opp_weights = malloc(HOLE_COMBOS * sizeof(double));
+    uint8_t* const opp_states = malloc(HOLE_COMBOS);
+    if (opp_masks == NULL || opp_weights == NULL || opp_states == NULL) {
+        free(opp_masks);
+        free(opp_weights);
+        free(opp_states);
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    uint64_t* const runouts = opp_masks + HOLE_COMBOS;
+
+    const uint64_t used = hole | board;
+    const HandValue hero = evaluate_mask(used);
+    double now[3] = {0.0, 0.0, 0.0};
+    size_t num_opps = 0;
+    size_t c = 0;
+    for (unsigned b = 1; b < DECK_SIZE; b++) {
+        for (unsigned a = 0; a < b; a++, c++) {
+            const uint64_t opp = (UINT64_C(1) << a) | (UINT64_C(1) << b);
+            const double wt = weights ? weights[c] : 1.0;
+            if ((opp & used) != 0 || wt == 0.0) {
+                continue;
+            }
+            opp_masks[num_opps] = opp;
+            opp_weights[num_opps] = wt;
+            opp_states[num_opps] = potential_state(hero, evaluate_mask(opp | board));
+            now[opp_states[num_opps]] += wt;
+            num_opps++;
+        }
+    }
+
+    size_t num_runouts = 0;
+    for (unsigned x = 0; x < DECK_SIZE; x++) {
+        if (used & (UINT64_C(1) << x)) {
+            continue;
+        }
+        if (board_cards == BOARD_SIZE - 1) {
+            runouts[num_runouts++] = UINT64_C(1) << x;
+            continue;
+        }
+        for (unsigned y = x + 1; y < DECK_SIZE; y++) {
+            if (!(used & (UINT64_C(1) << y))) {
+                runouts[num_runouts++] = (UINT64_C(1) << x) | (UINT64_C(1) << y);
+            }
+        }
+    }
+
+    size_t threads = resolve_thread_count(num_threads);
+    const size_t useful = num_runouts / MIN_RUNOUTS_PER_THREAD;
+    if (threads > useful) {
+        threads = (useful > 0) ? useful : 1;
+    }
+
+    const PotentialShared shared = {hole, board, opp_masks, opp_weights, opp_states,
+                                    num_opps, runouts};
+    PotentialJob jobs[MAX_WORKER_THREADS];
+    for (size_t t = 0; t < threads; t++) {
+        jobs[t].shared = &shared;
+        jobs[t].begin = num_runouts * t / threads;
+        jobs[t].end = num_runouts * (t + 1) / threads;
+    }
+    run_threads(threads, potential_worker, jobs, sizeof(PotentialJob));
+
+    double hp[3][3] = {{0}};
+    double total[3] = {0.0, 0.0, 0.0};
+    for (size_t t = 0; t < threads; t++) {
+        for (size_t i = 0; i < 3; i++) {
+            for (size_t j = 0; j < 3; j++) {
+                hp[i][j] += jobs[t].states[i][j];
+                total[i] += jobs[t].states[i][j];
+            }
+        }
+    }
+    free(opp_masks);
+    free(opp_weights);
+    free(opp_states);
+
+    const double range = now[POTENTIAL_AHEAD] + now[POTENTIAL_TIED] + now[POTENTIAL_BEHIND];
+    out->hs = (range > 0.0) ? (now[POTENTIAL_AHEAD] + 0.5 * now[POTENTIAL_TIED]) / range : 0.0;
+
+    const double from_behind = total[POTENTIAL_BEHIND] + 0.5 * total[POTENTIAL_TIED];
+    const double from_ahead = total[POTENTIAL_AHEAD] + 0.5 * total[POTENTIAL_TIED];
+    const double gained = hp[POTENTIAL_BEHIND][POTENTIAL_AHEAD] +
+                          0.5 * hp[POTENTIAL_BEHIND][POTENTIAL_TIED] +
+                          0.5 * hp[POTENTIAL_TIED][POTENTIAL_AHEAD];
+    const double lost = hp[POTENTIAL_AHEAD][POTENTIAL_BEHIND] +
+                        0.5 * hp[POTENTIAL_TIED][POTENTIAL_BEHIND] +
+                        0.5 * hp[POTENTIAL_AHEAD][POTENTIAL_TIED];
+    out->ppot = (from_behind > 0.0) ? gained / from_behind : 0.0;
+    out->npot = (from_ahead > 0.0) ? lost / from_ahead : 0.0;
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 3; j++) {
+            out->states[i][j] = hp[i][j];
+        }
+    }
+    return 0;
+}
+
+/* Static helper: the four 13-bit suit masks of a card mask */
+static void suits_of(uint64_t mask, uint32_t suits[4]) {
+    suits[0] = suits[1] = suits[2] = suits[3] = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        const unsigned card = (unsigned)__builtin_ctzll(mask);
+        suits[card & 3] |= 1u << (card >> 2);
+    }
+}
+
+/* Static helper: add or remove one card from suit masks */
+static void flip_card(uint32_t suits[4], const unsigned card) {
+    suits[card & 3] ^= 1u << (card >> 2);
+}
+
+/* Static helper: validate the hand, board and result of the outs functions */
+static int outs_valid(const uint64_t hole, const uint64_t board, const HandOuts* const out) {
+    const int board_cards = __builtin_popcountll(board);
+    if (out == NULL || hole_combo_index(hole) < 0 || (board >> DECK_SIZE) != 0 ||
+        board_cards < 3 || board_cards >= BOARD_SIZE) {
+        poker_errno = POKER_EINVAL;
+        return 0;
+    }
+    if (hole & board) {
+        poker_errno = POKER_EDUPLICATE;
+        return 0;
+    }
+    return 1;
+}
+
+/* Static helper: reset out and fill the hand's value with each unseen card added */
+static void outs_values(const uint64_t hole, const uint64_t board, const uint64_t used,
+                        HandOuts* const out) {
+    memset(out, 0, sizeof(*out));
+    const HandCategory now = HAND_VALUE_CATEGORY(evaluate_mask(hole | board));
+    uint32_t suits[4];
+    suits_of(hole | board, suits);
+    for (unsigned card = 0; card < DECK_SIZE; card++) {
+        if (used & (UINT64_C(1) << card)) {
+            continue;
+        }
+        flip_card(suits, card);
+        out->values[card] = evaluate_suits(suits);
+        flip_card(suits, card);
+        if (HAND_VALUE_CATEGORY(out->values[card]) > now) {
+            out->improves |= UINT64_C(1) << card;
+        }
+    }
+}
+
+int compute_outs(const uint64_t hole, const uint64_t board,
+                 const uint64_t* const opponents, const size_t num_opponents,
+                 HandOuts* const out) {
+    if (!outs_valid(hole, board, out)) {
+        return -1;
+    }
+    if (opponents == NULL || num_opponents == 0 || num_opponents >= MAX_PLAYERS) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    uint64_t used = hole | board;
+    for (size_t p = 0; p < num_opponents; p++) {
+        if (hole_combo_index(opponents[p]) < 0) {
+            poker_errno = POKER_EINVAL;
+            return -1;
+        }
+        if (opponents[p] & used) {
+            poker_errno = POKER_EDUPLICATE;
+            return -1;
+        }
+        used |= opponents[p];
+    }
+    outs_values(hole, board, used, out);
+
+    /* Best opponent value and how many hold it, per card */
+    HandValue best[DECK_SIZE] = {0};
+    uint8_t holding[DECK_SIZE] = {0};
+    for (size_t p = 0; p < num_opponents; p++) {
+        uint32_t suits[4];
+        suits_of(opponents[p] | board, suits);
+        for (unsigned card = 0; card < DECK_SIZE; card++) {
+            if (used & (UINT64_C(1) << card)) {
+                continue;
+            }
+            flip_card(suits, card);
+            const HandValue value = evaluate_suits(suits);
+            flip_card(suits, card);
+            if (value > best[card]) {
+                best[card] = value;
+                holding[card] = 1;
+            } else if (value == best[card]) {
+                holding[card]++;
+            }
+        }
+    }
+
+    for (unsigned card = 0; card < DECK_SIZE; card++) {
+        const uint64_t bit = UINT64_C(1) << card;
+        if (used & bit) {
+            continue;
+        }
+        if (out->values[card] > best[card]) {
+            out->ahead |= bit;
+            out->share[card] = 1.0;
+        } else if (out->values[card] == best[card]) {
+            out->tied |= bit;
+            out->share[card] = 1.0 / (holding[card] + 1);
+        } else {
+            out->behind |= bit;
+        }
+    }
+    return 0;
+}
+
+int compute_outs_range(const uint64_t hole, const uint64_t board,
+                       const double* const weights, HandOuts* const out) {
+    if (!outs_valid(hole, board, out)) {
+        return -1;
+    }
+    if (!valid_weights(weights)) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    const uint64_t used = hole | board;
+    outs_values(hole, board, used, out);
+
+    double win_tie[DECK_SIZE] = {0};
+    double total[DECK_SIZE] = {0};
+    size_t c = 0;
+    for (unsigned b = 1; b < DECK_SIZE; b++) {
+        for (unsigned a = 0; a < b; a++, c++) {
+            const uint64_t opp = (UINT64_C(1) << a) | (UINT64_C(1) << b);
+            const double wt = weights ? weights[c] : 1.0;
+            if ((opp & used) != 0 || wt == 0.0) {
+                continue;
+            }
+            uint32_t suits[4];
+            suits_of(opp | board, suits);
+            for (unsigned card = 0; card < DECK_SIZE; card++) {
+                if ((used | opp) & (UINT64_C(1) << card)) {
+                    continue;
+                }
+                flip_card(suits, card);
+                const HandValue value = evaluate_suits(suits);
+                flip_card(suits, card);
+                total[card] += wt;
+                win_tie[card] += (out->values[card] > value) ? wt
+                               : (out->values[card] == value) ? 0.5 * wt : 0.0;
+            }
+        }
+    }
+
+    for (unsigned card = 0; card < DECK_SIZE; card++) {
+        const uint64_t bit = UINT64_C(1) << card;
+        if (used & bit) {
+            continue;
+        }
+        out->share[card] = (total[card] > 0.0) ? win_tie[card] / total[card] : 0.0;
+        if (out->share[card] > 0.5) {
+            out->ahead |= bit;
+        } else if (out->share[card] == 0.5) {
+            out->tied |= bit;
+        } else {
+            out->behind |= bit;
+        }
+    }
+    return 0;
+}
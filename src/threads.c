@@ -0,0 +1,47 @@
+/*
+ * threads.c - Internal worker-thread helpers
+ * Shared by the modules that split work across POSIX threads
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "threads.h"
+#include <pthread.h>
+#include <unistd.h>
+
+size_t resolve_thread_count(const size_t requested) {
+    size_t count = requested;
+
+    if (count == 0) {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        count = (online > 0) ? (size_t)online : 1;
+    }
+    if (count > MAX_WORKER_THREADS) {
+        count = MAX_WORKER_THREADS;
+    }
+    return count;
+}
+
+void run_threads(const size_t num_threads, void* (*worker)(void*),
+                 void* const args, const size_t arg_size) {
+    pthread_t threads[MAX_WORKER_THREADS];
+    int started[MAX_WORKER_THREADS];
+    char* const base = (char*)args;
+    const size_t count = (num_threads > MAX_WORKER_THREADS) ? MAX_WORKER_THREADS : num_threads;
+
+    for (size_t i = 1; i < count; i++) {
+        started[i] = (pthread_create(&threads[i], NULL, worker, base + i * arg_size) == 0);
+    }
+
+    if (count > 0) {
+        worker(base);
+    }
+
+    for (size_t i = 1; i < count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            worker(base + i * arg_size);
+        }
+    }
+}
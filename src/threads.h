@@ -0,0 +1,41 @@
+/*
+ * threads.h - Internal worker-thread helpers (threads.c)
+ * Private to the library; not installed with the public headers
+ */
+
+#ifndef POKER_THREADS_H
+#define POKER_THREADS_H
+
+#include "../include/poker.h"
+
+/* Upper bound on worker threads, protects against runaway requests */
+#define MAX_WORKER_THREADS POKER_MAX_THREADS
+
+/**
+ * @brief Resolve a requested thread count to the number actually used
+ *
+ * A request of 0 means "one per online CPU". The result is always in
+ * [1, MAX_WORKER_THREADS].
+ *
+ * @param requested Requested thread count (0 = auto)
+ * @return Thread count to use
+ */
+size_t resolve_thread_count(const size_t requested);
+
+/**
+ * @brief Run worker(args[i]) for i in [0, num_threads) and wait for all
+ *
+ * args points to an array of num_threads elements of arg_size bytes; worker
+ * i receives a pointer to element i. Worker 0 runs on the calling thread so
+ * a single-thread call never spawns. If a thread cannot be created, its
+ * work runs on the calling thread instead, so every worker always runs.
+ *
+ * @param num_threads Number of workers (at most MAX_WORKER_THREADS)
+ * @param worker Worker function
+ * @param args Array of per-worker arguments
+ * @param arg_size Size of one argument element
+ */
+void run_threads(const size_t num_threads, void* (*worker)(void*),
+                 void* const args, const size_t arg_size);
+
+#endif /* POKER_THREADS_H */
@@ -0,0 +1,481 @@
+/*
+ * tournament.c - Multi-table tournament simulator
+ */
+
+#include "../include/poker_tournament.h"
+#include "threads.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Empty seat in TournamentState.seat_player */
+#define EMPTY_SEAT UINT32_MAX
+
+/*
+ * Scratch state for playing tournaments, reused across tournaments of a thread
+ */
+typedef struct {
+    GameTables* game;
+    size_t num_tables;         /* Tables at the start (GameTables capacity) */
+    uint32_t* seat_player;     /* num_tables * table_size: entrant or EMPTY_SEAT */
+    uint32_t* stacks;          /* Per entrant */
+    uint32_t* hand_start;      /* Per entrant: stack when its last hand began */
+    uint32_t* order;           /* Per entrant: seating shuffle and bust ordering */
+    uint8_t* button;           /* Per table */
+    uint8_t* count;            /* Per table: players seated (0 = table broken) */
+} TournamentState;
+
+uint64_t tournament_random(uint64_t* const rng) {
+    uint64_t z = (*rng += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+/* Static helper: uniform integer in [0, n) */
+static size_t random_below(uint64_t* const rng, const size_t n) {
+    return (size_t)(((tournament_random(rng) >> 32) * (uint64_t)n) >> 32);
+}
+
+static int valid_config(const TournamentConfig* const c) {
+    if (c == NULL || c->num_players < 2 || c->num_players > UINT32_MAX - 1 ||
+        c->table_size < 2 || c->table_size > MAX_PLAYERS || c->starting_stack == 0 ||
+        (uint64_t)c->num_players * c->starting_stack > UINT32_MAX ||
+        c->levels == NULL || c->num_levels == 0 || c->hands_per_level == 0 ||
+        c->num_payouts > c->num_players || (c->num_payouts > 0 && c->payouts == NULL) ||
+        c->policies == NULL || c->num_policies == 0 || c->num_policies > TOURNAMENT_MAX_POLICIES) {
+        return 0;
+    }
+    for (size_t l = 0; l < c->num_levels; l++) {
+        if (c->levels[l].small_blind == 0 || c->levels[l].big_blind < c->levels[l].small_blind) {
+            return 0;
+        }
+    }
+    for (size_t p = 0; p < c->num_policies; p++) {
+        if (c->policies[p].decide == NULL) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void state_free(TournamentState* const s) {
+    game_tables_destroy(s->game);
+    free(s->seat_player);
+    free(s->stacks);
+    free(s->hand_start);
+    free(s->order);
+    free(s->button);
+    free(s->count);
+    memset(s, 0, sizeof(*s));
+}
+
+/* Static helper: allocate scratch for a configuration (poker_errno set on failure) */
+static int state_init(TournamentState* const s, const TournamentConfig* const c) {
+    memset(s, 0, sizeof(*s));
+    s->num_tables = (c->num_players + c->table_size - 1) / c->table_size;
+    const GameConfig game = {c->table_size, c->levels[0].small_blind,
+                             c->levels[0].big_blind, c->starting_stack};
+    s->game = game_tables_create(&game, s->num_tables);
+    s->seat_player = malloc(s->num_tables * c->table_size * sizeof(uint32_t));
+    s->stacks = malloc(c->num_players * sizeof(uint32_t));
+    s->hand_start = malloc(c->num_players * sizeof(uint32_t));
+    s->order = malloc(c->num_players * sizeof(uint32_t));
+    s->button = malloc(s->num_tables);
+    s->count = malloc(s->num_tables);
+    if (s->game == NULL || s->seat_player == NULL || s->stacks == NULL ||
+        s->hand_start == NULL || s->order == NULL || s->button == NULL || s->count == NULL) {
+        state_free(s);
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    return 0;
+}
+
+/* Static helper: next occupied seat after seat at a table */
+static size_t next_occupied(const TournamentState* const s, const size_t ts,
+                            const size_t table, const size_t seat) {
+    for (size_t i = 1; i <= ts; i++) {
+        const size_t next = (seat + i) % ts;
+        if (s->seat_player[table * ts + next] != EMPTY_SEAT) {
+            return next;
+        }
+    }
+    return seat;
+}
+
+/* Static helper: seat a player in the first empty seat of a table */
+static void seat_player(TournamentState* const s, const size_t ts, const size_t table,
+                        const uint32_t player) {
+    for (size_t seat = 0; seat < ts; seat++) {
+        if (s->seat_player[table * ts + seat] == EMPTY_SEAT) {
+            s->seat_player[table * ts + seat] = player;
+            s->count[table]++;
+            return;
+        }
+    }
+}
+
+/* Static helper: open table with the fewest (lowest index) or most (highest index) players */
+static size_t pick_table(const TournamentState* const s, const size_t skip, const int most) {
+    size_t best = SIZE_MAX;
+    for (size_t t = 0; t < s->num_tables; t++) {
+        if (s->count[t] == 0 || t == skip) {
+            continue;
+        }
+        if (best == SIZE_MAX || (most ? s->count[t] >= s->count[best] : s->count[t] < s->count[best])) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+/*
+ * Static helper: break tables the field no longer needs, then move players
+ * from the biggest table to the smallest until counts differ by at most one
+ */
+static void balance_tables(TournamentState* const s, const size_t ts, const size_t remaining) {
+    const size_t needed = (remaining + ts - 1) / ts;
+    size_t open = 0;
+    for (size_t t = 0; t < s->num_tables; t++) {
+        open += (s->count[t] > 0);
+    }
+
+    while (open > needed) {
+        /* Smallest table, highest index on ties */
+        size_t broken = SIZE_MAX;
+        for (size_t t = 0; t < s->num_tables; t++) {
+            if (s->count[t] > 0 && (broken == SIZE_MAX || s->count[t] <= s->count[broken])) {
+                broken = t;
+            }
+        }
+        for (size_t seat = 0; seat < ts; seat++) {
+            const uint32_t player = s->seat_player[broken * ts + seat];
+            if (player != EMPTY_SEAT) {
+                s->seat_player[broken * ts + seat] = EMPTY_SEAT;
+                seat_player(s, ts, pick_table(s, broken, 0), player);
+            }
+        }
+        s->count[broken] = 0;
+        open--;
+    }
+
+    for (;;) {
+        const size_t big = pick_table(s, SIZE_MAX, 1);
+        const size_t small = pick_table(s, SIZE_MAX, 0);
+        if (big == SIZE_MAX || s->count[big] <= s->count[small] + 1) {
+            return;
+        }
+        /* Move the player due to post the next big blind */
+        const size_t sb = next_occupied(s, ts, big, s->button[big]);
+        const size_t bb = next_occupied(s, ts, big, sb);
+        const uint32_t player = s->seat_player[big * ts + bb];
+        s->seat_player[big * ts + bb] = EMPTY_SEAT;
+        s->count[big]--;
+        seat_player(s, ts, small, player);
+    }
+}
+
+/* Static helper: sort players by descending key, then by entrant number */
+static void sort_players(uint32_t* const players, const size_t n, const uint32_t* const keys) {
+    /* Insertion sort: bust lists are short */
+    for (size_t i = 1; i < n; i++) {
+        const uint32_t p = players[i];
+        size_t j = i;
+        while (j > 0 && (keys[players[j - 1]] < keys[p] ||
+                         (keys[players[j - 1]] == keys[p] && players[j - 1] > p))) {
+            players[j] = players[j - 1];
+            j--;
+        }
+        players[j] = p;
+    }
+}
+
+/* Static helper: play one hand at a table */
+static void play_hand(TournamentState* const s, const TournamentConfig* const c,
+                      const size_t table, uint64_t* const rng) {
+    GameTables* const g = s->game;
+    const size_t ts = c->table_size;
+    uint32_t stacks[MAX_PLAYERS];
+
+    if (s->seat_player[table * ts + s->button[table]] == EMPTY_SEAT) {
+        s->button[table] = (uint8_t)next_occupied(s, ts, table, s->button[table]);
+    }
+    for (size_t seat = 0; seat < ts; seat++) {
+        const uint32_t player = s->seat_player[table * ts + seat];
+        stacks[seat] = (player == EMPTY_SEAT) ? 0 : s->stacks[player];
+        if (player != EMPTY_SEAT) {
+            s->hand_start[player] = s->stacks[player];
+        }
+    }
+    game_start_hand(g, table, s->button[table], tournament_random(rng), stacks);
+
+    GameLegal legal;
+    while (game_legal_actions(g, table, &legal) == 0) {
+        const uint32_t player = s->seat_player[table * ts + legal.seat];
+        const TournamentPolicy* const policy = &c->policies[player % c->num_policies];
+        uint32_t raise_to = 0;
+        const int action = policy->decide(g, table, &legal, policy->params, rng, &raise_to);
+        if (game_apply(g, table, action, raise_to) != 0) {
+            game_apply(g, table, GAME_ACTION_CHECK_CALL, 0);
+        }
+    }
+
+    for (size_t seat = 0; seat < ts; seat++) {
+        const uint32_t player = s->seat_player[table * ts + seat];
+        if (player != EMPTY_SEAT) {
+            s->stacks[player] = g->stack[table * ts + seat];
+        }
+    }
+    s->button[table] = (uint8_t)next_occupied(s, ts, table, s->button[table]);
+}
+
+/* Static helper: play a whole tournament on prepared scratch state */
+static void play_tournament(TournamentState* const s, const TournamentConfig* const c,
+                            const uint64_t seed, uint32_t* const places,
+                            uint64_t* const out_hands, uint64_t* const out_rounds) {
+    const size_t ts = c->table_size;
+    const size_t n = c->num_players;
+    uint64_t rng = seed;
+    uint64_t hands = 0;
+    size_t rounds = 0;
+
+    /* Random seating, dealt round-robin over the tables */
+    for (size_t p = 0; p < n; p++) {
+        s->order[p] = (uint32_t)p;
+        s->stacks[p] = c->starting_stack;
+    }
+    for (size_t i = n - 1; i > 0; i--) {
+        const size_t j = random_below(&rng, i + 1);
+        const uint32_t tmp = s->order[i];
+        s->order[i] = s->order[j];
+        s->order[j] = tmp;
+    }
+    for (size_t i = 0; i < s->num_tables * ts; i++) {
+        s->seat_player[i] = EMPTY_SEAT;
+    }
+    memset(s->count, 0, s->num_tables);
+    for (size_t k = 0; k < n; k++) {
+        const size_t table = k % s->num_tables;
+        s->seat_player[table * ts + k / s->num_tables] = s->order[k];
+        s->count[table]++;
+    }
+    for (size_t t = 0; t < s->num_tables; t++) {
+        s->button[t] = (uint8_t)random_below(&rng, s->count[t]);
+    }
+
+    size_t remaining = n;
+    while (remaining > 1 && (c->max_rounds == 0 || rounds < c->max_rounds)) {
+        const size_t level = (rounds / c->hands_per_level < c->num_levels)
+                                 ? rounds / c->hands_per_level : c->num_levels - 1;
+        game_set_blinds(s->game, c->levels[level].small_blind, c->levels[level].big_blind);
+
+        for (size_t t = 0; t < s->num_tables; t++) {
+            if (s->count[t] >= 2) {
+                play_hand(s, c, t, &rng);
+                hands++;
+            }
+        }
+
+        /* Busted players: bigger stack at the start of the hand finishes higher */
+        size_t busted = 0;
+        for (size_t i = 0; i < s->num_tables * ts; i++) {
+            const uint32_t player = s->seat_player[i];
+            if (player != EMPTY_SEAT && s->stacks[player] == 0) {
+                s->order[busted++] = player;
+                s->seat_player[i] = EMPTY_SEAT;
+                s->count[i / ts]--;
+            }
+        }
+        sort_players(s->order, busted, s->hand_start);
+        for (size_t b = 0; b < busted; b++) {
+            places[s->order[b]] = (uint32_t)(remaining - busted + 1 + b);
+        }
+        remaining -= busted;
+        rounds++;
+        balance_tables(s, ts, remaining);
+    }
+
+    /* Survivors (one, or several after max_rounds) are ranked by chips */
+    size_t left = 0;
+    for (size_t i = 0; i < s->num_tables * ts; i++) {
+        if (s->seat_player[i] != EMPTY_SEAT) {
+            s->order[left++] = s->seat_player[i];
+        }
+    }
+    sort_players(s->order, left, s->stacks);
+    for (size_t i = 0; i < left; i++) {
+        places[s->order[i]] = (uint32_t)(i + 1);
+    }
+
+    *out_hands = hands;
+    *out_rounds = rounds;
+}
+
+int tournament_run(const TournamentConfig* const config, const uint64_t seed,
+                   uint32_t* const out_places, uint64_t* const out_hands) {
+    if (!valid_config(config) || out_places == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+    TournamentState state;
+    if (state_init(&state, config) != 0) {
+        return -1;
+    }
+    uint64_t hands;
+    uint64_t rounds;
+    play_tournament(&state, config, seed, out_places, &hands, &rounds);
+    state_free(&state);
+    if (out_hands != NULL) {
+        *out_hands = hands;
+    }
+    return 0;
+}
+
+/* One thread's share of tournament_simulate() */
+typedef struct {
+    const TournamentConfig* config;
+    uint64_t seed;
+    uint64_t begin;
+    uint64_t end;
+    int status;                /* 0, or the poker_errno code */
+    TournamentStats stats;
+} SimulateJob;
+
+static void* simulate_worker(void* arg) {
+    SimulateJob* const job = (SimulateJob*)arg;
+    const TournamentConfig* const c = job->config;
+    TournamentState state;
+    uint32_t* const places = malloc(c->num_players * sizeof(uint32_t));
+
+    memset(&job->stats, 0, sizeof(job->stats));
+    if (places == NULL || state_init(&state, c) != 0) {
+        free(places);
+        job->status = POKER_ENOMEM;
+        return NULL;
+    }
+
+    for (uint64_t i = job->begin; i < job->end; i++) {
+        uint64_t hands;
+        uint64_t rounds;
+        play_tournament(&state, c, job->seed + i, places, &hands, &rounds);
+        job->stats.tournaments++;
+        job->stats.hands += hands;
+        job->stats.rounds += rounds;
+        for (size_t p = 0; p < c->num_players; p++) {
+            TournamentPolicyStats* const ps = &job->stats.policies[p % c->num_policies];
+            const uint64_t prize = (places[p] <= c->num_payouts) ? c->payouts[places[p] - 1] : 0;
+            ps->entries++;
+            ps->wins += (places[p] == 1);
+            ps->cashes += (places[p] <= c->num_payouts);
+            ps->prize += prize;
+            ps->prize_sq += (double)prize * (double)prize;
+        }
+    }
+
+    state_free(&state);
+    free(places);
+    job->status = POKER_EOK;
+    return NULL;
+}
+
+int tournament_simulate(const TournamentConfig* const config, const uint64_t count,
+                        const uint64_t seed, const size_t num_threads,
+                        TournamentStats* const out) {
+    if (!valid_config(config) || out == NULL) {
+        poker_errno = POKER_EINVAL;
+        return -1;
+    }
+
+    size_t threads = resolve_thread_count(num_threads);
+    if (threads > count) {
+        threads = (count > 0) ? (size_t)count : 1;
+    }
+    SimulateJob* const jobs = calloc(threads, sizeof(SimulateJob));
+    if (jobs == NULL) {
+        poker_errno = POKER_ENOMEM;
+        return -1;
+    }
+    for (size_t t = 0; t < threads; t++) {
+        jobs[t].config = config;
+        jobs[t].seed = seed;
+        jobs[t].begin = count * t / threads;
+        jobs[t].end = count * (t + 1) / threads;
+    }
+    run_threads(threads, simulate_worker, jobs, sizeof(SimulateJob));
+
+    /* Merge in job order */
+    memset(out, 0, sizeof(*out));
+    int status = POKER_EOK;
+    for (size_t t = 0; t < threads; t++) {
+        const TournamentStats* const js = &jobs[t].stats;
+        if (jobs[t].status != POKER_EOK) {
+            status = jobs[t].status;
+        }
+        out->tournaments += js->tournaments;
+        out->hands += js->hands;
+        out->rounds += js->rounds;
+        for (size_t p = 0; p < TOURNAMENT_MAX_POLICIES; p++) {
+            out->policies[p].entries += js->policies[p].entries;
+            out->policies[p].wins += js->policies[p].wins;
+            out->policies[p].cashes += js->policies[p].cashes;
+            out->policies[p].prize += js->policies[p].prize;
+            out->policies[p].prize_sq += js->policies[p].prize_sq;
+        }
+    }
+    free(jobs);
+
+    if (status != POKER_EOK) {
+        poker_errno = status;
+        return -1;
+    }
+    return 0;
+}
+
+int tournament_decide_check_call(const GameTables* tables, size_t table,
+                                 const GameLegal* legal, const void* params,
+                                 uint64_t* rng, uint32_t* out_raise_to) {
+    (void)tables;
+    (void)table;
+    (void)legal;
+    (void)params;
+    (void)rng;
+    (void)out_raise_to;
+    return GAME_ACTION_CHECK_CALL;
+}
+
+int tournament_decide_random(const GameTables* tables, size_t table,
+                             const GameLegal* legal, const void* params,
+                             uint64_t* rng, uint32_t* out_raise_to) {
+    (void)tables;
+    (void)table;
+    (void)params;
+    const unsigned r = (unsigned)random_below(rng, 20);
+    if (r < 6 && (legal->actions & (1u << GAME_ACTION_FOLD))) {
+        return GAME_ACTION_FOLD;
+    }
+    if (r >= 17 && (legal->actions & (1u << GAME_ACTION_RAISE))) {
+        *out_raise_to = (r == 19) ? legal->max_raise_to : legal->min_raise_to;
+        return GAME_ACTION_RAISE;
+    }
+    return GAME_ACTION_CHECK_CALL;
+}
+
+int tournament_decide_shove(const GameTables* tables, size_t table,
+                            const GameLegal* legal, const void* params,
+                            uint64_t* rng, uint32_t* out_raise_to) {
+    (void)rng;
+    const int min_rank = params ? *(const int*)params : RANK_TEN;
+    const uint64_t hole = tables->hole[table * tables->config.num_seats + legal->seat];
+    const unsigned high = (63u - (unsigned)__builtin_clzll(hole)) / 4 + RANK_TWO;
+    const unsigned low = (unsigned)__builtin_ctzll(hole) / 4 + RANK_TWO;
+    const int preflop = (tables->street[table] == GAME_STREET_PREFLOP);
+
+    if (preflop && (high == low || (int)low >= min_rank)) {
+        if (legal->actions & (1u << GAME_ACTION_RAISE)) {
+            *out_raise_to = legal->max_raise_to;
+            return GAME_ACTION_RAISE;
+        }
+        return GAME_ACTION_CHECK_CALL;
+    }
+    return (legal->actions & (1u << GAME_ACTION_FOLD)) ? GAME_ACTION_FOLD : GAME_ACTION_CHECK_CALL;
+}
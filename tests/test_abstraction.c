@@ -0,0 +1,392 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/poker_abstraction.h"
+#include "../include/poker_boardrank.h"
+#include "test_helpers.h"
+
+/*
+ * Test Suite for hand indexing and card abstraction
+ * Tests verify isomorphism class counts, index/unindex round trips,
+ * invariance under suit renaming and card order, equity histograms
+ * against direct percentiles, earth mover's distances, bucket table
+ * builds (ordering, thread-count independence) and error handling
+ */
+
+static uint64_t random_state = 0x5EED;
+
+/* Static helper: xorshift64* step for test data */
+static uint64_t next_random(void) {
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return random_state * UINT64_C(0x2545F4914F6CDD1D);
+}
+
+/* Static helper: parse a card string into card indices */
+static size_t cards_of(const char* const text, uint8_t* const out) {
+    uint64_t mask = 0;
+    size_t n = 0;
+    for (size_t i = 0; text[i] != '\0'; i += 2) {
+        assert(parse_hand_mask(text + i, 2, &mask, NULL) == 1);
+        out[n++] = (uint8_t)__builtin_ctzll(mask);
+    }
+    return n;
+}
+
+static const size_t STREET_CARDS[HAND_INDEX_STREETS] = {2, 5, 6, 7};
+
+/* Static helper: deal distinct random cards */
+static void random_cards(uint8_t* const out, const size_t n) {
+    uint64_t used = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint8_t card;
+        do {
+            card = (uint8_t)(next_random() % DECK_SIZE);
+        } while (used & (UINT64_C(1) << card));
+        used |= UINT64_C(1) << card;
+        out[i] = card;
+    }
+}
+
+void test_hand_index(void) {
+    printf("Testing suit-isomorphic hand indices...\n");
+
+    assert(hand_index_count(HAND_INDEX_PREFLOP) == 169);
+    assert(hand_index_count(HAND_INDEX_FLOP) == 1286792);
+    assert(hand_index_count(HAND_INDEX_TURN) == 13960050);
+    assert(hand_index_count(HAND_INDEX_RIVER) == 123156254);
+    assert(board_index_count(HAND_INDEX_FLOP) == 1755);
+    assert(board_index_count(HAND_INDEX_TURN) == 16432);
+    assert(board_index_count(HAND_INDEX_RIVER) == 134459);
+
+    /* Round trips: every preflop class and board, a stride of the rest */
+    for (int street = 0; street < HAND_INDEX_STREETS; street++) {
+        const uint64_t count = hand_index_count(street);
+        const uint64_t stride = (street == HAND_INDEX_PREFLOP) ? 1 : count / 20000 + 1;
+        for (uint64_t i = 0; i < count; i += stride) {
+            uint8_t cards[7];
+            uint64_t index;
+            assert(hand_unindex(street, i, cards) == 0);
+            assert(hand_index(cards, STREET_CARDS[street], &index) == 0);
+            assert(index == i);
+        }
+        if (street == HAND_INDEX_PREFLOP) {
+            continue;
+        }
+        const uint64_t boards = board_index_count(street);
+        for (uint64_t i = 0; i < boards; i += (street == HAND_INDEX_FLOP) ? 1 : 7) {
+            uint8_t cards[BOARD_SIZE];
+            uint64_t index;
+            assert(board_unindex(street, i, cards) == 0);
+            assert(board_index(cards, (size_t)street + 2, &index) == 0);
+            assert(index == i);
+        }
+    }
+
+    /* Suit renaming and order within the hole cards or the board do not matter */
+    for (int trial = 0; trial < 2000; trial++) {
+        const int street = trial % HAND_INDEX_STREETS;
+        const size_t n = STREET_CARDS[street];
+        uint8_t cards[7];
+        uint8_t renamed[7];
+        random_cards(cards, n);
+
+        uint8_t suits[4] = {0, 1, 2, 3};
+        for (int i = 3; i > 0; i--) {
+            const int j = (int)(next_random() % (uint64_t)(i + 1));
+            const uint8_t t = suits[i];
+            suits[i] = suits[j];
+            suits[j] = t;
+        }
+        for (size_t i = 0; i < n; i++) {
+            renamed[i] = (uint8_t)((cards[i] & ~3u) | suits[cards[i] & 3]);
+        }
+        const uint8_t hole = renamed[0];
+        renamed[0] = renamed[1];
+        renamed[1] = hole;
+        if (n > 2) {
+            const uint8_t first = renamed[2];
+            renamed[2] = renamed[n - 1];
+            renamed[n - 1] = first;
+        }
+
+        uint64_t a;
+        uint64_t b;
+        assert(hand_index(cards, n, &a) == 0);
+        assert(hand_index(renamed, n, &b) == 0);
+        assert(a == b && a < hand_index_count(street));
+    }
+
+    /* Different classes stay apart: suited and offsuit, flush-draw boards */
+    uint8_t cards[7];
+    uint64_t a;
+    uint64_t b;
+    assert(hand_index(cards, cards_of("AhKh", cards), &a) == 0);
+    assert(hand_index(cards, cards_of("AhKd", cards), &b) == 0);
+    assert(a != b);
+    assert(hand_index(cards, cards_of("AhKhQh7h2c", cards), &a) == 0);
+    assert(hand_index(cards, cards_of("AhKhQd7h2c", cards), &b) == 0);
+    assert(a != b);
+
+    /* Errors */
+    assert(hand_index(cards, 4, &a) == -1 && poker_errno == POKER_EINVAL);
+    assert(hand_index(NULL, 2, &a) == -1 && poker_errno == POKER_EINVAL);
+    cards_of("AhAh", cards);
+    assert(hand_index(cards, 2, &a) == -1 && poker_errno == POKER_EDUPLICATE);
+    cards[1] = DECK_SIZE;
+    assert(hand_index(cards, 2, &a) == -1 && poker_errno == POKER_EINVAL);
+    assert(hand_unindex(HAND_INDEX_PREFLOP, 169, cards) == -1 && poker_errno == POKER_EINVAL);
+    assert(hand_unindex(HAND_INDEX_STREETS, 0, cards) == -1 && poker_errno == POKER_EINVAL);
+    assert(hand_index_count(-1) == 0);
+    assert(board_index_count(HAND_INDEX_PREFLOP) == 0);
+    assert(board_index(cards, 2, &a) == -1 && poker_errno == POKER_EINVAL);
+
+    printf("✓ Hand index tests passed\n");
+}
+
+void test_ehs_histograms(void) {
+    printf("Testing equity histograms and earth mover's distance...\n");
+
+    const unsigned bins = 10;
+    uint32_t* const hist = malloc(HOLE_COMBOS * bins * sizeof(uint32_t));
+    uint32_t* const again = malloc(HOLE_COMBOS * bins * sizeof(uint32_t));
+    BoardRanking* const ranking = malloc(sizeof(BoardRanking));
+    assert(hist != NULL && again != NULL && ranking != NULL);
+
+    /* River: one count per live combo, in the bin of its percentile */
+    const uint64_t river = mask_of("AhKd7c7s2h");
+    assert(ehs_histograms(river, bins, 0, 0, hist) == 0);
+    assert(board_ranking_build(river, ranking) == 0);
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        const uint64_t hole = hole_combo_mask(c);
+        uint32_t total = 0;
+        for (unsigned b = 0; b < bins; b++) {
+            total += hist[c * bins + b];
+        }
+        if (hole & river) {
+            assert(total == 0);
+            continue;
+        }
+        assert(total == 1);
+        unsigned bin = (unsigned)(board_ranking_percentile(ranking, hole) * bins + 1e-9);
+        bin = (bin < bins) ? bin : bins - 1;
+        assert(hist[c * bins + bin] == 1);
+    }
+
+    /* Turn: every river card the combo does not hold, matched one by one */
+    const uint64_t turn = mask_of("QsJs4d3c");
+    const size_t flush_draw = (size_t)hole_combo_index(mask_of("As9s"));
+    assert(ehs_histograms(turn, bins, 0, 0, hist) == 0);
+    uint32_t expected[10] = {0};
+    for (int card = 0; card < DECK_SIZE; card++) {
+        const uint64_t bit = UINT64_C(1) << card;
+        if ((turn | hole_combo_mask(flush_draw)) & bit) {
+            continue;
+        }
+        assert(board_ranking_build(turn | bit, ranking) == 0);
+        const double strength = board_ranking_percentile(ranking, hole_combo_mask(flush_draw));
+        const unsigned bin = (unsigned)(strength * bins + 1e-9);
+        expected[(bin < bins) ? bin : bins - 1]++;
+    }
+    assert(memcmp(expected, hist + flush_draw * bins, sizeof(expected)) == 0);
+
+    /* Sampling is reproducible and counts at most one runout per sample */
+    const uint64_t flop = mask_of("9h8h2c");
+    assert(ehs_histograms(flop, bins, 50, 7, hist) == 0);
+    assert(ehs_histograms(flop, bins, 50, 7, again) == 0);
+    assert(memcmp(hist, again, HOLE_COMBOS * bins * sizeof(uint32_t)) == 0);
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        uint32_t total = 0;
+        for (unsigned b = 0; b < bins; b++) {
+            total += hist[c * bins + b];
+        }
+        assert(total <= 50);
+    }
+    assert(ehs_histograms(flop, bins, 50, 8, again) == 0);
+    assert(memcmp(hist, again, HOLE_COMBOS * bins * sizeof(uint32_t)) != 0);
+
+    /* A draw and a made hand of similar strength are far apart */
+    const size_t draw = (size_t)hole_combo_index(mask_of("ThJh"));
+    const size_t pair = (size_t)hole_combo_index(mask_of("8d8s"));
+    assert(ehs_histograms(flop, bins, 0, 0, hist) == 0);
+    assert(histogram_emd(hist + draw * bins, hist + draw * bins, bins) == 0.0);
+    assert(histogram_emd(hist + draw * bins, hist + pair * bins, bins) > 0.1);
+
+    /* Exact distances */
+    const uint32_t low[4] = {1, 0, 0, 0};
+    const uint32_t high[4] = {0, 0, 0, 3};
+    const uint32_t half[4] = {1, 0, 0, 1};
+    const uint32_t empty[4] = {0, 0, 0, 0};
+    assert(fabs(histogram_emd(low, high, 4) - 0.75) < 1e-12);
+    assert(fabs(histogram_emd(high, low, 4) - 0.75) < 1e-12);
+    assert(fabs(histogram_emd(low, half, 4) - 0.375) < 1e-12);
+    assert(histogram_emd(low, empty, 4) == -1.0);
+    assert(histogram_emd(low, high, 0) == -1.0);
+
+    /* Errors */
+    assert(ehs_histograms(flop, 1, 0, 0, hist) == -1 && poker_errno == POKER_EINVAL);
+    assert(ehs_histograms(flop, ABSTRACTION_MAX_BINS + 1, 0, 0, hist) == -1);
+    assert(ehs_histograms(mask_of("AhKd"), bins, 0, 0, hist) == -1 && poker_errno == POKER_EINVAL);
+    assert(ehs_histograms(flop, bins, 0, 0, NULL) == -1 && poker_errno == POKER_EINVAL);
+
+    free(hist);
+    free(again);
+    free(ranking);
+    printf("✓ Equity histogram tests passed\n");
+}
+
+static char path[] = "/tmp/poker_buckets_XXXXXX";
+static char other_path[] = "/tmp/poker_buckets_XXXXXX";
+
+/* Static helper: read a whole file */
+static uint8_t* read_file(const char* const name, size_t* const out_size) {
+    FILE* const file = fopen(name, "rb");
+    assert(file != NULL);
+    fseek(file, 0, SEEK_END);
+    *out_size = (size_t)ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t* const data = malloc(*out_size);
+    assert(data != NULL && fread(data, 1, *out_size, file) == *out_size);
+    fclose(file);
+    return data;
+}
+
+/* Static helper: bucket of a hand in a table */
+static int bucket_of(const BucketTable* const table, const char* const text) {
+    uint8_t cards[7];
+    const size_t n = cards_of(text, cards);
+    return bucket_table_lookup(table, cards, n);
+}
+
+void test_abstraction_build(void) {
+    printf("Testing bucket table builds...\n");
+
+    AbstractionConfig config;
+    memset(&config, 0, sizeof(config));
+    config.street = HAND_INDEX_PREFLOP;
+    config.num_buckets = 8;
+    config.bins = 8;
+    config.samples = 1000;
+    config.iterations = 50;
+    config.num_threads = 1;
+    config.seed = 42;
+
+    AbstractionStats stats;
+    assert(abstraction_build(&config, path, &stats) == 0);
+    assert(stats.num_hands == 169);
+    assert(stats.iterations >= 1 && stats.iterations <= 50);
+    assert(stats.mean_distance >= 0.0 && stats.mean_distance < 0.5);
+    char scratch[sizeof(path) + sizeof(".features")];
+    snprintf(scratch, sizeof(scratch), "%s.features", path);
+    assert(access(scratch, F_OK) != 0);
+
+    /* The thread count does not change the table */
+    config.num_threads = 3;
+    assert(abstraction_build(&config, other_path, NULL) == 0);
+    size_t size;
+    size_t other_size;
+    uint8_t* const data = read_file(path, &size);
+    uint8_t* const other = read_file(other_path, &other_size);
+    assert(size == 24 + 169 && size == other_size);
+    assert(memcmp(data, other, size) == 0);
+    assert(memcmp(data, "PBKT", 4) == 0);
+    free(data);
+    free(other);
+
+    BucketTable* const table = bucket_table_open(path);
+    assert(table != NULL);
+    assert(bucket_table_street(table) == HAND_INDEX_PREFLOP);
+    assert(bucket_table_buckets(table) == 8);
+
+    /* Isomorphic hands share a bucket; premium pairs and trash do not */
+    const int aces = bucket_of(table, "AhAs");
+    assert(aces >= 0 && aces < 8);
+    assert(bucket_of(table, "AdAc") == aces);
+    assert(bucket_of(table, "KhKd") == aces);
+    assert(bucket_of(table, "7h2d") != aces);
+    assert(bucket_of(table, "7s2c") == bucket_of(table, "2h7d"));
+    assert(bucket_of(table, "AhKh") == bucket_of(table, "KsAs"));
+
+    /* Errors */
+    uint8_t cards[7];
+    assert(bucket_table_lookup(table, cards, cards_of("AhKhQh", cards)) == -1 &&
+           poker_errno == POKER_EINVAL);
+    assert(bucket_of(table, "AhAh") == -1 && poker_errno == POKER_EDUPLICATE);
+    bucket_table_close(table);
+    bucket_table_close(NULL);
+
+    /* A flop table with a few runouts per board */
+    config.street = HAND_INDEX_FLOP;
+    config.num_buckets = 300;
+    config.bins = 5;
+    config.samples = 2;
+    config.iterations = 3;
+    config.num_threads = 0;
+    assert(abstraction_build(&config, path, &stats) == 0);
+    assert(stats.num_hands == 1286792 && stats.iterations >= 1);
+    BucketTable* const flop = bucket_table_open(path);
+    assert(flop != NULL && bucket_table_buckets(flop) == 300);
+    free(read_file(path, &size));
+    assert(size == 24 + 2 * 1286792);
+    const int set = bucket_of(flop, "7h7dAs7c2h");
+    assert(set >= 0 && set < 300);
+    assert(bucket_of(flop, "7s7hAd7c2s") == set);
+    assert(bucket_of(flop, "7h7d7c2hAs") == set);
+    assert(bucket_of(flop, "7h7d") == -1 && poker_errno == POKER_EINVAL);
+    bucket_table_close(flop);
+
+    assert(bucket_table_open("/nonexistent/poker_buckets") == NULL && poker_errno == POKER_ENOTFOUND);
+    assert(bucket_table_open(NULL) == NULL && poker_errno == POKER_EINVAL);
+    FILE* const bad = fopen(other_path, "wb");
+    assert(bad != NULL);
+    fwrite("PBKT\x01\x00\x01\x00\x08\x00\x00\x00\x08\x00\x00\x00\xa9\x00\x00\x00\x00\x00\x00\x00",
+           1, 24, bad);
+    fclose(bad);
+    assert(bucket_table_open(other_path) == NULL && poker_errno == POKER_EFORMAT);
+
+    config.street = HAND_INDEX_PREFLOP;
+    config.samples = 0;
+    assert(abstraction_build(&config, path, NULL) == -1 && poker_errno == POKER_EINVAL);
+    config.samples = 10;
+    config.bins = 1;
+    assert(abstraction_build(&config, path, NULL) == -1 && poker_errno == POKER_EINVAL);
+    config.bins = 8;
+    config.num_buckets = ABSTRACTION_MAX_BUCKETS + 1;
+    assert(abstraction_build(&config, path, NULL) == -1 && poker_errno == POKER_EINVAL);
+    config.num_buckets = 8;
+    config.iterations = 0;
+    assert(abstraction_build(&config, path, NULL) == -1 && poker_errno == POKER_EINVAL);
+    config.iterations = 1;
+    assert(abstraction_build(NULL, path, NULL) == -1 && poker_errno == POKER_EINVAL);
+    assert(abstraction_build(&config, "/nonexistent/poker_buckets", NULL) == -1 &&
+           poker_errno == POKER_EIO);
+
+    printf("✓ Bucket table tests passed\n");
+}
+
+int main(void) {
+    printf("Running hand index and abstraction tests...\n\n");
+
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    fd = mkstemp(other_path);
+    assert(fd >= 0);
+    close(fd);
+
+    test_hand_index();
+    test_ehs_histograms();
+    test_abstraction_build();
+
+    unlink(path);
+    unlink(other_path);
+
+    printf("\n✓ All hand index and abstraction tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/poker_boardrank.h"
+#include "test_helpers.h"
+
+/*
+ * Test Suite for board rankings and the ranking cache
+ * Tests verify order, per-combo counts against pairwise comparison, nut
+ * and percentile queries, flop and turn boards, range-vs-range showdown
+ * values, cache hits and evictions and error handling
+ */
+
+/* Static helper: check a ranking against direct evaluation of every pair */
+static void check_ranking(const BoardRanking* const r, const uint64_t board) {
+    size_t live = 0;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        const uint64_t hole = hole_combo_mask(c);
+        if (hole & board) {
+            assert(r->value[c] == 0 && r->position[c] == BOARD_RANK_BLOCKED);
+            assert(r->wins[c] == 0 && r->ties[c] == 0 && r->losses[c] == 0);
+            continue;
+        }
+        live++;
+        const HandValue value = evaluate_mask(hole | board);
+        assert(r->value[c] == value && r->order[r->position[c]] == c);
+        size_t wins = 0, ties = 0, losses = 0;
+        for (size_t o = 0; o < HOLE_COMBOS; o++) {
+            const uint64_t opp = hole_combo_mask(o);
+            if (opp & (hole | board)) {
+                continue;
+            }
+            const HandValue other = evaluate_mask(opp | board);
+            wins += (value > other);
+            ties += (value == other);
+            losses += (value < other);
+        }
+        assert(r->wins[c] == wins && r->ties[c] == ties && r->losses[c] == losses);
+    }
+    assert(r->num_combos == live && r->board == board);
+
+    for (size_t k = 0; k < live; k++) {
+        const HandValue value = r->value[r->order[k]];
+        assert(k == 0 || r->value[r->order[k - 1]] <= value);
+        const size_t end = r->group_end[k];
+        assert(end > k && end <= live && r->value[r->order[end - 1]] == value);
+        assert(end == live || r->value[r->order[end]] > value);
+    }
+}
+
+void test_board_ranking_build(void) {
+    printf("Testing board_ranking_build...\n");
+
+    BoardRanking* const r = malloc(sizeof(BoardRanking));
+    const char* const boards[] = {"Ah7c7d2s9h", "TsJsQsKsAs", "2c2d2h2s3c", "Kd8s3h2c", "5h6h7c"};
+    for (size_t i = 0; i < 5; i++) {
+        const uint64_t board = mask_of(boards[i]);
+        assert(board_ranking_build(board, r) == 0);
+        check_ranking(r, board);
+    }
+    assert(board_ranking_build(mask_of("Ah7c7d2s9h"), r) == 0);
+    assert(r->num_combos == BOARD_COMBOS);
+    free(r);
+
+    printf("  ✓ Order and win/tie/loss counts match pairwise comparison\n");
+}
+
+void test_board_ranking_queries(void) {
+    printf("Testing board ranking queries...\n");
+
+    BoardRanking* const r = malloc(sizeof(BoardRanking));
+    const uint64_t board = mask_of("Ah7c7d2s9h");
+    assert(board_ranking_build(board, r) == 0);
+
+    /* Quad sevens are the only nuts */
+    assert(board_ranking_is_nuts(r, mask_of("7h7s")) == 1);
+    assert(board_ranking_beaten_by(r, mask_of("7h7s")) == 0);
+    assert(board_ranking_is_nuts(r, mask_of("AcAd")) == 0);
+    assert(board_ranking_beaten_by(r, mask_of("AcAd")) == 1);
+    assert(board_ranking_percentile(r, mask_of("7h7s")) == 1.0);
+
+    /* Percentile is uniform-range HS */
+    const char* const holes[] = {"AcKd", "3c4d", "9c9d", "KhQh"};
+    for (size_t i = 0; i < 4; i++) {
+        HandStrength hs;
+        const uint64_t hole = mask_of(holes[i]);
+        assert(hand_strength(hole, board, NULL, &hs) == 0);
+        assert(fabs(board_ranking_percentile(r, hole) - hs.hs) < 1e-12);
+    }
+
+    /* count_above ignores card removal and accepts any value */
+    const HandValue quads = r->value[hole_combo_index(mask_of("7h7s"))];
+    assert(board_ranking_count_above(r, quads) == 0);
+    assert(board_ranking_count_above(r, 0) == BOARD_COMBOS);
+    assert(board_ranking_count_above(r, quads - 1) == 1);
+    poker_errno = POKER_EOK;
+    assert(board_ranking_count_above(NULL, 0) == 0 && poker_errno == POKER_EINVAL);
+    const HandValue pair = r->value[hole_combo_index(mask_of("3c4d"))];
+    size_t above = 0;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        above += (r->position[c] != BOARD_RANK_BLOCKED && r->value[c] > pair);
+    }
+    assert(board_ranking_count_above(r, pair) == above);
+
+    poker_errno = POKER_EOK;
+    assert(board_ranking_beaten_by(r, mask_of("AhKd")) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+    assert(board_ranking_is_nuts(r, mask_of("KdQdJd")) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(board_ranking_percentile(NULL, mask_of("KdQd")) == -1.0);
+    free(r);
+
+    printf("  ✓ Nuts, beaten-by, percentile and count queries correct\n");
+}
+
+/* Static helper: random range with some zero and some fractional weights */
+static void random_weights(double* const weights, uint64_t* const state) {
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const unsigned r = (unsigned)(*state >> 40);
+        weights[c] = (r % 4 == 0) ? 0.0 : (r % 1000) / 997.0;
+    }
+}
+
+void test_board_ranking_showdown(void) {
+    printf("Testing board_ranking_showdown...\n");
+
+    BoardRanking* const r = malloc(sizeof(BoardRanking));
+    double* const hero = malloc(HOLE_COMBOS * sizeof(double));
+    double* const villain = malloc(HOLE_COMBOS * sizeof(double));
+    double* const hero_values = malloc(HOLE_COMBOS * sizeof(double));
+    double* const villain_values = malloc(HOLE_COMBOS * sizeof(double));
+    double* const totals = malloc(HOLE_COMBOS * sizeof(double));
+    uint64_t state = 77;
+
+    const char* const boards[] = {"Ah7c7d2s9h", "TsJsQs2d3h", "Kd8s3h2c"};
+    for (size_t i = 0; i < 3; i++) {
+        const uint64_t board = mask_of(boards[i]);
+        assert(board_ranking_build(board, r) == 0);
+        random_weights(hero, &state);
+        random_weights(villain, &state);
+        assert(board_ranking_showdown(r, villain, hero_values, totals) == 0);
+        assert(board_ranking_showdown(r, hero, villain_values, NULL) == 0);
+
+        /* Pairwise reference */
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            const uint64_t hole = hole_combo_mask(c);
+            if (hole & board) {
+                assert(hero_values[c] == 0.0 && totals[c] == 0.0);
+                continue;
+            }
+            double value = 0.0;
+            double total = 0.0;
+            for (size_t o = 0; o < HOLE_COMBOS; o++) {
+                const uint64_t opp = hole_combo_mask(o);
+                if (opp & (hole | board)) {
+                    continue;
+                }
+                const HandValue mine = r->value[c];
+                const HandValue theirs = r->value[o];
+                value += (mine > theirs) ? villain[o] : (mine < theirs) ? -villain[o] : 0.0;
+                total += villain[o];
+            }
+            assert(fabs(hero_values[c] - value) < 1e-9 && fabs(totals[c] - total) < 1e-9);
+        }
+
+        /* Zero-sum: what one range wins the other loses */
+        double hero_ev = 0.0;
+        double villain_ev = 0.0;
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            hero_ev += hero[c] * hero_values[c];
+            villain_ev += villain[c] * villain_values[c];
+        }
+        assert(fabs(hero_ev + villain_ev) < 1e-6);
+    }
+
+    /* Uniform range: wins minus losses from the counts */
+    assert(board_ranking_showdown(r, NULL, hero_values, totals) == 0);
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        assert(hero_values[c] == (double)r->wins[c] - (double)r->losses[c]);
+        assert(totals[c] == (double)(r->wins[c] + r->ties[c] + r->losses[c]));
+    }
+
+    poker_errno = POKER_EOK;
+    assert(board_ranking_showdown(NULL, NULL, hero_values, NULL) == -1);
+    assert(board_ranking_showdown(r, NULL, NULL, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    free(totals);
+    free(villain_values);
+    free(hero_values);
+    free(villain);
+    free(hero);
+    free(r);
+    printf("  ✓ Sweep matches pairwise showdown values on river and turn boards\n");
+}
+
+void test_board_rank_cache(void) {
+    printf("Testing board ranking cache...\n");
+
+    BoardRankCache* const cache = board_rank_cache_create(4);
+    assert(cache != NULL);
+    BoardRanking* const fresh = malloc(sizeof(BoardRanking));
+
+    /* Every river of one turn: each built once, then served from the cache */
+    const uint64_t turn = mask_of("Kd8s3h2c");
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    for (unsigned card = 0; card < DECK_SIZE; card++) {
+        const uint64_t river = turn | (UINT64_C(1) << card);
+        if (river == turn) {
+            continue;
+        }
+        const BoardRanking* const r = board_rank_cache_get(cache, river);
+        assert(r != NULL && r->board == river);
+        assert(board_rank_cache_get(cache, river) == r);
+        assert(board_ranking_build(river, fresh) == 0);
+        assert(memcmp(r->losses, fresh->losses, sizeof(fresh->losses)) == 0);
+    }
+    board_rank_cache_stats(cache, &hits, &misses);
+    assert(misses == 48 && hits == 48);
+
+    /* One slot: alternating boards evict each other */
+    BoardRankCache* const tiny = board_rank_cache_create(1);
+    const uint64_t a = mask_of("Ah7c7d2s9h");
+    const uint64_t b = mask_of("Ah7c7d2s9d");
+    assert(board_rank_cache_get(tiny, a)->board == a);
+    assert(board_rank_cache_get(tiny, b)->board == b);
+    assert(board_rank_cache_get(tiny, a)->board == a);
+    board_rank_cache_stats(tiny, &hits, NULL);
+    assert(hits == 0);
+
+    poker_errno = POKER_EOK;
+    assert(board_rank_cache_get(tiny, mask_of("Ah7c")) == NULL);
+    assert(poker_errno == POKER_EINVAL);
+    assert(board_rank_cache_get(tiny, 0) == NULL);
+    assert(board_rank_cache_get(NULL, a) == NULL);
+    assert(board_rank_cache_create(0) == NULL);
+    assert(board_ranking_build(mask_of("Ah7c7d2s9h3c"), fresh) == -1);
+    assert(board_ranking_build(a, NULL) == -1);
+    board_rank_cache_destroy(tiny);
+    board_rank_cache_destroy(cache);
+    board_rank_cache_destroy(NULL);
+    free(fresh);
+
+    printf("  ✓ Rankings cached, evicted and rebuilt correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Board Ranking Test Suite ===\n\n");
+
+    test_board_ranking_build();
+    test_board_ranking_queries();
+    test_board_ranking_showdown();
+    test_board_rank_cache();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "../include/poker_equity.h"
+#include "test_helpers.h"
+
+/*
+ * Test Suite for calculate_equity()
+ * Tests verify enumeration against a brute-force showdown count, Monte
+ * Carlo convergence, reproducibility and error handling
+ */
+
+void test_equity_river(void) {
+    printf("Testing calculate_equity on a complete board...\n");
+
+    const uint64_t holes[3] = {mask_of("AhAd"), mask_of("KhKd"), mask_of("2c3c")};
+    EquityResult result;
+
+    /* Aces full beats kings full; deuce-trey misses */
+    assert(calculate_equity(holes, 3, mask_of("AsKs7c7d9h"), 0, 0, 0, &result) == 0);
+    assert(result.trials == 1);
+    assert(result.equity[0] == 1.0 && result.win[0] == 1.0);
+    assert(result.equity[1] == 0.0 && result.equity[2] == 0.0);
+
+    /* Board plays for everyone: three-way split */
+    assert(calculate_equity(holes, 3, mask_of("AsKsQsJsTs"), 0, 0, 0, &result) == 0);
+    for (size_t p = 0; p < 3; p++) {
+        assert(fabs(result.equity[p] - 1.0 / 3.0) < 1e-12);
+        assert(result.tie[p] == 1.0 && result.win[p] == 0.0);
+    }
+
+    printf("  ✓ Wins and split pots scored correctly\n");
+}
+
+void test_equity_flop_enumeration(void) {
+    printf("Testing calculate_equity enumeration against brute force...\n");
+
+    const uint64_t holes[2] = {mask_of("AhKh"), mask_of("7c7d")};
+    const uint64_t board = mask_of("Qh8h2s");
+    const uint64_t dead = mask_of("9h");
+    EquityResult result;
+    assert(calculate_equity(holes, 2, board, dead, 0, 0, &result) == 0);
+
+    /* Brute force turn and river */
+    const uint64_t used = holes[0] | holes[1] | board | dead;
+    uint64_t trials = 0, wins0 = 0, ties = 0;
+    for (unsigned t = 0; t < DECK_SIZE; t++) {
+        for (unsigned r = t + 1; r < DECK_SIZE; r++) {
+            const uint64_t extra = (UINT64_C(1) << t) | (UINT64_C(1) << r);
+            if (extra & used) {
+                continue;
+            }
+            const HandValue a = evaluate_mask(holes[0] | board | extra);
+            const HandValue b = evaluate_mask(holes[1] | board | extra);
+            trials++;
+            wins0 += (a > b);
+            ties += (a == b);
+        }
+    }
+
+    assert(result.trials == trials);
+    assert(trials == 44 * 43 / 2);
+    assert(fabs(result.win[0] - (double)wins0 / (double)trials) < 1e-12);
+    assert(fabs(result.tie[0] - (double)ties / (double)trials) < 1e-12);
+    assert(fabs(result.equity[0] + result.equity[1] - 1.0) < 1e-12);
+    assert(fabs(result.equity[0] - ((double)wins0 + ties / 2.0) / (double)trials) < 1e-12);
+
+    printf("  ✓ Flush-draw equity %.4f matches %llu enumerated boards\n",
+           result.equity[0], (unsigned long long)trials);
+}
+
+void test_equity_monte_carlo(void) {
+    printf("Testing calculate_equity sampling converges and is reproducible...\n");
+
+    const uint64_t holes[2] = {mask_of("AsAh"), mask_of("KdKc")};
+    EquityResult exact, sampled, again;
+
+    /* Turn: 44 rivers, exact vs sampled */
+    const uint64_t board = mask_of("2h7c9dJs");
+    assert(calculate_equity(holes, 2, board, 0, 0, 0, &exact) == 0);
+    assert(exact.trials == 44);
+    assert(calculate_equity(holes, 2, board, 0, 100000, 42, &sampled) == 0);
+    assert(sampled.trials == 100000);
+    assert(fabs(sampled.equity[0] - exact.equity[0]) < 0.01);
+
+    /* Preflop sample: aces are roughly 82% against kings */
+    assert(calculate_equity(holes, 2, 0, 0, 200000, 7, &sampled) == 0);
+    assert(sampled.equity[0] > 0.80 && sampled.equity[0] < 0.84);
+    assert(calculate_equity(holes, 2, 0, 0, 200000, 7, &again) == 0);
+    assert(memcmp(&sampled, &again, sizeof(sampled)) == 0);
+
+    printf("  ✓ Sampled AA vs KK preflop: %.4f\n", sampled.equity[0]);
+}
+
+void test_equity_errors(void) {
+    printf("Testing calculate_equity error handling...\n");
+
+    EquityResult result;
+    uint64_t holes[2] = {mask_of("AsAh"), mask_of("KdKc")};
+
+    poker_errno = POKER_EOK;
+    assert(calculate_equity(NULL, 2, 0, 0, 0, 0, &result) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(calculate_equity(holes, 1, 0, 0, 0, 0, &result) == -1);
+    assert(calculate_equity(holes, 2, 0, 0, 0, 0, NULL) == -1);
+    assert(calculate_equity(holes, 2, mask_of("2c3c4c5c6c7c"), 0, 0, 0, &result) == -1);
+
+    holes[1] = mask_of("KdKcKh");
+    poker_errno = POKER_EOK;
+    assert(calculate_equity(holes, 2, 0, 0, 0, 0, &result) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    holes[1] = mask_of("AsKc");
+    poker_errno = POKER_EOK;
+    assert(calculate_equity(holes, 2, 0, 0, 0, 0, &result) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+
+    holes[1] = mask_of("KdKc");
+    poker_errno = POKER_EOK;
+    assert(calculate_equity(holes, 2, mask_of("Kd2c3c"), 0, 0, 0, &result) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+    poker_errno = POKER_EOK;
+    assert(calculate_equity(holes, 2, mask_of("2c3c4c"), mask_of("2c"), 0, 0, &result) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Equity Test Suite ===\n\n");
+
+    test_equity_river();
+    test_equity_flop_enumeration();
+    test_equity_monte_carlo();
+    test_equity_errors();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,361 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "../include/poker.h"
+
+/*
+ * Test Suite for evaluate_hand, evaluate_mask, evaluate_suits and compare_hands
+ * Tests verify categories, tiebreakers, best-five selection and ordering
+ */
+
+/* Static helper: parse a hand string into cards */
+static size_t cards_from(const char* const str, Card* const out) {
+    const int n = parse_hand(str, strlen(str), out, 7, NULL);
+    assert(n >= 0);
+    return (size_t)n;
+}
+
+/* Static helper: evaluate a hand string */
+static Hand eval(const char* const str) {
+    Card cards[7];
+    Hand hand;
+    const size_t n = cards_from(str, cards);
+    assert(evaluate_hand(cards, n, &hand) == 0);
+    return hand;
+}
+
+/* Static helper: check that a hand's best five are exactly the given cards */
+static void assert_best_five(const Hand* const hand, const char* const expected) {
+    Card cards[HAND_SIZE];
+    assert(cards_from(expected, cards) == HAND_SIZE);
+    uint64_t want = 0, got = 0;
+    for (size_t i = 0; i < HAND_SIZE; i++) {
+        want |= CARD_MASK_BIT(cards[i]);
+        got |= CARD_MASK_BIT(hand->cards[i]);
+    }
+    assert(want == got);
+}
+
+void test_evaluate_hand_categories(void) {
+    printf("Testing evaluate_hand categories and tiebreakers...\n");
+
+    Hand h = eval("AhKhQhJhTh");
+    assert(h.category == HAND_ROYAL_FLUSH);
+
+    h = eval("5d4d3d2dAd");
+    assert(h.category == HAND_STRAIGHT_FLUSH && h.tiebreakers[0] == RANK_FIVE);
+
+    h = eval("KsKhKdKc7h");
+    assert(h.category == HAND_FOUR_OF_A_KIND);
+    assert(h.tiebreakers[0] == RANK_KING && h.tiebreakers[1] == RANK_SEVEN);
+
+    h = eval("JdJcJh8s8d");
+    assert(h.category == HAND_FULL_HOUSE && h.num_tiebreakers == 2);
+    assert(h.tiebreakers[0] == RANK_JACK && h.tiebreakers[1] == RANK_EIGHT);
+
+    h = eval("Kh Jh 9h 6h 2h");
+    assert(h.category == HAND_FLUSH && h.num_tiebreakers == 5);
+    assert(h.tiebreakers[4] == RANK_TWO);
+
+    h = eval("5h4d3c2sAh");
+    assert(h.category == HAND_STRAIGHT && h.tiebreakers[0] == RANK_FIVE);
+
+    h = eval("QhQdQcTs7h");
+    assert(h.category == HAND_THREE_OF_A_KIND && h.num_tiebreakers == 3);
+
+    h = eval("AhAd9c9s5h");
+    assert(h.category == HAND_TWO_PAIR);
+    assert(h.tiebreakers[0] == RANK_ACE && h.tiebreakers[1] == RANK_NINE &&
+           h.tiebreakers[2] == RANK_FIVE);
+
+    h = eval("TcTh8d6s3c");
+    assert(h.category == HAND_ONE_PAIR && h.num_tiebreakers == 4);
+
+    h = eval("KdJc9h7s3d");
+    assert(h.category == HAND_HIGH_CARD && h.tiebreakers[0] == RANK_KING);
+
+    printf("  ✓ All ten categories evaluated correctly\n");
+}
+
+void test_evaluate_hand_seven_cards(void) {
+    printf("Testing evaluate_hand picks the best five of seven...\n");
+
+    /* Flush beats the straight also present */
+    Hand h = eval("9h8h7d6h5c2hKh");
+    assert(h.category == HAND_FLUSH);
+    assert_best_five(&h, "Kh9h8h6h2h");
+
+    /* Two trips make a full house with the higher trips */
+    h = eval("7s7h7d4c4d4hAs");
+    assert(h.category == HAND_FULL_HOUSE);
+    assert(h.tiebreakers[0] == RANK_SEVEN && h.tiebreakers[1] == RANK_FOUR);
+
+    /* Three pairs: kicker may come from the third pair */
+    h = eval("KsKd8h8c6s6d2c");
+    assert(h.category == HAND_TWO_PAIR && h.tiebreakers[2] == RANK_SIX);
+    assert_best_five(&h, "KsKd8h8c6s");
+
+    /* Straight flush within six suited cards */
+    h = eval("9c8c7c6c5c2cAh");
+    assert(h.category == HAND_STRAIGHT_FLUSH && h.tiebreakers[0] == RANK_NINE);
+    assert_best_five(&h, "9c8c7c6c5c");
+
+    /* Wheel best-five includes the ace */
+    h = eval("As2d3h4c5sKdQd");
+    assert(h.category == HAND_STRAIGHT);
+    assert_best_five(&h, "As2d3h4c5s");
+
+    /* Quads with three kickers available */
+    h = eval("3s3h3d3cQdJs9h");
+    assert(h.category == HAND_FOUR_OF_A_KIND && h.tiebreakers[1] == RANK_QUEEN);
+
+    printf("  ✓ Seven-card hands resolved correctly\n");
+}
+
+void test_evaluate_hand_matches_detectors(void) {
+    printf("Testing evaluate_hand agrees with detectors on all 5-card hands...\n");
+
+    /* Full enumeration of C(52,5) also checks the category distribution */
+    static const long EXPECTED[HAND_ROYAL_FLUSH + 1] = {
+        0, 1302540, 1098240, 123552, 54912, 10200, 5108, 3744, 624, 36, 4
+    };
+    long counts[HAND_ROYAL_FLUSH + 1] = {0};
+    long checked = 0;
+    Card cards[HAND_SIZE];
+
+    for (int a = 0; a < DECK_SIZE; a++)
+    for (int b = a + 1; b < DECK_SIZE; b++)
+    for (int c = b + 1; c < DECK_SIZE; c++)
+    for (int d = c + 1; d < DECK_SIZE; d++)
+    for (int e = d + 1; e < DECK_SIZE; e++) {
+        const uint64_t mask = (UINT64_C(1) << a) | (UINT64_C(1) << b) | (UINT64_C(1) << c) |
+                              (UINT64_C(1) << d) | (UINT64_C(1) << e);
+        const HandValue value = evaluate_mask(mask);
+        counts[HAND_VALUE_CATEGORY(value)]++;
+
+        /* Cross-check a sample against the detector-based path */
+        if ((a * 31 + b * 17 + c * 7 + d * 3 + e) % 97 != 0) {
+            continue;
+        }
+        cards[0] = CARD_FROM_INDEX(a);
+        cards[1] = CARD_FROM_INDEX(b);
+        cards[2] = CARD_FROM_INDEX(c);
+        cards[3] = CARD_FROM_INDEX(d);
+        cards[4] = CARD_FROM_INDEX(e);
+
+        Hand hand;
+        assert(evaluate_hand(cards, HAND_SIZE, &hand) == 0);
+        assert(hand_value(&hand) == value);
+
+        Rank tiebreakers[MAX_TIEBREAKERS];
+        size_t num = 0;
+        switch (hand.category) {
+            case HAND_ROYAL_FLUSH:
+                assert(detect_royal_flush(cards, HAND_SIZE));
+                break;
+            case HAND_STRAIGHT_FLUSH: {
+                Rank high;
+                assert(detect_straight_flush(cards, HAND_SIZE, &high));
+                assert(high == hand.tiebreakers[0]);
+                break;
+            }
+            case HAND_FOUR_OF_A_KIND:
+                assert(detect_four_of_a_kind(cards, HAND_SIZE, NULL, tiebreakers, &num));
+                break;
+            case HAND_FULL_HOUSE:
+                assert(detect_full_house(cards, HAND_SIZE, NULL, tiebreakers, &num));
+                break;
+            case HAND_FLUSH:
+                assert(detect_flush(cards, HAND_SIZE, tiebreakers, &num));
+                break;
+            case HAND_STRAIGHT:
+                assert(detect_straight(cards, HAND_SIZE, tiebreakers, &num));
+                break;
+            case HAND_THREE_OF_A_KIND:
+                assert(detect_three_of_a_kind(cards, HAND_SIZE, NULL, tiebreakers, &num));
+                break;
+            case HAND_TWO_PAIR:
+                assert(detect_two_pair(cards, HAND_SIZE, NULL, tiebreakers, &num));
+                break;
+            case HAND_ONE_PAIR:
+                assert(detect_one_pair(cards, HAND_SIZE, NULL, tiebreakers, &num));
+                break;
+            default:
+                assert(detect_high_card(cards, HAND_SIZE, tiebreakers, &num));
+                break;
+        }
+        if (num > 0) {
+            assert(num == hand.num_tiebreakers);
+            assert(memcmp(tiebreakers, hand.tiebreakers, num * sizeof(Rank)) == 0);
+        }
+        checked++;
+    }
+
+    for (int cat = HAND_HIGH_CARD; cat <= HAND_ROYAL_FLUSH; cat++) {
+        assert(counts[cat] == EXPECTED[cat]);
+    }
+    assert(checked > 10000);
+
+    printf("  ✓ Distribution exact; %ld hands cross-checked with detectors\n", checked);
+}
+
+void test_evaluate_mask_seven_brute_force(void) {
+    printf("Testing evaluate_mask on 7 cards equals best of 21 subsets...\n");
+
+    uint32_t state = 12345u;
+    for (int trial = 0; trial < 200000; trial++) {
+        int idx[7];
+        uint64_t mask = 0;
+        for (int i = 0; i < 7; i++) {
+            do {
+                state = state * 1664525u + 1013904223u;
+                idx[i] = (int)((state >> 8) % DECK_SIZE);
+            } while (mask & (UINT64_C(1) << idx[i]));
+            mask |= UINT64_C(1) << idx[i];
+        }
+
+        HandValue best = 0;
+        for (int skip1 = 0; skip1 < 7; skip1++) {
+            for (int skip2 = skip1 + 1; skip2 < 7; skip2++) {
+                const uint64_t five = mask & ~(UINT64_C(1) << idx[skip1]) & ~(UINT64_C(1) << idx[skip2]);
+                const HandValue v = evaluate_mask(five);
+                best = (v > best) ? v : best;
+            }
+        }
+        assert(evaluate_mask(mask) == best);
+
+        uint32_t suits[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 7; i++) {
+            suits[idx[i] & 3] |= 1u << (idx[i] >> 2);
+        }
+        assert(evaluate_suits(suits) == best);
+    }
+
+    printf("  ✓ 200000 random 7-card hands match brute force (mask and suit forms)\n");
+}
+
+void test_compare_hands(void) {
+    printf("Testing compare_hands ordering...\n");
+
+    const Hand flush = eval("Kh Jh 9h 6h 2h");
+    const Hand straight = eval("9c8h7d6s5c");
+    const Hand wheel = eval("5h4d3c2sAh");
+    const Hand pair_a = eval("AhAd9c7s5h");
+    const Hand pair_a2 = eval("AsAc9d7h5d");
+    const Hand pair_a_low = eval("AsAc9d7h4d");
+
+    assert(compare_hands(&flush, &straight) > 0);
+    assert(compare_hands(&straight, &wheel) > 0);
+    assert(compare_hands(&wheel, &pair_a) > 0);
+    assert(compare_hands(&pair_a, &pair_a2) == 0);
+    assert(compare_hands(&pair_a, &pair_a_low) > 0);
+    assert(compare_hands(&pair_a_low, &pair_a) < 0);
+
+    printf("  ✓ Hands ordered correctly\n");
+}
+
+void test_evaluate_hand_invalid(void) {
+    printf("Testing evaluate_hand error handling...\n");
+
+    Card cards[8];
+    Hand hand;
+    const size_t n = cards_from("AhKhQhJhTh9h8h", cards);
+
+    poker_errno = POKER_EOK;
+    assert(evaluate_hand(NULL, 5, &hand) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(evaluate_hand(cards, 4, &hand) == -1);
+    assert(evaluate_hand(cards, n, NULL) == -1);
+    cards[7] = cards[0];
+    assert(evaluate_hand(cards, 8, &hand) == -1);
+
+    cards[1] = cards[0];
+    assert(evaluate_hand(cards, 5, &hand) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+
+    cards[1].rank = 1;
+    assert(evaluate_hand(cards, 5, &hand) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    assert(evaluate_mask(0x1F) != 0);
+    assert(evaluate_mask(0xF) == 0);                       /* 4 cards */
+    assert(evaluate_mask(0xFF) == 0);                      /* 8 cards */
+    assert(evaluate_mask(UINT64_C(0xF) | (UINT64_C(1) << 60)) == 0);
+
+    const uint32_t five[4] = {0x1F, 0, 0, 0};
+    const uint32_t four[4] = {0x3, 0x1, 0x1, 0};
+    const uint32_t eight[4] = {0xFF, 0, 0, 0};
+    const uint32_t high[4] = {0xF, 0, 0, 1u << 13};
+    assert(evaluate_suits(five) == evaluate_mask(UINT64_C(0x11111)));
+    assert(evaluate_suits(four) == 0);
+    assert(evaluate_suits(eight) == 0);
+    assert(evaluate_suits(high) == 0);
+
+    printf("  ✓ Invalid input rejected\n");
+}
+
+void test_evaluate_card_rows(void) {
+    printf("Testing evaluate_card_rows across threads...\n");
+
+    /* Enough rows for several threads; every 97th row repeats a card */
+    enum { ROWS = 100000 };
+    static uint8_t cards[ROWS * 7];
+    static HandValue values[ROWS];
+    uint32_t state = 99u;
+    for (size_t i = 0; i < ROWS; i++) {
+        uint64_t used = 0;
+        for (size_t c = 0; c < 7; c++) {
+            uint8_t card;
+            do {
+                state = state * 1103515245u + 12345u;
+                card = (uint8_t)((state >> 16) % DECK_SIZE);
+            } while (used & (UINT64_C(1) << card));
+            used |= UINT64_C(1) << card;
+            cards[i * 7 + c] = card;
+        }
+        if (i % 97 == 0) {
+            cards[i * 7 + 6] = cards[i * 7];
+        }
+    }
+    cards[5 * 7 + 3] = DECK_SIZE;
+
+    assert(evaluate_card_rows(cards, ROWS, 7, 4, values) == 0);
+    for (size_t i = 0; i < ROWS; i++) {
+        uint64_t mask = 0;
+        for (size_t c = 0; c < 7; c++) {
+            mask |= (cards[i * 7 + c] < DECK_SIZE) ? UINT64_C(1) << cards[i * 7 + c] : 0;
+        }
+        const int valid = (i % 97 != 0) && (i != 5);
+        assert(values[i] == (valid ? evaluate_mask(mask) : 0));
+    }
+
+    /* Five-card rows: the first five cards of each row */
+    assert(evaluate_card_rows(cards + 7, 1, 5, 0, values) == 0);
+    const uint64_t five = (UINT64_C(1) << cards[7]) | (UINT64_C(1) << cards[8]) |
+                          (UINT64_C(1) << cards[9]) | (UINT64_C(1) << cards[10]) |
+                          (UINT64_C(1) << cards[11]);
+    assert(values[0] == evaluate_mask(five));
+
+    poker_errno = POKER_EOK;
+    assert(evaluate_card_rows(cards, ROWS, 4, 1, values) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(evaluate_card_rows(NULL, 1, 7, 1, values) == -1);
+    assert(evaluate_card_rows(NULL, 0, 7, 1, NULL) == 0);
+
+    printf("  ✓ Rows match evaluate_mask(), invalid rows give 0\n");
+}
+
+int main(void) {
+    printf("\n=== Hand Evaluation Test Suite ===\n\n");
+
+    test_evaluate_hand_categories();
+    test_evaluate_hand_seven_cards();
+    test_evaluate_hand_matches_detectors();
+    test_evaluate_mask_seven_brute_force();
+    test_compare_hands();
+    test_evaluate_hand_invalid();
+    test_evaluate_card_rows();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,240 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "../include/poker.h"
+
+/*
+ * Test Suite for Formatting Functions
+ * Tests verify card, mask, category and hand description formatting
+ */
+
+/* Static helper: build a hand with category and tiebreakers */
+static Hand make_hand(const char* const cards, const HandCategory category,
+                      const Rank* const tiebreakers, const size_t num) {
+    Hand hand;
+    memset(&hand, 0, sizeof(hand));
+    assert(parse_hand(cards, strlen(cards), hand.cards, HAND_SIZE, NULL) == HAND_SIZE);
+    hand.category = category;
+    for (size_t i = 0; i < num; i++) {
+        hand.tiebreakers[i] = tiebreakers[i];
+    }
+    hand.num_tiebreakers = num;
+    return hand;
+}
+
+void test_card_to_string_table_driven(void) {
+    printf("Testing card_to_string for all 52 cards...\n");
+
+    char buffer[3];
+    for (size_t i = 0; i < DECK_SIZE; i++) {
+        Card card = CARD_FROM_INDEX(i);
+        Card parsed;
+        assert(card_to_string(card, buffer, sizeof(buffer)) == 0);
+        assert(parse_card(buffer, &parsed) == 0);
+        assert(parsed.rank == card.rank && parsed.suit == card.suit);
+    }
+
+    Card invalid = {RANK_ACE, 7};
+    assert(card_to_string(invalid, buffer, sizeof(buffer)) == -1);
+
+    printf("  ✓ card_to_string round-trips all cards\n");
+}
+
+void test_hand_category_name(void) {
+    printf("Testing hand_category_name...\n");
+
+    assert(strcmp(hand_category_name(HAND_HIGH_CARD), "High Card") == 0);
+    assert(strcmp(hand_category_name(HAND_TWO_PAIR), "Two Pair") == 0);
+    assert(strcmp(hand_category_name(HAND_FULL_HOUSE), "Full House") == 0);
+    assert(strcmp(hand_category_name(HAND_ROYAL_FLUSH), "Royal Flush") == 0);
+    assert(strcmp(hand_category_name((HandCategory)0), "Unknown") == 0);
+    assert(strcmp(hand_category_name((HandCategory)11), "Unknown") == 0);
+
+    printf("  ✓ Category names correct\n");
+}
+
+void test_format_cards(void) {
+    printf("Testing format_cards...\n");
+
+    Card cards[5];
+    char buffer[32];
+    assert(parse_hand("AhKsQd7c2s", 10, cards, 5, NULL) == 5);
+
+    assert(format_cards(cards, 5, '\0', buffer, sizeof(buffer)) == 10);
+    assert(strcmp(buffer, "AhKsQd7c2s") == 0);
+
+    assert(format_cards(cards, 5, ' ', buffer, sizeof(buffer)) == 14);
+    assert(strcmp(buffer, "Ah Ks Qd 7c 2s") == 0);
+
+    /* Zero cards gives an empty string */
+    assert(format_cards(NULL, 0, ' ', buffer, sizeof(buffer)) == 0);
+    assert(buffer[0] == '\0');
+
+    printf("  ✓ Cards formatted correctly\n");
+}
+
+void test_format_cards_errors(void) {
+    printf("Testing format_cards error handling...\n");
+
+    Card cards[2] = {{RANK_ACE, SUIT_HEARTS}, {RANK_KING, SUIT_SPADES}};
+    char buffer[8];
+
+    /* Exact fit: 4 chars + NUL */
+    assert(format_cards(cards, 2, '\0', buffer, 5) == 4);
+
+    /* One byte short */
+    poker_errno = POKER_EOK;
+    assert(format_cards(cards, 2, '\0', buffer, 4) == -1);
+    assert(poker_errno == POKER_ERANGE);
+    assert(buffer[0] == '\0');
+
+    /* Invalid card */
+    cards[1].rank = 1;
+    assert(format_cards(cards, 2, '\0', buffer, sizeof(buffer)) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    assert(format_cards(cards, 2, '\0', NULL, 8) == -1);
+    assert(format_cards(NULL, 2, '\0', buffer, 8) == -1);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+void test_format_card_mask(void) {
+    printf("Testing format_card_mask...\n");
+
+    char buffer[DECK_SIZE * 3];
+    uint64_t mask;
+
+    assert(parse_hand_mask("Ah 2c Ks", 8, &mask, NULL) == 3);
+    assert(format_card_mask(mask, ' ', buffer, sizeof(buffer)) == 8);
+    assert(strcmp(buffer, "2c Ks Ah") == 0);
+
+    /* Round trip the full deck */
+    const uint64_t full = (UINT64_C(1) << DECK_SIZE) - 1;
+    assert(format_card_mask(full, '\0', buffer, sizeof(buffer)) == DECK_SIZE * 2);
+    assert(parse_hand_mask(buffer, DECK_SIZE * 2, &mask, NULL) == DECK_SIZE);
+    assert(mask == full);
+
+    /* Bits beyond the deck are rejected */
+    assert(format_card_mask(UINT64_C(1) << DECK_SIZE, ' ', buffer, sizeof(buffer)) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    printf("  ✓ Card masks formatted correctly\n");
+}
+
+void test_format_hand_description(void) {
+    printf("Testing format_hand_description for all categories...\n");
+
+    struct {
+        const char* cards;
+        HandCategory category;
+        Rank tiebreakers[MAX_TIEBREAKERS];
+        size_t num;
+        const char* expected;
+    } cases[] = {
+        {"AhJd8c5s2h", HAND_HIGH_CARD, {RANK_ACE, RANK_JACK, RANK_EIGHT, RANK_FIVE, RANK_TWO}, 5,
+         "High Card, Ace"},
+        {"ThTd7c4s2h", HAND_ONE_PAIR, {RANK_TEN, RANK_SEVEN, RANK_FOUR, RANK_TWO}, 4,
+         "One Pair, Tens"},
+        {"AsAd9h9cKh", HAND_TWO_PAIR, {RANK_ACE, RANK_NINE, RANK_KING}, 3,
+         "Two Pair, Aces and Nines"},
+        {"6h6d6c8s3h", HAND_THREE_OF_A_KIND, {RANK_SIX, RANK_EIGHT, RANK_THREE}, 3,
+         "Three of a Kind, Sixes"},
+        {"9h8d7c6s5h", HAND_STRAIGHT, {RANK_NINE}, 1,
+         "Straight, Nine high"},
+        {"AcJc9c7c3c", HAND_FLUSH, {RANK_ACE, RANK_JACK, RANK_NINE, RANK_SEVEN, RANK_THREE}, 5,
+         "Flush, Ace high"},
+        {"KhKdKc5s5h", HAND_FULL_HOUSE, {RANK_KING, RANK_FIVE}, 2,
+         "Full House, Kings full of Fives"},
+        {"QhQdQcQs2h", HAND_FOUR_OF_A_KIND, {RANK_QUEEN, RANK_TWO}, 2,
+         "Four of a Kind, Queens"},
+        {"5d4d3d2dAd", HAND_STRAIGHT_FLUSH, {RANK_FIVE}, 1,
+         "Straight Flush, Five high"},
+        {"AhKhQhJhTh", HAND_ROYAL_FLUSH, {RANK_ACE}, 1,
+         "Royal Flush"},
+    };
+
+    char buffer[64];
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        Hand hand = make_hand(cases[i].cards, cases[i].category,
+                              cases[i].tiebreakers, cases[i].num);
+        int n = format_hand_description(&hand, buffer, sizeof(buffer));
+        assert(n == (int)strlen(cases[i].expected));
+        assert(strcmp(buffer, cases[i].expected) == 0);
+    }
+
+    printf("  ✓ All descriptions correct\n");
+}
+
+void test_format_hand_description_errors(void) {
+    printf("Testing format_hand_description error handling...\n");
+
+    const Rank two_pair[] = {RANK_ACE, RANK_NINE, RANK_KING};
+    Hand hand = make_hand("AsAd9h9cKh", HAND_TWO_PAIR, two_pair, 3);
+    char buffer[64];
+
+    /* Buffer too small */
+    assert(format_hand_description(&hand, buffer, 10) == -1);
+    assert(poker_errno == POKER_ERANGE);
+
+    /* Missing second rank for two pair */
+    hand.num_tiebreakers = 1;
+    assert(format_hand_description(&hand, buffer, sizeof(buffer)) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    /* Invalid category */
+    hand.num_tiebreakers = 3;
+    hand.category = (HandCategory)42;
+    assert(format_hand_description(&hand, buffer, sizeof(buffer)) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    assert(format_hand_description(NULL, buffer, sizeof(buffer)) == -1);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+void test_format_hands_batch(void) {
+    printf("Testing format_hands batch output...\n");
+
+    const Rank two_pair[] = {RANK_ACE, RANK_NINE, RANK_KING};
+    const Rank royal[] = {RANK_ACE};
+    Hand hands[2];
+    hands[0] = make_hand("AsAd9h9cKh", HAND_TWO_PAIR, two_pair, 3);
+    hands[1] = make_hand("AhKhQhJhTh", HAND_ROYAL_FLUSH, royal, 1);
+
+    const char* expected =
+        "AsAd9h9cKh\tTwo Pair\tTwo Pair, Aces and Nines\n"
+        "AhKhQhJhTh\tRoyal Flush\tRoyal Flush\n";
+
+    char buffer[256];
+    assert(format_hands(hands, 2, buffer, sizeof(buffer)) == (int)strlen(expected));
+    assert(strcmp(buffer, expected) == 0);
+
+    /* All-or-nothing when the buffer is too small */
+    assert(format_hands(hands, 2, buffer, strlen(expected)) == -1);
+    assert(poker_errno == POKER_ERANGE);
+    assert(buffer[0] == '\0');
+
+    /* An invalid hand anywhere in the batch is rejected */
+    hands[1].cards[0].suit = 9;
+    assert(format_hands(hands, 2, buffer, sizeof(buffer)) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    printf("  ✓ Batch output correct\n");
+}
+
+int main(void) {
+    printf("\n=== Format Test Suite ===\n\n");
+
+    test_card_to_string_table_driven();
+    test_hand_category_name();
+    test_format_cards();
+    test_format_cards_errors();
+    test_format_card_mask();
+    test_format_hand_description();
+    test_format_hand_description_errors();
+    test_format_hands_batch();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
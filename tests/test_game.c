@@ -0,0 +1,288 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "../include/poker_game.h"
+
+/*
+ * Test Suite for the No-Limit Hold'em game engine
+ * Tests verify blinds and action order, raise sizing, incomplete all-ins,
+ * run-outs and settlement, chip conservation and replay over random
+ * self-play, batch stepping and error handling
+ */
+
+/* Static helper: chips at a table (stacks plus pot) */
+static uint64_t table_chips(const GameTables* const g, const size_t t) {
+    const size_t n = g->config.num_seats;
+    uint64_t total = 0;
+    for (size_t seat = 0; seat < n; seat++) {
+        total += g->stack[t * n + seat];
+    }
+    return (g->street[t] == GAME_STREET_DONE) ? total : total + g->pot[t];
+}
+
+/* Static helper: pick a random legal action */
+static void random_action(const GameTables* const g, const size_t t, uint32_t* const state,
+                          uint8_t* const action, uint32_t* const raise_to) {
+    GameLegal legal;
+    assert(game_legal_actions(g, t, &legal) == 0);
+    *state = *state * 1103515245u + 12345u;
+    const unsigned r = (*state >> 16) % 10;
+    if (r < 2 && (legal.actions & (1u << GAME_ACTION_FOLD))) {
+        *action = GAME_ACTION_FOLD;
+    } else if (r >= 7 && (legal.actions & (1u << GAME_ACTION_RAISE))) {
+        *action = GAME_ACTION_RAISE;
+        const uint32_t span = legal.max_raise_to - legal.min_raise_to;
+        *raise_to = (r == 9) ? legal.max_raise_to : legal.min_raise_to + (span ? (*state >> 8) % span : 0);
+    } else {
+        *action = GAME_ACTION_CHECK_CALL;
+    }
+}
+
+void test_game_blinds_and_order(void) {
+    printf("Testing blinds and action order...\n");
+
+    const GameConfig config = {3, 5, 10, 1000};
+    GameTables* const g = game_tables_create(&config, 2);
+    assert(g != NULL);
+    assert(g->street[0] == GAME_STREET_DONE);
+    GameLegal legal;
+
+    /* Three-handed: SB seat 1, BB seat 2, button acts first */
+    assert(game_start_hand(g, 0, 0, 1, NULL) == 0);
+    assert(g->street[0] == GAME_STREET_PREFLOP && g->to_act[0] == 0);
+    assert(g->stack[1] == 995 && g->stack[2] == 990 && g->pot[0] == 15);
+    assert(__builtin_popcountll(g->hole[0]) == 2 && (g->hole[0] & g->hole[1]) == 0);
+    assert(game_legal_actions(g, 0, &legal) == 0);
+    assert(legal.seat == 0 && legal.to_call == 10);
+    assert(legal.actions == 7 && legal.min_raise_to == 20 && legal.max_raise_to == 1000);
+
+    /* Call, call, big blind checks its option: flop dealt, SB first */
+    assert(game_apply(g, 0, GAME_ACTION_CHECK_CALL, 0) == 0);
+    assert(game_apply(g, 0, GAME_ACTION_CHECK_CALL, 0) == 0);
+    assert(g->to_act[0] == 2);
+    assert(game_legal_actions(g, 0, &legal) == 0 && legal.to_call == 0);
+    assert(!(legal.actions & (1u << GAME_ACTION_FOLD)));
+    assert(game_apply(g, 0, GAME_ACTION_CHECK_CALL, 0) == 0);
+    assert(g->street[0] == GAME_STREET_FLOP && g->to_act[0] == 1);
+    assert(__builtin_popcountll(g->board[0]) == 3 && g->pot[0] == 30);
+    assert(g->committed[1] == 0 && g->current_bet[0] == 0);
+
+    /* Heads-up: the button posts the small blind and acts first preflop only */
+    const uint32_t stacks[3] = {500, 0, 700};
+    assert(game_start_hand(g, 1, 2, 2, stacks) == 0);
+    assert(g->seated[1] == 0x5 && g->hole[1 * 3 + 1] == 0);
+    assert(g->committed[1 * 3 + 2] == 5 && g->committed[1 * 3 + 0] == 10);
+    assert(g->to_act[1] == 2);
+    assert(game_apply(g, 1, GAME_ACTION_CHECK_CALL, 0) == 0);
+    assert(g->to_act[1] == 0);
+    assert(game_apply(g, 1, GAME_ACTION_CHECK_CALL, 0) == 0);
+    assert(g->street[1] == GAME_STREET_FLOP && g->to_act[1] == 0);
+
+    /* Folding to the big blind ends the hand without a board */
+    assert(game_start_hand(g, 0, 0, 3, NULL) == 0);
+    assert(game_apply(g, 0, GAME_ACTION_FOLD, 0) == 0);
+    assert(game_apply(g, 0, GAME_ACTION_FOLD, 0) == 0);
+    assert(g->street[0] == GAME_STREET_DONE && g->to_act[0] == GAME_NO_SEAT);
+    assert(g->board[0] == 0 && g->won[2] == 15 && g->stack[2] == 1005 && g->stack[1] == 995);
+    assert(game_legal_actions(g, 0, &legal) == -1);
+
+    game_tables_destroy(g);
+    printf("  ✓ Blinds posted and seats act in order\n");
+}
+
+void test_game_raises(void) {
+    printf("Testing raise sizing and incomplete all-ins...\n");
+
+    const GameConfig config = {3, 5, 10, 1000};
+    GameTables* const g = game_tables_create(&config, 1);
+    GameLegal legal;
+
+    /* Raise to 30 (increment 20): the next full raise is to 50 */
+    assert(game_start_hand(g, 0, 0, 4, NULL) == 0);
+    assert(game_apply(g, 0, GAME_ACTION_RAISE, 19) == -1);
+    assert(game_apply(g, 0, GAME_ACTION_RAISE, 30) == 0);
+    assert(game_legal_actions(g, 0, &legal) == 0);
+    assert(legal.seat == 1 && legal.to_call == 25 && legal.min_raise_to == 50);
+    assert(game_apply(g, 0, GAME_ACTION_RAISE, 49) == -1);
+    assert(game_apply(g, 0, GAME_ACTION_RAISE, 1001) == -1);
+    assert(game_apply(g, 0, GAME_ACTION_RAISE, 80) == 0);   /* Increment 50 */
+    assert(game_legal_actions(g, 0, &legal) == 0 && legal.min_raise_to == 130);
+
+    /* Short all-in raise does not reopen the betting to seats that acted */
+    const uint32_t stacks[3] = {1000, 1000, 60};
+    assert(game_start_hand(g, 0, 0, 5, stacks) == 0);
+    assert(game_apply(g, 0, GAME_ACTION_RAISE, 40) == 0);       /* Button raises to 40 */
+    assert(game_apply(g, 0, GAME_ACTION_CHECK_CALL, 0) == 0);   /* SB calls */
+    assert(game_legal_actions(g, 0, &legal) == 0);
+    assert(legal.seat == 2 && legal.min_raise_to == 60 && legal.max_raise_to == 60);
+    assert(game_apply(g, 0, GAME_ACTION_RAISE, 60) == 0);       /* BB all-in, 20 more */
+    assert(g->all_in[0] == 0x4 && g->current_bet[0] == 60);
+    assert(game_legal_actions(g, 0, &legal) == 0);
+    assert(legal.seat == 0 && legal.to_call == 20);
+    assert(!(legal.actions & (1u << GAME_ACTION_RAISE)));
+    assert(game_apply(g, 0, GAME_ACTION_RAISE, 100) == -1);
+    assert(game_apply(g, 0, GAME_ACTION_CHECK_CALL, 0) == 0);
+    assert(game_apply(g, 0, GAME_ACTION_CHECK_CALL, 0) == 0);
+    assert(g->street[0] == GAME_STREET_FLOP && g->pot[0] == 180);
+
+    game_tables_destroy(g);
+    printf("  ✓ Minimum raises and reopening follow no-limit rules\n");
+}
+
+void test_game_all_in_run_out(void) {
+    printf("Testing all-in run-outs and side pots...\n");
+
+    const GameConfig config = {3, 5, 10, 1000};
+    GameTables* const g = game_tables_create(&config, 1);
+
+    /* Everyone all-in preflop with different stacks */
+    for (uint64_t seed = 0; seed < 200; seed++) {
+        const uint32_t stacks[3] = {100, 300, 1000};
+        assert(game_start_hand(g, 0, 0, seed, stacks) == 0);
+        assert(game_apply(g, 0, GAME_ACTION_RAISE, 100) == 0);
+        assert(game_apply(g, 0, GAME_ACTION_RAISE, 300) == 0);
+        assert(game_apply(g, 0, GAME_ACTION_CHECK_CALL, 0) == 0);
+        assert(g->street[0] == GAME_STREET_DONE);
+        assert(__builtin_popcountll(g->board[0]) == 5);
+        assert((g->board[0] & (g->hole[0] | g->hole[1] | g->hole[2])) == 0);
+        assert(g->stack[0] + g->stack[1] + g->stack[2] == 1400);
+        /* Big stack gets its uncalled 700 back; the short stack wins at most 300 */
+        assert(g->stack[2] >= 700 && g->won[0] <= 300);
+    }
+
+    /* One player left with chips: the board runs out without more betting */
+    const uint32_t stacks[3] = {1000, 1000, 50};
+    assert(game_start_hand(g, 0, 0, 9, stacks) == 0);
+    assert(game_apply(g, 0, GAME_ACTION_FOLD, 0) == 0);
+    assert(game_apply(g, 0, GAME_ACTION_RAISE, 1000) == 0);
+    assert(game_apply(g, 0, GAME_ACTION_CHECK_CALL, 0) == 0);
+    assert(g->street[0] == GAME_STREET_DONE && g->contributed[2] == 50);
+    assert(g->stack[0] + g->stack[1] + g->stack[2] == 2050);
+    assert(g->stack[1] >= 950);
+
+    game_tables_destroy(g);
+    printf("  ✓ Boards run out and side pots pay exactly\n");
+}
+
+void test_game_self_play(void) {
+    printf("Testing random self-play and replay...\n");
+
+    const size_t tables = 512;
+    for (size_t seats = 2; seats <= MAX_PLAYERS; seats += 4) {
+        const GameConfig config = {seats, 1, 2, 200};
+        GameTables* const g = game_tables_create(&config, tables);
+        GameTables* const replay = game_tables_create(&config, tables);
+        assert(g != NULL && replay != NULL);
+        static uint8_t actions[512];
+        static uint32_t raises[512];
+        uint32_t state = (uint32_t)seats;
+
+        for (size_t hand = 0; hand < 8; hand++) {
+            for (size_t t = 0; t < tables; t++) {
+                assert(game_start_hand(g, t, (t + hand) % seats, t * 31 + hand, NULL) == 0);
+                assert(game_start_hand(replay, t, (t + hand) % seats, t * 31 + hand, NULL) == 0);
+            }
+            size_t live = tables;
+            while (live > 0) {
+                for (size_t t = 0; t < tables; t++) {
+                    if (g->street[t] != GAME_STREET_DONE) {
+                        random_action(g, t, &state, &actions[t], &raises[t]);
+                    }
+                }
+                size_t replay_live = 0;
+                assert(game_apply_batch(g, actions, raises, tables, &live) == 0);
+                for (size_t t = 0; t < tables; t++) {
+                    if (replay->street[t] != GAME_STREET_DONE) {
+                        assert(game_apply(replay, t, actions[t], raises[t]) == 0);
+                    }
+                    replay_live += (replay->street[t] != GAME_STREET_DONE);
+                    assert(table_chips(g, t) == 200 * seats);
+                }
+                assert(replay_live == live);
+            }
+
+            for (size_t t = 0; t < tables; t++) {
+                uint64_t cards = g->board[t];
+                uint64_t won = 0;
+                uint64_t put = 0;
+                for (size_t seat = 0; seat < seats; seat++) {
+                    assert((cards & g->hole[t * seats + seat]) == 0);
+                    cards |= g->hole[t * seats + seat];
+                    won += g->won[t * seats + seat];
+                    put += g->contributed[t * seats + seat];
+                }
+                assert(won == put && put == g->pot[t]);
+            }
+            assert(memcmp(g->stack, replay->stack, tables * seats * sizeof(uint32_t)) == 0);
+            assert(memcmp(g->board, replay->board, tables * sizeof(uint64_t)) == 0);
+        }
+
+        game_tables_destroy(g);
+        game_tables_destroy(replay);
+    }
+
+    printf("  ✓ Chips conserved and hands replay exactly\n");
+}
+
+void test_game_errors(void) {
+    printf("Testing game error handling...\n");
+
+    GameConfig config = {1, 5, 10, 1000};
+    assert(game_tables_create(&config, 4) == NULL);
+    config.num_seats = MAX_PLAYERS + 1;
+    assert(game_tables_create(&config, 4) == NULL);
+    config.num_seats = 2;
+    config.big_blind = 4;
+    assert(game_tables_create(&config, 4) == NULL);
+    config.big_blind = 10;
+    assert(game_tables_create(&config, 0) == NULL);
+    assert(game_tables_create(NULL, 4) == NULL);
+
+    GameTables* const g = game_tables_create(&config, 2);
+    const uint32_t one_seated[2] = {1000, 0};
+    poker_errno = POKER_EOK;
+    assert(game_start_hand(g, 0, 1, 0, one_seated) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(game_start_hand(g, 0, 0, 0, one_seated) == -1);
+    assert(game_start_hand(g, 2, 0, 0, NULL) == -1);
+    assert(game_start_hand(g, 0, 2, 0, NULL) == -1);
+
+    assert(game_apply(g, 0, GAME_ACTION_CHECK_CALL, 0) == -1);   /* Hand not started */
+    assert(game_set_blinds(g, 0, 10) == -1);
+    assert(game_set_blinds(g, 20, 10) == -1);
+    assert(game_set_blinds(NULL, 5, 10) == -1);
+    assert(game_set_blinds(g, 25, 50) == 0);
+    assert(game_start_hand(g, 0, 0, 0, NULL) == 0);
+    assert(g->pot[0] == 75 && g->min_raise[0] == 50);
+    assert(game_set_blinds(g, 5, 10) == 0);
+    assert(game_start_hand(g, 0, 0, 0, NULL) == 0);
+    assert(game_apply(g, 0, 7, 0) == -1);
+    assert(game_apply(g, 0, -1, 0) == -1);
+
+    /* Batch: the illegal table is left alone, the legal one steps */
+    assert(game_start_hand(g, 1, 0, 0, NULL) == 0);
+    const uint8_t actions[2] = {GAME_ACTION_RAISE, GAME_ACTION_FOLD};
+    const uint32_t raises[2] = {15, 0};
+    size_t live = 9;
+    assert(game_apply_batch(g, actions, raises, 2, &live) == -1);
+    assert(g->to_act[0] == 0 && g->street[1] == GAME_STREET_DONE && live == 1);
+    assert(game_apply_batch(g, actions, NULL, 2, NULL) == -1);
+    assert(game_apply_batch(g, actions, raises, 3, NULL) == -1);
+
+    game_tables_destroy(g);
+    game_tables_destroy(NULL);
+    printf("  ✓ Errors reported correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Game Engine Test Suite ===\n\n");
+
+    test_game_blinds_and_order();
+    test_game_raises();
+    test_game_all_in_run_out();
+    test_game_self_play();
+    test_game_errors();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
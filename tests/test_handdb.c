@@ -0,0 +1,331 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/poker_handdb.h"
+
+/*
+ * Test Suite for the Columnar Hand Database
+ * Tests verify row contents, query results against brute force, and that
+ * block indices skip data that cannot match
+ */
+
+static uint32_t rng_state = 88172645u;
+static uint32_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/* Static helper: draw an unused card */
+static uint8_t draw(uint64_t* const used) {
+    unsigned card;
+    do {
+        card = next_random() % DECK_SIZE;
+    } while (*used & (UINT64_C(1) << card));
+    *used |= UINT64_C(1) << card;
+    return (uint8_t)card;
+}
+
+/* Static helper: random record; hero always known, others sometimes shown */
+static void make_record(HandRecord* const rec, const uint64_t hand_id, const uint8_t board_len) {
+    uint64_t used = 0;
+
+    memset(rec, 0, sizeof(*rec));
+    memset(rec->hole, CARD_INDEX_NONE, sizeof(rec->hole));
+    rec->hand_id = hand_id;
+    rec->num_players = (uint8_t)(2 + next_random() % 5);
+    rec->hero = (uint8_t)(next_random() % rec->num_players);
+    rec->board_len = board_len;
+    for (unsigned p = 0; p < rec->num_players; p++) {
+        if (p == rec->hero || next_random() % 2 == 0) {
+            rec->hole[p][0] = draw(&used);
+            rec->hole[p][1] = draw(&used);
+            rec->showdown_mask |= (uint16_t)(1u << p);
+        }
+    }
+    for (unsigned b = 0; b < board_len; b++) {
+        rec->board[b] = draw(&used);
+    }
+    const unsigned roll = next_random() % 10;
+    if (roll == 0) {
+        rec->winner_mask = 0;
+    } else if (roll == 1) {
+        rec->winner_mask = 0x3;  /* Split between players 0 and 1 */
+    } else {
+        rec->winner_mask = (uint16_t)(1u << (next_random() % rec->num_players));
+    }
+}
+
+/* Expected row computed independently of the database code */
+typedef struct {
+    uint64_t hand_id;
+    HandCategory category;
+    HandValue strength;
+    uint8_t result;
+    int is_hero;
+} ExpectedRow;
+
+static size_t expected_rows(const HandRecord* const records, const size_t count,
+                            ExpectedRow* const out) {
+    size_t n = 0;
+    for (size_t r = 0; r < count; r++) {
+        const HandRecord* const rec = &records[r];
+        for (unsigned p = 0; p < rec->num_players; p++) {
+            if (rec->hole[p][0] == CARD_INDEX_NONE) {
+                continue;
+            }
+            ExpectedRow* const row = &out[n++];
+            row->hand_id = rec->hand_id;
+            row->is_hero = (p == rec->hero);
+            row->category = 0;
+            row->strength = 0;
+            if (rec->board_len >= 3) {
+                Card cards[7];
+                cards[0] = CARD_FROM_INDEX(rec->hole[p][0]);
+                cards[1] = CARD_FROM_INDEX(rec->hole[p][1]);
+                for (unsigned b = 0; b < rec->board_len; b++) {
+                    cards[2 + b] = CARD_FROM_INDEX(rec->board[b]);
+                }
+                Hand hand;
+                assert(evaluate_hand(cards, 2 + rec->board_len, &hand) == 0);
+                row->category = hand.category;
+                row->strength = hand_value(&hand);
+            }
+            if (rec->winner_mask == 0) {
+                row->result = HANDDB_RESULT_UNKNOWN;
+            } else if (!(rec->winner_mask & (1u << p))) {
+                row->result = HANDDB_RESULT_LOST;
+            } else {
+                row->result = (rec->winner_mask == 0x3) ? HANDDB_RESULT_SPLIT : HANDDB_RESULT_WON;
+            }
+        }
+    }
+    return n;
+}
+
+static int row_matches(const ExpectedRow* const row, const HandDbQuery* const q) {
+    if (q->categories && !(q->categories & HANDDB_CATEGORY_BIT(row->category))) return 0;
+    if (q->results && !(q->results & row->result)) return 0;
+    if (q->hero_only && !row->is_hero) return 0;
+    if (row->strength < q->min_strength) return 0;
+    if (q->max_strength && row->strength > q->max_strength) return 0;
+    if (row->hand_id < q->min_hand_id) return 0;
+    if (q->max_hand_id && row->hand_id > q->max_hand_id) return 0;
+    return 1;
+}
+
+/* Callback state: checks rows arrive in order and match expectations */
+typedef struct {
+    const ExpectedRow* expected;
+    const HandDbQuery* query;
+    uint64_t last_row;
+    uint64_t seen;
+    uint64_t stop_after;
+} CheckState;
+
+static int check_row(const HandDbRow* row, void* user_data) {
+    CheckState* const state = (CheckState*)user_data;
+    const ExpectedRow* const want = &state->expected[row->row];
+    assert(state->seen == 0 || row->row > state->last_row);
+    assert(row->hand_id == want->hand_id);
+    assert(row->strength == want->strength);
+    assert(row->category == want->category);
+    assert(row->result == want->result);
+    assert(row->is_hero == want->is_hero);
+    assert(row_matches(want, state->query));
+    state->last_row = row->row;
+    state->seen++;
+    return (state->stop_after != 0 && state->seen >= state->stop_after);
+}
+
+static char path[] = "/tmp/poker_handdb_XXXXXX";
+
+#define NUM_RECORDS 20000
+
+void test_handdb_queries(void) {
+    printf("Testing handdb_query against brute force...\n");
+
+    HandRecord* const records = malloc(NUM_RECORDS * sizeof(HandRecord));
+    ExpectedRow* const expected = malloc(NUM_RECORDS * MAX_PLAYERS * sizeof(ExpectedRow));
+    assert(records != NULL && expected != NULL);
+    static const uint8_t BOARD_LENS[] = {0, 3, 4, 5, 5};
+    for (size_t i = 0; i < NUM_RECORDS; i++) {
+        make_record(&records[i], 1000 + i, BOARD_LENS[next_random() % 5]);
+    }
+    const size_t num_rows = expected_rows(records, NUM_RECORDS, expected);
+
+    HandDbWriter* const writer = handdb_writer_open(path, 1000);
+    assert(writer != NULL);
+    assert(handdb_writer_append(writer, records, NUM_RECORDS / 2) == 0);
+    assert(handdb_writer_append(writer, records + NUM_RECORDS / 2, NUM_RECORDS - NUM_RECORDS / 2) == 0);
+    assert(handdb_writer_close(writer) == 0);
+
+    HandDb* const db = handdb_open(path);
+    assert(db != NULL);
+    assert(handdb_row_count(db) == num_rows);
+
+    HandDbQuery queries[6];
+    memset(queries, 0, sizeof(queries));
+    /* Hero had a flush and lost */
+    queries[0].categories = HANDDB_CATEGORY_BIT(HAND_FLUSH);
+    queries[0].results = HANDDB_RESULT_LOST;
+    queries[0].hero_only = 1;
+    /* Full house or better (by strength) */
+    queries[1].min_strength = (HandValue)HAND_FULL_HOUSE << HAND_VALUE_CATEGORY_SHIFT;
+    /* Splits with two pair or trips */
+    queries[2].categories = HANDDB_CATEGORY_BIT(HAND_TWO_PAIR) | HANDDB_CATEGORY_BIT(HAND_THREE_OF_A_KIND);
+    queries[2].results = HANDDB_RESULT_SPLIT;
+    /* Hand id window, weak hands */
+    queries[3].min_hand_id = 5000;
+    queries[3].max_hand_id = 6000;
+    queries[3].max_strength = (HandValue)(HAND_ONE_PAIR + 1) << HAND_VALUE_CATEGORY_SHIFT;
+    /* Not evaluated (preflop) */
+    queries[4].categories = HANDDB_CATEGORY_BIT(0);
+    /* queries[5]: everything */
+
+    for (size_t qi = 0; qi < sizeof(queries) / sizeof(queries[0]); qi++) {
+        uint64_t want = 0;
+        for (size_t r = 0; r < num_rows; r++) {
+            want += (uint64_t)row_matches(&expected[r], &queries[qi]);
+        }
+
+        CheckState state = {expected, &queries[qi], 0, 0, 0};
+        HandDbQueryStats stats;
+        assert(handdb_query(db, &queries[qi], check_row, &state, &stats) == 0);
+        assert(state.seen == want);
+        assert(stats.rows_matched == want);
+        assert(stats.blocks_total == (num_rows + 999) / 1000);
+        assert(want > 0);
+
+        /* Count-only mode */
+        HandDbQueryStats count_stats;
+        assert(handdb_query(db, &queries[qi], NULL, NULL, &count_stats) == 0);
+        assert(count_stats.rows_matched == want);
+    }
+
+    /* Early stop */
+    CheckState state = {expected, &queries[5], 0, 0, 7};
+    assert(handdb_query(db, NULL, check_row, &state, NULL) == 0);
+    assert(state.seen == 7);
+
+    handdb_close(db);
+    free(expected);
+    free(records);
+    printf("  ✓ %zu rows; all queries match brute force\n", num_rows);
+}
+
+void test_handdb_block_skipping(void) {
+    printf("Testing block indices skip non-matching blocks...\n");
+
+    /* Preflop-only hands first, full boards after: category 0 blocks are skippable */
+    HandRecord* const records = malloc(NUM_RECORDS * sizeof(HandRecord));
+    assert(records != NULL);
+    for (size_t i = 0; i < NUM_RECORDS; i++) {
+        make_record(&records[i], i + 1, (i < NUM_RECORDS * 3 / 4) ? 0 : 5);
+    }
+
+    HandDbWriter* const writer = handdb_writer_open(path, 512);
+    assert(writer != NULL);
+    assert(handdb_writer_append(writer, records, NUM_RECORDS) == 0);
+    assert(handdb_writer_close(writer) == 0);
+
+    HandDb* const db = handdb_open(path);
+    assert(db != NULL);
+
+    HandDbQuery query;
+    memset(&query, 0, sizeof(query));
+    query.categories = HANDDB_CATEGORY_BIT(HAND_FLUSH);
+    query.results = HANDDB_RESULT_LOST;
+    query.hero_only = 1;
+
+    HandDbQueryStats stats;
+    assert(handdb_query(db, &query, NULL, NULL, &stats) == 0);
+    assert(stats.rows_matched > 0);
+    assert(stats.blocks_scanned * 3 < stats.blocks_total);
+    printf("  flush+lost: scanned %zu of %zu blocks\n", stats.blocks_scanned, stats.blocks_total);
+
+    /* Hand id range touches only the blocks that hold it */
+    memset(&query, 0, sizeof(query));
+    query.min_hand_id = 100;
+    query.max_hand_id = 200;
+    assert(handdb_query(db, &query, NULL, NULL, &stats) == 0);
+    assert(stats.blocks_scanned <= 2);
+
+    handdb_close(db);
+    free(records);
+    printf("  ✓ Index pruning effective\n");
+}
+
+void test_handdb_errors(void) {
+    printf("Testing hand database error handling...\n");
+
+    HandDbWriter* const writer = handdb_writer_open(path, 0);
+    assert(writer != NULL);
+    HandRecord rec;
+    make_record(&rec, 1, 5);
+    rec.board[1] = rec.board[0];  /* Duplicate board card */
+    poker_errno = POKER_EOK;
+    assert(handdb_writer_append(writer, &rec, 1) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    make_record(&rec, 1, 5);
+    rec.hole[rec.hero][0] = rec.board[2];  /* Hole card on the board */
+    assert(handdb_writer_append(writer, &rec, 1) == -1);
+    make_record(&rec, 1, 5);
+    rec.board[3] = 200;  /* Out of range, checked before use */
+    assert(handdb_writer_append(writer, &rec, 1) == -1);
+
+    /* A bad record anywhere in a batch appends nothing */
+    HandRecord batch[3];
+    for (int r = 0; r < 3; r++) {
+        make_record(&batch[r], (uint64_t)(r + 1), 5);
+    }
+    batch[2].board[4] = batch[2].board[0];
+    assert(handdb_writer_append(writer, batch, 3) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(handdb_writer_close(writer) == 0);
+
+    /* Empty database is valid */
+    HandDb* db = handdb_open(path);
+    assert(db != NULL && handdb_row_count(db) == 0);
+    HandDbQueryStats stats;
+    assert(handdb_query(db, NULL, NULL, NULL, &stats) == 0);
+    assert(stats.rows_matched == 0 && stats.blocks_total == 0);
+    handdb_close(db);
+    handdb_close(NULL);
+
+    FILE* const file = fopen(path, "wb");
+    assert(file != NULL);
+    fputs("definitely not a hand database, just some text padding", file);
+    fclose(file);
+    assert(handdb_open(path) == NULL);
+    assert(poker_errno == POKER_EFORMAT);
+
+    assert(handdb_open("/nonexistent/hands.db") == NULL);
+    assert(poker_errno == POKER_ENOTFOUND);
+    assert(handdb_query(NULL, NULL, NULL, NULL, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Hand Database Test Suite ===\n\n");
+
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    test_handdb_queries();
+    test_handdb_block_skipping();
+    test_handdb_errors();
+
+    unlink(path);
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,20 @@
+/*
+ * test_helpers.h - Helpers shared by the test suites
+ * Included by test_*.c files; each test is still built on its own
+ */
+
+#ifndef POKER_TEST_HELPERS_H
+#define POKER_TEST_HELPERS_H
+
+#include <assert.h>
+#include <string.h>
+#include "../include/poker.h"
+
+/* Static helper: parse a card string into a mask */
+static uint64_t mask_of(const char* const text) {
+    uint64_t mask = 0;
+    assert(parse_hand_mask(text, strlen(text), &mask, NULL) >= 0);
+    return mask;
+}
+
+#endif /* POKER_TEST_HELPERS_H */
@@ -0,0 +1,264 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/poker_history.h"
+
+/*
+ * Test Suite for Hand-History Ingestion
+ * Tests verify hand splitting, field parsing and parallel ingestion
+ */
+
+static const char* const STARS_HAND =
+    "PokerStars Hand #230000000001: Hold'em No Limit ($0.01/$0.02 USD) - 2024/01/01 12:00:00 ET\n"
+    "Table 'Alpha' 6-max Seat #1 is the button\n"
+    "Seat 1: alice ($2.00 in chips)\n"
+    "Seat 2: bob (the builder) ($2.00 in chips)\n"
+    "Seat 4: carol ($2.00 in chips)\n"
+    "bob (the builder): posts small blind $0.01\n"
+    "carol: posts big blind $0.02\n"
+    "*** HOLE CARDS ***\n"
+    "Dealt to alice [Ah Kd]\n"
+    "alice: raises $0.04 to $0.06\n"
+    "bob (the builder): calls $0.05\n"
+    "carol: folds\n"
+    "*** FLOP *** [2c 7d Jh]\n"
+    "*** TURN *** [2c 7d Jh] [5s]\n"
+    "*** RIVER *** [2c 7d Jh 5s] [Qc]\n"
+    "*** SHOW DOWN ***\n"
+    "alice: shows [Ah Kd] (high card Ace)\n"
+    "bob (the builder): shows [Tc Td] (a pair of Tens)\n"
+    "bob (the builder) collected $0.14 from pot\n"
+    "*** SUMMARY ***\n"
+    "Total pot $0.14 | Rake $0\n"
+    "Board [2c 7d Jh 5s Qc]\n"
+    "Seat 1: alice (button) showed [Ah Kd] and lost with high card Ace\n"
+    "Seat 2: bob (the builder) showed [Tc Td] and won ($0.14) with a pair of Tens\n"
+    "\n\n";
+
+static const char* const GG_HAND =
+    "Poker Hand #HD1234567: Hold'em No Limit ($0.05/$0.1) - 2024/01/02 08:00:00\r\n"
+    "Table 'NLHEGold1' 6-max Seat #2 is the button\r\n"
+    "Seat 1: Hero ($10 in chips)\r\n"
+    "Seat 2: 7f3a9b ($10 in chips)\r\n"
+    "*** HOLE CARDS ***\r\n"
+    "Dealt to Hero [9s 9c]\r\n"
+    "Dealt to 7f3a9b \r\n"
+    "Hero: raises $0.2 to $0.3\r\n"
+    "7f3a9b: folds\r\n"
+    "Hero collected $0.2 from pot\r\n"
+    "*** SUMMARY ***\r\n"
+    "Seat 1: Hero won ($0.2)\r\n";
+
+/* Malformed: duplicate card between hero and board */
+static const char* const BAD_HAND =
+    "PokerStars Hand #230000000002: Hold'em No Limit ($0.01/$0.02 USD)\n"
+    "Seat 1: alice ($2.00 in chips)\n"
+    "Seat 2: bob ($2.00 in chips)\n"
+    "*** HOLE CARDS ***\n"
+    "Dealt to alice [Ah Kd]\n"
+    "*** SUMMARY ***\n"
+    "Board [Ah 7d Jh]\n";
+
+/* Static helper: CARD_INDEX of a two-character card string */
+static uint8_t idx(const char* const str) {
+    Card card;
+    assert(parse_card(str, &card) == 0);
+    return (uint8_t)CARD_INDEX(card);
+}
+
+void test_history_next_hand(void) {
+    printf("Testing history_next_hand boundary detection...\n");
+
+    char buffer[4096];
+    snprintf(buffer, sizeof(buffer), "junk line\n%s%s", STARS_HAND, GG_HAND);
+    const size_t len = strlen(buffer);
+    const size_t first = strlen("junk line\n");
+    const size_t second = first + strlen(STARS_HAND);
+
+    assert(history_next_hand(buffer, len, 0) == first);
+    assert(history_next_hand(buffer, len, first) == first);
+    assert(history_next_hand(buffer, len, first + 1) == second);
+    assert(history_next_hand(buffer, len, second + 5) == len);
+    assert(history_next_hand(NULL, 10, 0) == 10);
+
+    printf("  ✓ Hand boundaries found correctly\n");
+}
+
+void test_history_parse_stars_hand(void) {
+    printf("Testing history_parse_hand with a PokerStars hand...\n");
+
+    HandRecord record;
+    assert(history_parse_hand(STARS_HAND, strlen(STARS_HAND), &record) == 0);
+
+    assert(record.hand_id == UINT64_C(230000000001));
+    assert(record.num_players == 3);
+    assert(record.hero == 0);
+    assert(record.hole[0][0] == idx("Ah") && record.hole[0][1] == idx("Kd"));
+    assert(record.hole[1][0] == idx("Tc") && record.hole[1][1] == idx("Td"));
+    assert(record.hole[2][0] == CARD_INDEX_NONE);
+
+    assert(record.board_len == 5);
+    assert(record.board[0] == idx("2c"));
+    assert(record.board[4] == idx("Qc"));
+
+    assert(record.showdown_mask == 0x3);
+    assert(record.winner_mask == 0x2);
+
+    printf("  ✓ PokerStars hand parsed correctly\n");
+}
+
+void test_history_parse_gg_hand(void) {
+    printf("Testing history_parse_hand with a GGPoker hand (CRLF)...\n");
+
+    HandRecord record;
+    assert(history_parse_hand(GG_HAND, strlen(GG_HAND), &record) == 0);
+
+    assert(record.hand_id == UINT64_C(1234567));
+    assert(record.num_players == 2);
+    assert(record.hero == 0);
+    assert(record.hole[0][0] == idx("9s") && record.hole[0][1] == idx("9c"));
+    assert(record.hole[1][0] == CARD_INDEX_NONE);
+    assert(record.board_len == 0);
+    assert(record.showdown_mask == 0);
+    assert(record.winner_mask == 0x1);
+
+    printf("  ✓ GGPoker hand parsed correctly\n");
+}
+
+void test_history_parse_invalid(void) {
+    printf("Testing history_parse_hand rejects malformed hands...\n");
+
+    HandRecord record;
+    poker_errno = POKER_EOK;
+    assert(history_parse_hand(BAD_HAND, strlen(BAD_HAND), &record) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+
+    assert(history_parse_hand("not a hand\n", 11, &record) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    assert(history_parse_hand(NULL, 0, &record) == -1);
+    assert(history_parse_hand(STARS_HAND, strlen(STARS_HAND), NULL) == -1);
+
+    printf("  ✓ Malformed hands rejected\n");
+}
+
+/* Static helper: build a buffer with many hands, every 7th one malformed */
+static char* build_history(const size_t num_hands, size_t* const out_len,
+                           size_t* const out_bad) {
+    const size_t stars_len = strlen(STARS_HAND);
+    const size_t gg_len = strlen(GG_HAND);
+    const size_t bad_len = strlen(BAD_HAND);
+    char* const buffer = malloc(num_hands * (stars_len + gg_len + bad_len));
+    assert(buffer != NULL);
+
+    size_t len = 0;
+    size_t bad = 0;
+    for (size_t i = 0; i < num_hands; i++) {
+        if (i % 7 == 6) {
+            memcpy(buffer + len, BAD_HAND, bad_len);
+            len += bad_len;
+            bad++;
+        } else if (i % 2 == 0) {
+            memcpy(buffer + len, STARS_HAND, stars_len);
+            len += stars_len;
+        } else {
+            memcpy(buffer + len, GG_HAND, gg_len);
+            len += gg_len;
+        }
+    }
+    *out_len = len;
+    *out_bad = bad;
+    return buffer;
+}
+
+void test_history_parse_buffer_parallel(void) {
+    printf("Testing history_parse_buffer is thread-count independent...\n");
+
+    size_t len, bad;
+    const size_t num_hands = 5000;
+    char* const buffer = build_history(num_hands, &len, &bad);
+
+    HistoryResult single;
+    assert(history_parse_buffer(buffer, len, 1, &single) == 0);
+    assert(single.count == num_hands - bad);
+    assert(single.skipped == bad);
+
+    const size_t thread_counts[] = {2, 3, 8};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        HistoryResult multi;
+        assert(history_parse_buffer(buffer, len, thread_counts[t], &multi) == 0);
+        assert(multi.count == single.count);
+        assert(multi.skipped == single.skipped);
+        assert(memcmp(multi.records, single.records,
+                      single.count * sizeof(HandRecord)) == 0);
+        history_result_free(&multi);
+    }
+
+    history_result_free(&single);
+    assert(single.records == NULL);
+    history_result_free(&single);  /* Safe after NULL poisoning */
+    free(buffer);
+
+    printf("  ✓ Parallel results identical to single-threaded\n");
+}
+
+void test_history_load_file(void) {
+    printf("Testing history_load_file via mmap...\n");
+
+    size_t len, bad;
+    char* const buffer = build_history(1000, &len, &bad);
+
+    char path[] = "/tmp/poker_history_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(write(fd, buffer, len) == (ssize_t)len);
+    close(fd);
+
+    HistoryResult result;
+    assert(history_load_file(path, 0, &result) == 0);
+    assert(result.count == 1000 - bad);
+    assert(result.records[0].hand_id == UINT64_C(230000000001));
+    history_result_free(&result);
+
+    unlink(path);
+    free(buffer);
+
+    poker_errno = POKER_EOK;
+    assert(history_load_file("/nonexistent/history.txt", 1, &result) == -1);
+    assert(poker_errno == POKER_ENOTFOUND);
+
+    printf("  ✓ File ingestion works\n");
+}
+
+void test_history_empty_input(void) {
+    printf("Testing history_parse_buffer with empty input...\n");
+
+    HistoryResult result;
+    assert(history_parse_buffer(NULL, 0, 4, &result) == 0);
+    assert(result.count == 0 && result.records == NULL);
+
+    assert(history_parse_buffer("no hands here\n", 14, 4, &result) == 0);
+    assert(result.count == 0 && result.skipped == 0);
+    history_result_free(&result);
+
+    printf("  ✓ Empty input handled\n");
+}
+
+int main(void) {
+    printf("\n=== Hand History Test Suite ===\n\n");
+
+    test_history_next_hand();
+    test_history_parse_stars_hand();
+    test_history_parse_gg_hand();
+    test_history_parse_invalid();
+    test_history_parse_buffer_parallel();
+    test_history_load_file();
+    test_history_empty_input();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
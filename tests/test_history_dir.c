@@ -0,0 +1,198 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/poker_history.h"
+
+/*
+ * Test Suite for Directory Ingestion
+ * Tests verify io_uring and pread paths deliver every file exactly once
+ */
+
+static const char* const HAND_TEMPLATE =
+    "PokerStars Hand #%u: Hold'em No Limit ($0.01/$0.02 USD)\n"
+    "Seat 1: alice ($2.00 in chips)\n"
+    "Seat 2: bob ($2.00 in chips)\n"
+    "*** HOLE CARDS ***\n"
+    "Dealt to alice [Ah Kd]\n"
+    "*** SHOW DOWN ***\n"
+    "bob: shows [Tc Td] (a pair of Tens)\n"
+    "bob collected $0.04 from pot\n"
+    "*** SUMMARY ***\n"
+    "Board [2c 7d Jh 5s Qc]\n\n";
+
+#define NUM_FILES 300
+#define HANDS_PER_FILE 3
+#define BIG_FILE_HANDS 400  /* Well over the 64KB initial read buffer */
+
+/* Callback accumulator */
+typedef struct {
+    size_t files;
+    size_t records;
+    uint64_t id_sum;
+    size_t stop_after;  /* 0 = never stop */
+} Totals;
+
+static char dir_path[] = "/tmp/poker_dir_XXXXXX";
+static uint64_t expected_id_sum = 0;
+static size_t expected_records = 0;
+
+/* Static helper: write a file of num_hands hands with ids starting at first_id */
+static void write_history(const char* const name, const unsigned first_id,
+                          const unsigned num_hands) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir_path, name);
+    FILE* const file = fopen(path, "w");
+    assert(file != NULL);
+    for (unsigned h = 0; h < num_hands; h++) {
+        fprintf(file, HAND_TEMPLATE, first_id + h);
+        expected_id_sum += first_id + h;
+        expected_records++;
+    }
+    fclose(file);
+}
+
+static void setup_directory(void) {
+    assert(mkdtemp(dir_path) != NULL);
+
+    char name[64];
+    unsigned id = 1;
+    for (unsigned f = 0; f < NUM_FILES; f++) {
+        snprintf(name, sizeof(name), "session_%03u.txt", f);
+        write_history(name, id, HANDS_PER_FILE);
+        id += HANDS_PER_FILE;
+    }
+    write_history("big_session.txt", id, BIG_FILE_HANDS);
+
+    /* Ignored: hidden file and subdirectory */
+    char path[256];
+    snprintf(path, sizeof(path), "%s/.hidden", dir_path);
+    FILE* const hidden = fopen(path, "w");
+    assert(hidden != NULL);
+    fprintf(hidden, HAND_TEMPLATE, 999999u);
+    fclose(hidden);
+    snprintf(path, sizeof(path), "%s/subdir", dir_path);
+    assert(mkdir(path, 0700) == 0);
+}
+
+static void teardown_directory(void) {
+    char cmd[300];
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", dir_path);
+    assert(system(cmd) == 0);
+}
+
+static int count_records(const char* name, const HandRecord* records,
+                         size_t count, void* user_data) {
+    Totals* const totals = (Totals*)user_data;
+    assert(name != NULL && name[0] != '.');
+    totals->files++;
+    totals->records += count;
+    for (size_t i = 0; i < count; i++) {
+        assert(records[i].num_players == 2);
+        assert(records[i].winner_mask == 0x2);
+        totals->id_sum += records[i].hand_id;
+    }
+    return (totals->stop_after != 0 && totals->files >= totals->stop_after) ? 1 : 0;
+}
+
+/* Static helper: load the test directory and check every hand arrived once */
+static void check_full_load(const size_t threads, const int use_io_uring) {
+    HistoryDirOptions options = {threads, 16, use_io_uring};
+    HistoryDirStats stats;
+    Totals totals = {0, 0, 0, 0};
+
+    assert(history_load_directory(dir_path, &options, count_records, &totals, &stats) == 0);
+    assert(totals.files == NUM_FILES + 1);
+    assert(totals.records == expected_records);
+    assert(totals.id_sum == expected_id_sum);
+    assert(stats.files == NUM_FILES + 1);
+    assert(stats.records == expected_records);
+    assert(stats.failed_files == 0 && stats.skipped == 0);
+    if (!use_io_uring) {
+        assert(stats.used_io_uring == 0);
+    }
+}
+
+void test_history_dir_pread(void) {
+    printf("Testing history_load_directory with the pread path...\n");
+
+    check_full_load(1, 0);
+    check_full_load(4, 0);
+
+    printf("  ✓ All files and records delivered exactly once\n");
+}
+
+void test_history_dir_io_uring(void) {
+    printf("Testing history_load_directory with io_uring requested...\n");
+
+    /* Falls back to pread transparently if the kernel refuses io_uring */
+    check_full_load(1, 1);
+    check_full_load(4, 1);
+
+    HistoryDirStats stats;
+    Totals totals = {0, 0, 0, 0};
+    assert(history_load_directory(dir_path, NULL, count_records, &totals, &stats) == 0);
+    assert(totals.records == expected_records);
+    printf("  (io_uring %s)\n", stats.used_io_uring ? "used" : "unavailable, pread fallback");
+
+    printf("  ✓ All files and records delivered exactly once\n");
+}
+
+void test_history_dir_early_stop(void) {
+    printf("Testing history_load_directory stops when the callback asks...\n");
+
+    const int modes[] = {0, 1};
+    for (size_t m = 0; m < 2; m++) {
+        HistoryDirOptions options = {2, 8, modes[m]};
+        Totals totals = {0, 0, 0, 5};
+        assert(history_load_directory(dir_path, &options, count_records, &totals, NULL) == 0);
+        assert(totals.files == 5);
+    }
+
+    printf("  ✓ Callback stop honored\n");
+}
+
+void test_history_dir_errors(void) {
+    printf("Testing history_load_directory error handling...\n");
+
+    Totals totals = {0, 0, 0, 0};
+    poker_errno = POKER_EOK;
+    assert(history_load_directory("/nonexistent/histories", NULL, count_records, &totals, NULL) == -1);
+    assert(poker_errno == POKER_ENOTFOUND);
+
+    assert(history_load_directory(NULL, NULL, count_records, &totals, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(history_load_directory(dir_path, NULL, NULL, &totals, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    /* Empty directory: success, no callbacks */
+    char empty[] = "/tmp/poker_empty_XXXXXX";
+    assert(mkdtemp(empty) != NULL);
+    HistoryDirStats stats;
+    assert(history_load_directory(empty, NULL, count_records, &totals, &stats) == 0);
+    assert(totals.files == 0 && stats.files == 0);
+    rmdir(empty);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Directory Ingestion Test Suite ===\n\n");
+
+    setup_directory();
+
+    test_history_dir_pread();
+    test_history_dir_io_uring();
+    test_history_dir_early_stop();
+    test_history_dir_errors();
+
+    teardown_directory();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "../include/poker.h"
+
+/*
+ * Test Suite for parse_hand and parse_hand_mask
+ * Tests verify bulk hand parsing, duplicate detection and error positions
+ */
+
+void test_card_index_encoding(void) {
+    printf("Testing CARD_INDEX / CARD_FROM_INDEX round trip...\n");
+
+    /* Index order must match deck_new() order */
+    Deck* deck = deck_new();
+    assert(deck != NULL);
+    for (size_t i = 0; i < DECK_SIZE; i++) {
+        assert(CARD_INDEX(deck->cards[i]) == i);
+
+        Card card = CARD_FROM_INDEX(i);
+        assert(card.rank == deck->cards[i].rank);
+        assert(card.suit == deck->cards[i].suit);
+    }
+    deck_free(deck);
+
+    Card two_hearts = {RANK_TWO, SUIT_HEARTS};
+    Card ace_spades = {RANK_ACE, SUIT_SPADES};
+    assert(CARD_MASK_BIT(two_hearts) == UINT64_C(1));
+    assert(CARD_MASK_BIT(ace_spades) == (UINT64_C(1) << 51));
+
+    printf("  ✓ Card index encoding correct\n");
+}
+
+void test_parse_hand_concatenated(void) {
+    printf("Testing parse_hand with concatenated cards...\n");
+
+    const char* str = "AhKsQd7c2s";
+    Card cards[7];
+
+    assert(parse_hand(str, strlen(str), cards, 7, NULL) == 5);
+    assert(cards[0].rank == RANK_ACE && cards[0].suit == SUIT_HEARTS);
+    assert(cards[1].rank == RANK_KING && cards[1].suit == SUIT_SPADES);
+    assert(cards[2].rank == RANK_QUEEN && cards[2].suit == SUIT_DIAMONDS);
+    assert(cards[3].rank == RANK_SEVEN && cards[3].suit == SUIT_CLUBS);
+    assert(cards[4].rank == RANK_TWO && cards[4].suit == SUIT_SPADES);
+
+    printf("  ✓ Concatenated hand parsed correctly\n");
+}
+
+void test_parse_hand_separators(void) {
+    printf("Testing parse_hand with separators...\n");
+
+    const char* str = " Th, 9d\t8C  7s 6H\r\n";
+    Card cards[5];
+
+    assert(parse_hand(str, strlen(str), cards, 5, NULL) == 5);
+    assert(cards[0].rank == RANK_TEN && cards[0].suit == SUIT_HEARTS);
+    assert(cards[2].rank == RANK_EIGHT && cards[2].suit == SUIT_CLUBS);
+    assert(cards[4].rank == RANK_SIX && cards[4].suit == SUIT_HEARTS);
+
+    /* Empty and separator-only input parse to zero cards */
+    assert(parse_hand("", 0, cards, 5, NULL) == 0);
+    assert(parse_hand("  ,", 3, cards, 5, NULL) == 0);
+
+    printf("  ✓ Separators handled correctly\n");
+}
+
+void test_parse_hand_respects_length(void) {
+    printf("Testing parse_hand stops at len (no NUL required)...\n");
+
+    /* Only the first two cards are inside len */
+    const char buffer[] = {'A', 'h', 'K', 's', 'X', 'X'};
+    Card cards[5];
+
+    assert(parse_hand(buffer, 4, cards, 5, NULL) == 2);
+    assert(cards[1].rank == RANK_KING && cards[1].suit == SUIT_SPADES);
+
+    printf("  ✓ Length limit respected\n");
+}
+
+void test_parse_hand_matches_parse_card(void) {
+    printf("Testing parse_hand agrees with parse_card for all cards...\n");
+
+    const char* ranks = "23456789TJQKAtjqka";
+    const char* suits = "hdcsHDCS";
+
+    for (size_t r = 0; r < strlen(ranks); r++) {
+        for (size_t s = 0; s < strlen(suits); s++) {
+            char str[3] = {ranks[r], suits[s], '\0'};
+            Card expected;
+            Card actual;
+
+            assert(parse_card(str, &expected) == 0);
+            assert(parse_hand(str, 2, &actual, 1, NULL) == 1);
+            assert(expected.rank == actual.rank);
+            assert(expected.suit == actual.suit);
+        }
+    }
+
+    printf("  ✓ parse_hand consistent with parse_card\n");
+}
+
+void test_parse_hand_invalid_characters(void) {
+    printf("Testing parse_hand error positions for invalid input...\n");
+
+    Card cards[7];
+    size_t pos = 0;
+
+    /* Bad rank at offset 4 */
+    poker_errno = POKER_EOK;
+    assert(parse_hand("AhKsXd", 6, cards, 7, &pos) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(pos == 4);
+
+    /* Bad suit at offset 3 */
+    assert(parse_hand("AhKx", 4, cards, 7, &pos) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(pos == 3);
+
+    /* Truncated card: suit missing at end of input */
+    assert(parse_hand("AhK", 3, cards, 7, &pos) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(pos == 3);
+
+    /* Separator between rank and suit is not allowed */
+    assert(parse_hand("A h", 3, cards, 7, &pos) == -1);
+    assert(pos == 1);
+
+    /* Error position is optional */
+    assert(parse_hand("1h", 2, cards, 7, NULL) == -1);
+
+    printf("  ✓ Invalid characters reported at correct offset\n");
+}
+
+void test_parse_hand_duplicates(void) {
+    printf("Testing parse_hand duplicate detection...\n");
+
+    Card cards[7];
+    size_t pos = 0;
+
+    poker_errno = POKER_EOK;
+    assert(parse_hand("Ah Ks ah", 8, cards, 7, &pos) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+    assert(pos == 6);
+
+    printf("  ✓ Duplicate cards rejected\n");
+}
+
+void test_parse_hand_capacity(void) {
+    printf("Testing parse_hand capacity limit...\n");
+
+    Card cards[2];
+    size_t pos = 0;
+
+    poker_errno = POKER_EOK;
+    assert(parse_hand("AhKsQd", 6, cards, 2, &pos) == -1);
+    assert(poker_errno == POKER_ERANGE);
+    assert(pos == 4);
+
+    printf("  ✓ Capacity overflow rejected\n");
+}
+
+void test_parse_hand_null_pointers(void) {
+    printf("Testing parse_hand NULL pointer handling...\n");
+
+    Card cards[2];
+    uint64_t mask;
+
+    assert(parse_hand(NULL, 2, cards, 2, NULL) == -1);
+    assert(parse_hand("Ah", 2, NULL, 2, NULL) == -1);
+    assert(parse_hand_mask(NULL, 2, &mask, NULL) == -1);
+    assert(parse_hand_mask("Ah", 2, NULL, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    printf("  ✓ NULL pointers rejected\n");
+}
+
+void test_parse_hand_mask(void) {
+    printf("Testing parse_hand_mask...\n");
+
+    uint64_t mask = 0;
+    size_t pos = 0;
+    Card ace_hearts = {RANK_ACE, SUIT_HEARTS};
+    Card two_clubs = {RANK_TWO, SUIT_CLUBS};
+
+    assert(parse_hand_mask("Ah2c", 4, &mask, NULL) == 2);
+    assert(mask == (CARD_MASK_BIT(ace_hearts) | CARD_MASK_BIT(two_clubs)));
+
+    /* Full deck fits in a mask */
+    char deck_str[DECK_SIZE * 2];
+    for (size_t i = 0; i < DECK_SIZE; i++) {
+        Card card = CARD_FROM_INDEX(i);
+        char buffer[3];
+        assert(card_to_string(card, buffer, sizeof(buffer)) == 0);
+        deck_str[i * 2] = buffer[0];
+        deck_str[i * 2 + 1] = buffer[1];
+    }
+    assert(parse_hand_mask(deck_str, sizeof(deck_str), &mask, NULL) == DECK_SIZE);
+    assert(mask == (UINT64_C(1) << DECK_SIZE) - 1);
+
+    /* Duplicate detection and error position */
+    assert(parse_hand_mask("2c Ah 2C", 8, &mask, &pos) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+    assert(pos == 6);
+
+    printf("  ✓ Card masks built correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Parse Hand Test Suite ===\n\n");
+
+    test_card_index_encoding();
+    test_parse_hand_concatenated();
+    test_parse_hand_separators();
+    test_parse_hand_respects_length();
+    test_parse_hand_matches_parse_card();
+    test_parse_hand_invalid_characters();
+    test_parse_hand_duplicates();
+    test_parse_hand_capacity();
+    test_parse_hand_null_pointers();
+    test_parse_hand_mask();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,321 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/poker_pipeline.h"
+
+/*
+ * Test Suite for the Pipeline Runtime
+ * Tests verify every batch passes through every stage once, that memory
+ * stays bounded by the batch pool, and early stop and error propagation
+ */
+
+#define NUM_RECORDS 20000
+
+static HandRecord records[NUM_RECORDS];
+
+/* Static helper: deterministic random showdown records */
+static void make_records(void) {
+    uint32_t state = 12345u;
+    for (size_t i = 0; i < NUM_RECORDS; i++) {
+        HandRecord* const rec = &records[i];
+        memset(rec, 0, sizeof(*rec));
+        memset(rec->hole, CARD_INDEX_NONE, sizeof(rec->hole));
+        rec->hand_id = i + 1;
+        rec->num_players = (uint8_t)(2 + i % 4);
+        rec->board_len = (uint8_t)(i % 7 == 0 ? 0 : BOARD_SIZE);
+        rec->hero = 0;
+
+        /* Distinct cards: board then two per player */
+        uint64_t used = 0;
+        uint8_t cards[BOARD_SIZE + 2 * MAX_PLAYERS];
+        for (size_t c = 0; c < BOARD_SIZE + 2u * rec->num_players; c++) {
+            uint8_t card;
+            do {
+                state = state * 1103515245u + 12345u;
+                card = (uint8_t)((state >> 16) % DECK_SIZE);
+            } while (used & (UINT64_C(1) << card));
+            used |= UINT64_C(1) << card;
+            cards[c] = card;
+        }
+        memcpy(rec->board, cards, BOARD_SIZE);
+        for (size_t p = 0; p < rec->num_players; p++) {
+            rec->hole[p][0] = cards[BOARD_SIZE + 2 * p];
+            rec->hole[p][1] = cards[BOARD_SIZE + 2 * p + 1];
+        }
+        rec->showdown_mask = (uint16_t)((1u << rec->num_players) - 1);
+    }
+}
+
+/* Static helper: expected value of one player's hand (0 if not evaluated) */
+static HandValue expected_value(const HandRecord* const rec, const size_t player) {
+    if (player >= rec->num_players || rec->board_len < 3) {
+        return 0;
+    }
+    uint64_t mask = (UINT64_C(1) << rec->hole[player][0]) | (UINT64_C(1) << rec->hole[player][1]);
+    for (size_t b = 0; b < rec->board_len; b++) {
+        mask |= UINT64_C(1) << rec->board[b];
+    }
+    return evaluate_mask(mask);
+}
+
+/* Aggregator state (single-threaded sink) */
+typedef struct {
+    uint64_t records;
+    uint64_t id_sum;
+    uint64_t category_counts[HAND_ROYAL_FLUSH + 1];
+    uint64_t batches;
+    uint64_t next_sequence;
+    int check_order;
+    uint64_t stop_after;    /* 0 = never */
+    size_t max_in_flight;
+} Aggregate;
+
+static size_t produced_batches = 0;
+static size_t consumed_batches = 0;
+
+static int counting_source(PipelineBatch* batch, void* context, size_t worker) {
+    const int rc = pipeline_array_source(batch, context, worker);
+    if (batch->count > 0) {
+        __atomic_fetch_add(&produced_batches, 1, __ATOMIC_SEQ_CST);
+    }
+    return rc;
+}
+
+static int aggregate_stage(PipelineBatch* batch, void* context, size_t worker) {
+    Aggregate* const agg = (Aggregate*)context;
+    assert(worker == 0);
+
+    const size_t in_flight = __atomic_load_n(&produced_batches, __ATOMIC_SEQ_CST) - consumed_batches;
+    if (in_flight > agg->max_in_flight) {
+        agg->max_in_flight = in_flight;
+    }
+    consumed_batches++;
+
+    if (agg->check_order) {
+        /* Order test also runs with 64 bytes of scratch per batch */
+        assert(batch->scratch != NULL);
+        memset(batch->scratch, 0xAB, 64);
+        assert(batch->sequence == agg->next_sequence);
+        agg->next_sequence++;
+    }
+    for (size_t i = 0; i < batch->count; i++) {
+        const HandRecord* const rec = &batch->records[i];
+        agg->records++;
+        agg->id_sum += rec->hand_id;
+        for (size_t p = 0; p < MAX_PLAYERS; p++) {
+            const HandValue value = batch->values[i * MAX_PLAYERS + p];
+            assert(value == expected_value(rec, p));
+            if (value != 0) {
+                agg->category_counts[HAND_VALUE_CATEGORY(value)]++;
+            }
+        }
+    }
+    agg->batches++;
+    return (agg->stop_after != 0 && agg->batches >= agg->stop_after) ? PIPELINE_DONE : 0;
+}
+
+/* Static helper: run source -> evaluate -> aggregate with the given thread counts */
+static int run_three_stage(const size_t source_threads, const size_t eval_threads,
+                           const PipelineOptions* const options, Aggregate* const agg,
+                           PipelineStats* const stats) {
+    PipelineArraySource source = {records, NUM_RECORDS, 0};
+    const PipelineStage stages[3] = {
+        {"read", counting_source, &source, source_threads},
+        {"evaluate", pipeline_evaluate_stage, NULL, eval_threads},
+        {"aggregate", aggregate_stage, agg, 1},
+    };
+    produced_batches = 0;
+    consumed_batches = 0;
+    return pipeline_run(stages, 3, options, stats);
+}
+
+void test_pipeline_all_records(void) {
+    printf("Testing pipeline_run delivers every record through every stage...\n");
+
+    uint64_t expected_ids = 0;
+    uint64_t expected_categories[HAND_ROYAL_FLUSH + 1] = {0};
+    for (size_t i = 0; i < NUM_RECORDS; i++) {
+        expected_ids += records[i].hand_id;
+        for (size_t p = 0; p < MAX_PLAYERS; p++) {
+            const HandValue value = expected_value(&records[i], p);
+            if (value != 0) {
+                expected_categories[HAND_VALUE_CATEGORY(value)]++;
+            }
+        }
+    }
+
+    const size_t configs[][2] = {{1, 1}, {1, 3}, {2, 4}, {3, 2}};
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        const PipelineOptions options = {333, 0, 0};
+        Aggregate agg;
+        memset(&agg, 0, sizeof(agg));
+        PipelineStats stats;
+
+        assert(run_three_stage(configs[c][0], configs[c][1], &options, &agg, &stats) == 0);
+        assert(agg.records == NUM_RECORDS);
+        assert(agg.id_sum == expected_ids);
+        assert(memcmp(agg.category_counts, expected_categories, sizeof(expected_categories)) == 0);
+
+        assert(stats.num_stages == 3);
+        for (size_t s = 0; s < 3; s++) {
+            assert(stats.stages[s].records == NUM_RECORDS);
+            assert(stats.stages[s].batches == (NUM_RECORDS + 332) / 333);
+        }
+        assert(stats.stages[1].num_threads == configs[c][1]);
+        assert(strcmp(stats.stages[1].name, "evaluate") == 0);
+        assert(stats.stages[2].records_per_sec > 0);
+    }
+
+    printf("  ✓ All records evaluated and aggregated exactly once\n");
+}
+
+void test_pipeline_order(void) {
+    printf("Testing pipeline_run keeps sequence order with single-threaded stages...\n");
+
+    Aggregate agg;
+    memset(&agg, 0, sizeof(agg));
+    agg.check_order = 1;
+    const PipelineOptions options = {100, 0, 64};
+    assert(run_three_stage(1, 1, &options, &agg, NULL) == 0);
+    assert(agg.next_sequence == NUM_RECORDS / 100);
+
+    printf("  ✓ Batches arrive in sequence order\n");
+}
+
+void test_pipeline_backpressure(void) {
+    printf("Testing pipeline_run bounds batches in flight...\n");
+
+    /* Small batches and queues: the source must wait for the sink */
+    const PipelineOptions options = {16, 2, 0};
+    Aggregate agg;
+    memset(&agg, 0, sizeof(agg));
+    PipelineStats stats;
+
+    assert(run_three_stage(2, 2, &options, &agg, &stats) == 0);
+    assert(agg.records == NUM_RECORDS);
+    /* 2 queues of 2 batches + 5 workers */
+    assert(stats.pool_batches == 9);
+    assert(agg.max_in_flight <= stats.pool_batches);
+
+    printf("  ✓ At most %zu of %zu pool batches in flight\n", agg.max_in_flight, stats.pool_batches);
+}
+
+void test_pipeline_early_stop(void) {
+    printf("Testing pipeline_run stops when a stage asks...\n");
+
+    Aggregate agg;
+    memset(&agg, 0, sizeof(agg));
+    agg.stop_after = 5;
+    const PipelineOptions options = {64, 0, 0};
+    PipelineStats stats;
+
+    assert(run_three_stage(2, 2, &options, &agg, &stats) == 0);
+    assert(agg.batches == 5);
+    assert(stats.stages[2].batches == 5);
+    assert(stats.stages[0].records < NUM_RECORDS);
+
+    printf("  ✓ Early stop honored\n");
+}
+
+static int failing_stage(PipelineBatch* batch, void* context, size_t worker) {
+    size_t* const seen = (size_t*)context;
+    (void)worker;
+    if (__atomic_add_fetch(seen, batch->count, __ATOMIC_RELAXED) > NUM_RECORDS / 2) {
+        poker_errno = POKER_ERANGE;
+        return -1;
+    }
+    return 0;
+}
+
+static int discard_stage(PipelineBatch* batch, void* context, size_t worker) {
+    (void)batch;
+    (void)context;
+    (void)worker;
+    return 0;
+}
+
+static int overfilling_source(PipelineBatch* batch, void* context, size_t worker) {
+    (void)context;
+    (void)worker;
+    batch->count = batch->capacity + 1;
+    return 0;
+}
+
+void test_pipeline_errors(void) {
+    printf("Testing pipeline_run error handling...\n");
+
+    /* Stage failure propagates its poker_errno */
+    PipelineArraySource source = {records, NUM_RECORDS, 0};
+    size_t seen = 0;
+    const PipelineStage stages[3] = {
+        {"read", pipeline_array_source, &source, 1},
+        {"fail", failing_stage, &seen, 3},
+        {"discard", discard_stage, NULL, 1},
+    };
+    poker_errno = POKER_EOK;
+    assert(pipeline_run(stages, 3, NULL, NULL) == -1);
+    assert(poker_errno == POKER_ERANGE);
+
+    /* Source claiming more records than the batch holds */
+    const PipelineStage bad_source[2] = {
+        {"read", overfilling_source, NULL, 1},
+        {"discard", discard_stage, NULL, 1},
+    };
+    poker_errno = POKER_EOK;
+    assert(pipeline_run(bad_source, 2, NULL, NULL) == -1);
+    assert(poker_errno == POKER_ERANGE);
+
+    /* Invalid arguments */
+    assert(pipeline_run(NULL, 2, NULL, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    poker_errno = POKER_EOK;
+    assert(pipeline_run(stages, 1, NULL, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    poker_errno = POKER_EOK;
+    assert(pipeline_run(stages, PIPELINE_MAX_STAGES + 1, NULL, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    const PipelineStage missing_fn[2] = {
+        {"read", pipeline_array_source, &source, 1},
+        {"none", NULL, NULL, 1},
+    };
+    poker_errno = POKER_EOK;
+    assert(pipeline_run(missing_fn, 2, NULL, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    const PipelineStage too_many[2] = {
+        {"read", pipeline_array_source, &source, 200},
+        {"discard", discard_stage, NULL, 200},
+    };
+    poker_errno = POKER_EOK;
+    assert(pipeline_run(too_many, 2, NULL, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    /* Empty source: success, nothing forwarded */
+    PipelineArraySource empty = {records, 0, 0};
+    const PipelineStage empty_stages[2] = {
+        {"read", pipeline_array_source, &empty, 2},
+        {"discard", discard_stage, NULL, 1},
+    };
+    PipelineStats stats;
+    assert(pipeline_run(empty_stages, 2, NULL, &stats) == 0);
+    assert(stats.stages[0].batches == 0 && stats.stages[1].batches == 0);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Pipeline Runtime Test Suite ===\n\n");
+
+    make_records();
+
+    test_pipeline_all_records();
+    test_pipeline_order();
+    test_pipeline_backpressure();
+    test_pipeline_early_stop();
+    test_pipeline_errors();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,250 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/poker_preflop.h"
+
+/*
+ * Test Suite for the preflop equity matrix
+ * Tests verify the matchup class count, lookups through suit renamings,
+ * matrix expansion, file format validation and builder errors. A full
+ * build enumerates every river board class and is left to the
+ * poker-preflop tool; its values are exact enumerations.
+ */
+
+#define MATRIX_CELLS ((size_t)HOLE_COMBOS * HOLE_COMBOS)
+
+static char path[] = "/tmp/test_preflop_XXXXXX";
+
+static uint64_t random_state = 0x5EED;
+
+/* Static helper: xorshift64* step for test data */
+static uint64_t next_random(void) {
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return random_state * UINT64_C(0x2545F4914F6CDD1D);
+}
+
+/* Static helper: rename suits of a mask (suit s becomes perm[s]) */
+static uint64_t rename_suits(const uint64_t mask, const int* const perm) {
+    uint64_t out = 0;
+    for (int card = 0; card < DECK_SIZE; card++) {
+        if (mask & (UINT64_C(1) << card)) {
+            out |= UINT64_C(1) << ((card & ~3) | perm[card & 3]);
+        }
+    }
+    return out;
+}
+
+/* Static helper: the suit permutation with number p (0-23) */
+static void permutation(int p, int* const perm) {
+    int free_suits[4] = {0, 1, 2, 3};
+    for (int i = 0; i < 4; i++) {
+        const int choices = 4 - i;
+        const int pick = p % choices;
+        p /= choices;
+        perm[i] = free_suits[pick];
+        for (int k = pick; k < 3; k++) {
+            free_suits[k] = free_suits[k + 1];
+        }
+    }
+}
+
+/* Static helper: test score of a class key */
+static uint32_t score_of(const uint32_t key) {
+    return key % (2 * PREFLOP_BOARDS + 1);
+}
+
+/* Static helper: write a matrix file; keys must be ascending */
+static void write_file(const uint8_t version, const uint32_t* const keys, const size_t count,
+                       const size_t written) {
+    FILE* const file = fopen(path, "wb");
+    assert(file != NULL);
+    uint8_t header[16] = {'P', 'E', 'Q', 'M', version};
+    for (int i = 0; i < 4; i++) {
+        header[8 + i] = (uint8_t)(count >> (8 * i));
+        header[12 + i] = (uint8_t)((uint32_t)PREFLOP_BOARDS >> (8 * i));
+    }
+    assert(fwrite(header, sizeof(header), 1, file) == 1);
+    for (size_t c = 0; c < written; c++) {
+        uint8_t entry[8];
+        for (int i = 0; i < 4; i++) {
+            entry[i] = (uint8_t)(keys[c] >> (8 * i));
+            entry[4 + i] = (uint8_t)(score_of(keys[c]) >> (8 * i));
+        }
+        assert(fwrite(entry, sizeof(entry), 1, file) == 1);
+    }
+    assert(fclose(file) == 0);
+}
+
+/* Class keys computed directly: smallest cell over all suit renamings */
+static uint32_t* class_keys(size_t* const count) {
+    uint32_t* const keys = malloc(MATRIX_CELLS * sizeof(uint32_t));
+    assert(keys != NULL);
+    int perms[24][4];
+    for (int p = 0; p < 24; p++) {
+        permutation(p, perms[p]);
+    }
+    *count = 0;
+    for (size_t a = 0; a < HOLE_COMBOS; a++) {
+        const uint64_t hole = hole_combo_mask(a);
+        for (size_t b = 0; b < HOLE_COMBOS; b++) {
+            const uint64_t villain = hole_combo_mask(b);
+            int canonical = !(hole & villain);
+            for (int p = 0; p < 24 && canonical; p++) {
+                const size_t renamed = (size_t)hole_combo_index(rename_suits(hole, perms[p])) *
+                                           HOLE_COMBOS +
+                                       (size_t)hole_combo_index(rename_suits(villain, perms[p]));
+                canonical = renamed >= a * HOLE_COMBOS + b;
+            }
+            if (canonical) {
+                keys[(*count)++] = (uint32_t)(a * HOLE_COMBOS + b);
+            }
+        }
+    }
+    return keys;
+}
+
+static void test_lookups(void) {
+    printf("Testing preflop_equity lookups...\n");
+
+    size_t count = 0;
+    uint32_t* const keys = class_keys(&count);
+    assert(count == PREFLOP_MATCHUP_CLASSES);
+    write_file(PREFLOP_EQUITY_FORMAT_VERSION, keys, count, count);
+    PreflopEquity* const table = preflop_equity_open(path);
+    assert(table != NULL);
+
+    /* Class representatives return their own score */
+    for (size_t c = 0; c < count; c += 97) {
+        const uint64_t hole = hole_combo_mask(keys[c] / HOLE_COMBOS);
+        const uint64_t villain = hole_combo_mask(keys[c] % HOLE_COMBOS);
+        assert(preflop_equity_score(table, hole, villain) == score_of(keys[c]));
+    }
+
+    /* Every suit renaming of a matchup has the same score */
+    for (int trial = 0; trial < 200; trial++) {
+        const uint64_t hole = hole_combo_mask(next_random() % HOLE_COMBOS);
+        uint64_t villain;
+        do {
+            villain = hole_combo_mask(next_random() % HOLE_COMBOS);
+        } while (villain & hole);
+        const int64_t score = preflop_equity_score(table, hole, villain);
+        assert(score >= 0);
+        assert(fabs(preflop_equity(table, hole, villain) -
+                    (double)score / (2.0 * PREFLOP_BOARDS)) < 1e-12);
+        for (int p = 0; p < 24; p++) {
+            int perm[4];
+            permutation(p, perm);
+            assert(preflop_equity_score(table, rename_suits(hole, perm),
+                                        rename_suits(villain, perm)) == score);
+        }
+    }
+
+    /* Specific card-removal classes stay apart */
+    uint64_t ahkh = 0;
+    uint64_t qhjh = 0;
+    uint64_t qsjs = 0;
+    assert(parse_hand_mask("AhKh", 4, &ahkh, NULL) == 2);
+    assert(parse_hand_mask("QhJh", 4, &qhjh, NULL) == 2);
+    assert(parse_hand_mask("QsJs", 4, &qsjs, NULL) == 2);
+    assert(preflop_equity_score(table, ahkh, qhjh) != preflop_equity_score(table, ahkh, qsjs));
+
+    /* Matrix expansion agrees with single lookups; overlaps are 0 */
+    double* const matrix = malloc(MATRIX_CELLS * sizeof(double));
+    assert(matrix != NULL);
+    assert(preflop_equity_matrix(table, matrix) == 0);
+    for (int trial = 0; trial < 2000; trial++) {
+        const size_t a = next_random() % HOLE_COMBOS;
+        const size_t b = next_random() % HOLE_COMBOS;
+        const uint64_t hole = hole_combo_mask(a);
+        const uint64_t villain = hole_combo_mask(b);
+        const double expected = (hole & villain) ? 0.0 : preflop_equity(table, hole, villain);
+        assert(matrix[a * HOLE_COMBOS + b] == expected);
+    }
+    free(matrix);
+
+    /* Errors */
+    assert(preflop_equity_score(table, ahkh, ahkh) == -1 && poker_errno == POKER_EDUPLICATE);
+    assert(preflop_equity_score(table, ahkh | qsjs, qhjh) == -1 && poker_errno == POKER_EINVAL);
+    assert(preflop_equity_score(table, 0, qhjh) == -1 && poker_errno == POKER_EINVAL);
+    assert(preflop_equity_score(NULL, ahkh, qhjh) == -1 && poker_errno == POKER_EINVAL);
+    assert(preflop_equity(table, ahkh, ahkh) == -1.0);
+    assert(preflop_equity_matrix(table, NULL) == -1 && poker_errno == POKER_EINVAL);
+    assert(preflop_equity_matrix(NULL, NULL) == -1 && poker_errno == POKER_EINVAL);
+
+    preflop_equity_close(table);
+    preflop_equity_close(NULL);
+    free(keys);
+
+    printf("✓ preflop_equity lookup tests passed\n");
+}
+
+static void test_file_format(void) {
+    printf("Testing preflop_equity_open validation...\n");
+
+    const uint32_t keys[3] = {1, 5, 9};
+    const uint32_t unsorted[3] = {1, 9, 5};
+
+    write_file(PREFLOP_EQUITY_FORMAT_VERSION, keys, 3, 3);
+    PreflopEquity* const table = preflop_equity_open(path);
+    assert(table != NULL);
+    preflop_equity_close(table);
+
+    /* Bad version, truncated or trailing data, unsorted keys */
+    write_file(PREFLOP_EQUITY_FORMAT_VERSION + 1, keys, 3, 3);
+    assert(preflop_equity_open(path) == NULL && poker_errno == POKER_EFORMAT);
+    write_file(PREFLOP_EQUITY_FORMAT_VERSION, keys, 3, 2);
+    assert(preflop_equity_open(path) == NULL && poker_errno == POKER_EFORMAT);
+    write_file(PREFLOP_EQUITY_FORMAT_VERSION, keys, 2, 3);
+    assert(preflop_equity_open(path) == NULL && poker_errno == POKER_EFORMAT);
+    write_file(PREFLOP_EQUITY_FORMAT_VERSION, unsorted, 3, 3);
+    assert(preflop_equity_open(path) == NULL && poker_errno == POKER_EFORMAT);
+    write_file(PREFLOP_EQUITY_FORMAT_VERSION, keys, 0, 0);
+    assert(preflop_equity_open(path) == NULL && poker_errno == POKER_EFORMAT);
+
+    /* Bad magic */
+    FILE* const file = fopen(path, "wb");
+    assert(file != NULL);
+    assert(fwrite("PBKT0000000000000000", 20, 1, file) == 1);
+    assert(fclose(file) == 0);
+    assert(preflop_equity_open(path) == NULL && poker_errno == POKER_EFORMAT);
+
+    assert(preflop_equity_open("/nonexistent/matrix.peqm") == NULL &&
+           poker_errno == POKER_ENOTFOUND);
+    assert(preflop_equity_open(NULL) == NULL && poker_errno == POKER_EINVAL);
+
+    printf("✓ preflop_equity_open validation tests passed\n");
+}
+
+static void test_build_errors(void) {
+    printf("Testing preflop_equity_build errors...\n");
+
+    assert(preflop_equity_build(NULL, 1, NULL) == -1 && poker_errno == POKER_EINVAL);
+    assert(preflop_equity_build("/nonexistent/matrix.peqm", 1, NULL) == -1 &&
+           poker_errno == POKER_EIO);
+
+    printf("✓ preflop_equity_build error tests passed\n");
+}
+
+int main(void) {
+    printf("Running preflop equity matrix tests...\n\n");
+
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    test_lookups();
+    test_file_format();
+    test_build_errors();
+
+    unlink(path);
+
+    printf("\n✓ All preflop equity matrix tests passed!\n");
+    return 0;
+}
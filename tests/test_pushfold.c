@@ -0,0 +1,338 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/poker_handindex.h"
+#include "../include/poker_pushfold.h"
+
+/*
+ * Test Suite for the push/fold solver
+ * Tests verify class-level matchup counts, thread-count independence,
+ * convergence, the value and exploitability against a brute-force
+ * combo-by-combo evaluation (exact card removal) and error handling.
+ * Equities come from a synthetic suit-invariant matrix file, since a real
+ * one takes minutes to build.
+ */
+
+#define MATRIX_CELLS ((size_t)HOLE_COMBOS * HOLE_COMBOS)
+
+static char path[] = "/tmp/test_pushfold_XXXXXX";
+
+/* Static helper: rename suits of a mask (suit s becomes perm[s]) */
+static uint64_t rename_suits(const uint64_t mask, const int* const perm) {
+    uint64_t out = 0;
+    for (int card = 0; card < DECK_SIZE; card++) {
+        if (mask & (UINT64_C(1) << card)) {
+            out |= UINT64_C(1) << ((card & ~3) | perm[card & 3]);
+        }
+    }
+    return out;
+}
+
+/* Static helper: the suit permutation with number p (0-23) */
+static void permutation(int p, int* const perm) {
+    int free_suits[4] = {0, 1, 2, 3};
+    for (int i = 0; i < 4; i++) {
+        const int choices = 4 - i;
+        const int pick = p % choices;
+        p /= choices;
+        perm[i] = free_suits[pick];
+        for (int k = pick; k < 3; k++) {
+            free_suits[k] = free_suits[k + 1];
+        }
+    }
+}
+
+/* Static helper: one-sided edge of a combo against another, suit-invariant */
+static int64_t edge(const uint64_t hole, const uint64_t villain) {
+    const int high = (63 - __builtin_clzll(hole)) / 4;
+    const int low = __builtin_ctzll(hole) / 4;
+    const int suit = __builtin_ctzll(hole) % 4;
+    const int suited = ((63 - __builtin_clzll(hole)) % 4) == suit;
+    const double strength = 2.0 * high + low + 13.0 * (high == low) + 3.0 * suited;
+    const int vhigh = (63 - __builtin_clzll(villain)) / 4;
+    const int vlow = __builtin_ctzll(villain) / 4;
+    const int vsuited = ((63 - __builtin_clzll(villain)) % 4) == (__builtin_ctzll(villain) % 4);
+    const double vstrength = 2.0 * vhigh + vlow + 13.0 * (vhigh == vlow) + 3.0 * vsuited;
+    /* A flush draw blocked by the villain's suit loses a little */
+    const uint64_t suit_cards = UINT64_C(0x1111111111111) << suit;
+    const int blocked = suited && (villain & suit_cards) != 0;
+    return (int64_t)(0.4 * PREFLOP_BOARDS * tanh((strength - vstrength) / 8.0)) -
+           (blocked ? 20000 : 0);
+}
+
+/* Static helper: synthetic half-point score; score(a, b) + score(b, a) = 2 * boards */
+static int64_t synthetic_score(const uint64_t hole, const uint64_t villain) {
+    return PREFLOP_BOARDS + edge(hole, villain) - edge(villain, hole);
+}
+
+/* Static helper: write the synthetic matrix (every class, or the first few) */
+static void write_matrix(const size_t limit) {
+    int perms[24][4];
+    for (int p = 0; p < 24; p++) {
+        permutation(p, perms[p]);
+    }
+    FILE* const file = fopen(path, "wb");
+    assert(file != NULL);
+    uint8_t header[16] = {'P', 'E', 'Q', 'M', PREFLOP_EQUITY_FORMAT_VERSION};
+    assert(fwrite(header, sizeof(header), 1, file) == 1);
+    uint32_t count = 0;
+    for (size_t a = 0; a < HOLE_COMBOS && count < limit; a++) {
+        const uint64_t hole = hole_combo_mask(a);
+        for (size_t b = 0; b < HOLE_COMBOS && count < limit; b++) {
+            const uint64_t villain = hole_combo_mask(b);
+            int canonical = !(hole & villain);
+            for (int p = 0; p < 24 && canonical; p++) {
+                const size_t renamed = (size_t)hole_combo_index(rename_suits(hole, perms[p])) *
+                                           HOLE_COMBOS +
+                                       (size_t)hole_combo_index(rename_suits(villain, perms[p]));
+                canonical = renamed >= a * HOLE_COMBOS + b;
+            }
+            if (canonical) {
+                const uint32_t key = (uint32_t)(a * HOLE_COMBOS + b);
+                const uint32_t score = (uint32_t)synthetic_score(hole, villain);
+                uint8_t entry[8];
+                for (int i = 0; i < 4; i++) {
+                    entry[i] = (uint8_t)(key >> (8 * i));
+                    entry[4 + i] = (uint8_t)(score >> (8 * i));
+                }
+                assert(fwrite(entry, sizeof(entry), 1, file) == 1);
+                count++;
+            }
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        header[8 + i] = (uint8_t)(count >> (8 * i));
+        header[12 + i] = (uint8_t)((uint32_t)PREFLOP_BOARDS >> (8 * i));
+    }
+    assert(fseek(file, 0, SEEK_SET) == 0);
+    assert(fwrite(header, sizeof(header), 1, file) == 1);
+    assert(fclose(file) == 0);
+}
+
+/* Static helper: class of a hand string */
+static size_t class_of(const char* const text) {
+    uint64_t mask = 0;
+    assert(parse_hand_mask(text, 4, &mask, NULL) == 2);
+    const uint8_t cards[2] = {(uint8_t)__builtin_ctzll(mask), (uint8_t)(63 - __builtin_clzll(mask))};
+    uint64_t index = 0;
+    assert(hand_index(cards, 2, &index) == 0);
+    return (size_t)index;
+}
+
+static void test_class_equities(const PushFoldEquities* const equities) {
+    printf("Testing pushfold_class_equity...\n");
+
+    const size_t aa = class_of("AhAd");
+    const size_t kk = class_of("KhKd");
+    const size_t aks = class_of("AhKh");
+    const size_t ako = class_of("AhKd");
+    size_t combos = 0;
+
+    /* Card removal: counts of unblocked villain combos */
+    pushfold_class_equity(equities, aa, kk, &combos);
+    assert(combos == 6);
+    pushfold_class_equity(equities, aa, aa, &combos);
+    assert(combos == 1);
+    pushfold_class_equity(equities, aks, aa, &combos);
+    assert(combos == 3);
+    pushfold_class_equity(equities, ako, aks, &combos);
+    assert(combos == 2);
+    pushfold_class_equity(equities, kk, ako, &combos);
+    assert(combos == 6);
+
+    /* Every hero sees 1225 villain combos; class equities are complementary */
+    for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+        size_t total = 0;
+        for (size_t y = 0; y < PUSHFOLD_CLASSES; y++) {
+            const double equity = pushfold_class_equity(equities, x, y, &combos);
+            total += combos;
+            assert(equity >= 0.0 && equity <= 1.0);
+            if (combos > 0) {
+                assert(fabs(equity + pushfold_class_equity(equities, y, x, NULL) - 1.0) < 1e-12);
+            }
+        }
+        assert(total == 1225);
+    }
+
+    /* The mean over the unblocked combos of the synthetic matrix */
+    uint64_t hole = 0;
+    parse_hand_mask("AhKh", 4, &hole, NULL);
+    double expected = 0.0;
+    for (size_t b = 0; b < HOLE_COMBOS; b++) {
+        const uint64_t villain = hole_combo_mask(b);
+        const int queens = __builtin_popcountll(villain & (UINT64_C(0xF) << 40)) == 2;
+        if (queens && !(villain & hole)) {
+            expected += (double)synthetic_score(hole, villain) / (2.0 * PREFLOP_BOARDS) / 6.0;
+        }
+    }
+    assert(fabs(pushfold_class_equity(equities, aks, class_of("QsQc"), &combos) - expected) < 1e-12);
+    assert(combos == 6);
+
+    assert(pushfold_class_equity(NULL, aa, kk, NULL) == -1.0 && poker_errno == POKER_EINVAL);
+    assert(pushfold_class_equity(equities, PUSHFOLD_CLASSES, kk, NULL) == -1.0 &&
+           poker_errno == POKER_EINVAL);
+
+    printf("✓ pushfold_class_equity tests passed\n");
+}
+
+/* Static helper: value and exploitability of a result, combo by combo */
+static void brute_force(const PushFoldSpot* const spot, const PushFoldResult* const result,
+                        double* const out_value, double* const out_exploitability) {
+    double jam[HOLE_COMBOS];
+    double call[HOLE_COMBOS];
+    assert(pushfold_expand(result->jam, jam) == 0);
+    assert(pushfold_expand(result->call, call) == 0);
+    const double gain = spot->big_blind + spot->ante + spot->big_blind_ante;
+    const double loss = spot->small_blind + spot->ante;
+
+    double value = 0.0;
+    double sb_best = 0.0;
+    double bb_fold_part = 0.0;
+    double bb_call[HOLE_COMBOS] = {0.0};
+    double bb_fold[HOLE_COMBOS] = {0.0};
+    size_t deals = 0;
+    for (size_t a = 0; a < HOLE_COMBOS; a++) {
+        const uint64_t hole = hole_combo_mask(a);
+        double jam_value = 0.0;
+        double fold_value = 0.0;
+        for (size_t b = 0; b < HOLE_COMBOS; b++) {
+            const uint64_t villain = hole_combo_mask(b);
+            if (hole & villain) {
+                continue;
+            }
+            deals++;
+            const double equity = (double)synthetic_score(hole, villain) / (2.0 * PREFLOP_BOARDS);
+            const double called = 2.0 * spot->stack * equity - spot->stack;
+            jam_value += (1.0 - call[b]) * gain + call[b] * called;
+            fold_value -= loss;
+            bb_call[b] -= jam[a] * called;
+            bb_fold[b] -= jam[a] * gain;
+        }
+        value += jam[a] * jam_value + (1.0 - jam[a]) * fold_value;
+        sb_best += fmax(jam_value, fold_value);
+        bb_fold_part -= (1.0 - jam[a]) * fold_value;
+    }
+    double bb_best = bb_fold_part;
+    for (size_t b = 0; b < HOLE_COMBOS; b++) {
+        bb_best += fmax(bb_call[b], bb_fold[b]);
+    }
+    assert(deals == (size_t)HOLE_COMBOS * 1225);
+    *out_value = value / (double)deals;
+    *out_exploitability = (sb_best + bb_best) / (2.0 * (double)deals);
+}
+
+static void test_solve(const PushFoldEquities* const equities) {
+    printf("Testing pushfold_solve...\n");
+
+    const PushFoldSpot spots[5] = {
+        {2.0, 0.5, 1.0, 0.0, 0.0},
+        {5.0, 0.5, 1.0, 0.0, 0.0},
+        {10.0, 0.5, 1.0, 0.0, 0.0},
+        {20.0, 0.5, 1.0, 0.0, 0.0},
+        {10.0, 0.5, 1.0, 0.125, 1.0},
+    };
+    PushFoldResult single[5];
+    PushFoldResult threaded[5];
+    PushFoldResult short_run[5];
+    assert(pushfold_solve(equities, spots, 5, 1000, 1, single) == 0);
+    assert(pushfold_solve(equities, spots, 5, 1000, 3, threaded) == 0);
+    assert(memcmp(single, threaded, sizeof(single)) == 0);
+    assert(pushfold_solve(equities, spots, 5, 50, 2, short_run) == 0);
+
+    const size_t aa = class_of("AhAd");
+    for (size_t s = 0; s < 5; s++) {
+        const PushFoldResult* const result = &single[s];
+        assert(result->exploitability >= -1e-9);
+        assert(result->exploitability < 1e-4 * spots[s].big_blind);
+        assert(result->exploitability <= short_run[s].exploitability);
+        assert(result->jam[aa] > 0.999 && result->call[aa] > 0.999);
+        for (size_t x = 0; x < PUSHFOLD_CLASSES; x++) {
+            assert(result->jam[x] >= 0.0 && result->jam[x] <= 1.0);
+            assert(result->call[x] >= 0.0 && result->call[x] <= 1.0);
+        }
+
+        /* The class-level sweep reproduces the combo-by-combo game */
+        double value = 0.0;
+        double exploitability = 0.0;
+        brute_force(&spots[s], result, &value, &exploitability);
+        assert(fabs(value - result->value) < 1e-9);
+        assert(fabs(exploitability - result->exploitability) < 1e-9);
+    }
+
+    /* Deeper stacks tighten both ranges; antes widen the jams */
+    assert(single[0].jam_share > single[1].jam_share);
+    assert(single[1].jam_share > single[2].jam_share);
+    assert(single[2].jam_share > single[3].jam_share);
+    assert(single[1].call_share > single[3].call_share);
+    assert(single[4].jam_share > single[2].jam_share);
+
+    /* Errors */
+    PushFoldSpot bad = spots[2];
+    bad.stack = 1.0;
+    assert(pushfold_solve(equities, &bad, 1, 10, 1, single) == -1 && poker_errno == POKER_EINVAL);
+    bad = spots[2];
+    bad.small_blind = 2.0;
+    assert(pushfold_solve(equities, &bad, 1, 10, 1, single) == -1 && poker_errno == POKER_EINVAL);
+    bad = spots[2];
+    bad.ante = -0.1;
+    assert(pushfold_solve(equities, &bad, 1, 10, 1, single) == -1 && poker_errno == POKER_EINVAL);
+    bad = spots[2];
+    bad.stack = NAN;
+    assert(pushfold_solve(equities, &bad, 1, 10, 1, single) == -1 && poker_errno == POKER_EINVAL);
+    assert(pushfold_solve(equities, spots, 5, 0, 1, single) == -1 && poker_errno == POKER_EINVAL);
+    assert(pushfold_solve(NULL, spots, 5, 10, 1, single) == -1 && poker_errno == POKER_EINVAL);
+    assert(pushfold_solve(equities, NULL, 5, 10, 1, single) == -1 && poker_errno == POKER_EINVAL);
+    assert(pushfold_solve(equities, NULL, 0, 10, 1, NULL) == 0);
+    assert(pushfold_expand(NULL, NULL) == -1 && poker_errno == POKER_EINVAL);
+
+    printf("✓ pushfold_solve tests passed\n");
+}
+
+static void test_loading(void) {
+    printf("Testing pushfold_equities_load errors...\n");
+
+    assert(pushfold_equities_create(NULL) == NULL && poker_errno == POKER_EINVAL);
+    assert(pushfold_equities_load(NULL, 1) == NULL && poker_errno == POKER_EINVAL);
+
+    /* A matrix without every class */
+    write_matrix(1000);
+    assert(pushfold_equities_load(path, 1) == NULL && poker_errno == POKER_EINVAL);
+
+    /* Not a matrix file */
+    FILE* const file = fopen(path, "wb");
+    assert(file != NULL);
+    assert(fwrite("not a matrix file", 17, 1, file) == 1);
+    assert(fclose(file) == 0);
+    assert(pushfold_equities_load(path, 1) == NULL && poker_errno == POKER_EFORMAT);
+
+    pushfold_equities_destroy(NULL);
+
+    printf("✓ pushfold_equities_load error tests passed\n");
+}
+
+int main(void) {
+    printf("Running push/fold solver tests...\n\n");
+
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    write_matrix(MATRIX_CELLS);
+    PushFoldEquities* const equities = pushfold_equities_load(path, 1);
+    assert(equities != NULL);
+
+    test_class_equities(equities);
+    test_solve(equities);
+    test_loading();
+
+    pushfold_equities_destroy(equities);
+    unlink(path);
+
+    printf("\n✓ All push/fold solver tests passed!\n");
+    return 0;
+}
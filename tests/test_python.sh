@@ -0,0 +1,100 @@
+#!/bin/bash
+# Test script for the pokereval Python extension
+# Checks values against known hands, zero-copy output, thread counts,
+# invalid rows and argument errors (NumPy is used when installed)
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(cd "$SCRIPT_DIR/.." && pwd)"
+cd "$PROJECT_ROOT"
+
+echo "Testing pokereval Python extension..."
+echo "=========================================="
+
+if ! command -v python3-config > /dev/null 2>&1; then
+    echo "SKIP: python3-config not found (Python development headers needed)"
+    exit 0
+fi
+
+make python > /dev/null
+
+PYTHONPATH=build python3 - << 'EOF'
+import array
+import random
+import pokereval
+
+def rows(hands, width):
+    """Pack hands (lists of card indices) into an (n, width) uint8 buffer."""
+    data = bytes(card for hand in hands for card in hand)
+    return memoryview(data).cast("B", (len(hands), width))
+
+# Test 1: known hands
+print("\nTest 1: Known hands")
+royal = pokereval.parse("AhKhQhJhTh")
+assert list(royal) == [48, 44, 40, 36, 32]
+boat = pokereval.parse("As Ad Ac Kd Kh 2c 2d")
+trash = pokereval.parse("2c 3d 4h 5s 7c 9d Jh")
+values = pokereval.evaluate(rows([boat, trash], 7))
+assert values[0] == 0x7ED000, hex(values[0])
+assert values[1] == 0x1B9754, hex(values[1])
+assert pokereval.category_name(values[0]) == "Full House"
+assert pokereval.category(pokereval.evaluate(rows([royal], 5))[0]) == 10
+print("✓ Values match poker-eval output")
+
+# Test 2: threads and evaluate_into agree on a large batch
+print("\nTest 2: Threaded batch")
+rng = random.Random(7)
+hands = [rng.sample(range(52), 7) for _ in range(50000)]
+hands[10][6] = hands[10][0]     # repeated card
+hands[11][3] = 60               # index out of range
+cards = rows(hands, 7)
+single = pokereval.evaluate(cards, threads=1)
+multi = pokereval.evaluate(cards, threads=4)
+assert list(single) == list(multi)
+assert single[10] == 0 and single[11] == 0
+assert sum(1 for v in single if v) == 49998
+out = array.array("I", bytes(4 * 50000))
+assert pokereval.evaluate_into(cards, out, threads=2) is None
+assert list(out) == list(single)
+print("✓ %d hands agree across thread counts" % len(hands))
+
+# Test 3: NumPy arrays (optional)
+try:
+    import numpy as np
+except ImportError:
+    print("\nTest 3: SKIP (NumPy not installed)")
+else:
+    print("\nTest 3: NumPy arrays")
+    arr = np.array(hands, dtype=np.uint8)
+    result = pokereval.evaluate(arr)
+    assert result.dtype == np.uint32 and result.shape == (50000,)
+    assert list(result) == list(single)
+    out = np.zeros(50000, dtype=np.uint32)
+    pokereval.evaluate_into(arr, out)
+    assert (out == result).all()
+    print("✓ ndarray in, ndarray out")
+
+# Test 4: argument errors
+print("\nTest 4: Errors")
+def raises(exc, fn, *args, **kwargs):
+    try:
+        fn(*args, **kwargs)
+    except exc:
+        return
+    raise AssertionError("%s not raised" % exc.__name__)
+
+raises(ValueError, pokereval.evaluate, rows([royal[:4]], 4))
+raises(ValueError, pokereval.evaluate, memoryview(bytes(royal)))
+raises(TypeError, pokereval.evaluate, memoryview(bytes(8 * 7)).cast("Q", (1, 7)))
+raises(TypeError, pokereval.evaluate_into, rows([royal], 5), array.array("H", [0]))
+raises(ValueError, pokereval.evaluate_into, rows([royal], 5), array.array("I", [0, 0]))
+raises(BufferError, pokereval.evaluate_into, rows([royal], 5), bytes(4))
+raises(ValueError, pokereval.evaluate, rows([royal], 5), threads=-1)
+raises(ValueError, pokereval.parse, "AhKhXx")
+print("✓ Errors raised")
+EOF
+
+echo ""
+echo "=========================================="
+echo "All pokereval tests passed!"
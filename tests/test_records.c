@@ -0,0 +1,363 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/poker_records.h"
+
+/*
+ * Test Suite for Binary Hand-Record Files
+ * Tests verify lossless round trips, block index seeking and corruption checks
+ */
+
+/* Static helper: deterministic pseudo-random generator (xorshift32) */
+static uint32_t rng_state = 2463534242u;
+static uint32_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/* Static helper: build a valid record with distinct cards and mixed shapes */
+static void make_record(HandRecord* const rec, const uint64_t hand_id) {
+    uint64_t used = 0;
+
+    memset(rec, 0, sizeof(*rec));
+    memset(rec->hole, CARD_INDEX_NONE, sizeof(rec->hole));
+    rec->hand_id = hand_id;
+    rec->num_players = (uint8_t)(2 + next_random() % (MAX_PLAYERS - 1));
+    rec->hero = (next_random() % 4 == 0) ? PLAYER_NONE
+                                         : (uint8_t)(next_random() % rec->num_players);
+    rec->board_len = (uint8_t)((const uint8_t[]){0, 3, 4, 5})[next_random() % 4];
+
+    for (unsigned p = 0; p < rec->num_players; p++) {
+        if (p != rec->hero && next_random() % 3 != 0) {
+            continue;  /* Hole cards not shown */
+        }
+        for (unsigned c = 0; c < HOLE_SIZE; c++) {
+            unsigned card;
+            do {
+                card = next_random() % DECK_SIZE;
+            } while (used & (UINT64_C(1) << card));
+            used |= UINT64_C(1) << card;
+            rec->hole[p][c] = (uint8_t)card;
+        }
+        rec->showdown_mask |= (uint16_t)(1u << p);
+    }
+    for (unsigned b = 0; b < rec->board_len; b++) {
+        unsigned card;
+        do {
+            card = next_random() % DECK_SIZE;
+        } while (used & (UINT64_C(1) << card));
+        used |= UINT64_C(1) << card;
+        rec->board[b] = (uint8_t)card;
+    }
+    rec->winner_mask = (uint16_t)(1u << (next_random() % rec->num_players));
+}
+
+/* Static helper: build count records with mostly sequential hand ids */
+static HandRecord* make_records(const size_t count) {
+    HandRecord* const records = malloc(count * sizeof(HandRecord));
+    assert(records != NULL);
+    uint64_t id = UINT64_C(230000000000);
+    for (size_t i = 0; i < count; i++) {
+        id += (i % 97 == 0) ? 1000 : 1;  /* Occasional gaps */
+        make_record(&records[i], (i % 501 == 0) ? id - 5000 : id);  /* Some backwards */
+    }
+    return records;
+}
+
+static char path[] = "/tmp/poker_records_XXXXXX";
+
+/* Static helper: write records with the given options */
+static void write_file(const HandRecord* const records, const size_t count,
+                       const RecordWriterOptions* const options) {
+    RecordWriter* const writer = record_writer_open(path, options);
+    assert(writer != NULL);
+    /* Uneven append sizes exercise block boundaries */
+    size_t done = 0;
+    size_t step = 1;
+    while (done < count) {
+        const size_t n = (count - done < step) ? count - done : step;
+        assert(record_writer_append(writer, records + done, n) == 0);
+        done += n;
+        step = step * 3 + 1;
+    }
+    assert(record_writer_close(writer) == 0);
+}
+
+static long file_size(void) {
+    struct stat st;
+    assert(stat(path, &st) == 0);
+    return (long)st.st_size;
+}
+
+void test_records_round_trip(void) {
+    printf("Testing record file round trip (raw and compressed)...\n");
+
+    const size_t count = 20000;
+    HandRecord* const records = make_records(count);
+    HandRecord* const decoded = malloc(count * sizeof(HandRecord));
+    assert(decoded != NULL);
+
+    const RecordWriterOptions modes[] = {{0, 0}, {0, 1}, {1000, 1}, {1, 0}};
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        write_file(records, count, &modes[m]);
+
+        RecordReader* const reader = record_reader_open(path);
+        assert(reader != NULL);
+        assert(record_reader_count(reader) == count);
+
+        /* Read in odd-sized chunks */
+        size_t total = 0;
+        size_t got;
+        do {
+            assert(record_reader_read(reader, decoded + total,
+                                      (count - total < 777) ? count - total : 777, &got) == 0);
+            total += got;
+        } while (got > 0 && total < count);
+        assert(total == count);
+        assert(record_reader_read(reader, decoded, 10, &got) == 0 && got == 0);
+        assert(memcmp(records, decoded, count * sizeof(HandRecord)) == 0);
+
+        record_reader_close(reader);
+    }
+
+    free(decoded);
+    free(records);
+    printf("  ✓ Records decode identically in every mode\n");
+}
+
+void test_records_size(void) {
+    printf("Testing record file is much smaller than raw structs...\n");
+
+    const size_t count = 20000;
+    HandRecord* const records = make_records(count);
+
+    RecordWriterOptions options = {0, 1};
+    write_file(records, count, &options);
+    const long size = file_size();
+    printf("  %zu records: %ld bytes (%.1f bytes/record vs %zu)\n",
+           count, size, (double)size / count, sizeof(HandRecord));
+    assert(size < (long)(count * sizeof(HandRecord)) / 3);
+
+    free(records);
+    printf("  ✓ Compact encoding\n");
+}
+
+void test_records_index_seek(void) {
+    printf("Testing block index and seeking...\n");
+
+    const size_t count = 10000;
+    HandRecord* const records = make_records(count);
+    RecordWriterOptions options = {512, 1};
+    write_file(records, count, &options);
+
+    RecordReader* const reader = record_reader_open(path);
+    assert(reader != NULL);
+    assert(record_reader_block_count(reader) == (count + 511) / 512);
+
+    RecordBlockInfo info;
+    assert(record_reader_block_info(reader, 3, &info) == 0);
+    assert(info.first_record == 3 * 512 && info.count == 512);
+    uint64_t min_id = UINT64_MAX, max_id = 0;
+    for (size_t i = info.first_record; i < info.first_record + info.count; i++) {
+        min_id = (records[i].hand_id < min_id) ? records[i].hand_id : min_id;
+        max_id = (records[i].hand_id > max_id) ? records[i].hand_id : max_id;
+    }
+    assert(info.min_hand_id == min_id && info.max_hand_id == max_id);
+    assert(record_reader_block_info(reader, 1000, &info) == -1);
+    assert(poker_errno == POKER_ERANGE);
+
+    const uint64_t targets[] = {0, 1, 511, 512, 4097, 9999, 5000};
+    for (size_t t = 0; t < sizeof(targets) / sizeof(targets[0]); t++) {
+        HandRecord rec[3];
+        size_t got;
+        assert(record_reader_seek(reader, targets[t]) == 0);
+        assert(record_reader_read(reader, rec, 3, &got) == 0);
+        assert(got == ((count - targets[t] < 3) ? count - targets[t] : 3));
+        assert(memcmp(rec, &records[targets[t]], got * sizeof(HandRecord)) == 0);
+    }
+
+    size_t got;
+    HandRecord rec;
+    assert(record_reader_seek(reader, count) == 0);
+    assert(record_reader_read(reader, &rec, 1, &got) == 0 && got == 0);
+    assert(record_reader_seek(reader, count + 1) == -1);
+    assert(poker_errno == POKER_ERANGE);
+
+    record_reader_close(reader);
+    free(records);
+    printf("  ✓ Index lookups and seeks correct\n");
+}
+
+void test_records_empty_file(void) {
+    printf("Testing empty record file...\n");
+
+    RecordWriter* const writer = record_writer_open(path, NULL);
+    assert(writer != NULL);
+    assert(record_writer_close(writer) == 0);
+
+    RecordReader* const reader = record_reader_open(path);
+    assert(reader != NULL);
+    assert(record_reader_count(reader) == 0);
+    assert(record_reader_block_count(reader) == 0);
+    HandRecord rec;
+    size_t got;
+    assert(record_reader_read(reader, &rec, 1, &got) == 0 && got == 0);
+    record_reader_close(reader);
+
+    printf("  ✓ Empty file valid\n");
+}
+
+void test_records_invalid_input(void) {
+    printf("Testing writer rejects unencodable records...\n");
+
+    RecordWriter* const writer = record_writer_open(path, NULL);
+    assert(writer != NULL);
+
+    HandRecord rec;
+    make_record(&rec, 1);
+    rec.num_players = MAX_PLAYERS + 1;
+    poker_errno = POKER_EOK;
+    assert(record_writer_append(writer, &rec, 1) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    make_record(&rec, 1);
+    rec.board_len = 5;
+    rec.board[4] = 52;
+    assert(record_writer_append(writer, &rec, 1) == -1);
+
+    make_record(&rec, 1);
+    rec.winner_mask = (uint16_t)(1u << rec.num_players);
+    assert(record_writer_append(writer, &rec, 1) == -1);
+
+    assert(record_writer_append(NULL, &rec, 1) == -1);
+    assert(record_writer_close(writer) == 0);
+    assert(record_writer_close(NULL) == 0);
+
+    assert(record_writer_open("/nonexistent/dir/file.phr", NULL) == NULL);
+    assert(poker_errno == POKER_ENOTFOUND);
+
+    printf("  ✓ Invalid records rejected\n");
+}
+
+void test_records_corruption(void) {
+    printf("Testing reader detects corrupt files...\n");
+
+    const size_t count = 3000;
+    HandRecord* const records = make_records(count);
+    HandRecord* const decoded = malloc(count * sizeof(HandRecord));
+    assert(decoded != NULL);
+
+    const int modes[] = {0, 1};
+    for (size_t m = 0; m < 2; m++) {
+        RecordWriterOptions options = {1000, modes[m]};
+        write_file(records, count, &options);
+
+        /* Flip one byte inside the second block's payload */
+        RecordReader* reader = record_reader_open(path);
+        assert(reader != NULL);
+        RecordBlockInfo info;
+        assert(record_reader_block_info(reader, 1, &info) == 0);
+        record_reader_close(reader);
+
+        FILE* file = fopen(path, "r+b");
+        assert(file != NULL);
+        const long at = (long)info.offset + 20 + (long)info.stored_size / 2;
+        fseek(file, at, SEEK_SET);
+        const int byte = fgetc(file);
+        fseek(file, at, SEEK_SET);
+        fputc(byte ^ 0x5A, file);
+        fclose(file);
+
+        reader = record_reader_open(path);
+        assert(reader != NULL);  /* Index is intact */
+        size_t got;
+        poker_errno = POKER_EOK;
+        assert(record_reader_read(reader, decoded, count, &got) == -1);
+        assert(poker_errno == POKER_EFORMAT);
+        assert(got == 1000);  /* First block delivered before the bad one */
+        assert(memcmp(decoded, records, 1000 * sizeof(HandRecord)) == 0);
+        record_reader_close(reader);
+    }
+
+    /* Truncated file and wrong magic */
+    write_file(records, count, NULL);
+    assert(truncate(path, file_size() - 3) == 0);
+    assert(record_reader_open(path) == NULL);
+    assert(poker_errno == POKER_EFORMAT);
+
+    FILE* file = fopen(path, "wb");
+    assert(file != NULL);
+    fputs("this is not a record file at all, just text", file);
+    fclose(file);
+    assert(record_reader_open(path) == NULL);
+    assert(poker_errno == POKER_EFORMAT);
+
+    assert(record_reader_open("/nonexistent/file.phr") == NULL);
+    assert(poker_errno == POKER_ENOTFOUND);
+
+    free(decoded);
+    free(records);
+    printf("  ✓ Corruption detected\n");
+}
+
+void test_records_from_history(void) {
+    printf("Testing records parsed from text history survive a round trip...\n");
+
+    const char* const hand =
+        "PokerStars Hand #230000000001: Hold'em No Limit ($0.01/$0.02 USD)\n"
+        "Seat 1: alice ($2.00 in chips)\n"
+        "Seat 3: bob ($2.00 in chips)\n"
+        "*** HOLE CARDS ***\n"
+        "Dealt to alice [Ah Kd]\n"
+        "*** SHOW DOWN ***\n"
+        "bob: shows [Tc Td] (a pair of Tens)\n"
+        "bob collected $0.04 from pot\n"
+        "*** SUMMARY ***\n"
+        "Board [2c 7d Jh 5s Qc]\n";
+
+    HandRecord rec;
+    assert(history_parse_hand(hand, strlen(hand), &rec) == 0);
+
+    RecordWriter* const writer = record_writer_open(path, NULL);
+    assert(writer != NULL);
+    assert(record_writer_append(writer, &rec, 1) == 0);
+    assert(record_writer_close(writer) == 0);
+
+    RecordReader* const reader = record_reader_open(path);
+    assert(reader != NULL);
+    HandRecord decoded;
+    size_t got;
+    assert(record_reader_read(reader, &decoded, 1, &got) == 0 && got == 1);
+    assert(memcmp(&rec, &decoded, sizeof(HandRecord)) == 0);
+    record_reader_close(reader);
+
+    printf("  ✓ Parsed history record preserved exactly\n");
+}
+
+int main(void) {
+    printf("\n=== Hand Record File Test Suite ===\n\n");
+
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    test_records_round_trip();
+    test_records_size();
+    test_records_index_seek();
+    test_records_empty_file();
+    test_records_invalid_input();
+    test_records_corruption();
+    test_records_from_history();
+
+    unlink(path);
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
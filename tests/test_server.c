@@ -0,0 +1,309 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/poker_server.h"
+#include "test_helpers.h"
+
+/*
+ * Test Suite for the Evaluation Server
+ * Tests verify concurrent clients get the same answers as direct calls,
+ * deadlines, malformed requests, clients that stop reading and clean
+ * shutdown
+ */
+
+#define NUM_CLIENTS 4
+#define REQUESTS_PER_CLIENT 200
+#define HANDS_PER_REQUEST 100
+
+/* Enough pipelined requests that the responses overflow the socket buffers */
+#define FLOOD_REQUESTS 100000
+
+static char socket_path[64];
+static PokerServer* server = NULL;
+static pthread_t server_thread;
+
+/*
+ * Static helper: read counters once hands and deadline misses reach the
+ * expected totals
+ * Workers publish counters after answering, so a reply can arrive first.
+ */
+static void settled_stats(const uint64_t expected_hands, const uint64_t expected_misses,
+                          ServerStats* const stats) {
+    const struct timespec pause = {0, 1000000};
+    for (int tries = 0; tries < 1000; tries++) {
+        server_get_stats(server, stats);
+        if (stats->hands >= expected_hands && stats->deadline_misses >= expected_misses) {
+            return;
+        }
+        nanosleep(&pause, NULL);
+    }
+}
+
+static void* run_server(void* arg) {
+    (void)arg;
+    assert(server_run(server) == 0);
+    return NULL;
+}
+
+/* Static helper: connect a raw socket to the server */
+static int raw_connect(void) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_path);
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    assert(fd >= 0);
+    assert(connect(fd, (const struct sockaddr*)&addr, sizeof(addr)) == 0);
+    return fd;
+}
+
+/* Static helper: random seven-card masks */
+static void random_masks(uint32_t* const state, uint64_t* const masks, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint64_t mask = 0;
+        while (__builtin_popcountll(mask) < 7) {
+            *state = *state * 1103515245u + 12345u;
+            mask |= UINT64_C(1) << ((*state >> 16) % DECK_SIZE);
+        }
+        masks[i] = mask;
+    }
+}
+
+static void* client_worker(void* arg) {
+    uint32_t state = (uint32_t)(size_t)arg * 7919u + 1u;
+    PokerClient* const client = client_connect(socket_path);
+    assert(client != NULL);
+
+    uint64_t masks[HANDS_PER_REQUEST];
+    HandValue values[HANDS_PER_REQUEST];
+    for (size_t r = 0; r < REQUESTS_PER_CLIENT; r++) {
+        random_masks(&state, masks, HANDS_PER_REQUEST);
+        assert(client_evaluate(client, masks, HANDS_PER_REQUEST, 0, values) == 0);
+        for (size_t i = 0; i < HANDS_PER_REQUEST; i++) {
+            assert(values[i] == evaluate_mask(masks[i]));
+        }
+    }
+    client_close(client);
+    return NULL;
+}
+
+void test_server_concurrent_evaluate(void) {
+    printf("Testing concurrent clients against direct evaluation...\n");
+
+    pthread_t threads[NUM_CLIENTS];
+    for (size_t t = 0; t < NUM_CLIENTS; t++) {
+        assert(pthread_create(&threads[t], NULL, client_worker, (void*)t) == 0);
+    }
+    for (size_t t = 0; t < NUM_CLIENTS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    ServerStats stats;
+    settled_stats(NUM_CLIENTS * REQUESTS_PER_CLIENT * HANDS_PER_REQUEST, 0, &stats);
+    assert(stats.connections == NUM_CLIENTS);
+    assert(stats.requests == NUM_CLIENTS * REQUESTS_PER_CLIENT);
+    assert(stats.hands == NUM_CLIENTS * REQUESTS_PER_CLIENT * HANDS_PER_REQUEST);
+    assert(stats.batches <= stats.requests);
+
+    printf("  ✓ %llu requests served in %llu batches (largest %llu)\n",
+           (unsigned long long)stats.requests, (unsigned long long)stats.batches,
+           (unsigned long long)stats.max_batch_requests);
+}
+
+void test_server_equity(void) {
+    printf("Testing equity requests...\n");
+
+    PokerClient* const client = client_connect(socket_path);
+    assert(client != NULL);
+    assert(client_ping(client) == 0);
+
+    /* Enumeration matches the direct call exactly */
+    const uint64_t holes[2] = {mask_of("AhKh"), mask_of("7c7d")};
+    const uint64_t board = mask_of("Qh8h2s");
+    EquityResult remote, local;
+    assert(client_equity(client, holes, 2, board, 0, 0, 0, 0, &remote) == 0);
+    assert(calculate_equity(holes, 2, board, 0, 0, 0, &local) == 0);
+    assert(memcmp(&remote, &local, sizeof(local)) == 0);
+
+    /* Sampling runs in chunks: same trials, close to the exact answer */
+    assert(client_equity(client, holes, 2, board, 0, 50000, 9, 0, &remote) == 0);
+    assert(remote.trials == 50000);
+    assert(fabs(remote.equity[0] - local.equity[0]) < 0.01);
+    assert(fabs(remote.equity[0] + remote.equity[1] - 1.0) < 1e-9);
+
+    /* Invalid cards are rejected, and the connection stays usable */
+    const uint64_t clash[2] = {mask_of("AhKh"), mask_of("AhQd")};
+    poker_errno = POKER_EOK;
+    assert(client_equity(client, clash, 2, 0, 0, 0, 0, 0, &remote) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(client_ping(client) == 0);
+
+    client_close(client);
+    printf("  ✓ Equity matches calculate_equity()\n");
+}
+
+void test_server_deadline(void) {
+    printf("Testing request deadlines...\n");
+
+    PokerClient* const client = client_connect(socket_path);
+    assert(client != NULL);
+
+    /* Far more sampling than fits in one millisecond */
+    const uint64_t holes[6] = {mask_of("AsAh"), mask_of("KdKc"), mask_of("QsQh"),
+                               mask_of("JdJc"), mask_of("TsTh"), mask_of("9d9c")};
+    ServerStats before, after;
+    server_get_stats(server, &before);
+    EquityResult result;
+    poker_errno = POKER_EOK;
+    assert(client_equity(client, holes, 6, 0, 0, 100000000u, 1, 1000, &result) == -1);
+    assert(poker_errno == POKER_ETIMEDOUT);
+    settled_stats(0, before.deadline_misses + 1, &after);
+    assert(after.deadline_misses == before.deadline_misses + 1);
+
+    /* A generous deadline still succeeds */
+    const uint64_t mask = mask_of("AsKsQsJsTs");
+    HandValue value = 0;
+    assert(client_evaluate(client, &mask, 1, 1000000, &value) == 0);
+    assert(HAND_VALUE_CATEGORY(value) == HAND_ROYAL_FLUSH);
+
+    client_close(client);
+    printf("  ✓ Deadline misses reported as POKER_ETIMEDOUT\n");
+}
+
+void test_server_malformed(void) {
+    printf("Testing malformed requests...\n");
+
+    const int fd = raw_connect();
+
+    /* Unknown type: INVALID reply, then the server hangs up */
+    ServerRequestHeader header;
+    memset(&header, 0, sizeof(header));
+    header.id = 77;
+    header.type = 99;
+    assert(send(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header));
+    ServerResponseHeader response;
+    assert(recv(fd, &response, sizeof(response), MSG_WAITALL) == (ssize_t)sizeof(response));
+    assert(response.id == 77);
+    assert(response.status == SERVER_STATUS_INVALID);
+    assert(response.payload_size == 0);
+    char byte;
+    assert(recv(fd, &byte, 1, 0) == 0);
+    close(fd);
+
+    /* Client-side argument checks */
+    PokerClient* const client = client_connect(socket_path);
+    assert(client != NULL);
+    HandValue value;
+    poker_errno = POKER_EOK;
+    assert(client_evaluate(client, NULL, 1, 0, &value) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    const uint64_t mask = 0;
+    assert(client_evaluate(client, &mask, SERVER_MAX_HANDS + 1, 0, &value) == -1);
+
+    /* Invalid masks evaluate to 0 like evaluate_mask() */
+    assert(client_evaluate(client, &mask, 1, 0, &value) == 0);
+    assert(value == 0);
+    client_close(client);
+
+    poker_errno = POKER_EOK;
+    assert(client_connect("/nonexistent/poker.sock") == NULL);
+    assert(poker_errno == POKER_EIO);
+
+    printf("  ✓ Malformed requests rejected\n");
+}
+
+void test_server_slow_reader(void) {
+    printf("Testing a client that stops reading...\n");
+
+    /* Pipeline pings and evaluations without reading any response */
+    const int fd = raw_connect();
+    const uint64_t mask = mask_of("AsKsQsJsTs");
+    static uint8_t requests[FLOOD_REQUESTS * (sizeof(ServerRequestHeader) + sizeof(uint64_t))];
+    size_t size = 0;
+    for (uint32_t r = 0; r < FLOOD_REQUESTS; r++) {
+        ServerRequestHeader header;
+        memset(&header, 0, sizeof(header));
+        header.id = r;
+        header.type = (r % 100 == 0) ? SERVER_REQ_EVALUATE : SERVER_REQ_PING;
+        header.count = (header.type == SERVER_REQ_EVALUATE) ? 1 : 0;
+        memcpy(requests + size, &header, sizeof(header));
+        size += sizeof(header);
+        if (header.type == SERVER_REQ_EVALUATE) {
+            memcpy(requests + size, &mask, sizeof(mask));
+            size += sizeof(mask);
+        }
+    }
+    for (size_t sent = 0; sent < size;) {
+        const ssize_t n = send(fd, requests + sent, size - sent, 0);
+        assert(n > 0);
+        sent += (size_t)n;
+    }
+
+    /* Other clients are served while those responses wait */
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    PokerClient* const client = client_connect(socket_path);
+    assert(client != NULL);
+    for (int i = 0; i < 10; i++) {
+        assert(client_ping(client) == 0);
+    }
+    client_close(client);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    assert((double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9 < 1.0);
+
+    /* Every response still arrives, once, with the right values */
+    static uint8_t seen[FLOOD_REQUESTS];
+    memset(seen, 0, sizeof(seen));
+    for (uint32_t r = 0; r < FLOOD_REQUESTS; r++) {
+        ServerResponseHeader response;
+        assert(recv(fd, &response, sizeof(response), MSG_WAITALL) == (ssize_t)sizeof(response));
+        assert(response.id < FLOOD_REQUESTS && !seen[response.id]);
+        assert(response.status == SERVER_STATUS_OK);
+        seen[response.id] = 1;
+        if (response.id % 100 == 0) {
+            HandValue value = 0;
+            assert(response.payload_size == sizeof(value));
+            assert(recv(fd, &value, sizeof(value), MSG_WAITALL) == (ssize_t)sizeof(value));
+            assert(value == evaluate_mask(mask));
+        } else {
+            assert(response.payload_size == 0);
+        }
+    }
+    close(fd);
+
+    printf("  ✓ A stalled reader does not hold up other clients\n");
+}
+
+int main(void) {
+    printf("\n=== Evaluation Server Test Suite ===\n\n");
+
+    snprintf(socket_path, sizeof(socket_path), "/tmp/poker-test-%ld.sock", (long)getpid());
+    const ServerOptions options = {socket_path, 2, 0, 0, 0};
+    server = server_open(&options);
+    assert(server != NULL);
+    assert(pthread_create(&server_thread, NULL, run_server, NULL) == 0);
+
+    test_server_concurrent_evaluate();
+    test_server_equity();
+    test_server_deadline();
+    test_server_malformed();
+    test_server_slow_reader();
+
+    server_stop(server);
+    pthread_join(server_thread, NULL);
+    server_close(server);
+    struct stat st;
+    assert(stat(socket_path, &st) != 0);
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,293 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/poker_showdown.h"
+#include "test_helpers.h"
+
+/*
+ * Test Suite for showdown_build_pots(), showdown_settle() and
+ * showdown_settle_batch()
+ * Tests verify main/side pot construction, folded chips, multiway all-in
+ * payouts, chip conservation, batch/single agreement and error handling
+ */
+
+/* Static helper: table with the given holes (NULL = folded) and contributions */
+static ShowdownTable make_table(const char* const* const holes, const uint64_t* const put,
+                                const size_t n, const char* const board) {
+    ShowdownTable table;
+    memset(&table, 0, sizeof(table));
+    table.num_players = n;
+    table.board = mask_of(board);
+    table.odd_chip_rule = SHOWDOWN_ODD_CHIP_POSITION;
+    for (size_t seat = 0; seat < n; seat++) {
+        table.players[seat].folded = (holes[seat] == NULL);
+        table.players[seat].hole = holes[seat] ? mask_of(holes[seat]) : 0;
+        table.contributions[seat] = put[seat];
+    }
+    return table;
+}
+
+void test_build_pots(void) {
+    printf("Testing showdown_build_pots...\n");
+
+    ShowdownSidePot pots[SHOWDOWN_MAX_POTS];
+    size_t num_pots = 0;
+
+    /* Three all-ins of 50, 100 and 300: main pot 150, side pots 100 and 200 */
+    const char* holes[4] = {"AhAd", "KhKd", "QhQd", "JhJd"};
+    const uint64_t put[4] = {50, 100, 300, 300};
+    ShowdownTable table = make_table(holes, put, 4, "2c3d4s8h9c");
+    assert(showdown_build_pots(&table, pots, &num_pots) == 0);
+    assert(num_pots == 3);
+    assert(pots[0].amount == 200 && pots[0].eligible == 0xF);
+    assert(pots[1].amount == 150 && pots[1].eligible == 0xE);
+    assert(pots[2].amount == 400 && pots[2].eligible == 0xC);
+
+    /* Folded chips: seat 1 folded after putting in 80 */
+    const char* folded[4] = {"AhAd", NULL, "QhQd", "JhJd"};
+    const uint64_t put2[4] = {50, 80, 300, 300};
+    table = make_table(folded, put2, 4, "2c3d4s8h9c");
+    assert(showdown_build_pots(&table, pots, &num_pots) == 0);
+    assert(num_pots == 2);
+    assert(pots[0].amount == 200 && pots[0].eligible == 0xD);
+    assert(pots[1].amount == 30 + 250 + 250 && pots[1].eligible == 0xC);
+
+    /* Folded chips above every live level go to the top pot */
+    const uint64_t put3[4] = {50, 500, 100, 100};
+    table = make_table(folded, put3, 4, "2c3d4s8h9c");
+    assert(showdown_build_pots(&table, pots, &num_pots) == 0);
+    assert(num_pots == 2);
+    assert(pots[0].amount == 200 && pots[0].eligible == 0xD);
+    assert(pots[1].amount == 450 + 50 + 50 && pots[1].eligible == 0xC);
+
+    /* Equal contributions: a single pot */
+    const uint64_t equal[4] = {100, 100, 100, 100};
+    table = make_table(holes, equal, 4, "2c3d4s8h9c");
+    assert(showdown_build_pots(&table, pots, &num_pots) == 0);
+    assert(num_pots == 1 && pots[0].amount == 400 && pots[0].eligible == 0xF);
+
+    printf("  ✓ Main and side pots built from live levels\n");
+}
+
+void test_settle_multiway_all_in(void) {
+    printf("Testing showdown_settle with a multiway all-in...\n");
+
+    /* Short stack has the best hand: wins only the main pot */
+    const char* holes[4] = {"AhAd", "KhKd", "QhQd", "JhJd"};
+    const uint64_t put[4] = {50, 100, 300, 300};
+    ShowdownTable table = make_table(holes, put, 4, "2c3d4s8h9c");
+    ShowdownSettlement result;
+    assert(showdown_settle(&table, &result) == 0);
+    assert(result.status == POKER_EOK);
+    assert(result.pots[0].winners == 0x1);
+    assert(result.pots[1].winners == 0x2);
+    assert(result.pots[2].winners == 0x4);
+    assert(result.payouts[0] == 200 && result.payouts[1] == 150);
+    assert(result.payouts[2] == 400 && result.payouts[3] == 0);
+    assert(result.values[0] > result.values[1] && result.values[1] > result.values[2]);
+
+    /* Uncalled chips come back to the big stack without a showdown */
+    const uint64_t uncalled[2] = {100, 400};
+    const char* two[2] = {"AhAd", "KhKd"};
+    table = make_table(two, uncalled, 2, "2c3d4s8h9c");
+    assert(showdown_settle(&table, &result) == 0);
+    assert(result.num_pots == 2);
+    assert(result.payouts[0] == 200 && result.payouts[1] == 300);
+
+    /* Split main pot, side pot to the only eligible seat */
+    const char* tied[3] = {"2h3h", "2d3d", "KhKd"};
+    const uint64_t put3[3] = {101, 101, 101};
+    table = make_table(tied, put3, 3, "AsKsQsJsTs");
+    table.first_seat = 1;
+    assert(showdown_settle(&table, &result) == 0);
+    assert(result.pots[0].winners == 0x7);
+    assert(result.payouts[1] == 101 && result.payouts[2] == 101 && result.payouts[0] == 101);
+    const uint64_t put4[3] = {50, 101, 300};
+    table = make_table(tied, put4, 3, "AsKsQsJsTs");
+    table.first_seat = 1;
+    assert(showdown_settle(&table, &result) == 0);
+    assert(result.payouts[0] == 50);                  /* 150 three ways */
+    assert(result.payouts[1] == 50 + 51);              /* 102 two ways, odd chip to seat 1 */
+    assert(result.payouts[2] == 50 + 51 + 199);
+
+    /* Everyone else folded: no board needed */
+    const char* folded[3] = {NULL, "AhAd", NULL};
+    const uint64_t put5[3] = {20, 60, 40};
+    table = make_table(folded, put5, 3, "");
+    assert(showdown_settle(&table, &result) == 0);
+    assert(result.payouts[1] == 120 && result.values[1] == 0);
+
+    printf("  ✓ Each pot goes to its best eligible hand\n");
+}
+
+void test_settle_matches_resolve(void) {
+    printf("Testing showdown_settle conserves chips and agrees with showdown_resolve...\n");
+
+    srand(63);
+    for (size_t deal = 0; deal < 20000; deal++) {
+        const size_t n = 2 + deal % (MAX_PLAYERS - 1);
+        ShowdownTable table;
+        memset(&table, 0, sizeof(table));
+        table.num_players = n;
+        table.first_seat = deal % n;
+        table.odd_chip_rule = (deal & 1) ? SHOWDOWN_ODD_CHIP_HIGH_CARD : SHOWDOWN_ODD_CHIP_POSITION;
+
+        uint64_t used = 0;
+        for (size_t c = 0; c < BOARD_SIZE + 2 * n; c++) {
+            uint64_t bit;
+            do {
+                bit = UINT64_C(1) << (rand() % DECK_SIZE);
+            } while (used & bit);
+            used |= bit;
+            if (c < BOARD_SIZE) {
+                table.board |= bit;
+            } else {
+                table.players[(c - BOARD_SIZE) / 2].hole |= bit;
+            }
+        }
+        uint64_t total = 0;
+        size_t live = 0;
+        for (size_t seat = 0; seat < n; seat++) {
+            table.players[seat].folded = (rand() % 4 == 0);
+            table.contributions[seat] = (uint64_t)(rand() % 5) * 25 + (uint64_t)(rand() % 3);
+            total += table.contributions[seat];
+            live += !table.players[seat].folded;
+        }
+        if (live == 0) {
+            table.players[0].folded = 0;
+        }
+
+        ShowdownSettlement result;
+        assert(showdown_settle(&table, &result) == 0);
+        uint64_t paid = 0;
+        uint64_t in_pots = 0;
+        for (size_t seat = 0; seat < n; seat++) {
+            paid += result.payouts[seat];
+            if (table.players[seat].folded) {
+                assert(result.payouts[seat] == 0);
+            }
+        }
+        for (size_t p = 0; p < result.num_pots; p++) {
+            in_pots += result.pots[p].amount;
+        }
+        assert(paid == total && in_pots == total);
+
+        /* Every pot matches a one-pot showdown among its eligible seats */
+        for (size_t p = 0; p < result.num_pots; p++) {
+            ShowdownPlayer players[MAX_PLAYERS];
+            for (size_t seat = 0; seat < n; seat++) {
+                players[seat] = table.players[seat];
+                players[seat].folded = !(result.pots[p].eligible & (1u << seat));
+            }
+            uint16_t winners = 0;
+            assert(showdown_resolve(players, n, table.board, NULL, &winners, NULL) > 0);
+            assert(winners == result.pots[p].winners);
+        }
+    }
+
+    printf("  ✓ 20000 tables settled exactly\n");
+}
+
+void test_settle_batch(void) {
+    printf("Testing showdown_settle_batch...\n");
+
+    const size_t count = 20000;
+    ShowdownTable* const tables = malloc(count * sizeof(ShowdownTable));
+    ShowdownSettlement* const single = malloc(count * sizeof(ShowdownSettlement));
+    ShowdownSettlement* const batch = malloc(count * sizeof(ShowdownSettlement));
+    assert(tables && single && batch);
+
+    const char* holes[4] = {"AhAd", "KhKd", "QhQd", "JhJd"};
+    const char* boards[3] = {"2c3d4s8h9c", "AsKsQsJsTs", "Kc7d7h2s2d"};
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t put[4] = {10 + i % 7, 10 + i % 11, 10 + i % 13, 10 + i % 5};
+        tables[i] = make_table(holes, put, 4, boards[i % 3]);
+        tables[i].first_seat = i % 4;
+        assert(showdown_settle(&tables[i], &single[i]) == 0);
+    }
+
+    for (size_t threads = 1; threads <= 4; threads++) {
+        memset(batch, 0xAB, count * sizeof(ShowdownSettlement));
+        assert(showdown_settle_batch(tables, count, threads, batch) == 0);
+        for (size_t i = 0; i < count; i++) {
+            assert(batch[i].status == POKER_EOK);
+            assert(batch[i].num_pots == single[i].num_pots);
+            assert(memcmp(batch[i].payouts, single[i].payouts, sizeof(single[i].payouts)) == 0);
+        }
+    }
+
+    /* A bad table is reported without stopping the rest */
+    tables[12345].players[1].hole = tables[12345].players[0].hole;
+    poker_errno = POKER_EOK;
+    assert(showdown_settle_batch(tables, count, 4, batch) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+    assert(batch[12345].status == POKER_EDUPLICATE);
+    assert(batch[12346].status == POKER_EOK);
+    assert(memcmp(batch[19999].payouts, single[19999].payouts, sizeof(single[19999].payouts)) == 0);
+
+    assert(showdown_settle_batch(tables, 0, 0, NULL) == 0);
+    assert(showdown_settle_batch(NULL, 1, 0, batch) == -1);
+
+    free(tables);
+    free(single);
+    free(batch);
+    printf("  ✓ Batch settlements match single-table results\n");
+}
+
+void test_settle_errors(void) {
+    printf("Testing settlement error handling...\n");
+
+    const char* holes[2] = {"AhAd", "KhKd"};
+    const uint64_t put[2] = {100, 100};
+    ShowdownTable table = make_table(holes, put, 2, "2c3d4s8h9c");
+    ShowdownSettlement result;
+    ShowdownSidePot pots[SHOWDOWN_MAX_POTS];
+    size_t num_pots;
+
+    /* Contested pot needs a board */
+    table.board = mask_of("2c3d");
+    poker_errno = POKER_EOK;
+    assert(showdown_settle(&table, &result) == -1);
+    assert(poker_errno == POKER_EINVAL && result.status == POKER_EINVAL);
+
+    table.board = mask_of("2c3d4s8h9c");
+    table.players[1].hole = mask_of("Ah2c");
+    assert(showdown_settle(&table, &result) == -1);
+    assert(result.status == POKER_EDUPLICATE);
+
+    table.players[1].hole = mask_of("KhKd");
+    table.first_seat = 2;
+    assert(showdown_settle(&table, &result) == -1);
+    table.first_seat = 0;
+    table.odd_chip_rule = 9;
+    assert(showdown_settle(&table, &result) == -1);
+    table.odd_chip_rule = SHOWDOWN_ODD_CHIP_POSITION;
+    table.num_players = 0;
+    assert(showdown_settle(&table, &result) == -1);
+    assert(showdown_build_pots(&table, pots, &num_pots) == -1);
+    table.num_players = 2;
+
+    table.players[0].folded = 1;
+    table.players[1].folded = 1;
+    assert(showdown_build_pots(&table, pots, &num_pots) == -1);
+    assert(showdown_settle(&table, &result) == -1);
+    assert(showdown_settle(NULL, &result) == -1);
+    assert(showdown_settle(&table, NULL) == -1);
+    assert(showdown_build_pots(NULL, pots, &num_pots) == -1);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Settlement Test Suite ===\n\n");
+
+    test_build_pots();
+    test_settle_multiway_all_in();
+    test_settle_matches_resolve();
+    test_settle_batch();
+    test_settle_errors();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
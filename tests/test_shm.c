@@ -0,0 +1,330 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/poker_shm.h"
+
+/*
+ * Test Suite for Shared-Memory Ring IPC
+ * Tests verify single- and multi-producer rings return the same values as
+ * direct evaluation, across processes and after the evaluator sleeps
+ */
+
+#define NUM_MASKS 5000
+#define NUM_THREADS 4
+
+static char segment_path[64];
+static ShmEvaluator* evaluator = NULL;
+static uint64_t masks[NUM_MASKS];
+static HandValue expected[NUM_MASKS];
+
+static void* run_evaluator(void* arg) {
+    (void)arg;
+    assert(shm_evaluator_run(evaluator) == 0);
+    return NULL;
+}
+
+/* Static helper: random 5-7 card masks and their direct values */
+static void make_masks(void) {
+    uint32_t state = 2024u;
+    for (size_t i = 0; i < NUM_MASKS; i++) {
+        const int cards = 5 + (int)(i % 3);
+        uint64_t mask = 0;
+        while (__builtin_popcountll(mask) < cards) {
+            state = state * 1103515245u + 12345u;
+            mask |= UINT64_C(1) << ((state >> 16) % DECK_SIZE);
+        }
+        masks[i] = mask;
+        expected[i] = evaluate_mask(mask);
+    }
+}
+
+/* Static helper: evaluate every mask through one ring and compare */
+static int check_ring(const size_t ring) {
+    ShmClient* const client = shm_client_attach(segment_path, ring);
+    if (client == NULL) {
+        return -1;
+    }
+    HandValue* const values = malloc(NUM_MASKS * sizeof(HandValue));
+    int rc = (values != NULL) ? shm_client_evaluate(client, masks, NUM_MASKS, values) : -1;
+    if (rc == 0 && memcmp(values, expected, NUM_MASKS * sizeof(HandValue)) != 0) {
+        rc = -1;
+    }
+    free(values);
+    shm_client_detach(client);
+    return rc;
+}
+
+void test_shm_single_client(void) {
+    printf("Testing one client per ring...\n");
+
+    assert(check_ring(0) == 0);
+
+    /* Requests smaller than a slot, one at a time */
+    ShmClient* const client = shm_client_attach(segment_path, 1);
+    assert(client != NULL);
+    assert(shm_client_slot_hands(client) == 64);
+    HandValue value = 0;
+    for (size_t i = 0; i < 100; i++) {
+        assert(shm_client_evaluate(client, &masks[i], 1, &value) == 0);
+        assert(value == expected[i]);
+    }
+    assert(shm_client_evaluate(client, masks, 0, NULL) == 0);
+
+    /* Invalid masks evaluate to 0 like evaluate_mask() */
+    const uint64_t bad = 0x7;
+    assert(shm_client_evaluate(client, &bad, 1, &value) == 0);
+    assert(value == 0);
+    shm_client_detach(client);
+
+    printf("  ✓ Values match evaluate_mask()\n");
+}
+
+static void* shared_ring_worker(void* arg) {
+    (void)arg;
+    assert(check_ring(2) == 0);
+    return NULL;
+}
+
+void test_shm_shared_ring(void) {
+    printf("Testing several producers on one ring...\n");
+
+    ShmStats before, after;
+    shm_evaluator_get_stats(evaluator, &before);
+
+    pthread_t threads[NUM_THREADS];
+    for (size_t t = 0; t < NUM_THREADS; t++) {
+        assert(pthread_create(&threads[t], NULL, shared_ring_worker, NULL) == 0);
+    }
+    for (size_t t = 0; t < NUM_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    shm_evaluator_get_stats(evaluator, &after);
+    assert(after.hands - before.hands == (uint64_t)NUM_THREADS * NUM_MASKS);
+    assert(after.requests - before.requests == (uint64_t)NUM_THREADS * ((NUM_MASKS + 63) / 64));
+
+    printf("  ✓ %d clients served through one ring\n", NUM_THREADS);
+}
+
+void test_shm_other_process(void) {
+    printf("Testing a client in another process...\n");
+
+    const pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        _exit(check_ring(3) == 0 ? 0 : 1);
+    }
+    int status = 0;
+    assert(waitpid(pid, &status, 0) == pid);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    printf("  ✓ Forked client served\n");
+}
+
+void test_shm_wakeup(void) {
+    printf("Testing requests wake an idle evaluator...\n");
+
+    /* Let the evaluator go to sleep, then send single requests */
+    ShmClient* const client = shm_client_attach(segment_path, 0);
+    assert(client != NULL);
+    const struct timespec pause = {0, 20000000};
+    double total = 0;
+    for (size_t i = 0; i < 5; i++) {
+        nanosleep(&pause, NULL);
+        struct timespec start, end;
+        HandValue value = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        assert(shm_client_evaluate(client, &masks[i], 1, &value) == 0);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        assert(value == expected[i]);
+        total += (double)(end.tv_sec - start.tv_sec) * 1e6 + (double)(end.tv_nsec - start.tv_nsec) / 1e3;
+    }
+    ShmStats stats;
+    shm_evaluator_get_stats(evaluator, &stats);
+    assert(stats.sleeps > 0);
+
+    /* Busy round trips for comparison */
+    struct timespec start, end;
+    HandValue value = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t i = 0; i < 10000; i++) {
+        assert(shm_client_evaluate(client, &masks[i % NUM_MASKS], 1, &value) == 0);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double busy = ((double)(end.tv_sec - start.tv_sec) * 1e6 +
+                         (double)(end.tv_nsec - start.tv_nsec) / 1e3) / 10000.0;
+    shm_client_detach(client);
+
+    printf("  ✓ Round trip %.1f us from sleep, %.2f us busy\n", total / 5.0, busy);
+}
+
+void test_shm_errors(void) {
+    printf("Testing shared-memory error handling...\n");
+
+    poker_errno = POKER_EOK;
+    assert(shm_client_attach("/nonexistent/poker-shm", 0) == NULL);
+    assert(poker_errno == POKER_EIO);
+    poker_errno = POKER_EOK;
+    assert(shm_client_attach(segment_path, 4) == NULL);
+    assert(poker_errno == POKER_ERANGE);
+
+    /* A file that is not a segment */
+    char other[80];
+    snprintf(other, sizeof(other), "%s.bad", segment_path);
+    FILE* file = fopen(other, "wb");
+    assert(file != NULL);
+    char junk[256];
+    memset(junk, 0x5A, sizeof(junk));
+    fwrite(junk, 1, sizeof(junk), file);
+    fclose(file);
+    poker_errno = POKER_EOK;
+    assert(shm_client_attach(other, 0) == NULL);
+    assert(poker_errno == POKER_EFORMAT);
+
+    /* The evaluator does not replace it either */
+    poker_errno = POKER_EOK;
+    assert(shm_evaluator_create(other, NULL) == NULL);
+    assert(poker_errno == POKER_EIO);
+    file = fopen(other, "rb");
+    assert(file != NULL);
+    char kept[257];
+    assert(fread(kept, 1, sizeof(kept), file) == sizeof(junk));
+    assert(memcmp(kept, junk, sizeof(junk)) == 0);
+    fclose(file);
+    remove(other);
+
+    const ShmRingOptions bad_slots = {1, 6, 16};
+    poker_errno = POKER_EOK;
+    assert(shm_evaluator_create(other, &bad_slots) == NULL);
+    assert(poker_errno == POKER_EINVAL);
+    assert(shm_evaluator_create(NULL, NULL) == NULL);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+void test_shm_closed(void) {
+    printf("Testing clients fail once the evaluator is gone...\n");
+
+    char path[80];
+    snprintf(path, sizeof(path), "%s.closed", segment_path);
+    const ShmRingOptions options = {1, 4, 8};
+    ShmEvaluator* const idle = shm_evaluator_create(path, &options);
+    assert(idle != NULL);
+    ShmClient* const client = shm_client_attach(path, 0);
+    assert(client != NULL);
+
+    /* Nobody polls this segment; destroying it releases the waiting client */
+    shm_evaluator_destroy(idle);
+    HandValue value;
+    poker_errno = POKER_EOK;
+    assert(shm_client_evaluate(client, masks, 1, &value) == -1);
+    assert(poker_errno == POKER_EIO);
+    shm_client_detach(client);
+    assert(access(path, F_OK) != 0);
+
+    printf("  ✓ POKER_EIO after shutdown\n");
+}
+
+void test_shm_stale(void) {
+    printf("Testing a segment left by a dead evaluator is replaced...\n");
+
+    char path[80];
+    snprintf(path, sizeof(path), "%s.stale", segment_path);
+    const ShmRingOptions options = {1, 4, 8};
+    const pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        /* Exit without destroying, as a crashed evaluator would */
+        _exit(shm_evaluator_create(path, &options) != NULL ? 0 : 1);
+    }
+    int status = 0;
+    assert(waitpid(child, &status, 0) == child);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(access(path, F_OK) == 0);
+
+    ShmEvaluator* const fresh = shm_evaluator_create(path, &options);
+    assert(fresh != NULL);
+    shm_evaluator_destroy(fresh);
+    assert(access(path, F_OK) != 0);
+
+    printf("  ✓ Old segment replaced\n");
+}
+
+void test_shm_hostile_header(void) {
+    printf("Testing the evaluator ignores geometry rewritten by a client...\n");
+
+    char path[80];
+    snprintf(path, sizeof(path), "%s.hostile", segment_path);
+    const ShmRingOptions options = {2, 8, 16};
+    ShmEvaluator* const server = shm_evaluator_create(path, &options);
+    assert(server != NULL);
+    ShmClient* const client = shm_client_attach(path, 1);
+    assert(client != NULL);
+
+    /* Rewrite num_rings, ring_slots, slot_hands and slot_size in the header */
+    const int fd = open(path, O_RDWR);
+    assert(fd >= 0);
+    uint32_t* const header = mmap(NULL, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    assert(header != MAP_FAILED);
+    header[2] = 1000000;
+    header[3] = 1u << 20;
+    header[4] = 1u << 30;
+    header[5] = 1u << 30;
+    munmap(header, 64);
+
+    ShmEvaluator* const saved = evaluator;
+    evaluator = server;
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, run_evaluator, NULL) == 0);
+    HandValue values[100];
+    assert(shm_client_evaluate(client, masks, 100, values) == 0);
+    assert(memcmp(values, expected, sizeof(values)) == 0);
+    shm_evaluator_stop(server);
+    pthread_join(thread, NULL);
+    evaluator = saved;
+
+    shm_client_detach(client);
+    shm_evaluator_destroy(server);
+
+    printf("  ✓ Served with the geometry it was created with\n");
+}
+
+int main(void) {
+    printf("\n=== Shared-Memory Ring Test Suite ===\n\n");
+
+    make_masks();
+    snprintf(segment_path, sizeof(segment_path), "/tmp/poker-shm-test-%ld", (long)getpid());
+    const ShmRingOptions options = {4, 16, 64};
+    evaluator = shm_evaluator_create(segment_path, &options);
+    assert(evaluator != NULL);
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, run_evaluator, NULL) == 0);
+
+    test_shm_single_client();
+    test_shm_shared_ring();
+    test_shm_other_process();
+    test_shm_wakeup();
+    test_shm_errors();
+
+    shm_evaluator_stop(evaluator);
+    pthread_join(thread, NULL);
+    shm_evaluator_destroy(evaluator);
+    assert(access(segment_path, F_OK) != 0);
+
+    test_shm_closed();
+    test_shm_stale();
+    test_shm_hostile_header();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "../include/poker_showdown.h"
+#include "test_helpers.h"
+
+/*
+ * Test Suite for showdown_resolve()
+ * Tests verify winners against evaluate_hand()/compare_hands(), exact
+ * splits, both odd-chip rules, folded seats and error handling
+ */
+
+void test_showdown_single_winner(void) {
+    printf("Testing showdown_resolve with one winner...\n");
+
+    const ShowdownPlayer players[3] = {
+        {mask_of("AhAd"), 0},
+        {mask_of("KhKd"), 0},
+        {mask_of("7s2c"), 0},
+    };
+    const ShowdownPot pot = {1000, 1, SHOWDOWN_ODD_CHIP_POSITION};
+    uint16_t winners = 0;
+    uint64_t shares[3];
+
+    assert(showdown_resolve(players, 3, mask_of("As9c5h3d2d"), &pot, &winners, shares) == 1);
+    assert(winners == 0x1);
+    assert(shares[0] == 1000 && shares[1] == 0 && shares[2] == 0);
+
+    /* Winners only */
+    assert(showdown_resolve(players, 3, mask_of("Ks9c5h3d2d"), NULL, &winners, NULL) == 1);
+    assert(winners == 0x2);
+
+    printf("  ✓ Best hand takes the pot\n");
+}
+
+void test_showdown_split_pots(void) {
+    printf("Testing split pots and odd chips...\n");
+
+    /* Board plays: every live seat ties */
+    const uint64_t board = mask_of("AsKsQsJsTs");
+    const ShowdownPlayer players[4] = {
+        {mask_of("2c3c"), 0},
+        {mask_of("4c5c"), 0},
+        {mask_of("6c7c"), 0},
+        {mask_of("8c9c"), 1},
+    };
+    uint16_t winners = 0;
+    uint64_t shares[4];
+
+    /* 100 three ways: 34/33/33, odd chip to the first seat from first_seat */
+    ShowdownPot pot = {100, 2, SHOWDOWN_ODD_CHIP_POSITION};
+    assert(showdown_resolve(players, 4, board, &pot, &winners, shares) == 3);
+    assert(winners == 0x7);
+    assert(shares[2] == 34 && shares[0] == 33 && shares[1] == 33 && shares[3] == 0);
+
+    /* 101 three ways from seat 1: seats 1 and 2 get the odd chips */
+    pot.amount = 101;
+    pot.first_seat = 1;
+    assert(showdown_resolve(players, 4, board, &pot, &winners, shares) == 3);
+    assert(shares[1] == 34 && shares[2] == 34 && shares[0] == 33);
+
+    /* First seat is a folded seat: the next winner in order gets the chip */
+    pot.amount = 100;
+    pot.first_seat = 3;
+    assert(showdown_resolve(players, 4, board, &pot, &winners, shares) == 3);
+    assert(shares[0] == 34 && shares[1] == 33 && shares[2] == 33);
+
+    /* High-card rule: 7c beats 5c beats 3c */
+    pot.odd_chip_rule = SHOWDOWN_ODD_CHIP_HIGH_CARD;
+    pot.first_seat = 0;
+    pot.amount = 101;
+    assert(showdown_resolve(players, 4, board, &pot, &winners, shares) == 3);
+    assert(shares[2] == 34 && shares[1] == 34 && shares[0] == 33);
+
+    /* Same rank: spades beat hearts beat diamonds beat clubs */
+    const ShowdownPlayer suited[3] = {
+        {mask_of("9h2h"), 0},
+        {mask_of("9s3h"), 0},
+        {mask_of("9d4h"), 0},
+    };
+    pot.amount = 5;
+    assert(showdown_resolve(suited, 3, board, &pot, &winners, shares) == 3);
+    assert(shares[1] == 2 && shares[0] == 2 && shares[2] == 1);
+
+    /* Every chip is always awarded */
+    for (uint64_t amount = 0; amount < 50; amount++) {
+        pot.amount = amount;
+        assert(showdown_resolve(players, 4, board, &pot, &winners, shares) == 3);
+        assert(shares[0] + shares[1] + shares[2] + shares[3] == amount);
+    }
+
+    printf("  ✓ Splits are exact and odd chips follow the rule\n");
+}
+
+void test_showdown_matches_compare_hands(void) {
+    printf("Testing showdown_resolve agrees with compare_hands on random deals...\n");
+
+    uint32_t state = 4242u;
+    for (size_t deal = 0; deal < 20000; deal++) {
+        const size_t num_players = 2 + deal % (MAX_PLAYERS - 1);
+        uint8_t cards[BOARD_SIZE + 2 * MAX_PLAYERS];
+        uint64_t used = 0;
+        for (size_t c = 0; c < BOARD_SIZE + 2 * num_players; c++) {
+            uint8_t card;
+            do {
+                state = state * 1103515245u + 12345u;
+                card = (uint8_t)((state >> 16) % DECK_SIZE);
+            } while (used & (UINT64_C(1) << card));
+            used |= UINT64_C(1) << card;
+            cards[c] = card;
+        }
+
+        uint64_t board = 0;
+        Card seven[MAX_PLAYERS][7];
+        for (size_t c = 0; c < BOARD_SIZE; c++) {
+            board |= UINT64_C(1) << cards[c];
+        }
+        ShowdownPlayer players[MAX_PLAYERS];
+        Hand hands[MAX_PLAYERS];
+        for (size_t p = 0; p < num_players; p++) {
+            const uint8_t a = cards[BOARD_SIZE + 2 * p], b = cards[BOARD_SIZE + 2 * p + 1];
+            players[p].hole = (UINT64_C(1) << a) | (UINT64_C(1) << b);
+            players[p].folded = (deal % 3 == 0 && p == 1);
+            for (size_t c = 0; c < BOARD_SIZE; c++) {
+                seven[p][c] = CARD_FROM_INDEX(cards[c]);
+            }
+            seven[p][5] = CARD_FROM_INDEX(a);
+            seven[p][6] = CARD_FROM_INDEX(b);
+            assert(evaluate_hand(seven[p], 7, &hands[p]) == 0);
+        }
+
+        /* Expected winners by pairwise comparison */
+        uint16_t expected = 0;
+        size_t best = SIZE_MAX;
+        for (size_t p = 0; p < num_players; p++) {
+            if (players[p].folded) {
+                continue;
+            }
+            const int cmp = (best == SIZE_MAX) ? 1 : compare_hands(&hands[p], &hands[best]);
+            if (cmp > 0) {
+                best = p;
+                expected = (uint16_t)(1u << p);
+            } else if (cmp == 0) {
+                expected |= (uint16_t)(1u << p);
+            }
+        }
+
+        uint16_t winners = 0;
+        const int n = showdown_resolve(players, num_players, board, NULL, &winners, NULL);
+        assert(winners == expected);
+        assert(n == __builtin_popcount(expected));
+    }
+
+    printf("  ✓ 20000 deals agree\n");
+}
+
+void test_showdown_errors(void) {
+    printf("Testing showdown_resolve error handling...\n");
+
+    ShowdownPlayer players[2] = {
+        {mask_of("AhAd"), 0},
+        {mask_of("KhKd"), 0},
+    };
+    const uint64_t board = mask_of("2c3c4c5d9s");
+    ShowdownPot pot = {10, 0, SHOWDOWN_ODD_CHIP_POSITION};
+    uint64_t shares[2];
+    uint16_t winners;
+
+    /* Everyone else folded: no board needed */
+    players[1].folded = 1;
+    assert(showdown_resolve(players, 2, 0, &pot, &winners, shares) == 1);
+    assert(winners == 0x1 && shares[0] == 10 && shares[1] == 0);
+
+    /* Folded cards are not checked for duplicates */
+    players[1].hole = mask_of("AhKd");
+    assert(showdown_resolve(players, 2, board, &pot, &winners, shares) == 1);
+
+    players[1].folded = 0;
+    poker_errno = POKER_EOK;
+    assert(showdown_resolve(players, 2, board, &pot, &winners, shares) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+    players[1].hole = mask_of("Kh2c");
+    poker_errno = POKER_EOK;
+    assert(showdown_resolve(players, 2, board, &pot, &winners, shares) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+
+    players[1].hole = mask_of("KhKdKs");
+    poker_errno = POKER_EOK;
+    assert(showdown_resolve(players, 2, board, &pot, &winners, shares) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    players[1].hole = mask_of("KhKd");
+    assert(showdown_resolve(players, 2, mask_of("2c3c"), &pot, &winners, shares) == -1);
+    assert(showdown_resolve(players, 2, mask_of("2c3c4c5c6c7c"), &pot, &winners, shares) == -1);
+    assert(showdown_resolve(NULL, 2, board, &pot, &winners, shares) == -1);
+    assert(showdown_resolve(players, 0, board, &pot, &winners, shares) == -1);
+    assert(showdown_resolve(players, MAX_PLAYERS + 1, board, &pot, &winners, shares) == -1);
+    assert(showdown_resolve(players, 2, board, &pot, &winners, NULL) == -1);
+    pot.first_seat = 2;
+    assert(showdown_resolve(players, 2, board, &pot, &winners, shares) == -1);
+    pot.first_seat = 0;
+    pot.odd_chip_rule = 7;
+    assert(showdown_resolve(players, 2, board, &pot, &winners, shares) == -1);
+
+    players[0].folded = 1;
+    players[1].folded = 1;
+    poker_errno = POKER_EOK;
+    assert(showdown_resolve(players, 2, board, NULL, &winners, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Showdown Test Suite ===\n\n");
+
+    test_showdown_single_winner();
+    test_showdown_split_pots();
+    test_showdown_matches_compare_hands();
+    test_showdown_errors();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
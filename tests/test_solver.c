@@ -0,0 +1,424 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/poker_solver.h"
+#include "test_helpers.h"
+
+/*
+ * Test Suite for the river subgame solver
+ * Tests verify betting tree construction, convergence to the known
+ * equilibrium of a polarized-vs-bluff-catcher spot, best responses to
+ * fixed strategies, exploitability, normalized strategies, thread-count
+ * independence and error handling
+ */
+
+/* Static helper: combo index of a two-card string */
+static size_t combo_of(const char* const text) {
+    const int combo = hole_combo_index(mask_of(text));
+    assert(combo >= 0);
+    return (size_t)combo;
+}
+
+/* Static helper: config with one bet and raise menu for both players */
+static RiverConfig standard_config(void) {
+    RiverConfig config;
+    memset(&config, 0, sizeof(config));
+    config.board = mask_of("Ah7c7d2s9h");
+    config.pot = 10.0;
+    config.stack = 50.0;
+    for (int p = 0; p < 2; p++) {
+        config.bet_sizes[p][0] = 0.5;
+        config.bet_sizes[p][1] = 1.0;
+        config.num_bet_sizes[p] = 2;
+        config.raise_sizes[p][0] = 1.0;
+        config.num_raise_sizes[p] = 1;
+    }
+    config.max_raises = 2;
+    config.all_in = 1;
+    return config;
+}
+
+/* Static helper: check tree invariants below a node, returns nodes visited */
+static size_t check_subtree(const RiverSolver* const solver, const RiverConfig* const config,
+                            const size_t index, int* const seen) {
+    RiverNode node;
+    assert(river_solver_node(solver, index, &node) == 0);
+    assert(!seen[index]);
+    seen[index] = 1;
+    assert(node.bets[0] <= config->stack && node.bets[1] <= config->stack);
+    if (node.player < 0) {
+        assert(node.num_actions == 0);
+        if (node.folded < 0) {
+            assert(node.bets[0] == node.bets[1]);
+        } else {
+            assert(node.bets[node.folded] < node.bets[1 - node.folded]);
+        }
+        return 1;
+    }
+
+    size_t visited = 1;
+    double last = -1.0;
+    for (size_t a = 0; a < node.num_actions; a++) {
+        assert(node.amounts[a] <= config->stack);
+        if (node.actions[a] == RIVER_ACTION_BET) {
+            assert(node.amounts[a] > last);
+            assert(node.amounts[a] > node.bets[1 - node.player]);
+            last = node.amounts[a];
+        }
+        RiverNode child;
+        assert(river_solver_node(solver, node.children[a], &child) == 0);
+        assert(child.bets[node.player] == node.amounts[a]);
+        visited += check_subtree(solver, config, node.children[a], seen);
+    }
+    return visited;
+}
+
+void test_river_tree(void) {
+    printf("Testing river betting tree...\n");
+
+    const RiverConfig config = standard_config();
+    double range[HOLE_COMBOS];
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        range[c] = 1.0;
+    }
+    RiverSolver* const solver = river_solver_create(&config, range, range);
+    assert(solver != NULL);
+
+    const size_t n = river_solver_num_nodes(solver);
+    int* const seen = calloc(n, sizeof(int));
+    assert(seen != NULL);
+    assert(check_subtree(solver, &config, 0, seen) == n);
+    free(seen);
+
+    /* Root: check, bet 5, bet 10, all-in 50 */
+    RiverNode root;
+    assert(river_solver_node(solver, 0, &root) == 0);
+    assert(root.player == RIVER_OOP && root.num_actions == 4);
+    assert(root.actions[0] == RIVER_ACTION_CHECK);
+    assert(root.amounts[1] == 5.0 && root.amounts[2] == 10.0 && root.amounts[3] == 50.0);
+
+    /* Facing a 5 bet: fold, call, raise to 5 + 1.0 * 20 = 25, all-in */
+    RiverNode facing;
+    assert(river_solver_node(solver, root.children[1], &facing) == 0);
+    assert(facing.player == RIVER_IP && facing.num_actions == 4);
+    assert(facing.actions[0] == RIVER_ACTION_FOLD && facing.actions[1] == RIVER_ACTION_CALL);
+    assert(facing.amounts[1] == 5.0 && facing.amounts[2] == 25.0 && facing.amounts[3] == 50.0);
+
+    /* Facing all-in: fold or call only */
+    RiverNode shove;
+    assert(river_solver_node(solver, root.children[3], &shove) == 0);
+    assert(shove.num_actions == 2);
+
+    /* Check then check is a showdown */
+    RiverNode checked;
+    RiverNode showdown;
+    assert(river_solver_node(solver, root.children[0], &checked) == 0);
+    assert(checked.player == RIVER_IP && checked.actions[0] == RIVER_ACTION_CHECK);
+    assert(river_solver_node(solver, checked.children[0], &showdown) == 0);
+    assert(showdown.player == -1 && showdown.folded == -1 && showdown.bets[0] == 0.0);
+
+    /* Facing the raise to 25: the 1.0 re-raise clamps to all-in and merges */
+    RiverNode raised;
+    assert(river_solver_node(solver, facing.children[2], &raised) == 0);
+    assert(raised.player == RIVER_OOP && raised.num_actions == 3);
+    assert(raised.amounts[2] == 50.0);
+
+    river_solver_destroy(solver);
+
+    /* No raises allowed: fold or call against a bet */
+    RiverConfig capped_config = standard_config();
+    capped_config.max_raises = 0;
+    RiverSolver* const capped = river_solver_create(&capped_config, range, range);
+    assert(capped != NULL);
+    assert(river_solver_node(capped, 0, &root) == 0);
+    assert(river_solver_node(capped, root.children[1], &facing) == 0);
+    assert(facing.num_actions == 2 && facing.actions[1] == RIVER_ACTION_CALL);
+    river_solver_destroy(capped);
+
+    /* No stack behind: check, check */
+    RiverConfig short_config = standard_config();
+    short_config.stack = 0.0;
+    RiverSolver* const flat = river_solver_create(&short_config, range, range);
+    assert(flat != NULL && river_solver_num_nodes(flat) == 3);
+    river_solver_destroy(flat);
+
+    printf("✓ River betting tree tests passed\n");
+}
+
+/*
+ * Static helper: OOP holds the nuts (3 combos of KK) or air (3 combos of
+ * 65) and may check or bet the pot; IP holds a bluff-catcher and may only
+ * call or fold
+ */
+static const char* const polar_nuts[] = {"KhKd", "KhKc", "KdKc"};
+static const char* const polar_air[] = {"6h5h", "6d5d", "6c5c"};
+
+static RiverSolver* polarized_solver(void) {
+    RiverConfig config;
+    memset(&config, 0, sizeof(config));
+    config.board = mask_of("KsQd7h4c2s");
+    config.pot = 10.0;
+    config.stack = 10.0;
+    config.bet_sizes[RIVER_OOP][0] = 1.0;
+    config.num_bet_sizes[RIVER_OOP] = 1;
+
+    double oop[HOLE_COMBOS] = {0};
+    double ip[HOLE_COMBOS] = {0};
+    for (size_t i = 0; i < 3; i++) {
+        oop[combo_of(polar_nuts[i])] = 1.0;
+        oop[combo_of(polar_air[i])] = 1.0;
+    }
+    ip[combo_of("QcJc")] = 1.0;
+    return river_solver_create(&config, oop, ip);
+}
+
+void test_river_polarized(void) {
+    printf("Testing river equilibrium (polarized vs bluff-catcher)...\n");
+
+    /*
+     * Equilibrium: OOP bets all nuts and 1.5 air combos (one bluff per two
+     * value hands) and IP calls half the time
+     */
+    RiverSolver* const solver = polarized_solver();
+    assert(solver != NULL);
+    assert(river_solver_run(solver, 2000, 1) == 0);
+
+    RiverNode root;
+    assert(river_solver_node(solver, 0, &root) == 0);
+    assert(root.num_actions == 2 && root.actions[1] == RIVER_ACTION_BET);
+
+    double* const strategy = malloc(RIVER_MAX_ACTIONS * HOLE_COMBOS * sizeof(double));
+    assert(strategy != NULL);
+    assert(river_solver_strategy(solver, 0, strategy) == 0);
+    double bluffs = 0.0;
+    for (size_t i = 0; i < 3; i++) {
+        assert(strategy[HOLE_COMBOS + combo_of(polar_nuts[i])] > 0.99);
+        bluffs += strategy[HOLE_COMBOS + combo_of(polar_air[i])];
+    }
+    assert(fabs(bluffs - 1.5) < 0.05);
+
+    assert(river_solver_strategy(solver, root.children[1], strategy) == 0);
+    assert(fabs(strategy[HOLE_COMBOS + combo_of("QcJc")] - 0.5) < 0.03);
+
+    /* Game value 2.5 for OOP: nuts win 10 on average, air loses 5 */
+    double value = 0.0;
+    double exploitability = 1.0;
+    assert(river_solver_best_response(solver, RIVER_OOP, 1, &value, NULL) == 0);
+    assert(fabs(value - 2.5) < 0.05);
+    assert(river_solver_best_response(solver, RIVER_IP, 1, &value, NULL) == 0);
+    assert(fabs(value + 2.5) < 0.05);
+    assert(river_solver_exploitability(solver, 1, &exploitability) == 0);
+    assert(exploitability >= 0.0 && exploitability < 0.05);
+
+    free(strategy);
+    river_solver_destroy(solver);
+    printf("✓ River equilibrium tests passed\n");
+}
+
+void test_river_best_response(void) {
+    printf("Testing river best response against fixed strategies...\n");
+
+    RiverSolver* const solver = polarized_solver();
+    assert(solver != NULL);
+    RiverNode root;
+    assert(river_solver_node(solver, 0, &root) == 0);
+
+    /* OOP bets only the nuts, IP always calls */
+    double* const strategy = calloc(RIVER_MAX_ACTIONS * HOLE_COMBOS, sizeof(double));
+    assert(strategy != NULL);
+    for (size_t i = 0; i < 3; i++) {
+        strategy[HOLE_COMBOS + combo_of(polar_nuts[i])] = 1.0;
+        strategy[combo_of(polar_air[i])] = 1.0;
+    }
+    assert(river_solver_set_strategy(solver, 0, strategy) == 0);
+    memset(strategy, 0, RIVER_MAX_ACTIONS * HOLE_COMBOS * sizeof(double));
+    strategy[HOLE_COMBOS + combo_of("QcJc")] = 2.0;    /* normalized per combo */
+    assert(river_solver_set_strategy(solver, root.children[1], strategy) == 0);
+
+    /* OOP responds by betting the nuts (+15) and checking air (-5) */
+    double values[HOLE_COMBOS];
+    double value = 0.0;
+    assert(river_solver_best_response(solver, RIVER_OOP, 1, &value, values) == 0);
+    assert(fabs(value - 5.0) < 1e-9);
+    for (size_t i = 0; i < 3; i++) {
+        assert(fabs(values[combo_of(polar_nuts[i])] - 15.0) < 1e-9);
+        assert(fabs(values[combo_of(polar_air[i])] + 5.0) < 1e-9);
+    }
+    assert(values[combo_of("Ks3c")] == 0.0);     /* blocked by the board */
+
+    /* IP responds by folding to bets: -5 against the nuts, +5 against air */
+    assert(river_solver_best_response(solver, RIVER_IP, 1, &value, values) == 0);
+    assert(fabs(value) < 1e-9 && fabs(values[combo_of("QcJc")]) < 1e-9);
+
+    double exploitability = 0.0;
+    assert(river_solver_exploitability(solver, 1, &exploitability) == 0);
+    assert(fabs(exploitability - 2.5) < 1e-9);
+
+    free(strategy);
+    river_solver_destroy(solver);
+    printf("✓ River best response tests passed\n");
+}
+
+void test_river_threads(void) {
+    printf("Testing river solver strategies and threads...\n");
+
+    const RiverConfig config = standard_config();
+    double oop[HOLE_COMBOS];
+    double ip[HOLE_COMBOS];
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        oop[c] = (double)(c % 7) / 6.0;
+        ip[c] = (double)(c % 5 + 1) / 5.0;
+    }
+
+    RiverSolver* const single = river_solver_create(&config, oop, ip);
+    RiverSolver* const multi = river_solver_create(&config, oop, ip);
+    assert(single != NULL && multi != NULL);
+    assert(river_solver_run(single, 10, 1) == 0);
+    assert(river_solver_run(single, 10, 1) == 0);
+    assert(river_solver_run(multi, 20, 3) == 0);
+
+    const size_t size = RIVER_MAX_ACTIONS * HOLE_COMBOS * sizeof(double);
+    double* const a = malloc(size);
+    double* const b = malloc(size);
+    assert(a != NULL && b != NULL);
+    const uint64_t board = config.board;
+    for (size_t n = 0; n < river_solver_num_nodes(single); n++) {
+        RiverNode node;
+        assert(river_solver_node(single, n, &node) == 0);
+        if (node.player < 0) {
+            assert(river_solver_strategy(single, n, a) == -1 && poker_errno == POKER_EINVAL);
+            continue;
+        }
+        assert(river_solver_strategy(single, n, a) == 0);
+        assert(river_solver_strategy(multi, n, b) == 0);
+        assert(memcmp(a, b, node.num_actions * HOLE_COMBOS * sizeof(double)) == 0);
+        for (size_t c = 0; c < HOLE_COMBOS; c++) {
+            double total = 0.0;
+            for (size_t act = 0; act < node.num_actions; act++) {
+                assert(a[act * HOLE_COMBOS + c] >= 0.0);
+                total += a[act * HOLE_COMBOS + c];
+            }
+            assert(fabs(total - 1.0) < 1e-9);
+            /* Board-blocked combos never act: uniform */
+            if (hole_combo_mask(c) & board) {
+                assert(fabs(a[c] - 1.0 / (double)node.num_actions) < 1e-12);
+            }
+        }
+    }
+    free(a);
+    free(b);
+
+    /* Exploitability falls with iterations and does not depend on threads */
+    RiverSolver* const fresh = river_solver_create(&config, oop, ip);
+    assert(fresh != NULL);
+    double before = 0.0, after = 0.0, threaded = 0.0;
+    assert(river_solver_exploitability(fresh, 1, &before) == 0);
+    assert(river_solver_exploitability(single, 1, &after) == 0);
+    assert(river_solver_exploitability(single, 3, &threaded) == 0);
+    assert(before > 0.0 && after > 0.0 && after < 0.25 * before);
+    assert(threaded == after);
+    double oop_values[HOLE_COMBOS], oop_threaded[HOLE_COMBOS];
+    double value = 0.0, value_threaded = 0.0;
+    assert(river_solver_best_response(single, RIVER_OOP, 1, &value, oop_values) == 0);
+    assert(river_solver_best_response(single, RIVER_OOP, 3, &value_threaded, oop_threaded) == 0);
+    assert(value == value_threaded && memcmp(oop_values, oop_threaded, sizeof(oop_values)) == 0);
+    river_solver_destroy(fresh);
+
+    river_solver_destroy(single);
+    river_solver_destroy(multi);
+    printf("✓ River solver strategy and thread tests passed\n");
+}
+
+void test_river_errors(void) {
+    printf("Testing river solver error handling...\n");
+
+    double range[HOLE_COMBOS];
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        range[c] = 1.0;
+    }
+    const RiverConfig good = standard_config();
+
+    assert(river_solver_create(NULL, range, range) == NULL && poker_errno == POKER_EINVAL);
+    assert(river_solver_create(&good, NULL, range) == NULL && poker_errno == POKER_EINVAL);
+    assert(river_solver_create(&good, range, NULL) == NULL && poker_errno == POKER_EINVAL);
+
+    RiverConfig config = good;
+    config.board = mask_of("Ah7c7d2s");
+    assert(river_solver_create(&config, range, range) == NULL && poker_errno == POKER_EINVAL);
+    config = good;
+    config.pot = 0.0;
+    assert(river_solver_create(&config, range, range) == NULL && poker_errno == POKER_EINVAL);
+    config = good;
+    config.stack = -1.0;
+    assert(river_solver_create(&config, range, range) == NULL && poker_errno == POKER_EINVAL);
+    config = good;
+    config.bet_sizes[RIVER_IP][1] = 0.0;
+    assert(river_solver_create(&config, range, range) == NULL && poker_errno == POKER_EINVAL);
+    config = good;
+    config.num_raise_sizes[RIVER_OOP] = RIVER_MAX_SIZES + 1;
+    assert(river_solver_create(&config, range, range) == NULL && poker_errno == POKER_EINVAL);
+
+    double bad[HOLE_COMBOS];
+    memcpy(bad, range, sizeof(bad));
+    bad[100] = -1.0;
+    assert(river_solver_create(&good, bad, range) == NULL && poker_errno == POKER_EINVAL);
+
+    /* Only board-blocked combos: empty range */
+    double blocked[HOLE_COMBOS] = {0};
+    blocked[combo_of("Ah7c")] = 1.0;
+    assert(river_solver_create(&good, range, blocked) == NULL && poker_errno == POKER_EINVAL);
+
+    RiverSolver* const solver = river_solver_create(&good, range, range);
+    assert(solver != NULL);
+    RiverNode node;
+    double strategy[RIVER_MAX_ACTIONS * HOLE_COMBOS];
+    const size_t n = river_solver_num_nodes(solver);
+    assert(river_solver_node(solver, n, &node) == -1 && poker_errno == POKER_EINVAL);
+    assert(river_solver_node(solver, 0, NULL) == -1 && poker_errno == POKER_EINVAL);
+    assert(river_solver_strategy(solver, n, strategy) == -1 && poker_errno == POKER_EINVAL);
+    assert(river_solver_strategy(solver, 0, NULL) == -1 && poker_errno == POKER_EINVAL);
+    assert(river_solver_run(NULL, 1, 1) == -1 && poker_errno == POKER_EINVAL);
+    assert(river_solver_num_nodes(NULL) == 0);
+
+    double value = 0.0;
+    assert(river_solver_best_response(NULL, RIVER_OOP, 1, &value, NULL) == -1 &&
+           poker_errno == POKER_EINVAL);
+    assert(river_solver_best_response(solver, 2, 1, &value, NULL) == -1 &&
+           poker_errno == POKER_EINVAL);
+    assert(river_solver_best_response(solver, RIVER_IP, 1, NULL, NULL) == -1 &&
+           poker_errno == POKER_EINVAL);
+    assert(river_solver_exploitability(NULL, 1, &value) == -1 && poker_errno == POKER_EINVAL);
+    assert(river_solver_exploitability(solver, 1, NULL) == -1 && poker_errno == POKER_EINVAL);
+
+    RiverNode root;
+    assert(river_solver_node(solver, 0, &root) == 0);
+    for (size_t i = 0; i < root.num_actions * HOLE_COMBOS; i++) {
+        strategy[i] = 1.0;
+    }
+    strategy[7] = -0.5;
+    assert(river_solver_set_strategy(solver, 0, strategy) == -1 && poker_errno == POKER_EINVAL);
+    strategy[7] = 1.0;
+    assert(river_solver_set_strategy(solver, n, strategy) == -1 && poker_errno == POKER_EINVAL);
+    assert(river_solver_set_strategy(solver, root.children[0], NULL) == -1 &&
+           poker_errno == POKER_EINVAL);
+    assert(river_solver_set_strategy(solver, 0, strategy) == 0);
+    river_solver_destroy(solver);
+    river_solver_destroy(NULL);
+
+    printf("✓ River solver error handling tests passed\n");
+}
+
+int main(void) {
+    printf("Running river solver tests...\n\n");
+
+    test_river_tree();
+    test_river_polarized();
+    test_river_best_response();
+    test_river_threads();
+    test_river_errors();
+
+    printf("\n✓ All river solver tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,413 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/poker_strength.h"
+#include "../include/poker_equity.h"
+#include "test_helpers.h"
+
+/*
+ * Test Suite for hand strength (HS, EHS, EHS²) and potential (PPot, NPot)
+ * Tests verify combo indexing, river HS against pairwise comparison, the
+ * ranked all-hands path against the single-hand path, EHS against exact
+ * equity, weighted ranges, potential against direct enumeration, outs
+ * against per-card evaluation and error handling
+ */
+
+static int close_to(const double a, const double b) {
+    return fabs(a - b) < 1e-9;
+}
+
+void test_hole_combo_index(void) {
+    printf("Testing hole_combo_index...\n");
+
+    char* const seen = calloc(HOLE_COMBOS, 1);
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        const uint64_t hole = hole_combo_mask(c);
+        assert(__builtin_popcountll(hole) == 2);
+        assert(hole_combo_index(hole) == (int)c);
+        assert(!seen[c]);
+        seen[c] = 1;
+    }
+    free(seen);
+
+    assert(hole_combo_index(UINT64_C(0x3)) == 0);
+    assert(hole_combo_index(UINT64_C(0x3) << 50) == HOLE_COMBOS - 1);
+    assert(hole_combo_index(0) == -1);
+    assert(hole_combo_index(mask_of("AsKsQs")) == -1);
+    assert(hole_combo_index(UINT64_C(1) << 52 | 1) == -1);
+    assert(hole_combo_mask(HOLE_COMBOS) == 0);
+
+    printf("  ✓ %d combos map one-to-one\n", HOLE_COMBOS);
+}
+
+void test_hand_strength_river(void) {
+    printf("Testing river HS...\n");
+
+    const uint64_t board = mask_of("Ah7c7d2s9h");
+    const uint64_t hero = mask_of("AcKd");
+    const HandValue value = evaluate_mask(hero | board);
+    size_t wins = 0;
+    size_t ties = 0;
+    size_t total = 0;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        const uint64_t opp = hole_combo_mask(c);
+        if (opp & (hero | board)) {
+            continue;
+        }
+        const HandValue other = evaluate_mask(opp | board);
+        wins += (value > other);
+        ties += (value == other);
+        total++;
+    }
+    assert(total == 990);
+
+    HandStrength hs;
+    assert(hand_strength(hero, board, NULL, &hs) == 0);
+    assert(close_to(hs.hs, (wins + ties / 2.0) / total));
+    assert(close_to(hs.ehs, hs.hs) && close_to(hs.ehs2, hs.hs * hs.hs));
+
+    /* The nuts on a board with no possible tie */
+    assert(hand_strength(mask_of("7h7s"), board, NULL, &hs) == 0);
+    assert(close_to(hs.hs, 1.0));
+
+    printf("  ✓ River HS matches pairwise comparison\n");
+}
+
+void test_hand_strength_all(void) {
+    printf("Testing hand_strength_all...\n");
+
+    const char* const boards[] = {"Ah7c7d2s9h", "TsJsQs2d", "5h6h7c"};
+    HandStrength* const all = malloc(HOLE_COMBOS * sizeof(HandStrength));
+    double* const weights = malloc(HOLE_COMBOS * sizeof(double));
+    uint64_t rng = 0x1234;
+
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        weights[c] = (rng >> 60) < 4 ? 0.0 : (double)(rng >> 58) / 64.0;
+    }
+
+    for (size_t i = 0; i < 3; i++) {
+        const uint64_t board = mask_of(boards[i]);
+        const double* const range = (i == 1) ? weights : NULL;
+        assert(hand_strength_all(board, range, all) == 0);
+
+        size_t checked = 0;
+        for (size_t c = (i * 7) % 31; c < HOLE_COMBOS; c += 31) {
+            const uint64_t hole = hole_combo_mask(c);
+            if (hole & board) {
+                assert(all[c].hs == 0.0 && all[c].ehs == 0.0 && all[c].ehs2 == 0.0);
+                continue;
+            }
+            HandStrength one;
+            assert(hand_strength(hole, board, range, &one) == 0);
+            assert(close_to(one.hs, all[c].hs));
+            assert(close_to(one.ehs, all[c].ehs));
+            assert(close_to(one.ehs2, all[c].ehs2));
+            assert(all[c].ehs2 <= all[c].ehs + 1e-12);
+            assert(all[c].ehs * all[c].ehs <= all[c].ehs2 + 1e-12);
+            checked++;
+        }
+        assert(checked > 30);
+    }
+
+    free(weights);
+    free(all);
+    printf("  ✓ Ranked and single-hand paths agree on flop, turn and river\n");
+}
+
+void test_hand_strength_equity(void) {
+    printf("Testing EHS against exact equity...\n");
+
+    const uint64_t board = mask_of("Kd8s3h2c");
+    const uint64_t hero = mask_of("QhJh");
+    double equity = 0.0;
+    size_t opponents = 0;
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        const uint64_t opp = hole_combo_mask(c);
+        if (opp & (hero | board)) {
+            continue;
+        }
+        const uint64_t holes[2] = {hero, opp};
+        EquityResult result;
+        assert(calculate_equity(holes, 2, board, 0, 0, 0, &result) == 0);
+        equity += result.equity[0];
+        opponents++;
+    }
+    equity /= opponents;
+
+    HandStrength hs;
+    assert(hand_strength(hero, board, NULL, &hs) == 0);
+    assert(close_to(hs.ehs, equity));
+    assert(hs.ehs > hs.hs);
+
+    printf("  ✓ EHS = %.4f equals equity against a random hand\n", hs.ehs);
+}
+
+void test_hand_strength_ranges(void) {
+    printf("Testing weighted ranges...\n");
+
+    const uint64_t board = mask_of("Ah7c7d2s9h");
+    const uint64_t hero = mask_of("AcKd");
+    double* const weights = calloc(HOLE_COMBOS, sizeof(double));
+    HandStrength hs;
+
+    /* Range of only sevens: hero always loses */
+    weights[hole_combo_index(mask_of("7h7s"))] = 1.0;
+    weights[hole_combo_index(mask_of("7sKh"))] = 3.0;
+    assert(hand_strength(hero, board, weights, &hs) == 0);
+    assert(close_to(hs.hs, 0.0));
+
+    /* One losing combo, one beaten combo of triple the weight */
+    weights[hole_combo_index(mask_of("7sKh"))] = 0.0;
+    weights[hole_combo_index(mask_of("QcQd"))] = 3.0;
+    assert(hand_strength(hero, board, weights, &hs) == 0);
+    assert(close_to(hs.hs, 0.75));
+
+    /* Every combo in the range is blocked: all values are 0 */
+    memset(weights, 0, HOLE_COMBOS * sizeof(double));
+    weights[hole_combo_index(mask_of("AsAh"))] = 1.0;
+    assert(hand_strength(hero, board, weights, &hs) == 0);
+    assert(hs.hs == 0.0 && hs.ehs == 0.0 && hs.ehs2 == 0.0);
+
+    free(weights);
+    printf("  ✓ Range weights and card removal applied\n");
+}
+
+/* Static helper: state transition counts by direct enumeration */
+static void count_states(const uint64_t hole, const uint64_t board, double states[3][3]) {
+    memset(states, 0, 9 * sizeof(double));
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        const uint64_t opp = hole_combo_mask(c);
+        if (opp & (hole | board)) {
+            continue;
+        }
+        const HandValue hero_now = evaluate_mask(hole | board);
+        const HandValue opp_now = evaluate_mask(opp | board);
+        const int now = (hero_now > opp_now) ? 0 : (hero_now == opp_now) ? 1 : 2;
+        for (size_t r = 0; r < HOLE_COMBOS; r++) {
+            const uint64_t runout = hole_combo_mask(r);
+            const uint64_t river = board | runout;
+            if (__builtin_popcountll(river) != BOARD_SIZE || (runout & (hole | board | opp))) {
+                continue;
+            }
+            const HandValue hero = evaluate_mask(hole | river);
+            const HandValue other = evaluate_mask(opp | river);
+            states[now][(hero > other) ? 0 : (hero == other) ? 1 : 2] += 1.0;
+        }
+        if (__builtin_popcountll(board) == BOARD_SIZE - 1) {
+            for (unsigned card = 0; card < DECK_SIZE; card++) {
+                const uint64_t runout = UINT64_C(1) << card;
+                if (runout & (hole | board | opp)) {
+                    continue;
+                }
+                const HandValue hero = evaluate_mask(hole | board | runout);
+                const HandValue other = evaluate_mask(opp | board | runout);
+                states[now][(hero > other) ? 0 : (hero == other) ? 1 : 2] += 1.0;
+            }
+        }
+    }
+}
+
+void test_hand_potential(void) {
+    printf("Testing hand_potential...\n");
+
+    /* Flush draw on the flop, one-card lookahead on the turn */
+    const char* const cases[][2] = {{"Ah5h", "Kh9h2c"}, {"QsJs", "Ts9d2h3c"}};
+    for (size_t i = 0; i < 2; i++) {
+        const uint64_t hole = mask_of(cases[i][0]);
+        const uint64_t board = mask_of(cases[i][1]);
+        double expected[3][3];
+        count_states(hole, board, expected);
+
+        HandPotential one;
+        HandPotential many;
+        assert(hand_potential(hole, board, NULL, 1, &one) == 0);
+        assert(hand_potential(hole, board, NULL, 3, &many) == 0);
+        for (size_t a = 0; a < 3; a++) {
+            for (size_t b = 0; b < 3; b++) {
+                assert(one.states[a][b] == expected[a][b]);
+                assert(many.states[a][b] == expected[a][b]);
+            }
+        }
+        assert(one.ppot == many.ppot && one.npot == many.npot);
+
+        const double (*hp)[3] = expected;
+        const double behind = hp[2][0] + hp[2][1] + hp[2][2];
+        const double tied = hp[1][0] + hp[1][1] + hp[1][2];
+        const double ahead = hp[0][0] + hp[0][1] + hp[0][2];
+        assert(close_to(one.ppot, (hp[2][0] + hp[2][1] / 2 + hp[1][0] / 2) / (behind + tied / 2)));
+        assert(close_to(one.npot, (hp[0][2] + hp[1][2] / 2 + hp[0][1] / 2) / (ahead + tied / 2)));
+
+        /* Against a uniform range the river column is EHS */
+        HandStrength hs;
+        assert(hand_strength(hole, board, NULL, &hs) == 0);
+        const double river_ahead = hp[0][0] + hp[1][0] + hp[2][0];
+        const double river_tied = hp[0][1] + hp[1][1] + hp[2][1];
+        assert(close_to(one.hs, hs.hs));
+        assert(close_to((river_ahead + river_tied / 2) / (behind + tied + ahead), hs.ehs));
+        assert(one.ppot > 0.0 && one.npot > 0.0);
+        printf("  %s on %s: HS %.3f PPot %.3f NPot %.3f\n",
+               cases[i][0], cases[i][1], one.hs, one.ppot, one.npot);
+    }
+
+    /* Quads on the flop are never behind: nothing to gain */
+    HandPotential nuts;
+    assert(hand_potential(mask_of("AhAd"), mask_of("AsAc2d"), NULL, 0, &nuts) == 0);
+    assert(nuts.ppot == 0.0 && nuts.hs > 0.99);
+
+    /* A range of one combo that is ahead now */
+    double* const weights = calloc(HOLE_COMBOS, sizeof(double));
+    weights[hole_combo_index(mask_of("KdKc"))] = 2.0;
+    HandPotential range;
+    assert(hand_potential(mask_of("Ah5h"), mask_of("Kh9h2c"), weights, 2, &range) == 0);
+    assert(range.hs == 0.0 && range.npot == 0.0 && range.ppot > 0.0);
+    assert(range.states[POTENTIAL_BEHIND][POTENTIAL_AHEAD] > 0.0);
+    assert(range.states[POTENTIAL_AHEAD][POTENTIAL_AHEAD] == 0.0);
+    free(weights);
+
+    printf("  ✓ Matches direct enumeration on 1 and 3 threads\n");
+}
+
+void test_compute_outs(void) {
+    printf("Testing compute_outs...\n");
+
+    /* Nut flush draw against a set: eight clean hearts, 2h fills the set up */
+    const uint64_t hole = mask_of("AhKh");
+    const uint64_t board = mask_of("Qh7h2c");
+    const uint64_t set = mask_of("QsQd");
+    HandOuts outs;
+    assert(compute_outs(hole, board, &set, 1, &outs) == 0);
+    assert(__builtin_popcountll(outs.ahead) == 8 && outs.tied == 0);
+    assert(outs.ahead == (mask_of("3h4h5h6h8h9hThJh")));
+    assert(outs.behind & mask_of("2h"));
+    assert((outs.ahead | outs.behind) == (~(hole | board | set) & ((UINT64_C(1) << DECK_SIZE) - 1)));
+
+    /* Three opponents on the turn against per-card evaluation */
+    const uint64_t turn = mask_of("9c8d2s5h");
+    const uint64_t hero = mask_of("TcJc");
+    const uint64_t opponents[3] = {mask_of("9h9d"), mask_of("TdJd"), mask_of("AcKc")};
+    const uint64_t seen = hero | turn | opponents[0] | opponents[1] | opponents[2];
+    const HandCategory now = HAND_VALUE_CATEGORY(evaluate_mask(hero | turn));
+    assert(compute_outs(hero, turn, opponents, 3, &outs) == 0);
+    size_t unseen = 0;
+    for (unsigned card = 0; card < DECK_SIZE; card++) {
+        const uint64_t bit = UINT64_C(1) << card;
+        if (seen & bit) {
+            assert(outs.values[card] == 0 && outs.share[card] == 0.0);
+            assert(!((outs.ahead | outs.tied | outs.behind | outs.improves) & bit));
+            continue;
+        }
+        unseen++;
+        const HandValue value = evaluate_mask(hero | turn | bit);
+        HandValue best = 0;
+        size_t holding = 0;
+        for (size_t p = 0; p < 3; p++) {
+            const HandValue other = evaluate_mask(opponents[p] | turn | bit);
+            holding = (other > best) ? 1 : holding + (other == best);
+            best = (other > best) ? other : best;
+        }
+        assert(outs.values[card] == value);
+        assert(!!(outs.improves & bit) == (HAND_VALUE_CATEGORY(value) > now));
+        if (value > best) {
+            assert((outs.ahead & bit) && outs.share[card] == 1.0);
+        } else if (value == best) {
+            assert((outs.tied & bit) && close_to(outs.share[card], 1.0 / (holding + 1)));
+        } else {
+            assert((outs.behind & bit) && outs.share[card] == 0.0);
+        }
+    }
+    /* Every straight card is shared with the same draw; nothing gets past the set otherwise */
+    assert(unseen == 40 && outs.ahead == 0 && outs.tied == mask_of("QhQdQcQs7h7d7c7s"));
+
+    /* Against a range: share is HS on the next street */
+    double* const weights = malloc(HOLE_COMBOS * sizeof(double));
+    for (size_t c = 0; c < HOLE_COMBOS; c++) {
+        weights[c] = (double)(c % 5);
+    }
+    assert(compute_outs_range(hole, board, weights, &outs) == 0);
+    for (unsigned card = 0; card < DECK_SIZE; card++) {
+        const uint64_t bit = UINT64_C(1) << card;
+        if ((hole | board) & bit) {
+            continue;
+        }
+        HandStrength hs;
+        assert(hand_strength(hole, board | bit, weights, &hs) == 0);
+        assert(close_to(outs.share[card], hs.hs));
+        assert(!!(outs.ahead & bit) == (hs.hs > 0.5));
+    }
+    free(weights);
+
+    printf("  ✓ Per-card outcomes match direct evaluation\n");
+}
+
+void test_hand_strength_errors(void) {
+    printf("Testing hand strength error handling...\n");
+
+    const uint64_t board = mask_of("Ah7c7d");
+    HandStrength hs;
+    HandStrength* const all = malloc(HOLE_COMBOS * sizeof(HandStrength));
+    double* const weights = calloc(HOLE_COMBOS, sizeof(double));
+
+    poker_errno = POKER_EOK;
+    assert(hand_strength(mask_of("AcKd"), mask_of("Ah7c"), NULL, &hs) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(hand_strength(mask_of("AcKdQd"), board, NULL, &hs) == -1);
+    assert(hand_strength(mask_of("AcKd"), board, NULL, NULL) == -1);
+    assert(hand_strength_all(mask_of("Ah7c7d2s9hTs"), NULL, all) == -1);
+    assert(hand_strength_all(board, NULL, NULL) == -1);
+    weights[5] = -1.0;
+    assert(hand_strength_all(board, weights, all) == -1);
+    assert(poker_errno == POKER_EINVAL);
+
+    poker_errno = POKER_EOK;
+    assert(hand_strength(mask_of("AhKd"), board, NULL, &hs) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+
+    HandPotential potential;
+    poker_errno = POKER_EOK;
+    assert(hand_potential(mask_of("AcKd"), mask_of("Ah7c7d2s9h"), NULL, 1, &potential) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(hand_potential(mask_of("AcKd"), board, weights, 1, &potential) == -1);
+    assert(hand_potential(mask_of("AcKd"), board, NULL, 1, NULL) == -1);
+    assert(hand_potential(mask_of("AhKd"), board, NULL, 1, &potential) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+
+    HandOuts outs;
+    const uint64_t opponent = mask_of("QsQd");
+    poker_errno = POKER_EOK;
+    assert(compute_outs(mask_of("AcKd"), board, NULL, 1, &outs) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    assert(compute_outs(mask_of("AcKd"), board, &opponent, 0, &outs) == -1);
+    assert(compute_outs(mask_of("AcKd"), mask_of("Ah7c7d2s9h"), &opponent, 1, &outs) == -1);
+    assert(compute_outs_range(mask_of("AcKd"), board, weights, &outs) == -1);
+    assert(compute_outs_range(mask_of("AcKd"), board, NULL, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    poker_errno = POKER_EOK;
+    assert(compute_outs(mask_of("AcQd"), board, &opponent, 1, &outs) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+    poker_errno = POKER_EOK;
+    assert(compute_outs_range(mask_of("7cKd"), board, NULL, &outs) == -1);
+    assert(poker_errno == POKER_EDUPLICATE);
+
+    free(weights);
+    free(all);
+    printf("  ✓ Errors reported correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Hand Strength Test Suite ===\n\n");
+
+    test_hole_combo_index();
+    test_hand_strength_river();
+    test_hand_strength_all();
+    test_hand_strength_equity();
+    test_hand_strength_ranges();
+    test_hand_potential();
+    test_compute_outs();
+    test_hand_strength_errors();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
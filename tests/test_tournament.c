@@ -0,0 +1,227 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/poker_tournament.h"
+
+/*
+ * Test Suite for the tournament simulator
+ * Tests verify finishing places, determinism, thread-count independence,
+ * payout accounting, custom policies, round limits and error handling
+ */
+
+static const TournamentLevel LEVELS[] = {
+    {10, 20}, {15, 30}, {25, 50}, {50, 100}, {100, 200}, {200, 400}, {400, 800},
+};
+static const uint64_t PAYOUTS[] = {500, 300, 200};
+
+/* Static helper: a 27-player, 9-max structure with three mixed policies */
+static TournamentConfig make_config(const TournamentPolicy* const policies, const size_t count) {
+    TournamentConfig config;
+    memset(&config, 0, sizeof(config));
+    config.num_players = 27;
+    config.table_size = 9;
+    config.starting_stack = 1500;
+    config.levels = LEVELS;
+    config.num_levels = sizeof(LEVELS) / sizeof(LEVELS[0]);
+    config.hands_per_level = 10;
+    config.payouts = PAYOUTS;
+    config.num_payouts = 3;
+    config.policies = policies;
+    config.num_policies = count;
+    return config;
+}
+
+/* Static helper: check places are a permutation of 1..n */
+static void check_places(const uint32_t* const places, const size_t n) {
+    char* const seen = calloc(n + 1, 1);
+    for (size_t p = 0; p < n; p++) {
+        assert(places[p] >= 1 && places[p] <= n);
+        assert(!seen[places[p]]);
+        seen[places[p]] = 1;
+    }
+    free(seen);
+}
+
+/* Custom policy: check/call, counting decisions and table sizes seen */
+static size_t decisions;
+static size_t largest_table;
+static int decide_counting(const GameTables* tables, size_t table, const GameLegal* legal,
+                           const void* params, uint64_t* rng, uint32_t* out_raise_to) {
+    const size_t seated = (size_t)__builtin_popcount(tables->seated[table]);
+    decisions++;
+    largest_table = (seated > largest_table) ? seated : largest_table;
+    return tournament_decide_check_call(tables, table, legal, params, rng, out_raise_to);
+}
+
+void test_tournament_run(void) {
+    printf("Testing tournament_run...\n");
+
+    const int min_rank = RANK_JACK;
+    const TournamentPolicy policies[3] = {
+        {tournament_decide_random, NULL},
+        {tournament_decide_shove, &min_rank},
+        {tournament_decide_check_call, NULL},
+    };
+    const TournamentConfig config = make_config(policies, 3);
+    uint32_t places[27];
+    uint32_t again[27];
+    uint64_t hands = 0;
+    uint64_t hands_again = 0;
+
+    assert(tournament_run(&config, 1, places, &hands) == 0);
+    check_places(places, 27);
+    assert(hands > 0);
+    assert(tournament_run(&config, 1, again, &hands_again) == 0);
+    assert(memcmp(places, again, sizeof(places)) == 0 && hands == hands_again);
+
+    /* Another seed plays out differently */
+    size_t differ = 0;
+    for (uint64_t seed = 2; seed < 6; seed++) {
+        assert(tournament_run(&config, seed, again, NULL) == 0);
+        check_places(again, 27);
+        differ += (memcmp(places, again, sizeof(places)) != 0);
+    }
+    assert(differ > 0);
+
+    /* Large field with a custom policy: tables never exceed their size */
+    const TournamentPolicy counting = {decide_counting, NULL};
+    TournamentConfig big = make_config(&counting, 1);
+    big.num_players = 200;
+    big.table_size = 6;
+    uint32_t* const big_places = malloc(200 * sizeof(uint32_t));
+    decisions = 0;
+    largest_table = 0;
+    assert(tournament_run(&big, 7, big_places, &hands) == 0);
+    check_places(big_places, 200);
+    assert(decisions > hands && largest_table == 6);
+    free(big_places);
+
+    printf("  ✓ Places are complete and seeds replay exactly\n");
+}
+
+void test_tournament_simulate(void) {
+    printf("Testing tournament_simulate...\n");
+
+    const int min_rank = RANK_QUEEN;
+    const TournamentPolicy policies[3] = {
+        {tournament_decide_random, NULL},
+        {tournament_decide_shove, &min_rank},
+        {tournament_decide_check_call, NULL},
+    };
+    const TournamentConfig config = make_config(policies, 3);
+    const uint64_t count = 60;
+    TournamentStats one;
+    TournamentStats many;
+
+    assert(tournament_simulate(&config, count, 100, 1, &one) == 0);
+    assert(tournament_simulate(&config, count, 100, 3, &many) == 0);
+    assert(one.tournaments == count && one.hands == many.hands && one.rounds == many.rounds);
+
+    uint64_t wins = 0;
+    uint64_t cashes = 0;
+    uint64_t prize = 0;
+    for (size_t p = 0; p < 3; p++) {
+        assert(one.policies[p].entries == count * 9);
+        assert(one.policies[p].wins == many.policies[p].wins);
+        assert(one.policies[p].cashes == many.policies[p].cashes);
+        assert(one.policies[p].prize == many.policies[p].prize);
+        assert(fabs(one.policies[p].prize_sq - many.policies[p].prize_sq) < 1e-6);
+        wins += one.policies[p].wins;
+        cashes += one.policies[p].cashes;
+        prize += one.policies[p].prize;
+    }
+    assert(wins == count && cashes == count * 3 && prize == count * 1000);
+    assert(one.policies[3].entries == 0);
+
+    /* Tournament i of a simulation is tournament_run(seed + i) */
+    uint32_t places[27];
+    TournamentStats single;
+    assert(tournament_run(&config, 105, places, NULL) == 0);
+    assert(tournament_simulate(&config, 1, 105, 1, &single) == 0);
+    for (size_t p = 0; p < 3; p++) {
+        uint64_t expected = 0;
+        for (size_t e = p; e < 27; e += 3) {
+            expected += (places[e] <= 3) ? PAYOUTS[places[e] - 1] : 0;
+        }
+        assert(single.policies[p].prize == expected);
+    }
+
+    assert(tournament_simulate(&config, 0, 0, 2, &single) == 0);
+    assert(single.tournaments == 0 && single.hands == 0);
+
+    printf("  ✓ %llu tournaments aggregate identically on 1 and 3 threads\n",
+           (unsigned long long)count);
+}
+
+void test_tournament_max_rounds(void) {
+    printf("Testing round limits...\n");
+
+    const TournamentPolicy policy = {tournament_decide_check_call, NULL};
+    TournamentConfig config = make_config(&policy, 1);
+    config.max_rounds = 3;
+    uint32_t places[27];
+    uint64_t hands = 0;
+
+    assert(tournament_run(&config, 3, places, &hands) == 0);
+    check_places(places, 27);
+    assert(hands <= 3 * 3);
+
+    printf("  ✓ Survivors ranked by chips after the last round\n");
+}
+
+void test_tournament_errors(void) {
+    printf("Testing tournament error handling...\n");
+
+    const TournamentPolicy policy = {tournament_decide_check_call, NULL};
+    TournamentConfig config = make_config(&policy, 1);
+    uint32_t places[27];
+    TournamentStats stats;
+
+    config.num_players = 1;
+    poker_errno = POKER_EOK;
+    assert(tournament_run(&config, 0, places, NULL) == -1);
+    assert(poker_errno == POKER_EINVAL);
+    config = make_config(&policy, 1);
+    config.table_size = MAX_PLAYERS + 1;
+    assert(tournament_run(&config, 0, places, NULL) == -1);
+    config = make_config(&policy, 1);
+    config.starting_stack = UINT32_MAX / 2;
+    assert(tournament_run(&config, 0, places, NULL) == -1);
+    config = make_config(&policy, 1);
+    config.num_levels = 0;
+    assert(tournament_run(&config, 0, places, NULL) == -1);
+    config = make_config(&policy, 1);
+    config.hands_per_level = 0;
+    assert(tournament_run(&config, 0, places, NULL) == -1);
+    config = make_config(&policy, 1);
+    config.num_payouts = 28;
+    assert(tournament_run(&config, 0, places, NULL) == -1);
+    config = make_config(&policy, 1);
+    config.num_policies = TOURNAMENT_MAX_POLICIES + 1;
+    assert(tournament_simulate(&config, 1, 0, 1, &stats) == -1);
+
+    const TournamentPolicy missing = {NULL, NULL};
+    config = make_config(&missing, 1);
+    assert(tournament_run(&config, 0, places, NULL) == -1);
+
+    config = make_config(&policy, 1);
+    assert(tournament_run(&config, 0, NULL, NULL) == -1);
+    assert(tournament_simulate(&config, 1, 0, 1, NULL) == -1);
+    assert(tournament_run(NULL, 0, places, NULL) == -1);
+
+    printf("  ✓ Errors reported correctly\n");
+}
+
+int main(void) {
+    printf("\n=== Tournament Test Suite ===\n\n");
+
+    test_tournament_run();
+    test_tournament_simulate();
+    test_tournament_max_rounds();
+    test_tournament_errors();
+
+    printf("\n=== All tests passed! ===\n\n");
+    return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ * poker-buckets - Card abstraction builder
+ *
+ * Clusters every suit-isomorphic hand class of a street by its equity
+ * histogram (k-means under the earth mover's distance) and writes a
+ * bucket table (poker_abstraction.h), or looks hands up in one.
+ *
+ * Build:
+ *   make tools
+ *
+ * Run:
+ *   ./build/poker-buckets --street flop -k 200 -n 100 -o flop.pbkt --stats
+ *   ./build/poker-buckets --lookup flop.pbkt "AhKh QhJc2d" "7s2d 7h7c2s"
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_abstraction.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Defaults */
+#define DEFAULT_BUCKETS    200
+#define DEFAULT_BINS       50
+#define DEFAULT_SAMPLES    100
+#define DEFAULT_ITERATIONS 30
+
+static const char* const STREET_NAMES[HAND_INDEX_STREETS] = {"preflop", "flop", "turn", "river"};
+
+static void usage(FILE* const out) {
+    fprintf(out,
+            "Usage: poker-buckets [options] -o FILE\n"
+            "       poker-buckets --lookup FILE HAND...\n"
+            "Build a card abstraction: k-means buckets of equity histograms.\n"
+            "\n"
+            "Options:\n"
+            "  -s, --street NAME     preflop, flop (default), turn or river\n"
+            "  -k, --buckets N       Buckets (default %d, at most %d)\n"
+            "  -b, --bins N          Histogram bins (default %d, 2-%d)\n"
+            "  -n, --samples N       Runouts per board, 0 = every runout (default %d)\n"
+            "  -i, --iterations N    Most k-means iterations (default %d)\n"
+            "  -t, --threads N       Worker threads (default: online CPUs)\n"
+            "      --seed N          Sampling and seeding seed (default 1)\n"
+            "  -o, --output FILE     Bucket table to write\n"
+            "      --stats           Print build statistics to stderr\n"
+            "  -l, --lookup FILE     Print the bucket of each HAND (hole cards then board)\n"
+            "  -h, --help            Show this help\n",
+            DEFAULT_BUCKETS, ABSTRACTION_MAX_BUCKETS, DEFAULT_BINS, ABSTRACTION_MAX_BINS,
+            DEFAULT_SAMPLES, DEFAULT_ITERATIONS);
+}
+
+/* Static helper: parse a count argument in [0, max] */
+static int parse_count(const char* const arg, const unsigned long long max, size_t* const out) {
+    char* end = NULL;
+    const unsigned long long value = (arg != NULL) ? strtoull(arg, &end, 10) : 0;
+    if (arg == NULL || end == arg || *end != '\0' || value > max) {
+        return -1;
+    }
+    *out = (size_t)value;
+    return 0;
+}
+
+/* Static helper: print the bucket of each hand argument */
+static int lookup_hands(const char* const path, char** const hands, const int num_hands) {
+    BucketTable* const table = bucket_table_open(path);
+    if (table == NULL) {
+        fprintf(stderr, "poker-buckets: cannot open table '%s' (error %d)\n", path, poker_errno);
+        return 1;
+    }
+    int rc = 0;
+    for (int h = 0; h < num_hands; h++) {
+        /* Cards in the order written, so hole cards come first */
+        uint8_t cards[HOLE_SIZE + BOARD_SIZE];
+        size_t n = 0;
+        int valid = 1;
+        for (const char* p = hands[h]; *p != '\0' && valid;) {
+            if (*p == ' ') {
+                p++;
+                continue;
+            }
+            uint64_t mask = 0;
+            valid = (n < sizeof(cards) && p[1] != '\0' && parse_hand_mask(p, 2, &mask, NULL) == 1);
+            if (valid) {
+                cards[n++] = (uint8_t)__builtin_ctzll(mask);
+                p += 2;
+            }
+        }
+        const int bucket = valid ? bucket_table_lookup(table, cards, n) : -1;
+        if (bucket < 0) {
+            fprintf(stderr, "poker-buckets: invalid hand '%s'\n", hands[h]);
+            rc = 1;
+            continue;
+        }
+        printf("%s\t%d\n", hands[h], bucket);
+    }
+    bucket_table_close(table);
+    return rc;
+}
+
+int main(int argc, char** argv) {
+    AbstractionConfig config;
+    memset(&config, 0, sizeof(config));
+    config.street = HAND_INDEX_FLOP;
+    config.num_buckets = DEFAULT_BUCKETS;
+    config.bins = DEFAULT_BINS;
+    config.samples = DEFAULT_SAMPLES;
+    config.iterations = DEFAULT_ITERATIONS;
+    config.seed = 1;
+    const char* output = NULL;
+    int print_stats = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* const arg = argv[i];
+        const char* const value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        size_t count;
+
+        if (strcmp(arg, "-s") == 0 || strcmp(arg, "--street") == 0) {
+            config.street = -1;
+            for (int s = 0; s < HAND_INDEX_STREETS && value != NULL; s++) {
+                if (strcmp(value, STREET_NAMES[s]) == 0) {
+                    config.street = s;
+                }
+            }
+            if (config.street < 0) {
+                fprintf(stderr, "poker-buckets: unknown street '%s'\n", value ? value : "");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-k") == 0 || strcmp(arg, "--buckets") == 0) {
+            if (parse_count(value, ABSTRACTION_MAX_BUCKETS, &config.num_buckets) != 0 ||
+                config.num_buckets == 0) {
+                fprintf(stderr, "poker-buckets: invalid bucket count (1-%d)\n",
+                        ABSTRACTION_MAX_BUCKETS);
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-b") == 0 || strcmp(arg, "--bins") == 0) {
+            if (parse_count(value, ABSTRACTION_MAX_BINS, &count) != 0 || count < 2) {
+                fprintf(stderr, "poker-buckets: invalid bin count (2-%d)\n", ABSTRACTION_MAX_BINS);
+                return 2;
+            }
+            config.bins = (unsigned)count;
+            i++;
+        } else if (strcmp(arg, "-n") == 0 || strcmp(arg, "--samples") == 0) {
+            if (parse_count(value, 1u << 30, &config.samples) != 0) {
+                fprintf(stderr, "poker-buckets: invalid sample count\n");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-i") == 0 || strcmp(arg, "--iterations") == 0) {
+            if (parse_count(value, 1u << 20, &config.iterations) != 0 || config.iterations == 0) {
+                fprintf(stderr, "poker-buckets: invalid iteration count\n");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--threads") == 0) {
+            if (parse_count(value, 256, &config.num_threads) != 0 || config.num_threads == 0) {
+                fprintf(stderr, "poker-buckets: invalid thread count (1-256)\n");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "--seed") == 0) {
+            char* end = NULL;
+            config.seed = (value != NULL) ? strtoull(value, &end, 10) : 0;
+            if (value == NULL || end == value || *end != '\0') {
+                fprintf(stderr, "poker-buckets: invalid seed\n");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0) {
+            if (value == NULL) {
+                fprintf(stderr, "poker-buckets: missing output file\n");
+                return 2;
+            }
+            output = value;
+            i++;
+        } else if (strcmp(arg, "--stats") == 0) {
+            print_stats = 1;
+        } else if (strcmp(arg, "-l") == 0 || strcmp(arg, "--lookup") == 0) {
+            if (value == NULL) {
+                fprintf(stderr, "poker-buckets: missing table file\n");
+                return 2;
+            }
+            return lookup_hands(value, argv + i + 2, argc - i - 2);
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            usage(stdout);
+            return 0;
+        } else {
+            fprintf(stderr, "poker-buckets: unknown option '%s'\n", arg);
+            usage(stderr);
+            return 2;
+        }
+    }
+
+    if (output == NULL) {
+        fprintf(stderr, "poker-buckets: missing output file\n");
+        usage(stderr);
+        return 2;
+    }
+    if (config.street == HAND_INDEX_PREFLOP && config.samples == 0) {
+        fprintf(stderr, "poker-buckets: preflop needs a nonzero sample count\n");
+        return 2;
+    }
+
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    AbstractionStats stats;
+    if (abstraction_build(&config, output, &stats) != 0) {
+        fprintf(stderr, "poker-buckets: build failed (error %d)\n", poker_errno);
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (print_stats) {
+        const double seconds =
+            (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        fprintf(stderr,
+                "%s: %llu hands, %zu buckets (%zu empty), %zu iterations, "
+                "%llu changed in the last, mean EMD %.4f, %.1f s\n",
+                STREET_NAMES[config.street], (unsigned long long)stats.num_hands,
+                config.num_buckets, stats.empty_buckets, stats.iterations,
+                (unsigned long long)stats.changed, stats.mean_distance, seconds);
+    }
+    return 0;
+}
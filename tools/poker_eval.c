@@ -0,0 +1,680 @@
+/*
+ * poker-eval - Batch hand evaluator for shell pipelines
+ *
+ * Reads hands from files or stdin, evaluates them in batches across
+ * threads and writes one tab-separated line per hand:
+ *
+ *   <category>\t<value>\t<best five>          (text and mask input)
+ *   <hand id>\t<player>\t<category>\t<value>\t<best five>   (record files)
+ *
+ * value is the packed HandValue in hex (compare as integers or strings).
+ *
+ * Input formats:
+ *   text     One hand of 5-7 cards per line ("AhKh QhJhTh 2c3d"). Empty
+ *            lines are echoed as empty lines and invalid lines are written
+ *            as "Invalid\t-\t-", so output lines match input lines.
+ *   mask     Little-endian 64-bit card masks, 8 bytes per hand
+ *   records  Binary hand-record files (poker_records.h); one line per
+ *            player with known hole cards and at least a flop
+ *
+ * Build:
+ *   make tools
+ *
+ * Run:
+ *   ./build/poker-eval --threads 4 hands.txt
+ *   generate_hands | ./build/poker-eval --unordered | sort | uniq -c
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_pipeline.h"
+#include "../include/poker_records.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Longest output line: "<hand id>\t<player>\t<category>\t0x<value>\t<five cards>\n" */
+#define MAX_LINE 96
+
+/* Text input read size */
+#define READ_CHUNK (1 << 20)
+
+/* Evaluation threads, leaving one each for the read and write stages */
+#define MAX_EVAL_THREADS (POKER_MAX_THREADS - 2)
+
+/* Input formats */
+#define INPUT_TEXT    0
+#define INPUT_MASK    1
+#define INPUT_RECORDS 2
+
+/* Status of each text line or mask (BatchScratch) */
+#define LINE_HAND    0
+#define LINE_EMPTY   1
+#define LINE_INVALID 2
+
+/* Command-line options */
+typedef struct {
+    int format;
+    size_t batch_size;
+    size_t threads;
+    int unordered;
+    int stats;
+    char** files;
+    size_t num_files;
+} EvalOptions;
+
+/*
+ * Input state for the (single-threaded) source stage
+ */
+typedef struct {
+    const EvalOptions* options;
+    size_t file_index;
+    FILE* file;
+    RecordReader* reader;
+    char* buffer;              /* Text read buffer */
+    size_t buffer_len;
+    size_t buffer_pos;
+    int eof;
+    int skip_line;             /* Discarding the rest of an over-long line */
+    uint64_t line;             /* Lines (text) or hands (mask) read */
+    uint64_t invalid;          /* Invalid input lines/masks */
+    int failed;                /* Input could not be opened or read */
+} EvalInput;
+
+/*
+ * Per-batch scratch (PipelineBatch.scratch): the source stage writes one
+ * LINE_* status per text or mask record, the evaluation stage the
+ * formatted output after them
+ */
+typedef struct {
+    size_t len;                /* Bytes of formatted output */
+    uint8_t data[];            /* capacity statuses, then the output */
+} BatchScratch;
+
+/* Static helper: line statuses of a batch */
+static uint8_t* batch_status(const PipelineBatch* const batch) {
+    return ((BatchScratch*)batch->scratch)->data;
+}
+
+/* Static helper: formatted output of a batch */
+static char* batch_text(const PipelineBatch* const batch) {
+    return (char*)((BatchScratch*)batch->scratch)->data + batch->capacity;
+}
+
+/* Out-of-order batch waiting for its turn */
+typedef struct {
+    uint64_t sequence;
+    char* text;
+    size_t len;
+} PendingText;
+
+/* Output state for the (single-threaded) sink stage */
+typedef struct {
+    int unordered;
+    uint64_t next_sequence;
+    PendingText* pending;
+    size_t num_pending;
+    size_t pending_capacity;
+} EvalOutput;
+
+static void usage(FILE* const out) {
+    fprintf(out,
+            "Usage: poker-eval [options] [file...]\n"
+            "Evaluate poker hands read from files (or stdin, or '-').\n"
+            "\n"
+            "Options:\n"
+            "  -f, --format FMT   Input format: text (default), mask, records\n"
+            "  -b, --batch N      Hands per batch (default %d)\n"
+            "  -t, --threads N    Evaluation threads (default: online CPUs)\n"
+            "  -u, --unordered    Write batches as they finish instead of in input order\n"
+            "  -s, --stats        Print per-stage throughput to stderr\n"
+            "  -h, --help         Show this help\n",
+            PIPELINE_DEFAULT_BATCH_SIZE);
+}
+
+/* Static helper: parse a positive count argument */
+static int parse_count(const char* const arg, size_t* const out) {
+    char* end = NULL;
+    const unsigned long long value = (arg != NULL) ? strtoull(arg, &end, 10) : 0;
+    if (arg == NULL || end == arg || *end != '\0' || value == 0 || value > 1u << 24) {
+        return -1;
+    }
+    *out = (size_t)value;
+    return 0;
+}
+
+static int parse_options(const int argc, char** const argv, EvalOptions* const opts) {
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    opts->format = INPUT_TEXT;
+    opts->batch_size = PIPELINE_DEFAULT_BATCH_SIZE;
+    opts->threads = (online > 0) ? (size_t)online : 1;
+    if (opts->threads > MAX_EVAL_THREADS) {
+        opts->threads = MAX_EVAL_THREADS;
+    }
+    opts->unordered = 0;
+    opts->stats = 0;
+    opts->files = NULL;
+    opts->num_files = 0;
+
+    int i = 1;
+    for (; i < argc; i++) {
+        const char* const arg = argv[i];
+        const char* const value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "-f") == 0 || strcmp(arg, "--format") == 0) {
+            if (value != NULL && strcmp(value, "text") == 0) {
+                opts->format = INPUT_TEXT;
+            } else if (value != NULL && strcmp(value, "mask") == 0) {
+                opts->format = INPUT_MASK;
+            } else if (value != NULL && strcmp(value, "records") == 0) {
+                opts->format = INPUT_RECORDS;
+            } else {
+                fprintf(stderr, "poker-eval: unknown format '%s'\n", value ? value : "");
+                return -1;
+            }
+            i++;
+        } else if (strcmp(arg, "-b") == 0 || strcmp(arg, "--batch") == 0) {
+            if (parse_count(value, &opts->batch_size) != 0) {
+                fprintf(stderr, "poker-eval: invalid batch size\n");
+                return -1;
+            }
+            i++;
+        } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--threads") == 0) {
+            if (parse_count(value, &opts->threads) != 0 || opts->threads > MAX_EVAL_THREADS) {
+                fprintf(stderr, "poker-eval: invalid thread count (1-%d)\n", MAX_EVAL_THREADS);
+                return -1;
+            }
+            i++;
+        } else if (strcmp(arg, "-u") == 0 || strcmp(arg, "--unordered") == 0) {
+            opts->unordered = 1;
+        } else if (strcmp(arg, "-s") == 0 || strcmp(arg, "--stats") == 0) {
+            opts->stats = 1;
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            usage(stdout);
+            exit(0);
+        } else if (strcmp(arg, "--") == 0) {
+            i++;
+            break;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            fprintf(stderr, "poker-eval: unknown option '%s'\n", arg);
+            return -1;
+        } else {
+            break;
+        }
+    }
+
+    opts->files = argv + i;
+    opts->num_files = (size_t)(argc - i);
+    if (opts->format == INPUT_RECORDS && opts->num_files == 0) {
+        fprintf(stderr, "poker-eval: records input needs file arguments\n");
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Input
+ */
+
+/* Static helper: open the next input; 0 when there is none left */
+static int open_next_input(EvalInput* const in) {
+    const EvalOptions* const opts = in->options;
+
+    if (in->file != NULL && in->file != stdin) {
+        fclose(in->file);
+    }
+    in->file = NULL;
+    record_reader_close(in->reader);
+    in->reader = NULL;
+    in->buffer_len = 0;
+    in->buffer_pos = 0;
+    in->eof = 0;
+
+    if (opts->num_files == 0) {
+        if (in->file_index++ > 0) {
+            return 0;
+        }
+        in->file = stdin;
+        return 1;
+    }
+
+    while (in->file_index < opts->num_files) {
+        const char* const path = opts->files[in->file_index++];
+        if (opts->format == INPUT_RECORDS) {
+            in->reader = record_reader_open(path);
+            if (in->reader != NULL) {
+                return 1;
+            }
+        } else {
+            in->file = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+            if (in->file != NULL) {
+                return 1;
+            }
+        }
+        fprintf(stderr, "poker-eval: cannot read '%s'\n", path);
+        in->failed = 1;
+    }
+    return 0;
+}
+
+/* Static helper: store 5-7 card indices as hole (first two) plus board */
+static void store_cards(HandRecord* const rec, const uint8_t* const cards, const size_t n) {
+    rec->num_players = 1;
+    rec->hole[0][0] = cards[0];
+    rec->hole[0][1] = cards[1];
+    rec->board_len = (uint8_t)(n - HOLE_SIZE);
+    memcpy(rec->board, cards + HOLE_SIZE, n - HOLE_SIZE);
+}
+
+/* Static helper: turn one text line into a record and its LINE_* status */
+static void text_line_record(EvalInput* const in, const char* const line, size_t len,
+                             HandRecord* const rec, uint8_t* const status) {
+    memset(rec, 0, sizeof(*rec));
+    rec->hand_id = ++in->line;
+    *status = LINE_HAND;
+
+    if (len > 0 && line[len - 1] == '\r') {
+        len--;
+    }
+    if (len == 0) {
+        *status = LINE_EMPTY;
+        return;
+    }
+
+    Card cards[HAND_SIZE + 2];
+    const int n = parse_hand(line, len, cards, HAND_SIZE + 2, NULL);
+    if (n < HAND_SIZE) {
+        *status = LINE_INVALID;
+        in->invalid++;
+        fprintf(stderr, "poker-eval: line %llu: invalid hand\n", (unsigned long long)in->line);
+        return;
+    }
+
+    uint8_t indices[HAND_SIZE + 2];
+    for (int i = 0; i < n; i++) {
+        indices[i] = (uint8_t)CARD_INDEX(cards[i]);
+    }
+    store_cards(rec, indices, (size_t)n);
+}
+
+/* Static helper: fill a batch from text lines; returns records added */
+static size_t read_text(EvalInput* const in, PipelineBatch* const batch) {
+    uint8_t* const status = batch_status(batch);
+    size_t count = 0;
+
+    while (count < batch->capacity) {
+        const char* const start = in->buffer + in->buffer_pos;
+        const size_t avail = in->buffer_len - in->buffer_pos;
+        const char* const newline = memchr(start, '\n', avail);
+
+        if (newline != NULL) {
+            if (in->skip_line) {
+                in->skip_line = 0;
+            } else {
+                text_line_record(in, start, (size_t)(newline - start), &batch->records[count],
+                                 &status[count]);
+                count++;
+            }
+            in->buffer_pos += (size_t)(newline - start) + 1;
+            continue;
+        }
+        if (in->eof) {
+            if (avail > 0 && !in->skip_line) {
+                text_line_record(in, start, avail, &batch->records[count], &status[count]);
+                count++;
+                in->buffer_pos = in->buffer_len;
+            }
+            break;
+        }
+
+        /* Keep the partial line, refill behind it */
+        memmove(in->buffer, start, avail);
+        in->buffer_len = avail;
+        in->buffer_pos = 0;
+        if (in->buffer_len == READ_CHUNK) {
+            /* A line longer than the buffer cannot be a hand: report it once, drop the rest */
+            if (!in->skip_line) {
+                text_line_record(in, "-", 1, &batch->records[count], &status[count]);
+                count++;
+                in->skip_line = 1;
+            }
+            in->buffer_len = 0;
+            continue;
+        }
+        const size_t got = fread(in->buffer + in->buffer_len, 1, READ_CHUNK - in->buffer_len, in->file);
+        in->buffer_len += got;
+        if (got == 0) {
+            if (ferror(in->file)) {
+                in->failed = 1;
+            }
+            in->eof = 1;
+        }
+    }
+    return count;
+}
+
+/* Static helper: fill a batch from 8-byte masks; returns records added */
+static size_t read_masks(EvalInput* const in, PipelineBatch* const batch) {
+    uint8_t* const status = batch_status(batch);
+    size_t count = 0;
+    unsigned char bytes[8];
+
+    while (count < batch->capacity && fread(bytes, 1, sizeof(bytes), in->file) == sizeof(bytes)) {
+        uint64_t mask = 0;
+        for (int b = 7; b >= 0; b--) {
+            mask = (mask << 8) | bytes[b];
+        }
+
+        status[count] = LINE_HAND;
+        HandRecord* const rec = &batch->records[count++];
+        memset(rec, 0, sizeof(*rec));
+        rec->hand_id = ++in->line;
+
+        uint8_t indices[HAND_SIZE + 2];
+        size_t n = 0;
+        for (unsigned i = 0; i < 64 && n <= HAND_SIZE + 1; i++) {
+            if (mask & (UINT64_C(1) << i)) {
+                indices[n++] = (uint8_t)i;
+            }
+        }
+        if (evaluate_mask(mask) == 0) {
+            status[count - 1] = LINE_INVALID;
+            in->invalid++;
+            continue;
+        }
+        store_cards(rec, indices, n);
+    }
+    if (count < batch->capacity) {
+        in->eof = 1;
+    }
+    return count;
+}
+
+/* Source stage: fill a batch from the current input, moving through files */
+static int source_stage(PipelineBatch* batch, void* context, size_t worker) {
+    EvalInput* const in = (EvalInput*)context;
+    (void)worker;
+
+    for (;;) {
+        if (in->file == NULL && in->reader == NULL && !open_next_input(in)) {
+            return PIPELINE_DONE;
+        }
+
+        size_t got = 0;
+        if (in->options->format == INPUT_RECORDS) {
+            if (record_reader_read(in->reader, batch->records, batch->capacity, &got) != 0) {
+                fprintf(stderr, "poker-eval: corrupt record file\n");
+                in->failed = 1;
+            }
+            in->eof = (got == 0);
+        } else if (in->options->format == INPUT_MASK) {
+            got = read_masks(in, batch);
+        } else {
+            got = read_text(in, batch);
+        }
+
+        batch->count = got;
+        if (in->eof && (in->buffer_pos >= in->buffer_len || in->options->format != INPUT_TEXT)) {
+            if (in->file != NULL && in->file != stdin) {
+                fclose(in->file);
+            }
+            in->file = NULL;
+            record_reader_close(in->reader);
+            in->reader = NULL;
+        }
+        if (got > 0) {
+            return 0;
+        }
+    }
+}
+
+/*
+ * Evaluation
+ */
+
+/* Static helper: append a NUL-terminated string */
+static char* put_str(char* out, const char* str) {
+    while (*str != '\0') {
+        *out++ = *str++;
+    }
+    return out;
+}
+
+/* Static helper: append an unsigned decimal */
+static char* put_uint(char* out, uint64_t value) {
+    char digits[20];
+    size_t n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (n > 0) {
+        *out++ = digits[--n];
+    }
+    return out;
+}
+
+/* Static helper: append "<category>\t0x<value>\t<best five>\n" for 5-7 cards */
+static char* put_evaluation(char* out, const Card* const cards, const size_t n) {
+    static const char HEX[] = "0123456789abcdef";
+    Hand hand;
+
+    if (evaluate_hand(cards, n, &hand) != 0) {
+        return put_str(out, "Invalid\t-\t-\n");
+    }
+
+    const HandValue value = hand_value(&hand);
+    out = put_str(out, hand_category_name(hand.category));
+    out = put_str(out, "\t0x");
+    for (int shift = 20; shift >= 0; shift -= 4) {
+        *out++ = HEX[(value >> shift) & 0xF];
+    }
+    *out++ = '\t';
+    const int written = format_cards(hand.cards, HAND_SIZE, ' ', out, 3 * HAND_SIZE);
+    out += (written > 0) ? written : 0;
+    *out++ = '\n';
+    return out;
+}
+
+/* Evaluation stage: evaluate and format every hand of a batch into its scratch */
+static int evaluate_stage(PipelineBatch* batch, void* context, size_t worker) {
+    const EvalOptions* const opts = (const EvalOptions*)context;
+    const uint8_t* const status = batch_status(batch);
+    char* const text = batch_text(batch);
+    char* out = text;
+    (void)worker;
+
+    for (size_t i = 0; i < batch->count; i++) {
+        const HandRecord* const rec = &batch->records[i];
+        Card cards[HAND_SIZE + 2];
+
+        if (opts->format != INPUT_RECORDS) {
+            if (status[i] == LINE_EMPTY) {
+                *out++ = '\n';
+                continue;
+            }
+            if (status[i] == LINE_INVALID) {
+                out = put_str(out, "Invalid\t-\t-\n");
+                continue;
+            }
+        }
+
+        for (size_t b = 0; b < rec->board_len && b < BOARD_SIZE; b++) {
+            cards[HOLE_SIZE + b] = CARD_FROM_INDEX(rec->board[b]);
+        }
+        const size_t n = HOLE_SIZE + rec->board_len;
+
+        for (size_t p = 0; p < rec->num_players && p < MAX_PLAYERS; p++) {
+            if (rec->hole[p][0] >= DECK_SIZE || rec->hole[p][1] >= DECK_SIZE) {
+                continue;
+            }
+            if (opts->format == INPUT_RECORDS) {
+                if (rec->board_len < 3) {
+                    continue;
+                }
+                out = put_uint(out, rec->hand_id);
+                *out++ = '\t';
+                out = put_uint(out, p);
+                *out++ = '\t';
+            }
+            cards[0] = CARD_FROM_INDEX(rec->hole[p][0]);
+            cards[1] = CARD_FROM_INDEX(rec->hole[p][1]);
+            out = put_evaluation(out, cards, n);
+        }
+    }
+
+    ((BatchScratch*)batch->scratch)->len = (size_t)(out - text);
+    return 0;
+}
+
+/*
+ * Output
+ */
+
+static int write_text(const char* const text, const size_t len) {
+    if (len > 0 && fwrite(text, 1, len, stdout) != len) {
+        poker_errno = POKER_EIO;
+        return -1;
+    }
+    return 0;
+}
+
+/* Sink stage: write batches, holding early ones until their turn in ordered mode */
+static int output_stage(PipelineBatch* batch, void* context, size_t worker) {
+    EvalOutput* const out = (EvalOutput*)context;
+    const char* const text = batch_text(batch);
+    const size_t len = ((const BatchScratch*)batch->scratch)->len;
+    (void)worker;
+
+    if (out->unordered) {
+        return write_text(text, len);
+    }
+
+    if (batch->sequence != out->next_sequence) {
+        if (out->num_pending == out->pending_capacity) {
+            const size_t capacity = out->pending_capacity ? out->pending_capacity * 2 : 16;
+            PendingText* const grown = realloc(out->pending, capacity * sizeof(PendingText));
+            if (grown == NULL) {
+                poker_errno = POKER_ENOMEM;
+                return -1;
+            }
+            out->pending = grown;
+            out->pending_capacity = capacity;
+        }
+        PendingText* const slot = &out->pending[out->num_pending];
+        slot->text = malloc(len + 1);
+        if (slot->text == NULL) {
+            poker_errno = POKER_ENOMEM;
+            return -1;
+        }
+        memcpy(slot->text, text, len);
+        slot->len = len;
+        slot->sequence = batch->sequence;
+        out->num_pending++;
+        return 0;
+    }
+
+    if (write_text(text, len) != 0) {
+        return -1;
+    }
+    out->next_sequence++;
+
+    /* Drain held batches that are now due */
+    for (size_t i = 0; i < out->num_pending;) {
+        PendingText* const slot = &out->pending[i];
+        if (slot->sequence != out->next_sequence) {
+            i++;
+            continue;
+        }
+        const int rc = write_text(slot->text, slot->len);
+        free(slot->text);
+        *slot = out->pending[--out->num_pending];
+        if (rc != 0) {
+            return -1;
+        }
+        out->next_sequence++;
+        i = 0;
+    }
+    return 0;
+}
+
+static void print_stats(const PipelineStats* const stats) {
+    fprintf(stderr, "%-10s %7s %12s %14s %10s %10s\n",
+            "stage", "threads", "records", "records/s", "busy s", "wait s");
+    for (size_t s = 0; s < stats->num_stages; s++) {
+        const PipelineStageStats* const st = &stats->stages[s];
+        fprintf(stderr, "%-10s %7zu %12llu %14.0f %10.3f %10.3f\n",
+                st->name, st->num_threads, (unsigned long long)st->records,
+                st->records_per_sec, st->busy_sec, st->wait_sec);
+    }
+    fprintf(stderr, "elapsed %.3f s, %zu batches in pool\n", stats->elapsed_sec, stats->pool_batches);
+}
+
+int main(int argc, char** argv) {
+    EvalOptions opts;
+    if (parse_options(argc, argv, &opts) != 0) {
+        usage(stderr);
+        return 2;
+    }
+
+    EvalInput input;
+    memset(&input, 0, sizeof(input));
+    input.options = &opts;
+    if (opts.format == INPUT_TEXT) {
+        input.buffer = malloc(READ_CHUNK);
+        if (input.buffer == NULL) {
+            fprintf(stderr, "poker-eval: out of memory\n");
+            return 1;
+        }
+    }
+
+    EvalOutput output;
+    memset(&output, 0, sizeof(output));
+    output.unordered = opts.unordered;
+
+    static char stdout_buffer[1 << 16];
+    setvbuf(stdout, stdout_buffer, _IOFBF, sizeof(stdout_buffer));
+
+    /* Record files produce up to one line per player; every record has a status byte */
+    const size_t lines_per_record = (opts.format == INPUT_RECORDS) ? MAX_PLAYERS : 1;
+    PipelineOptions pipeline_options = {0, 0, 0};
+    pipeline_options.batch_size = opts.batch_size;
+    pipeline_options.scratch_size = sizeof(BatchScratch) +
+                                    opts.batch_size * (1 + lines_per_record * MAX_LINE);
+
+    const PipelineStage stages[3] = {
+        {"read", source_stage, &input, 1},
+        {"evaluate", evaluate_stage, &opts, opts.threads},
+        {"write", output_stage, &output, 1},
+    };
+    PipelineStats stats;
+    memset(&stats, 0, sizeof(stats));
+    const int rc = pipeline_run(stages, 3, &pipeline_options, &stats);
+
+    if (fflush(stdout) != 0 && rc == 0) {
+        fprintf(stderr, "poker-eval: write error\n");
+        input.failed = 1;
+    }
+    if (rc != 0) {
+        fprintf(stderr, "poker-eval: evaluation failed (error %d)\n", poker_errno);
+    }
+    if (opts.stats) {
+        print_stats(&stats);
+    }
+
+    for (size_t i = 0; i < output.num_pending; i++) {
+        free(output.pending[i].text);
+    }
+    free(output.pending);
+    free(input.buffer);
+    if (input.file != NULL && input.file != stdin) {
+        fclose(input.file);
+    }
+    record_reader_close(input.reader);
+
+    if (rc != 0 || input.failed) {
+        return 1;
+    }
+    return (input.invalid > 0) ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * poker-evald - Local evaluation daemon
+ *
+ * Serves hand evaluation and equity requests over a Unix domain socket
+ * (protocol in poker_server.h) so short-lived processes can share one set
+ * of warm worker threads. Concurrent requests are coalesced into batches.
+ *
+ * Build:
+ *   make tools
+ *
+ * Run:
+ *   ./build/poker-evald --socket /tmp/poker-evald.sock --threads 4
+ *
+ * SIGINT or SIGTERM stops the daemon after answering queued requests.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_server.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_SOCKET "/tmp/poker-evald.sock"
+
+static PokerServer* running_server = NULL;
+
+static void handle_signal(int sig) {
+    (void)sig;
+    server_stop(running_server);
+}
+
+static void usage(FILE* const out) {
+    fprintf(out,
+            "Usage: poker-evald [options]\n"
+            "Serve hand evaluation requests over a Unix domain socket.\n"
+            "\n"
+            "Options:\n"
+            "  -S, --socket PATH      Socket path (default %s)\n"
+            "  -t, --threads N        Worker threads (default: online CPUs)\n"
+            "  -b, --max-batch N      Hands per coalesced batch (default 4096)\n"
+            "  -p, --max-pending N    Queued requests before BUSY replies (default 1024)\n"
+            "  -s, --stats            Print counters to stderr on exit\n"
+            "  -h, --help             Show this help\n",
+            DEFAULT_SOCKET);
+}
+
+/* Static helper: parse a positive count argument */
+static int parse_count(const char* const arg, size_t* const out) {
+    char* end = NULL;
+    const unsigned long long value = (arg != NULL) ? strtoull(arg, &end, 10) : 0;
+    if (arg == NULL || end == arg || *end != '\0' || value == 0 || value > 1u << 24) {
+        return -1;
+    }
+    *out = (size_t)value;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    ServerOptions options;
+    memset(&options, 0, sizeof(options));
+    options.socket_path = DEFAULT_SOCKET;
+    int print_stats = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* const arg = argv[i];
+        const char* const value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "-S") == 0 || strcmp(arg, "--socket") == 0) {
+            if (value == NULL) {
+                fprintf(stderr, "poker-evald: missing socket path\n");
+                usage(stderr);
+                return 2;
+            }
+            options.socket_path = value;
+            i++;
+        } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--threads") == 0) {
+            if (parse_count(value, &options.num_threads) != 0 || options.num_threads > 256) {
+                fprintf(stderr, "poker-evald: invalid thread count (1-256)\n");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-b") == 0 || strcmp(arg, "--max-batch") == 0) {
+            if (parse_count(value, &options.max_batch) != 0) {
+                fprintf(stderr, "poker-evald: invalid batch size\n");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-p") == 0 || strcmp(arg, "--max-pending") == 0) {
+            if (parse_count(value, &options.max_pending) != 0) {
+                fprintf(stderr, "poker-evald: invalid queue limit\n");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-s") == 0 || strcmp(arg, "--stats") == 0) {
+            print_stats = 1;
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            usage(stdout);
+            return 0;
+        } else {
+            fprintf(stderr, "poker-evald: unknown option '%s'\n", arg);
+            usage(stderr);
+            return 2;
+        }
+    }
+
+    running_server = server_open(&options);
+    if (running_server == NULL) {
+        fprintf(stderr, "poker-evald: cannot listen on %s (error %d)\n",
+                options.socket_path, poker_errno);
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    fprintf(stderr, "poker-evald: listening on %s\n", options.socket_path);
+    const int rc = server_run(running_server);
+    if (rc != 0) {
+        fprintf(stderr, "poker-evald: server failed (error %d)\n", poker_errno);
+    }
+
+    if (print_stats) {
+        ServerStats stats;
+        server_get_stats(running_server, &stats);
+        fprintf(stderr,
+                "connections %llu, requests %llu, batches %llu, hands %llu, equity %llu,\n"
+                "deadline misses %llu, rejected %llu, largest batch %llu requests\n",
+                (unsigned long long)stats.connections, (unsigned long long)stats.requests,
+                (unsigned long long)stats.batches, (unsigned long long)stats.hands,
+                (unsigned long long)stats.equity_requests,
+                (unsigned long long)stats.deadline_misses, (unsigned long long)stats.rejected,
+                (unsigned long long)stats.max_batch_requests);
+    }
+    server_close(running_server);
+    return (rc == 0) ? 0 : 1;
+}
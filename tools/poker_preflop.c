@@ -0,0 +1,140 @@
+/*
+ * poker-preflop - Preflop equity matrix builder
+ *
+ * Computes the exact all-in equity of every hole combo against every other
+ * combo and writes it as a compact matrix file (poker_preflop.h), or looks
+ * matchups up in one. A full build ranks every river board class once;
+ * build with "make release tools" for a one-time run of a few minutes.
+ *
+ * Build:
+ *   make tools
+ *
+ * Run:
+ *   ./build/poker-preflop -o preflop.peqm --stats
+ *   ./build/poker-preflop --lookup preflop.peqm AhKh QsQd 7c2d 8h8s
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_preflop.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static void usage(FILE* const out) {
+    fprintf(out,
+            "Usage: poker-preflop [options] -o FILE\n"
+            "       poker-preflop --lookup FILE HOLE VILLAIN [HOLE VILLAIN]...\n"
+            "Build the exact preflop combo-vs-combo equity matrix.\n"
+            "\n"
+            "Options:\n"
+            "  -t, --threads N       Worker threads (default: online CPUs)\n"
+            "  -o, --output FILE     Matrix file to write\n"
+            "      --stats           Print build statistics to stderr\n"
+            "  -l, --lookup FILE     Print the equity of each HOLE against VILLAIN\n"
+            "  -h, --help            Show this help\n");
+}
+
+/* Static helper: parse one two-card combo */
+static int parse_combo(const char* const text, uint64_t* const out) {
+    return (strlen(text) == 4 && parse_hand_mask(text, 4, out, NULL) == HOLE_SIZE) ? 0 : -1;
+}
+
+/* Static helper: print the equity of each matchup argument */
+static int lookup_matchups(const char* const path, char** const args, const int num_args) {
+    if (num_args == 0 || num_args % 2 != 0) {
+        fprintf(stderr, "poker-preflop: expected HOLE VILLAIN pairs\n");
+        return 2;
+    }
+    PreflopEquity* const table = preflop_equity_open(path);
+    if (table == NULL) {
+        fprintf(stderr, "poker-preflop: cannot open matrix '%s' (error %d)\n", path, poker_errno);
+        return 1;
+    }
+    int rc = 0;
+    for (int i = 0; i < num_args; i += 2) {
+        uint64_t hole = 0;
+        uint64_t villain = 0;
+        const double equity = (parse_combo(args[i], &hole) == 0 &&
+                               parse_combo(args[i + 1], &villain) == 0)
+                                  ? preflop_equity(table, hole, villain)
+                                  : -1.0;
+        if (equity < 0.0) {
+            fprintf(stderr, "poker-preflop: invalid matchup '%s' vs '%s'\n", args[i], args[i + 1]);
+            rc = 1;
+            continue;
+        }
+        printf("%s\t%s\t%.6f\n", args[i], args[i + 1], equity);
+    }
+    preflop_equity_close(table);
+    return rc;
+}
+
+int main(int argc, char** argv) {
+    size_t num_threads = 0;
+    const char* output = NULL;
+    int print_stats = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* const arg = argv[i];
+        const char* const value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "-t") == 0 || strcmp(arg, "--threads") == 0) {
+            char* end = NULL;
+            const unsigned long long count = (value != NULL) ? strtoull(value, &end, 10) : 0;
+            if (value == NULL || end == value || *end != '\0' || count == 0 || count > 256) {
+                fprintf(stderr, "poker-preflop: invalid thread count (1-256)\n");
+                return 2;
+            }
+            num_threads = (size_t)count;
+            i++;
+        } else if (strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0) {
+            if (value == NULL) {
+                fprintf(stderr, "poker-preflop: missing output file\n");
+                return 2;
+            }
+            output = value;
+            i++;
+        } else if (strcmp(arg, "--stats") == 0) {
+            print_stats = 1;
+        } else if (strcmp(arg, "-l") == 0 || strcmp(arg, "--lookup") == 0) {
+            if (value == NULL) {
+                fprintf(stderr, "poker-preflop: missing matrix file\n");
+                return 2;
+            }
+            return lookup_matchups(value, argv + i + 2, argc - i - 2);
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            usage(stdout);
+            return 0;
+        } else {
+            fprintf(stderr, "poker-preflop: unknown option '%s'\n", arg);
+            usage(stderr);
+            return 2;
+        }
+    }
+
+    if (output == NULL) {
+        fprintf(stderr, "poker-preflop: missing output file\n");
+        usage(stderr);
+        return 2;
+    }
+
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    PreflopEquityStats stats;
+    if (preflop_equity_build(output, num_threads, &stats) != 0) {
+        fprintf(stderr, "poker-preflop: build failed (error %d)\n", poker_errno);
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (print_stats) {
+        const double seconds =
+            (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        fprintf(stderr, "%zu matchup classes over %zu board classes, %.1f s\n",
+                stats.num_classes, stats.board_classes, seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * poker-pushfold - Heads-up push/fold charts
+ *
+ * Solves the small blind's jam range and the big blind's calling range
+ * for a grid of stack depths under one blind and ante structure
+ * (poker_pushfold.h), printing a summary per stack and optionally 13x13
+ * charts. Equities come from a preflop matrix file, which is built on
+ * first use if it does not exist.
+ *
+ * Build:
+ *   make tools
+ *
+ * Run:
+ *   ./build/poker-pushfold -m preflop.peqm --stacks 5:20:1 --ante 0.125
+ *   ./build/poker-pushfold -m preflop.peqm --stacks 10 --bb-ante 1 --chart
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/poker_pushfold.h"
+#include "../include/poker_handindex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Defaults */
+#define DEFAULT_ITERATIONS 1000
+#define MAX_STACKS         4096
+
+static void usage(FILE* const out) {
+    fprintf(out,
+            "Usage: poker-pushfold [options] --stacks FROM[:TO[:STEP]]\n"
+            "Solve heads-up push/fold equilibria for a grid of stack depths.\n"
+            "\n"
+            "Options:\n"
+            "  -m, --matrix FILE     Preflop equity matrix (default preflop.peqm; built if missing)\n"
+            "  -s, --stacks RANGE    Effective stacks in big blinds, e.g. 10 or 5:20:0.5\n"
+            "      --sb N            Small blind in big blinds (default 0.5)\n"
+            "      --ante N          Ante per player in big blinds (default 0)\n"
+            "      --bb-ante N       Big-blind ante in big blinds (default 0)\n"
+            "  -i, --iterations N    CFR+ iterations per stack (default %d)\n"
+            "  -t, --threads N       Worker threads (default: online CPUs)\n"
+            "  -c, --chart           Print 13x13 jam and call charts (percent)\n"
+            "  -h, --help            Show this help\n",
+            DEFAULT_ITERATIONS);
+}
+
+/* Static helper: parse a count argument in [0, max] */
+static int parse_count(const char* const arg, const unsigned long long max, size_t* const out) {
+    char* end = NULL;
+    const unsigned long long value = (arg != NULL) ? strtoull(arg, &end, 10) : 0;
+    if (arg == NULL || end == arg || *end != '\0' || value > max) {
+        return -1;
+    }
+    *out = (size_t)value;
+    return 0;
+}
+
+/* Static helper: parse a non-negative number */
+static int parse_amount(const char* const arg, double* const out) {
+    char* end = NULL;
+    const double value = (arg != NULL) ? strtod(arg, &end) : -1.0;
+    if (arg == NULL || end == arg || *end != '\0' || !(value >= 0.0)) {
+        return -1;
+    }
+    *out = value;
+    return 0;
+}
+
+/* Static helper: parse FROM[:TO[:STEP]] into a list of stacks */
+static size_t parse_stacks(const char* const arg, double* const out) {
+    char* end = NULL;
+    const double from = strtod(arg, &end);
+    double to = from;
+    double step = 1.0;
+    if (end != arg && *end == ':') {
+        const char* const next = end + 1;
+        to = strtod(next, &end);
+        if (end == next) {
+            return 0;
+        }
+        if (*end == ':') {
+            const char* const last = end + 1;
+            step = strtod(last, &end);
+            if (end == last) {
+                return 0;
+            }
+        }
+    }
+    if (*end != '\0' || !(from > 0.0) || !(to >= from) || !(step > 0.0)) {
+        return 0;
+    }
+    /* Stacks are from + k * step, so rounding does not accumulate */
+    size_t count = 0;
+    while (from + step * (double)count <= to + step * 1e-9) {
+        if (count == MAX_STACKS) {
+            return 0;
+        }
+        out[count] = from + step * (double)count;
+        count++;
+    }
+    return count;
+}
+
+/* Static helper: class of a chart cell (row and column ranks, aces first) */
+static size_t chart_class(const int row, const int column) {
+    const int high = 12 - ((row < column) ? row : column);
+    const int low = 12 - ((row < column) ? column : row);
+    const int suited = row < column;
+    const uint8_t cards[HOLE_SIZE] = {(uint8_t)(high * 4), (uint8_t)(low * 4 + (suited ? 0 : 1))};
+    uint64_t index = 0;
+    hand_index(cards, HOLE_SIZE, &index);
+    return (size_t)index;
+}
+
+/* Static helper: rank character of a chart row or column (aces first) */
+static char chart_rank(const int line) {
+    const Card card = {(uint8_t)(RANK_ACE - line), SUIT_HEARTS};
+    char text[3];
+    card_to_string(card, text, sizeof(text));
+    return text[0];
+}
+
+/* Static helper: print a 13x13 chart, suited hands above the diagonal */
+static void print_chart(const char* const title, const double* const values) {
+    printf("%s\n    ", title);
+    for (int column = 0; column < 13; column++) {
+        printf("%4c", chart_rank(column));
+    }
+    printf("\n");
+    for (int row = 0; row < 13; row++) {
+        printf("%4c", chart_rank(row));
+        for (int column = 0; column < 13; column++) {
+            printf("%4.0f", 100.0 * values[chart_class(row, column)]);
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* matrix = "preflop.peqm";
+    static double stacks[MAX_STACKS];
+    size_t num_stacks = 0;
+    double small_blind = 0.5;
+    double ante = 0.0;
+    double big_blind_ante = 0.0;
+    size_t iterations = DEFAULT_ITERATIONS;
+    size_t num_threads = 0;
+    int chart = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* const arg = argv[i];
+        const char* const value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "-m") == 0 || strcmp(arg, "--matrix") == 0) {
+            if (value == NULL) {
+                fprintf(stderr, "poker-pushfold: missing matrix file\n");
+                return 2;
+            }
+            matrix = value;
+            i++;
+        } else if (strcmp(arg, "-s") == 0 || strcmp(arg, "--stacks") == 0) {
+            num_stacks = (value != NULL) ? parse_stacks(value, stacks) : 0;
+            if (num_stacks == 0) {
+                fprintf(stderr, "poker-pushfold: invalid stacks (FROM[:TO[:STEP]], at most %d)\n",
+                        MAX_STACKS);
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "--sb") == 0 || strcmp(arg, "--ante") == 0 ||
+                   strcmp(arg, "--bb-ante") == 0) {
+            double* const target = (strcmp(arg, "--sb") == 0)     ? &small_blind
+                                   : (strcmp(arg, "--ante") == 0) ? &ante
+                                                                  : &big_blind_ante;
+            if (parse_amount(value, target) != 0) {
+                fprintf(stderr, "poker-pushfold: invalid amount for %s\n", arg);
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-i") == 0 || strcmp(arg, "--iterations") == 0) {
+            if (parse_count(value, 1u << 30, &iterations) != 0 || iterations == 0) {
+                fprintf(stderr, "poker-pushfold: invalid iteration count\n");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--threads") == 0) {
+            if (parse_count(value, 256, &num_threads) != 0 || num_threads == 0) {
+                fprintf(stderr, "poker-pushfold: invalid thread count (1-256)\n");
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "-c") == 0 || strcmp(arg, "--chart") == 0) {
+            chart = 1;
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            usage(stdout);
+            return 0;
+        } else {
+            fprintf(stderr, "poker-pushfold: unknown option '%s'\n", arg);
+            usage(stderr);
+            return 2;
+        }
+    }
+
+    if (num_stacks == 0) {
+        fprintf(stderr, "poker-pushfold: missing stacks\n");
+        usage(stderr);
+        return 2;
+    }
+    PushFoldSpot* const spots = calloc(num_stacks, sizeof(PushFoldSpot));
+    PushFoldResult* const results = calloc(num_stacks, sizeof(PushFoldResult));
+    if (spots == NULL || results == NULL) {
+        fprintf(stderr, "poker-pushfold: out of memory\n");
+        free(spots);
+        free(results);
+        return 1;
+    }
+    for (size_t s = 0; s < num_stacks; s++) {
+        spots[s].stack = stacks[s];
+        spots[s].small_blind = small_blind;
+        spots[s].big_blind = 1.0;
+        spots[s].ante = ante;
+        spots[s].big_blind_ante = big_blind_ante;
+    }
+
+    int rc = 0;
+    PushFoldEquities* const equities = pushfold_equities_load(matrix, num_threads);
+    if (equities == NULL) {
+        fprintf(stderr, "poker-pushfold: cannot load matrix '%s' (error %d)\n", matrix, poker_errno);
+        rc = 1;
+    } else if (pushfold_solve(equities, spots, num_stacks, iterations, num_threads, results) != 0) {
+        fprintf(stderr, "poker-pushfold: invalid spot (error %d)\n", poker_errno);
+        rc = 2;
+    } else {
+        for (size_t s = 0; s < num_stacks; s++) {
+            printf("stack %.2f: jam %.1f%%, call %.1f%%, SB value %+.4f bb, exploitability %.2e bb\n",
+                   stacks[s], 100.0 * results[s].jam_share, 100.0 * results[s].call_share,
+                   results[s].value, results[s].exploitability);
+            if (chart) {
+                print_chart("Jam (SB)", results[s].jam);
+                print_chart("Call (BB)", results[s].call);
+            }
+        }
+    }
+    pushfold_equities_destroy(equities);
+    free(spots);
+    free(results);
+    return rc;
+}